@@ -55,6 +55,8 @@ extern "C" {
 #include "svc/Inc/otas_stm.h"
 #include "svc/Inc/mesh.h"  
 #include "svc/Inc/template_stm.h"  
+#include "svc/Inc/stream_stm.h"
+#include "svc/Inc/coc_stm.h"
   
 #include "svc/Inc/svc_ctl.h"
 
@@ -185,6 +185,128 @@ const hci_event_table_t hci_vs_event_table[HCI_VS_EVENT_TABLE_SIZE] =
   { 0x0C1FU, aci_gatt_notification_ext_event_process },
 };
 
+/* Direct index of the event process functions tables: each entry holds the
+ * position + 1 of the event in its table, 0 when the event is not handled */
+static const uint8_t hci_event_index[HCI_EVENT_INDEX_SIZE] =
+{
+  [0x05U] = 1U,
+  [0x08U] = 2U,
+  [0x0CU] = 3U,
+  [0x10U] = 4U,
+  [0x13U] = 5U,
+  [0x30U] = 6U,
+};
+
+static const uint8_t hci_le_event_index[HCI_LE_EVENT_INDEX_SIZE] =
+{
+  [0x01U] = 1U,
+  [0x02U] = 2U,
+  [0x03U] = 3U,
+  [0x04U] = 4U,
+  [0x05U] = 5U,
+  [0x07U] = 6U,
+  [0x08U] = 7U,
+  [0x09U] = 8U,
+  [0x0AU] = 9U,
+  [0x0BU] = 10U,
+  [0x0CU] = 11U,
+  [0x0DU] = 12U,
+  [0x11U] = 13U,
+  [0x12U] = 14U,
+  [0x13U] = 15U,
+  [0x14U] = 16U,
+};
+
+static const uint8_t hci_vs_event_index[HCI_VS_EVENT_INDEX_SIZE] =
+{
+  [0x04U] = 1U,
+  [0x05U] = 2U,
+  [0x06U] = 3U,
+  [0x20U] = 4U,
+  [0x21U] = 5U,
+  [0x22U] = 6U,
+  [0x23U] = 7U,
+  [0x24U] = 8U,
+  [0x25U] = 9U,
+  [0x27U] = 10U,
+  [0x28U] = 11U,
+  [0x29U] = 12U,
+  [0x2AU] = 13U,
+  [0x40U] = 14U,
+  [0x41U] = 15U,
+  [0x42U] = 16U,
+  [0x4AU] = 17U,
+  [0x50U] = 18U,
+  [0x51U] = 19U,
+  [0x52U] = 20U,
+  [0x53U] = 21U,
+  [0x54U] = 22U,
+  [0x55U] = 23U,
+  [0x56U] = 24U,
+  [0x57U] = 25U,
+  [0x61U] = 26U,
+  [0x62U] = 27U,
+  [0x63U] = 28U,
+  [0x64U] = 29U,
+  [0x65U] = 30U,
+  [0x66U] = 31U,
+  [0x67U] = 32U,
+  [0x68U] = 33U,
+  [0x69U] = 34U,
+  [0x6AU] = 35U,
+  [0x6CU] = 36U,
+  [0x6DU] = 37U,
+  [0x6EU] = 38U,
+  [0x6FU] = 39U,
+  [0x70U] = 40U,
+  [0x71U] = 41U,
+  [0x72U] = 42U,
+  [0x73U] = 43U,
+  [0x74U] = 44U,
+  [0x75U] = 45U,
+  [0x76U] = 46U,
+  [0x77U] = 47U,
+  [0x78U] = 48U,
+  [0x79U] = 49U,
+  [0x7AU] = 50U,
+  [0x7DU] = 51U,
+  [0x7EU] = 52U,
+  [0x7FU] = 53U,
+};
+
+/* HCI event process functions table lookup */
+const hci_event_table_t* hci_event_table_find( uint16_t evt_code )
+{
+  uint8_t pos = 0;
+  if ( evt_code < HCI_EVENT_INDEX_SIZE )
+  {
+    pos = hci_event_index[evt_code];
+  }
+  return (pos != 0U) ? &hci_event_table[pos - 1U] : 0;
+}
+
+/* HCI LE event process functions table lookup */
+const hci_event_table_t* hci_le_event_table_find( uint16_t evt_code )
+{
+  uint8_t pos = 0;
+  if ( evt_code < HCI_LE_EVENT_INDEX_SIZE )
+  {
+    pos = hci_le_event_index[evt_code];
+  }
+  return (pos != 0U) ? &hci_le_event_table[pos - 1U] : 0;
+}
+
+/* HCI VS event process functions table lookup */
+const hci_event_table_t* hci_vs_event_table_find( uint16_t evt_code )
+{
+  uint8_t pos = 0;
+  if ( (evt_code & ~HCI_VS_EVENT_INDEX_MASK) == 0U )
+  {
+    pos = hci_vs_event_index[HCI_VS_EVENT_INDEX(evt_code)];
+  }
+  return (pos != 0U) ? &hci_vs_event_table[pos - 1U] : 0;
+}
+
 /* HCI_DISCONNECTION_COMPLETE_EVENT callback function */
 __WEAK void hci_disconnection_complete_event( uint8_t Status,
                                               uint16_t Connection_Handle,
@@ -36,6 +36,21 @@ extern const hci_event_table_t hci_event_table[HCI_EVENT_TABLE_SIZE];
 extern const hci_event_table_t hci_le_event_table[HCI_LE_EVENT_TABLE_SIZE];
 extern const hci_event_table_t hci_vs_event_table[HCI_VS_EVENT_TABLE_SIZE];
 
+/* Sizes of the direct indexes of the event tables: the HCI event code and the
+ * LE sub-event code are used as is; the VS event code is folded from its
+ * group (bits 10-11) and its 5-bit code within the group (bits 0-4) */
+#define HCI_EVENT_INDEX_SIZE 0x40
+#define HCI_LE_EVENT_INDEX_SIZE 0x40
+#define HCI_VS_EVENT_INDEX_SIZE 0x80
+#define HCI_VS_EVENT_INDEX_MASK 0x0C1FU
+#define HCI_VS_EVENT_INDEX( code ) ((((code) >> 5) & 0x60U) | ((code) & 0x1FU))
+
+/* Event process functions tables lookup in constant time: they return the
+ * table entry of the given event code or 0 (NULL) if the event is unknown */
+extern const hci_event_table_t* hci_event_table_find( uint16_t evt_code );
+extern const hci_event_table_t* hci_le_event_table_find( uint16_t evt_code );
+extern const hci_event_table_t* hci_vs_event_table_find( uint16_t evt_code );
+
 /* HCI events */
 
 /**
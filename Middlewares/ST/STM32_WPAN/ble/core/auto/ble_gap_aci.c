@@ -467,6 +467,28 @@ tBleStatus aci_gap_update_adv_data( uint8_t AdvDataLen,
   return status;
 }
 
+tBleStatus aci_gap_update_adv_data_async( uint8_t AdvDataLen,
+                                          const uint8_t* AdvData,
+                                          hci_cmd_cb_t Cmd_Cb )
+{
+  struct hci_request rq;
+  uint8_t cmd_buffer[BLE_CMD_MAX_PARAM_LEN];
+  aci_gap_update_adv_data_cp0 *cp0 = (aci_gap_update_adv_data_cp0*)(cmd_buffer);
+  int index_input = 0;
+  cp0->AdvDataLen = AdvDataLen;
+  index_input += 1;
+  Osal_MemCpy( (void*)&cp0->AdvData, (const void*)AdvData, AdvDataLen );
+  index_input += AdvDataLen;
+  Osal_MemSet( &rq, 0, sizeof(rq) );
+  rq.ogf = 0x3f;
+  rq.ocf = 0x08e;
+  rq.cparam = cmd_buffer;
+  rq.clen = index_input;
+  if ( hci_send_req_async(&rq, Cmd_Cb) < 0 )
+    return BLE_STATUS_INSUFFICIENT_RESOURCES;
+  return BLE_STATUS_SUCCESS;
+}
+
 tBleStatus aci_gap_delete_ad_type( uint8_t ADType )
 {
   struct hci_request rq;
@@ -536,6 +536,20 @@ tBleStatus aci_gap_slave_security_req( uint16_t Connection_Handle );
 tBleStatus aci_gap_update_adv_data( uint8_t AdvDataLen,
                                     const uint8_t* AdvData );
 
+/**
+ * @brief Non-blocking version of aci_gap_update_adv_data()
+ * The command is queued and the function returns without waiting for its
+ * response. Cmd_Cb (if not NULL) is called from hci_user_evt_proc() with
+ * the returned status when the response is received.
+ *
+ * @param Cmd_Cb Callback called on command response
+ * @return BLE_STATUS_SUCCESS if the command is queued,
+ *         BLE_STATUS_INSUFFICIENT_RESOURCES if the queue is full.
+ */
+tBleStatus aci_gap_update_adv_data_async( uint8_t AdvDataLen,
+                                          const uint8_t* AdvData,
+                                          hci_cmd_cb_t Cmd_Cb );
+
 /**
  * @brief ACI_GAP_DELETE_AD_TYPE
  * This command can be used to delete the specified AD type from the
@@ -312,6 +312,37 @@ tBleStatus aci_gatt_update_char_value( uint16_t Service_Handle,
   return status;
 }
 
+tBleStatus aci_gatt_update_char_value_async( uint16_t Service_Handle,
+                                             uint16_t Char_Handle,
+                                             uint8_t Val_Offset,
+                                             uint8_t Char_Value_Length,
+                                             const uint8_t* Char_Value,
+                                             hci_cmd_cb_t Cmd_Cb )
+{
+  struct hci_request rq;
+  uint8_t cmd_buffer[BLE_CMD_MAX_PARAM_LEN];
+  aci_gatt_update_char_value_cp0 *cp0 = (aci_gatt_update_char_value_cp0*)(cmd_buffer);
+  int index_input = 0;
+  cp0->Service_Handle = Service_Handle;
+  index_input += 2;
+  cp0->Char_Handle = Char_Handle;
+  index_input += 2;
+  cp0->Val_Offset = Val_Offset;
+  index_input += 1;
+  cp0->Char_Value_Length = Char_Value_Length;
+  index_input += 1;
+  Osal_MemCpy( (void*)&cp0->Char_Value, (const void*)Char_Value, Char_Value_Length );
+  index_input += Char_Value_Length;
+  Osal_MemSet( &rq, 0, sizeof(rq) );
+  rq.ogf = 0x3f;
+  rq.ocf = 0x106;
+  rq.cparam = cmd_buffer;
+  rq.clen = index_input;
+  if ( hci_send_req_async(&rq, Cmd_Cb) < 0 )
+    return BLE_STATUS_INSUFFICIENT_RESOURCES;
+  return BLE_STATUS_SUCCESS;
+}
+
 tBleStatus aci_gatt_del_char( uint16_t Serv_Handle,
                               uint16_t Char_Handle )
 {
@@ -1400,6 +1431,46 @@ tBleStatus aci_gatt_update_char_value_ext( uint16_t Conn_Handle_To_Notify,
   return status;
 }
 
+tBleStatus aci_gatt_update_char_value_ext_async( uint16_t Conn_Handle_To_Notify,
+                                                 uint16_t Service_Handle,
+                                                 uint16_t Char_Handle,
+                                                 uint8_t Update_Type,
+                                                 uint16_t Char_Length,
+                                                 uint16_t Value_Offset,
+                                                 uint8_t Value_Length,
+                                                 const uint8_t* Value,
+                                                 hci_cmd_cb_t Cmd_Cb )
+{
+  struct hci_request rq;
+  uint8_t cmd_buffer[BLE_CMD_MAX_PARAM_LEN];
+  aci_gatt_update_char_value_ext_cp0 *cp0 = (aci_gatt_update_char_value_ext_cp0*)(cmd_buffer);
+  int index_input = 0;
+  cp0->Conn_Handle_To_Notify = Conn_Handle_To_Notify;
+  index_input += 2;
+  cp0->Service_Handle = Service_Handle;
+  index_input += 2;
+  cp0->Char_Handle = Char_Handle;
+  index_input += 2;
+  cp0->Update_Type = Update_Type;
+  index_input += 1;
+  cp0->Char_Length = Char_Length;
+  index_input += 2;
+  cp0->Value_Offset = Value_Offset;
+  index_input += 2;
+  cp0->Value_Length = Value_Length;
+  index_input += 1;
+  Osal_MemCpy( (void*)&cp0->Value, (const void*)Value, Value_Length );
+  index_input += Value_Length;
+  Osal_MemSet( &rq, 0, sizeof(rq) );
+  rq.ogf = 0x3f;
+  rq.ocf = 0x12c;
+  rq.cparam = cmd_buffer;
+  rq.clen = index_input;
+  if ( hci_send_req_async(&rq, Cmd_Cb) < 0 )
+    return BLE_STATUS_INSUFFICIENT_RESOURCES;
+  return BLE_STATUS_SUCCESS;
+}
+
 tBleStatus aci_gatt_deny_read( uint16_t Connection_Handle,
                                uint8_t Error_Code )
 {
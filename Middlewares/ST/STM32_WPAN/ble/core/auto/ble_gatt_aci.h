@@ -272,6 +272,23 @@ tBleStatus aci_gatt_update_char_value( uint16_t Service_Handle,
                                        uint8_t Char_Value_Length,
                                        const uint8_t* Char_Value );
 
+/**
+ * @brief Non-blocking version of aci_gatt_update_char_value()
+ * The command is queued and the function returns without waiting for its
+ * response. Cmd_Cb (if not NULL) is called from hci_user_evt_proc() with
+ * the returned status when the response is received.
+ *
+ * @param Cmd_Cb Callback called on command response
+ * @return BLE_STATUS_SUCCESS if the command is queued,
+ *         BLE_STATUS_INSUFFICIENT_RESOURCES if the queue is full.
+ */
+tBleStatus aci_gatt_update_char_value_async( uint16_t Service_Handle,
+                                             uint16_t Char_Handle,
+                                             uint8_t Val_Offset,
+                                             uint8_t Char_Value_Length,
+                                             const uint8_t* Char_Value,
+                                             hci_cmd_cb_t Cmd_Cb );
+
 /**
  * @brief ACI_GATT_DEL_CHAR
  * Delete the specified characteristic from the service.
@@ -1119,6 +1136,26 @@ tBleStatus aci_gatt_update_char_value_ext( uint16_t Conn_Handle_To_Notify,
                                            uint8_t Value_Length,
                                            const uint8_t* Value );
 
+/**
+ * @brief Non-blocking version of aci_gatt_update_char_value_ext()
+ * The command is queued and the function returns without waiting for its
+ * response. Cmd_Cb (if not NULL) is called from hci_user_evt_proc() with
+ * the returned status when the response is received.
+ *
+ * @param Cmd_Cb Callback called on command response
+ * @return BLE_STATUS_SUCCESS if the command is queued,
+ *         BLE_STATUS_INSUFFICIENT_RESOURCES if the queue is full.
+ */
+tBleStatus aci_gatt_update_char_value_ext_async( uint16_t Conn_Handle_To_Notify,
+                                                 uint16_t Service_Handle,
+                                                 uint16_t Char_Handle,
+                                                 uint8_t Update_Type,
+                                                 uint16_t Char_Length,
+                                                 uint16_t Value_Offset,
+                                                 uint8_t Value_Length,
+                                                 const uint8_t* Value,
+                                                 hci_cmd_cb_t Cmd_Cb );
+
 /**
  * @brief ACI_GATT_DENY_READ
  * Deny the GATT server to send a response to a read request from a client.
@@ -109,6 +109,12 @@ struct hci_request
 };
 extern int hci_send_req( struct hci_request* req, uint8_t async );
 
+/* Callback function called when the response of a command sent with
+ * hci_send_req_async() is received. rparam points to the return parameters
+ * (status first) and is only valid until the callback returns */
+typedef void (*hci_cmd_cb_t)( uint16_t opcode, const uint8_t* rparam, uint8_t rlen );
+extern int hci_send_req_async( struct hci_request* req, hci_cmd_cb_t cb );
+
 
 #ifndef FALSE
 #define FALSE 0
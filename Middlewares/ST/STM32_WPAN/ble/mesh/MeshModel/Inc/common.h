@@ -88,6 +88,11 @@
 #define INTENSITY_LEVEL_FULL                                              31990U
 
 #define MAX_TID_VALUE                                                       0XFF
+/* Number of (source, destination) pairs whose last TID is kept by the model
+   servers, may be overridden in mesh_cfg_usr.h */
+#ifndef TID_CACHE_SIZE
+#define TID_CACHE_SIZE                                                         8
+#endif
 
 #define STEP_HEX_VALUE_0                                                    0X00
 #define STEP_HEX_VALUE_1                                                    0X01
@@ -647,6 +652,11 @@ MOBLE_RESULT TimeDttFGet(MOBLEUINT32 timeMs, MOBLEUINT8* timeDttF);
 MOBLEUINT32 Get_StepResolutionValue(MOBLEUINT8 time_param);
 
 float Ratio_CalculateValue(MOBLEUINT16 setValue , MOBLEUINT16 maxRange , MOBLEINT16 minRange);
+MOBLEUINT32 Sqrt_CalculateValue(MOBLEUINT32 value);
+MOBLEUINT16 Lightness_ActualToLinear(MOBLEUINT16 actual);
+MOBLEUINT16 Lightness_LinearToActual(MOBLEUINT16 linear);
+MOBLEUINT16 CtlTemperature_FromLevel(MOBLEINT16 level);
+MOBLEINT16 CtlTemperature_ToLevel(MOBLEUINT16 temperature);
 void TraceHeader(const char* func_name, int mode);
 #ifdef ENABLE_SAVE_MODEL_STATE_NVM
 MOBLE_RESULT SaveModelsStateNvm(MOBLEUINT8* flag);
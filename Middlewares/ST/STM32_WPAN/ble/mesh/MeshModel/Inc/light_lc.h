@@ -27,6 +27,12 @@
 #define LC_PROPERTY_TABLE_COUNT                  18
 #define LIGHT_LC_DEFAULT_TRANSITION_RES_MS       100 /* Recommended value is 100 milliseconds */
 
+/* PI regulator arithmetic, may be overridden in mesh_cfg_usr.h
+   0: floating point, 1: fixed point (Q16.16), no FPU operation */
+#ifndef LIGHT_LC_REGULATOR_FIXED_POINT
+#define LIGHT_LC_REGULATOR_FIXED_POINT           0
+#endif
+
 /* Exported types ------------------------------------------------------------*/
 typedef struct
 {
@@ -41,7 +41,53 @@ WEAK_FUNCTION(MOBLE_RESULT ApplicationGetConfigServerDeviceKey(MOBLE_ADDRESS src
 MOBLEUINT8 TimeDelay(MOBLEUINT16 waitPeriod);
 
 /* Private define ------------------------------------------------------------*/
+/* A message with the TID, source and destination of a message received less
+   than 6 seconds before is a retransmission */
+#define TID_VALIDITY_PERIOD_MS                                              6000
+#define TID_CACHE_HASH_SIZE                                (2 * TID_CACHE_SIZE)
+/* Cache links are entry index + 1, 0 is the end of a list */
+#define TID_CACHE_NONE                                                         0
+/* The single precision conversions of the previous releases differ from the
+   exact ones only when the remainder of the integer division is within this
+   band of the divisor or of 0 */
+#define CONVERSION_CORRECTION_BAND                                           512
+
+#if (TID_CACHE_SIZE < 1) || (TID_CACHE_SIZE > 255)
+#error "TID_CACHE_SIZE shall be in the range 1 - 255"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+/**
+  * TID cache entry, last TID received for a (source, destination) pair
+ */
+typedef struct
+{
+  MOBLEUINT32 tidTick;
+  MOBLE_ADDRESS src;
+  MOBLE_ADDRESS dst;
+  MOBLEUINT8 tid;
+  MOBLEUINT8 hashNext;    /* Next entry of the same hash bucket */
+  MOBLEUINT8 lruPrev;     /* Entry used more recently */
+  MOBLEUINT8 lruNext;     /* Entry used less recently */
+}tid_cache_entry_t;
+
+/**
+  * TID cache shared by the model servers
+  * Entries are found through a hash table of the (source, destination) pair
+  * and are recycled in least recently used order when the cache is full
+ */
+typedef struct
+{
+  tid_cache_entry_t entry[TID_CACHE_SIZE];
+  MOBLEUINT8 bucket[TID_CACHE_HASH_SIZE];
+  MOBLEUINT8 lruHead;
+  MOBLEUINT8 lruTail;
+  MOBLEUINT8 count;
+}tid_cache_t;
+
 /* Private macro -------------------------------------------------------------*/
+#define CONVERSION_TABLE_SIZE(table)       (sizeof(table) / sizeof((table)[0]))
+
 #ifdef ENABLE_SAVE_MODEL_STATE_NVM
 extern const APPLI_SAVE_MODEL_STATE_CB SaveModelState_cb;
 extern const APPLI_SAVE_MODEL_TEST_STATE_CB SaveModelTestState_cb;
@@ -52,9 +98,90 @@ MOBLEUINT8 PowerOnOff_flag = FLAG_RESET;
 MOBLEUINT8 RestoreFlag[APPLICATION_NUMBER_OF_ELEMENTS];
 
 Model_Tid_t Model_Tid;
+static tid_cache_t TidCache;
 /*Variables used for the publishing of binded data */
 Model_Binding_Var_t Model_Binding_Var;
 
+/* floor(16 * sqrt(index)), first estimate of the integer square root */
+static const MOBLEUINT8 SqrtEstimate[256] =
+{
+  0, 16, 22, 27, 32, 35, 39, 42, 45, 48, 50, 53, 55, 57, 59, 61,
+  64, 65, 67, 69, 71, 73, 75, 76, 78, 80, 81, 83, 84, 86, 87, 89,
+  90, 91, 93, 94, 96, 97, 98, 99, 101, 102, 103, 104, 106, 107, 108, 109,
+  110, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126,
+  128, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
+  143, 144, 144, 145, 146, 147, 148, 149, 150, 150, 151, 152, 153, 154, 155, 155,
+  156, 157, 158, 159, 160, 160, 161, 162, 163, 163, 164, 165, 166, 167, 167, 168,
+  169, 170, 170, 171, 172, 173, 173, 174, 175, 176, 176, 177, 178, 178, 179, 180,
+  181, 181, 182, 183, 183, 184, 185, 185, 186, 187, 187, 188, 189, 189, 190, 191,
+  192, 192, 193, 193, 194, 195, 195, 196, 197, 197, 198, 199, 199, 200, 201, 201,
+  202, 203, 203, 204, 204, 205, 206, 206, 207, 208, 208, 209, 209, 210, 211, 211,
+  212, 212, 213, 214, 214, 215, 215, 216, 217, 217, 218, 218, 219, 219, 220, 221,
+  221, 222, 222, 223, 224, 224, 225, 225, 226, 226, 227, 227, 228, 229, 229, 230,
+  230, 231, 231, 232, 232, 233, 234, 234, 235, 235, 236, 236, 237, 237, 238, 238,
+  239, 240, 240, 241, 241, 242, 242, 243, 243, 244, 244, 245, 245, 246, 246, 247,
+  247, 248, 248, 249, 249, 250, 250, 251, 251, 252, 252, 253, 253, 254, 254, 255
+};
+
+/* Inputs of the conversions for which the single precision computation of the
+   previous releases gives one more (Up) or one less (Down) than the exact
+   integer result. The integer conversions are corrected on these inputs to
+   keep the states bit-exact with the previous releases. */
+static const MOBLEUINT16 ActualToLinear_Up[] =
+{
+  19935, 21636, 22398, 22768, 25665, 25852, 28035, 28610, 30676, 31055,
+  31689, 31890, 32343, 33192, 34187, 34480, 36093, 38398, 39870, 40661,
+  42190, 42767, 43137, 43200, 43272, 44766, 44796, 45190, 45536, 47606,
+  48612, 48795, 49320, 49399, 50054, 51330, 51704, 52900, 54539, 54686,
+  56070, 56206, 56344, 56704, 57006, 57220, 57521, 57562, 58557, 59805,
+  61101, 61313, 61352, 61594, 61619, 62110, 62605, 63120, 63161, 63378,
+  63424, 63689, 63780, 63876, 64686, 64811, 64908, 65173
+};
+
+static const MOBLEUINT16 ActualToLinear_Down[] =
+{
+  37170, 46172, 52590, 56136, 59991
+};
+
+static const MOBLEUINT16 LinearToActual_Up[] =
+{
+  291, 1164, 2411, 2520, 2621, 4656, 5721, 6078, 6615, 7112,
+  7281, 7283, 7285, 7729, 8594, 8738, 9644, 10080, 10484, 10488,
+  11109, 14273, 14512, 17858, 18369, 18624, 18640, 19405, 21082, 21199,
+  21338, 21699, 22871, 22884, 24211, 24312, 24899, 25792, 26460, 26665,
+  28252, 28448, 29120, 29124, 29128, 29132, 29136, 29140, 29469, 30418,
+  30916, 31479, 31565, 31697, 31846, 31973, 32530, 32664, 33541, 34035,
+  34266, 34376, 34952, 35233, 35255, 36492, 37579, 38311, 38337, 38576,
+  40320, 41928, 41936, 41944, 41952, 41960, 42202, 42353, 42806, 42882,
+  43138, 43747, 44436, 44464, 44652, 45235, 46303, 46377, 46569, 47854,
+  48085, 49231, 49342, 50394, 50675, 51015, 51654, 52811, 54916, 55314,
+  55898, 57064, 57092, 57305, 58048, 58080, 58563, 58650, 58756, 59048,
+  59535, 60024, 60515, 60665, 61008, 61091, 61503, 61629, 62000, 62499,
+  63000, 63503, 63633, 64008, 64515, 65024, 65505, 65507, 65509, 65511,
+  65513, 65515, 65517, 65519, 65521, 65523, 65525, 65527, 65529, 65531,
+  65533
+};
+
+static const MOBLEUINT16 LinearToActual_Down[] =
+{
+  31161
+};
+
+/* Indexed by Generic Level + 32768 */
+static const MOBLEUINT16 LevelToCtlTemperature_Up[] =
+{
+  10460, 14829, 19198, 23567, 27936, 31380, 32305, 35749, 36674, 40118,
+  41043, 44487, 45412, 48856, 49781, 53225, 54150, 56669, 57594, 58519,
+  60113, 61038, 61963, 62888, 64482, 65407
+};
+
+static const MOBLEUINT16 CtlTemperatureToLevel_Up[] =
+{
+  5551, 6831, 8111, 9391, 9662, 10671, 10942, 11951, 12222, 13231,
+  13502, 14511, 14782, 15791, 16062, 17071, 17342, 17613, 17884, 18351,
+  18622, 18893, 19164, 19631, 19902
+};
+
 /**
 * @brief  Chk_ParamValidity: This function is to check validity of Parameters
 * @param  param: Parameter 
@@ -486,6 +613,177 @@ float Ratio_CalculateValue(MOBLEUINT16 setValue , MOBLEUINT16 maxRange , MOBLEIN
       
       return Ratio;
 }
+
+/**
+* @brief  Sqrt_CalculateValue: This function is used to calculate the integer
+*         square root of a value, without floating point operation.
+*         The estimate from the 8 most significant bits is refined by Newton
+*         steps, which do not go below the integer square root.
+* @param  value: value of which the square root is calculated.
+* @retval Largest integer whose square is less than or equal to value
+*/ 
+MOBLEUINT32 Sqrt_CalculateValue(MOBLEUINT32 value)
+{
+  MOBLEUINT32 top = value;
+  MOBLEUINT32 root;
+  MOBLEUINT8 shift = 0;
+  
+  if(value == 0)
+  {
+    return 0;
+  }
+  
+  while(top >= 256)
+  {
+    top >>= 2;
+    shift++;
+  }
+  
+  /* Estimate within about 1%, two Newton steps bring it within 1 */
+  root = ((MOBLEUINT32)SqrtEstimate[top] << shift) >> 4;
+  root = (root + (value / root)) >> 1;
+  root = (root + (value / root)) >> 1;
+  
+  while(root > (value / root))
+  {
+    root--;
+  }
+  
+  return root;
+}
+
+/**
+* @brief  Conversion_Correction: This function is used to find if an input is
+*         in a sorted table of inputs to correct.
+* @param  pTable: sorted table of inputs.
+* @param  size: number of inputs of the table.
+* @param  input: input of the conversion.
+* @retval 1 if the input is in the table, 0 otherwise
+*/ 
+static MOBLEUINT8 Conversion_Correction(const MOBLEUINT16* pTable, MOBLEUINT16 size, MOBLEUINT16 input)
+{
+  MOBLEUINT16 first = 0;
+  MOBLEUINT16 last = size;
+  MOBLEUINT16 middle;
+  
+  while(first < last)
+  {
+    middle = (first + last) / 2;
+    if(pTable[middle] < input)
+    {
+      first = middle + 1;
+    }
+    else
+    {
+      last = middle;
+    }
+  }
+  
+  return ((first < size) && (pTable[first] == input)) ? 1 : 0;
+}
+
+/**
+* @brief  Lightness_ActualToLinear: This function is used to convert a Light
+*         Lightness Actual value to Light Lightness Linear with integer operations.
+*         Linear = 65535 * (Actual / 65535)^2, with the rounding of the previous
+*         single precision computation.
+* @param  actual: Light Lightness Actual value.
+* @retval Light Lightness Linear value
+*/ 
+MOBLEUINT16 Lightness_ActualToLinear(MOBLEUINT16 actual)
+{
+  MOBLEUINT32 productValue = (MOBLEUINT32)actual * actual;
+  MOBLEUINT16 linear = (MOBLEUINT16)(productValue / 65535);
+  MOBLEUINT32 remainder = productValue - ((MOBLEUINT32)linear * 65535);
+  
+  if(remainder >= (65535 - CONVERSION_CORRECTION_BAND))
+  {
+    linear += Conversion_Correction(ActualToLinear_Up, CONVERSION_TABLE_SIZE(ActualToLinear_Up), actual);
+  }
+  if(remainder < CONVERSION_CORRECTION_BAND)
+  {
+    linear -= Conversion_Correction(ActualToLinear_Down, CONVERSION_TABLE_SIZE(ActualToLinear_Down), actual);
+  }
+  
+  return linear;
+}
+
+/**
+* @brief  Lightness_LinearToActual: This function is used to convert a Light
+*         Lightness Linear value to Light Lightness Actual with integer operations.
+*         Actual = 65535 * sqrt(Linear / 65535), with the rounding of the previous
+*         single precision computation.
+* @param  linear: Light Lightness Linear value.
+* @retval Light Lightness Actual value
+*/ 
+MOBLEUINT16 Lightness_LinearToActual(MOBLEUINT16 linear)
+{
+  MOBLEUINT32 productValue = (MOBLEUINT32)linear * 65535;
+  MOBLEUINT32 root = Sqrt_CalculateValue(productValue);
+  /* Remainder in the range 0 - 2 * root */
+  MOBLEUINT32 remainder = productValue - (root * root);
+  MOBLEUINT16 actual = (MOBLEUINT16)root;
+  
+  if((remainder + CONVERSION_CORRECTION_BAND) > (2 * root))
+  {
+    actual += Conversion_Correction(LinearToActual_Up, CONVERSION_TABLE_SIZE(LinearToActual_Up), linear);
+  }
+  if(remainder < CONVERSION_CORRECTION_BAND)
+  {
+    actual -= Conversion_Correction(LinearToActual_Down, CONVERSION_TABLE_SIZE(LinearToActual_Down), linear);
+  }
+  
+  return actual;
+}
+
+/**
+* @brief  CtlTemperature_FromLevel: This function is used to convert a Generic
+*         Level value to Light CTL Temperature with integer operations.
+*         Temperature = T_MIN + (Level + 32768) * (T_MAX - T_MIN) / 65535, rounded
+*         as the previous single precision computation.
+* @param  level: Generic Level value.
+* @retval Light CTL Temperature value
+*/ 
+MOBLEUINT16 CtlTemperature_FromLevel(MOBLEINT16 level)
+{
+  MOBLEUINT16 index = (MOBLEUINT16)(level + 32768);
+  MOBLEUINT32 productValue = ((MOBLEUINT32)index * (MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE)) + 32767;
+  MOBLEUINT32 quotient = productValue / 65535;
+  MOBLEUINT16 temperature = (MOBLEUINT16)(MIN_CTL_TEMP_RANGE + quotient);
+  
+  if((productValue - (quotient * 65535)) >= (65535 - CONVERSION_CORRECTION_BAND))
+  {
+    temperature += Conversion_Correction(LevelToCtlTemperature_Up,
+                                         CONVERSION_TABLE_SIZE(LevelToCtlTemperature_Up), index);
+  }
+  
+  return temperature;
+}
+
+/**
+* @brief  CtlTemperature_ToLevel: This function is used to convert a Light CTL
+*         Temperature value to Generic Level with integer operations.
+*         Level = (Temperature - T_MIN) * 65535 / (T_MAX - T_MIN) - 32768, rounded
+*         as the previous single precision computation.
+* @param  temperature: Light CTL Temperature value, in the range T_MIN - T_MAX.
+* @retval Generic Level value
+*/ 
+MOBLEINT16 CtlTemperature_ToLevel(MOBLEUINT16 temperature)
+{
+  MOBLEUINT32 productValue = ((MOBLEUINT32)(temperature - MIN_CTL_TEMP_RANGE) * 65535) +
+                             ((MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE) / 2);
+  MOBLEUINT32 quotient = productValue / (MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE);
+  MOBLEINT16 level = (MOBLEINT16)(quotient - 32768);
+  
+  if((productValue - (quotient * (MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE))) >=
+     ((MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE) - CONVERSION_CORRECTION_BAND))
+  {
+    level += Conversion_Correction(CtlTemperatureToLevel_Up,
+                                   CONVERSION_TABLE_SIZE(CtlTemperatureToLevel_Up), temperature);
+  }
+  
+  return level;
+}
   
 /**
 * @brief  TraceHeader: This function is used print the timestamp , function name
@@ -1101,40 +1399,175 @@ void ModelSave_Process(void)
 
 
 /**
-  * @brief  
-  * @param  
-  * @retval 
+  * @brief  Hash bucket of a (source, destination) pair in the TID cache
+  * @param  Source and destination addresses
+  * @retval Bucket index
   */
-MOBLE_RESULT Chk_TidValidity(MOBLE_ADDRESS peerAddr, MOBLE_ADDRESS dstAddr, MOBLEUINT8 tidValue)
+static
+MOBLEUINT8 TidCache_Hash(MOBLE_ADDRESS src, MOBLE_ADDRESS dst)
 {
-  static MOBLEUINT32 Check_time;
-  MOBLE_RESULT status = MOBLE_RESULT_SUCCESS;
+  MOBLEUINT32 hash = ((MOBLEUINT32)src << 16) | dst;
   
-  TRACE_M(TF_COMMON, "dst_peer %.2X peer_add %.2X, tid %d\r\n", dstAddr, peerAddr, tidValue);
+  hash ^= hash >> 15;
+  hash *= 0x2C1B3C6DUL;
+  hash ^= hash >> 12;
   
-  if(((Clock_Time()- Check_time) <= 6000))
+  return (MOBLEUINT8)(hash % TID_CACHE_HASH_SIZE);
+}
+
+
+/**
+  * @brief  Unlink an entry from the least recently used list of the TID cache
+  * @param  Entry link (index + 1)
+  * @retval None
+  */
+static
+void TidCache_LruRemove(MOBLEUINT8 link)
+{
+  tid_cache_entry_t* pEntry = &TidCache.entry[link - 1];
+  
+  if(pEntry->lruPrev != TID_CACHE_NONE)
+  {
+    TidCache.entry[pEntry->lruPrev - 1].lruNext = pEntry->lruNext;
+  }
+  else
+  {
+    TidCache.lruHead = pEntry->lruNext;
+  }
+  
+  if(pEntry->lruNext != TID_CACHE_NONE)
+  {
+    TidCache.entry[pEntry->lruNext - 1].lruPrev = pEntry->lruPrev;
+  }
+  else
   {
-    if((Model_Tid.Peer_Addrs == peerAddr)&&(Model_Tid.Dst_Addrs == dstAddr)&&(Model_Tid.Tid_Value == tidValue))
+    TidCache.lruTail = pEntry->lruPrev;
+  }
+}
+
+
+/**
+  * @brief  Link an entry as most recently used in the TID cache
+  * @param  Entry link (index + 1)
+  * @retval None
+  */
+static
+void TidCache_LruInsertHead(MOBLEUINT8 link)
+{
+  tid_cache_entry_t* pEntry = &TidCache.entry[link - 1];
+  
+  pEntry->lruPrev = TID_CACHE_NONE;
+  pEntry->lruNext = TidCache.lruHead;
+  
+  if(TidCache.lruHead != TID_CACHE_NONE)
+  {
+    TidCache.entry[TidCache.lruHead - 1].lruPrev = link;
+  }
+  else
+  {
+    TidCache.lruTail = link;
+  }
+  TidCache.lruHead = link;
+}
+
+
+/**
+  * @brief  Entry of a (source, destination) pair in the TID cache. When the
+  *         pair is not found, the least recently used entry is recycled for it
+  *         (or a free one when the cache is not full) and its TID tick is
+  *         cleared. The entry returned is the most recently used one.
+  * @param  Source and destination addresses, reference to found status
+  * @retval Reference to the entry
+  */
+static
+tid_cache_entry_t* TidCache_Get(MOBLE_ADDRESS src, MOBLE_ADDRESS dst, MOBLEUINT8* pFound)
+{
+  MOBLEUINT8 bucket = TidCache_Hash(src, dst);
+  MOBLEUINT8 link = TidCache.bucket[bucket];
+  MOBLEUINT8* pLink;
+  tid_cache_entry_t* pEntry;
+  
+  while(link != TID_CACHE_NONE &&
+        (TidCache.entry[link - 1].src != src || TidCache.entry[link - 1].dst != dst))
+  {
+    link = TidCache.entry[link - 1].hashNext;
+  }
+  
+  *pFound = (link != TID_CACHE_NONE);
+  
+  if(link != TID_CACHE_NONE)
+  {
+    TidCache_LruRemove(link);
+  }
+  else
+  {
+    if(TidCache.count < TID_CACHE_SIZE)
     {
-      TRACE_M(TF_COMMON,"Duplicate Message Parameter within six second \r\n");
-      status =  MOBLE_RESULT_INVALIDARG;       
+      TidCache.count++;
+      link = TidCache.count;
     }
     else
     {
-      Check_time = Clock_Time();
-      Model_Tid.Peer_Addrs = peerAddr;
-      Model_Tid.Dst_Addrs = dstAddr;
-      Model_Tid.Tid_Value = tidValue; 
-      TRACE_M(TF_COMMON,"New Message Parameter within six second \r\n");
+      /* Recycle the least recently used entry */
+      link = TidCache.lruTail;
+      TidCache_LruRemove(link);
+      
+      pLink = &TidCache.bucket[TidCache_Hash(TidCache.entry[link - 1].src,
+                                             TidCache.entry[link - 1].dst)];
+      while(*pLink != link)
+      {
+        pLink = &TidCache.entry[*pLink - 1].hashNext;
+      }
+      *pLink = TidCache.entry[link - 1].hashNext;
     }
+    
+    pEntry = &TidCache.entry[link - 1];
+    pEntry->src = src;
+    pEntry->dst = dst;
+    pEntry->tid = 0;
+    pEntry->tidTick = 0;
+    pEntry->hashNext = TidCache.bucket[bucket];
+    TidCache.bucket[bucket] = link;
+  }
+  
+  TidCache_LruInsertHead(link);
+  
+  return &TidCache.entry[link - 1];
+}
+
+
+/**
+  * @brief  TID check of a received message against the last message received
+  *         from the same source to the same destination. The last TID of up
+  *         to TID_CACHE_SIZE (source, destination) pairs is kept, so that the
+  *         messages of several clients may be interleaved.
+  * @param  Source and destination addresses, TID of the received message
+  * @retval MOBLE_RESULT_INVALIDARG if the message is a retransmission received
+  *         within 6 seconds, else MOBLE_RESULT_SUCCESS
+  */
+MOBLE_RESULT Chk_TidValidity(MOBLE_ADDRESS peerAddr, MOBLE_ADDRESS dstAddr, MOBLEUINT8 tidValue)
+{
+  MOBLE_RESULT status = MOBLE_RESULT_SUCCESS;
+  MOBLEUINT32 now = Clock_Time();
+  MOBLEUINT8 found;
+  tid_cache_entry_t* pEntry;
+  
+  TRACE_M(TF_COMMON, "dst_peer %.2X peer_add %.2X, tid %d\r\n", dstAddr, peerAddr, tidValue);
+  
+  pEntry = TidCache_Get(peerAddr, dstAddr, &found);
+  
+  if(found && 
+     pEntry->tid == tidValue && 
+     (now - pEntry->tidTick) <= TID_VALIDITY_PERIOD_MS)
+  {
+    TRACE_M(TF_COMMON,"Duplicate Message Parameter within six second \r\n");
+    status =  MOBLE_RESULT_INVALIDARG;       
   }
   else
   {
-    Check_time = Clock_Time();
-    Model_Tid.Peer_Addrs = peerAddr;
-    Model_Tid.Dst_Addrs = dstAddr;
-    Model_Tid.Tid_Value = tidValue;
-    TRACE_M(TF_COMMON,"New Message Parameter after six second\r\n");
+    pEntry->tid = tidValue;
+    pEntry->tidTick = now;
+    TRACE_M(TF_COMMON,"New Message Parameter\r\n");
   }
   
   return status;
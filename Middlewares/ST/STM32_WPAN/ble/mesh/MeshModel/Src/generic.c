@@ -27,7 +27,6 @@
 #include <string.h>
 #include "compiler.h"
 #include <stdint.h>
-#include "math.h"
 
 
 /** @addtogroup MODEL_GENERIC
@@ -1474,12 +1473,10 @@ void Light_CtlTemp_GenericLevelBinding(Light_CtlStatus_t* bCtlTempParam, MOBLEUI
   T_MIN = minimum range of ctl temperature
   T_MAX = maximum range of ctl temperature
   */
-  MOBLEUINT32 productValue;
-  productValue = (bCtlTempParam->PresentCtlTemperature16 - MIN_CTL_TEMP_RANGE) * 65535;
   TRACE_M(TF_GENERIC_M, "\r\n ******** PresentCtlTemperature16 = %d,  ********\r\n\r\n", bCtlTempParam->PresentCtlTemperature16);
-  TRACE_M(TF_GENERIC_M, "\r\n ******** productValue = %ld,  ********\r\n\r\n", productValue); 
  
-  Generic_LevelStatus[elementIndex].Present_Level16 = (MOBLEINT16)(round((productValue / (float)(MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE))) - 32768);
+  Generic_LevelStatus[elementIndex].Present_Level16 = 
+    CtlTemperature_ToLevel(bCtlTempParam->PresentCtlTemperature16);
   TRACE_M(TF_GENERIC_M, "\r\n ********, Present Level value %d ********\r\n\r\n" ,Generic_LevelStatus[elementIndex].Present_Level16); 
   GenericLevel_LightBinding(&Generic_LevelStatus[elementIndex] , BINDING_LIGHT_CTL_TEMP_SET,elementIndex,
                                                           trnsnFlag,trnsnCmplt);
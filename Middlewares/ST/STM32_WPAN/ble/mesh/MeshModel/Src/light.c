@@ -23,7 +23,6 @@
 #include "common.h"
 #include "models_if.h"
 #include "light_lc.h"
-#include "math.h"
 #include "compiler.h"
 #include <string.h>
 /** @addtogroup MODEL_Light
@@ -2786,7 +2785,8 @@ MOBLE_RESULT Light_LightnessActualUpdate(MOBLEUINT16 lightActual, MOBLEUINT8 ele
 void Light_LightnessLinearUpdate(MOBLEUINT8 elementIndex, MOBLEUINT16 linear)
 {
   Light_LightnessStatus[elementIndex].LinearPresentValue16 = linear;
-  Light_LightnessStatus[elementIndex].LightnessPresentValue16 = (MOBLEUINT16)(sqrt((double)linear * (double)65535));
+  /* Exact square root, as the double precision sqrt() of the previous releases */
+  Light_LightnessStatus[elementIndex].LightnessPresentValue16 = (MOBLEUINT16)Sqrt_CalculateValue((MOBLEUINT32)linear * 65535);
   
   /* Status publish pending */
   
@@ -3382,10 +3382,8 @@ void GenericLevel_LightBinding(Generic_LevelStatus_t* gLevel_param , MOBLEUINT8
 */
 MOBLEUINT16 Light_Actual_LinearBinding(MOBLEUINT8 elementIndex)
 {
-  float productValue;
-  
-  productValue = pow((((float)Light_LightnessStatus[elementIndex].LightnessPresentValue16)/65535) , 2);
-  Light_LightnessStatus[elementIndex].LinearPresentValue16 = (MOBLEUINT16)(65535 * productValue);
+  Light_LightnessStatus[elementIndex].LinearPresentValue16 = 
+    Lightness_ActualToLinear(Light_LightnessStatus[elementIndex].LightnessPresentValue16);
  
   return Light_LightnessStatus[elementIndex].LinearPresentValue16; 
 }
@@ -3405,19 +3403,17 @@ MOBLEUINT16 Light_Linear_ActualBinding(MOBLEUINT32 length, MOBLEUINT8 elementInd
   /*
   6.1.2.1.1 - actual lightness = 655354 * squareroot(linear lightness/ 655354).
   */
-  float productValue;
-  
   if(length <= 3)
   {
-    productValue = sqrt((((float)Light_LightnessStatus[elementIndex].LinearPresentValue16) / 65535));
-    Light_LightnessStatus[elementIndex].LightnessPresentValue16 = (MOBLEUINT16)(65535 * productValue);      
+    Light_LightnessStatus[elementIndex].LightnessPresentValue16 = 
+      Lightness_LinearToActual(Light_LightnessStatus[elementIndex].LinearPresentValue16);
     
     return Light_LightnessStatus[elementIndex].LightnessPresentValue16;  
   }
   else
   {
-    productValue = sqrt((((float)Light_LightnessStatus[elementIndex].TargetValue16) / 65535));
-    Light_LightnessStatus[elementIndex].TargetValue16 = (MOBLEUINT16)(65535 * productValue);
+    Light_LightnessStatus[elementIndex].TargetValue16 = 
+      Lightness_LinearToActual(Light_LightnessStatus[elementIndex].TargetValue16);
     Light_TemporaryStatus[elementIndex].TargetParam_1 = Light_LightnessStatus[elementIndex].TargetValue16;   
     
     return Light_LightnessStatus[elementIndex].TargetValue16;  
@@ -3545,10 +3541,7 @@ void GenericLevel_CtlTempBinding(Generic_LevelStatus_t * bLevelParam, MOBLEUINT8
   T_MIN = minimum range of ctl temperature
   T_MAX = maximum range of ctl temperature
   */
-  MOBLEUINT32 productValue;
-  
-  productValue = (bLevelParam->Present_Level16 + 32768) * (MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE) ;
-  Light_CtlStatus[elementIndex].PresentCtlTemperature16 = (MOBLEUINT16)(MIN_CTL_TEMP_RANGE + round(((productValue) / (float)65535)));
+  Light_CtlStatus[elementIndex].PresentCtlTemperature16 = CtlTemperature_FromLevel(bLevelParam->Present_Level16);
   
   TRACE_M(TF_LIGHT_M, "PresentGeneric = %d,\r\n", bLevelParam->Present_Level16);
   TRACE_M(TF_LIGHT_M, "Present Level value %d\r\n", Light_CtlStatus[elementIndex].PresentCtlTemperature16); 
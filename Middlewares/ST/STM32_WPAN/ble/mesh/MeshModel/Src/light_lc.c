@@ -25,6 +25,7 @@
 #include "common.h"
 #include "light_lc.h"
 #include <string.h>
+#include <stdint.h>
 #include "compiler.h"
 
 
@@ -94,8 +95,6 @@ typedef struct
   const light_lc_propertyId_t* pPropertyId;
   /* LC property value table */
   MOBLEUINT32 propertyValue[LC_PROPERTY_TABLE_COUNT];
-  /* LC TID struct */
-  tid_param_t lastMsgTidParams;
   /* LC transition struct */
   transition_params_t transitionParams;
   /* Actual value to be multiplied with 0.01 */
@@ -172,6 +171,11 @@ typedef struct
 #define LC_REGULATOR_KPD_PID_INDEX                             16
 #define LC_REGULATOR_KPU_PID_INDEX                             17
 
+#if (LIGHT_LC_REGULATOR_FIXED_POINT == 1)
+/* Fractional bits of the regulator coefficients and internal sum */
+#define LC_REGULATOR_Q                                         16
+#endif
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 #ifdef ENABLE_LIGHT_MODEL_SERVER_LC
@@ -1422,8 +1426,8 @@ MOBLE_RESULT Light_LC_OnOffSetUnack(lc_param_t* pLcParams,
 
   if(result == MOBLE_RESULT_SUCCESS)
   {
-    /* TID check and update */
-    if(Tid_CheckAndUpdate(tid, pmsgParam->peer_addr, pmsgParam->dst_peer, &pLcParams->lastMsgTidParams) == 0)
+    /* TID check and update, shared with the other model servers */
+    if(MOBLE_FAILED(Chk_TidValidity(pmsgParam->peer_addr, pmsgParam->dst_peer, tid)))
     {
       result = MOBLE_RESULT_FAIL;
       TRACE_I(TF_LIGHT_LC_M, "Old message dropped\r\n");
@@ -1949,6 +1953,62 @@ MOBLE_RESULT Light_LC_InitialTargetValueUpdatePid(lc_param_t* pLcParams,
 }
 
 
+#if (LIGHT_LC_REGULATOR_FIXED_POINT == 1)
+/**
+  * @brief  Conversion of a regulator coefficient property (IEEE 754 single
+  *         precision) to Q16.16 without floating point operation
+  *         Out of range values are saturated, NaN is handled as 0
+  * @param  Raw value of the coefficient property
+  * @retval Coefficient in Q16.16
+  */
+static
+MOBLEINT32 Light_LC_CoefficientToFixed(MOBLEUINT32 floatValue)
+{
+  MOBLEINT32 exponent = (MOBLEINT32)((floatValue >> 23) & 0xFF);
+  MOBLEUINT32 mantissa = (floatValue & 0x007FFFFF) | 0x00800000;
+  MOBLEINT32 shift;
+  MOBLEINT32 fixedValue;
+  
+  if(exponent == 0 || 
+     (exponent == 0xFF && (floatValue & 0x007FFFFF) != 0))
+  {
+    /* Zero, subnormal or NaN */
+    fixedValue = 0;
+  }
+  else
+  {
+    /* value = mantissa * 2^(exponent - 127 - 23), Q16.16 is value * 2^16 */
+    shift = exponent - 127 - 23 + LC_REGULATOR_Q;
+    
+    if(shift > 7)
+    {
+      fixedValue = 0x7FFFFFFF;
+    }
+    else if(shift >= 0)
+    {
+      fixedValue = (MOBLEINT32)(mantissa << shift);
+    }
+    else if(shift > -25)
+    {
+      /* Rounded to nearest */
+      fixedValue = (MOBLEINT32)((mantissa + (1UL << (-shift - 1))) >> (-shift));
+    }
+    else
+    {
+      fixedValue = 0;
+    }
+    
+    if((floatValue & 0x80000000) != 0)
+    {
+      fixedValue = -fixedValue;
+    }
+  }
+  
+  return fixedValue;
+}
+#endif
+
+
 /**
   * @brief  PI regulator to adjust ambient level
   *         Magnified values are used for optimizing case when regulator input is 0
@@ -1960,9 +2020,14 @@ MOBLEUINT16 Light_LC_PIregulator(lc_param_t* pLcParams)
 {
   MOBLEUINT32 tempU32i = 0;
   MOBLEUINT32 tempU32p = 0;
+#if (LIGHT_LC_REGULATOR_FIXED_POINT == 1)
+  int64_t tempFixed = 0;
+  MOBLEINT32 coefficient = 0;
+#else
   MOBLEUINT32* pU32temp = 0;
   float* pFtemp;
   float tempFloat = 0;
+#endif
   MOBLEUINT16 regulatorOutput = 0;
   MOBLEINT32 error = 0;
   MOBLEINT32 accuracy = 0;
@@ -2048,12 +2113,53 @@ MOBLEUINT16 Light_LC_PIregulator(lc_param_t* pLcParams)
                                 &tempU32p);
     }
         
+#if (LIGHT_LC_REGULATOR_FIXED_POINT == 1)
+    /* Regulator input is 100x
+       Time is 1000x
+       Coefficients and internal sum in Q16.16
+       Quotient and remainder are scaled separately to stay in 64 bits */
+    coefficient = Light_LC_CoefficientToFixed(tempU32i);
+    tempFixed = (int64_t)regulatorInput * (MOBLEINT32)summationIntervalMs;
+    tempFixed = ((int64_t)pLcParams->piLastInternalSum << LC_REGULATOR_Q) + \
+                (tempFixed / 100000) * coefficient + \
+                ((tempFixed % 100000) * coefficient) / 100000;
+
+    if(tempFixed < 0) /* summation interval range is 0 - 65535 */
+    {
+      pLcParams->piLastInternalSum = 0;
+    }
+    else if(tempFixed > ((int64_t)65535 << LC_REGULATOR_Q))
+    {
+      pLcParams->piLastInternalSum = 65535;
+    }
+    else
+    {
+      pLcParams->piLastInternalSum = (MOBLEUINT16)(tempFixed >> LC_REGULATOR_Q);
+    }
+
+    /* Regulator input is 100x */
+    tempFixed = (((int64_t)pLcParams->piLastInternalSum << LC_REGULATOR_Q) + \
+                 (int64_t)regulatorInput * Light_LC_CoefficientToFixed(tempU32p))/100;
+
+    if(tempFixed < 0)
+    {
+      regulatorOutput = 0;
+    }
+    else if(tempFixed > ((int64_t)65535 << LC_REGULATOR_Q))
+    {
+      regulatorOutput = 65535;
+    }
+    else
+    {
+      regulatorOutput = (MOBLEUINT16)(tempFixed >> LC_REGULATOR_Q);
+    }
+#else
     /* Regulator input is 100x
        Time is 1000x */
     pU32temp = &tempU32i;
     pFtemp = (float*)pU32temp;
     tempFloat = (MOBLEINT32)pLcParams->piLastInternalSum + \
-                (regulatorInput * summationIntervalMs * (*pFtemp))/100000;
+                (regulatorInput * (MOBLEINT32)summationIntervalMs * (*pFtemp))/100000;
 
     if(tempFloat < 0) /* summation interval range is 0 - 65535 */
     {
@@ -2085,6 +2191,7 @@ MOBLEUINT16 Light_LC_PIregulator(lc_param_t* pLcParams)
     {
       regulatorOutput = (MOBLEUINT16)tempFloat;
     }
+#endif
   }
   else /* regulator input is 0, no change in output */
   {
@@ -0,0 +1,31 @@
+/**
+ ******************************************************************************
+ * @file    app_conf.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the application configuration for the Linux host
+ *          build of the mesh models
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The configuration of the application pulls the HAL, the models only use
+ * CFG_DEBUG_TRACE. The traces are off, the host programs print the results.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_CONF_H
+#define APP_CONF_H
+
+#define CFG_DEBUG_TRACE                                                     0
+
+#endif /*APP_CONF_H */
@@ -0,0 +1,42 @@
+/**
+ ******************************************************************************
+ * @file    hal_common.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the board header for the Linux host build of the mesh
+ *          models
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The header of the application selects the board and pulls the HAL. The
+ * models only need the C library, the mesh types and the clock, whose
+ * HAL_GetTick() is provided by the host programs.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef _HAL_H_
+#define _HAL_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "host_types.h"
+#include "ble_clock.h"
+
+uint32_t HAL_GetTick(void);
+
+#endif /* _HAL_H_ */
@@ -0,0 +1,43 @@
+/**
+ ******************************************************************************
+ * @file    host_types.h
+ * @author  MCD Application Team
+ * @brief   32-bit mesh types for the Linux host build of the mesh models
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * MOBLEUINT32 and MOBLEINT32 are long in the mesh types.h, 64-bit on a
+ * x86-64 host. They are renamed while types.h is included then defined with
+ * the 32-bit width of the target, so that the models compute with the same
+ * wrap-around and integer promotions as on the Cortex-M4. hal_common.h is the
+ * first header of the models, the later includes of types.h are guarded.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_TYPES_H
+#define HOST_TYPES_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#define MOBLEINT32 MOBLEINT32_LP64
+#define MOBLEUINT32 MOBLEUINT32_LP64
+#include "../../Inc/types.h"
+#undef MOBLEINT32
+#undef MOBLEUINT32
+
+typedef int32_t MOBLEINT32;
+typedef uint32_t MOBLEUINT32;
+
+#endif /* HOST_TYPES_H */
@@ -0,0 +1,458 @@
+/**
+ ******************************************************************************
+ * @file    light_conv_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host test and benchmark of the Light Lightness and Light CTL
+ *          temperature conversions
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Each conversion of the models is run over its full input range and compared
+ * with two references:
+ *
+ *   exact  the formula of the Mesh Model specification evaluated in long
+ *          double, truncated or rounded as the model does
+ *   float  the previous floating point code of light.c and generic.c, copied
+ *          below as it was
+ *
+ *   actual->linear  Lightness_ActualToLinear()       Actual 0..65535
+ *   linear->actual  Lightness_LinearToActual()       Linear 0..65535
+ *   linear update   Light_LightnessLinearUpdate()    Linear 0..65535
+ *   level->temp     GenericLevel_CtlTempBinding()    Level -32768..32767
+ *   temp->level     Light_CtlTemp_GenericLevelBinding()
+ *                                                    Temperature T_MIN..T_MAX
+ *
+ * The integer conversions must be equal to the previous code on every input.
+ * The linear update computed sqrt() in double and is exact. The other previous
+ * conversions computed in single precision float, which is one LSB off the
+ * exact formula on some inputs: the models correct their integer result on
+ * these inputs, which are counted against the exact reference.
+ *
+ * The benchmark runs <passes> times the full range of the lightness
+ * conversions, with the previous float code then with the integer one, and
+ * reports the ns per conversion.
+ *
+ * Usage: light_conv_host [-p passes] [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hal_common.h"
+#include "ble_mesh.h"
+#include "common.h"
+#include "light.h"
+#include "generic.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define LIGHT_CONV_HOST_MAX_ERRORS      (10U)
+#define LIGHT_CONV_HOST_ELEMENT_INDEX   (0U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  LIGHT_CONV_HOST_ACTUAL_TO_LINEAR,
+  LIGHT_CONV_HOST_LINEAR_TO_ACTUAL,
+  LIGHT_CONV_HOST_LINEAR_UPDATE,
+  LIGHT_CONV_HOST_LEVEL_TO_TEMP,
+  LIGHT_CONV_HOST_TEMP_TO_LEVEL,
+  LIGHT_CONV_HOST_CONV_NBR,
+} LIGHT_CONV_HOST_Conv_t;
+
+typedef struct
+{
+  const char *p_Name;
+  int32_t First;
+  int32_t Last;
+} LIGHT_CONV_HOST_ConvDesc_t;
+
+typedef struct
+{
+  uint32_t InputNbr;
+  uint32_t ExactDiffNbr;
+  int32_t ExactMaxDiff;
+  double FloatNs;
+  double IntNs;
+} LIGHT_CONV_HOST_Result_t;
+
+/* Global variables ----------------------------------------------------------*/
+/**
+ * Callbacks of the application, none: the conversions are read back from the status messages
+ */
+const Appli_Light_cb_t LightAppli_cb;
+
+/* Private variables ---------------------------------------------------------*/
+static const LIGHT_CONV_HOST_ConvDesc_t ConvDesc[LIGHT_CONV_HOST_CONV_NBR] =
+{
+  { "actual->linear", 0, 65535 },
+  { "linear->actual", 0, 65535 },
+  { "linear update",  0, 65535 },
+  { "level->temp",    -32768, 32767 },
+  { "temp->level",    MIN_CTL_TEMP_RANGE, MAX_CTL_TEMP_RANGE },
+};
+
+static uint32_t PassNbr = 200U;
+static const char *CsvFile;
+
+static LIGHT_CONV_HOST_Result_t Result[LIGHT_CONV_HOST_CONV_NBR];
+static volatile uint32_t Sink;
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t LIGHT_CONV_HOST_Int( LIGHT_CONV_HOST_Conv_t Conv, int32_t Input );
+static int32_t LIGHT_CONV_HOST_Exact( LIGHT_CONV_HOST_Conv_t Conv, int32_t Input );
+static int32_t LIGHT_CONV_HOST_Float( LIGHT_CONV_HOST_Conv_t Conv, int32_t Input );
+static void LIGHT_CONV_HOST_Check( LIGHT_CONV_HOST_Conv_t Conv );
+static void LIGHT_CONV_HOST_Benchmark( void );
+static uint64_t LIGHT_CONV_HOST_NowNs( void );
+static void LIGHT_CONV_HOST_Error( LIGHT_CONV_HOST_Conv_t Conv, int32_t Input, const char *p_Ref, int32_t Ref,
+                                   int32_t Value );
+static void LIGHT_CONV_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  LIGHT_CONV_HOST_Conv_t conv;
+  FILE *p_csv;
+  int opt;
+
+  while((opt = getopt(argc, argv, "p:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'p':
+        PassNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        LIGHT_CONV_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  if(PassNbr == 0U)
+  {
+    LIGHT_CONV_HOST_Usage(argv[0]);
+  }
+
+  for(conv = LIGHT_CONV_HOST_ACTUAL_TO_LINEAR; conv < LIGHT_CONV_HOST_CONV_NBR; conv++)
+  {
+    LIGHT_CONV_HOST_Check(conv);
+  }
+  LIGHT_CONV_HOST_Benchmark();
+
+  for(conv = LIGHT_CONV_HOST_ACTUAL_TO_LINEAR; conv < LIGHT_CONV_HOST_CONV_NBR; conv++)
+  {
+    printf("%-14s: %5u inputs, equal to float, exact differs on %3u inputs by up to %d LSB", ConvDesc[conv].p_Name,
+           Result[conv].InputNbr, Result[conv].ExactDiffNbr, Result[conv].ExactMaxDiff);
+    if(Result[conv].IntNs != 0)
+    {
+      printf(", %.1f ns float, %.1f ns integer", Result[conv].FloatNs, Result[conv].IntNs);
+    }
+    printf("\n");
+  }
+  printf("%u errors\n", ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "conversion,inputs,exact_diff_inputs,exact_max_diff_lsb,float_ns,integer_ns,errors\n");
+      }
+      for(conv = LIGHT_CONV_HOST_ACTUAL_TO_LINEAR; conv < LIGHT_CONV_HOST_CONV_NBR; conv++)
+      {
+        fprintf(p_csv, "%s,%u,%u,%d,%.1f,%.1f,%u\n", ConvDesc[conv].p_Name, Result[conv].InputNbr,
+                Result[conv].ExactDiffNbr, Result[conv].ExactMaxDiff, Result[conv].FloatNs, Result[conv].IntNs,
+                ErrorNbr);
+      }
+      fclose(p_csv);
+    }
+  }
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief Conversion by the models, read back from the status messages for the bindings
+ */
+static int32_t LIGHT_CONV_HOST_Int( LIGHT_CONV_HOST_Conv_t Conv, int32_t Input )
+{
+  MODEL_MessageHeader_t msg_param;
+  Generic_LevelStatus_t level_param;
+  Light_CtlStatus_t ctl_param;
+  MOBLEUINT8 status[16];
+  MOBLEUINT32 length;
+  int32_t value;
+
+  memset(&msg_param, 0, sizeof(msg_param));
+  msg_param.elementIndex = LIGHT_CONV_HOST_ELEMENT_INDEX;
+
+  switch(Conv)
+  {
+    case LIGHT_CONV_HOST_ACTUAL_TO_LINEAR:
+      value = Lightness_ActualToLinear((MOBLEUINT16)Input);
+      break;
+
+    case LIGHT_CONV_HOST_LINEAR_TO_ACTUAL:
+      value = Lightness_LinearToActual((MOBLEUINT16)Input);
+      break;
+
+    case LIGHT_CONV_HOST_LINEAR_UPDATE:
+      Light_LightnessLinearUpdate(LIGHT_CONV_HOST_ELEMENT_INDEX, (MOBLEUINT16)Input);
+      (void)Light_Lightness_Status(status, &length, &msg_param);
+      value = status[0] | (status[1] << 8);
+      break;
+
+    case LIGHT_CONV_HOST_LEVEL_TO_TEMP:
+      memset(&level_param, 0, sizeof(level_param));
+      level_param.Present_Level16 = (MOBLEINT16)Input;
+      GenericLevel_CtlTempBinding(&level_param, LIGHT_CONV_HOST_ELEMENT_INDEX);
+      (void)Light_CtlTemperature_Status(status, &length, &msg_param);
+      value = status[0] | (status[1] << 8);
+      break;
+
+    case LIGHT_CONV_HOST_TEMP_TO_LEVEL:
+    default:
+      memset(&ctl_param, 0, sizeof(ctl_param));
+      ctl_param.PresentCtlTemperature16 = (MOBLEUINT16)Input;
+      Light_CtlTemp_GenericLevelBinding(&ctl_param, LIGHT_CONV_HOST_ELEMENT_INDEX, 0, 0);
+      (void)Generic_Level_Status(status, &length, &msg_param);
+      value = (int16_t)(status[0] | (status[1] << 8));
+      break;
+  }
+
+  return value;
+}
+
+/**
+ * @brief Formulas of the Mesh Model specification 6.1.2.1.1 and 6.1.3.1.1, in long double
+ */
+static int32_t LIGHT_CONV_HOST_Exact( LIGHT_CONV_HOST_Conv_t Conv, int32_t Input )
+{
+  long double range = (long double)(MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE);
+  int32_t value;
+
+  switch(Conv)
+  {
+    case LIGHT_CONV_HOST_ACTUAL_TO_LINEAR:
+      value = (int32_t)floorl(65535.0L * powl((long double)Input / 65535.0L, 2));
+      break;
+
+    case LIGHT_CONV_HOST_LINEAR_TO_ACTUAL:
+    case LIGHT_CONV_HOST_LINEAR_UPDATE:
+      value = (int32_t)floorl(sqrtl((long double)Input * 65535.0L));
+      break;
+
+    case LIGHT_CONV_HOST_LEVEL_TO_TEMP:
+      value = MIN_CTL_TEMP_RANGE + (int32_t)roundl(((long double)Input + 32768.0L) * range / 65535.0L);
+      break;
+
+    case LIGHT_CONV_HOST_TEMP_TO_LEVEL:
+    default:
+      value = (int32_t)roundl(((long double)Input - MIN_CTL_TEMP_RANGE) * 65535.0L / range) - 32768;
+      break;
+  }
+
+  return value;
+}
+
+/**
+ * @brief Previous code of Light_Actual_LinearBinding(), Light_Linear_ActualBinding(),
+ *        Light_LightnessLinearUpdate(), GenericLevel_CtlTempBinding() and Light_CtlTemp_GenericLevelBinding()
+ */
+static int32_t LIGHT_CONV_HOST_Float( LIGHT_CONV_HOST_Conv_t Conv, int32_t Input )
+{
+  float productValue;
+  MOBLEUINT32 product;
+  int32_t value;
+
+  switch(Conv)
+  {
+    case LIGHT_CONV_HOST_ACTUAL_TO_LINEAR:
+      productValue = pow((((float)Input)/65535) , 2);
+      value = (MOBLEUINT16)(65535 * productValue);
+      break;
+
+    case LIGHT_CONV_HOST_LINEAR_TO_ACTUAL:
+      productValue = sqrt((((float)Input) / 65535));
+      value = (MOBLEUINT16)(65535 * productValue);
+      break;
+
+    case LIGHT_CONV_HOST_LINEAR_UPDATE:
+      value = (MOBLEUINT16)(sqrt((double)Input * (double)65535));
+      break;
+
+    case LIGHT_CONV_HOST_LEVEL_TO_TEMP:
+      product = (Input + 32768) * (MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE) ;
+      value = (MOBLEUINT16)(MIN_CTL_TEMP_RANGE + round(((product) / (float)65535)));
+      break;
+
+    case LIGHT_CONV_HOST_TEMP_TO_LEVEL:
+    default:
+      product = (Input - MIN_CTL_TEMP_RANGE) * 65535;
+      value = (MOBLEINT16)(round((product / (float)(MAX_CTL_TEMP_RANGE - MIN_CTL_TEMP_RANGE))) - 32768);
+      break;
+  }
+
+  return value;
+}
+
+static void LIGHT_CONV_HOST_Check( LIGHT_CONV_HOST_Conv_t Conv )
+{
+  int32_t input;
+  int32_t value;
+  int32_t exact;
+  int32_t ref;
+  int32_t diff;
+
+  for(input = ConvDesc[Conv].First; input <= ConvDesc[Conv].Last; input++)
+  {
+    value = LIGHT_CONV_HOST_Int(Conv, input);
+    exact = LIGHT_CONV_HOST_Exact(Conv, input);
+    ref = LIGHT_CONV_HOST_Float(Conv, input);
+
+    if(value != ref)
+    {
+      LIGHT_CONV_HOST_Error(Conv, input, "float", ref, value);
+    }
+
+    diff = abs(exact - value);
+    if(diff != 0)
+    {
+      Result[Conv].ExactDiffNbr++;
+      if(diff > Result[Conv].ExactMaxDiff)
+      {
+        Result[Conv].ExactMaxDiff = diff;
+      }
+    }
+    Result[Conv].InputNbr++;
+  }
+
+  return;
+}
+
+/**
+ * @brief Cost of the lightness conversions, run on each step of a transition
+ */
+static void LIGHT_CONV_HOST_Benchmark( void )
+{
+  LIGHT_CONV_HOST_Conv_t conv;
+  uint64_t start_time;
+  uint32_t pass;
+  uint32_t input;
+  uint32_t sum;
+  float productValue;
+  double conv_nbr;
+
+  conv_nbr = (double)PassNbr * 65536.0;
+
+  for(conv = LIGHT_CONV_HOST_ACTUAL_TO_LINEAR; conv <= LIGHT_CONV_HOST_LINEAR_UPDATE; conv++)
+  {
+    sum = 0;
+    start_time = LIGHT_CONV_HOST_NowNs();
+    for(pass = 0; pass < PassNbr; pass++)
+    {
+      for(input = 0; input <= 65535U; input++)
+      {
+        if(conv == LIGHT_CONV_HOST_ACTUAL_TO_LINEAR)
+        {
+          productValue = pow((((float)input)/65535) , 2);
+          sum += (MOBLEUINT16)(65535 * productValue);
+        }
+        else if(conv == LIGHT_CONV_HOST_LINEAR_TO_ACTUAL)
+        {
+          productValue = sqrt((((float)input) / 65535));
+          sum += (MOBLEUINT16)(65535 * productValue);
+        }
+        else
+        {
+          sum += (MOBLEUINT16)(sqrt((double)input * (double)65535));
+        }
+      }
+    }
+    Result[conv].FloatNs = (double)(LIGHT_CONV_HOST_NowNs() - start_time) / conv_nbr;
+    Sink = sum;
+
+    sum = 0;
+    start_time = LIGHT_CONV_HOST_NowNs();
+    for(pass = 0; pass < PassNbr; pass++)
+    {
+      for(input = 0; input <= 65535U; input++)
+      {
+        if(conv == LIGHT_CONV_HOST_ACTUAL_TO_LINEAR)
+        {
+          sum += Lightness_ActualToLinear((MOBLEUINT16)input);
+        }
+        else if(conv == LIGHT_CONV_HOST_LINEAR_TO_ACTUAL)
+        {
+          sum += Lightness_LinearToActual((MOBLEUINT16)input);
+        }
+        else
+        {
+          sum += (MOBLEUINT16)Sqrt_CalculateValue(input * 65535U);
+        }
+      }
+    }
+    Result[conv].IntNs = (double)(LIGHT_CONV_HOST_NowNs() - start_time) / conv_nbr;
+    Sink = sum;
+  }
+
+  return;
+}
+
+static uint64_t LIGHT_CONV_HOST_NowNs( void )
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static void LIGHT_CONV_HOST_Error( LIGHT_CONV_HOST_Conv_t Conv, int32_t Input, const char *p_Ref, int32_t Ref,
+                                   int32_t Value )
+{
+  if(ErrorNbr < LIGHT_CONV_HOST_MAX_ERRORS)
+  {
+    printf("error: %s of %d: %d, %s %d\n", ConvDesc[Conv].p_Name, Input, Value, p_Ref, Ref);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static void LIGHT_CONV_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s [-p passes] [-c csv]\n", p_Name);
+  exit(2);
+}
+
+/**
+ * @brief Clock of the models, the conversions do not depend on it
+ */
+uint32_t HAL_GetTick( void )
+{
+  return 0;
+}
@@ -0,0 +1,402 @@
+/**
+ ******************************************************************************
+ * @file    light_lc_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host replay of ambient lux traces through the floating point
+ *          and the fixed point Light LC PI regulators
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Light_LC_PIregulator() of light_lc.c is built with
+ * LIGHT_LC_REGULATOR_FIXED_POINT 0 (float) and 1 (fixed, Q16.16). Each trace
+ * of <reports> ambient lux level reports is replayed through both, each report
+ * <interval> ms after the previous one, the interval drawn between 5 and
+ * 125 ms so that the summation interval of the regulator is 0 (under 10 ms),
+ * proportional or clamped to 100 ms. The traces are synthetic, the sensor
+ * does not see the light of the regulated lamp:
+ *
+ *   daylight  slow rise and fall of the daylight around the target, with noise
+ *   steps     step changes of the ambient level every 50 to 2000 reports
+ *   flicker   fast swings of up to 50% around the target
+ *
+ * Each trace is run for 3 lux targets and 4 sets of coefficients, the Mesh
+ * Model default set (Kiu 250, Kid 25, Kpu 80, Kpd 80) and sets 10 times
+ * smaller, 4 times larger and 40 times larger. The Light LC Regulator Accuracy
+ * property is 0: light_lc.c scales it to a dead band of 100 times the one of
+ * the specification (the 2% default reads as 200% of the target), which would
+ * leave the regulator idle on most reports.
+ *
+ * The outputs of the fixed point regulator must not differ from the outputs
+ * of the float one by more than 1 LSB of Light Lightness Linear. The float
+ * and the fixed point regulators are then timed alone on the same traces, in
+ * cycles of the host time stamp counter, which counts at the nominal
+ * frequency of the CPU, and in ns per call.
+ *
+ * Usage: light_lc_host [-n reports] [-s seed] [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <x86intrin.h>
+
+#include "hal_common.h"
+#include "light_lc_regulator_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define LIGHT_LC_HOST_MAX_ERRORS        (10U)
+#define LIGHT_LC_HOST_ALLOWED_LSB       (1)
+#define LIGHT_LC_HOST_MIN_INTERVAL_MS   (5U)
+#define LIGHT_LC_HOST_MAX_INTERVAL_MS   (125U)
+/* Accuracy property, no dead band (see above) */
+#define LIGHT_LC_HOST_ACCURACY          (0U)
+#define LIGHT_LC_HOST_TARGET_NBR        (3U)
+#define LIGHT_LC_HOST_COEFF_NBR         (4U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  LIGHT_LC_HOST_TRACE_DAYLIGHT,
+  LIGHT_LC_HOST_TRACE_STEPS,
+  LIGHT_LC_HOST_TRACE_FLICKER,
+  LIGHT_LC_HOST_TRACE_NBR,
+} LIGHT_LC_HOST_Trace_t;
+
+typedef struct
+{
+  float Kiu;
+  float Kid;
+  float Kpu;
+  float Kpd;
+} LIGHT_LC_HOST_Coeff_t;
+
+typedef struct
+{
+  uint32_t ReportNbr;
+  uint32_t DiffNbr;
+  int32_t MaxDiff;
+  uint64_t FloatCycles;
+  uint64_t FixedCycles;
+  uint64_t FloatNs;
+  uint64_t FixedNs;
+} LIGHT_LC_HOST_Result_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *TraceName[LIGHT_LC_HOST_TRACE_NBR] = { "daylight", "steps", "flicker" };
+
+/* Light LC Lux Level On property, lux */
+static const uint32_t Target[LIGHT_LC_HOST_TARGET_NBR] = { 100U, 500U, 2000U };
+
+static const LIGHT_LC_HOST_Coeff_t Coeff[LIGHT_LC_HOST_COEFF_NBR] =
+{
+  { 250.0f, 25.0f, 80.0f, 80.0f },
+  { 25.0f, 2.5f, 8.0f, 8.0f },
+  { 1000.0f, 100.0f, 320.0f, 320.0f },
+  { 10000.0f, 1000.0f, 3200.0f, 3200.0f },
+};
+
+static uint32_t ReportNbr = 20000U;
+static uint32_t Seed = 1U;
+static const char *CsvFile;
+
+static uint32_t *p_Ambient;
+static uint32_t *p_Interval;
+static uint16_t *p_FloatOut;
+static uint16_t *p_FixedOut;
+static uint32_t Tick;
+static uint32_t Random;
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static void LIGHT_LC_HOST_MakeTrace( LIGHT_LC_HOST_Trace_t Trace, uint32_t TargetLux );
+static void LIGHT_LC_HOST_Replay( const LIGHT_LC_REGULATOR_HOST_Config_t *p_Config, uint16_t *p_Out,
+                                  void (*Init)( uint32_t Instance, const LIGHT_LC_REGULATOR_HOST_Config_t *p_Config ),
+                                  uint16_t (*Run)( uint32_t Instance, uint32_t AmbientLuxLevel ),
+                                  uint64_t *p_Cycles, uint64_t *p_Ns );
+static uint32_t LIGHT_LC_HOST_FloatBits( float Value );
+static uint32_t LIGHT_LC_HOST_Random( uint32_t Range );
+static uint64_t LIGHT_LC_HOST_NowNs( void );
+static void LIGHT_LC_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  LIGHT_LC_REGULATOR_HOST_Config_t config;
+  LIGHT_LC_HOST_Result_t result[LIGHT_LC_HOST_TRACE_NBR];
+  LIGHT_LC_HOST_Result_t total;
+  LIGHT_LC_HOST_Trace_t trace;
+  uint32_t target;
+  uint32_t coeff;
+  uint32_t report;
+  int32_t diff;
+  uint64_t cycles;
+  uint64_t ns;
+  FILE *p_csv;
+  int opt;
+
+  while((opt = getopt(argc, argv, "n:s:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'n':
+        ReportNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 's':
+        Seed = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        LIGHT_LC_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  if(ReportNbr == 0U)
+  {
+    LIGHT_LC_HOST_Usage(argv[0]);
+  }
+
+  p_Ambient = malloc(ReportNbr * sizeof(uint32_t));
+  p_Interval = malloc(ReportNbr * sizeof(uint32_t));
+  p_FloatOut = malloc(ReportNbr * sizeof(uint16_t));
+  p_FixedOut = malloc(ReportNbr * sizeof(uint16_t));
+  if((p_Ambient == NULL) || (p_Interval == NULL) || (p_FloatOut == NULL) || (p_FixedOut == NULL))
+  {
+    fprintf(stderr, "out of memory\n");
+    return 2;
+  }
+
+  memset(result, 0, sizeof(result));
+  memset(&total, 0, sizeof(total));
+  Random = Seed;
+
+  for(trace = LIGHT_LC_HOST_TRACE_DAYLIGHT; trace < LIGHT_LC_HOST_TRACE_NBR; trace++)
+  {
+    for(target = 0; target < LIGHT_LC_HOST_TARGET_NBR; target++)
+    {
+      LIGHT_LC_HOST_MakeTrace(trace, Target[target]);
+
+      for(coeff = 0; coeff < LIGHT_LC_HOST_COEFF_NBR; coeff++)
+      {
+        config.Kiu = LIGHT_LC_HOST_FloatBits(Coeff[coeff].Kiu);
+        config.Kid = LIGHT_LC_HOST_FloatBits(Coeff[coeff].Kid);
+        config.Kpu = LIGHT_LC_HOST_FloatBits(Coeff[coeff].Kpu);
+        config.Kpd = LIGHT_LC_HOST_FloatBits(Coeff[coeff].Kpd);
+        config.Accuracy = LIGHT_LC_HOST_ACCURACY;
+        config.LuxLevelOut = Target[target];
+
+        LIGHT_LC_HOST_Replay(&config, p_FloatOut, LIGHT_LC_REGULATOR_HOST_InitFloat, LIGHT_LC_REGULATOR_HOST_RunFloat,
+                             &cycles, &ns);
+        result[trace].FloatCycles += cycles;
+        result[trace].FloatNs += ns;
+        LIGHT_LC_HOST_Replay(&config, p_FixedOut, LIGHT_LC_REGULATOR_HOST_InitFixed, LIGHT_LC_REGULATOR_HOST_RunFixed,
+                             &cycles, &ns);
+        result[trace].FixedCycles += cycles;
+        result[trace].FixedNs += ns;
+
+        for(report = 0; report < ReportNbr; report++)
+        {
+          diff = abs((int32_t)p_FixedOut[report] - (int32_t)p_FloatOut[report]);
+          if(diff != 0)
+          {
+            result[trace].DiffNbr++;
+            if(diff > result[trace].MaxDiff)
+            {
+              result[trace].MaxDiff = diff;
+            }
+            if(diff > LIGHT_LC_HOST_ALLOWED_LSB)
+            {
+              if(ErrorNbr < LIGHT_LC_HOST_MAX_ERRORS)
+              {
+                printf("error: %s trace, target %u lux, coefficients %u, report %u: float %u, fixed %u\n",
+                       TraceName[trace], Target[target], coeff, report, p_FloatOut[report], p_FixedOut[report]);
+              }
+              ErrorNbr++;
+            }
+          }
+        }
+        result[trace].ReportNbr += ReportNbr;
+      }
+    }
+
+    total.ReportNbr += result[trace].ReportNbr;
+    total.DiffNbr += result[trace].DiffNbr;
+    total.MaxDiff = (result[trace].MaxDiff > total.MaxDiff) ? result[trace].MaxDiff : total.MaxDiff;
+    total.FloatCycles += result[trace].FloatCycles;
+    total.FixedCycles += result[trace].FixedCycles;
+    total.FloatNs += result[trace].FloatNs;
+    total.FixedNs += result[trace].FixedNs;
+  }
+
+  for(trace = LIGHT_LC_HOST_TRACE_DAYLIGHT; trace <= LIGHT_LC_HOST_TRACE_NBR; trace++)
+  {
+    LIGHT_LC_HOST_Result_t *p_result = (trace == LIGHT_LC_HOST_TRACE_NBR) ? &total : &result[trace];
+    const char *p_name = (trace == LIGHT_LC_HOST_TRACE_NBR) ? "all" : TraceName[trace];
+
+    printf("%-8s: %7u reports, %5u outputs differ by up to %d LSB, float %.1f cycles %.1f ns, "
+           "fixed %.1f cycles %.1f ns per call\n", p_name, p_result->ReportNbr, p_result->DiffNbr, p_result->MaxDiff,
+           (double)p_result->FloatCycles / p_result->ReportNbr, (double)p_result->FloatNs / p_result->ReportNbr,
+           (double)p_result->FixedCycles / p_result->ReportNbr, (double)p_result->FixedNs / p_result->ReportNbr);
+
+    if(CsvFile != NULL)
+    {
+      p_csv = fopen(CsvFile, "a");
+      if(p_csv != NULL)
+      {
+        if(ftell(p_csv) == 0)
+        {
+          fprintf(p_csv, "trace,reports,diff_outputs,max_diff_lsb,float_cycles,float_ns,fixed_cycles,fixed_ns,"
+                  "errors\n");
+        }
+        fprintf(p_csv, "%s,%u,%u,%d,%.1f,%.1f,%.1f,%.1f,%u\n", p_name, p_result->ReportNbr, p_result->DiffNbr,
+                p_result->MaxDiff, (double)p_result->FloatCycles / p_result->ReportNbr,
+                (double)p_result->FloatNs / p_result->ReportNbr, (double)p_result->FixedCycles / p_result->ReportNbr,
+                (double)p_result->FixedNs / p_result->ReportNbr, ErrorNbr);
+        fclose(p_csv);
+      }
+    }
+  }
+  printf("%u errors\n", ErrorNbr);
+
+  free(p_Ambient);
+  free(p_Interval);
+  free(p_FloatOut);
+  free(p_FixedOut);
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/**
+ * @brief Clock of the models, the simulated time of the trace in ms
+ */
+uint32_t HAL_GetTick( void )
+{
+  return Tick;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief Ambient lux levels, in 0.01 lux, and report intervals of a trace around a target
+ */
+static void LIGHT_LC_HOST_MakeTrace( LIGHT_LC_HOST_Trace_t Trace, uint32_t TargetLux )
+{
+  uint32_t report;
+  uint32_t next_step;
+  int64_t level;
+  int64_t target;
+
+  target = (int64_t)TargetLux * 100;
+  level = target;
+  next_step = 0;
+
+  for(report = 0; report < ReportNbr; report++)
+  {
+    switch(Trace)
+    {
+      case LIGHT_LC_HOST_TRACE_DAYLIGHT:
+        /* From 0 to twice the target and back down over the trace, 1% noise */
+        level = (2 * target * (int64_t)(ReportNbr / 2 - abs((int32_t)report - (int32_t)(ReportNbr / 2)))) /
+                (ReportNbr / 2 + 1);
+        level += ((int64_t)LIGHT_LC_HOST_Random(2001U) - 1000) * target / 100000;
+        break;
+
+      case LIGHT_LC_HOST_TRACE_STEPS:
+        if(report == next_step)
+        {
+          level = ((int64_t)LIGHT_LC_HOST_Random(301U) * target) / 100;
+          next_step = report + 50U + LIGHT_LC_HOST_Random(1951U);
+        }
+        break;
+
+      case LIGHT_LC_HOST_TRACE_FLICKER:
+      default:
+        level = target + (((int64_t)LIGHT_LC_HOST_Random(1001U) - 500) * target) / 1000;
+        break;
+    }
+
+    p_Ambient[report] = (level < 0) ? 0U : (uint32_t)level;
+    p_Interval[report] = LIGHT_LC_HOST_MIN_INTERVAL_MS +
+                         LIGHT_LC_HOST_Random(LIGHT_LC_HOST_MAX_INTERVAL_MS - LIGHT_LC_HOST_MIN_INTERVAL_MS + 1U);
+  }
+
+  return;
+}
+
+/**
+ * @brief Replay of the trace through one regulator, the time includes the loop over the reports
+ */
+static void LIGHT_LC_HOST_Replay( const LIGHT_LC_REGULATOR_HOST_Config_t *p_Config, uint16_t *p_Out,
+                                  void (*Init)( uint32_t Instance, const LIGHT_LC_REGULATOR_HOST_Config_t *p_Config ),
+                                  uint16_t (*Run)( uint32_t Instance, uint32_t AmbientLuxLevel ),
+                                  uint64_t *p_Cycles, uint64_t *p_Ns )
+{
+  uint32_t report;
+  uint64_t start_cycles;
+  uint64_t start_time;
+
+  Tick = 0;
+  Init(0, p_Config);
+
+  start_time = LIGHT_LC_HOST_NowNs();
+  start_cycles = __rdtsc();
+  for(report = 0; report < ReportNbr; report++)
+  {
+    Tick += p_Interval[report];
+    p_Out[report] = Run(0, p_Ambient[report]);
+  }
+  *p_Cycles = __rdtsc() - start_cycles;
+  *p_Ns = LIGHT_LC_HOST_NowNs() - start_time;
+
+  return;
+}
+
+static uint32_t LIGHT_LC_HOST_FloatBits( float Value )
+{
+  uint32_t bits;
+
+  memcpy(&bits, &Value, sizeof(bits));
+
+  return bits;
+}
+
+/**
+ * @brief Linear congruential generator, the traces only depend on the seed
+ */
+static uint32_t LIGHT_LC_HOST_Random( uint32_t Range )
+{
+  Random = (Random * 1103515245U) + 12345U;
+
+  return (Random >> 8) % Range;
+}
+
+static uint64_t LIGHT_LC_HOST_NowNs( void )
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static void LIGHT_LC_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s [-n reports] [-s seed] [-c csv]\n", p_Name);
+  exit(2);
+}
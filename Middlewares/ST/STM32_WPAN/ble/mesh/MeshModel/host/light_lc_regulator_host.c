@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @file    light_lc_regulator_host.c
+ * @author  MCD Application Team
+ * @brief   Access to the PI regulator of light_lc.c for the Linux host
+ *          harness, built once per arithmetic
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Light_LC_PIregulator() and the LC parameters are private to light_lc.c,
+ * which is included here unmodified. The Makefile builds this file once with
+ * LIGHT_LC_REGULATOR_FIXED_POINT 0 and LIGHT_LC_REGULATOR_HOST_VARIANT Float,
+ * once with 1 and Fixed, then keeps only the functions below global, so that
+ * both regulators are linked in the same program.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "light_lc.c"
+#include "light_lc_regulator_host.h"
+
+/* Private macros ------------------------------------------------------------*/
+#define LIGHT_LC_REGULATOR_HOST_CONCAT(name, variant)   name##variant
+#define LIGHT_LC_REGULATOR_HOST_NAME(name, variant)     LIGHT_LC_REGULATOR_HOST_CONCAT(name, variant)
+#define LIGHT_LC_REGULATOR_HOST_Init   LIGHT_LC_REGULATOR_HOST_NAME(LIGHT_LC_REGULATOR_HOST_Init, \
+                                                                    LIGHT_LC_REGULATOR_HOST_VARIANT)
+#define LIGHT_LC_REGULATOR_HOST_Run    LIGHT_LC_REGULATOR_HOST_NAME(LIGHT_LC_REGULATOR_HOST_Run, \
+                                                                    LIGHT_LC_REGULATOR_HOST_VARIANT)
+
+/* Private variables ---------------------------------------------------------*/
+/**
+ * Regulator entries of the LC_PropertyId table, which is only built with ENABLE_LIGHT_MODEL_SERVER_LC
+ */
+static const light_lc_propertyId_t PropertyId[LC_PROPERTY_TABLE_COUNT] =
+{
+  [LC_REGULATOR_ACCURACY_PID_INDEX] =
+  {
+    LIGHT_CONTROL_REGULATOR_ACCURACY_PID,
+    LC_REGULATOR_ACCURACY_PID_SIZE,
+    LC_REGULATOR_ACCURACY_PID_INDEX
+  },
+  [LC_REGULATOR_KID_PID_INDEX] =
+  {
+    LIGHT_CONTROL_REGULATOR_KID_PID,
+    LC_REGULATOR_KID_PID_SIZE,
+    LC_REGULATOR_KID_PID_INDEX
+  },
+  [LC_REGULATOR_KIU_PID_INDEX] =
+  {
+    LIGHT_CONTROL_REGULATOR_KIU_PID,
+    LC_REGULATOR_KIU_PID_SIZE,
+    LC_REGULATOR_KIU_PID_INDEX
+  },
+  [LC_REGULATOR_KPD_PID_INDEX] =
+  {
+    LIGHT_CONTROL_REGULATOR_KPD_PID,
+    LC_REGULATOR_KPD_PID_SIZE,
+    LC_REGULATOR_KPD_PID_INDEX
+  },
+  [LC_REGULATOR_KPU_PID_INDEX] =
+  {
+    LIGHT_CONTROL_REGULATOR_KPU_PID,
+    LC_REGULATOR_KPU_PID_SIZE,
+    LC_REGULATOR_KPU_PID_INDEX
+  },
+};
+
+static lc_param_t LcParams[LIGHT_LC_REGULATOR_HOST_MAX_INSTANCE_NBR];
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+ * @brief Properties of an instance, its internal sum is reset and its last update is now
+ */
+void LIGHT_LC_REGULATOR_HOST_Init( uint32_t Instance, const LIGHT_LC_REGULATOR_HOST_Config_t *p_Config )
+{
+  lc_param_t *p_lc_params = &LcParams[Instance];
+
+  memset(p_lc_params, 0, sizeof(lc_param_t));
+  p_lc_params->pPropertyId = PropertyId;
+  p_lc_params->propertyValue[LC_REGULATOR_ACCURACY_PID_INDEX] = p_Config->Accuracy;
+  p_lc_params->propertyValue[LC_REGULATOR_KIU_PID_INDEX] = p_Config->Kiu;
+  p_lc_params->propertyValue[LC_REGULATOR_KID_PID_INDEX] = p_Config->Kid;
+  p_lc_params->propertyValue[LC_REGULATOR_KPU_PID_INDEX] = p_Config->Kpu;
+  p_lc_params->propertyValue[LC_REGULATOR_KPD_PID_INDEX] = p_Config->Kpd;
+  p_lc_params->luxLevelOut = p_Config->LuxLevelOut;
+  p_lc_params->piLightnessUpdateTick = Clock_Time();
+
+  return;
+}
+
+/**
+ * @brief Report of the ambient lux level, in 0.01 lux, then run of the regulator at Clock_Time()
+ * @retval Output of the regulator, Light Lightness Linear
+ */
+uint16_t LIGHT_LC_REGULATOR_HOST_Run( uint32_t Instance, uint32_t AmbientLuxLevel )
+{
+  LcParams[Instance].ambientLuxLevel = AmbientLuxLevel;
+
+  return Light_LC_PIregulator(&LcParams[Instance]);
+}
@@ -0,0 +1,51 @@
+/**
+ ******************************************************************************
+ * @file    light_lc_regulator_host.h
+ * @author  MCD Application Team
+ * @brief   Access to the PI regulator of light_lc.c for the Linux host
+ *          harness, built once per arithmetic
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LIGHT_LC_REGULATOR_HOST_H
+#define LIGHT_LC_REGULATOR_HOST_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define LIGHT_LC_REGULATOR_HOST_MAX_INSTANCE_NBR        (4U)
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * Regulator properties, the coefficients as the IEEE 754 bit patterns of the
+ * Light LC Regulator Kxx properties
+ */
+typedef struct
+{
+  uint32_t Kiu;
+  uint32_t Kid;
+  uint32_t Kpu;
+  uint32_t Kpd;
+  uint8_t Accuracy;
+  uint32_t LuxLevelOut;
+} LIGHT_LC_REGULATOR_HOST_Config_t;
+
+/* Exported functions ------------------------------------------------------- */
+void LIGHT_LC_REGULATOR_HOST_InitFloat( uint32_t Instance, const LIGHT_LC_REGULATOR_HOST_Config_t *p_Config );
+uint16_t LIGHT_LC_REGULATOR_HOST_RunFloat( uint32_t Instance, uint32_t AmbientLuxLevel );
+void LIGHT_LC_REGULATOR_HOST_InitFixed( uint32_t Instance, const LIGHT_LC_REGULATOR_HOST_Config_t *p_Config );
+uint16_t LIGHT_LC_REGULATOR_HOST_RunFixed( uint32_t Instance, uint32_t AmbientLuxLevel );
+
+#endif /* LIGHT_LC_REGULATOR_HOST_H */
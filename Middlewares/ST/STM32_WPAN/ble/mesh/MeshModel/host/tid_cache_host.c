@@ -0,0 +1,404 @@
+/**
+ ******************************************************************************
+ * @file    tid_cache_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host test of the TID cache of Chk_TidValidity() with
+ *          interleaved messages of several clients
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * <flows> (source, destination) pairs send <messages> messages to
+ * Chk_TidValidity(), each message from a flow drawn at random. A message is a
+ * new one, with the next TID of its flow, or with <retransmissions> percent
+ * probability a retransmission of the last message of its flow. The messages
+ * are 1 to 50 ms apart, with a pause of 6 to 9 s every 2000 messages on
+ * average, and the clock wraps around during the run.
+ *
+ * The result of each message is compared with a reference model of the cache:
+ * TID_CACHE_SIZE entries in least recently used order, a message being a
+ * duplicate when the entry of its pair holds its TID from 6 s or less before.
+ * Any difference is an error, so is a new message reported as a duplicate.
+ * Up to TID_CACHE_SIZE flows every retransmission within 6 s of the accepted
+ * message must be dropped.
+ *
+ * The retransmissions let through are counted for the cache and, on the same
+ * messages, for the single entry check used before the cache. The messages
+ * are then sent again to time Chk_TidValidity(), in ns per call.
+ *
+ * Usage: tid_cache_host [-f flows] [-n messages] [-r retransmissions %] [-s seed] [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hal_common.h"
+#include "ble_mesh.h"
+#include "common.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TID_CACHE_HOST_MAX_ERRORS       (10U)
+#define TID_CACHE_HOST_VALIDITY_MS      (6000U)
+#define TID_CACHE_HOST_MAX_GAP_MS       (50U)
+#define TID_CACHE_HOST_PAUSE_RATE       (2000U)
+#define TID_CACHE_HOST_START_TICK       (0xFFFFFFFFU - 600000U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  MOBLE_ADDRESS Src;
+  MOBLE_ADDRESS Dst;
+  MOBLEUINT8 Tid;
+  MOBLEUINT8 Sent;
+  uint32_t AcceptTick;
+} TID_CACHE_HOST_Flow_t;
+
+typedef struct
+{
+  MOBLE_ADDRESS Src;
+  MOBLE_ADDRESS Dst;
+  MOBLEUINT8 Tid;
+  uint32_t Tick;
+} TID_CACHE_HOST_Entry_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t FlowNbr = 4U;
+static uint32_t MsgNbr = 2000000U;
+static uint32_t RetransmitPercent = 25U;
+static uint32_t Seed = 1U;
+static const char *CsvFile;
+
+static TID_CACHE_HOST_Flow_t *p_Flow;
+/* Messages sent, replayed to time Chk_TidValidity() */
+static uint32_t *p_MsgFlow;
+static uint32_t *p_MsgTick;
+static MOBLEUINT8 *p_MsgTid;
+/* Reference of the cache, most recently used first */
+static TID_CACHE_HOST_Entry_t RefCache[TID_CACHE_SIZE];
+static uint32_t RefCount;
+/* Single entry check used before the cache */
+static TID_CACHE_HOST_Entry_t RefSingle;
+static uint32_t Tick;
+static uint32_t Random;
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static MOBLEUINT8 TID_CACHE_HOST_RefCheck( MOBLE_ADDRESS Src, MOBLE_ADDRESS Dst, MOBLEUINT8 Tid );
+static MOBLEUINT8 TID_CACHE_HOST_RefSingleCheck( MOBLE_ADDRESS Src, MOBLE_ADDRESS Dst, MOBLEUINT8 Tid );
+static uint32_t TID_CACHE_HOST_Random( uint32_t Range );
+static uint64_t TID_CACHE_HOST_NowNs( void );
+static void TID_CACHE_HOST_Error( const char *p_Msg, uint32_t Msg, uint32_t Flow );
+static void TID_CACHE_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  TID_CACHE_HOST_Flow_t *p_flow;
+  uint32_t msg;
+  uint32_t flow;
+  MOBLEUINT8 retransmit;
+  MOBLEUINT8 duplicate;
+  MOBLEUINT8 ref_duplicate;
+  MOBLEUINT8 expired;
+  uint32_t new_nbr = 0;
+  uint32_t retransmit_nbr = 0;
+  uint32_t expired_nbr = 0;
+  uint32_t missed_nbr = 0;
+  uint32_t single_missed_nbr = 0;
+  uint64_t start_time;
+  double missed_percent;
+  double single_missed_percent;
+  double call_ns;
+  FILE *p_csv;
+  int opt;
+
+  while((opt = getopt(argc, argv, "f:n:r:s:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'f':
+        FlowNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'n':
+        MsgNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'r':
+        RetransmitPercent = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 's':
+        Seed = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        TID_CACHE_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  if((FlowNbr == 0U) || (FlowNbr > 0xFFFFU) || (MsgNbr == 0U) || (RetransmitPercent > 100U))
+  {
+    TID_CACHE_HOST_Usage(argv[0]);
+  }
+
+  p_Flow = calloc(FlowNbr, sizeof(TID_CACHE_HOST_Flow_t));
+  p_MsgFlow = malloc(MsgNbr * sizeof(uint32_t));
+  p_MsgTick = malloc(MsgNbr * sizeof(uint32_t));
+  p_MsgTid = malloc(MsgNbr * sizeof(MOBLEUINT8));
+  if((p_Flow == NULL) || (p_MsgFlow == NULL) || (p_MsgTick == NULL) || (p_MsgTid == NULL))
+  {
+    fprintf(stderr, "out of memory\n");
+    return 2;
+  }
+
+  /* Clients 0x0001.. to the elements 0x0100.. of the node, a client may send to several elements */
+  Random = Seed;
+  for(flow = 0; flow < FlowNbr; flow++)
+  {
+    p_Flow[flow].Src = (MOBLE_ADDRESS)(1U + (flow / 3U));
+    p_Flow[flow].Dst = (MOBLE_ADDRESS)(0x0100U + (flow % 3U));
+    p_Flow[flow].Tid = (MOBLEUINT8)TID_CACHE_HOST_Random(256U);
+  }
+  Tick = TID_CACHE_HOST_START_TICK;
+
+  for(msg = 0; msg < MsgNbr; msg++)
+  {
+    flow = TID_CACHE_HOST_Random(FlowNbr);
+    p_flow = &p_Flow[flow];
+
+    if(TID_CACHE_HOST_Random(TID_CACHE_HOST_PAUSE_RATE) == 0U)
+    {
+      Tick += TID_CACHE_HOST_VALIDITY_MS + TID_CACHE_HOST_Random(3001U);
+    }
+    else
+    {
+      Tick += 1U + TID_CACHE_HOST_Random(TID_CACHE_HOST_MAX_GAP_MS);
+    }
+
+    retransmit = (p_flow->Sent != MOBLE_FALSE) && (TID_CACHE_HOST_Random(100U) < RetransmitPercent);
+    if(retransmit == MOBLE_FALSE)
+    {
+      p_flow->Tid++;
+      p_flow->Sent = MOBLE_TRUE;
+    }
+    /* Retransmissions of more than 6 s after the message was accepted are new messages for the models */
+    expired = ((Tick - p_flow->AcceptTick) > TID_CACHE_HOST_VALIDITY_MS);
+
+    p_MsgFlow[msg] = flow;
+    p_MsgTick[msg] = Tick;
+    p_MsgTid[msg] = p_flow->Tid;
+
+    duplicate = (Chk_TidValidity(p_flow->Src, p_flow->Dst, p_flow->Tid) == MOBLE_RESULT_INVALIDARG);
+    ref_duplicate = TID_CACHE_HOST_RefCheck(p_flow->Src, p_flow->Dst, p_flow->Tid);
+    if(duplicate == MOBLE_FALSE)
+    {
+      p_flow->AcceptTick = Tick;
+    }
+
+    if(duplicate != ref_duplicate)
+    {
+      TID_CACHE_HOST_Error((duplicate != MOBLE_FALSE) ? "dropped, not a duplicate of the reference" :
+                                                  "accepted, duplicate of the reference", msg, flow);
+    }
+
+    if(retransmit == MOBLE_FALSE)
+    {
+      new_nbr++;
+      if(duplicate != MOBLE_FALSE)
+      {
+        TID_CACHE_HOST_Error("new message dropped", msg, flow);
+      }
+      (void)TID_CACHE_HOST_RefSingleCheck(p_flow->Src, p_flow->Dst, p_flow->Tid);
+    }
+    else
+    {
+      retransmit_nbr++;
+      if(expired != MOBLE_FALSE)
+      {
+        expired_nbr++;
+      }
+      if(duplicate == MOBLE_FALSE)
+      {
+        missed_nbr++;
+        if((expired == MOBLE_FALSE) && (FlowNbr <= TID_CACHE_SIZE))
+        {
+          TID_CACHE_HOST_Error("retransmission within 6 s let through with a flow per entry", msg, flow);
+        }
+      }
+      if(TID_CACHE_HOST_RefSingleCheck(p_flow->Src, p_flow->Dst, p_flow->Tid) == MOBLE_FALSE)
+      {
+        single_missed_nbr++;
+      }
+    }
+  }
+
+  /* Same messages again, the clock goes on from the end of the first run */
+  start_time = TID_CACHE_HOST_NowNs();
+  for(msg = 0; msg < MsgNbr; msg++)
+  {
+    Tick = p_MsgTick[msg] + (p_MsgTick[MsgNbr - 1U] - TID_CACHE_HOST_START_TICK);
+    (void)Chk_TidValidity(p_Flow[p_MsgFlow[msg]].Src, p_Flow[p_MsgFlow[msg]].Dst, p_MsgTid[msg]);
+  }
+  call_ns = (double)(TID_CACHE_HOST_NowNs() - start_time) / MsgNbr;
+
+  missed_percent = (retransmit_nbr != 0U) ? (100.0 * missed_nbr) / retransmit_nbr : 0;
+  single_missed_percent = (retransmit_nbr != 0U) ? (100.0 * single_missed_nbr) / retransmit_nbr : 0;
+
+  printf("cache %u, %5u flows: %u messages, %u new, %u retransmissions, %u after 6 s, let through %.1f%% "
+         "(single entry %.1f%%), %.0f ns/call, %u errors\n", TID_CACHE_SIZE, FlowNbr, MsgNbr, new_nbr, retransmit_nbr,
+         expired_nbr, missed_percent, single_missed_percent, call_ns, ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "cache_size,flows,messages,new,retransmissions,expired,let_through_percent,"
+                "single_entry_let_through_percent,call_ns,errors\n");
+      }
+      fprintf(p_csv, "%u,%u,%u,%u,%u,%u,%.1f,%.1f,%.0f,%u\n", TID_CACHE_SIZE, FlowNbr, MsgNbr, new_nbr,
+              retransmit_nbr, expired_nbr, missed_percent, single_missed_percent, call_ns, ErrorNbr);
+      fclose(p_csv);
+    }
+  }
+
+  free(p_Flow);
+  free(p_MsgFlow);
+  free(p_MsgTick);
+  free(p_MsgTid);
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/**
+ * @brief Clock of the models, the simulated time of the messages in ms
+ */
+uint32_t HAL_GetTick( void )
+{
+  return Tick;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief Reference of the cache, the entries are moved in the array to keep the least recently used order
+ * @retval MOBLE_TRUE if the message is a duplicate
+ */
+static MOBLEUINT8 TID_CACHE_HOST_RefCheck( MOBLE_ADDRESS Src, MOBLE_ADDRESS Dst, MOBLEUINT8 Tid )
+{
+  TID_CACHE_HOST_Entry_t entry;
+  uint32_t index;
+  MOBLEUINT8 duplicate = MOBLE_FALSE;
+
+  for(index = 0; index < RefCount; index++)
+  {
+    if((RefCache[index].Src == Src) && (RefCache[index].Dst == Dst))
+    {
+      break;
+    }
+  }
+
+  if(index < RefCount)
+  {
+    entry = RefCache[index];
+    duplicate = (entry.Tid == Tid) && ((Tick - entry.Tick) <= TID_CACHE_HOST_VALIDITY_MS);
+  }
+  else
+  {
+    /* Not found, the least recently used entry is dropped when the cache is full */
+    if(RefCount < TID_CACHE_SIZE)
+    {
+      RefCount++;
+    }
+    index = RefCount - 1U;
+    entry.Src = Src;
+    entry.Dst = Dst;
+  }
+
+  if(duplicate == MOBLE_FALSE)
+  {
+    entry.Tid = Tid;
+    entry.Tick = Tick;
+  }
+  memmove(&RefCache[1], &RefCache[0], index * sizeof(TID_CACHE_HOST_Entry_t));
+  RefCache[0] = entry;
+
+  return duplicate;
+}
+
+/**
+ * @brief Single entry check of Chk_TidValidity() before the cache
+ * @retval MOBLE_TRUE if the message is a duplicate
+ */
+static MOBLEUINT8 TID_CACHE_HOST_RefSingleCheck( MOBLE_ADDRESS Src, MOBLE_ADDRESS Dst, MOBLEUINT8 Tid )
+{
+  MOBLEUINT8 duplicate;
+
+  duplicate = ((Tick - RefSingle.Tick) <= TID_CACHE_HOST_VALIDITY_MS) && (RefSingle.Src == Src) &&
+              (RefSingle.Dst == Dst) && (RefSingle.Tid == Tid);
+  if(duplicate == MOBLE_FALSE)
+  {
+    RefSingle.Src = Src;
+    RefSingle.Dst = Dst;
+    RefSingle.Tid = Tid;
+    RefSingle.Tick = Tick;
+  }
+
+  return duplicate;
+}
+
+/**
+ * @brief Linear congruential generator, the messages only depend on the seed
+ */
+static uint32_t TID_CACHE_HOST_Random( uint32_t Range )
+{
+  Random = (Random * 1103515245U) + 12345U;
+
+  return (Random >> 8) % Range;
+}
+
+static uint64_t TID_CACHE_HOST_NowNs( void )
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static void TID_CACHE_HOST_Error( const char *p_Msg, uint32_t Msg, uint32_t Flow )
+{
+  if(ErrorNbr < TID_CACHE_HOST_MAX_ERRORS)
+  {
+    printf("error: message %u, flow %u: %s\n", Msg, Flow, p_Msg);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static void TID_CACHE_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s [-f flows (1..65535)] [-n messages] [-r retransmissions %%] [-s seed] [-c csv]\n",
+          p_Name);
+  exit(2);
+}
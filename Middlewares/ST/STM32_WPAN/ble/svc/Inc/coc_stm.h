@@ -0,0 +1,144 @@
+/**
+  ******************************************************************************
+  * @file    coc_stm.h
+  * @author  MCD Application Team
+  * @brief   Header for coc_stm.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2018-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __COC_STM_H
+#define __COC_STM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  COC_STM_CONNECTED_EVT,
+  COC_STM_CONNECT_FAILED_EVT,
+  COC_STM_DISCONNECTED_EVT,
+  COC_STM_TX_CPLT_EVT,
+  COC_STM_RX_DATA_EVT,
+  COC_STM_PROCESS_REQ_EVT,
+} COC_STM_Opcode_evt_t;
+
+typedef struct
+{
+  COC_STM_Opcode_evt_t      Coc_Evt_Opcode;
+  uint16_t                  ConnectionHandle;
+  uint8_t                   ChannelIndex;
+  tBleStatus                Status;       /**< COC_STM_TX_CPLT_EVT: BLE_STATUS_SUCCESS when the whole buffer was sent
+                                               COC_STM_CONNECT_FAILED_EVT: BLE_STATUS_FAILED */
+  uint16_t                  Result;       /**< COC_STM_CONNECT_FAILED_EVT: result of the LE credit based connection
+                                               response, 0 otherwise */
+  const uint8_t             *pPayload;    /**< COC_STM_TX_CPLT_EVT: buffer given to COC_STM_Send()
+                                               COC_STM_RX_DATA_EVT: received segment, valid during the callback */
+  uint32_t                  Length;       /**< COC_STM_TX_CPLT_EVT: number of bytes sent
+                                               COC_STM_RX_DATA_EVT: length of the received segment */
+  uint16_t                  SduOffset;    /**< COC_STM_RX_DATA_EVT: offset of the segment in the SDU */
+  uint16_t                  SduLength;    /**< COC_STM_RX_DATA_EVT: length of the SDU. The SDU is complete when
+                                               SduOffset + Length == SduLength */
+}COC_STM_App_Notification_evt_t;
+
+typedef struct
+{
+  uint32_t TxByteNbr;           /**< Number of bytes accepted by the BLE stack */
+  uint32_t TxSduNbr;            /**< Number of SDUs accepted by the BLE stack */
+  uint32_t TxFrameNbr;          /**< Number of K-frames accepted by the BLE stack */
+  uint32_t CreditWaitNbr;       /**< Number of times the transmission waited for credits from the peer */
+  uint32_t PoolFullNbr;         /**< Number of times the TX pool was found full */
+  uint32_t RxByteNbr;           /**< Number of bytes received */
+  uint32_t RxSduNbr;            /**< Number of SDUs received */
+  uint32_t RxFrameNbr;          /**< Number of K-frames received */
+  uint32_t RxErrorNbr;          /**< Number of K-frames dropped as inconsistent with the SDU length */
+  uint32_t TxGoodput;           /**< Bytes per second sent since the statistics were reset */
+  uint32_t RxGoodput;           /**< Bytes per second received since the statistics were reset */
+}COC_STM_Stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * Maximum number of connection-oriented channels open at the same time
+ */
+#ifndef BLE_CFG_COC_MAX_CHANNEL
+#define BLE_CFG_COC_MAX_CHANNEL                     (2)
+#endif
+
+/**
+ * SPSM of the bulk transfer channels (dynamic range 0x0080 - 0x00FF)
+ */
+#ifndef BLE_CFG_COC_SPSM
+#define BLE_CFG_COC_SPSM                            (0x0080)
+#endif
+
+/**
+ * Largest SDU accepted from the peer
+ */
+#ifndef BLE_CFG_COC_MTU
+#define BLE_CFG_COC_MTU                             (1024)
+#endif
+
+/**
+ * Largest K-frame accepted from the peer: 247 bytes fill a link layer packet with a data length of 251 bytes
+ */
+#ifndef BLE_CFG_COC_MPS
+#define BLE_CFG_COC_MPS                             (247)
+#endif
+
+/**
+ * Number of K-frames the peer may send ahead. Credits are given back by batches of half this value
+ */
+#ifndef BLE_CFG_COC_RX_CREDITS
+#define BLE_CFG_COC_RX_CREDITS                      (8)
+#endif
+
+/**
+ * Largest K-frame sent: the Data parameter of ACI_L2CAP_COC_TX_DATA is limited to BLE_CMD_MAX_PARAM_LEN - 3 bytes
+ */
+#define COC_STM_TX_FRAME_MAX                        (BLE_CMD_MAX_PARAM_LEN - 3)
+
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void COC_STM_Init( void );
+void COC_STM_Process( void );
+tBleStatus COC_STM_Connect( uint16_t ConnectionHandle );
+tBleStatus COC_STM_Close( uint8_t ChannelIndex );
+void COC_STM_Disconnect( uint16_t ConnectionHandle );
+tBleStatus COC_STM_Send( uint8_t ChannelIndex, const uint8_t *pData, uint32_t Length );
+tBleStatus COC_STM_SetRxFlow( uint8_t ChannelIndex, uint8_t Enable );
+tBleStatus COC_STM_GetStats( uint8_t ChannelIndex, COC_STM_Stats_t *pStats );
+void COC_STM_ResetStats( uint8_t ChannelIndex );
+
+/**
+ * @brief  Callbacks to be implemented by the application
+ *         - COC_STM_App_Notification() reports the service events. On COC_STM_PROCESS_REQ_EVT, the application
+ *           shall call COC_STM_Process() from its background (e.g. a sequencer task). On COC_STM_TX_CPLT_EVT, the
+ *           buffer given to COC_STM_Send() is released. On COC_STM_RX_DATA_EVT, the segment shall be consumed
+ *           before returning: its credit is given back to the peer unless COC_STM_SetRxFlow() disabled it
+ *         - COC_STM_App_GetTick() returns a millisecond time base to compute the goodput. A weak implementation
+ *           returns 0, the goodput is then not computed.
+ */
+void COC_STM_App_Notification( COC_STM_App_Notification_evt_t *pNotification );
+uint32_t COC_STM_App_GetTick( void );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__COC_STM_H */
@@ -59,6 +59,8 @@ extern "C" {
     uint8_t             *pPayload;
     OTAS_STM_ChardId_t  ChardId;
     uint8_t             ValueLength;
+    uint8_t             Busy;           /**< Set by the application when it cannot take the raw data yet: the event is
+                                             kept and reported again after SVCCTL_ResumeUserEventFlow() */
   } OTA_STM_Notification_t;
 
   typedef PACKED_STRUCT{
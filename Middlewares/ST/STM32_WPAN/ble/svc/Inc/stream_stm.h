@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file    stream_stm.h
+  * @author  MCD Application Team
+  * @brief   Header for stream_stm.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2018-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STREAM_STM_H
+#define __STREAM_STM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  STREAM_STM_NOTIFY_ENABLED_EVT,
+  STREAM_STM_NOTIFY_DISABLED_EVT,
+  STREAM_STM_PROCESS_REQ_EVT,
+} STREAM_STM_Opcode_evt_t;
+
+typedef struct
+{
+  STREAM_STM_Opcode_evt_t   Stream_Evt_Opcode;
+  uint16_t                  ConnectionHandle;
+}STREAM_STM_App_Notification_evt_t;
+
+typedef struct
+{
+  uint32_t TxPacketNbr;         /**< Number of notifications accepted by the BLE stack */
+  uint32_t TxByteNbr;           /**< Number of payload bytes accepted by the BLE stack */
+  uint32_t RetryNbr;            /**< Number of notifications sent again after the TX pool was full */
+  uint32_t PoolFullNbr;         /**< Number of times the TX pool was found full */
+  uint32_t ErrorNbr;            /**< Number of notifications dropped on error */
+  uint32_t Goodput;             /**< Payload bytes per second since the statistics were reset */
+  uint16_t PayloadSize;         /**< Current payload size of the notifications */
+}STREAM_STM_Stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * Maximum number of connections streaming at the same time
+ */
+#ifndef BLE_CFG_STREAM_MAX_CONN
+#define BLE_CFG_STREAM_MAX_CONN                     (2)
+#endif
+
+/**
+ * Largest notification payload: the parameters of ACI_GATT_UPDATE_CHAR_VALUE_EXT (12 bytes + value) are limited to
+ * 255 bytes. It fits in a single link layer packet with a data length of 251 bytes.
+ */
+#define STREAM_STM_PAYLOAD_MAX                      (243)
+
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void STREAM_STM_Init( void );
+void STREAM_STM_Process( void );
+void STREAM_STM_SetDataLength( uint16_t ConnectionHandle, uint16_t MaxTxOctets );
+void STREAM_STM_Disconnect( uint16_t ConnectionHandle );
+tBleStatus STREAM_STM_GetStats( uint16_t ConnectionHandle, STREAM_STM_Stats_t *pStats );
+void STREAM_STM_ResetStats( uint16_t ConnectionHandle );
+
+/**
+ * @brief  Callbacks to be implemented by the application
+ *         - STREAM_STM_App_Notification() reports the service events. On STREAM_STM_PROCESS_REQ_EVT, the application
+ *           shall call STREAM_STM_Process() from its background (e.g. a sequencer task)
+ *         - STREAM_STM_App_Fill() is called from STREAM_STM_Process() to get the next payload of a connection. It
+ *           returns the number of bytes written in pPayload (up to Size), 0 when there is nothing to send. The
+ *           application calls again STREAM_STM_Process() when new data is available.
+ *         - STREAM_STM_App_GetTick() returns a millisecond time base to compute the goodput. A weak implementation
+ *           returns 0, the goodput is then not computed.
+ */
+void STREAM_STM_App_Notification( STREAM_STM_App_Notification_evt_t *pNotification );
+uint16_t STREAM_STM_App_Fill( uint16_t ConnectionHandle, uint8_t *pPayload, uint16_t Size );
+uint32_t STREAM_STM_App_GetTick( void );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__STREAM_STM_H */
@@ -26,6 +26,8 @@
  *  + A GATT event is relevant to only one Service and/or one Client. When a GATT event is received, it is notified to
  *    the registered handlers to the BLE controller. When no registered handler acknowledges positively the GATT event,
  *    it is reported to the application.
+ *  + An L2CAP event is notified to the registered Service handlers in the same way, so that a Service may manage
+ *    connection-oriented channels. When no handler acknowledges it, it is reported to the application.
  *  + A GAP event is not relevant to either a Service or a Client. It is sent to the application
  *  + In case the application does not want to take benefit from the ble_controller, it could bypass it. In that case,
  *  the application shall:
@@ -88,6 +90,23 @@ extern "C" {
    */
   void SVCCTL_RegisterSvcHandler( SVC_CTL_p_EvtHandler_t pfBLE_SVC_Service_Event_Handler );
 
+  /**
+   * @brief  This API registers the attribute handle range of a Service. A GATT event on an attribute handle
+   *         (attribute modified, read/write/prepare write permit request) is given first to the Service handler owning
+   *         that handle, without polling the other registered Service handlers. When the owner does not acknowledge
+   *         the event, or when no range contains the handle, all the registered Service handlers are called as usual.
+   *         It shall be called once the handles of the Service are known (after aci_gatt_add_service()).
+   *         A range overlapping an already registered one is ignored.
+   *
+   * @param  pfBLE_SVC_Service_Event_Handler: The Service handler already registered with SVCCTL_RegisterSvcHandler()
+   * @param  StartHandle: The Service handle returned by aci_gatt_add_service()
+   * @param  EndHandle: The last attribute handle of the Service (StartHandle + Max_Attribute_Records - 1)
+   * @retval None
+   */
+  void SVCCTL_RegisterSvcHandleRange( SVC_CTL_p_EvtHandler_t pfBLE_SVC_Service_Event_Handler,
+                                      uint16_t StartHandle,
+                                      uint16_t EndHandle );
+
   /**
    * @brief  This API registers a handler to be called when a GATT user event is received from the BLE core device. When
    *         a Client is created, it shall register a callback to be notified when a GATT event is received from the
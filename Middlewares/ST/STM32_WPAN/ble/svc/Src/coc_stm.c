@@ -0,0 +1,835 @@
+/**
+  ******************************************************************************
+  * @file    coc_stm.c
+  * @author  MCD Application Team
+  * @brief   Bulk transfer over L2CAP connection-oriented channels (custom STM)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2018-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/**
+ * The service moves large buffers over LE credit based connection-oriented channels opened on BLE_CFG_COC_SPSM:
+ *  - COC_STM_Connect() opens a channel on a link, a request received from the peer on BLE_CFG_COC_SPSM is accepted
+ *    as long as a channel entry is free
+ *  - a buffer given to COC_STM_Send() is cut in SDUs of up to the peer MTU, each SDU in K-frames of up to the peer
+ *    MPS. COC_STM_Process() sends one K-frame per channel in turn while the channel has credits and the TX pool of
+ *    the BLE stack is not full. COC_STM_TX_CPLT_EVT releases the buffer
+ *  - the received K-frames are reported as they come with COC_STM_RX_DATA_EVT, without copy. Their credits are
+ *    given back to the peer by batches once consumed
+ *  - statistics (bytes, SDUs, K-frames, credit waits, goodput) are maintained per channel
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "common_blesvc.h"
+#include "coc_stm.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  COC_STM_CHANNEL_FREE,
+  COC_STM_CHANNEL_CONNECTING,
+  COC_STM_CHANNEL_OPEN,
+} CocChannelState_t;
+
+typedef struct
+{
+  uint16_t  ConnectionHandle;             /**< Link of the channel */
+  uint8_t   ChannelIndex;                 /**< Channel index given by the BLE stack once the channel is open */
+  uint8_t   State;                        /**< CocChannelState_t */
+  uint16_t  PeerMtu;                      /**< Largest SDU accepted by the peer */
+  uint16_t  PeerMps;                      /**< Largest K-frame accepted by the peer */
+  uint16_t  TxCredits;                    /**< Number of K-frames the peer may still receive */
+  uint8_t   CreditWait;                   /**< The transmission is waiting for credits */
+  uint8_t   RxFlowEnabled;                /**< The credits of the received K-frames are given back */
+  const uint8_t *pTxData;                 /**< Buffer being sent, NULL if none */
+  uint32_t  TxLength;                     /**< Length of the buffer being sent */
+  uint32_t  TxOffset;                     /**< Offset of the next byte to send */
+  uint16_t  TxSduRemaining;               /**< Bytes of the current SDU still to send, 0 at a SDU boundary */
+  uint16_t  RxSduLength;                  /**< Length of the SDU being received, 0 at a SDU boundary */
+  uint16_t  RxSduOffset;                  /**< Bytes of the SDU being received already reported */
+  uint16_t  RxCreditsUsed;                /**< Credits consumed by the peer and not given back yet */
+  uint32_t  StartTick;                    /**< Time base when the statistics were reset */
+  COC_STM_Stats_t Stats;
+}CocChannelContext_t;
+
+typedef struct
+{
+  uint8_t   TxPoolFull;                   /**< The BLE stack rejected a K-frame, waiting for the TX pool */
+  uint8_t   NextChannel;                  /**< Next channel to serve */
+  uint8_t   Frame[COC_STM_TX_FRAME_MAX];  /**< First K-frame of a SDU: SDU length + payload */
+  CocChannelContext_t Channel[BLE_CFG_COC_MAX_CHANNEL];
+}CocContext_t;
+
+/* Private defines -----------------------------------------------------------*/
+/**
+ * The first K-frame of a SDU starts with the SDU length
+ */
+#define COC_STM_SDU_HDR_SIZE                (2)
+
+/**
+ * LE credit based connection response result: refused - no resources available
+ */
+#define COC_STM_RESULT_NO_RESOURCES         (0x0004)
+
+/**
+ * Number of consumed credits given back at once
+ */
+#if (BLE_CFG_COC_RX_CREDITS > 1)
+#define COC_STM_CREDIT_BATCH                (BLE_CFG_COC_RX_CREDITS / 2)
+#else
+#define COC_STM_CREDIT_BATCH                (1)
+#endif
+
+/* Private macros ------------------------------------------------------------*/
+#define COC_STM_LE16(p)                     ((uint16_t)((p)[0] | ((p)[1] << 8)))
+
+/* Private variables ---------------------------------------------------------*/
+PLACE_IN_SECTION("BLE_DRIVER_CONTEXT") static CocContext_t aCocContext;
+
+/* Private function prototypes -----------------------------------------------*/
+static SVCCTL_EvtAckStatus_t Coc_Event_Handler(void *Event);
+static CocChannelContext_t * Coc_GetChannel(uint8_t ChannelIndex);
+static CocChannelContext_t * Coc_GetConnecting(uint16_t ConnectionHandle);
+static CocChannelContext_t * Coc_Alloc(uint16_t ConnectionHandle);
+static void Coc_Open(CocChannelContext_t *pChannel, uint8_t ChannelIndex, uint16_t Mtu, uint16_t Mps, uint16_t Credits);
+static void Coc_Release(CocChannelContext_t *pChannel);
+static void Coc_RxData(CocChannelContext_t *pChannel, const uint8_t *pData, uint16_t Length);
+static void Coc_ReturnCredits(CocChannelContext_t *pChannel, uint8_t Force);
+static tBleStatus Coc_TxFrame(CocChannelContext_t *pChannel);
+static void Coc_TxComplete(CocChannelContext_t *pChannel, tBleStatus Status);
+static void Coc_Notify(COC_STM_Opcode_evt_t Opcode, CocChannelContext_t *pChannel);
+
+
+/* Functions Definition ------------------------------------------------------*/
+/* Private functions ----------------------------------------------------------*/
+
+/**
+ * @brief  Event handler
+ * @param  Event: Address of the buffer holding the Event
+ * @retval Ack: Return whether the Event has been managed or not
+ */
+static SVCCTL_EvtAckStatus_t Coc_Event_Handler(void *Event)
+{
+  SVCCTL_EvtAckStatus_t return_value;
+  hci_event_pckt *event_pckt;
+  evt_blecore_aci *blecore_evt;
+  aci_l2cap_coc_connect_event_rp0 *coc_connect;
+  aci_l2cap_coc_connect_confirm_event_rp0 *coc_connect_confirm;
+  aci_l2cap_coc_flow_control_event_rp0 *coc_flow_control;
+  aci_l2cap_coc_rx_data_event_rp0 *coc_rx_data;
+  CocChannelContext_t *p_channel;
+  COC_STM_App_Notification_evt_t Notification;
+  uint8_t channel_nbr;
+  uint8_t channel_index_list[5];
+
+  return_value = SVCCTL_EvtNotAck;
+  event_pckt = (hci_event_pckt *)(((hci_uart_pckt*)Event)->data);
+
+  switch(event_pckt->evt)
+  {
+    case HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE:
+    {
+      blecore_evt = (evt_blecore_aci*)event_pckt->data;
+      switch(blecore_evt->ecode)
+      {
+        case ACI_L2CAP_COC_CONNECT_VSEVT_CODE:
+        {
+          coc_connect = (aci_l2cap_coc_connect_event_rp0*)blecore_evt->data;
+          if(coc_connect->SPSM != BLE_CFG_COC_SPSM)
+          {
+            break;
+          }
+          return_value = SVCCTL_EvtAckFlowEnable;
+
+          p_channel = Coc_Alloc(coc_connect->Connection_Handle);
+          if(p_channel == NULL)
+          {
+            aci_l2cap_coc_connect_confirm(coc_connect->Connection_Handle,
+                                          BLE_CFG_COC_MTU,
+                                          BLE_CFG_COC_MPS,
+                                          0,
+                                          COC_STM_RESULT_NO_RESOURCES,
+                                          &channel_nbr,
+                                          channel_index_list);
+            break;
+          }
+
+          if((aci_l2cap_coc_connect_confirm(coc_connect->Connection_Handle,
+                                            BLE_CFG_COC_MTU,
+                                            BLE_CFG_COC_MPS,
+                                            BLE_CFG_COC_RX_CREDITS,
+                                            0x0000, /* Success */
+                                            &channel_nbr,
+                                            channel_index_list) == BLE_STATUS_SUCCESS) && (channel_nbr != 0))
+          {
+            Coc_Open(p_channel, channel_index_list[0], coc_connect->MTU, coc_connect->MPS, coc_connect->Initial_Credits);
+          }
+          else
+          {
+            Coc_Release(p_channel);
+          }
+        }
+        break;
+
+        case ACI_L2CAP_COC_CONNECT_CONFIRM_VSEVT_CODE:
+        {
+          coc_connect_confirm = (aci_l2cap_coc_connect_confirm_event_rp0*)blecore_evt->data;
+          p_channel = Coc_GetConnecting(coc_connect_confirm->Connection_Handle);
+          if(p_channel == NULL)
+          {
+            break;
+          }
+          return_value = SVCCTL_EvtAckFlowEnable;
+
+          if((coc_connect_confirm->Result == 0x0000) && (coc_connect_confirm->Channel_Number != 0))
+          {
+            Coc_Open(p_channel,
+                     coc_connect_confirm->Channel_Index_List[0],
+                     coc_connect_confirm->MTU,
+                     coc_connect_confirm->MPS,
+                     coc_connect_confirm->Initial_Credits);
+          }
+          else
+          {
+            Notification.Coc_Evt_Opcode = COC_STM_CONNECT_FAILED_EVT;
+            Notification.ConnectionHandle = p_channel->ConnectionHandle;
+            Notification.ChannelIndex = 0;
+            Notification.Status = BLE_STATUS_FAILED;
+            Notification.Result = coc_connect_confirm->Result;
+            Notification.pPayload = NULL;
+            Notification.Length = 0;
+            Notification.SduOffset = 0;
+            Notification.SduLength = 0;
+            Coc_Release(p_channel);
+            COC_STM_App_Notification(&Notification);
+          }
+        }
+        break;
+
+        case ACI_L2CAP_COC_DISCONNECT_VSEVT_CODE:
+        {
+          p_channel = Coc_GetChannel(((aci_l2cap_coc_disconnect_event_rp0*)blecore_evt->data)->Channel_Index);
+          if(p_channel != NULL)
+          {
+            return_value = SVCCTL_EvtAckFlowEnable;
+            Coc_TxComplete(p_channel, BLE_STATUS_FAILED);
+            Coc_Notify(COC_STM_DISCONNECTED_EVT, p_channel);
+            Coc_Release(p_channel);
+          }
+        }
+        break;
+
+        case ACI_L2CAP_COC_FLOW_CONTROL_VSEVT_CODE:
+        {
+          coc_flow_control = (aci_l2cap_coc_flow_control_event_rp0*)blecore_evt->data;
+          p_channel = Coc_GetChannel(coc_flow_control->Channel_Index);
+          if(p_channel != NULL)
+          {
+            return_value = SVCCTL_EvtAckFlowEnable;
+            p_channel->TxCredits += coc_flow_control->Credits;
+            if((p_channel->CreditWait != FALSE) && (p_channel->TxCredits != 0))
+            {
+              p_channel->CreditWait = FALSE;
+              Coc_Notify(COC_STM_PROCESS_REQ_EVT, p_channel);
+            }
+          }
+        }
+        break;
+
+        case ACI_L2CAP_COC_RX_DATA_VSEVT_CODE:
+        {
+          coc_rx_data = (aci_l2cap_coc_rx_data_event_rp0*)blecore_evt->data;
+          p_channel = Coc_GetChannel(coc_rx_data->Channel_Index);
+          if(p_channel != NULL)
+          {
+            return_value = SVCCTL_EvtAckFlowEnable;
+            Coc_RxData(p_channel, coc_rx_data->Data, coc_rx_data->Length);
+          }
+        }
+        break;
+
+        case ACI_L2CAP_COC_TX_POOL_AVAILABLE_VSEVT_CODE:
+        {
+          /**
+           * Not acknowledged, the TX pool is shared with the other users of the L2CAP channels
+           */
+          if(aCocContext.TxPoolFull != FALSE)
+          {
+            aCocContext.TxPoolFull = FALSE;
+            Coc_Notify(COC_STM_PROCESS_REQ_EVT, NULL);
+          }
+        }
+        break;
+
+        default:
+          break;
+      }
+    }
+    break; /* HCI_HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE_SPECIFIC */
+
+    default:
+      break;
+  }
+
+  return(return_value);
+}/* end SVCCTL_EvtAckStatus_t */
+
+/**
+ * @brief  Open channel lookup
+ * @param  ChannelIndex: Channel index given by the BLE stack
+ * @retval Channel entry, NULL if not found
+ */
+static CocChannelContext_t * Coc_GetChannel(uint8_t ChannelIndex)
+{
+  uint8_t index;
+
+  for(index = 0; index < BLE_CFG_COC_MAX_CHANNEL; index++)
+  {
+    if((aCocContext.Channel[index].State == COC_STM_CHANNEL_OPEN) &&
+       (aCocContext.Channel[index].ChannelIndex == ChannelIndex))
+    {
+      return &aCocContext.Channel[index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief  Lookup of the channel requested on a link
+ * @param  ConnectionHandle: Connection handle
+ * @retval Channel entry, NULL if not found
+ */
+static CocChannelContext_t * Coc_GetConnecting(uint16_t ConnectionHandle)
+{
+  uint8_t index;
+
+  for(index = 0; index < BLE_CFG_COC_MAX_CHANNEL; index++)
+  {
+    if((aCocContext.Channel[index].State == COC_STM_CHANNEL_CONNECTING) &&
+       (aCocContext.Channel[index].ConnectionHandle == ConnectionHandle))
+    {
+      return &aCocContext.Channel[index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief  Channel entry allocation, the entry is in the connecting state
+ * @param  ConnectionHandle: Connection handle
+ * @retval Channel entry, NULL if all the entries are in use
+ */
+static CocChannelContext_t * Coc_Alloc(uint16_t ConnectionHandle)
+{
+  CocChannelContext_t *p_channel;
+  uint8_t index;
+
+  for(index = 0; index < BLE_CFG_COC_MAX_CHANNEL; index++)
+  {
+    p_channel = &aCocContext.Channel[index];
+    if(p_channel->State == COC_STM_CHANNEL_FREE)
+    {
+      memset(p_channel, 0, sizeof(CocChannelContext_t));
+      p_channel->ConnectionHandle = ConnectionHandle;
+      p_channel->State = COC_STM_CHANNEL_CONNECTING;
+      p_channel->RxFlowEnabled = TRUE;
+      return p_channel;
+    }
+  }
+
+  return NULL;
+}
+
+static void Coc_Open(CocChannelContext_t *pChannel, uint8_t ChannelIndex, uint16_t Mtu, uint16_t Mps, uint16_t Credits)
+{
+  pChannel->ChannelIndex = ChannelIndex;
+  pChannel->State = COC_STM_CHANNEL_OPEN;
+  pChannel->PeerMtu = Mtu;
+  pChannel->PeerMps = Mps;
+  pChannel->TxCredits = Credits;
+  pChannel->StartTick = COC_STM_App_GetTick();
+  Coc_Notify(COC_STM_CONNECTED_EVT, pChannel);
+
+  return;
+}
+
+static void Coc_Release(CocChannelContext_t *pChannel)
+{
+  pChannel->State = COC_STM_CHANNEL_FREE;
+  pChannel->pTxData = NULL;
+
+  return;
+}
+
+/**
+ * @brief  K-frame reception: the SDU length is taken from the first K-frame of a SDU, the payload is reported to the
+ *         application and the credit is given back
+ * @param  pChannel: Channel entry
+ * @param  pData: Information data of the K-frame
+ * @param  Length: Length of the information data
+ * @retval None
+ */
+static void Coc_RxData(CocChannelContext_t *pChannel, const uint8_t *pData, uint16_t Length)
+{
+  COC_STM_App_Notification_evt_t Notification;
+  uint16_t sdu_length;
+
+  pChannel->RxCreditsUsed++;
+  pChannel->Stats.RxFrameNbr++;
+
+  if(pChannel->RxSduLength == 0)
+  {
+    sdu_length = (Length >= COC_STM_SDU_HDR_SIZE) ? COC_STM_LE16(pData) : 0;
+    if((sdu_length == 0) || (sdu_length > BLE_CFG_COC_MTU))
+    {
+      pChannel->Stats.RxErrorNbr++;
+      Coc_ReturnCredits(pChannel, FALSE);
+      return;
+    }
+    pChannel->RxSduLength = sdu_length;
+    pChannel->RxSduOffset = 0;
+    pData += COC_STM_SDU_HDR_SIZE;
+    Length -= COC_STM_SDU_HDR_SIZE;
+  }
+
+  if((pChannel->RxSduOffset + Length) > pChannel->RxSduLength)
+  {
+    /**
+     * The SDU is dropped, the next K-frame is expected to start a SDU
+     */
+    pChannel->Stats.RxErrorNbr++;
+    pChannel->RxSduLength = 0;
+    Coc_ReturnCredits(pChannel, FALSE);
+    return;
+  }
+
+  if(Length != 0)
+  {
+    Notification.Coc_Evt_Opcode = COC_STM_RX_DATA_EVT;
+    Notification.ConnectionHandle = pChannel->ConnectionHandle;
+    Notification.ChannelIndex = pChannel->ChannelIndex;
+    Notification.Status = BLE_STATUS_SUCCESS;
+    Notification.Result = 0;
+    Notification.pPayload = pData;
+    Notification.Length = Length;
+    Notification.SduOffset = pChannel->RxSduOffset;
+    Notification.SduLength = pChannel->RxSduLength;
+    COC_STM_App_Notification(&Notification);
+
+    pChannel->RxSduOffset += Length;
+    pChannel->Stats.RxByteNbr += Length;
+  }
+
+  if(pChannel->RxSduOffset == pChannel->RxSduLength)
+  {
+    pChannel->Stats.RxSduNbr++;
+    pChannel->RxSduLength = 0;
+  }
+
+  /**
+   * The application may have closed the channel from the notification
+   */
+  if(pChannel->State == COC_STM_CHANNEL_OPEN)
+  {
+    Coc_ReturnCredits(pChannel, FALSE);
+  }
+
+  return;
+}
+
+/**
+ * @brief  Credits given back to the peer for the consumed K-frames
+ * @param  pChannel: Channel entry
+ * @param  Force: TRUE to give back the credits even if less than a batch was consumed
+ * @retval None
+ */
+static void Coc_ReturnCredits(CocChannelContext_t *pChannel, uint8_t Force)
+{
+  if((pChannel->RxFlowEnabled != FALSE) && (pChannel->RxCreditsUsed != 0) &&
+     ((Force != FALSE) || (pChannel->RxCreditsUsed >= COC_STM_CREDIT_BATCH)))
+  {
+    if(aci_l2cap_coc_flow_control(pChannel->ChannelIndex, pChannel->RxCreditsUsed) == BLE_STATUS_SUCCESS)
+    {
+      pChannel->RxCreditsUsed = 0;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief  Transmission of the next K-frame of a channel. The first K-frame of a SDU is built in Frame[] with the SDU
+ *         length, the next ones are sent from the application buffer
+ * @param  pChannel: Channel entry with a buffer to send and credits
+ * @retval Status of ACI_L2CAP_COC_TX_DATA
+ */
+static tBleStatus Coc_TxFrame(CocChannelContext_t *pChannel)
+{
+  const uint8_t *p_frame;
+  uint16_t frame_max;
+  uint16_t sdu_remaining;
+  uint16_t payload;
+  uint16_t frame_length;
+  tBleStatus status;
+
+  frame_max = MIN(pChannel->PeerMps, COC_STM_TX_FRAME_MAX);
+
+  if(pChannel->TxSduRemaining == 0)
+  {
+    sdu_remaining = (uint16_t)MIN(pChannel->TxLength - pChannel->TxOffset, pChannel->PeerMtu);
+    payload = MIN(sdu_remaining, frame_max - COC_STM_SDU_HDR_SIZE);
+    aCocContext.Frame[0] = (uint8_t)(sdu_remaining & 0xFF);
+    aCocContext.Frame[1] = (uint8_t)(sdu_remaining >> 8);
+    memcpy(&aCocContext.Frame[COC_STM_SDU_HDR_SIZE], &pChannel->pTxData[pChannel->TxOffset], payload);
+    p_frame = aCocContext.Frame;
+    frame_length = payload + COC_STM_SDU_HDR_SIZE;
+  }
+  else
+  {
+    sdu_remaining = pChannel->TxSduRemaining;
+    payload = MIN(sdu_remaining, frame_max);
+    p_frame = &pChannel->pTxData[pChannel->TxOffset];
+    frame_length = payload;
+  }
+
+  status = aci_l2cap_coc_tx_data(pChannel->ChannelIndex, frame_length, p_frame);
+  if(status == BLE_STATUS_SUCCESS)
+  {
+    pChannel->TxCredits--;
+    pChannel->TxOffset += payload;
+    pChannel->TxSduRemaining = sdu_remaining - payload;
+    pChannel->Stats.TxFrameNbr++;
+    pChannel->Stats.TxByteNbr += payload;
+    if(pChannel->TxSduRemaining == 0)
+    {
+      pChannel->Stats.TxSduNbr++;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @brief  End of the transmission of a buffer, reported to the application
+ * @param  pChannel: Channel entry
+ * @param  Status: BLE_STATUS_SUCCESS when the whole buffer was sent
+ * @retval None
+ */
+static void Coc_TxComplete(CocChannelContext_t *pChannel, tBleStatus Status)
+{
+  COC_STM_App_Notification_evt_t Notification;
+
+  if(pChannel->pTxData == NULL)
+  {
+    return;
+  }
+
+  Notification.Coc_Evt_Opcode = COC_STM_TX_CPLT_EVT;
+  Notification.ConnectionHandle = pChannel->ConnectionHandle;
+  Notification.ChannelIndex = pChannel->ChannelIndex;
+  Notification.Status = Status;
+  Notification.Result = 0;
+  Notification.pPayload = pChannel->pTxData;
+  Notification.Length = pChannel->TxOffset;
+  Notification.SduOffset = 0;
+  Notification.SduLength = 0;
+
+  pChannel->pTxData = NULL;
+  pChannel->CreditWait = FALSE;
+  COC_STM_App_Notification(&Notification);
+
+  return;
+}
+
+static void Coc_Notify(COC_STM_Opcode_evt_t Opcode, CocChannelContext_t *pChannel)
+{
+  COC_STM_App_Notification_evt_t Notification;
+
+  memset(&Notification, 0, sizeof(Notification));
+  Notification.Coc_Evt_Opcode = Opcode;
+  if(pChannel != NULL)
+  {
+    Notification.ConnectionHandle = pChannel->ConnectionHandle;
+    Notification.ChannelIndex = pChannel->ChannelIndex;
+  }
+  COC_STM_App_Notification(&Notification);
+
+  return;
+}
+
+/* Weak functions ----------------------------------------------------------*/
+__WEAK uint32_t COC_STM_App_GetTick( void )
+{
+  return 0;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief  Service initialization
+ * @param  None
+ * @retval None
+ */
+void COC_STM_Init(void)
+{
+  memset(&aCocContext, 0, sizeof(aCocContext));
+
+  /**
+   *	Register the event handler to the BLE controller
+   */
+  SVCCTL_RegisterSvcHandler(Coc_Event_Handler);
+
+  return;
+}
+
+/**
+ * @brief  Send the K-frames of the buffers given to COC_STM_Send() until the TX pool of the BLE stack is full or the
+ *         channels have no more credits or data. The channels are served in turn, one K-frame each.
+ * @param  None
+ * @retval None
+ */
+void COC_STM_Process(void)
+{
+  CocChannelContext_t *p_channel;
+  tBleStatus status;
+  uint8_t idle_nbr = 0;
+
+  while((aCocContext.TxPoolFull == FALSE) && (idle_nbr < BLE_CFG_COC_MAX_CHANNEL))
+  {
+    p_channel = &aCocContext.Channel[aCocContext.NextChannel];
+    aCocContext.NextChannel = (aCocContext.NextChannel + 1) % BLE_CFG_COC_MAX_CHANNEL;
+
+    if((p_channel->State != COC_STM_CHANNEL_OPEN) || (p_channel->pTxData == NULL))
+    {
+      idle_nbr++;
+      continue;
+    }
+
+    if(p_channel->TxCredits == 0)
+    {
+      /**
+       * Wait for ACI_L2CAP_COC_FLOW_CONTROL_VSEVT_CODE
+       */
+      if(p_channel->CreditWait == FALSE)
+      {
+        p_channel->CreditWait = TRUE;
+        p_channel->Stats.CreditWaitNbr++;
+      }
+      idle_nbr++;
+      continue;
+    }
+
+    status = Coc_TxFrame(p_channel);
+    if(status == BLE_STATUS_INSUFFICIENT_RESOURCES)
+    {
+      /**
+       * Wait for ACI_L2CAP_COC_TX_POOL_AVAILABLE_VSEVT_CODE, the K-frame is built again
+       */
+      aCocContext.TxPoolFull = TRUE;
+      p_channel->Stats.PoolFullNbr++;
+    }
+    else
+    {
+      if(status != BLE_STATUS_SUCCESS)
+      {
+        Coc_TxComplete(p_channel, status);
+      }
+      else if(p_channel->TxOffset == p_channel->TxLength)
+      {
+        Coc_TxComplete(p_channel, BLE_STATUS_SUCCESS);
+      }
+      idle_nbr = 0;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief  Request of a channel on BLE_CFG_COC_SPSM. COC_STM_CONNECTED_EVT or COC_STM_CONNECT_FAILED_EVT reports the
+ *         outcome
+ * @param  ConnectionHandle: Connection handle
+ * @retval BLE_STATUS_BUSY when a request is already pending on the link, BLE_STATUS_INSUFFICIENT_RESOURCES when all
+ *         the channel entries are in use, else the status of ACI_L2CAP_COC_CONNECT
+ */
+tBleStatus COC_STM_Connect(uint16_t ConnectionHandle)
+{
+  CocChannelContext_t *p_channel;
+  tBleStatus status;
+
+  if(Coc_GetConnecting(ConnectionHandle) != NULL)
+  {
+    return BLE_STATUS_BUSY;
+  }
+
+  p_channel = Coc_Alloc(ConnectionHandle);
+  if(p_channel == NULL)
+  {
+    return BLE_STATUS_INSUFFICIENT_RESOURCES;
+  }
+
+  status = aci_l2cap_coc_connect(ConnectionHandle,
+                                 BLE_CFG_COC_SPSM,
+                                 BLE_CFG_COC_MTU,
+                                 BLE_CFG_COC_MPS,
+                                 BLE_CFG_COC_RX_CREDITS,
+                                 0); /* LE credit based connection-oriented channel */
+  if(status != BLE_STATUS_SUCCESS)
+  {
+    Coc_Release(p_channel);
+  }
+
+  return status;
+}
+
+/**
+ * @brief  Channel termination. COC_STM_DISCONNECTED_EVT is reported when the channel is closed
+ * @param  ChannelIndex: Channel index
+ * @retval BLE_STATUS_INVALID_PARAMS when the channel is unknown, else the status of ACI_L2CAP_COC_DISCONNECT
+ */
+tBleStatus COC_STM_Close(uint8_t ChannelIndex)
+{
+  if(Coc_GetChannel(ChannelIndex) == NULL)
+  {
+    return BLE_STATUS_INVALID_PARAMS;
+  }
+
+  return aci_l2cap_coc_disconnect(ChannelIndex);
+}
+
+/**
+ * @brief  Release of the channels of a link, to be called on HCI_DISCONNECTION_COMPLETE_EVT_CODE
+ * @param  ConnectionHandle: Connection handle
+ * @retval None
+ */
+void COC_STM_Disconnect(uint16_t ConnectionHandle)
+{
+  CocChannelContext_t *p_channel;
+  uint8_t index;
+
+  for(index = 0; index < BLE_CFG_COC_MAX_CHANNEL; index++)
+  {
+    p_channel = &aCocContext.Channel[index];
+    if((p_channel->State != COC_STM_CHANNEL_FREE) && (p_channel->ConnectionHandle == ConnectionHandle))
+    {
+      if(p_channel->State == COC_STM_CHANNEL_OPEN)
+      {
+        Coc_TxComplete(p_channel, BLE_STATUS_FAILED);
+        Coc_Notify(COC_STM_DISCONNECTED_EVT, p_channel);
+      }
+      Coc_Release(p_channel);
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief  Transmission of a buffer. The buffer shall not be modified until COC_STM_TX_CPLT_EVT is reported
+ * @param  ChannelIndex: Channel index
+ * @param  pData: Buffer to send
+ * @param  Length: Length of the buffer
+ * @retval BLE_STATUS_INVALID_PARAMS when the channel is unknown or the buffer empty, BLE_STATUS_BUSY when a buffer
+ *         is already being sent on the channel
+ */
+tBleStatus COC_STM_Send(uint8_t ChannelIndex, const uint8_t *pData, uint32_t Length)
+{
+  CocChannelContext_t *p_channel;
+
+  p_channel = Coc_GetChannel(ChannelIndex);
+  if((p_channel == NULL) || (pData == NULL) || (Length == 0))
+  {
+    return BLE_STATUS_INVALID_PARAMS;
+  }
+
+  if(p_channel->pTxData != NULL)
+  {
+    return BLE_STATUS_BUSY;
+  }
+
+  p_channel->pTxData = pData;
+  p_channel->TxLength = Length;
+  p_channel->TxOffset = 0;
+  p_channel->TxSduRemaining = 0;
+  Coc_Notify(COC_STM_PROCESS_REQ_EVT, p_channel);
+
+  return BLE_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Reception flow control. While disabled, the credits of the received K-frames are kept so that the peer
+ *         stops once it has used its credits. They are all given back when enabled again.
+ * @param  ChannelIndex: Channel index
+ * @param  Enable: TRUE to give back the credits
+ * @retval BLE_STATUS_INVALID_PARAMS when the channel is unknown
+ */
+tBleStatus COC_STM_SetRxFlow(uint8_t ChannelIndex, uint8_t Enable)
+{
+  CocChannelContext_t *p_channel;
+
+  p_channel = Coc_GetChannel(ChannelIndex);
+  if(p_channel == NULL)
+  {
+    return BLE_STATUS_INVALID_PARAMS;
+  }
+
+  p_channel->RxFlowEnabled = Enable;
+  Coc_ReturnCredits(p_channel, TRUE);
+
+  return BLE_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Statistics of a channel
+ * @param  ChannelIndex: Channel index
+ * @param  pStats: Statistics
+ * @retval BLE_STATUS_INVALID_PARAMS when the channel is unknown
+ */
+tBleStatus COC_STM_GetStats(uint8_t ChannelIndex, COC_STM_Stats_t *pStats)
+{
+  CocChannelContext_t *p_channel;
+  uint32_t elapsed;
+
+  p_channel = Coc_GetChannel(ChannelIndex);
+  if(p_channel == NULL)
+  {
+    return BLE_STATUS_INVALID_PARAMS;
+  }
+
+  *pStats = p_channel->Stats;
+  elapsed = COC_STM_App_GetTick() - p_channel->StartTick;
+  pStats->TxGoodput = (elapsed != 0) ? (uint32_t)(((uint64_t)p_channel->Stats.TxByteNbr * 1000) / elapsed) : 0;
+  pStats->RxGoodput = (elapsed != 0) ? (uint32_t)(((uint64_t)p_channel->Stats.RxByteNbr * 1000) / elapsed) : 0;
+
+  return BLE_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Statistics reset of a channel
+ * @param  ChannelIndex: Channel index
+ * @retval None
+ */
+void COC_STM_ResetStats(uint8_t ChannelIndex)
+{
+  CocChannelContext_t *p_channel;
+
+  p_channel = Coc_GetChannel(ChannelIndex);
+  if(p_channel != NULL)
+  {
+    memset(&p_channel->Stats, 0, sizeof(p_channel->Stats));
+    p_channel->StartTick = COC_STM_App_GetTick();
+  }
+
+  return;
+}
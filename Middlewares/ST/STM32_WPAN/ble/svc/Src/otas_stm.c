@@ -170,7 +170,12 @@ static SVCCTL_EvtAckStatus_t OTAS_Event_Handler(void *Event)
             notification.ChardId = OTAS_STM_RAW_DATA_ID;
             notification.pPayload = (uint8_t*)&attribute_modified->Attr_Data[0];
             notification.ValueLength = attribute_modified->Attr_Data_Length;
+            notification.Busy = FALSE;
             OTAS_STM_Notification( &notification );
+            if(notification.Busy != FALSE)
+            {
+              return_value = SVCCTL_EvtAckFlowDisable;
+            }
           }
         }
         break;
@@ -212,6 +212,9 @@ void P2PS_STM_Init(void)
                       PRIMARY_SERVICE,
                       8,
                       &(aPeerToPeerContext.PeerToPeerSvcHdle));
+    SVCCTL_RegisterSvcHandleRange(PeerToPeer_Event_Handler,
+                                  aPeerToPeerContext.PeerToPeerSvcHdle,
+                                  aPeerToPeerContext.PeerToPeerSvcHdle + 8 - 1);
 
     /**
      *  Add LED Characteristic
@@ -0,0 +1,504 @@
+/**
+  ******************************************************************************
+  * @file    stream_stm.c
+  * @author  MCD Application Team
+  * @brief   Data streaming service (custom STM)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2018-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/**
+ * The service streams notifications from the application to the subscribed clients:
+ *  - the payload of each notification is sized to the ATT_MTU and to the data length of the connection so that the
+ *    last link layer packet of a notification is filled
+ *  - STREAM_STM_Process() keeps the TX pool of the BLE stack topped up, serving the connections in turn. When the
+ *    pool is full, the rejected payload is kept and sent first when ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE is received
+ *  - statistics (packets, bytes, retries, goodput) are maintained per connection
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "common_blesvc.h"
+#include "stream_stm.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint16_t  ConnectionHandle;             /**< STREAM_STM_INVALID_CONN_HANDLE when the entry is free */
+  uint16_t  AttMtu;                       /**< ATT_MTU of the connection */
+  uint16_t  MaxTxOctets;                  /**< Maximum link layer payload of the connection */
+  uint8_t   NotifyEnabled;                /**< Notifications enabled by the client */
+  uint32_t  StartTick;                    /**< Time base when the statistics were reset */
+  STREAM_STM_Stats_t Stats;
+}StreamConnContext_t;
+
+typedef struct
+{
+  uint16_t  StreamSvcHdle;                /**< Service handle */
+  uint16_t  StreamTxCharHdle;             /**< Characteristic handle */
+  uint8_t   TxPoolFull;                   /**< The BLE stack rejected a notification, waiting for the TX pool */
+  uint8_t   NextConn;                     /**< Next connection to serve */
+  uint8_t   PendingConn;                  /**< Connection of the payload held in Payload[] */
+  uint16_t  PendingLength;                /**< Length of the payload held in Payload[], 0 if none */
+  uint8_t   Payload[STREAM_STM_PAYLOAD_MAX];
+  StreamConnContext_t Conn[BLE_CFG_STREAM_MAX_CONN];
+}StreamContext_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define STREAM_STM_INVALID_CONN_HANDLE      (0xFFFF)
+
+/**
+ * Header of a notification: ATT opcode and handle (3 bytes) + L2CAP header (4 bytes)
+ */
+#define STREAM_STM_ATT_HDR_SIZE             (3)
+#define STREAM_STM_NOTIF_HDR_SIZE           (STREAM_STM_ATT_HDR_SIZE + 4)
+
+/**
+ * Default link layer payload before any data length update
+ */
+#define STREAM_STM_DEFAULT_TX_OCTETS        (27)
+
+/**
+ * Service, characteristic declaration, characteristic value and client characteristic configuration descriptor
+ */
+#define STREAM_STM_MAX_ATTRIBUTE_RECORDS    (4)
+
+/* Private macros ------------------------------------------------------------*/
+#define COPY_UUID_128(uuid_struct, uuid_15, uuid_14, uuid_13, uuid_12, uuid_11, uuid_10, uuid_9, uuid_8, uuid_7, uuid_6, uuid_5, uuid_4, uuid_3, uuid_2, uuid_1, uuid_0) \
+do {\
+    uuid_struct[0] = uuid_0; uuid_struct[1] = uuid_1; uuid_struct[2] = uuid_2; uuid_struct[3] = uuid_3; \
+        uuid_struct[4] = uuid_4; uuid_struct[5] = uuid_5; uuid_struct[6] = uuid_6; uuid_struct[7] = uuid_7; \
+            uuid_struct[8] = uuid_8; uuid_struct[9] = uuid_9; uuid_struct[10] = uuid_10; uuid_struct[11] = uuid_11; \
+                uuid_struct[12] = uuid_12; uuid_struct[13] = uuid_13; uuid_struct[14] = uuid_14; uuid_struct[15] = uuid_15; \
+}while(0)
+
+/* Data streaming Service */
+/*
+ 0000FEA0-8E22-4541-9D4C-21EDAE82ED19: Service 128bits UUID
+ 0000FEA1-8E22-4541-9D4C-21EDAE82ED19: TX Characteristic 128bits UUID
+ */
+#define COPY_STREAM_SERVICE_UUID(uuid_struct)       COPY_UUID_128(uuid_struct,0x00,0x00,0xFE,0xA0,0x8e,0x22,0x45,0x41,0x9d,0x4c,0x21,0xed,0xae,0x82,0xed,0x19)
+#define COPY_STREAM_TX_CHAR_UUID(uuid_struct)       COPY_UUID_128(uuid_struct,0x00,0x00,0xFE,0xA1,0x8e,0x22,0x45,0x41,0x9d,0x4c,0x21,0xed,0xae,0x82,0xed,0x19)
+
+/* Private variables ---------------------------------------------------------*/
+PLACE_IN_SECTION("BLE_DRIVER_CONTEXT") static StreamContext_t aStreamContext;
+
+/* Private function prototypes -----------------------------------------------*/
+static SVCCTL_EvtAckStatus_t Stream_Event_Handler(void *Event);
+static StreamConnContext_t * Stream_GetConn(uint16_t ConnectionHandle, uint8_t Alloc);
+static uint16_t Stream_PayloadSize(StreamConnContext_t *pConn);
+static void Stream_Notify(STREAM_STM_Opcode_evt_t Opcode, uint16_t ConnectionHandle);
+
+
+/* Functions Definition ------------------------------------------------------*/
+/* Private functions ----------------------------------------------------------*/
+
+/**
+ * @brief  Event handler
+ * @param  Event: Address of the buffer holding the Event
+ * @retval Ack: Return whether the Event has been managed or not
+ */
+static SVCCTL_EvtAckStatus_t Stream_Event_Handler(void *Event)
+{
+  SVCCTL_EvtAckStatus_t return_value;
+  hci_event_pckt *event_pckt;
+  evt_blecore_aci *blecore_evt;
+  aci_gatt_attribute_modified_event_rp0 *attribute_modified;
+  aci_att_exchange_mtu_resp_event_rp0 *exchange_mtu_resp;
+  StreamConnContext_t *p_conn;
+
+  return_value = SVCCTL_EvtNotAck;
+  event_pckt = (hci_event_pckt *)(((hci_uart_pckt*)Event)->data);
+
+  switch(event_pckt->evt)
+  {
+    case HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE:
+    {
+      blecore_evt = (evt_blecore_aci*)event_pckt->data;
+      switch(blecore_evt->ecode)
+      {
+        case ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE:
+        {
+          attribute_modified = (aci_gatt_attribute_modified_event_rp0*)blecore_evt->data;
+          if(attribute_modified->Attr_Handle == (aStreamContext.StreamTxCharHdle + 2))
+          {
+            /**
+             * Descriptor handle
+             */
+            return_value = SVCCTL_EvtAckFlowEnable;
+
+            p_conn = Stream_GetConn(attribute_modified->Connection_Handle, TRUE);
+            if(p_conn == NULL)
+            {
+              /* All the connection entries are in use */
+              break;
+            }
+
+            if(attribute_modified->Attr_Data[0] & COMSVC_Notification)
+            {
+              p_conn->NotifyEnabled = TRUE;
+              STREAM_STM_ResetStats(p_conn->ConnectionHandle);
+              Stream_Notify(STREAM_STM_NOTIFY_ENABLED_EVT, p_conn->ConnectionHandle);
+              Stream_Notify(STREAM_STM_PROCESS_REQ_EVT, p_conn->ConnectionHandle);
+            }
+            else
+            {
+              p_conn->NotifyEnabled = FALSE;
+              if((aStreamContext.PendingLength != 0) && (&aStreamContext.Conn[aStreamContext.PendingConn] == p_conn))
+              {
+                aStreamContext.PendingLength = 0;
+              }
+              Stream_Notify(STREAM_STM_NOTIFY_DISABLED_EVT, p_conn->ConnectionHandle);
+            }
+          }
+        }
+        break;
+
+        case ACI_ATT_EXCHANGE_MTU_RESP_VSEVT_CODE:
+        {
+          /**
+           * Not acknowledged, the event may be of interest for the application as well
+           */
+          exchange_mtu_resp = (aci_att_exchange_mtu_resp_event_rp0*)blecore_evt->data;
+          p_conn = Stream_GetConn(exchange_mtu_resp->Connection_Handle, TRUE);
+          if(p_conn != NULL)
+          {
+            p_conn->AttMtu = exchange_mtu_resp->Server_RX_MTU;
+          }
+        }
+        break;
+
+        case ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE:
+        {
+          /**
+           * Not acknowledged, the TX pool is shared with the other services
+           */
+          if(aStreamContext.TxPoolFull != FALSE)
+          {
+            aStreamContext.TxPoolFull = FALSE;
+            Stream_Notify(STREAM_STM_PROCESS_REQ_EVT, ((aci_gatt_tx_pool_available_event_rp0*)blecore_evt->data)->Connection_Handle);
+          }
+        }
+        break;
+
+        default:
+          break;
+      }
+    }
+    break; /* HCI_HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE_SPECIFIC */
+
+    default:
+      break;
+  }
+
+  return(return_value);
+}/* end SVCCTL_EvtAckStatus_t */
+
+/**
+ * @brief  Connection entry lookup
+ * @param  ConnectionHandle: Connection handle
+ * @param  Alloc: TRUE to allocate a free entry when the connection is not known
+ * @retval Connection entry, NULL if not found
+ */
+static StreamConnContext_t * Stream_GetConn(uint16_t ConnectionHandle, uint8_t Alloc)
+{
+  StreamConnContext_t *p_free = NULL;
+  uint8_t index;
+
+  for(index = 0; index < BLE_CFG_STREAM_MAX_CONN; index++)
+  {
+    if(aStreamContext.Conn[index].ConnectionHandle == ConnectionHandle)
+    {
+      return &aStreamContext.Conn[index];
+    }
+    if((p_free == NULL) && (aStreamContext.Conn[index].ConnectionHandle == STREAM_STM_INVALID_CONN_HANDLE))
+    {
+      p_free = &aStreamContext.Conn[index];
+    }
+  }
+
+  if((Alloc != FALSE) && (p_free != NULL))
+  {
+    memset(p_free, 0, sizeof(StreamConnContext_t));
+    p_free->ConnectionHandle = ConnectionHandle;
+    p_free->AttMtu = BLE_DEFAULT_ATT_MTU;
+    p_free->MaxTxOctets = STREAM_STM_DEFAULT_TX_OCTETS;
+    return p_free;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief  Payload size of the notifications of a connection
+ *         The largest payload allowed by the ATT_MTU is shortened so that its last link layer packet is full
+ * @param  pConn: Connection entry
+ * @retval Payload size
+ */
+static uint16_t Stream_PayloadSize(StreamConnContext_t *pConn)
+{
+  uint16_t size;
+  uint16_t ll_pkt_nbr;
+
+  size = MIN(pConn->AttMtu - STREAM_STM_ATT_HDR_SIZE, STREAM_STM_PAYLOAD_MAX);
+
+  if((pConn->MaxTxOctets != 0) && ((size + STREAM_STM_NOTIF_HDR_SIZE) > pConn->MaxTxOctets))
+  {
+    ll_pkt_nbr = (size + STREAM_STM_NOTIF_HDR_SIZE) / pConn->MaxTxOctets;
+    size = (ll_pkt_nbr * pConn->MaxTxOctets) - STREAM_STM_NOTIF_HDR_SIZE;
+  }
+
+  return size;
+}
+
+static void Stream_Notify(STREAM_STM_Opcode_evt_t Opcode, uint16_t ConnectionHandle)
+{
+  STREAM_STM_App_Notification_evt_t Notification;
+
+  Notification.Stream_Evt_Opcode = Opcode;
+  Notification.ConnectionHandle = ConnectionHandle;
+  STREAM_STM_App_Notification(&Notification);
+
+  return;
+}
+
+/* Weak functions ----------------------------------------------------------*/
+__WEAK uint32_t STREAM_STM_App_GetTick( void )
+{
+  return 0;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief  Service initialization
+ * @param  None
+ * @retval None
+ */
+void STREAM_STM_Init(void)
+{
+  Char_UUID_t uuid16;
+  uint8_t index;
+
+  memset(&aStreamContext, 0, sizeof(aStreamContext));
+  for(index = 0; index < BLE_CFG_STREAM_MAX_CONN; index++)
+  {
+    aStreamContext.Conn[index].ConnectionHandle = STREAM_STM_INVALID_CONN_HANDLE;
+  }
+
+  /**
+   *	Register the event handler to the BLE controller
+   */
+  SVCCTL_RegisterSvcHandler(Stream_Event_Handler);
+
+  /**
+   *  Data streaming Service
+   *
+   * Max_Attribute_Records = 1 for the service +
+   *                         2 for the TX characteristic +
+   *                         1 for the client char configuration descriptor
+   */
+  COPY_STREAM_SERVICE_UUID(uuid16.Char_UUID_128);
+  aci_gatt_add_service(UUID_TYPE_128,
+                       (Service_UUID_t *) &uuid16,
+                       PRIMARY_SERVICE,
+                       STREAM_STM_MAX_ATTRIBUTE_RECORDS,
+                       &(aStreamContext.StreamSvcHdle));
+  SVCCTL_RegisterSvcHandleRange(Stream_Event_Handler,
+                                aStreamContext.StreamSvcHdle,
+                                aStreamContext.StreamSvcHdle + STREAM_STM_MAX_ATTRIBUTE_RECORDS - 1);
+
+  /**
+   *  Add TX Characteristic
+   */
+  COPY_STREAM_TX_CHAR_UUID(uuid16.Char_UUID_128);
+  aci_gatt_add_char(aStreamContext.StreamSvcHdle,
+                    UUID_TYPE_128, &uuid16,
+                    STREAM_STM_PAYLOAD_MAX,
+                    CHAR_PROP_NOTIFY,
+                    ATTR_PERMISSION_NONE,
+                    GATT_DONT_NOTIFY_EVENTS, /* gattEvtMask */
+                    10, /* encryKeySize */
+                    1, /* isVariable */
+                    &(aStreamContext.StreamTxCharHdle));
+
+  return;
+}
+
+/**
+ * @brief  Send the payloads provided by STREAM_STM_App_Fill() until the TX pool of the BLE stack is full or there is
+ *         nothing more to send. The connections with notifications enabled are served in turn, one payload each.
+ * @param  None
+ * @retval None
+ */
+void STREAM_STM_Process(void)
+{
+  StreamConnContext_t *p_conn;
+  tBleStatus status;
+  uint8_t index;
+  uint8_t idle_nbr = 0;
+
+  while((aStreamContext.TxPoolFull == FALSE) && (idle_nbr < BLE_CFG_STREAM_MAX_CONN))
+  {
+    if(aStreamContext.PendingLength != 0)
+    {
+      /**
+       * The payload rejected when the TX pool was full is sent first
+       */
+      index = aStreamContext.PendingConn;
+      aStreamContext.Conn[index].Stats.RetryNbr++;
+    }
+    else
+    {
+      index = aStreamContext.NextConn;
+      aStreamContext.NextConn = (aStreamContext.NextConn + 1) % BLE_CFG_STREAM_MAX_CONN;
+      p_conn = &aStreamContext.Conn[index];
+
+      if((p_conn->ConnectionHandle == STREAM_STM_INVALID_CONN_HANDLE) || (p_conn->NotifyEnabled == FALSE))
+      {
+        idle_nbr++;
+        continue;
+      }
+
+      p_conn->Stats.PayloadSize = Stream_PayloadSize(p_conn);
+      aStreamContext.PendingLength = STREAM_STM_App_Fill(p_conn->ConnectionHandle,
+                                                         aStreamContext.Payload,
+                                                         p_conn->Stats.PayloadSize);
+      if(aStreamContext.PendingLength == 0)
+      {
+        idle_nbr++;
+        continue;
+      }
+      aStreamContext.PendingLength = MIN(aStreamContext.PendingLength, p_conn->Stats.PayloadSize);
+      aStreamContext.PendingConn = index;
+    }
+
+    p_conn = &aStreamContext.Conn[index];
+    status = aci_gatt_update_char_value_ext(p_conn->ConnectionHandle,
+                                            aStreamContext.StreamSvcHdle,
+                                            aStreamContext.StreamTxCharHdle,
+                                            0x01, /* Notification */
+                                            aStreamContext.PendingLength, /* Char_Length */
+                                            0, /* Value_Offset */
+                                            aStreamContext.PendingLength,
+                                            aStreamContext.Payload);
+    if(status == BLE_STATUS_INSUFFICIENT_RESOURCES)
+    {
+      /**
+       * Wait for ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE, the payload is kept
+       */
+      aStreamContext.TxPoolFull = TRUE;
+      p_conn->Stats.PoolFullNbr++;
+    }
+    else
+    {
+      if(status == BLE_STATUS_SUCCESS)
+      {
+        p_conn->Stats.TxPacketNbr++;
+        p_conn->Stats.TxByteNbr += aStreamContext.PendingLength;
+      }
+      else
+      {
+        p_conn->Stats.ErrorNbr++;
+      }
+      aStreamContext.PendingLength = 0;
+      idle_nbr = 0;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief  Data length update of a connection, to be called on HCI_LE_DATA_LENGTH_CHANGE_SUBEVT_CODE
+ * @param  ConnectionHandle: Connection handle
+ * @param  MaxTxOctets: MaxTxOctets reported by the event
+ * @retval None
+ */
+void STREAM_STM_SetDataLength(uint16_t ConnectionHandle, uint16_t MaxTxOctets)
+{
+  StreamConnContext_t *p_conn;
+
+  p_conn = Stream_GetConn(ConnectionHandle, TRUE);
+  if(p_conn != NULL)
+  {
+    p_conn->MaxTxOctets = MaxTxOctets;
+  }
+
+  return;
+}
+
+/**
+ * @brief  Connection release, to be called on HCI_DISCONNECTION_COMPLETE_EVT_CODE
+ * @param  ConnectionHandle: Connection handle
+ * @retval None
+ */
+void STREAM_STM_Disconnect(uint16_t ConnectionHandle)
+{
+  StreamConnContext_t *p_conn;
+
+  p_conn = Stream_GetConn(ConnectionHandle, FALSE);
+  if(p_conn != NULL)
+  {
+    if((aStreamContext.PendingLength != 0) && (&aStreamContext.Conn[aStreamContext.PendingConn] == p_conn))
+    {
+      aStreamContext.PendingLength = 0;
+    }
+    p_conn->ConnectionHandle = STREAM_STM_INVALID_CONN_HANDLE;
+    p_conn->NotifyEnabled = FALSE;
+  }
+
+  return;
+}
+
+/**
+ * @brief  Statistics of a connection
+ * @param  ConnectionHandle: Connection handle
+ * @param  pStats: Statistics
+ * @retval BLE_STATUS_INVALID_PARAMS when the connection is unknown
+ */
+tBleStatus STREAM_STM_GetStats(uint16_t ConnectionHandle, STREAM_STM_Stats_t *pStats)
+{
+  StreamConnContext_t *p_conn;
+  uint32_t elapsed;
+
+  p_conn = Stream_GetConn(ConnectionHandle, FALSE);
+  if(p_conn == NULL)
+  {
+    return BLE_STATUS_INVALID_PARAMS;
+  }
+
+  *pStats = p_conn->Stats;
+  pStats->PayloadSize = Stream_PayloadSize(p_conn);
+  elapsed = STREAM_STM_App_GetTick() - p_conn->StartTick;
+  pStats->Goodput = (elapsed != 0) ? (uint32_t)(((uint64_t)p_conn->Stats.TxByteNbr * 1000) / elapsed) : 0;
+
+  return BLE_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Statistics reset of a connection
+ * @param  ConnectionHandle: Connection handle
+ * @retval None
+ */
+void STREAM_STM_ResetStats(uint16_t ConnectionHandle)
+{
+  StreamConnContext_t *p_conn;
+
+  p_conn = Stream_GetConn(ConnectionHandle, FALSE);
+  if(p_conn != NULL)
+  {
+    memset(&p_conn->Stats, 0, sizeof(p_conn->Stats));
+    p_conn->StartTick = STREAM_STM_App_GetTick();
+  }
+
+  return;
+}
@@ -22,12 +22,21 @@
 #include "cmsis_compiler.h"
 
 /* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+uint16_t StartHandle;
+uint16_t EndHandle;
+SVC_CTL_p_EvtHandler_t pfEvtHandler;
+} SVCCTL_HandleRange_t;
+
 typedef struct
 {
 #if (BLE_CFG_SVC_MAX_NBR_CB > 0)
 SVC_CTL_p_EvtHandler_t SVCCTL__SvcHandlerTab[BLE_CFG_SVC_MAX_NBR_CB];
+SVCCTL_HandleRange_t SVCCTL_SvcRangeTab[BLE_CFG_SVC_MAX_NBR_CB];
 #endif
 uint8_t NbreOfRegisteredHandler;
+uint8_t NbreOfRegisteredRange;
 } SVCCTL_EvtHandler_t;
 
 typedef struct
@@ -41,6 +50,8 @@ uint8_t NbreOfRegisteredHandler;
 /* Private defines -----------------------------------------------------------*/
 #define SVCCTL_EGID_EVT_MASK   0xFF00
 #define SVCCTL_GATT_EVT_TYPE   0x0C00
+#define SVCCTL_L2CAP_EVT_TYPE  0x0800
+#define SVCCTL_NO_ATTR_HANDLE  0x0000
 #define SVCCTL_GAP_DEVICE_NAME_LENGTH 7
 
 /* Private macros ------------------------------------------------------------*/
@@ -57,6 +68,72 @@ PLACE_IN_SECTION("BLE_DRIVER_CONTEXT") SVCCTL_CltHandler_t SVCCTL_CltHandler;
  */
 
 /* Private functions ----------------------------------------------------------*/
+#if (BLE_CFG_SVC_MAX_NBR_CB > 0)
+/**
+ * @brief  Returns the attribute handle a GATT server event applies to
+ * @param  blecore_evt: GATT event
+ * @retval Attribute handle, SVCCTL_NO_ATTR_HANDLE when the event does not carry one
+ */
+static uint16_t SVCCTL_GetAttrHandle( evt_blecore_aci *blecore_evt )
+{
+  uint16_t attr_handle = SVCCTL_NO_ATTR_HANDLE;
+
+  switch (blecore_evt->ecode)
+  {
+    /**
+     * These events all start with the Connection_Handle followed by the attribute handle
+     */
+    case ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE:
+    case ACI_GATT_WRITE_PERMIT_REQ_VSEVT_CODE:
+    case ACI_GATT_READ_PERMIT_REQ_VSEVT_CODE:
+    case ACI_GATT_PREPARE_WRITE_PERMIT_REQ_VSEVT_CODE:
+      attr_handle = ((aci_gatt_read_permit_req_event_rp0*)blecore_evt->data)->Attribute_Handle;
+      break;
+
+    default:
+      break;
+  }
+
+  return attr_handle;
+}
+
+/**
+ * @brief  Finds the Service handler owning an attribute handle
+ * @param  attr_handle: Attribute handle
+ * @retval Service handler, NULL when no registered range contains the handle
+ */
+static SVC_CTL_p_EvtHandler_t SVCCTL_FindSvcHandler( uint16_t attr_handle )
+{
+  SVCCTL_HandleRange_t *p_range;
+  uint8_t low = 0;
+  uint8_t high = SVCCTL_EvtHandler.NbreOfRegisteredRange;
+  uint8_t mid;
+
+  /**
+   * The ranges are sorted by start handle and do not overlap
+   */
+  while (low < high)
+  {
+    mid = (low + high) / 2;
+    p_range = &SVCCTL_EvtHandler.SVCCTL_SvcRangeTab[mid];
+    if (attr_handle < p_range->StartHandle)
+    {
+      high = mid;
+    }
+    else if (attr_handle > p_range->EndHandle)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      return p_range->pfEvtHandler;
+    }
+  }
+
+  return NULL;
+}
+#endif
+
 /* Weak functions ----------------------------------------------------------*/
 void BVOPUS_STM_Init(void);
 
@@ -129,6 +206,14 @@ __WEAK void BVOPUS_STM_Init( void )
 {
   return;
 }
+__WEAK void STREAM_STM_Init( void )
+{
+  return;
+}
+__WEAK void COC_STM_Init( void )
+{
+  return;
+}
 __WEAK void SVCCTL_InitCustomSvc( void )
 {
   return;
@@ -143,6 +228,7 @@ void SVCCTL_Init( void )
    * Initialize the number of registered Handler
    */
   SVCCTL_EvtHandler.NbreOfRegisteredHandler = 0;
+  SVCCTL_EvtHandler.NbreOfRegisteredRange = 0;
   SVCCTL_CltHandler.NbreOfRegisteredHandler = 0;
 
   /**
@@ -187,6 +273,10 @@ __WEAK void SVCCTL_SvcInit(void)
   
   BVOPUS_STM_Init();
 
+  STREAM_STM_Init();
+
+  COC_STM_Init();
+
   MESH_Init();
 
   SVCCTL_InitCustomSvc();
@@ -211,6 +301,54 @@ void SVCCTL_RegisterSvcHandler( SVC_CTL_p_EvtHandler_t pfBLE_SVC_Service_Event_H
   return;
 }
 
+/**
+ * @brief  Attribute handle range registration of a Service handler
+ * @param  pfBLE_SVC_Service_Event_Handler: Service handler
+ * @param  StartHandle: First attribute handle of the Service
+ * @param  EndHandle: Last attribute handle of the Service
+ * @retval None
+ */
+void SVCCTL_RegisterSvcHandleRange( SVC_CTL_p_EvtHandler_t pfBLE_SVC_Service_Event_Handler,
+                                    uint16_t StartHandle,
+                                    uint16_t EndHandle )
+{
+#if (BLE_CFG_SVC_MAX_NBR_CB > 0)
+  SVCCTL_HandleRange_t *p_tab = SVCCTL_EvtHandler.SVCCTL_SvcRangeTab;
+  uint8_t index;
+
+  if ((SVCCTL_EvtHandler.NbreOfRegisteredRange >= BLE_CFG_SVC_MAX_NBR_CB) || (StartHandle > EndHandle))
+  {
+    return;
+  }
+
+  /**
+   * Keep the table sorted by start handle, a range overlapping a registered one is ignored
+   * and the Service is then only reached through the walk over all the Service handlers
+   */
+  index = SVCCTL_EvtHandler.NbreOfRegisteredRange;
+  while ((index > 0) && (p_tab[index - 1].StartHandle > StartHandle))
+  {
+    index--;
+  }
+  if (((index > 0) && (p_tab[index - 1].EndHandle >= StartHandle)) ||
+      ((index < SVCCTL_EvtHandler.NbreOfRegisteredRange) && (p_tab[index].StartHandle <= EndHandle)))
+  {
+    return;
+  }
+  memmove(&p_tab[index + 1], &p_tab[index], (SVCCTL_EvtHandler.NbreOfRegisteredRange - index) * sizeof(SVCCTL_HandleRange_t));
+  p_tab[index].StartHandle = StartHandle;
+  p_tab[index].EndHandle = EndHandle;
+  p_tab[index].pfEvtHandler = pfBLE_SVC_Service_Event_Handler;
+  SVCCTL_EvtHandler.NbreOfRegisteredRange++;
+#else
+  (void)(pfBLE_SVC_Service_Event_Handler);
+  (void)(StartHandle);
+  (void)(EndHandle);
+#endif
+
+  return;
+}
+
 /**
  * @brief  BLE Controller initialization
  * @param  None
@@ -235,6 +373,10 @@ __WEAK SVCCTL_UserEvtFlowStatus_t SVCCTL_UserEvtRx( void *pckt )
   SVCCTL_EvtAckStatus_t event_notification_status;
   SVCCTL_UserEvtFlowStatus_t return_status;
   uint8_t index;
+#if (BLE_CFG_SVC_MAX_NBR_CB > 0)
+  SVC_CTL_p_EvtHandler_t p_owner_handler;
+  uint16_t attr_handle;
+#endif
 
   event_pckt = (hci_event_pckt*) ((hci_uart_pckt *) pckt)->data;
   event_notification_status = SVCCTL_EvtNotAck;
@@ -249,9 +391,28 @@ __WEAK SVCCTL_UserEvtFlowStatus_t SVCCTL_UserEvtRx( void *pckt )
       {
         case SVCCTL_GATT_EVT_TYPE:
 #if (BLE_CFG_SVC_MAX_NBR_CB > 0)
+          /**
+           * A GATT event on an attribute handle is first given to the Service owning that handle
+           */
+          p_owner_handler = NULL;
+          attr_handle = SVCCTL_GetAttrHandle(blecore_evt);
+          if (attr_handle != SVCCTL_NO_ATTR_HANDLE)
+          {
+            p_owner_handler = SVCCTL_FindSvcHandler(attr_handle);
+            if (p_owner_handler != NULL)
+            {
+              event_notification_status = p_owner_handler(pckt);
+            }
+          }
+
           /* For Service event handler */
-          for (index = 0; index < SVCCTL_EvtHandler.NbreOfRegisteredHandler; index++)
+          for (index = 0; (index < SVCCTL_EvtHandler.NbreOfRegisteredHandler) && (event_notification_status == SVCCTL_EvtNotAck); index++)
           {
+            if (SVCCTL_EvtHandler.SVCCTL__SvcHandlerTab[index] == p_owner_handler)
+            {
+              /* Already called */
+              continue;
+            }
             event_notification_status = SVCCTL_EvtHandler.SVCCTL__SvcHandlerTab[index](pckt);
             /**
              * When a GATT event has been acknowledged by a Service, there is no need to call the other registered handlers
@@ -287,6 +448,22 @@ __WEAK SVCCTL_UserEvtFlowStatus_t SVCCTL_UserEvtRx( void *pckt )
 #endif
           break;
 
+        case SVCCTL_L2CAP_EVT_TYPE:
+#if (BLE_CFG_SVC_MAX_NBR_CB > 0)
+          /**
+           * An L2CAP event is given to the Services managing connection-oriented channels
+           */
+          for (index = 0; index < SVCCTL_EvtHandler.NbreOfRegisteredHandler; index++)
+          {
+            event_notification_status = SVCCTL_EvtHandler.SVCCTL__SvcHandlerTab[index](pckt);
+            if (event_notification_status != SVCCTL_EvtNotAck)
+            {
+              break;
+            }
+          }
+#endif
+          break;
+
         default:
           break;
       }
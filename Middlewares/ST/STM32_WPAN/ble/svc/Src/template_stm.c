@@ -204,6 +204,9 @@ void SVCCTL_InitCustomSvc(void)
                       PRIMARY_SERVICE,
                       8, /*Max_Attribute_Records*/
                       &(aTemplateContext.TemplateSvcHdle));
+    SVCCTL_RegisterSvcHandleRange(Template_Event_Handler,
+                                  aTemplateContext.TemplateSvcHdle,
+                                  aTemplateContext.TemplateSvcHdle + 8 - 1);
 
     /**
      *  Add Write Characteristic
@@ -0,0 +1,82 @@
+/**
+ ******************************************************************************
+ * @file    app_conf.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the application configuration for the Linux host
+ *          build of the transport layer
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_CONF_H
+#define APP_CONF_H
+
+/******************************************************************************
+ * Transport Layer
+ ******************************************************************************/
+/**
+ * Queue length of BLE Event
+ * This parameter defines the number of asynchronous events that can be stored in the HCI layer before
+ * being reported to the application. When a command is sent but a response is not received yet, the
+ * HCI layer keeps on reporting the asynchronous events in this queue.
+ */
+#define CFG_TLBLE_EVT_QUEUE_LENGTH                                             5
+
+/**
+ * The maximum size of the HCI packets
+ */
+#define CFG_TLBLE_MOST_EVENT_PAYLOAD_SIZE                                    255
+
+#define TL_BLE_EVENT_FRAME_SIZE ( TL_EVT_HDR_SIZE + CFG_TLBLE_MOST_EVENT_PAYLOAD_SIZE )
+
+/******************************************************************************
+ * Sequencer
+ ******************************************************************************/
+/**
+ * These are the lists of task id registered to the sequencer
+ * Each task id shall be in the range [0:31]
+ */
+typedef enum
+{
+  CFG_TASK_APP_ID,
+  CFG_TASK_HCI_ASYNCH_EVT_ID,
+  CFG_LAST_TASK_ID_WITH_HCICMD,                                               /**< Shall be LAST in the list */
+} CFG_Task_Id_With_HCI_Cmd_t;
+
+/**< Add in that list all tasks that never send a ACI/HCI command */
+typedef enum
+{
+  CFG_FIRST_TASK_ID_WITH_NO_HCICMD = CFG_LAST_TASK_ID_WITH_HCICMD - 1,        /**< Shall be FIRST in the list */
+  CFG_TASK_OTHER_ID,
+  CFG_LAST_TASK_ID_WITH_NO_HCICMD                                            /**< Shall be LAST in the list */
+} CFG_Task_Id_With_NO_HCI_Cmd_t;
+
+/**
+ * This is the list of priority required by the application
+ * Each Id shall be in the range 0..31
+ */
+typedef enum
+{
+  CFG_SCH_PRIO_0,
+  CFG_PRIO_NBR
+} CFG_SCH_Prio_Id_t;
+
+/**
+ * This is a bit mapping over 32bits listing all events id supported in the application
+ */
+typedef enum
+{
+  CFG_IDLEEVT_HCI_CMD_EVT_RSP_ID,
+} CFG_IdleEvt_Id_t;
+
+#endif /*APP_CONF_H */
@@ -0,0 +1,26 @@
+/**
+ ******************************************************************************
+ * @file    ble_conf.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the BLE configuration for the Linux host build of
+ *          the transport layer
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BLE_CONF_H
+#define BLE_CONF_H
+
+#include "app_conf.h"
+
+#endif /*BLE_CONF_H */
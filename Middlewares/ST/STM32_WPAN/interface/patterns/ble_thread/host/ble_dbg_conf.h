@@ -0,0 +1,27 @@
+/**
+ ******************************************************************************
+ * @file    ble_dbg_conf.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the BLE debug configuration for the Linux host
+ *          build of the transport layer - all the traces are disabled
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BLE_DBG_CONF_H
+#define BLE_DBG_CONF_H
+
+#define BLE_DBG_APP_MSG(...)
+#define BLE_DBG_SVCCTL_MSG(...)
+
+#endif /*BLE_DBG_CONF_H */
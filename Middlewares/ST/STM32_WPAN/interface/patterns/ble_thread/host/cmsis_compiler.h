@@ -0,0 +1,80 @@
+/**
+ ******************************************************************************
+ * @file    cmsis_compiler.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the CMSIS compiler header for a Linux host build of
+ *          the transport layer
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The interrupt masking (PRIMASK) used by the transport layer and by the list
+ * management is replaced by a recursive pthread mutex. The IPCC "interrupt"
+ * handlers are executed by the thread emulating the CPU2 with that mutex held,
+ * so they never run while the CPU1 code is in a critical section.
+ *
+ * Only the sequence used by the middleware is supported:
+ *   primask_bit = __get_PRIMASK(); __disable_irq(); ... __set_PRIMASK(primask_bit);
+ *
+ * This directory shall be in the include path before the CMSIS one and the
+ * build shall use -D_GNU_SOURCE -pthread.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CMSIS_COMPILER_H
+#define __CMSIS_COMPILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <pthread.h>
+
+/* Exported variables --------------------------------------------------------*/
+extern pthread_mutex_t HW_IPCC_HOST_IrqLock;
+
+/* Exported macros -----------------------------------------------------------*/
+#ifndef __WEAK
+#define __WEAK                                  __attribute__((weak))
+#endif
+#ifndef __weak
+#define __weak                                  __attribute__((weak))
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE                         static inline
+#endif
+
+/* Exported functions --------------------------------------------------------*/
+__STATIC_INLINE uint32_t __get_PRIMASK( void )
+{
+  return 0;
+}
+
+__STATIC_INLINE void __disable_irq( void )
+{
+  (void)pthread_mutex_lock( &HW_IPCC_HOST_IrqLock );
+}
+
+__STATIC_INLINE void __set_PRIMASK( uint32_t priMask )
+{
+  (void)priMask;
+  (void)pthread_mutex_unlock( &HW_IPCC_HOST_IrqLock );
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__CMSIS_COMPILER_H */
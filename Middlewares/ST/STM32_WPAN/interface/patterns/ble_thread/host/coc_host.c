@@ -0,0 +1,1110 @@
+/**
+ ******************************************************************************
+ * @file    coc_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host loopback test of the L2CAP connection-oriented channels
+ *          of coc_stm.c
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * coc_stm.c exchanges <bytes> in both directions on two channels with a
+ * simulated peer. The L2CAP ACI commands are stubbed, the events of the BLE
+ * stack are given directly to the service handler:
+ *
+ *   - channel 1 on link 1, opened with COC_STM_Connect(): the peer has the MTU
+ *     <mtu> and the MPS <mps>
+ *   - channel 2 on link 2, requested by the peer: MTU 300, MPS 60
+ *
+ * The buffers given to COC_STM_Send() are of <buffer> bytes. The K-frames
+ * accepted by aci_l2cap_coc_tx_data() wait in a TX pool of <pool> K-frames.
+ * At each connection event, up to <tx> of them are transmitted to the peer,
+ * which gives back its credits, then the peer sends up to <tx> K-frames on
+ * each channel, as long as it has credits. ACI_L2CAP_COC_TX_POOL_AVAILABLE is
+ * sent once the pool has room again after a K-frame was rejected.
+ *
+ * The test checks that:
+ *   - the bytes reassembled by the peer and the ones received by the
+ *     application are the ones sent, in order
+ *   - each SDU is of up to the peer MTU and ends with the buffer, each K-frame
+ *     of up to the peer MPS and full except the last one of a SDU
+ *   - no K-frame is sent without credit or while waiting for the TX pool, every
+ *     rejected K-frame is sent again after one ACI_L2CAP_COC_TX_POOL_AVAILABLE
+ *   - the credits given back match the K-frames consumed, none while the
+ *     reception flow is disabled, all of them once enabled again
+ *   - a K-frame with a wrong SDU length is dropped and its credit given back
+ *   - a request is refused when all the channel entries are in use, a request
+ *     on another SPSM is left to the other handlers
+ *   - COC_STM_CONNECT_FAILED_EVT reports the L2CAP result of the peer
+ *   - COC_STM_Close() and COC_STM_Disconnect() release the buffer being sent
+ *     and report COC_STM_DISCONNECTED_EVT
+ *
+ * Usage: coc_host [-n bytes] [-b buffer] [-p pool] [-t tx] [-u mtu] [-m mps]
+ *                 [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <unistd.h>
+
+#include "common_blesvc.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define COC_HOST_CHANNEL_NBR            (2U)
+#define COC_HOST_REQ_HANDLE             (0x0003U)       /**< Link without channel entry left */
+#define COC_HOST_CHANNEL_INDEX          (0x40U)         /**< Channel index of the first channel in the stack */
+#define COC_HOST_INTERVAL_US            (7500U)         /**< Connection interval */
+#define COC_HOST_HOLD_EVENTS            (20U)           /**< Connection events with the reception flow disabled */
+#define COC_HOST_MAX_STALLS             (1000U)
+#define COC_HOST_MAX_ERRORS             (10U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint16_t ConnectionHandle;
+  uint8_t  ChannelIndex;
+  uint16_t PeerMtu;
+  uint16_t PeerMps;
+  uint16_t PeerInitialCredits;
+  uint8_t  Open;
+  /* Service to peer */
+  uint16_t PeerCredits;         /**< K-frames the service may still send */
+  uint16_t PeerConsumed;        /**< K-frames received by the peer, credits not given back yet */
+  uint32_t TxGivenNbr;          /**< Bytes given to COC_STM_Send() */
+  uint32_t TxBufLength;         /**< Length of the buffer being sent, 0 if none */
+  uint32_t PeerRxNbr;           /**< Bytes reassembled by the peer */
+  uint32_t PeerRxFrameNbr;      /**< K-frames received by the peer */
+  uint16_t PeerSduLength;       /**< Length of the SDU being reassembled, 0 at a SDU boundary */
+  uint16_t PeerSduOffset;
+  uint8_t  *pTxBuf;
+  /* Peer to service */
+  uint16_t LocalCredits;        /**< K-frames the peer may still send */
+  uint32_t PeerTxNbr;           /**< Bytes sent by the peer */
+  uint32_t PeerTxSduNbr;
+  uint16_t PeerTxSduLength;     /**< Length of the SDU being sent, 0 at a SDU boundary */
+  uint16_t PeerTxSduOffset;
+  uint32_t AppRxNbr;            /**< Bytes received by the application */
+  uint16_t AppSduOffset;
+  uint8_t  RxFlowHeld;          /**< The reception flow is disabled */
+  uint32_t HoldEventNbr;        /**< Remaining connection events with the reception flow disabled */
+} COC_HOST_Channel_t;
+
+typedef struct
+{
+  uint8_t  ChannelIndex;
+  uint16_t Length;
+  uint8_t  Data[COC_STM_TX_FRAME_MAX];
+} COC_HOST_Frame_t;
+
+/* Private variables ---------------------------------------------------------*/
+static COC_HOST_Channel_t Channel[COC_HOST_CHANNEL_NBR] =
+{
+  { 0x0001U, COC_HOST_CHANNEL_INDEX,      512U, 247U, 6U },
+  { 0x0002U, COC_HOST_CHANNEL_INDEX + 1U, 300U, 60U,  3U },
+};
+
+static uint32_t ByteNbr = 200000U;
+static uint32_t BufferSize = 3000U;
+static uint16_t PoolSize = 4U;
+static uint16_t TxNbr = 4U;
+static const char *CsvFile;
+
+static SVC_CTL_p_EvtHandler_t CocHandler;
+static uint8_t ProcessReq;
+static uint32_t LinkEventNbr;
+
+static COC_HOST_Frame_t *pPool;
+static uint16_t PoolCount;
+static uint16_t PoolHead;
+static uint8_t PoolFullPending;
+static uint32_t PoolFullNbr;
+static uint32_t TxPoolAvailNbr;
+
+static uint8_t ConnectConfirmNbr;
+static uint16_t ConnectConfirmResult;
+static uint16_t ConnectConfirmCredits;
+static uint8_t DisconnectIndex;
+static uint32_t TxCpltNbr;
+static tBleStatus TxCpltStatus;
+static uint32_t DisconnectedNbr;
+static uint32_t ConnectFailedNbr;
+static tBleStatus ConnectFailedStatus;
+static uint16_t ConnectFailedResult;
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static void COC_HOST_LinkEvent( void );
+static void COC_HOST_PeerRx( COC_HOST_Channel_t *p_Channel, const COC_HOST_Frame_t *p_Frame );
+static void COC_HOST_PeerTx( COC_HOST_Channel_t *p_Channel );
+static void COC_HOST_AppTx( COC_HOST_Channel_t *p_Channel );
+static void COC_HOST_AppRxFlow( COC_HOST_Channel_t *p_Channel );
+static void COC_HOST_Process( void );
+static SVCCTL_EvtAckStatus_t COC_HOST_InjectEvt( uint16_t Ecode, const void *p_Data, uint8_t Size );
+static void COC_HOST_InjectConnect( uint16_t ConnectionHandle, uint16_t Spsm, uint16_t Mtu, uint16_t Mps,
+                                    uint16_t Credits );
+static void COC_HOST_InjectConnectConfirm( uint16_t ConnectionHandle, uint16_t Result, uint8_t ChannelIndex,
+                                           uint16_t Mtu, uint16_t Mps, uint16_t Credits );
+static void COC_HOST_InjectDisconnect( uint8_t ChannelIndex );
+static void COC_HOST_TestConnect( void );
+static void COC_HOST_TestDisconnect( void );
+static COC_HOST_Channel_t * COC_HOST_GetChannel( uint8_t ChannelIndex );
+static COC_HOST_Channel_t * COC_HOST_GetLink( uint16_t ConnectionHandle );
+static uint8_t COC_HOST_Byte( const COC_HOST_Channel_t *p_Channel, uint32_t Position, uint8_t Direction );
+static uint8_t COC_HOST_Done( void );
+static void COC_HOST_Error( const char *p_Msg, uint32_t Value );
+static void COC_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  COC_STM_Stats_t stats[COC_HOST_CHANNEL_NBR];
+  aci_l2cap_coc_rx_data_event_rp0 rx_data;
+  COC_HOST_Channel_t *p_channel;
+  uint32_t pool_full_nbr;
+  uint32_t frame_nbr;
+  uint32_t credit_wait_nbr;
+  uint32_t progress;
+  uint32_t last_progress;
+  uint32_t stall_nbr;
+  uint32_t index;
+  FILE *p_csv;
+  int opt;
+
+  while((opt = getopt(argc, argv, "n:b:p:t:u:m:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'n':
+        ByteNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'b':
+        BufferSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'p':
+        PoolSize = (uint16_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 't':
+        TxNbr = (uint16_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'u':
+        Channel[0].PeerMtu = (uint16_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'm':
+        Channel[0].PeerMps = (uint16_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        COC_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  /* The MPS of the LE credit based channels is 23 bytes at least */
+  if((ByteNbr == 0U) || (BufferSize == 0U) || (PoolSize == 0U) || (TxNbr == 0U) ||
+     (Channel[0].PeerMtu < 23U) || (Channel[0].PeerMps < 23U))
+  {
+    COC_HOST_Usage(argv[0]);
+  }
+
+  pPool = malloc(PoolSize * sizeof(COC_HOST_Frame_t));
+  for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+  {
+    Channel[index].pTxBuf = malloc(BufferSize);
+  }
+
+  COC_STM_Init();
+  if(CocHandler == NULL)
+  {
+    COC_HOST_Error("service handler not registered", 0);
+    return 1;
+  }
+
+  COC_HOST_TestConnect();
+
+  /**
+   * A K-frame with a SDU length above the MTU is dropped, its credit is given back
+   */
+  p_channel = &Channel[0];
+  if(p_channel->Open != FALSE)
+  {
+    rx_data.Channel_Index = p_channel->ChannelIndex;
+    rx_data.Length = 2U;
+    rx_data.Data[0] = (uint8_t)(BLE_CFG_COC_MTU + 1);
+    rx_data.Data[1] = (uint8_t)((BLE_CFG_COC_MTU + 1) >> 8);
+    p_channel->LocalCredits--;
+    COC_HOST_InjectEvt(ACI_L2CAP_COC_RX_DATA_VSEVT_CODE, &rx_data, (uint8_t)(3U + rx_data.Length));
+  }
+
+  /**
+   * Transfer in both directions on both channels
+   */
+  last_progress = 0;
+  stall_nbr = 0;
+  while((ErrorNbr == 0U) && (COC_HOST_Done() == FALSE))
+  {
+    for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+    {
+      COC_HOST_AppTx(&Channel[index]);
+      COC_HOST_AppRxFlow(&Channel[index]);
+    }
+    COC_HOST_Process();
+    COC_HOST_LinkEvent();
+    COC_HOST_Process();
+
+    progress = 0;
+    for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+    {
+      progress += Channel[index].PeerRxNbr + Channel[index].AppRxNbr;
+    }
+    if(progress == last_progress)
+    {
+      stall_nbr++;
+      if(stall_nbr >= COC_HOST_MAX_STALLS)
+      {
+        COC_HOST_Error("transfer stalled", progress);
+        break;
+      }
+    }
+    else
+    {
+      stall_nbr = 0;
+      last_progress = progress;
+    }
+  }
+
+  pool_full_nbr = 0;
+  frame_nbr = 0;
+  credit_wait_nbr = 0;
+  for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+  {
+    p_channel = &Channel[index];
+    memset(&stats[index], 0, sizeof(stats[index]));
+    if(COC_STM_GetStats(p_channel->ChannelIndex, &stats[index]) != BLE_STATUS_SUCCESS)
+    {
+      COC_HOST_Error("no statistics on channel", p_channel->ChannelIndex);
+    }
+    pool_full_nbr += stats[index].PoolFullNbr;
+    frame_nbr += stats[index].TxFrameNbr;
+    credit_wait_nbr += stats[index].CreditWaitNbr;
+
+    if((stats[index].TxByteNbr != ByteNbr) || (p_channel->PeerRxNbr != ByteNbr))
+    {
+      COC_HOST_Error("bytes lost or sent twice on channel", p_channel->ChannelIndex);
+    }
+    if((stats[index].RxByteNbr != ByteNbr) || (p_channel->AppRxNbr != ByteNbr))
+    {
+      COC_HOST_Error("bytes lost or received twice on channel", p_channel->ChannelIndex);
+    }
+    if(stats[index].TxFrameNbr != p_channel->PeerRxFrameNbr)
+    {
+      COC_HOST_Error("K-frames sent do not match the ones received on channel", p_channel->ChannelIndex);
+    }
+    if(stats[index].RxSduNbr != p_channel->PeerTxSduNbr)
+    {
+      COC_HOST_Error("SDUs received do not match the ones sent on channel", p_channel->ChannelIndex);
+    }
+    if(stats[index].RxErrorNbr != ((index == 0U) ? 1U : 0U))
+    {
+      COC_HOST_Error("wrong number of dropped K-frames on channel", p_channel->ChannelIndex);
+    }
+
+    printf("channel 0x%02X (mtu %4u, mps %3u): %u bytes in %u SDUs and %u K-frames sent, %u bytes in %u SDUs "
+           "received, credit waits %u, pool full %u, goodput %u/%u B/s\n",
+           p_channel->ChannelIndex, p_channel->PeerMtu, p_channel->PeerMps, stats[index].TxByteNbr,
+           stats[index].TxSduNbr, stats[index].TxFrameNbr, stats[index].RxByteNbr, stats[index].RxSduNbr,
+           stats[index].CreditWaitNbr, stats[index].PoolFullNbr, stats[index].TxGoodput, stats[index].RxGoodput);
+  }
+
+  if((PoolFullNbr != pool_full_nbr) || (TxPoolAvailNbr != pool_full_nbr))
+  {
+    COC_HOST_Error("pool full without one tx pool available event", TxPoolAvailNbr);
+  }
+
+  COC_HOST_TestDisconnect();
+
+  printf("pool %2u, tx %2u, mps %3u: %u bytes per channel and direction, %u K-frames, credit waits %u, "
+         "pool full %u, tx pool available %u, %u connection events, %u errors\n",
+         PoolSize, TxNbr, Channel[0].PeerMps, ByteNbr, frame_nbr, credit_wait_nbr, pool_full_nbr, TxPoolAvailNbr,
+         LinkEventNbr, ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "pool,tx,mps,bytes,frames,credit_waits,pool_full,tx_pool_available,events,errors\n");
+      }
+      fprintf(p_csv, "%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", PoolSize, TxNbr, Channel[0].PeerMps, ByteNbr, frame_nbr,
+              credit_wait_nbr, pool_full_nbr, TxPoolAvailNbr, LinkEventNbr, ErrorNbr);
+      fclose(p_csv);
+    }
+  }
+
+  for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+  {
+    free(Channel[index].pTxBuf);
+  }
+  free(pPool);
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/**
+ * @brief Stand-in of svc_ctl.c, the handler of the service is called directly
+ */
+void SVCCTL_RegisterSvcHandler( SVC_CTL_p_EvtHandler_t pfBLE_SVC_Service_Event_Handler )
+{
+  CocHandler = pfBLE_SVC_Service_Event_Handler;
+
+  return;
+}
+
+/**
+ * @brief Stand-ins of the L2CAP ACI commands, the peer answers through the events injected by the test
+ */
+tBleStatus aci_l2cap_coc_connect( uint16_t Connection_Handle,
+                                  uint16_t SPSM,
+                                  uint16_t MTU,
+                                  uint16_t MPS,
+                                  uint16_t Initial_Credits,
+                                  uint8_t Channel_Number )
+{
+  (void)Connection_Handle;
+
+  if((SPSM != BLE_CFG_COC_SPSM) || (MTU != BLE_CFG_COC_MTU) || (MPS != BLE_CFG_COC_MPS) ||
+     (Initial_Credits != BLE_CFG_COC_RX_CREDITS) || (Channel_Number != 0U))
+  {
+    COC_HOST_Error("wrong connection request parameters", SPSM);
+  }
+
+  return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_l2cap_coc_connect_confirm( uint16_t Connection_Handle,
+                                          uint16_t MTU,
+                                          uint16_t MPS,
+                                          uint16_t Initial_Credits,
+                                          uint16_t Result,
+                                          uint8_t* Channel_Number,
+                                          uint8_t* Channel_Index_List )
+{
+  COC_HOST_Channel_t *p_channel;
+
+  ConnectConfirmNbr++;
+  ConnectConfirmResult = Result;
+  ConnectConfirmCredits = Initial_Credits;
+
+  if((MTU != BLE_CFG_COC_MTU) || (MPS != BLE_CFG_COC_MPS))
+  {
+    COC_HOST_Error("wrong connection response parameters", MTU);
+  }
+
+  p_channel = COC_HOST_GetLink(Connection_Handle);
+  if((Result != 0x0000U) || (p_channel == NULL))
+  {
+    *Channel_Number = 0;
+    return BLE_STATUS_SUCCESS;
+  }
+
+  *Channel_Number = 1;
+  Channel_Index_List[0] = p_channel->ChannelIndex;
+
+  return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_l2cap_coc_disconnect( uint8_t Channel_Index )
+{
+  DisconnectIndex = Channel_Index;
+
+  return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_l2cap_coc_flow_control( uint8_t Channel_Index, uint16_t Credits )
+{
+  COC_HOST_Channel_t *p_channel;
+
+  p_channel = COC_HOST_GetChannel(Channel_Index);
+  if(p_channel == NULL)
+  {
+    COC_HOST_Error("credits given on an unknown channel", Channel_Index);
+    return BLE_STATUS_INVALID_PARAMS;
+  }
+
+  if(p_channel->RxFlowHeld != FALSE)
+  {
+    COC_HOST_Error("credits given while the reception flow is disabled on channel", Channel_Index);
+  }
+  if((p_channel->LocalCredits + Credits) > BLE_CFG_COC_RX_CREDITS)
+  {
+    COC_HOST_Error("more credits given than consumed on channel", Channel_Index);
+  }
+  p_channel->LocalCredits += Credits;
+
+  return BLE_STATUS_SUCCESS;
+}
+
+tBleStatus aci_l2cap_coc_tx_data( uint8_t Channel_Index, uint16_t Length, const uint8_t* Data )
+{
+  COC_HOST_Channel_t *p_channel;
+  COC_HOST_Frame_t *p_frame;
+
+  p_channel = COC_HOST_GetChannel(Channel_Index);
+  if((p_channel == NULL) || (p_channel->Open == FALSE))
+  {
+    COC_HOST_Error("K-frame sent on a closed channel", Channel_Index);
+    return BLE_STATUS_INVALID_PARAMS;
+  }
+  if(PoolFullPending != FALSE)
+  {
+    COC_HOST_Error("K-frame sent while waiting for the TX pool on channel", Channel_Index);
+  }
+  if(p_channel->PeerCredits == 0U)
+  {
+    COC_HOST_Error("K-frame sent without credit on channel", Channel_Index);
+    return BLE_STATUS_FAILED;
+  }
+  if((Length == 0U) || (Length > MIN(p_channel->PeerMps, COC_STM_TX_FRAME_MAX)))
+  {
+    COC_HOST_Error("wrong K-frame length", Length);
+    return BLE_STATUS_INVALID_PARAMS;
+  }
+
+  if(PoolCount == PoolSize)
+  {
+    PoolFullPending = TRUE;
+    PoolFullNbr++;
+    return BLE_STATUS_INSUFFICIENT_RESOURCES;
+  }
+
+  p_frame = &pPool[(PoolHead + PoolCount) % PoolSize];
+  p_frame->ChannelIndex = Channel_Index;
+  p_frame->Length = Length;
+  memcpy(p_frame->Data, Data, Length);
+  PoolCount++;
+  p_channel->PeerCredits--;
+
+  return BLE_STATUS_SUCCESS;
+}
+
+void COC_STM_App_Notification( COC_STM_App_Notification_evt_t *pNotification )
+{
+  COC_HOST_Channel_t *p_channel;
+  uint32_t index;
+
+  p_channel = COC_HOST_GetLink(pNotification->ConnectionHandle);
+
+  switch(pNotification->Coc_Evt_Opcode)
+  {
+    case COC_STM_CONNECTED_EVT:
+      if((p_channel == NULL) || (p_channel->ChannelIndex != pNotification->ChannelIndex))
+      {
+        COC_HOST_Error("unexpected channel connected", pNotification->ChannelIndex);
+        break;
+      }
+      p_channel->Open = TRUE;
+      p_channel->PeerCredits = p_channel->PeerInitialCredits;
+      p_channel->LocalCredits = BLE_CFG_COC_RX_CREDITS;
+      break;
+
+    case COC_STM_CONNECT_FAILED_EVT:
+      ConnectFailedNbr++;
+      ConnectFailedStatus = pNotification->Status;
+      ConnectFailedResult = pNotification->Result;
+      break;
+
+    case COC_STM_DISCONNECTED_EVT:
+      DisconnectedNbr++;
+      if(p_channel != NULL)
+      {
+        p_channel->Open = FALSE;
+      }
+      break;
+
+    case COC_STM_TX_CPLT_EVT:
+      TxCpltNbr++;
+      TxCpltStatus = pNotification->Status;
+      if((p_channel == NULL) || (pNotification->pPayload != p_channel->pTxBuf) || (p_channel->TxBufLength == 0U))
+      {
+        COC_HOST_Error("unexpected buffer released on channel", pNotification->ChannelIndex);
+        break;
+      }
+      if((pNotification->Status == BLE_STATUS_SUCCESS) && (pNotification->Length != p_channel->TxBufLength))
+      {
+        COC_HOST_Error("buffer partly sent on channel", pNotification->ChannelIndex);
+      }
+      p_channel->TxBufLength = 0;
+      break;
+
+    case COC_STM_RX_DATA_EVT:
+      if((p_channel == NULL) || (pNotification->ChannelIndex != p_channel->ChannelIndex))
+      {
+        COC_HOST_Error("data received on an unexpected channel", pNotification->ChannelIndex);
+        break;
+      }
+      if((pNotification->SduOffset != p_channel->AppSduOffset) ||
+         (pNotification->SduLength != p_channel->PeerTxSduLength) ||
+         ((pNotification->SduOffset + pNotification->Length) > pNotification->SduLength))
+      {
+        COC_HOST_Error("wrong SDU offset or length received on channel", p_channel->ChannelIndex);
+      }
+      for(index = 0; index < pNotification->Length; index++)
+      {
+        if(pNotification->pPayload[index] != COC_HOST_Byte(p_channel, p_channel->AppRxNbr + index, 1U))
+        {
+          COC_HOST_Error("wrong byte received at", p_channel->AppRxNbr + index);
+          break;
+        }
+      }
+      p_channel->AppRxNbr += pNotification->Length;
+      p_channel->AppSduOffset += pNotification->Length;
+      if(p_channel->AppSduOffset == pNotification->SduLength)
+      {
+        p_channel->AppSduOffset = 0;
+      }
+      break;
+
+    case COC_STM_PROCESS_REQ_EVT:
+      ProcessReq = TRUE;
+      break;
+
+    default:
+      break;
+  }
+
+  return;
+}
+
+uint32_t COC_STM_App_GetTick( void )
+{
+  return (uint32_t)(((uint64_t)LinkEventNbr * COC_HOST_INTERVAL_US) / 1000U);
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief Connection event: the K-frames held in the TX pool are transmitted and the peer gives back its credits,
+ *        then the peer sends its own K-frames
+ */
+static void COC_HOST_LinkEvent( void )
+{
+  COC_HOST_Channel_t *p_channel;
+  aci_l2cap_coc_flow_control_event_rp0 flow_control;
+  uint16_t tx_nbr;
+  uint32_t index;
+
+  LinkEventNbr++;
+
+  for(tx_nbr = 0; (tx_nbr < TxNbr) && (PoolCount != 0U); tx_nbr++)
+  {
+    p_channel = COC_HOST_GetChannel(pPool[PoolHead].ChannelIndex);
+    if(p_channel != NULL)
+    {
+      COC_HOST_PeerRx(p_channel, &pPool[PoolHead]);
+    }
+    PoolHead = (PoolHead + 1U) % PoolSize;
+    PoolCount--;
+  }
+
+  for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+  {
+    p_channel = &Channel[index];
+    if((p_channel->Open != FALSE) && (p_channel->PeerConsumed != 0U))
+    {
+      flow_control.Channel_Index = p_channel->ChannelIndex;
+      flow_control.Credits = p_channel->PeerConsumed;
+      p_channel->PeerCredits += p_channel->PeerConsumed;
+      p_channel->PeerConsumed = 0;
+      COC_HOST_InjectEvt(ACI_L2CAP_COC_FLOW_CONTROL_VSEVT_CODE, &flow_control, sizeof(flow_control));
+    }
+  }
+
+  for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+  {
+    COC_HOST_PeerTx(&Channel[index]);
+  }
+
+  if((PoolFullPending != FALSE) && (PoolCount < PoolSize))
+  {
+    PoolFullPending = FALSE;
+    TxPoolAvailNbr++;
+    if(COC_HOST_InjectEvt(ACI_L2CAP_COC_TX_POOL_AVAILABLE_VSEVT_CODE, NULL, 0) != SVCCTL_EvtNotAck)
+    {
+      COC_HOST_Error("tx pool available event acknowledged", TxPoolAvailNbr);
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief Reassembly of the K-frames by the peer. The buffers given to COC_STM_Send() are expected to be cut in SDUs
+ *        of the peer MTU, the SDUs in K-frames of the largest size
+ */
+static void COC_HOST_PeerRx( COC_HOST_Channel_t *p_Channel, const COC_HOST_Frame_t *p_Frame )
+{
+  const uint8_t *p_data;
+  uint32_t buffer_end;
+  uint16_t frame_max;
+  uint16_t expected;
+  uint16_t length;
+  uint16_t index;
+
+  p_Channel->PeerRxFrameNbr++;
+  p_Channel->PeerConsumed++;
+  frame_max = MIN(p_Channel->PeerMps, COC_STM_TX_FRAME_MAX);
+  p_data = p_Frame->Data;
+  length = p_Frame->Length;
+
+  if(p_Channel->PeerSduLength == 0U)
+  {
+    buffer_end = ((p_Channel->PeerRxNbr / BufferSize) + 1U) * BufferSize;
+    buffer_end = MIN(buffer_end, ByteNbr);
+    expected = (uint16_t)MIN(buffer_end - p_Channel->PeerRxNbr, p_Channel->PeerMtu);
+    if((length < 2U) || ((uint16_t)(p_data[0] | (p_data[1] << 8)) != expected))
+    {
+      COC_HOST_Error("wrong SDU length sent on channel", p_Channel->ChannelIndex);
+      return;
+    }
+    p_Channel->PeerSduLength = expected;
+    p_Channel->PeerSduOffset = 0;
+    if(length != MIN(expected + 2U, frame_max))
+    {
+      COC_HOST_Error("wrong length of the first K-frame of a SDU", length);
+    }
+    p_data += 2;
+    length -= 2U;
+  }
+  else if(length != MIN(p_Channel->PeerSduLength - p_Channel->PeerSduOffset, frame_max))
+  {
+    COC_HOST_Error("wrong K-frame length", length);
+  }
+
+  if((p_Channel->PeerSduOffset + length) > p_Channel->PeerSduLength)
+  {
+    COC_HOST_Error("K-frame beyond the SDU on channel", p_Channel->ChannelIndex);
+    return;
+  }
+
+  for(index = 0; index < length; index++)
+  {
+    if(p_data[index] != COC_HOST_Byte(p_Channel, p_Channel->PeerRxNbr + index, 0U))
+    {
+      COC_HOST_Error("wrong byte sent at", p_Channel->PeerRxNbr + index);
+      break;
+    }
+  }
+  p_Channel->PeerRxNbr += length;
+  p_Channel->PeerSduOffset += length;
+  if(p_Channel->PeerSduOffset == p_Channel->PeerSduLength)
+  {
+    p_Channel->PeerSduLength = 0;
+  }
+
+  return;
+}
+
+/**
+ * @brief The peer sends SDUs of various lengths up to BLE_CFG_COC_MTU, in K-frames of up to BLE_CFG_COC_MPS
+ */
+static void COC_HOST_PeerTx( COC_HOST_Channel_t *p_Channel )
+{
+  aci_l2cap_coc_rx_data_event_rp0 rx_data;
+  uint16_t frame_nbr;
+  uint16_t hdr;
+  uint16_t payload;
+  uint16_t index;
+
+  for(frame_nbr = 0; frame_nbr < TxNbr; frame_nbr++)
+  {
+    if((p_Channel->Open == FALSE) || (p_Channel->LocalCredits == 0U) || (p_Channel->PeerTxNbr == ByteNbr))
+    {
+      return;
+    }
+
+    hdr = 0;
+    if(p_Channel->PeerTxSduLength == 0U)
+    {
+      p_Channel->PeerTxSduLength = (uint16_t)MIN(1U + ((p_Channel->PeerTxSduNbr * 97U) % BLE_CFG_COC_MTU),
+                                                 ByteNbr - p_Channel->PeerTxNbr);
+      p_Channel->PeerTxSduOffset = 0;
+      rx_data.Data[0] = (uint8_t)p_Channel->PeerTxSduLength;
+      rx_data.Data[1] = (uint8_t)(p_Channel->PeerTxSduLength >> 8);
+      hdr = 2;
+    }
+    payload = MIN(p_Channel->PeerTxSduLength - p_Channel->PeerTxSduOffset, BLE_CFG_COC_MPS - hdr);
+    for(index = 0; index < payload; index++)
+    {
+      rx_data.Data[hdr + index] = COC_HOST_Byte(p_Channel, p_Channel->PeerTxNbr + index, 1U);
+    }
+    rx_data.Channel_Index = p_Channel->ChannelIndex;
+    rx_data.Length = hdr + payload;
+    p_Channel->LocalCredits--;
+
+    /* The SDU length is checked by the application during the injection */
+    COC_HOST_InjectEvt(ACI_L2CAP_COC_RX_DATA_VSEVT_CODE, &rx_data, (uint8_t)(3U + rx_data.Length));
+
+    p_Channel->PeerTxNbr += payload;
+    p_Channel->PeerTxSduOffset += payload;
+    if(p_Channel->PeerTxSduOffset == p_Channel->PeerTxSduLength)
+    {
+      p_Channel->PeerTxSduNbr++;
+      p_Channel->PeerTxSduLength = 0;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief The next buffer is given once the previous one is released
+ */
+static void COC_HOST_AppTx( COC_HOST_Channel_t *p_Channel )
+{
+  uint32_t length;
+  uint32_t index;
+
+  if((p_Channel->Open == FALSE) || (p_Channel->TxBufLength != 0U) || (p_Channel->TxGivenNbr == ByteNbr))
+  {
+    return;
+  }
+
+  length = MIN(BufferSize, ByteNbr - p_Channel->TxGivenNbr);
+  for(index = 0; index < length; index++)
+  {
+    p_Channel->pTxBuf[index] = COC_HOST_Byte(p_Channel, p_Channel->TxGivenNbr + index, 0U);
+  }
+
+  if(COC_STM_Send(p_Channel->ChannelIndex, p_Channel->pTxBuf, length) != BLE_STATUS_SUCCESS)
+  {
+    COC_HOST_Error("buffer refused on channel", p_Channel->ChannelIndex);
+    return;
+  }
+  p_Channel->TxBufLength = length;
+  p_Channel->TxGivenNbr += length;
+
+  return;
+}
+
+/**
+ * @brief The reception flow of the second channel is disabled for COC_HOST_HOLD_EVENTS connection events halfway
+ *        through the transfer: the peer shall stop once it has used its credits
+ */
+static void COC_HOST_AppRxFlow( COC_HOST_Channel_t *p_Channel )
+{
+  if((p_Channel != &Channel[1]) || (p_Channel->Open == FALSE))
+  {
+    return;
+  }
+
+  if((p_Channel->RxFlowHeld == FALSE) && (p_Channel->HoldEventNbr == 0U) && (p_Channel->AppRxNbr >= (ByteNbr / 2U)))
+  {
+    p_Channel->RxFlowHeld = TRUE;
+    p_Channel->HoldEventNbr = COC_HOST_HOLD_EVENTS;
+    (void)COC_STM_SetRxFlow(p_Channel->ChannelIndex, FALSE);
+  }
+  else if(p_Channel->RxFlowHeld != FALSE)
+  {
+    p_Channel->HoldEventNbr--;
+    if(p_Channel->HoldEventNbr == 0U)
+    {
+      if((p_Channel->PeerTxNbr != ByteNbr) && (p_Channel->LocalCredits != 0U))
+      {
+        COC_HOST_Error("the peer still has credits with the reception flow disabled on channel",
+                       p_Channel->ChannelIndex);
+      }
+      p_Channel->RxFlowHeld = FALSE;
+      (void)COC_STM_SetRxFlow(p_Channel->ChannelIndex, TRUE);
+      if(p_Channel->LocalCredits != BLE_CFG_COC_RX_CREDITS)
+      {
+        COC_HOST_Error("credits not all given back with the reception flow enabled on channel",
+                       p_Channel->ChannelIndex);
+      }
+      /* Never 0 again: the flow is disabled once */
+      p_Channel->HoldEventNbr = UINT32_MAX;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief Background task of the application
+ */
+static void COC_HOST_Process( void )
+{
+  while(ProcessReq != FALSE)
+  {
+    ProcessReq = FALSE;
+    COC_STM_Process();
+  }
+
+  return;
+}
+
+/**
+ * @brief Vendor specific event of the BLE stack given to the service handler
+ */
+static SVCCTL_EvtAckStatus_t COC_HOST_InjectEvt( uint16_t Ecode, const void *p_Data, uint8_t Size )
+{
+  uint8_t evt[5U + BLE_EVT_MAX_PARAM_LEN];
+
+  evt[0] = HCI_EVENT_PKT_TYPE;
+  evt[1] = HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE;
+  evt[2] = (uint8_t)(sizeof(uint16_t) + Size);
+  evt[3] = (uint8_t)Ecode;
+  evt[4] = (uint8_t)(Ecode >> 8);
+  if(Size != 0U)
+  {
+    memcpy(&evt[5], p_Data, MIN(Size, sizeof(evt) - 5U));
+  }
+
+  return CocHandler(evt);
+}
+
+static void COC_HOST_InjectConnect( uint16_t ConnectionHandle, uint16_t Spsm, uint16_t Mtu, uint16_t Mps,
+                                    uint16_t Credits )
+{
+  aci_l2cap_coc_connect_event_rp0 connect;
+
+  connect.Connection_Handle = ConnectionHandle;
+  connect.SPSM = Spsm;
+  connect.MTU = Mtu;
+  connect.MPS = Mps;
+  connect.Initial_Credits = Credits;
+  connect.Channel_Number = 1;
+
+  if(COC_HOST_InjectEvt(ACI_L2CAP_COC_CONNECT_VSEVT_CODE, &connect, sizeof(connect)) !=
+     ((Spsm == BLE_CFG_COC_SPSM) ? SVCCTL_EvtAckFlowEnable : SVCCTL_EvtNotAck))
+  {
+    COC_HOST_Error("wrong acknowledgment of the connection request on SPSM", Spsm);
+  }
+
+  return;
+}
+
+static void COC_HOST_InjectConnectConfirm( uint16_t ConnectionHandle, uint16_t Result, uint8_t ChannelIndex,
+                                           uint16_t Mtu, uint16_t Mps, uint16_t Credits )
+{
+  aci_l2cap_coc_connect_confirm_event_rp0 confirm;
+
+  confirm.Connection_Handle = ConnectionHandle;
+  confirm.MTU = Mtu;
+  confirm.MPS = Mps;
+  confirm.Initial_Credits = Credits;
+  confirm.Result = Result;
+  confirm.Channel_Number = (Result == 0x0000U) ? 1U : 0U;
+  confirm.Channel_Index_List[0] = ChannelIndex;
+
+  COC_HOST_InjectEvt(ACI_L2CAP_COC_CONNECT_CONFIRM_VSEVT_CODE, &confirm, 11U + confirm.Channel_Number);
+
+  return;
+}
+
+static void COC_HOST_InjectDisconnect( uint8_t ChannelIndex )
+{
+  aci_l2cap_coc_disconnect_event_rp0 disconnect;
+
+  disconnect.Channel_Index = ChannelIndex;
+  COC_HOST_InjectEvt(ACI_L2CAP_COC_DISCONNECT_VSEVT_CODE, &disconnect, sizeof(disconnect));
+
+  return;
+}
+
+/**
+ * @brief Opening of the channels: a request of the application on link 1, a request of the peer on link 2, then
+ *        the requests refused as the channel entries are all in use
+ */
+static void COC_HOST_TestConnect( void )
+{
+  COC_HOST_Channel_t *p_channel;
+
+  p_channel = &Channel[0];
+  if(COC_STM_Connect(p_channel->ConnectionHandle) != BLE_STATUS_SUCCESS)
+  {
+    COC_HOST_Error("connection refused on link", p_channel->ConnectionHandle);
+  }
+  if(COC_STM_Connect(p_channel->ConnectionHandle) != BLE_STATUS_BUSY)
+  {
+    COC_HOST_Error("second request accepted on link", p_channel->ConnectionHandle);
+  }
+  COC_HOST_InjectConnectConfirm(p_channel->ConnectionHandle, 0x0000, p_channel->ChannelIndex, p_channel->PeerMtu,
+                                p_channel->PeerMps, p_channel->PeerInitialCredits);
+  if(p_channel->Open == FALSE)
+  {
+    COC_HOST_Error("channel not connected on link", p_channel->ConnectionHandle);
+  }
+
+  p_channel = &Channel[1];
+  COC_HOST_InjectConnect(p_channel->ConnectionHandle, BLE_CFG_COC_SPSM + 1, p_channel->PeerMtu, p_channel->PeerMps,
+                         p_channel->PeerInitialCredits);
+  if(ConnectConfirmNbr != 0U)
+  {
+    COC_HOST_Error("request on another SPSM answered on link", p_channel->ConnectionHandle);
+  }
+  COC_HOST_InjectConnect(p_channel->ConnectionHandle, BLE_CFG_COC_SPSM, p_channel->PeerMtu, p_channel->PeerMps,
+                         p_channel->PeerInitialCredits);
+  if((ConnectConfirmNbr != 1U) || (ConnectConfirmResult != 0x0000U) ||
+     (ConnectConfirmCredits != BLE_CFG_COC_RX_CREDITS) || (p_channel->Open == FALSE))
+  {
+    COC_HOST_Error("request of the peer not accepted on link", p_channel->ConnectionHandle);
+  }
+
+  /* No channel entry left */
+  COC_HOST_InjectConnect(COC_HOST_REQ_HANDLE, BLE_CFG_COC_SPSM, 100, 100, 1);
+  if((ConnectConfirmNbr != 2U) || (ConnectConfirmResult != 0x0004U) || (ConnectConfirmCredits != 0U))
+  {
+    COC_HOST_Error("request not refused with no resources on link", COC_HOST_REQ_HANDLE);
+  }
+  if(COC_STM_Connect(COC_HOST_REQ_HANDLE) != BLE_STATUS_INSUFFICIENT_RESOURCES)
+  {
+    COC_HOST_Error("connection requested with no entry left on link", COC_HOST_REQ_HANDLE);
+  }
+
+  return;
+}
+
+/**
+ * @brief Termination of the channels, with a buffer being sent on the first one, then connection requests refused
+ *        by the peer
+ */
+static void COC_HOST_TestDisconnect( void )
+{
+  static const uint16_t result[] = { 0x0002, 0x0004, 0x000A };
+  COC_STM_Stats_t stats;
+  COC_HOST_Channel_t *p_channel;
+  uint32_t tx_cplt_nbr;
+  uint32_t index;
+
+  p_channel = &Channel[0];
+  p_channel->TxGivenNbr = 0;
+  COC_HOST_AppTx(p_channel);
+  tx_cplt_nbr = TxCpltNbr;
+  if(COC_STM_Close(p_channel->ChannelIndex) != BLE_STATUS_SUCCESS)
+  {
+    COC_HOST_Error("close refused on channel", p_channel->ChannelIndex);
+  }
+  if(DisconnectIndex != p_channel->ChannelIndex)
+  {
+    COC_HOST_Error("disconnection not requested on channel", p_channel->ChannelIndex);
+  }
+  COC_HOST_InjectDisconnect(p_channel->ChannelIndex);
+  if((TxCpltNbr != (tx_cplt_nbr + 1U)) || (TxCpltStatus != BLE_STATUS_FAILED) || (DisconnectedNbr != 1U) ||
+     (p_channel->Open != FALSE))
+  {
+    COC_HOST_Error("buffer not released or disconnection not reported on channel", p_channel->ChannelIndex);
+  }
+
+  p_channel = &Channel[1];
+  COC_STM_Disconnect(p_channel->ConnectionHandle);
+  if((DisconnectedNbr != 2U) || (p_channel->Open != FALSE) ||
+     (COC_STM_GetStats(p_channel->ChannelIndex, &stats) != BLE_STATUS_INVALID_PARAMS))
+  {
+    COC_HOST_Error("channel not released on link", p_channel->ConnectionHandle);
+  }
+
+  for(index = 0; index < (sizeof(result) / sizeof(result[0])); index++)
+  {
+    if(COC_STM_Connect(COC_HOST_REQ_HANDLE) != BLE_STATUS_SUCCESS)
+    {
+      COC_HOST_Error("connection refused on link", COC_HOST_REQ_HANDLE);
+    }
+    COC_HOST_InjectConnectConfirm(COC_HOST_REQ_HANDLE, result[index], 0, 0, 0, 0);
+    if((ConnectFailedNbr != (index + 1U)) || (ConnectFailedStatus != BLE_STATUS_FAILED) ||
+       (ConnectFailedResult != result[index]))
+    {
+      COC_HOST_Error("L2CAP result not reported", result[index]);
+    }
+  }
+
+  return;
+}
+
+static COC_HOST_Channel_t * COC_HOST_GetChannel( uint8_t ChannelIndex )
+{
+  uint32_t index;
+
+  for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+  {
+    if(Channel[index].ChannelIndex == ChannelIndex)
+    {
+      return &Channel[index];
+    }
+  }
+
+  return NULL;
+}
+
+static COC_HOST_Channel_t * COC_HOST_GetLink( uint16_t ConnectionHandle )
+{
+  uint32_t index;
+
+  for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+  {
+    if(Channel[index].ConnectionHandle == ConnectionHandle)
+    {
+      return &Channel[index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Byte at a position of the stream of a channel, Direction 0 from the application, 1 from the peer
+ */
+static uint8_t COC_HOST_Byte( const COC_HOST_Channel_t *p_Channel, uint32_t Position, uint8_t Direction )
+{
+  return (uint8_t)(((Position * 2654435761U) >> 24) ^ p_Channel->ChannelIndex ^ (Direction * 0x5AU));
+}
+
+static uint8_t COC_HOST_Done( void )
+{
+  uint32_t index;
+
+  for(index = 0; index < COC_HOST_CHANNEL_NBR; index++)
+  {
+    if((Channel[index].PeerRxNbr != ByteNbr) || (Channel[index].AppRxNbr != ByteNbr) ||
+       (Channel[index].TxBufLength != 0U))
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static void COC_HOST_Error( const char *p_Msg, uint32_t Value )
+{
+  if(ErrorNbr < COC_HOST_MAX_ERRORS)
+  {
+    printf("error: %s %u\n", p_Msg, Value);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static void COC_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s [-n bytes] [-b buffer] [-p pool] [-t tx] [-u mtu] [-m mps] [-c csv]\n", p_Name);
+  exit(2);
+}
@@ -0,0 +1,344 @@
+/**
+ ******************************************************************************
+ * @file    hci_cmd_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host benchmark of the blocking and of the non-blocking ACI
+ *          commands
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The CFG_TASK_APP_ID task of the sequencer sends <commands> notifications of
+ * <size> bytes to the CPU2 simulated by hw_ipcc_host.c:
+ *
+ *   -m block    aci_gatt_update_char_value(), one command per run of the task,
+ *               the task waits for each response in hci_cmd_resp_wait()
+ *   -m async    aci_gatt_update_char_value_async() until the command queue of
+ *               hci_tl.c is full (HCI_TL_ASYNC_CMD_BUFFER_SIZE). The task is
+ *               requested again by the callback of the next response, the
+ *               responses are reported from hci_user_evt_proc()
+ *   -m mixed    as async, with one command out of 16 sent with the blocking
+ *               aci_gatt_update_char_value() once the previous commands are
+ *               completed. While it waits for its response, the sequencer runs
+ *               the CFG_TASK_OTHER_ID task, which sends an
+ *               aci_gatt_update_char_value_async() command: it shall only be
+ *               queued, and sent once the blocking command is completed.
+ *
+ * Each response is checked (opcode, status, order). The commands per second
+ * are measured from the first command to the last response. The time spent in
+ * the aci_gatt_update_char_value*() calls, during which the task is blocked,
+ * and the CPU time of the thread playing the CPU1 are reported per command.
+ *
+ * Usage: hci_cmd_host -m <block|async|mixed> [-n commands] [-s size] [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <unistd.h>
+
+#include "app_conf.h"
+#include "ble_common.h"
+#include "ble_const.h"
+#include "ble_gatt_aci.h"
+#include "stm32_seq.h"
+#include "hw_ipcc_host.h"
+#include "hci_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define HCI_CMD_HOST_MAX_SIZE           (BLE_CMD_MAX_PARAM_LEN - 6U)
+#define HCI_CMD_HOST_SERVICE_HANDLE     (0x000CU)
+#define HCI_CMD_HOST_CHAR_HANDLE        (0x000EU)
+#define HCI_CMD_HOST_OPCODE             (0xFD06U)
+#define HCI_CMD_HOST_MAX_ERRORS         (10U)
+#define HCI_CMD_HOST_MIXED_PERIOD       (16U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  HCI_CMD_HOST_MODE_BLOCK,
+  HCI_CMD_HOST_MODE_ASYNC,
+  HCI_CMD_HOST_MODE_MIXED,
+} HCI_CMD_HOST_Mode_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *ModeName[] = { "block", "async", "mixed" };
+
+static HCI_CMD_HOST_Mode_t Mode = HCI_CMD_HOST_MODE_BLOCK;
+static uint32_t CmdNbr = 200000U;
+static uint32_t ValueSize = 20U;
+static const char *CsvFile;
+
+static uint8_t Value[HCI_CMD_HOST_MAX_SIZE];
+static uint32_t SentNbr;
+static uint32_t DoneNbr;
+static uint32_t QueueFullNbr;
+static uint64_t CallTime;
+static uint8_t AppWaiting;
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HCI_CMD_HOST_AppTask( void );
+static void HCI_CMD_HOST_OtherTask( void );
+static void HCI_CMD_HOST_CmdCb( uint16_t opcode, const uint8_t* rparam, uint8_t rlen );
+static void HCI_CMD_HOST_UserEvtRx( void *pPayload );
+static void HCI_CMD_HOST_Error( const char *p_Msg, uint32_t Seq );
+static void HCI_CMD_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  HW_IPCC_HOST_Stats_t stats;
+  uint64_t start_time;
+  uint64_t start_cpu_time;
+  double elapsed_ns;
+  double cmd_rate;
+  double cpu_ns;
+  double call_ns;
+  FILE *p_csv;
+  int opt;
+  uint32_t mode;
+
+  while((opt = getopt(argc, argv, "m:n:s:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'm':
+        for(mode = 0; mode < (sizeof(ModeName) / sizeof(ModeName[0])); mode++)
+        {
+          if(strcmp(optarg, ModeName[mode]) == 0)
+          {
+            break;
+          }
+        }
+        if(mode == (sizeof(ModeName) / sizeof(ModeName[0])))
+        {
+          HCI_CMD_HOST_Usage(argv[0]);
+        }
+        Mode = (HCI_CMD_HOST_Mode_t)mode;
+        break;
+
+      case 'n':
+        CmdNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 's':
+        ValueSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        HCI_CMD_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  if((CmdNbr == 0U) || (ValueSize > HCI_CMD_HOST_MAX_SIZE))
+  {
+    HCI_CMD_HOST_Usage(argv[0]);
+  }
+
+  HCI_HOST_Init(HCI_CMD_HOST_UserEvtRx);
+  UTIL_SEQ_RegTask(1<<CFG_TASK_APP_ID, UTIL_SEQ_RFU, HCI_CMD_HOST_AppTask);
+  UTIL_SEQ_RegTask(1<<CFG_TASK_OTHER_ID, UTIL_SEQ_RFU, HCI_CMD_HOST_OtherTask);
+  HW_IPCC_HOST_ResetStats();
+
+  start_time = HCI_HOST_NowNs(CLOCK_MONOTONIC);
+  start_cpu_time = HCI_HOST_NowNs(CLOCK_THREAD_CPUTIME_ID);
+  UTIL_SEQ_SetTask(1<<CFG_TASK_APP_ID, CFG_SCH_PRIO_0);
+  HCI_HOST_Run();
+  elapsed_ns = (double)(HCI_HOST_NowNs(CLOCK_MONOTONIC) - start_time);
+  cpu_ns = (double)(HCI_HOST_NowNs(CLOCK_THREAD_CPUTIME_ID) - start_cpu_time) / (double)CmdNbr;
+  cmd_rate = (double)CmdNbr * 1e9 / elapsed_ns;
+  call_ns = (double)CallTime / (double)CmdNbr;
+
+  HCI_HOST_DeInit();
+  HW_IPCC_HOST_GetStats(&stats);
+  if(stats.BleCmdNbr != CmdNbr)
+  {
+    HCI_CMD_HOST_Error("commands lost", stats.BleCmdNbr);
+  }
+
+  printf("%-5s size %3u: %u commands, %.0f commands/s, %.0f ns/command in the calls, %.0f ns/command cpu1, "
+         "queue full %u, %u errors\n",
+         ModeName[Mode], ValueSize, CmdNbr, cmd_rate, call_ns, cpu_ns, QueueFullNbr, ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "mode,size,commands,commands_per_s,call_ns,cpu1_ns,queue_full,errors\n");
+      }
+      fprintf(p_csv, "%s,%u,%u,%.0f,%.0f,%.0f,%u,%u\n", ModeName[Mode], ValueSize, CmdNbr, cmd_rate, call_ns, cpu_ns,
+              QueueFullNbr, ErrorNbr);
+      fclose(p_csv);
+    }
+  }
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+static void HCI_CMD_HOST_AppTask( void )
+{
+  tBleStatus status;
+  uint64_t call_time;
+  uint32_t seq;
+
+  if(Mode == HCI_CMD_HOST_MODE_BLOCK)
+  {
+    Value[0] = (uint8_t)SentNbr;
+    call_time = HCI_HOST_NowNs(CLOCK_MONOTONIC);
+    status = aci_gatt_update_char_value(HCI_CMD_HOST_SERVICE_HANDLE, HCI_CMD_HOST_CHAR_HANDLE, 0, (uint8_t)ValueSize,
+                                        Value);
+    CallTime += HCI_HOST_NowNs(CLOCK_MONOTONIC) - call_time;
+    if(status != BLE_STATUS_SUCCESS)
+    {
+      HCI_CMD_HOST_Error("command failed", SentNbr);
+    }
+    SentNbr++;
+    DoneNbr++;
+
+    if(SentNbr < CmdNbr)
+    {
+      UTIL_SEQ_SetTask(1<<CFG_TASK_APP_ID, CFG_SCH_PRIO_0);
+    }
+    else
+    {
+      HCI_HOST_Stop();
+    }
+  }
+  else
+  {
+    while(SentNbr < CmdNbr)
+    {
+      if((Mode == HCI_CMD_HOST_MODE_MIXED) && ((SentNbr % HCI_CMD_HOST_MIXED_PERIOD) == (HCI_CMD_HOST_MIXED_PERIOD - 1U)))
+      {
+        if(DoneNbr != SentNbr)
+        {
+          /* The task is requested again by the next response */
+          AppWaiting = TRUE;
+          break;
+        }
+        seq = SentNbr;
+        Value[0] = (uint8_t)seq;
+        SentNbr++;
+        UTIL_SEQ_SetTask(1<<CFG_TASK_OTHER_ID, CFG_SCH_PRIO_0);
+        call_time = HCI_HOST_NowNs(CLOCK_MONOTONIC);
+        status = aci_gatt_update_char_value(HCI_CMD_HOST_SERVICE_HANDLE, HCI_CMD_HOST_CHAR_HANDLE, 0,
+                                            (uint8_t)ValueSize, Value);
+        CallTime += HCI_HOST_NowNs(CLOCK_MONOTONIC) - call_time;
+        if((status != BLE_STATUS_SUCCESS) || (DoneNbr != seq))
+        {
+          HCI_CMD_HOST_Error("wrong blocking command response", seq);
+        }
+        DoneNbr++;
+        if(DoneNbr == CmdNbr)
+        {
+          HCI_HOST_Stop();
+        }
+        continue;
+      }
+
+      Value[0] = (uint8_t)SentNbr;
+      call_time = HCI_HOST_NowNs(CLOCK_MONOTONIC);
+      status = aci_gatt_update_char_value_async(HCI_CMD_HOST_SERVICE_HANDLE, HCI_CMD_HOST_CHAR_HANDLE, 0,
+                                                (uint8_t)ValueSize, Value, HCI_CMD_HOST_CmdCb);
+      CallTime += HCI_HOST_NowNs(CLOCK_MONOTONIC) - call_time;
+      if(status != BLE_STATUS_SUCCESS)
+      {
+        /* The command queue is full, the task is requested again by the next response */
+        QueueFullNbr++;
+        AppWaiting = TRUE;
+        break;
+      }
+      SentNbr++;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief Send an asynchronous command while a blocking command waits for its response
+ */
+static void HCI_CMD_HOST_OtherTask( void )
+{
+  if(SentNbr < CmdNbr)
+  {
+    Value[0] = (uint8_t)SentNbr;
+    if(aci_gatt_update_char_value_async(HCI_CMD_HOST_SERVICE_HANDLE, HCI_CMD_HOST_CHAR_HANDLE, 0, (uint8_t)ValueSize,
+                                        Value, HCI_CMD_HOST_CmdCb) == BLE_STATUS_SUCCESS)
+    {
+      SentNbr++;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief Response of a command sent with aci_gatt_update_char_value_async(), the responses come in order
+ */
+static void HCI_CMD_HOST_CmdCb( uint16_t opcode, const uint8_t* rparam, uint8_t rlen )
+{
+  if((opcode != HCI_CMD_HOST_OPCODE) || (rlen < 1U) || (rparam[0] != BLE_STATUS_SUCCESS) || (DoneNbr >= SentNbr))
+  {
+    HCI_CMD_HOST_Error("wrong response", DoneNbr);
+  }
+  DoneNbr++;
+
+  if(AppWaiting != FALSE)
+  {
+    AppWaiting = FALSE;
+    UTIL_SEQ_SetTask(1<<CFG_TASK_APP_ID, CFG_SCH_PRIO_0);
+  }
+
+  if(DoneNbr == CmdNbr)
+  {
+    HCI_HOST_Stop();
+  }
+
+  return;
+}
+
+static void HCI_CMD_HOST_UserEvtRx( void *pPayload )
+{
+  (void)pPayload;
+
+  HCI_CMD_HOST_Error("unexpected event", DoneNbr);
+
+  return;
+}
+
+static void HCI_CMD_HOST_Error( const char *p_Msg, uint32_t Seq )
+{
+  if(ErrorNbr < HCI_CMD_HOST_MAX_ERRORS)
+  {
+    printf("error: command %u: %s\n", Seq, p_Msg);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static void HCI_CMD_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s -m <block|async|mixed> [-n commands] [-s size (up to %u)] [-c csv]\n",
+          p_Name, HCI_CMD_HOST_MAX_SIZE);
+  exit(2);
+}
@@ -0,0 +1,302 @@
+/**
+ ******************************************************************************
+ * @file    hci_evt_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host benchmark of the time budget of hci_user_evt_proc_budget()
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The CPU2 simulated by hw_ipcc_host.c sends <events> vendor specific events
+ * of <size> bytes. The CFG_TASK_HCI_ASYNCH_EVT_ID task of the sequencer reports
+ * them with hci_user_evt_proc_budget(<evt budget>, <time budget>), the
+ * callback of each event spends <work> ns on it.
+ *
+ * Each event also requests the CFG_TASK_OTHER_ID task, which stands for the
+ * other tasks of the application. Its latency is the time from the request to
+ * its run, that is the remainder of the call of hci_user_evt_proc_budget()
+ * then of the tasks run before it by the round robin of the sequencer.
+ *
+ * The events per second, the release buffer transactions and the median, 99th
+ * percentile and maximum latency of the other task are reported. A budget of 1
+ * event is hci_user_evt_proc(), a budget of 0 event and 0 us is no limit.
+ *
+ * The simulated CPU2 allocates the largest event buffer for each event, so the
+ * event pool sized with <queue length> holds <queue length> - 1 events: no call
+ * may report more events than that, whatever the budget.
+ *
+ * Usage: hci_evt_host [-n events] [-s size] [-q queue length] [-e evt budget] [-t time budget us] [-w work ns]
+ *                     [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <unistd.h>
+
+#include "app_conf.h"
+#include "stm32_wpan_common.h"
+#include "tl.h"
+#include "hci_tl.h"
+#include "stm32_seq.h"
+#include "hw_ipcc_host.h"
+#include "hci_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define HCI_EVT_HOST_MIN_SIZE           (4U)
+#define HCI_EVT_HOST_MAX_SIZE           (253U)
+#define HCI_EVT_HOST_SUBEVTCODE         (0x0C3FU)
+#define HCI_EVT_HOST_MAX_ERRORS         (10U)
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t EvtNbr = 200000U;
+static uint32_t EvtSize = 16U;
+static uint32_t QueueLength = CFG_TLBLE_EVT_QUEUE_LENGTH;
+static uint32_t EvtBudget = 1U;
+static uint32_t TimeBudget;
+static uint32_t WorkNs = 500U;
+static const char *CsvFile;
+
+static uint32_t DoneNbr;
+static uint32_t CallNbr;
+static uint8_t OtherPending;
+static uint64_t OtherRequestTime;
+static uint64_t *p_Latency;
+static uint32_t LatencyNbr;
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HCI_EVT_HOST_EvtTask( void );
+static void HCI_EVT_HOST_OtherTask( void );
+static void HCI_EVT_HOST_UserEvtRx( void *pPayload );
+static void HCI_EVT_HOST_Work( uint64_t Ns );
+static int HCI_EVT_HOST_Compare( const void *p_A, const void *p_B );
+static void HCI_EVT_HOST_Error( const char *p_Msg, uint32_t Seq );
+static void HCI_EVT_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  HW_IPCC_HOST_Stats_t stats;
+  uint64_t start_time;
+  double elapsed_ns;
+  double evt_rate;
+  double p50_us;
+  double p99_us;
+  double max_us;
+  FILE *p_csv;
+  int opt;
+
+  while((opt = getopt(argc, argv, "n:s:q:e:t:w:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'n':
+        EvtNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 's':
+        EvtSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'q':
+        QueueLength = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'e':
+        EvtBudget = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 't':
+        TimeBudget = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'w':
+        WorkNs = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        HCI_EVT_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  if((EvtNbr == 0U) || (EvtSize < HCI_EVT_HOST_MIN_SIZE) || (EvtSize > HCI_EVT_HOST_MAX_SIZE) ||
+     (QueueLength < 2U))
+  {
+    HCI_EVT_HOST_Usage(argv[0]);
+  }
+
+  p_Latency = malloc(EvtNbr * sizeof(uint64_t));
+  if(p_Latency == NULL)
+  {
+    fprintf(stderr, "out of memory\n");
+    return 2;
+  }
+
+  HCI_HOST_SetEvtQueueLength(QueueLength);
+  HCI_HOST_Init(HCI_EVT_HOST_UserEvtRx);
+  /* The task registered by HCI_HOST_Init() is replaced by the budgeted one */
+  UTIL_SEQ_RegTask(1<<CFG_TASK_HCI_ASYNCH_EVT_ID, UTIL_SEQ_RFU, HCI_EVT_HOST_EvtTask);
+  UTIL_SEQ_RegTask(1<<CFG_TASK_OTHER_ID, UTIL_SEQ_RFU, HCI_EVT_HOST_OtherTask);
+  HW_IPCC_HOST_ResetStats();
+
+  start_time = HCI_HOST_NowNs(CLOCK_MONOTONIC);
+  HW_IPCC_HOST_SendBleAsynchEvt(EvtNbr, HCI_EVT_HOST_SUBEVTCODE, (uint8_t)EvtSize);
+  HCI_HOST_Run();
+  elapsed_ns = (double)(HCI_HOST_NowNs(CLOCK_MONOTONIC) - start_time);
+  evt_rate = (double)EvtNbr * 1e9 / elapsed_ns;
+
+  HCI_HOST_DeInit();
+  HW_IPCC_HOST_GetStats(&stats);
+  if(stats.AsynchEvtNbr != EvtNbr)
+  {
+    HCI_EVT_HOST_Error("events lost", stats.AsynchEvtNbr);
+  }
+
+  p50_us = 0;
+  p99_us = 0;
+  max_us = 0;
+  if(LatencyNbr != 0U)
+  {
+    qsort(p_Latency, LatencyNbr, sizeof(uint64_t), HCI_EVT_HOST_Compare);
+    p50_us = (double)p_Latency[LatencyNbr / 2U] / 1000.0;
+    p99_us = (double)p_Latency[((uint64_t)LatencyNbr * 99U) / 100U] / 1000.0;
+    max_us = (double)p_Latency[LatencyNbr - 1U] / 1000.0;
+  }
+
+  printf("queue %2u budget %3u evt %4u us, work %4u ns: %u events, %.0f events/s, %u calls, "
+         "release buffer transactions %u, other task latency p50 %.1f us p99 %.1f us max %.1f us, %u errors\n",
+         QueueLength, EvtBudget, TimeBudget, WorkNs, EvtNbr, evt_rate, CallNbr, stats.FreeBufIrqNbr, p50_us, p99_us,
+         max_us, ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "queue_length,evt_budget,time_budget_us,work_ns,events,events_per_s,calls,"
+                "free_buf_transactions,latency_p50_us,latency_p99_us,latency_max_us,errors\n");
+      }
+      fprintf(p_csv, "%u,%u,%u,%u,%u,%.0f,%u,%u,%.1f,%.1f,%.1f,%u\n", QueueLength, EvtBudget, TimeBudget, WorkNs,
+              EvtNbr, evt_rate, CallNbr, stats.FreeBufIrqNbr, p50_us, p99_us, max_us, ErrorNbr);
+      fclose(p_csv);
+    }
+  }
+
+  free(p_Latency);
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+static void HCI_EVT_HOST_EvtTask( void )
+{
+  CallNbr++;
+  hci_user_evt_proc_budget(EvtBudget, TimeBudget);
+
+  return;
+}
+
+static void HCI_EVT_HOST_OtherTask( void )
+{
+  p_Latency[LatencyNbr] = HCI_HOST_NowNs(CLOCK_MONOTONIC) - OtherRequestTime;
+  LatencyNbr++;
+  OtherPending = FALSE;
+
+  if(DoneNbr == EvtNbr)
+  {
+    HCI_HOST_Stop();
+  }
+
+  return;
+}
+
+static void HCI_EVT_HOST_UserEvtRx( void *pPayload )
+{
+  tHCI_UserEvtRxParam *p_param;
+  TL_EvtPacket_t *p_evt;
+  TL_AsynchEvt_t *p_asynch_evt;
+  uint32_t evt_seq;
+
+  p_param = (tHCI_UserEvtRxParam *)pPayload;
+  p_evt = p_param->pckt;
+  p_asynch_evt = (TL_AsynchEvt_t*)p_evt->evtserial.evt.payload;
+  memcpy(&evt_seq, p_asynch_evt->payload, sizeof(evt_seq));
+  if((p_evt->evtserial.evt.evtcode != TL_BLEEVT_VS_OPCODE) || (p_asynch_evt->subevtcode != HCI_EVT_HOST_SUBEVTCODE) ||
+     (p_evt->evtserial.evt.plen != (sizeof(uint16_t) + EvtSize)) || (evt_seq != DoneNbr))
+  {
+    HCI_EVT_HOST_Error("wrong event", DoneNbr);
+  }
+
+  HCI_EVT_HOST_Work(WorkNs);
+  DoneNbr++;
+
+  /* The other task is requested once, its latency is measured from the first request */
+  if(OtherPending == FALSE)
+  {
+    OtherPending = TRUE;
+    OtherRequestTime = HCI_HOST_NowNs(CLOCK_MONOTONIC);
+    UTIL_SEQ_SetTask(1<<CFG_TASK_OTHER_ID, CFG_SCH_PRIO_0);
+  }
+
+  return;
+}
+
+/**
+ * @brief Busy loop standing for the processing of an event by the application
+ */
+static void HCI_EVT_HOST_Work( uint64_t Ns )
+{
+  uint64_t start_time;
+
+  if(Ns != 0U)
+  {
+    start_time = HCI_HOST_NowNs(CLOCK_MONOTONIC);
+    while((HCI_HOST_NowNs(CLOCK_MONOTONIC) - start_time) < Ns)
+    {
+    }
+  }
+
+  return;
+}
+
+static int HCI_EVT_HOST_Compare( const void *p_A, const void *p_B )
+{
+  uint64_t a = *(const uint64_t *)p_A;
+  uint64_t b = *(const uint64_t *)p_B;
+
+  return (a > b) - (a < b);
+}
+
+static void HCI_EVT_HOST_Error( const char *p_Msg, uint32_t Seq )
+{
+  if(ErrorNbr < HCI_EVT_HOST_MAX_ERRORS)
+  {
+    printf("error: event %u: %s\n", Seq, p_Msg);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static void HCI_EVT_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s [-n events] [-s size (%u..%u)] [-q queue length (2..64)] [-e evt budget] "
+          "[-t time budget us] [-w work ns] [-c csv]\n", p_Name, HCI_EVT_HOST_MIN_SIZE, HCI_EVT_HOST_MAX_SIZE);
+  exit(2);
+}
@@ -0,0 +1,213 @@
+/**
+ ******************************************************************************
+ * @file    hci_host.c
+ * @author  MCD Application Team
+ * @brief   BLE application glue of the Linux host benchmarks of the HCI
+ *          transport layer
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+
+#include "app_conf.h"
+#include "stm32_wpan_common.h"
+#include "stm_list.h"
+#include "tl.h"
+#include "hci_tl.h"
+#include "stm32_seq.h"
+#include "hw_ipcc_host.h"
+#include "hci_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define HCI_HOST_MAX_EVT_QUEUE_LENGTH   (64U)
+#define HCI_HOST_POOL_SIZE(length)      ((length)*4U*DIVC((sizeof(TL_PacketHeader_t) + TL_BLE_EVENT_FRAME_SIZE), 4U))
+
+/* Private variables ---------------------------------------------------------*/
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static uint8_t EvtPool[HCI_HOST_POOL_SIZE(HCI_HOST_MAX_EVT_QUEUE_LENGTH)];
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static uint8_t SystemSpareEvtBuffer[sizeof(TL_PacketHeader_t) + TL_EVT_HDR_SIZE + 255U];
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static uint8_t BleSpareEvtBuffer[sizeof(TL_PacketHeader_t) + TL_EVT_HDR_SIZE + 255];
+PLACE_IN_SECTION("MB_MEM1") ALIGN(4) static TL_CmdPacket_t BleCmdBuffer;
+
+/**
+ * Wake up of UTIL_SEQ_Idle(), bound to the lock playing the PRIMASK
+ */
+static pthread_cond_t IdleCond = PTHREAD_COND_INITIALIZER;
+static volatile uint8_t Stopped;
+static uint32_t EvtQueueLength = CFG_TLBLE_EVT_QUEUE_LENGTH;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HCI_HOST_StatusNot( HCI_TL_CmdStatus_t Status );
+static void HCI_HOST_Wakeup( void );
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+ * @brief Initialization of the transport layer as in appe_Tl_Init() and Ble_Tl_Init()
+ * @param UserEvtRx: Callback of the HCI events, called from hci_user_evt_proc()
+ */
+void HCI_HOST_Init( void (*UserEvtRx)( void *pData ) )
+{
+  TL_MM_Config_t tl_mm_config;
+  HCI_TL_HciInitConf_t hci_tl_init_conf;
+
+  UTIL_SEQ_Init();
+  Stopped = FALSE;
+
+  TL_Init();
+
+  tl_mm_config.p_BleSpareEvtBuffer = BleSpareEvtBuffer;
+  tl_mm_config.p_SystemSpareEvtBuffer = SystemSpareEvtBuffer;
+  tl_mm_config.p_AsynchEvtPool = EvtPool;
+  tl_mm_config.AsynchEvtPoolSize = HCI_HOST_POOL_SIZE(EvtQueueLength);
+  tl_mm_config.p_TracesEvtPool = NULL;
+  tl_mm_config.TracesEvtPoolSize = 0;
+  TL_MM_Init(&tl_mm_config);
+
+  TL_Enable();
+
+  UTIL_SEQ_RegTask(1<<CFG_TASK_HCI_ASYNCH_EVT_ID, UTIL_SEQ_RFU, hci_user_evt_proc);
+
+  hci_tl_init_conf.p_cmdbuffer = (uint8_t*)&BleCmdBuffer;
+  hci_tl_init_conf.StatusNotCallBack = HCI_HOST_StatusNot;
+  hci_init(UserEvtRx, (void*)&hci_tl_init_conf);
+
+  return;
+}
+
+/**
+ * @brief Size the event pool as CFG_TLBLE_EVT_QUEUE_LENGTH would, to be called before HCI_HOST_Init()
+ * @param Length: Up to HCI_HOST_MAX_EVT_QUEUE_LENGTH, CFG_TLBLE_EVT_QUEUE_LENGTH of app_conf.h by default
+ */
+void HCI_HOST_SetEvtQueueLength( uint32_t Length )
+{
+  EvtQueueLength = MIN(Length, HCI_HOST_MAX_EVT_QUEUE_LENGTH);
+
+  return;
+}
+
+/**
+ * @brief Run the sequencer until HCI_HOST_Stop() is called
+ */
+void HCI_HOST_Run( void )
+{
+  while(Stopped == FALSE)
+  {
+    UTIL_SEQ_Run(UTIL_SEQ_DEFAULT);
+  }
+
+  return;
+}
+
+void HCI_HOST_Stop( void )
+{
+  Stopped = TRUE;
+  HCI_HOST_Wakeup();
+
+  return;
+}
+
+void HCI_HOST_DeInit( void )
+{
+  HW_IPCC_HOST_WaitIdle();
+  HW_IPCC_HOST_Stop();
+
+  return;
+}
+
+uint64_t HCI_HOST_NowNs( clockid_t ClockId )
+{
+  struct timespec now;
+
+  (void)clock_gettime(ClockId, &now);
+
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Called by UTIL_SEQ_Run() with the interrupts masked, as the WFI of the target
+ */
+void UTIL_SEQ_Idle( void )
+{
+  if(Stopped == FALSE)
+  {
+    (void)pthread_cond_wait(&IdleCond, &HW_IPCC_HOST_IrqLock);
+  }
+
+  return;
+}
+
+void hci_notify_asynch_evt(void* p_Data)
+{
+  (void)p_Data;
+
+  UTIL_SEQ_SetTask(1 << CFG_TASK_HCI_ASYNCH_EVT_ID, CFG_SCH_PRIO_0);
+  HCI_HOST_Wakeup();
+
+  return;
+}
+
+void hci_cmd_resp_release(uint32_t Flag)
+{
+  (void)Flag;
+
+  UTIL_SEQ_SetEvt(1 << CFG_IDLEEVT_HCI_CMD_EVT_RSP_ID);
+  HCI_HOST_Wakeup();
+
+  return;
+}
+
+void hci_cmd_resp_wait(uint32_t Timeout)
+{
+  (void)Timeout;
+
+  UTIL_SEQ_WaitEvt(1 << CFG_IDLEEVT_HCI_CMD_EVT_RSP_ID);
+
+  return;
+}
+
+uint32_t hci_get_tick(void)
+{
+  return (uint32_t)(HCI_HOST_NowNs(CLOCK_MONOTONIC) / 1000U);
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief As BLE_StatusNot() of app_ble.c: the tasks sending commands are paused while a command is pending
+ */
+static void HCI_HOST_StatusNot( HCI_TL_CmdStatus_t Status )
+{
+  uint32_t task_id_list;
+
+  task_id_list = (1 << CFG_LAST_TASK_ID_WITH_HCICMD) - 1;
+  if(Status == HCI_TL_CmdBusy)
+  {
+    UTIL_SEQ_PauseTask(task_id_list);
+  }
+  else
+  {
+    UTIL_SEQ_ResumeTask(task_id_list);
+  }
+
+  return;
+}
+
+static void HCI_HOST_Wakeup( void )
+{
+  BACKUP_PRIMASK();
+
+  DISABLE_IRQ();
+  (void)pthread_cond_broadcast(&IdleCond);
+  RESTORE_PRIMASK();
+
+  return;
+}
@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file    hci_host.h
+ * @author  MCD Application Team
+ * @brief   Header for hci_host.c
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * BLE application glue of the Linux host benchmarks of hci_tl.c, written as
+ * app_entry.c and app_ble.c of the BLE applications: the transport layer is
+ * initialized the same way, the HCI events are reported from the
+ * CFG_TASK_HCI_ASYNCH_EVT_ID task of the sequencer and a blocking command waits
+ * in UTIL_SEQ_WaitEvt() for CFG_IDLEEVT_HCI_CMD_EVT_RSP_ID.
+ *
+ * UTIL_SEQ_Idle() blocks until an IPCC interrupt handler requests a task or
+ * sets an event, or until HCI_HOST_Stop() is called.
+ *
+ * hci_get_tick() counts in microseconds, so that the time budget of
+ * hci_user_evt_proc_budget() may be set below one millisecond.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HCI_HOST_H
+#define __HCI_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <time.h>
+
+/* Exported functions ------------------------------------------------------- */
+void HCI_HOST_SetEvtQueueLength( uint32_t Length );
+void HCI_HOST_Init( void (*UserEvtRx)( void *pData ) );
+void HCI_HOST_Run( void );
+void HCI_HOST_Stop( void );
+void HCI_HOST_DeInit( void );
+uint64_t HCI_HOST_NowNs( clockid_t ClockId );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__HCI_HOST_H */
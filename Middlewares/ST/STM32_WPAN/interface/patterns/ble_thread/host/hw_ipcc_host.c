@@ -0,0 +1,826 @@
+/**
+ ******************************************************************************
+ * @file    hw_ipcc_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host simulator of the IPCC and of the CPU2 for the mailbox
+ *          transport layer
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+
+#include "stm32_wpan_common.h"
+#include "hw.h"
+
+#include "stm_list.h"
+#include "tl.h"
+#include "mbox_def.h"
+#include "hw_ipcc_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#ifndef LL_IPCC_CHANNEL_1
+#define LL_IPCC_CHANNEL_1                       (0x00000001U)
+#define LL_IPCC_CHANNEL_2                       (0x00000002U)
+#define LL_IPCC_CHANNEL_3                       (0x00000004U)
+#define LL_IPCC_CHANNEL_4                       (0x00000008U)
+#define LL_IPCC_CHANNEL_5                       (0x00000010U)
+#define LL_IPCC_CHANNEL_6                       (0x00000020U)
+#endif
+
+/**
+ * Size of the buffers the CPU2 carves in the asynchronous event pool
+ */
+#define HW_IPCC_HOST_EVT_BUFFER_SIZE            (DIVC((sizeof(TL_PacketHeader_t) + TL_EVT_HDR_SIZE + 255), 8) * 8)
+
+/**
+ * Length of the command complete event sent by the CPU2: numcmd, cmdcode and status
+ */
+#define HW_IPCC_HOST_CC_PLEN                    (TL_EVT_HDR_SIZE + 1)
+
+/**
+ * Commands sending a notification/indication, with the offset of their Value_Length parameter
+ */
+#define HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_OPCODE      (0xFD06)
+#define HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_LEN_OFFSET  (5)
+#define HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_EXT_OPCODE  (0xFD2C)
+#define HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_EXT_LEN_OFFSET (11)
+#define HW_IPCC_HOST_GATT_TX_POOL_AVAILABLE_EVT_CODE    (0x0C16)
+#define HW_IPCC_HOST_STATUS_INSUFFICIENT_RESOURCES      (0x64)
+
+/* Private macros ------------------------------------------------------------*/
+/* Private typedef -----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/**
+ * Interrupt masking of the CPU1 (see cmsis_compiler.h)
+ */
+pthread_mutex_t HW_IPCC_HOST_IrqLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/**
+ * Reference table of the transport layer, located by the CPU2 as on target
+ */
+extern volatile MB_RefTable_t __start_MAPPING_TABLE;
+
+static pthread_mutex_t Cpu2Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Cpu2Cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t IdleCond = PTHREAD_COND_INITIALIZER;
+static pthread_t Cpu2Thread;
+static uint8_t Cpu2Running;
+static uint8_t Cpu2Stop;
+static uint8_t Cpu2Busy;
+
+/**
+ * Channel flags set by the CPU1 and transmit free interrupts enabled by the CPU1
+ */
+static uint32_t ChannelFlags;
+static uint32_t TxEnabled;
+
+/**
+ * Asynchronous events still to be sent by the CPU2
+ */
+static uint32_t BurstEvtNbr;
+static uint16_t BurstSubEvtCode;
+static uint8_t BurstPayloadSize;
+
+/**
+ * Free event buffers of the CPU2 - only accessed by the CPU2 thread
+ */
+static TL_EvtPacket_t *p_Cpu2FreeEvt;
+static uint8_t Cpu2PoolInitialized;
+static uint32_t Cpu2EvtSeqNbr;
+
+/**
+ * GATT TX pool of the CPU2, only modeled when GattTxPoolSize is not 0
+ */
+static uint16_t GattTxPoolSize;
+static uint16_t GattTxPoolUsed;
+static uint8_t GattTxPoolFull;
+static uint8_t GattTxPoolAvailEvtPending;
+static uint16_t GattTxPoolConnHandle;
+
+static HW_IPCC_HOST_Stats_t HostStats;
+
+static void (*FreeBufCb)( void );
+
+/* Private function prototypes -----------------------------------------------*/
+static void *HW_IPCC_HOST_Cpu2( void *arg );
+static void HW_IPCC_HOST_SetFlag( uint32_t channel, uint8_t enable_tx );
+static uint8_t HW_IPCC_HOST_IsActiveFlag( uint32_t channel );
+static void HW_IPCC_HOST_DisableTx( uint32_t channel );
+static void HW_IPCC_HOST_Cpu2InitPool( void );
+static uint32_t HW_IPCC_HOST_Cpu2SendAsynchEvt( uint32_t evt_nbr );
+static uint8_t HW_IPCC_HOST_Cpu2SendTxPoolAvailableEvt( void );
+static uint8_t HW_IPCC_HOST_Cpu2GattTx( TL_CmdPacket_t *p_cmd );
+static void HW_IPCC_HOST_Cpu2ProcessRequests( uint32_t flags );
+static void HW_IPCC_HOST_Cpu2RaiseTxIrq( uint32_t channels );
+
+static void HW_IPCC_BLE_EvtHandler( void );
+static void HW_IPCC_BLE_AclDataEvtHandler( void );
+static void HW_IPCC_SYS_CmdEvtHandler( void );
+static void HW_IPCC_MM_FreeBufHandler( void );
+
+/* Public functions ----------------------------------------------------------*/
+
+/******************************************************************************
+ * GENERAL
+ ******************************************************************************/
+void HW_IPCC_Enable( void )
+{
+  /**
+   * Boot the CPU2
+   */
+  if( Cpu2Running == 0 )
+  {
+    Cpu2Stop = 0;
+    Cpu2Running = 1;
+    (void)pthread_create( &Cpu2Thread, NULL, HW_IPCC_HOST_Cpu2, NULL );
+  }
+
+  return;
+}
+
+void HW_IPCC_Init( void )
+{
+  return;
+}
+
+void HW_IPCC_HOST_Stop( void )
+{
+  if( Cpu2Running != 0 )
+  {
+    (void)pthread_mutex_lock( &Cpu2Lock );
+    Cpu2Stop = 1;
+    (void)pthread_cond_signal( &Cpu2Cond );
+    (void)pthread_mutex_unlock( &Cpu2Lock );
+
+    (void)pthread_join( Cpu2Thread, NULL );
+    Cpu2Running = 0;
+  }
+
+  return;
+}
+
+/**
+ * @brief  Request the CPU2 to send BLE asynchronous events
+ * @note   The events are vendor specific events allocated from the asynchronous event pool. When the pool is
+ *         exhausted, the CPU2 waits for the CPU1 to release buffers with TL_MM_EvtDone().
+ *         The first 4 bytes of the payload (when PayloadSize allows) hold a sequence number.
+ * @param  EvtNbr: Number of events to send
+ * @param  SubEvtCode: Sub event code of the events
+ * @param  PayloadSize: Size of the payload of the events after the sub event code
+ * @retval None
+ */
+void HW_IPCC_HOST_SendBleAsynchEvt( uint32_t EvtNbr, uint16_t SubEvtCode, uint8_t PayloadSize )
+{
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  BurstEvtNbr += EvtNbr;
+  BurstSubEvtCode = SubEvtCode;
+  BurstPayloadSize = MIN(PayloadSize, 255 - sizeof(uint16_t));
+  (void)pthread_cond_signal( &Cpu2Cond );
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return;
+}
+
+/**
+ * @brief  Set the number of notifications/indications the CPU2 may hold before they are transmitted
+ * @note   Once the pool is full, aci_gatt_update_char_value() and aci_gatt_update_char_value_ext() are answered
+ *         with BLE_STATUS_INSUFFICIENT_RESOURCES until HW_IPCC_HOST_TransmitGattTx() frees buffers, the CPU2 then
+ *         sends ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE.
+ * @param  BufNbr: Size of the pool - 0 to accept all the notifications (default)
+ * @retval None
+ */
+void HW_IPCC_HOST_SetGattTxPool( uint16_t BufNbr )
+{
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  GattTxPoolSize = BufNbr;
+  GattTxPoolUsed = 0;
+  GattTxPoolFull = FALSE;
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return;
+}
+
+/**
+ * @brief  Transmit over the air notifications/indications held in the GATT TX pool of the CPU2
+ * @param  BufNbr: Maximum number of notifications/indications to transmit
+ * @retval Number of notifications/indications transmitted
+ */
+uint16_t HW_IPCC_HOST_TransmitGattTx( uint16_t BufNbr )
+{
+  uint16_t tx_nbr;
+
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  tx_nbr = MIN(BufNbr, GattTxPoolUsed);
+  GattTxPoolUsed -= tx_nbr;
+  if( ( tx_nbr != 0 ) && ( GattTxPoolFull != FALSE ) )
+  {
+    GattTxPoolFull = FALSE;
+    GattTxPoolAvailEvtPending = TRUE;
+    (void)pthread_cond_signal( &Cpu2Cond );
+  }
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return tx_nbr;
+}
+
+/**
+ * @brief  Wait for the CPU2 to have processed all the requests of the CPU1 and sent all the events requested
+ * @note   This shall not be called from the thread processing the events when the asynchronous event pool
+ *         may be exhausted.
+ * @retval None
+ */
+void HW_IPCC_HOST_WaitIdle( void )
+{
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  while( ( Cpu2Busy != 0 ) || ( ChannelFlags != 0 ) || ( ( TxEnabled & ~ChannelFlags ) != 0 ) || ( BurstEvtNbr != 0 ) ||
+         ( GattTxPoolAvailEvtPending != FALSE ) )
+  {
+    (void)pthread_cond_wait( &IdleCond, &Cpu2Lock );
+  }
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return;
+}
+
+void HW_IPCC_HOST_GetStats( HW_IPCC_HOST_Stats_t *p_Stats )
+{
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  *p_Stats = HostStats;
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return;
+}
+
+void HW_IPCC_HOST_ResetStats( void )
+{
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  memset( &HostStats, 0, sizeof(HostStats) );
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return;
+}
+
+/******************************************************************************
+ * BLE
+ ******************************************************************************/
+void HW_IPCC_BLE_Init( void )
+{
+  return;
+}
+
+void HW_IPCC_BLE_SendCmd( void )
+{
+  HW_IPCC_HOST_SetFlag( HW_IPCC_BLE_CMD_CHANNEL, FALSE );
+
+  return;
+}
+
+static void HW_IPCC_BLE_EvtHandler( void )
+{
+  HW_IPCC_BLE_RxEvtNot();
+
+  return;
+}
+
+void HW_IPCC_BLE_SendAclData( void )
+{
+  HW_IPCC_HOST_SetFlag( HW_IPCC_HCI_ACL_DATA_CHANNEL, TRUE );
+
+  return;
+}
+
+static void HW_IPCC_BLE_AclDataEvtHandler( void )
+{
+  HW_IPCC_HOST_DisableTx( HW_IPCC_HCI_ACL_DATA_CHANNEL );
+
+  HW_IPCC_BLE_AclDataAckNot();
+
+  return;
+}
+
+__WEAK void HW_IPCC_BLE_AclDataAckNot( void ){};
+__WEAK void HW_IPCC_BLE_RxEvtNot( void ){};
+
+/******************************************************************************
+ * SYSTEM
+ ******************************************************************************/
+void HW_IPCC_SYS_Init( void )
+{
+  return;
+}
+
+void HW_IPCC_SYS_SendCmd( void )
+{
+  HW_IPCC_HOST_SetFlag( HW_IPCC_SYSTEM_CMD_RSP_CHANNEL, TRUE );
+
+  return;
+}
+
+static void HW_IPCC_SYS_CmdEvtHandler( void )
+{
+  HW_IPCC_HOST_DisableTx( HW_IPCC_SYSTEM_CMD_RSP_CHANNEL );
+
+  HW_IPCC_SYS_CmdEvtNot();
+
+  return;
+}
+
+__WEAK void HW_IPCC_SYS_CmdEvtNot( void ){};
+__WEAK void HW_IPCC_SYS_EvtNot( void ){};
+
+/******************************************************************************
+ * MEMORY MANAGER
+ ******************************************************************************/
+void HW_IPCC_MM_SendFreeBuf( void (*cb)( void ) )
+{
+  BACKUP_PRIMASK();
+
+  DISABLE_IRQ();
+
+  if ( HW_IPCC_HOST_IsActiveFlag( HW_IPCC_MM_RELEASE_BUFFER_CHANNEL ) )
+  {
+    FreeBufCb = cb;
+    (void)pthread_mutex_lock( &Cpu2Lock );
+    TxEnabled |= HW_IPCC_MM_RELEASE_BUFFER_CHANNEL;
+    (void)pthread_cond_signal( &Cpu2Cond );
+    (void)pthread_mutex_unlock( &Cpu2Lock );
+  }
+  else
+  {
+    cb();
+
+    HW_IPCC_HOST_SetFlag( HW_IPCC_MM_RELEASE_BUFFER_CHANNEL, FALSE );
+  }
+
+  RESTORE_PRIMASK();
+
+  return;
+}
+
+static void HW_IPCC_MM_FreeBufHandler( void )
+{
+  HW_IPCC_HOST_DisableTx( HW_IPCC_MM_RELEASE_BUFFER_CHANNEL );
+
+  FreeBufCb();
+
+  HW_IPCC_HOST_SetFlag( HW_IPCC_MM_RELEASE_BUFFER_CHANNEL, FALSE );
+
+  return;
+}
+
+/******************************************************************************
+ * TRACES
+ ******************************************************************************/
+void HW_IPCC_TRACES_Init( void )
+{
+  return;
+}
+
+__WEAK void HW_IPCC_TRACES_EvtNot( void ){};
+
+/* Private functions ---------------------------------------------------------*/
+
+/******************************************************************************
+ * IPCC
+ ******************************************************************************/
+static void HW_IPCC_HOST_SetFlag( uint32_t channel, uint8_t enable_tx )
+{
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  ChannelFlags |= channel;
+  if( enable_tx != FALSE )
+  {
+    TxEnabled |= channel;
+  }
+  (void)pthread_cond_signal( &Cpu2Cond );
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return;
+}
+
+static uint8_t HW_IPCC_HOST_IsActiveFlag( uint32_t channel )
+{
+  uint8_t active;
+
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  active = ( ( ChannelFlags & channel ) != 0 );
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return active;
+}
+
+static void HW_IPCC_HOST_DisableTx( uint32_t channel )
+{
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  TxEnabled &= ~channel;
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return;
+}
+
+/******************************************************************************
+ * CPU2
+ ******************************************************************************/
+static void *HW_IPCC_HOST_Cpu2( void *arg )
+{
+  uint32_t flags;
+  uint32_t tx_irq;
+  uint32_t evt_nbr;
+  uint8_t pool_empty = FALSE;
+  uint8_t burst;
+  uint8_t avail_evt;
+  uint8_t avail_sent;
+
+  (void)arg;
+
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  while( Cpu2Stop == 0 )
+  {
+    flags = ChannelFlags;
+    tx_irq = TxEnabled & ~ChannelFlags;
+    evt_nbr = ( pool_empty == FALSE ) ? BurstEvtNbr : 0;
+    avail_evt = ( pool_empty == FALSE ) ? GattTxPoolAvailEvtPending : FALSE;
+
+    if( ( flags == 0 ) && ( tx_irq == 0 ) && ( evt_nbr == 0 ) && ( avail_evt == FALSE ) )
+    {
+      Cpu2Busy = 0;
+      (void)pthread_cond_broadcast( &IdleCond );
+      (void)pthread_cond_wait( &Cpu2Cond, &Cpu2Lock );
+      continue;
+    }
+    Cpu2Busy = 1;
+    (void)pthread_mutex_unlock( &Cpu2Lock );
+
+    /**
+     * The interrupts are raised without holding Cpu2Lock as the CPU1 code takes it with the interrupts masked
+     */
+    if( tx_irq != 0 )
+    {
+      HW_IPCC_HOST_Cpu2RaiseTxIrq( tx_irq );
+    }
+
+    if( flags != 0 )
+    {
+      HW_IPCC_HOST_Cpu2ProcessRequests( flags );
+    }
+
+    if( flags & HW_IPCC_MM_RELEASE_BUFFER_CHANNEL )
+    {
+      pool_empty = FALSE;
+    }
+
+    burst = ( evt_nbr != 0 );
+    if( burst != FALSE )
+    {
+      evt_nbr = HW_IPCC_HOST_Cpu2SendAsynchEvt( evt_nbr );
+    }
+
+    avail_sent = FALSE;
+    if( avail_evt != FALSE )
+    {
+      avail_sent = HW_IPCC_HOST_Cpu2SendTxPoolAvailableEvt( );
+    }
+
+    (void)pthread_mutex_lock( &Cpu2Lock );
+    if( avail_evt != FALSE )
+    {
+      if( avail_sent != FALSE )
+      {
+        GattTxPoolAvailEvtPending = FALSE;
+      }
+      else
+      {
+        /* Wait for the CPU1 to release buffers */
+        pool_empty = TRUE;
+        HostStats.PoolEmptyNbr++;
+      }
+    }
+    if( burst != FALSE )
+    {
+      BurstEvtNbr -= evt_nbr;
+      if( ( BurstEvtNbr != 0 ) && ( p_Cpu2FreeEvt == NULL ) )
+      {
+        /* Wait for the CPU1 to release buffers */
+        pool_empty = TRUE;
+        HostStats.PoolEmptyNbr++;
+      }
+    }
+  }
+  Cpu2Busy = 0;
+  (void)pthread_cond_broadcast( &IdleCond );
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return NULL;
+}
+
+static void HW_IPCC_HOST_Cpu2RaiseTxIrq( uint32_t channels )
+{
+  BACKUP_PRIMASK();
+
+  DISABLE_IRQ();
+
+  if( channels & HW_IPCC_SYSTEM_CMD_RSP_CHANNEL )
+  {
+    HW_IPCC_SYS_CmdEvtHandler();
+  }
+  if( channels & HW_IPCC_MM_RELEASE_BUFFER_CHANNEL )
+  {
+    HW_IPCC_MM_FreeBufHandler();
+  }
+  if( channels & HW_IPCC_HCI_ACL_DATA_CHANNEL )
+  {
+    HW_IPCC_BLE_AclDataEvtHandler();
+  }
+
+  RESTORE_PRIMASK();
+
+  return;
+}
+
+static void HW_IPCC_HOST_Cpu2ProcessRequests( uint32_t flags )
+{
+  volatile MB_RefTable_t *p_ref_table = &__start_MAPPING_TABLE;
+  TL_CmdPacket_t *p_cmd;
+  TL_EvtPacket_t *p_evt;
+  TL_EvtSerial_t *p_rsp;
+  TL_CcEvt_t *p_cc;
+  TL_AclDataPacket_t *p_acl;
+  tListNode *p_node;
+  uint16_t cmdcode;
+  uint8_t status;
+  uint32_t free_buf_nbr = 0;
+
+  if( flags & HW_IPCC_SYSTEM_CMD_RSP_CHANNEL )
+  {
+    /**
+     * The response of a system command does not have the packet header
+     */
+    p_cmd = (TL_CmdPacket_t*)p_ref_table->p_sys_table->pcmd_buffer;
+    cmdcode = p_cmd->cmdserial.cmd.cmdcode;
+    p_rsp = (TL_EvtSerial_t*)p_cmd;
+    p_rsp->type = TL_SYSRSP_PKT_TYPE;
+    p_rsp->evt.evtcode = TL_BLEEVT_CC_OPCODE;
+    p_rsp->evt.plen = HW_IPCC_HOST_CC_PLEN;
+    p_cc = (TL_CcEvt_t*)p_rsp->evt.payload;
+    p_cc->numcmd = 1;
+    p_cc->cmdcode = cmdcode;
+    p_cc->payload[0] = 0;
+  }
+
+  if( flags & HW_IPCC_BLE_CMD_CHANNEL )
+  {
+    /**
+     * The command complete event is written in the command buffer
+     */
+    p_cmd = (TL_CmdPacket_t*)p_ref_table->p_ble_table->pcmd_buffer;
+    cmdcode = p_cmd->cmdserial.cmd.cmdcode;
+    status = HW_IPCC_HOST_Cpu2GattTx( p_cmd );
+    p_evt = (TL_EvtPacket_t*)p_cmd;
+    p_evt->evtserial.type = TL_BLEEVT_PKT_TYPE;
+    p_evt->evtserial.evt.evtcode = TL_BLEEVT_CC_OPCODE;
+    p_evt->evtserial.evt.plen = HW_IPCC_HOST_CC_PLEN;
+    p_cc = (TL_CcEvt_t*)p_evt->evtserial.evt.payload;
+    p_cc->numcmd = 1;
+    p_cc->cmdcode = cmdcode;
+    p_cc->payload[0] = status;
+
+    LST_insert_tail( (tListNode*)p_ref_table->p_ble_table->pevt_queue, (tListNode*)p_evt );
+  }
+
+  if( flags & HW_IPCC_HCI_ACL_DATA_CHANNEL )
+  {
+    p_acl = (TL_AclDataPacket_t*)p_ref_table->p_ble_table->phci_acl_data_buffer;
+    (void)p_acl->AclDataSerial.length;
+  }
+
+  if( flags & HW_IPCC_MM_RELEASE_BUFFER_CHANNEL )
+  {
+    HW_IPCC_HOST_Cpu2InitPool();
+
+    while( LST_is_empty( (tListNode*)p_ref_table->p_mem_manager_table->pevt_free_buffer_queue ) == FALSE )
+    {
+      LST_remove_head( (tListNode*)p_ref_table->p_mem_manager_table->pevt_free_buffer_queue, &p_node );
+      p_node->next = (tListNode*)p_Cpu2FreeEvt;
+      p_Cpu2FreeEvt = (TL_EvtPacket_t*)p_node;
+      free_buf_nbr++;
+    }
+  }
+
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  if( flags & HW_IPCC_BLE_CMD_CHANNEL )
+  {
+    HostStats.BleCmdNbr++;
+    HostStats.BleEvtIrqNbr++;
+  }
+  if( flags & HW_IPCC_SYSTEM_CMD_RSP_CHANNEL )
+  {
+    HostStats.SysCmdNbr++;
+  }
+  if( flags & HW_IPCC_HCI_ACL_DATA_CHANNEL )
+  {
+    HostStats.AclDataNbr++;
+  }
+  if( flags & HW_IPCC_MM_RELEASE_BUFFER_CHANNEL )
+  {
+    HostStats.FreeBufIrqNbr++;
+    HostStats.FreeBufNbr += free_buf_nbr;
+  }
+  /**
+   * The channels are released before the transmit free interrupts are raised
+   */
+  ChannelFlags &= ~flags;
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  if( flags & HW_IPCC_BLE_CMD_CHANNEL )
+  {
+    BACKUP_PRIMASK();
+
+    DISABLE_IRQ();
+    HW_IPCC_BLE_EvtHandler();
+    RESTORE_PRIMASK();
+  }
+
+  return;
+}
+
+static void HW_IPCC_HOST_Cpu2InitPool( void )
+{
+  volatile MB_RefTable_t *p_ref_table = &__start_MAPPING_TABLE;
+  uint8_t *p_pool;
+  uint32_t pool_size;
+
+  if( Cpu2PoolInitialized == 0 )
+  {
+    Cpu2PoolInitialized = 1;
+
+    p_pool = p_ref_table->p_mem_manager_table->blepool;
+    pool_size = p_ref_table->p_mem_manager_table->blepoolsize;
+
+    while( ( p_pool != NULL ) && ( pool_size >= HW_IPCC_HOST_EVT_BUFFER_SIZE ) )
+    {
+      ((tListNode*)p_pool)->next = (tListNode*)p_Cpu2FreeEvt;
+      p_Cpu2FreeEvt = (TL_EvtPacket_t*)p_pool;
+      p_pool += HW_IPCC_HOST_EVT_BUFFER_SIZE;
+      pool_size -= HW_IPCC_HOST_EVT_BUFFER_SIZE;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief  Notification/indication sent with a BLE command, checked against the GATT TX pool
+ * @note   To be called before the command complete event overwrites the command packet
+ * @param  p_cmd: BLE command
+ * @retval Status of the command
+ */
+static uint8_t HW_IPCC_HOST_Cpu2GattTx( TL_CmdPacket_t *p_cmd )
+{
+  uint16_t cmdcode = p_cmd->cmdserial.cmd.cmdcode;
+  uint8_t status = 0;
+  uint8_t len;
+
+  if( cmdcode == HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_OPCODE )
+  {
+    len = p_cmd->cmdserial.cmd.payload[HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_LEN_OFFSET];
+  }
+  else if( cmdcode == HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_EXT_OPCODE )
+  {
+    len = p_cmd->cmdserial.cmd.payload[HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_EXT_LEN_OFFSET];
+  }
+  else
+  {
+    return status;
+  }
+
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  if( ( GattTxPoolSize != 0 ) && ( GattTxPoolUsed >= GattTxPoolSize ) )
+  {
+    status = HW_IPCC_HOST_STATUS_INSUFFICIENT_RESOURCES;
+    GattTxPoolFull = TRUE;
+    GattTxPoolConnHandle = (cmdcode == HW_IPCC_HOST_GATT_UPDATE_CHAR_VALUE_EXT_OPCODE) ?
+                           (p_cmd->cmdserial.cmd.payload[0] | (p_cmd->cmdserial.cmd.payload[1] << 8)) : 0;
+    HostStats.GattTxFullNbr++;
+  }
+  else
+  {
+    if( GattTxPoolSize != 0 )
+    {
+      GattTxPoolUsed++;
+    }
+    HostStats.GattTxNbr++;
+    HostStats.GattTxByteNbr += len;
+  }
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return status;
+}
+
+static uint8_t HW_IPCC_HOST_Cpu2SendTxPoolAvailableEvt( void )
+{
+  volatile MB_RefTable_t *p_ref_table = &__start_MAPPING_TABLE;
+  TL_EvtPacket_t *p_evt;
+  TL_AsynchEvt_t *p_asynch_evt;
+  uint16_t param[2];
+
+  HW_IPCC_HOST_Cpu2InitPool();
+
+  if( p_Cpu2FreeEvt == NULL )
+  {
+    return FALSE;
+  }
+
+  p_evt = p_Cpu2FreeEvt;
+  p_Cpu2FreeEvt = (TL_EvtPacket_t*)((tListNode*)p_evt)->next;
+
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  param[0] = GattTxPoolConnHandle;
+  param[1] = GattTxPoolSize - GattTxPoolUsed;
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  p_evt->evtserial.type = TL_BLEEVT_PKT_TYPE;
+  p_evt->evtserial.evt.evtcode = TL_BLEEVT_VS_OPCODE;
+  p_evt->evtserial.evt.plen = sizeof(uint16_t) + sizeof(param);
+  p_asynch_evt = (TL_AsynchEvt_t*)p_evt->evtserial.evt.payload;
+  p_asynch_evt->subevtcode = HW_IPCC_HOST_GATT_TX_POOL_AVAILABLE_EVT_CODE;
+  memcpy( p_asynch_evt->payload, param, sizeof(param) );
+
+  LST_insert_tail( (tListNode*)p_ref_table->p_ble_table->pevt_queue, (tListNode*)p_evt );
+
+  BACKUP_PRIMASK();
+
+  DISABLE_IRQ();
+  HW_IPCC_BLE_EvtHandler();
+  RESTORE_PRIMASK();
+
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  HostStats.AsynchEvtNbr++;
+  HostStats.BleEvtIrqNbr++;
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  return TRUE;
+}
+
+static uint32_t HW_IPCC_HOST_Cpu2SendAsynchEvt( uint32_t evt_nbr )
+{
+  volatile MB_RefTable_t *p_ref_table = &__start_MAPPING_TABLE;
+  TL_EvtPacket_t *p_evt;
+  TL_AsynchEvt_t *p_asynch_evt;
+  uint16_t subevtcode;
+  uint8_t payload_size;
+  uint32_t sent_nbr = 0;
+
+  (void)pthread_mutex_lock( &Cpu2Lock );
+  subevtcode = BurstSubEvtCode;
+  payload_size = BurstPayloadSize;
+  (void)pthread_mutex_unlock( &Cpu2Lock );
+
+  HW_IPCC_HOST_Cpu2InitPool();
+
+  while( ( sent_nbr < evt_nbr ) && ( p_Cpu2FreeEvt != NULL ) )
+  {
+    p_evt = p_Cpu2FreeEvt;
+    p_Cpu2FreeEvt = (TL_EvtPacket_t*)((tListNode*)p_evt)->next;
+
+    p_evt->evtserial.type = TL_BLEEVT_PKT_TYPE;
+    p_evt->evtserial.evt.evtcode = TL_BLEEVT_VS_OPCODE;
+    p_evt->evtserial.evt.plen = sizeof(uint16_t) + payload_size;
+    p_asynch_evt = (TL_AsynchEvt_t*)p_evt->evtserial.evt.payload;
+    p_asynch_evt->subevtcode = subevtcode;
+    memset( p_asynch_evt->payload, 0, payload_size );
+    memcpy( p_asynch_evt->payload, &Cpu2EvtSeqNbr, MIN(payload_size, sizeof(Cpu2EvtSeqNbr)) );
+    Cpu2EvtSeqNbr++;
+
+    LST_insert_tail( (tListNode*)p_ref_table->p_ble_table->pevt_queue, (tListNode*)p_evt );
+    sent_nbr++;
+  }
+
+  if( sent_nbr != 0 )
+  {
+    /**
+     * All the events queued are reported with a single interrupt
+     */
+    BACKUP_PRIMASK();
+
+    DISABLE_IRQ();
+    HW_IPCC_BLE_EvtHandler();
+    RESTORE_PRIMASK();
+
+    (void)pthread_mutex_lock( &Cpu2Lock );
+    HostStats.AsynchEvtNbr += sent_nbr;
+    HostStats.BleEvtIrqNbr++;
+    (void)pthread_mutex_unlock( &Cpu2Lock );
+  }
+
+  return sent_nbr;
+}
@@ -0,0 +1,85 @@
+/**
+ ******************************************************************************
+ * @file    hw_ipcc_host.h
+ * @author  MCD Application Team
+ * @brief   Header for hw_ipcc_host.c
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Linux host simulator of the IPCC and of the CPU2 for the BLE and system
+ * channels of the mailbox transport layer (tl_mbox.c, hci_tl.c, shci_tl.c).
+ *
+ * A thread plays the CPU2:
+ *  - it answers each BLE command with a command complete event (status
+ *    success, no return parameter) and each system command with a command
+ *    response (status success)
+ *  - it consumes the ACL data packets and acknowledges them
+ *  - it takes back the event buffers released with TL_MM_EvtDone()
+ *  - it generates bursts of BLE asynchronous events on request, allocated
+ *    from the pool given in TL_MM_Init()
+ *  - it may model a GATT TX pool: the notifications are then rejected with
+ *    BLE_STATUS_INSUFFICIENT_RESOURCES when the pool is full, and
+ *    ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE is sent once some are transmitted
+ *
+ * The CPU2 finds the reference table through the MAPPING_TABLE section, as on
+ * target. The transport layer files are built unmodified together with
+ * hw_ipcc_host.c, stm_list.c and the cmsis_compiler.h stand-in of this
+ * directory. The Makefile of this directory builds tl_host, which measures the
+ * per packet overhead of each channel, hci_cmd_host, which compares the
+ * blocking and the non-blocking ACI commands of hci_tl.c, hci_evt_host,
+ * which measures the budgets of hci_user_evt_proc_budget(), and stream_host,
+ * which tests the GATT TX pool flow control of stream_stm.c.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HW_IPCC_HOST_H
+#define __HW_IPCC_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t BleCmdNbr;           /**< Number of BLE commands received by the CPU2 */
+  uint32_t SysCmdNbr;           /**< Number of system commands received by the CPU2 */
+  uint32_t AclDataNbr;          /**< Number of ACL data packets received by the CPU2 */
+  uint32_t AsynchEvtNbr;        /**< Number of BLE asynchronous events sent by the CPU2 */
+  uint32_t BleEvtIrqNbr;        /**< Number of BLE event channel interrupts raised to the CPU1 */
+  uint32_t FreeBufIrqNbr;       /**< Number of release buffer channel transactions received by the CPU2 */
+  uint32_t FreeBufNbr;          /**< Number of event buffers given back to the CPU2 */
+  uint32_t PoolEmptyNbr;        /**< Number of times the CPU2 waited for a free event buffer */
+  uint32_t GattTxNbr;           /**< Number of notifications/indications accepted by the CPU2 */
+  uint32_t GattTxByteNbr;       /**< Number of bytes of the notifications/indications accepted by the CPU2 */
+  uint32_t GattTxFullNbr;       /**< Number of notifications/indications rejected as the GATT TX pool is full */
+} HW_IPCC_HOST_Stats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void HW_IPCC_HOST_Stop( void );
+void HW_IPCC_HOST_SendBleAsynchEvt( uint32_t EvtNbr, uint16_t SubEvtCode, uint8_t PayloadSize );
+void HW_IPCC_HOST_SetGattTxPool( uint16_t BufNbr );
+uint16_t HW_IPCC_HOST_TransmitGattTx( uint16_t BufNbr );
+void HW_IPCC_HOST_WaitIdle( void );
+void HW_IPCC_HOST_GetStats( HW_IPCC_HOST_Stats_t *p_Stats );
+void HW_IPCC_HOST_ResetStats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__HW_IPCC_HOST_H */
@@ -0,0 +1,515 @@
+/**
+ ******************************************************************************
+ * @file    stream_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host test of the TX pool flow control of stream_stm.c
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * stream_stm.c streams <bytes> to each of two connections through the real
+ * transport layer, to the CPU2 simulated by hw_ipcc_host.c with a GATT TX pool
+ * of <pool> notifications:
+ *
+ *   - connection 1: ATT_MTU 247, data length 251, payload of 243 bytes
+ *   - connection 2: ATT_MTU 100, data length 27, payload of 74 bytes
+ *
+ * The CFG_TASK_APP_ID task runs STREAM_STM_Process() on
+ * STREAM_STM_PROCESS_REQ_EVT. The CFG_TASK_OTHER_ID task plays the link layer:
+ * once the CPU2 is idle, it transmits up to <tx> notifications with
+ * HW_IPCC_HOST_TransmitGattTx(), which sends ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE
+ * when the pool was full. The events of the CPU2 are given to the service
+ * handler as SVCCTL_UserEvtRx() would.
+ *
+ * The test checks that:
+ *   - all the bytes given by STREAM_STM_App_Fill() are accepted by the CPU2,
+ *     none lost or sent twice, without any error
+ *   - every notification rejected as the pool is full is sent again, after
+ *     one ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE, before any new payload
+ *   - the payload sizes match the ATT_MTU and the data length
+ *   - a third connection is refused (BLE_CFG_STREAM_MAX_CONN is 2)
+ *
+ * The simulated CPU2 answers the commands without return parameters, so
+ * aci_gatt_add_service() and aci_gatt_add_char() give the handle 0 and the
+ * client characteristic configuration descriptor has the handle 2.
+ *
+ * Usage: stream_host [-n bytes] [-p pool] [-t tx] [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <unistd.h>
+
+#include "app_conf.h"
+#include "common_blesvc.h"
+#include "tl.h"
+#include "hci_tl.h"
+#include "stm32_seq.h"
+#include "hw_ipcc_host.h"
+#include "hci_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define STREAM_HOST_CONN_NBR            (2U)
+#define STREAM_HOST_CCCD_HANDLE         (0x0002U)
+#define STREAM_HOST_TX_POOL_AVAIL_CODE  (0x0C16U)
+#define STREAM_HOST_MAX_STALLS          (1000U)
+#define STREAM_HOST_MAX_ERRORS          (10U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint16_t ConnectionHandle;
+  uint16_t AttMtu;
+  uint16_t MaxTxOctets;
+  uint16_t PayloadSize;         /**< Expected payload size */
+  uint32_t FillByteNbr;         /**< Bytes given by STREAM_STM_App_Fill() */
+  uint8_t  Enabled;
+} STREAM_HOST_Conn_t;
+
+/* Private variables ---------------------------------------------------------*/
+static STREAM_HOST_Conn_t Conn[STREAM_HOST_CONN_NBR] =
+{
+  { 0x0001U, 247U, 251U, 243U, 0U, FALSE },
+  { 0x0002U, 100U, 27U,  74U,  0U, FALSE },
+};
+
+static uint32_t ByteNbr = 1000000U;
+static uint16_t PoolSize = 12U;
+static uint16_t TxNbr = 4U;
+static const char *CsvFile;
+
+static SVC_CTL_p_EvtHandler_t StreamHandler;
+static uint32_t TxPoolAvailNbr;
+static uint32_t TransmitNbr;
+static uint32_t StallNbr;
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static void STREAM_HOST_LinkLayerTask( void );
+static void STREAM_HOST_UserEvtRx( void *pPayload );
+static void STREAM_HOST_InjectEvt( uint16_t Ecode, const void *p_Data, uint8_t Size );
+static void STREAM_HOST_Connect( STREAM_HOST_Conn_t *p_Conn );
+static STREAM_HOST_Conn_t * STREAM_HOST_GetConn( uint16_t ConnectionHandle );
+static uint8_t STREAM_HOST_Done( void );
+static void STREAM_HOST_Error( const char *p_Msg, uint32_t Value );
+static void STREAM_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  HW_IPCC_HOST_Stats_t host_stats;
+  STREAM_STM_Stats_t stats[STREAM_HOST_CONN_NBR];
+  STREAM_HOST_Conn_t extra_conn = { 0x0003U, 247U, 251U, 243U, 0U, FALSE };
+  uint32_t pool_full_nbr;
+  uint32_t index;
+  FILE *p_csv;
+  int opt;
+
+  while((opt = getopt(argc, argv, "n:p:t:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'n':
+        ByteNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'p':
+        PoolSize = (uint16_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 't':
+        TxNbr = (uint16_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        STREAM_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  if((ByteNbr == 0U) || (PoolSize == 0U) || (TxNbr == 0U))
+  {
+    STREAM_HOST_Usage(argv[0]);
+  }
+
+  HCI_HOST_Init(STREAM_HOST_UserEvtRx);
+  UTIL_SEQ_RegTask(1<<CFG_TASK_APP_ID, UTIL_SEQ_RFU, STREAM_STM_Process);
+  UTIL_SEQ_RegTask(1<<CFG_TASK_OTHER_ID, UTIL_SEQ_RFU, STREAM_HOST_LinkLayerTask);
+
+  STREAM_STM_Init();
+  if(StreamHandler == NULL)
+  {
+    STREAM_HOST_Error("service handler not registered", 0);
+    return 1;
+  }
+
+  HW_IPCC_HOST_SetGattTxPool(PoolSize);
+  HW_IPCC_HOST_ResetStats();
+
+  for(index = 0; index < STREAM_HOST_CONN_NBR; index++)
+  {
+    STREAM_HOST_Connect(&Conn[index]);
+    if(Conn[index].Enabled == FALSE)
+    {
+      STREAM_HOST_Error("notifications not enabled on connection", Conn[index].ConnectionHandle);
+    }
+  }
+
+  /* No entry is left for a third connection */
+  STREAM_HOST_Connect(&extra_conn);
+  if((extra_conn.Enabled != FALSE) ||
+     (STREAM_STM_GetStats(extra_conn.ConnectionHandle, &stats[0]) == BLE_STATUS_SUCCESS))
+  {
+    STREAM_HOST_Error("third connection accepted", extra_conn.ConnectionHandle);
+  }
+
+  UTIL_SEQ_SetTask(1<<CFG_TASK_OTHER_ID, CFG_SCH_PRIO_0);
+  HCI_HOST_Run();
+  HCI_HOST_DeInit();
+  HW_IPCC_HOST_GetStats(&host_stats);
+
+  pool_full_nbr = 0;
+  for(index = 0; index < STREAM_HOST_CONN_NBR; index++)
+  {
+    (void)STREAM_STM_GetStats(Conn[index].ConnectionHandle, &stats[index]);
+    pool_full_nbr += stats[index].PoolFullNbr;
+
+    if((Conn[index].FillByteNbr != ByteNbr) || (stats[index].TxByteNbr != ByteNbr))
+    {
+      STREAM_HOST_Error("bytes lost or sent twice on connection", Conn[index].ConnectionHandle);
+    }
+    if(stats[index].ErrorNbr != 0U)
+    {
+      STREAM_HOST_Error("notifications dropped on connection", Conn[index].ConnectionHandle);
+    }
+    if(stats[index].RetryNbr != stats[index].PoolFullNbr)
+    {
+      STREAM_HOST_Error("rejected notifications not sent again on connection", Conn[index].ConnectionHandle);
+    }
+    if(stats[index].PayloadSize != Conn[index].PayloadSize)
+    {
+      STREAM_HOST_Error("wrong payload size on connection", Conn[index].ConnectionHandle);
+    }
+
+    printf("connection %u (mtu %3u, data length %3u): payload %3u, %u notifications, %u bytes, "
+           "pool full %u, retries %u, errors %u\n",
+           Conn[index].ConnectionHandle, Conn[index].AttMtu, Conn[index].MaxTxOctets, stats[index].PayloadSize,
+           stats[index].TxPacketNbr, stats[index].TxByteNbr, stats[index].PoolFullNbr, stats[index].RetryNbr,
+           stats[index].ErrorNbr);
+  }
+
+  if((host_stats.GattTxByteNbr != (ByteNbr * STREAM_HOST_CONN_NBR)) ||
+     (host_stats.GattTxNbr != (stats[0].TxPacketNbr + stats[1].TxPacketNbr)) || (TransmitNbr != host_stats.GattTxNbr))
+  {
+    STREAM_HOST_Error("notifications accepted by the CPU2 do not match", host_stats.GattTxNbr);
+  }
+  if((host_stats.GattTxFullNbr != pool_full_nbr) || (TxPoolAvailNbr != pool_full_nbr))
+  {
+    STREAM_HOST_Error("pool full without one tx pool available event", TxPoolAvailNbr);
+  }
+
+  printf("pool %2u, tx %2u: %u bytes per connection, %u notifications, pool full %u, tx pool available %u, "
+         "%u errors\n",
+         PoolSize, TxNbr, ByteNbr, host_stats.GattTxNbr, pool_full_nbr, TxPoolAvailNbr, ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "pool,tx,bytes,notifications,pool_full,tx_pool_available,errors\n");
+      }
+      fprintf(p_csv, "%u,%u,%u,%u,%u,%u,%u\n", PoolSize, TxNbr, ByteNbr, host_stats.GattTxNbr, pool_full_nbr,
+              TxPoolAvailNbr, ErrorNbr);
+      fclose(p_csv);
+    }
+  }
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/**
+ * @brief Stand-ins of svc_ctl.c, the handler of the service is called directly
+ */
+void SVCCTL_RegisterSvcHandler( SVC_CTL_p_EvtHandler_t pfBLE_SVC_Service_Event_Handler )
+{
+  StreamHandler = pfBLE_SVC_Service_Event_Handler;
+
+  return;
+}
+
+void SVCCTL_RegisterSvcHandleRange( SVC_CTL_p_EvtHandler_t pfBLE_SVC_Service_Event_Handler,
+                                    uint16_t StartHandle,
+                                    uint16_t EndHandle )
+{
+  (void)pfBLE_SVC_Service_Event_Handler;
+  (void)StartHandle;
+  (void)EndHandle;
+
+  return;
+}
+
+void STREAM_STM_App_Notification( STREAM_STM_App_Notification_evt_t *pNotification )
+{
+  STREAM_HOST_Conn_t *p_conn;
+
+  p_conn = STREAM_HOST_GetConn(pNotification->ConnectionHandle);
+
+  switch(pNotification->Stream_Evt_Opcode)
+  {
+    case STREAM_STM_NOTIFY_ENABLED_EVT:
+      if(p_conn != NULL)
+      {
+        p_conn->Enabled = TRUE;
+      }
+      else
+      {
+        STREAM_HOST_Error("notifications enabled on connection", pNotification->ConnectionHandle);
+      }
+      break;
+
+    case STREAM_STM_NOTIFY_DISABLED_EVT:
+      if(p_conn != NULL)
+      {
+        p_conn->Enabled = FALSE;
+      }
+      break;
+
+    case STREAM_STM_PROCESS_REQ_EVT:
+      UTIL_SEQ_SetTask(1<<CFG_TASK_APP_ID, CFG_SCH_PRIO_0);
+      break;
+
+    default:
+      break;
+  }
+
+  return;
+}
+
+/**
+ * @brief The bytes of each connection are numbered. A new payload is only asked once every notification rejected
+ *        as the pool was full has been sent again.
+ */
+uint16_t STREAM_STM_App_Fill( uint16_t ConnectionHandle, uint8_t *pPayload, uint16_t Size )
+{
+  STREAM_HOST_Conn_t *p_conn;
+  STREAM_STM_Stats_t stats;
+  uint32_t pool_full_nbr = 0;
+  uint32_t retry_nbr = 0;
+  uint32_t conn_index;
+  uint16_t length;
+  uint16_t index;
+
+  for(conn_index = 0; conn_index < STREAM_HOST_CONN_NBR; conn_index++)
+  {
+    (void)STREAM_STM_GetStats(Conn[conn_index].ConnectionHandle, &stats);
+    pool_full_nbr += stats.PoolFullNbr;
+    retry_nbr += stats.RetryNbr;
+  }
+  if(retry_nbr != pool_full_nbr)
+  {
+    STREAM_HOST_Error("new payload asked before the rejected one is sent again", pool_full_nbr);
+  }
+
+  p_conn = STREAM_HOST_GetConn(ConnectionHandle);
+  if(p_conn == NULL)
+  {
+    STREAM_HOST_Error("payload asked for an unknown connection", ConnectionHandle);
+    return 0;
+  }
+
+  if(Size != p_conn->PayloadSize)
+  {
+    STREAM_HOST_Error("wrong payload size asked", Size);
+  }
+
+  length = (uint16_t)MIN((uint32_t)Size, ByteNbr - p_conn->FillByteNbr);
+  for(index = 0; index < length; index++)
+  {
+    pPayload[index] = (uint8_t)(p_conn->FillByteNbr + index);
+  }
+  p_conn->FillByteNbr += length;
+
+  return length;
+}
+
+uint32_t STREAM_STM_App_GetTick( void )
+{
+  return (uint32_t)(HCI_HOST_NowNs(CLOCK_MONOTONIC) / 1000000U);
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief Connection event: the notifications held by the CPU2 are transmitted once it has processed the commands
+ */
+static void STREAM_HOST_LinkLayerTask( void )
+{
+  uint16_t tx_nbr;
+
+  HW_IPCC_HOST_WaitIdle();
+  tx_nbr = HW_IPCC_HOST_TransmitGattTx(TxNbr);
+  TransmitNbr += tx_nbr;
+
+  if((tx_nbr == 0U) && (STREAM_HOST_Done() != FALSE))
+  {
+    HCI_HOST_Stop();
+    return;
+  }
+
+  if(tx_nbr == 0U)
+  {
+    StallNbr++;
+    if(StallNbr >= STREAM_HOST_MAX_STALLS)
+    {
+      STREAM_HOST_Error("streaming stalled", TransmitNbr);
+      HCI_HOST_Stop();
+      return;
+    }
+  }
+  else
+  {
+    StallNbr = 0;
+  }
+
+  UTIL_SEQ_SetTask(1<<CFG_TASK_OTHER_ID, CFG_SCH_PRIO_0);
+
+  return;
+}
+
+static void STREAM_HOST_UserEvtRx( void *pPayload )
+{
+  tHCI_UserEvtRxParam *p_param;
+  TL_EvtPacket_t *p_evt;
+  TL_AsynchEvt_t *p_asynch_evt;
+
+  p_param = (tHCI_UserEvtRxParam *)pPayload;
+  p_evt = p_param->pckt;
+  p_asynch_evt = (TL_AsynchEvt_t*)p_evt->evtserial.evt.payload;
+
+  if((p_evt->evtserial.evt.evtcode == TL_BLEEVT_VS_OPCODE) &&
+     (p_asynch_evt->subevtcode == STREAM_HOST_TX_POOL_AVAIL_CODE))
+  {
+    TxPoolAvailNbr++;
+  }
+  else
+  {
+    STREAM_HOST_Error("unexpected event", p_evt->evtserial.evt.evtcode);
+  }
+
+  (void)StreamHandler((void *)&(p_evt->evtserial));
+  p_param->status = HCI_TL_UserEventFlow_Enable;
+
+  return;
+}
+
+/**
+ * @brief Vendor specific event of the BLE stack given to the service handler
+ */
+static void STREAM_HOST_InjectEvt( uint16_t Ecode, const void *p_Data, uint8_t Size )
+{
+  uint8_t evt[sizeof(TL_EvtSerial_t) + sizeof(uint16_t) + 32U];
+
+  evt[0] = TL_BLEEVT_PKT_TYPE;
+  evt[1] = HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE;
+  evt[2] = (uint8_t)(sizeof(uint16_t) + Size);
+  evt[3] = (uint8_t)Ecode;
+  evt[4] = (uint8_t)(Ecode >> 8);
+  memcpy(&evt[5], p_Data, MIN(Size, sizeof(evt) - 5U));
+
+  (void)StreamHandler(evt);
+
+  return;
+}
+
+/**
+ * @brief Connection of a client: MTU exchange, data length update and notifications enabled
+ */
+static void STREAM_HOST_Connect( STREAM_HOST_Conn_t *p_Conn )
+{
+  aci_att_exchange_mtu_resp_event_rp0 mtu_resp;
+  uint8_t attr_modified[sizeof(uint16_t) * 4U + 2U];
+
+  mtu_resp.Connection_Handle = p_Conn->ConnectionHandle;
+  mtu_resp.Server_RX_MTU = p_Conn->AttMtu;
+  STREAM_HOST_InjectEvt(ACI_ATT_EXCHANGE_MTU_RESP_VSEVT_CODE, &mtu_resp, sizeof(mtu_resp));
+
+  STREAM_STM_SetDataLength(p_Conn->ConnectionHandle, p_Conn->MaxTxOctets);
+
+  attr_modified[0] = (uint8_t)p_Conn->ConnectionHandle;
+  attr_modified[1] = (uint8_t)(p_Conn->ConnectionHandle >> 8);
+  attr_modified[2] = (uint8_t)STREAM_HOST_CCCD_HANDLE;
+  attr_modified[3] = (uint8_t)(STREAM_HOST_CCCD_HANDLE >> 8);
+  attr_modified[4] = 0;
+  attr_modified[5] = 0;
+  attr_modified[6] = 2;
+  attr_modified[7] = 0;
+  attr_modified[8] = COMSVC_Notification;
+  attr_modified[9] = 0;
+  STREAM_HOST_InjectEvt(ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE, attr_modified, sizeof(attr_modified));
+
+  return;
+}
+
+static STREAM_HOST_Conn_t * STREAM_HOST_GetConn( uint16_t ConnectionHandle )
+{
+  uint32_t index;
+
+  for(index = 0; index < STREAM_HOST_CONN_NBR; index++)
+  {
+    if(Conn[index].ConnectionHandle == ConnectionHandle)
+    {
+      return &Conn[index];
+    }
+  }
+
+  return NULL;
+}
+
+static uint8_t STREAM_HOST_Done( void )
+{
+  STREAM_STM_Stats_t stats;
+  uint32_t index;
+
+  for(index = 0; index < STREAM_HOST_CONN_NBR; index++)
+  {
+    if((STREAM_STM_GetStats(Conn[index].ConnectionHandle, &stats) != BLE_STATUS_SUCCESS) ||
+       (stats.TxByteNbr != ByteNbr))
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static void STREAM_HOST_Error( const char *p_Msg, uint32_t Value )
+{
+  if(ErrorNbr < STREAM_HOST_MAX_ERRORS)
+  {
+    printf("error: %s %u\n", p_Msg, Value);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static void STREAM_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s [-n bytes] [-p pool] [-t tx] [-c csv]\n", p_Name);
+  exit(2);
+}
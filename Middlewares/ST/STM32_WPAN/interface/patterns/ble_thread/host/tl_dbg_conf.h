@@ -0,0 +1,38 @@
+/**
+ ******************************************************************************
+ * @file    tl_dbg_conf.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the debug configuration of the transport layer for
+ *          the Linux host build - all the traces are disabled
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TL_DBG_CONF_H
+#define TL_DBG_CONF_H
+
+#define TL_SHCI_CMD_DBG_MSG(...)
+#define TL_SHCI_CMD_DBG_BUF(...)
+#define TL_SHCI_CMD_DBG_RAW(...)
+#define TL_SHCI_EVT_DBG_MSG(...)
+#define TL_SHCI_EVT_DBG_BUF(...)
+#define TL_SHCI_EVT_DBG_RAW(...)
+#define TL_HCI_CMD_DBG_MSG(...)
+#define TL_HCI_CMD_DBG_BUF(...)
+#define TL_HCI_CMD_DBG_RAW(...)
+#define TL_HCI_EVT_DBG_MSG(...)
+#define TL_HCI_EVT_DBG_BUF(...)
+#define TL_HCI_EVT_DBG_RAW(...)
+#define TL_MM_DBG_MSG(...)
+
+#endif /*TL_DBG_CONF_H */
@@ -0,0 +1,498 @@
+/**
+ ******************************************************************************
+ * @file    tl_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host benchmark of the per packet overhead of the mailbox
+ *          transport layer
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * tl_mbox.c is initialized as in the transparent mode application (TL_Init(),
+ * TL_SYS_Init(), TL_BLE_Init(), TL_MM_Init(), TL_Enable()) and exchanges
+ * <packets> packets with the CPU2 simulated by hw_ipcc_host.c:
+ *
+ *   -m ble_cmd  TL_BLE_SendCmd() of a <size> bytes command, then wait for its
+ *               command complete event
+ *   -m sys_cmd  TL_SYS_SendCmd() of a <size> bytes command, then wait for its
+ *               command response
+ *   -m acl      TL_BLE_SendAclData() of <size> bytes, then wait for the
+ *               acknowledge of the CPU2
+ *   -m evt      the CPU2 sends <packets> vendor specific events of <size>
+ *               bytes, each released with TL_MM_EvtDone() once received. With
+ *               -b, TL_MM_SetBatchConfig() gives back the buffers <batch> at a
+ *               time, the buffers held are also given back whenever no event
+ *               is left to process
+ *
+ * The time reported per packet is the round trip, which includes the CPU2
+ * thread, and the CPU time of the thread playing the CPU1. The IPCC interrupt
+ * handlers are executed by the CPU2 thread, so they are only part of the round
+ * trip time.
+ *
+ * Usage: tl_host -m <ble_cmd|sys_cmd|acl|evt> [-n packets] [-s size] [-b batch] [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "app_conf.h"
+#include "stm32_wpan_common.h"
+#include "stm_list.h"
+#include "tl.h"
+#include "hw_ipcc_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TL_HOST_POOL_SIZE               (CFG_TLBLE_EVT_QUEUE_LENGTH*4U*DIVC((sizeof(TL_PacketHeader_t) + TL_BLE_EVENT_FRAME_SIZE), 4U))
+#define TL_HOST_ACL_DATA_MAX_SIZE       (251U)
+#define TL_HOST_EVT_MIN_SIZE            (4U)
+#define TL_HOST_EVT_MAX_SIZE            (253U)
+#define TL_HOST_BLE_CMD_OPCODE          (0xFC3FU)
+#define TL_HOST_SYS_CMD_OPCODE          (0xFC50U)
+#define TL_HOST_EVT_SUBEVTCODE          (0x0C3FU)
+#define TL_HOST_MAX_ERRORS              (10U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  TL_HOST_MODE_BLE_CMD,
+  TL_HOST_MODE_SYS_CMD,
+  TL_HOST_MODE_ACL,
+  TL_HOST_MODE_EVT,
+} TL_HOST_Mode_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *ModeName[] = { "ble_cmd", "sys_cmd", "acl", "evt" };
+
+static TL_HOST_Mode_t Mode = TL_HOST_MODE_BLE_CMD;
+static uint32_t PacketNbr = 100000U;
+static uint32_t PacketSize = 16U;
+static uint32_t BatchNbr;
+static const char *CsvFile;
+
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static uint8_t EvtPool[TL_HOST_POOL_SIZE];
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static TL_CmdPacket_t SystemCmdBuffer;
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static uint8_t SystemSpareEvtBuffer[sizeof(TL_PacketHeader_t) + TL_EVT_HDR_SIZE + 255U];
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static uint8_t BleSpareEvtBuffer[sizeof(TL_PacketHeader_t) + TL_EVT_HDR_SIZE + 255];
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static TL_CmdPacket_t BleCmdBuffer;
+PLACE_IN_SECTION("MB_MEM2") ALIGN(4) static uint8_t HciAclDataBuffer[sizeof(TL_PacketHeader_t) + 5 + 251];
+
+/**
+ * Notifications of the IPCC interrupt handlers to the CPU1 thread
+ */
+static pthread_mutex_t HostLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t HostCond = PTHREAD_COND_INITIALIZER;
+static volatile uint32_t BleCmdEvtNbr;
+static volatile uint32_t SysCmdEvtNbr;
+static volatile uint32_t AclDataAckNbr;
+static volatile uint32_t BleEvtNbr;
+static tListNode BleEvtQueue;
+
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static void TL_HOST_Init( void );
+static void TL_HOST_SysCmdEvt( TL_EvtPacket_t *phcievt );
+static void TL_HOST_SysUserEvt( TL_EvtPacket_t *phcievt );
+static void TL_HOST_BleEvt( TL_EvtPacket_t *phcievt );
+static void TL_HOST_AclDataAck( void );
+static void TL_HOST_WaitCount( volatile uint32_t *p_Count, uint32_t Count );
+static void TL_HOST_RunBleCmd( void );
+static void TL_HOST_RunSysCmd( void );
+static void TL_HOST_RunAcl( void );
+static void TL_HOST_RunEvt( void );
+static void TL_HOST_Error( const char *p_Msg, uint32_t Seq );
+static uint64_t TL_HOST_NowNs( clockid_t ClockId );
+static void TL_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  HW_IPCC_HOST_Stats_t stats;
+  TL_MM_Stats_t mm_stats;
+  TL_MM_BatchConfig_t batch_config;
+  uint64_t start_time;
+  uint64_t start_cpu_time;
+  double rtt_ns;
+  double cpu_ns;
+  FILE *p_csv;
+  int opt;
+  uint32_t mode;
+  uint32_t max_size;
+
+  while((opt = getopt(argc, argv, "m:n:s:b:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'm':
+        for(mode = 0; mode < (sizeof(ModeName) / sizeof(ModeName[0])); mode++)
+        {
+          if(strcmp(optarg, ModeName[mode]) == 0)
+          {
+            break;
+          }
+        }
+        if(mode == (sizeof(ModeName) / sizeof(ModeName[0])))
+        {
+          TL_HOST_Usage(argv[0]);
+        }
+        Mode = (TL_HOST_Mode_t)mode;
+        break;
+
+      case 'n':
+        PacketNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 's':
+        PacketSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'b':
+        BatchNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        TL_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  switch(Mode)
+  {
+    case TL_HOST_MODE_ACL:
+      max_size = TL_HOST_ACL_DATA_MAX_SIZE;
+      break;
+
+    case TL_HOST_MODE_EVT:
+      max_size = TL_HOST_EVT_MAX_SIZE;
+      break;
+
+    default:
+      max_size = 255U;
+      break;
+  }
+  if((PacketNbr == 0U) || (PacketSize > max_size) || (BatchNbr > 255U) ||
+     ((Mode == TL_HOST_MODE_EVT) && (PacketSize < TL_HOST_EVT_MIN_SIZE)))
+  {
+    TL_HOST_Usage(argv[0]);
+  }
+
+  TL_HOST_Init();
+
+  batch_config.MaxBufNbr = (uint8_t)BatchNbr;
+  batch_config.MaxHeldSize = 0;
+  batch_config.MaxHeldTime = 0;
+  TL_MM_SetBatchConfig(&batch_config);
+
+  HW_IPCC_HOST_WaitIdle();
+  HW_IPCC_HOST_ResetStats();
+  TL_MM_ResetStats();
+
+  start_time = TL_HOST_NowNs(CLOCK_MONOTONIC);
+  start_cpu_time = TL_HOST_NowNs(CLOCK_THREAD_CPUTIME_ID);
+  switch(Mode)
+  {
+    case TL_HOST_MODE_BLE_CMD:
+      TL_HOST_RunBleCmd();
+      break;
+
+    case TL_HOST_MODE_SYS_CMD:
+      TL_HOST_RunSysCmd();
+      break;
+
+    case TL_HOST_MODE_ACL:
+      TL_HOST_RunAcl();
+      break;
+
+    default:
+      TL_HOST_RunEvt();
+      break;
+  }
+  rtt_ns = (double)(TL_HOST_NowNs(CLOCK_MONOTONIC) - start_time) / (double)PacketNbr;
+  cpu_ns = (double)(TL_HOST_NowNs(CLOCK_THREAD_CPUTIME_ID) - start_cpu_time) / (double)PacketNbr;
+
+  HW_IPCC_HOST_WaitIdle();
+  HW_IPCC_HOST_GetStats(&stats);
+  TL_MM_GetStats(&mm_stats);
+  HW_IPCC_HOST_Stop();
+
+  printf("%-7s size %3u batch %3u: %u packets, %.0f ns/packet round trip, %.0f ns/packet cpu1, %.0f packets/s, "
+         "evt irq %u, release buffer transactions %u, %u errors\n",
+         ModeName[Mode], PacketSize, BatchNbr, PacketNbr, rtt_ns, cpu_ns, 1e9 / rtt_ns, stats.BleEvtIrqNbr,
+         mm_stats.SendFreeBufNbr, ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "mode,size,batch,packets,rtt_ns,cpu1_ns,packets_per_s,evt_irq,free_buf_transactions,errors\n");
+      }
+      fprintf(p_csv, "%s,%u,%u,%u,%.0f,%.0f,%.0f,%u,%u,%u\n", ModeName[Mode], PacketSize, BatchNbr, PacketNbr, rtt_ns,
+              cpu_ns, 1e9 / rtt_ns, stats.BleEvtIrqNbr, mm_stats.SendFreeBufNbr, ErrorNbr);
+      fclose(p_csv);
+    }
+  }
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief Initialization of the transport layer as in the transparent mode application
+ */
+static void TL_HOST_Init( void )
+{
+  TL_MM_Config_t tl_mm_config;
+  TL_SYS_InitConf_t tl_sys_init_conf;
+  TL_BLE_InitConf_t tl_ble_init_conf;
+
+  LST_init_head(&BleEvtQueue);
+
+  TL_Init();
+
+  tl_sys_init_conf.p_cmdbuffer = (uint8_t*)&SystemCmdBuffer;
+  tl_sys_init_conf.IoBusCallBackCmdEvt = TL_HOST_SysCmdEvt;
+  tl_sys_init_conf.IoBusCallBackUserEvt = TL_HOST_SysUserEvt;
+  TL_SYS_Init((void*)&tl_sys_init_conf);
+
+  tl_ble_init_conf.p_cmdbuffer = (uint8_t*)&BleCmdBuffer;
+  tl_ble_init_conf.p_AclDataBuffer = HciAclDataBuffer;
+  tl_ble_init_conf.IoBusEvtCallBack = TL_HOST_BleEvt;
+  tl_ble_init_conf.IoBusAclDataTxAck = TL_HOST_AclDataAck;
+  TL_BLE_Init((void*)&tl_ble_init_conf);
+
+  tl_mm_config.p_BleSpareEvtBuffer = BleSpareEvtBuffer;
+  tl_mm_config.p_SystemSpareEvtBuffer = SystemSpareEvtBuffer;
+  tl_mm_config.p_AsynchEvtPool = EvtPool;
+  tl_mm_config.AsynchEvtPoolSize = TL_HOST_POOL_SIZE;
+  tl_mm_config.p_TracesEvtPool = NULL;
+  tl_mm_config.TracesEvtPoolSize = 0;
+  TL_MM_Init(&tl_mm_config);
+
+  TL_Enable();
+
+  return;
+}
+
+/**
+ * @brief IPCC interrupt handlers, executed by the CPU2 thread
+ */
+static void TL_HOST_SysCmdEvt( TL_EvtPacket_t *phcievt )
+{
+  (void)phcievt;
+
+  (void)pthread_mutex_lock(&HostLock);
+  SysCmdEvtNbr++;
+  (void)pthread_cond_signal(&HostCond);
+  (void)pthread_mutex_unlock(&HostLock);
+
+  return;
+}
+
+static void TL_HOST_SysUserEvt( TL_EvtPacket_t *phcievt )
+{
+  TL_MM_EvtDone(phcievt);
+
+  return;
+}
+
+static void TL_HOST_BleEvt( TL_EvtPacket_t *phcievt )
+{
+  (void)pthread_mutex_lock(&HostLock);
+  if((phcievt->evtserial.evt.evtcode == TL_BLEEVT_CC_OPCODE) || (phcievt->evtserial.evt.evtcode == TL_BLEEVT_CS_OPCODE))
+  {
+    /* The command complete event is written in the command buffer, it is not released */
+    BleCmdEvtNbr++;
+  }
+  else
+  {
+    LST_insert_tail(&BleEvtQueue, (tListNode*)phcievt);
+    BleEvtNbr++;
+  }
+  (void)pthread_cond_signal(&HostCond);
+  (void)pthread_mutex_unlock(&HostLock);
+
+  return;
+}
+
+static void TL_HOST_AclDataAck( void )
+{
+  (void)pthread_mutex_lock(&HostLock);
+  AclDataAckNbr++;
+  (void)pthread_cond_signal(&HostCond);
+  (void)pthread_mutex_unlock(&HostLock);
+
+  return;
+}
+
+/**
+ * @brief Wait for a counter updated by the IPCC interrupt handlers to reach Count
+ */
+static void TL_HOST_WaitCount( volatile uint32_t *p_Count, uint32_t Count )
+{
+  (void)pthread_mutex_lock(&HostLock);
+  while(*p_Count < Count)
+  {
+    (void)pthread_cond_wait(&HostCond, &HostLock);
+  }
+  (void)pthread_mutex_unlock(&HostLock);
+
+  return;
+}
+
+static void TL_HOST_RunBleCmd( void )
+{
+  TL_EvtPacket_t *p_evt = (TL_EvtPacket_t*)&BleCmdBuffer;
+  uint8_t *p_cc;
+  uint32_t seq;
+
+  for(seq = 0; seq < PacketNbr; seq++)
+  {
+    BleCmdBuffer.cmdserial.cmd.cmdcode = TL_HOST_BLE_CMD_OPCODE;
+    BleCmdBuffer.cmdserial.cmd.plen = (uint8_t)PacketSize;
+    memset(BleCmdBuffer.cmdserial.cmd.payload, (int)seq, PacketSize);
+    TL_BLE_SendCmd(NULL, 0);
+
+    TL_HOST_WaitCount(&BleCmdEvtNbr, seq + 1U);
+
+    /* TL_CcEvt_t is not used as the command buffer is smaller: numcmd, cmdcode, status */
+    p_cc = p_evt->evtserial.evt.payload;
+    if((p_evt->evtserial.evt.evtcode != TL_BLEEVT_CC_OPCODE) ||
+       ((p_cc[1] | (p_cc[2] << 8)) != TL_HOST_BLE_CMD_OPCODE) || (p_cc[0] == 0U))
+    {
+      TL_HOST_Error("wrong command complete event", seq);
+    }
+  }
+
+  return;
+}
+
+static void TL_HOST_RunSysCmd( void )
+{
+  TL_EvtSerial_t *p_rsp = (TL_EvtSerial_t*)&SystemCmdBuffer;
+  TL_CcEvt_t *p_cc;
+  uint32_t seq;
+
+  for(seq = 0; seq < PacketNbr; seq++)
+  {
+    SystemCmdBuffer.cmdserial.cmd.cmdcode = TL_HOST_SYS_CMD_OPCODE;
+    SystemCmdBuffer.cmdserial.cmd.plen = (uint8_t)PacketSize;
+    memset(SystemCmdBuffer.cmdserial.cmd.payload, (int)seq, PacketSize);
+    TL_SYS_SendCmd(NULL, 0);
+
+    TL_HOST_WaitCount(&SysCmdEvtNbr, seq + 1U);
+
+    /* The response of a system command does not have the packet header */
+    p_cc = (TL_CcEvt_t*)p_rsp->evt.payload;
+    if((p_rsp->type != TL_SYSRSP_PKT_TYPE) || (p_cc->cmdcode != TL_HOST_SYS_CMD_OPCODE))
+    {
+      TL_HOST_Error("wrong command response", seq);
+    }
+  }
+
+  return;
+}
+
+static void TL_HOST_RunAcl( void )
+{
+  TL_AclDataPacket_t *p_acl = (TL_AclDataPacket_t*)HciAclDataBuffer;
+  uint32_t seq;
+
+  for(seq = 0; seq < PacketNbr; seq++)
+  {
+    p_acl->AclDataSerial.handle = 0x0001;
+    p_acl->AclDataSerial.length = (uint16_t)PacketSize;
+    memset(p_acl->AclDataSerial.acl_data, (int)seq, PacketSize);
+    TL_BLE_SendAclData(NULL, 0);
+
+    TL_HOST_WaitCount(&AclDataAckNbr, seq + 1U);
+  }
+
+  return;
+}
+
+static void TL_HOST_RunEvt( void )
+{
+  TL_EvtPacket_t *p_evt;
+  TL_AsynchEvt_t *p_asynch_evt;
+  uint32_t seq;
+  uint32_t evt_seq;
+
+  HW_IPCC_HOST_SendBleAsynchEvt(PacketNbr, TL_HOST_EVT_SUBEVTCODE, (uint8_t)PacketSize);
+
+  for(seq = 0; seq < PacketNbr; seq++)
+  {
+    if(BleEvtNbr <= seq)
+    {
+      /**
+       * Nothing left to process: the buffers still held are given back before waiting, as an application does
+       * once it gets idle, otherwise a batch larger than the pool would never be complete
+       */
+      TL_MM_FlushFreeBuf();
+      TL_HOST_WaitCount(&BleEvtNbr, seq + 1U);
+    }
+
+    LST_remove_head(&BleEvtQueue, (tListNode**)&p_evt);
+
+    p_asynch_evt = (TL_AsynchEvt_t*)p_evt->evtserial.evt.payload;
+    memcpy(&evt_seq, p_asynch_evt->payload, sizeof(evt_seq));
+    if((p_evt->evtserial.evt.evtcode != TL_BLEEVT_VS_OPCODE) || (p_asynch_evt->subevtcode != TL_HOST_EVT_SUBEVTCODE) ||
+       (p_evt->evtserial.evt.plen != (sizeof(uint16_t) + PacketSize)) || (evt_seq != seq))
+    {
+      TL_HOST_Error("wrong event", seq);
+    }
+
+    TL_MM_EvtDone(p_evt);
+  }
+
+  /* The buffers still held are given back so that the CPU2 gets idle */
+  TL_MM_FlushFreeBuf();
+
+  return;
+}
+
+static void TL_HOST_Error( const char *p_Msg, uint32_t Seq )
+{
+  if(ErrorNbr < TL_HOST_MAX_ERRORS)
+  {
+    printf("error: packet %u: %s\n", Seq, p_Msg);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static uint64_t TL_HOST_NowNs( clockid_t ClockId )
+{
+  struct timespec now;
+
+  (void)clock_gettime(ClockId, &now);
+
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static void TL_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s -m <ble_cmd|sys_cmd|acl|evt> [-n packets] [-s size (up to 255, %u for acl, %u..%u for evt)] "
+          "[-b release batch (0..255)] [-c csv]\n",
+          p_Name, TL_HOST_ACL_DATA_MAX_SIZE, TL_HOST_EVT_MIN_SIZE, TL_HOST_EVT_MAX_SIZE);
+  exit(2);
+}
@@ -0,0 +1,35 @@
+/**
+ ******************************************************************************
+ * @file    utilities_conf.h
+ * @author  MCD Application Team
+ * @brief   Configuration of the utilities for the Linux host build of the
+ *          transport layer
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The Linux host template is used as is. Its critical sections take the lock
+ * that plays the PRIMASK of the CPU1 in cmsis_compiler.h, so that the IPCC
+ * interrupt handlers executed by the CPU2 thread are masked by the sequencer
+ * as on target.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HCI_HOST_UTILITIES_CONF_H
+#define HCI_HOST_UTILITIES_CONF_H
+
+/* Includes ------------------------------------------------------------------*/
+#define UTILS_HostLock                          HW_IPCC_HOST_IrqLock
+#include "utilities_conf_host_template.h"
+
+#endif /*HCI_HOST_UTILITIES_CONF_H */
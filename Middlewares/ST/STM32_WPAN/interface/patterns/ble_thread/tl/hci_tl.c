@@ -22,6 +22,7 @@
 #include "ble_const.h"
 
 #include "stm_list.h"
+#include "stm_queue.h"
 #include "tl.h"
 #include "hci_tl.h"
 
@@ -32,6 +33,15 @@ typedef enum
   HCI_TL_CMD_RESP_WAIT,
 } HCI_TL_CmdRespStatus_t;
 
+/**
+ * Header of a command sent with hci_send_req_async(), followed by the command parameters
+ */
+typedef struct
+{
+  hci_cmd_cb_t cb;
+  uint16_t opcode;
+} HCI_TL_AsyncCmdHdr_t;
+
 /* Private defines -----------------------------------------------------------*/
 
 /**
@@ -39,6 +49,21 @@ typedef enum
  */
 #define HCI_TL_DEFAULT_TIMEOUT (33000)
 
+/**
+ * Size of the buffer holding the commands sent with hci_send_req_async() and not completed yet
+ */
+#ifndef HCI_TL_ASYNC_CMD_BUFFER_SIZE
+#define HCI_TL_ASYNC_CMD_BUFFER_SIZE (1024)
+#endif
+
+/**
+ * Time (hci_get_tick() unit) after which a command sent with hci_send_req_async() is reported in timeout, and
+ * after which the command credit is assumed to be given back when the controller did not give it
+ */
+#ifndef HCI_TL_ASYNC_CMD_TIMEOUT
+#define HCI_TL_ASYNC_CMD_TIMEOUT (HCI_TL_DEFAULT_TIMEOUT)
+#endif
+
 /* Private macros ------------------------------------------------------------*/
 /* Public variables ---------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -57,12 +82,23 @@ static tHciContext hciContext;
 static tListNode HciCmdEventQueue;
 static void (* StatusNotCallBackFunction) (HCI_TL_CmdStatus_t status);
 static volatile HCI_TL_CmdRespStatus_t CmdRspStatusFlag;
+static queue_t HciAsyncCmdQueue;
+static uint8_t HciAsyncCmdQueueBuffer[HCI_TL_ASYNC_CMD_BUFFER_SIZE];
+static volatile uint8_t HciAsyncCmdPending;
+static volatile uint8_t HciAsyncCmdInCallback;
+static volatile uint8_t HciBlockingCmdPending;
+static volatile uint8_t HciCmdCredit;
+static uint32_t HciAsyncCmdSendTime;
 
 /* Private function prototypes -----------------------------------------------*/
 static void NotifyCmdStatus(HCI_TL_CmdStatus_t hcicmdstatus);
 static void SendCmd(uint16_t opcode, uint8_t plen, void *param);
 static void TlEvtReceived(TL_EvtPacket_t *hcievt);
 static void TlInit( TL_CmdPacket_t * p_cmdbuffer );
+static void AsyncCmdSendNext( void );
+static void AsyncCmdProcessEvt( void );
+static void AsyncCmdCheckTimeout( void );
+static void AsyncCmdFlush( void );
 
 /* Interface ------- ---------------------------------------------------------*/
 void hci_init(void(* UserEvtRx)(void* pData), void* pConf)
@@ -78,9 +114,23 @@ void hci_init(void(* UserEvtRx)(void* pData), void* pConf)
 }
 
 void hci_user_evt_proc(void)
+{
+  hci_user_evt_proc_budget(1, 0);
+
+  return;
+}
+
+void hci_user_evt_proc_budget(uint32_t max_evt_nbr, uint32_t max_time)
 {
   TL_EvtPacket_t *phcievtbuffer;
   tHCI_UserEvtRxParam UserEvtRxParam;
+  uint32_t evt_nbr;
+  uint32_t start_time;
+
+  /**
+   * Report the responses of the commands sent with hci_send_req_async()
+   */
+  AsyncCmdProcessEvt();
 
   /**
    * Up to release version v1.2.0, a while loop was implemented to read out events from the queue as long as
@@ -90,6 +140,8 @@ void hci_user_evt_proc(void)
    * From now, the events are reported one by one. When it is checked there is still an event pending in the queue,
    * a request to the user is made to call again hci_user_evt_proc().
    * This gives the opportunity to the application to run other background tasks between each event.
+   * hci_user_evt_proc_budget() reports up to max_evt_nbr events and/or for up to max_time in a single call before
+   * the same request is made, which bounds the time the other tasks may wait.
    */
 
   /**
@@ -97,7 +149,15 @@ void hci_user_evt_proc(void)
    * in case the user overwrite the header where the next/prev pointers are located
    */
 
-  if((LST_is_empty(&HciAsynchEventQueue) == FALSE) && (UserEventFlow != HCI_TL_UserEventFlow_Disable))
+  start_time = (max_time != 0) ? hci_get_tick() : 0;
+  evt_nbr = 0;
+
+  /**
+   * The buffers released while reporting the events are given back to the CPU2 at once
+   */
+  TL_MM_StartBatch();
+
+  while((LST_is_empty(&HciAsynchEventQueue) == FALSE) && (UserEventFlow != HCI_TL_UserEventFlow_Disable))
   {
     LST_remove_head ( &HciAsynchEventQueue, (tListNode **)&phcievtbuffer );
 
@@ -124,8 +184,17 @@ void hci_user_evt_proc(void)
        */
       LST_insert_head ( &HciAsynchEventQueue, (tListNode *)phcievtbuffer );
     }
+
+    evt_nbr++;
+    if(((max_evt_nbr != 0) && (evt_nbr >= max_evt_nbr)) ||
+       ((max_time != 0) && ((hci_get_tick() - start_time) >= max_time)))
+    {
+      break;
+    }
   }
 
+  TL_MM_EndBatch();
+
   if((LST_is_empty(&HciAsynchEventQueue) == FALSE) && (UserEventFlow != HCI_TL_UserEventFlow_Disable))
   {
     hci_notify_asynch_evt((void*) &HciAsynchEventQueue);
@@ -150,7 +219,6 @@ void hci_resume_flow( void )
 
 int hci_send_req(struct hci_request *p_cmd, uint8_t async)
 {
-  (void)(async);
   uint16_t opcode;
   TL_CcEvt_t  *pcommand_complete_event;
   TL_CsEvt_t    *pcommand_status_event;
@@ -158,7 +226,27 @@ int hci_send_req(struct hci_request *p_cmd, uint8_t async)
   uint8_t hci_cmd_complete_return_parameters_length;
   HCI_TL_CmdStatus_t local_cmd_status;
 
+  if(async != FALSE)
+  {
+    /**
+     * The command is queued and its response is ignored
+     */
+    return hci_send_req_async(p_cmd, NULL);
+  }
+
   NotifyCmdStatus(HCI_TL_CmdBusy);
+
+  /**
+   * The command buffer is shared with the commands sent with hci_send_req_async() that are still pending
+   */
+  AsyncCmdFlush();
+
+  /**
+   * Until the response is received, hci_send_req_async() only queues the commands and the command events are
+   * not processed by hci_user_evt_proc()
+   */
+  HciBlockingCmdPending = TRUE;
+
   local_cmd_status = HCI_TL_CmdBusy;
   opcode = ((p_cmd->ocf) & 0x03ff) | ((p_cmd->ogf) << 10);
   SendCmd(opcode, p_cmd->clen, p_cmd->cparam);
@@ -182,6 +270,7 @@ int hci_send_req(struct hci_request *p_cmd, uint8_t async)
           *(uint8_t *)(p_cmd->rparam) = pcommand_status_event->status;
         }
 
+        HciCmdCredit = pcommand_status_event->numcmd;
         if(pcommand_status_event->numcmd != 0)
         {
           local_cmd_status = HCI_TL_CmdAvailable;
@@ -198,6 +287,7 @@ int hci_send_req(struct hci_request *p_cmd, uint8_t async)
           memcpy(p_cmd->rparam, pcommand_complete_event->payload, p_cmd->rlen);
         }
 
+        HciCmdCredit = pcommand_complete_event->numcmd;
         if(pcommand_complete_event->numcmd != 0)
         {
           local_cmd_status = HCI_TL_CmdAvailable;
@@ -206,12 +296,214 @@ int hci_send_req(struct hci_request *p_cmd, uint8_t async)
     }
   }
 
+  HciBlockingCmdPending = FALSE;
+
   NotifyCmdStatus(HCI_TL_CmdAvailable);
 
+  /**
+   * Send the commands queued by hci_send_req_async() while the command was pending
+   */
+  AsyncCmdSendNext();
+
+  return 0;
+}
+
+int hci_send_req_async(struct hci_request *p_cmd, hci_cmd_cb_t cb)
+{
+  HCI_TL_AsyncCmdHdr_t cmd_hdr;
+  uint8_t *p_elt;
+
+  /**
+   * The parameters are copied so that the caller may release them on return
+   */
+  p_elt = CircularQueue_Reserve(&HciAsyncCmdQueue, sizeof(HCI_TL_AsyncCmdHdr_t) + p_cmd->clen);
+  if(p_elt == NULL)
+  {
+    return -1;
+  }
+
+  cmd_hdr.cb = cb;
+  cmd_hdr.opcode = ((p_cmd->ocf) & 0x03ff) | ((p_cmd->ogf) << 10);
+  memcpy(p_elt, &cmd_hdr, sizeof(HCI_TL_AsyncCmdHdr_t));
+  memcpy(p_elt + sizeof(HCI_TL_AsyncCmdHdr_t), p_cmd->cparam, p_cmd->clen);
+  CircularQueue_Commit(&HciAsyncCmdQueue, sizeof(HCI_TL_AsyncCmdHdr_t) + p_cmd->clen);
+
+  /**
+   * From a callback, the command is sent once the callback has returned as the command buffer still holds the
+   * return parameters given to the callback
+   */
+  if(HciAsyncCmdInCallback == FALSE)
+  {
+    AsyncCmdCheckTimeout();
+    AsyncCmdSendNext();
+  }
+
   return 0;
 }
 
 /* Private functions ---------------------------------------------------------*/
+/**
+ * Send the first command of the asynchronous command queue
+ * The CPU2 writes the response of a command in the command buffer, so that only one command is sent at a time
+ * whatever the Num_HCI_Command_Packets credit given by the controller: the credit only allows to send the next
+ * command. hci_send_req_async() does not give a higher throughput than hci_send_req(), it lets the caller run
+ * while the command is processed.
+ * No command is sent while a command sent with hci_send_req() is pending or when the controller gave no credit
+ */
+static void AsyncCmdSendNext( void )
+{
+  HCI_TL_AsyncCmdHdr_t cmd_hdr;
+  uint8_t *p_elt;
+  uint16_t elt_size;
+
+  if((HciAsyncCmdPending != FALSE) || (HciBlockingCmdPending != FALSE) || (HciCmdCredit == 0))
+  {
+    return;
+  }
+
+  p_elt = CircularQueue_Peek(&HciAsyncCmdQueue, &elt_size);
+  if(p_elt != NULL)
+  {
+    memcpy(&cmd_hdr, p_elt, sizeof(HCI_TL_AsyncCmdHdr_t));
+    HciAsyncCmdPending = TRUE;
+    HciAsyncCmdSendTime = hci_get_tick();
+    SendCmd(cmd_hdr.opcode, elt_size - sizeof(HCI_TL_AsyncCmdHdr_t), p_elt + sizeof(HCI_TL_AsyncCmdHdr_t));
+  }
+
+  return;
+}
+
+/**
+ * Report the response of the pending asynchronous command and send the next one
+ */
+static void AsyncCmdProcessEvt( void )
+{
+  HCI_TL_AsyncCmdHdr_t cmd_hdr;
+  TL_EvtPacket_t *pevtpacket;
+  TL_CcEvt_t *pcommand_complete_event;
+  TL_CsEvt_t *pcommand_status_event;
+  const uint8_t *p_rparam;
+  uint8_t rlen;
+  uint16_t cmdcode;
+
+  /**
+   * The command events received while a command sent with hci_send_req() is pending are its own
+   */
+  if(HciBlockingCmdPending != FALSE)
+  {
+    return;
+  }
+
+  while(LST_is_empty(&HciCmdEventQueue) == FALSE)
+  {
+    LST_remove_head (&HciCmdEventQueue, (tListNode **)&pevtpacket);
+
+    if(pevtpacket->evtserial.evt.evtcode == TL_BLEEVT_CS_OPCODE)
+    {
+      pcommand_status_event = (TL_CsEvt_t*)pevtpacket->evtserial.evt.payload;
+      cmdcode = pcommand_status_event->cmdcode;
+      HciCmdCredit = pcommand_status_event->numcmd;
+      p_rparam = &pcommand_status_event->status;
+      rlen = 1;
+    }
+    else
+    {
+      pcommand_complete_event = (TL_CcEvt_t*)pevtpacket->evtserial.evt.payload;
+      cmdcode = pcommand_complete_event->cmdcode;
+      HciCmdCredit = pcommand_complete_event->numcmd;
+      p_rparam = pcommand_complete_event->payload;
+      rlen = pevtpacket->evtserial.evt.plen - TL_EVT_HDR_SIZE;
+    }
+
+    if(HciAsyncCmdPending == FALSE)
+    {
+      /**
+       * Not a response to a command, e.g. the command complete of HCI_NOP the controller sends to give back
+       * credits: only the credit is taken into account
+       */
+      continue;
+    }
+
+    memcpy(&cmd_hdr, CircularQueue_Peek(&HciAsyncCmdQueue, NULL), sizeof(HCI_TL_AsyncCmdHdr_t));
+
+    if(cmdcode != cmd_hdr.opcode)
+    {
+      /**
+       * Not the response of the pending command: its credit is taken into account and the response is still
+       * waited for, up to HCI_TL_ASYNC_CMD_TIMEOUT
+       */
+      continue;
+    }
+
+    /**
+     * The command is completed even when the controller gives no credit, the next one is then sent when a later
+     * command event gives a credit back
+     */
+    CircularQueue_Release(&HciAsyncCmdQueue);
+    HciAsyncCmdPending = FALSE;
+    if(cmd_hdr.cb != NULL)
+    {
+      HciAsyncCmdInCallback = TRUE;
+      cmd_hdr.cb(cmd_hdr.opcode, p_rparam, rlen);
+      HciAsyncCmdInCallback = FALSE;
+    }
+  }
+
+  AsyncCmdCheckTimeout();
+  AsyncCmdSendNext();
+
+  return;
+}
+
+/**
+ * Report in timeout the pending asynchronous command that got no response, and assume the credit is given back
+ * when the controller did not give it within HCI_TL_ASYNC_CMD_TIMEOUT
+ */
+static void AsyncCmdCheckTimeout( void )
+{
+  HCI_TL_AsyncCmdHdr_t cmd_hdr;
+  uint8_t status;
+
+  if(((HciAsyncCmdPending != FALSE) || (HciCmdCredit == 0)) &&
+     ((hci_get_tick() - HciAsyncCmdSendTime) >= HCI_TL_ASYNC_CMD_TIMEOUT))
+  {
+    HciCmdCredit = 1;
+
+    if(HciAsyncCmdPending != FALSE)
+    {
+      memcpy(&cmd_hdr, CircularQueue_Peek(&HciAsyncCmdQueue, NULL), sizeof(HCI_TL_AsyncCmdHdr_t));
+      CircularQueue_Release(&HciAsyncCmdQueue);
+      HciAsyncCmdPending = FALSE;
+      if(cmd_hdr.cb != NULL)
+      {
+        status = BLE_STATUS_TIMEOUT;
+        HciAsyncCmdInCallback = TRUE;
+        cmd_hdr.cb(cmd_hdr.opcode, &status, 1);
+        HciAsyncCmdInCallback = FALSE;
+      }
+    }
+  }
+
+  return;
+}
+
+/**
+ * Wait for all the asynchronous commands to be completed
+ */
+static void AsyncCmdFlush( void )
+{
+  AsyncCmdSendNext();
+
+  while((HciAsyncCmdPending != FALSE) || (CircularQueue_Empty(&HciAsyncCmdQueue) == FALSE))
+  {
+    hci_cmd_resp_wait(HCI_TL_DEFAULT_TIMEOUT);
+
+    AsyncCmdProcessEvt();
+  }
+
+  return;
+}
+
 static void TlInit( TL_CmdPacket_t * p_cmdbuffer )
 {
   TL_BLE_InitConf_t Conf;
@@ -221,6 +513,12 @@ static void TlInit( TL_CmdPacket_t * p_cmdbuffer )
    */
   LST_init_head (&HciCmdEventQueue);
 
+  CircularQueue_Init(&HciAsyncCmdQueue, HciAsyncCmdQueueBuffer, HCI_TL_ASYNC_CMD_BUFFER_SIZE, 0, CIRCULAR_QUEUE_NO_FLAG);
+  HciAsyncCmdPending = FALSE;
+  HciAsyncCmdInCallback = FALSE;
+  HciBlockingCmdPending = FALSE;
+  HciCmdCredit = 1;
+
   pCmdBuffer = p_cmdbuffer;
 
   LST_init_head (&HciAsynchEventQueue);
@@ -276,6 +574,11 @@ static void TlEvtReceived(TL_EvtPacket_t *hcievt)
   {
     LST_insert_tail(&HciCmdEventQueue, (tListNode *)hcievt);
     hci_cmd_resp_release(0); /**< Notify the application a full Cmd Event has been received */
+
+    if(HciBlockingCmdPending == FALSE)
+    {
+      hci_notify_asynch_evt((void*) &HciAsynchEventQueue); /**< The response is reported from hci_user_evt_proc() */
+    }
   }
   else
   {
@@ -287,6 +590,11 @@ static void TlEvtReceived(TL_EvtPacket_t *hcievt)
 }
 
 /* Weak implementation ----------------------------------------------------------------*/
+__WEAK uint32_t hci_get_tick(void)
+{
+  return 0;
+}
+
 __WEAK void hci_cmd_resp_wait(uint32_t timeout)
 {
   (void)timeout;
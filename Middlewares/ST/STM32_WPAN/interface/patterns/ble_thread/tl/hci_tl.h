@@ -137,6 +137,17 @@ void hci_cmd_resp_wait(uint32_t timeout);
  */
 void hci_cmd_resp_release(uint32_t flag);
 
+/**
+ * @brief  This function returns the time base used by the time budget of hci_user_evt_proc_budget().
+ *         A weak implementation is available in hci_tl.c that always returns 0, the time budget is then never
+ *         reached and only the number of events bounds hci_user_evt_proc_budget().
+ *         The user may re-implement this function in the application (e.g. with HAL_GetTick()).
+ *
+ * @param  None
+ * @retval Time base in the unit of the max_time parameter of hci_user_evt_proc_budget()
+ */
+uint32_t hci_get_tick(void);
+
 
 
 /**
@@ -160,6 +171,21 @@ void hci_cmd_resp_release(uint32_t flag);
 
 void hci_user_evt_proc(void);
 
+/**
+ * @brief  This process may be called instead of hci_user_evt_proc() to report several events per call.
+ *         It reports the pending events until either max_evt_nbr events have been reported or max_time has elapsed
+ *         (measured with hci_get_tick()), then requests to be called again with hci_notify_asynch_evt() when events
+ *         are still pending, so that the other tasks still run between two bursts.
+ *         The event buffers released during the call are given back to the CPU2 with a single IPCC transaction.
+ *         hci_user_evt_proc() is the same as hci_user_evt_proc_budget(1, 0).
+ *
+ * @param  max_evt_nbr: Maximum number of events reported - 0 for no limit
+ * @param  max_time: Maximum time spent reporting the events - 0 for no limit
+ *         At least one event is reported, the time is checked after each event
+ * @retval None
+ */
+void hci_user_evt_proc_budget(uint32_t max_evt_nbr, uint32_t max_time);
+
 /**
  * END OF SECTION - PROCESS TO BE CALLED BY THE SCHEDULER
  *********************************************************************************************************************
@@ -182,6 +182,29 @@ typedef struct
   uint32_t TracesEvtPoolSize;
 } TL_MM_Config_t;
 
+/**
+ * Batched release of the event buffers to the CPU2
+ * The released buffers are kept in a local queue and sent to the CPU2 with a single IPCC transaction when
+ * one of the thresholds is reached, when a spare buffer is released or when TL_MM_FlushFreeBuf() is called
+ * Between TL_MM_StartBatch() and TL_MM_EndBatch(), the thresholds are only checked on TL_MM_EndBatch() so that
+ * the buffers released while processing a burst of events are sent at once
+ * The time threshold requires CFG_TL_MM_HELD_TIMER set to 1 in app_conf.h: a single shot timer of the timer
+ * server, created on the first call of TL_MM_SetBatchConfig() with a time threshold, is started when a buffer
+ * is held and sends the buffers held from the timer server interrupt handler on its expiry
+ */
+typedef struct
+{
+  uint8_t  MaxBufNbr;           /**< Number of released buffers to send at once - 0 or 1 to disable the batching */
+  uint32_t MaxHeldSize;         /**< Size (bytes) of the released buffers to send at once - 0 for no size threshold */
+  uint32_t MaxHeldTime;         /**< Time (timer server ticks) a released buffer may be held - 0 for no time threshold */
+} TL_MM_BatchConfig_t;
+
+typedef struct
+{
+  uint32_t ReleasedBufNbr;      /**< Number of buffers released with TL_MM_EvtDone() */
+  uint32_t SendFreeBufNbr;      /**< Number of IPCC transactions requested to send the released buffers */
+} TL_MM_Stats_t;
+
 typedef struct
 {
   uint8_t *p_ThreadOtCmdRspBuffer;
@@ -301,6 +324,12 @@ void TL_BLE_LLD_SendRspAck( void );
  ******************************************************************************/
 void TL_MM_Init( TL_MM_Config_t *p_Config );
 void TL_MM_EvtDone( TL_EvtPacket_t * hcievt );
+void TL_MM_SetBatchConfig( TL_MM_BatchConfig_t *p_Config );
+void TL_MM_StartBatch( void );
+void TL_MM_EndBatch( void );
+void TL_MM_FlushFreeBuf( void );
+void TL_MM_GetStats( TL_MM_Stats_t *p_Stats );
+void TL_MM_ResetStats( void );
 
 /******************************************************************************
  * TRACES
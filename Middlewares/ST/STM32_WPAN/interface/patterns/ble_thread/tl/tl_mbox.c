@@ -25,6 +25,14 @@
 #include "mbox_def.h"
 #include "tl_dbg_conf.h"
 
+#ifndef CFG_TL_MM_HELD_TIMER
+#define CFG_TL_MM_HELD_TIMER    0
+#endif
+
+#if (CFG_TL_MM_HELD_TIMER != 0)
+#include "hw_if.h"
+#endif
+
 /* Private typedef -----------------------------------------------------------*/
 typedef enum
 {
@@ -63,6 +71,16 @@ PLACE_IN_SECTION("MB_MEM1") ALIGN(4) static tListNode  SystemEvtQueue;
 
 
 static tListNode  LocalFreeBufQueue;
+static TL_MM_BatchConfig_t MM_BatchConfig;
+static uint32_t MM_HeldBufNbr;
+static uint32_t MM_HeldSize;
+static uint8_t MM_BatchNest;
+#if (CFG_TL_MM_HELD_TIMER != 0)
+static uint8_t MM_HeldTimerId;
+static uint8_t MM_HeldTimerCreated;
+static uint8_t MM_HeldTimerRunning;
+#endif
+static TL_MM_Stats_t MM_Stats;
 static void (* BLE_IoBusEvtCallBackFunction) (TL_EvtPacket_t *phcievt);
 static void (* BLE_IoBusAclDataTxAck) ( void );
 static void (* SYS_CMD_IoBusCallBackFunction) (TL_EvtPacket_t *phcievt);
@@ -71,7 +89,24 @@ static void (* SYS_EVT_IoBusCallBackFunction) (TL_EvtPacket_t *phcievt);
 
 /* Global variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+#if (CFG_TL_MM_HELD_TIMER != 0)
+/**
+ * Called from the timer server interrupt handler when the first buffer held has been kept MaxHeldTime
+ */
+static void MM_HeldTimerExpired( void )
+{
+  MM_HeldTimerRunning = 0;
+  TL_MM_FlushFreeBuf( );
+
+  return;
+}
+#endif
+
 static void SendFreeBuf( void );
+static uint8_t MM_BatchThresholdReached( void );
+#if (CFG_TL_MM_HELD_TIMER != 0)
+static void MM_HeldTimerExpired( void );
+#endif
 static void OutputDbgTrace(TL_MB_PacketType_t packet_type, uint8_t* buffer);
 
 /* Public Functions Definition ------------------------------------------------------*/
@@ -595,6 +630,15 @@ void TL_MM_Init( TL_MM_Config_t *p_Config )
   LST_init_head (&FreeBufQueue);
   LST_init_head (&LocalFreeBufQueue);
 
+  MM_BatchConfig.MaxBufNbr = 0;
+  MM_BatchConfig.MaxHeldSize = 0;
+  MM_HeldBufNbr = 0;
+  MM_HeldSize = 0;
+  MM_BatchNest = 0;
+#if (CFG_TL_MM_HELD_TIMER != 0)
+  MM_HeldTimerRunning = 0;
+#endif
+
   p_mem_manager_table = TL_RefTable.p_mem_manager_table;
 
   p_mem_manager_table->blepool = p_Config->p_AsynchEvtPool;
@@ -610,15 +654,163 @@ void TL_MM_Init( TL_MM_Config_t *p_Config )
 
 void TL_MM_EvtDone(TL_EvtPacket_t * phcievt)
 {
-  LST_insert_tail(&LocalFreeBufQueue, (tListNode *)phcievt);
+  uint32_t primask_bit;
+  uint8_t flush;
+#if (CFG_TL_MM_HELD_TIMER != 0)
+  uint8_t start_timer;
+#endif
 
   OutputDbgTrace(TL_MB_MM_RELEASE_BUFFER, (uint8_t*)phcievt);
 
-  HW_IPCC_MM_SendFreeBuf( SendFreeBuf );
+  /**
+   * The counters of the held buffers are updated in the same critical section as the queue as they may be
+   * reset by TL_MM_FlushFreeBuf() from the timer server interrupt handler
+   * The size shall be read before the buffer is inserted in the queue as it may be given back to the CPU2
+   * from the IPCC interrupt handler as soon as it is inserted
+   */
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+  MM_HeldSize += sizeof(TL_PacketHeader_t) + TL_EVT_HDR_SIZE + phcievt->evtserial.evt.plen;
+  MM_HeldBufNbr++;
+  MM_Stats.ReleasedBufNbr++;
+
+  /**
+   * The spare buffers are used by the CPU2 when its pool is exhausted, the released buffers are then
+   * sent immediately, even within TL_MM_StartBatch()/TL_MM_EndBatch()
+   */
+  flush = ( ( MM_BatchNest == 0 ) && ( MM_BatchThresholdReached( ) != FALSE ) ) ||
+          ( (uint8_t*)phcievt == TL_RefTable.p_mem_manager_table->spare_ble_buffer ) ||
+          ( (uint8_t*)phcievt == TL_RefTable.p_mem_manager_table->spare_sys_buffer );
+
+  LST_insert_tail(&LocalFreeBufQueue, (tListNode *)phcievt);
+
+#if (CFG_TL_MM_HELD_TIMER != 0)
+  /**
+   * The timer is started by the first buffer held, the buffers released after it are sent earlier
+   */
+  start_timer = ( flush == FALSE ) && ( MM_BatchConfig.MaxHeldTime != 0 ) && ( MM_HeldTimerRunning == 0 );
+  if( start_timer != FALSE )
+  {
+    MM_HeldTimerRunning = 1;
+  }
+#endif
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+
+#if (CFG_TL_MM_HELD_TIMER != 0)
+  if( start_timer != FALSE )
+  {
+    HW_TS_Start( MM_HeldTimerId, MM_BatchConfig.MaxHeldTime );
+  }
+#endif
+
+  if( flush != FALSE )
+  {
+    TL_MM_FlushFreeBuf( );
+  }
 
   return;
 }
 
+void TL_MM_SetBatchConfig( TL_MM_BatchConfig_t *p_Config )
+{
+  MM_BatchConfig = *p_Config;
+
+#if (CFG_TL_MM_HELD_TIMER != 0)
+  if( ( MM_BatchConfig.MaxHeldTime != 0 ) && ( MM_HeldTimerCreated == 0 ) )
+  {
+    (void)HW_TS_Create( CFG_TIM_PROC_ID_ISR, &MM_HeldTimerId, hw_ts_SingleShot, MM_HeldTimerExpired );
+    MM_HeldTimerCreated = 1;
+  }
+#endif
+
+  /**
+   * Send the buffers already held in case the thresholds have been lowered
+   */
+  TL_MM_FlushFreeBuf( );
+
+  return;
+}
+
+void TL_MM_StartBatch( void )
+{
+  MM_BatchNest++;
+
+  return;
+}
+
+void TL_MM_EndBatch( void )
+{
+  uint32_t primask_bit;
+  uint8_t flush;
+
+  if( MM_BatchNest != 0 )
+  {
+    MM_BatchNest--;
+  }
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+  flush = ( MM_BatchNest == 0 ) && ( MM_BatchThresholdReached( ) != FALSE );
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+
+  if( flush != FALSE )
+  {
+    TL_MM_FlushFreeBuf( );
+  }
+
+  return;
+}
+
+void TL_MM_FlushFreeBuf( void )
+{
+  uint32_t primask_bit;
+  uint32_t held_buf_nbr;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+  held_buf_nbr = MM_HeldBufNbr;
+  if( held_buf_nbr != 0 )
+  {
+    MM_HeldBufNbr = 0;
+    MM_HeldSize = 0;
+    MM_Stats.SendFreeBufNbr++;
+  }
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+
+  if( held_buf_nbr != 0 )
+  {
+    HW_IPCC_MM_SendFreeBuf( SendFreeBuf );
+  }
+
+  return;
+}
+
+void TL_MM_GetStats( TL_MM_Stats_t *p_Stats )
+{
+  *p_Stats = MM_Stats;
+
+  return;
+}
+
+void TL_MM_ResetStats( void )
+{
+  MM_Stats.ReleasedBufNbr = 0;
+  MM_Stats.SendFreeBufNbr = 0;
+
+  return;
+}
+
+static uint8_t MM_BatchThresholdReached( void )
+{
+  return ( ( MM_HeldBufNbr != 0 ) &&
+           ( ( MM_HeldBufNbr >= MM_BatchConfig.MaxBufNbr ) ||
+             ( ( MM_BatchConfig.MaxHeldSize != 0 ) && ( MM_HeldSize >= MM_BatchConfig.MaxHeldSize ) ) ) );
+}
+
 static void SendFreeBuf( void )
 {
   tListNode *p_node;
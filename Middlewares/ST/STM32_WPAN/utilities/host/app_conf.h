@@ -0,0 +1,29 @@
+/**
+ ******************************************************************************
+ * @file    app_conf.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the application configuration for the Linux host
+ *          build of the WPAN utilities
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * stm_queue.c does not depend on the application configuration. The critical
+ * sections of the callers of CircularQueue_xxx() are emulated by queue_host.c.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_CONF_H
+#define APP_CONF_H
+
+#endif /*APP_CONF_H */
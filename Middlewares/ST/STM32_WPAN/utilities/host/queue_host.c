@@ -0,0 +1,672 @@
+/**
+ ******************************************************************************
+ * @file    queue_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host stress test and benchmark of the queues of stm_queue.c
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2018-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * A producer thread sends <elements> elements of random size, from 4 bytes to
+ * <max size>, to a consumer thread. The bytes sent form a stream where the
+ * value of each byte depends on its offset, and each element starts with its
+ * sequence number: the consumer checks the order, the size and the content of
+ * everything it receives.
+ *
+ *   -m spsc     SPSCQueue_Add() / SPSCQueue_Remove_Copy(), no lock
+ *   -m spsc_zc  SPSCQueue_Reserve() of up to 8 bytes more than the element,
+ *               built in place, SPSCQueue_Commit() of its actual size /
+ *               SPSCQueue_Peek(), checked in place, SPSCQueue_Release()
+ *   -m circ     CircularQueue_Add() / CircularQueue_Sense(), copy,
+ *               CircularQueue_Remove(), each call in a critical section as in
+ *               dbg_trace.c (CIRCULAR_QUEUE_SPLIT_IF_WRAPPING_FLAG). The
+ *               PRIMASK is emulated by a spin lock. The elements split at the
+ *               end of the buffer are checked as part of the byte stream.
+ *               CircularQueue_Add() keeps the part of an element that fits at
+ *               the end of the buffer on 8 bits when it checks for room: the
+ *               elements are limited to 255 bytes in this mode, larger ones
+ *               end up overflowing the queue.
+ *   -m circ_zc  CircularQueue_Reserve() of up to 8 bytes more than the
+ *               element, built in place, CircularQueue_Commit() of its actual
+ *               size / CircularQueue_Peek(), checked in place,
+ *               CircularQueue_Release(), each call in a critical section. The
+ *               queue has no option: an element that does not fit at the end
+ *               of the buffer is reserved at its beginning and the end of the
+ *               buffer is skipped with a marker, which the consumer shall
+ *               step over. As the consumer thread often empties the queue,
+ *               which restarts it at the beginning of the buffer, a single
+ *               thread first fills the queue and drains it by half, 10000
+ *               elements in a row, to force the reservations past the end of
+ *               the buffer. The run fails if none of them wrapped this way.
+ *
+ * When the queue is full (producer) or empty (consumer), the thread yields.
+ * The throughput is the number of elements received per second.
+ *
+ * Usage: queue_host -m <spsc|spsc_zc|circ|circ_zc> [-n elements] [-s max size] [-q queue size] [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utilities_common.h"
+#include "stm_queue.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define QUEUE_HOST_MIN_SIZE             (4U)
+#define QUEUE_HOST_MAX_SIZE             (1024U)
+#define QUEUE_HOST_CIRC_MAX_SIZE        (255U)
+#define QUEUE_HOST_RESERVE_EXTRA        (8U)
+#define QUEUE_HOST_MAX_ERRORS           (10U)
+#define QUEUE_HOST_WRAP_ELEMENTS        (10000U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  QUEUE_HOST_MODE_SPSC,
+  QUEUE_HOST_MODE_SPSC_ZC,
+  QUEUE_HOST_MODE_CIRC,
+  QUEUE_HOST_MODE_CIRC_ZC,
+} QUEUE_HOST_Mode_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *ModeName[] = { "spsc", "spsc_zc", "circ", "circ_zc" };
+
+static QUEUE_HOST_Mode_t Mode = QUEUE_HOST_MODE_SPSC;
+static uint32_t ElementNbr = 1000000U;
+static uint32_t MaxSize = 64U;
+static uint32_t QueueSize = 1024U;
+static const char *CsvFile;
+
+static uint32_t *p_QueueBuffer;
+static spsc_queue_t SpscQueue;
+static queue_t CircQueue;
+static pthread_spinlock_t CircLock;
+
+static uint32_t FullNbr;
+static uint32_t EmptyNbr;
+static uint32_t ErrorNbr;
+static uint64_t ByteNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t QUEUE_HOST_NextSize( uint32_t *p_Seed );
+static uint8_t QUEUE_HOST_StreamByte( uint64_t Offset );
+static void QUEUE_HOST_Fill( uint8_t *p_Dst, uint32_t Seq, uint32_t Size, uint64_t Offset );
+static void QUEUE_HOST_Check( const uint8_t *p_Src, uint32_t Seq, uint32_t Size, uint64_t Offset );
+static void QUEUE_HOST_Error( const char *p_Msg, uint32_t Seq );
+static void *QUEUE_HOST_Producer( void *p_Arg );
+static void QUEUE_HOST_ConsumeSpsc( void );
+static void QUEUE_HOST_ConsumeCirc( void );
+static void QUEUE_HOST_ConsumeCircZc( void );
+static void QUEUE_HOST_WrapCircZc( void );
+static void QUEUE_HOST_CheckCircZc( const uint8_t *p_Elt, uint16_t EltSize, uint32_t Seq, uint32_t Size,
+                                    uint64_t Offset );
+/**
+ * @brief Fill the queue and drain it by half from a single thread, so that it is never empty and the
+ *        reservations go past the end of the buffer
+ */
+static void QUEUE_HOST_WrapCircZc( void )
+{
+  uint32_t prod_seed = 0x12345678U;
+  uint32_t cons_seed = 0x12345678U;
+  uint64_t prod_offset = 0;
+  uint64_t cons_offset = 0;
+  uint32_t prod_seq = 0;
+  uint32_t cons_seq = 0;
+  uint32_t size = 0;
+  uint32_t skip_nbr = 0;
+  uint16_t elt_size;
+  uint8_t *p_elt;
+
+  (void)CircularQueue_Init(&CircQueue, (uint8_t*)p_QueueBuffer, QueueSize, 0, 0);
+
+  while(cons_seq < QUEUE_HOST_WRAP_ELEMENTS)
+  {
+    /* Fill the queue */
+    while(prod_seq < QUEUE_HOST_WRAP_ELEMENTS)
+    {
+      if(size == 0U)
+      {
+        size = QUEUE_HOST_NextSize(&prod_seed);
+      }
+      p_elt = CircularQueue_Reserve(&CircQueue, (uint16_t)(size + (prod_seq % QUEUE_HOST_RESERVE_EXTRA)));
+      if(p_elt == NULL)
+      {
+        break;
+      }
+      if(CircQueue.reserveSkip != 0U)
+      {
+        skip_nbr++;
+      }
+      QUEUE_HOST_Fill(p_elt, prod_seq, size, prod_offset);
+      CircularQueue_Commit(&CircQueue, (uint16_t)size);
+      prod_offset += size;
+      prod_seq++;
+      size = 0;
+    }
+
+    /* Drain it by half, the last element is always consumed */
+    while((cons_seq < prod_seq) &&
+          ((CircQueue.byteCount > (QueueSize / 2U)) || (prod_seq == QUEUE_HOST_WRAP_ELEMENTS)))
+    {
+      p_elt = CircularQueue_Peek(&CircQueue, &elt_size);
+      if(p_elt == NULL)
+      {
+        QUEUE_HOST_Error("element lost", cons_seq);
+        return;
+      }
+      QUEUE_HOST_CheckCircZc(p_elt, elt_size, cons_seq, QUEUE_HOST_NextSize(&cons_seed), cons_offset);
+      if(ErrorNbr != 0U)
+      {
+        /* Releasing a wrong element would corrupt the queue */
+        return;
+      }
+      CircularQueue_Release(&CircQueue);
+      cons_offset += elt_size;
+      cons_seq++;
+    }
+  }
+
+  if(CircularQueue_Empty(&CircQueue) == FALSE)
+  {
+    QUEUE_HOST_Error("queue not empty after the wrap test", cons_seq);
+  }
+  printf("%-7s wrap test: %u elements, %u reserved past the end of the buffer\n",
+         ModeName[Mode], cons_seq, skip_nbr);
+  if(skip_nbr == 0U)
+  {
+    QUEUE_HOST_Error("no element reserved past the end of the buffer", cons_seq);
+  }
+
+  return;
+}
+
+/**
+ * @brief Check an element received in place: contiguous in the buffer, never the skip marker
+ */
+static void QUEUE_HOST_CheckCircZc( const uint8_t *p_Elt, uint16_t EltSize, uint32_t Seq, uint32_t Size,
+                                    uint64_t Offset )
+{
+  if((p_Elt < (uint8_t*)p_QueueBuffer) || ((p_Elt + EltSize) > ((uint8_t*)p_QueueBuffer + QueueSize)))
+  {
+    QUEUE_HOST_Error("element not contiguous in the buffer", Seq);
+  }
+  else if(EltSize != Size)
+  {
+    QUEUE_HOST_Error("wrong size", Seq);
+  }
+  else
+  {
+    QUEUE_HOST_Check(p_Elt, Seq, Size, Offset);
+  }
+
+  return;
+}
+
+/**
+ * @brief Receive the elements in place, the skip marker at the end of the buffer shall never be returned
+ */
+static void QUEUE_HOST_ConsumeCircZc( void )
+{
+  uint32_t seed = 0x12345678U;
+  uint32_t size;
+  uint32_t seq;
+  uint16_t elt_size;
+  uint8_t *p_elt;
+
+  for(seq = 0; seq < ElementNbr; seq++)
+  {
+    size = QUEUE_HOST_NextSize(&seed);
+
+    for(;;)
+    {
+      (void)pthread_spin_lock(&CircLock);
+      p_elt = CircularQueue_Peek(&CircQueue, &elt_size);
+      (void)pthread_spin_unlock(&CircLock);
+      if(p_elt != NULL)
+      {
+        break;
+      }
+      EmptyNbr++;
+      (void)sched_yield();
+    }
+
+    QUEUE_HOST_CheckCircZc(p_elt, elt_size, seq, size, ByteNbr);
+
+    (void)pthread_spin_lock(&CircLock);
+    CircularQueue_Release(&CircQueue);
+    (void)pthread_spin_unlock(&CircLock);
+    ByteNbr += size;
+  }
+
+  if(CircularQueue_Empty(&CircQueue) == FALSE)
+  {
+    QUEUE_HOST_Error("queue not empty at the end", ElementNbr);
+  }
+
+  return;
+}
+
+static uint64_t QUEUE_HOST_NowNs( void );
+static void QUEUE_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  pthread_t producer;
+  uint64_t start_time;
+  uint64_t elapsed_time;
+  double elt_rate;
+  double byte_rate;
+  FILE *p_csv;
+  int opt;
+  uint32_t mode;
+
+  while((opt = getopt(argc, argv, "m:n:s:q:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'm':
+        for(mode = 0; mode < (sizeof(ModeName) / sizeof(ModeName[0])); mode++)
+        {
+          if(strcmp(optarg, ModeName[mode]) == 0)
+          {
+            break;
+          }
+        }
+        if(mode == (sizeof(ModeName) / sizeof(ModeName[0])))
+        {
+          QUEUE_HOST_Usage(argv[0]);
+        }
+        Mode = (QUEUE_HOST_Mode_t)mode;
+        break;
+
+      case 'n':
+        ElementNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 's':
+        MaxSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'q':
+        QueueSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        QUEUE_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  if((MaxSize < QUEUE_HOST_MIN_SIZE) || (MaxSize > QUEUE_HOST_MAX_SIZE) || ((QueueSize & 3U) != 0U) ||
+     (QueueSize < (2U * (MaxSize + QUEUE_HOST_RESERVE_EXTRA + 8U))) ||
+     ((Mode == QUEUE_HOST_MODE_CIRC) && (MaxSize > QUEUE_HOST_CIRC_MAX_SIZE)))
+  {
+    QUEUE_HOST_Usage(argv[0]);
+  }
+
+  p_QueueBuffer = malloc(QueueSize);
+  if(Mode == QUEUE_HOST_MODE_CIRC)
+  {
+    (void)pthread_spin_init(&CircLock, PTHREAD_PROCESS_PRIVATE);
+    (void)CircularQueue_Init(&CircQueue, (uint8_t*)p_QueueBuffer, QueueSize, 0, CIRCULAR_QUEUE_SPLIT_IF_WRAPPING_FLAG);
+  }
+  else if(Mode == QUEUE_HOST_MODE_CIRC_ZC)
+  {
+    QUEUE_HOST_WrapCircZc();
+    if(ErrorNbr != 0U)
+    {
+      free(p_QueueBuffer);
+      return 1;
+    }
+    (void)pthread_spin_init(&CircLock, PTHREAD_PROCESS_PRIVATE);
+    (void)CircularQueue_Init(&CircQueue, (uint8_t*)p_QueueBuffer, QueueSize, 0, 0);
+  }
+  else
+  {
+    (void)SPSCQueue_Init(&SpscQueue, (uint8_t*)p_QueueBuffer, QueueSize);
+  }
+
+  start_time = QUEUE_HOST_NowNs();
+  (void)pthread_create(&producer, NULL, QUEUE_HOST_Producer, NULL);
+  if(Mode == QUEUE_HOST_MODE_CIRC)
+  {
+    QUEUE_HOST_ConsumeCirc();
+  }
+  else if(Mode == QUEUE_HOST_MODE_CIRC_ZC)
+  {
+    QUEUE_HOST_ConsumeCircZc();
+  }
+  else
+  {
+    QUEUE_HOST_ConsumeSpsc();
+  }
+  (void)pthread_join(producer, NULL);
+  elapsed_time = QUEUE_HOST_NowNs() - start_time;
+
+  elt_rate = (double)ElementNbr * 1e9 / (double)elapsed_time;
+  byte_rate = (double)ByteNbr * 1e3 / (double)elapsed_time;
+  printf("%-7s max size %4u queue %5u: %u elements %llu bytes, %.0f elements/s %.1f MB/s, full %u empty %u, %u errors\n",
+         ModeName[Mode], MaxSize, QueueSize, ElementNbr, (unsigned long long)ByteNbr, elt_rate, byte_rate,
+         FullNbr, EmptyNbr, ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "mode,max_size,queue_size,elements,bytes,elements_per_s,mb_per_s,full,empty,errors\n");
+      }
+      fprintf(p_csv, "%s,%u,%u,%u,%llu,%.0f,%.1f,%u,%u,%u\n", ModeName[Mode], MaxSize, QueueSize, ElementNbr,
+              (unsigned long long)ByteNbr, elt_rate, byte_rate, FullNbr, EmptyNbr, ErrorNbr);
+      fclose(p_csv);
+    }
+  }
+
+  free(p_QueueBuffer);
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief Size of the next element, the producer and the consumer draw the same sequence
+ */
+static uint32_t QUEUE_HOST_NextSize( uint32_t *p_Seed )
+{
+  uint32_t x = *p_Seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *p_Seed = x;
+
+  return QUEUE_HOST_MIN_SIZE + (x % (MaxSize - QUEUE_HOST_MIN_SIZE + 1U));
+}
+
+static uint8_t QUEUE_HOST_StreamByte( uint64_t Offset )
+{
+  return (uint8_t)((Offset * 131U) ^ (Offset >> 8));
+}
+
+/**
+ * @brief Build an element: sequence number, then the bytes of the stream
+ */
+static void QUEUE_HOST_Fill( uint8_t *p_Dst, uint32_t Seq, uint32_t Size, uint64_t Offset )
+{
+  uint32_t i;
+
+  memcpy(p_Dst, &Seq, sizeof(Seq));
+  for(i = sizeof(Seq); i < Size; i++)
+  {
+    p_Dst[i] = QUEUE_HOST_StreamByte(Offset + i);
+  }
+
+  return;
+}
+
+static void QUEUE_HOST_Check( const uint8_t *p_Src, uint32_t Seq, uint32_t Size, uint64_t Offset )
+{
+  uint32_t seq;
+  uint32_t i;
+
+  memcpy(&seq, p_Src, sizeof(seq));
+  if(seq != Seq)
+  {
+    QUEUE_HOST_Error("wrong sequence number", Seq);
+    return;
+  }
+  for(i = sizeof(seq); i < Size; i++)
+  {
+    if(p_Src[i] != QUEUE_HOST_StreamByte(Offset + i))
+    {
+      QUEUE_HOST_Error("corrupted content", Seq);
+      return;
+    }
+  }
+
+  return;
+}
+
+static void QUEUE_HOST_Error( const char *p_Msg, uint32_t Seq )
+{
+  if(ErrorNbr < QUEUE_HOST_MAX_ERRORS)
+  {
+    printf("error: element %u: %s\n", Seq, p_Msg);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static void *QUEUE_HOST_Producer( void *p_Arg )
+{
+  uint8_t element[QUEUE_HOST_MAX_SIZE];
+  uint32_t seed = 0x12345678U;
+  uint64_t offset = 0;
+  uint32_t size;
+  uint32_t seq;
+  uint8_t *p_elt;
+
+  (void)p_Arg;
+
+  for(seq = 0; seq < ElementNbr; seq++)
+  {
+    size = QUEUE_HOST_NextSize(&seed);
+
+    switch(Mode)
+    {
+      case QUEUE_HOST_MODE_SPSC:
+        QUEUE_HOST_Fill(element, seq, size, offset);
+        while(SPSCQueue_Add(&SpscQueue, element, (uint16_t)size) == NULL)
+        {
+          FullNbr++;
+          (void)sched_yield();
+        }
+        break;
+
+      case QUEUE_HOST_MODE_SPSC_ZC:
+        while((p_elt = SPSCQueue_Reserve(&SpscQueue, (uint16_t)(size + (seq % QUEUE_HOST_RESERVE_EXTRA)))) == NULL)
+        {
+          FullNbr++;
+          (void)sched_yield();
+        }
+        QUEUE_HOST_Fill(p_elt, seq, size, offset);
+        SPSCQueue_Commit(&SpscQueue, (uint16_t)size);
+        break;
+
+      case QUEUE_HOST_MODE_CIRC_ZC:
+        for(;;)
+        {
+          (void)pthread_spin_lock(&CircLock);
+          p_elt = CircularQueue_Reserve(&CircQueue, (uint16_t)(size + (seq % QUEUE_HOST_RESERVE_EXTRA)));
+          (void)pthread_spin_unlock(&CircLock);
+          if(p_elt != NULL)
+          {
+            break;
+          }
+          FullNbr++;
+          (void)sched_yield();
+        }
+        /* The reserved room is not visible to the consumer before the commit */
+        QUEUE_HOST_Fill(p_elt, seq, size, offset);
+        (void)pthread_spin_lock(&CircLock);
+        CircularQueue_Commit(&CircQueue, (uint16_t)size);
+        (void)pthread_spin_unlock(&CircLock);
+        break;
+
+      default:
+        QUEUE_HOST_Fill(element, seq, size, offset);
+        for(;;)
+        {
+          (void)pthread_spin_lock(&CircLock);
+          p_elt = CircularQueue_Add(&CircQueue, element, (uint16_t)size, 1);
+          (void)pthread_spin_unlock(&CircLock);
+          if(p_elt != NULL)
+          {
+            break;
+          }
+          FullNbr++;
+          (void)sched_yield();
+        }
+        break;
+    }
+
+    offset += size;
+  }
+
+  return NULL;
+}
+
+static void QUEUE_HOST_ConsumeSpsc( void )
+{
+  uint8_t element[QUEUE_HOST_MAX_SIZE];
+  uint32_t seed = 0x12345678U;
+  uint32_t size;
+  uint32_t seq;
+  uint16_t elt_size;
+  uint8_t *p_elt;
+
+  for(seq = 0; seq < ElementNbr; seq++)
+  {
+    size = QUEUE_HOST_NextSize(&seed);
+
+    if(Mode == QUEUE_HOST_MODE_SPSC)
+    {
+      while(SPSCQueue_Remove_Copy(&SpscQueue, &elt_size, element) == NULL)
+      {
+        EmptyNbr++;
+        (void)sched_yield();
+      }
+      p_elt = element;
+    }
+    else
+    {
+      while((p_elt = SPSCQueue_Peek(&SpscQueue, &elt_size)) == NULL)
+      {
+        EmptyNbr++;
+        (void)sched_yield();
+      }
+    }
+
+    if(elt_size != size)
+    {
+      QUEUE_HOST_Error("wrong size", seq);
+    }
+    else
+    {
+      QUEUE_HOST_Check(p_elt, seq, size, ByteNbr);
+    }
+
+    if(Mode == QUEUE_HOST_MODE_SPSC_ZC)
+    {
+      SPSCQueue_Release(&SpscQueue);
+    }
+    ByteNbr += size;
+  }
+
+  if(SPSCQueue_Empty(&SpscQueue) == FALSE)
+  {
+    QUEUE_HOST_Error("queue not empty at the end", ElementNbr);
+  }
+
+  return;
+}
+
+/**
+ * @brief Receive the elements as dbg_trace.c does, an element split at the end of the buffer comes in two parts
+ */
+static void QUEUE_HOST_ConsumeCirc( void )
+{
+  uint8_t element[QUEUE_HOST_MAX_SIZE];
+  uint32_t seed = 0x12345678U;
+  uint32_t size = 0;
+  uint32_t received = 0;
+  uint32_t seq = 0;
+  uint16_t part_size;
+  uint8_t *p_part;
+
+  while(seq < ElementNbr)
+  {
+    if(received == 0U)
+    {
+      size = QUEUE_HOST_NextSize(&seed);
+    }
+
+    for(;;)
+    {
+      (void)pthread_spin_lock(&CircLock);
+      p_part = CircularQueue_Sense(&CircQueue, &part_size);
+      (void)pthread_spin_unlock(&CircLock);
+      if(p_part != NULL)
+      {
+        break;
+      }
+      EmptyNbr++;
+      (void)sched_yield();
+    }
+
+    if((received + part_size) > size)
+    {
+      QUEUE_HOST_Error("wrong size", seq);
+      part_size = (uint16_t)(size - received);
+    }
+    memcpy(&element[received], p_part, part_size);
+    received += part_size;
+
+    (void)pthread_spin_lock(&CircLock);
+    (void)CircularQueue_Remove(&CircQueue, NULL);
+    (void)pthread_spin_unlock(&CircLock);
+
+    if(received == size)
+    {
+      QUEUE_HOST_Check(element, seq, size, ByteNbr);
+      ByteNbr += size;
+      received = 0;
+      seq++;
+    }
+  }
+
+  if(CircularQueue_Empty(&CircQueue) == FALSE)
+  {
+    QUEUE_HOST_Error("queue not empty at the end", ElementNbr);
+  }
+
+  return;
+}
+
+static uint64_t QUEUE_HOST_NowNs( void )
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static void QUEUE_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s -m <spsc|spsc_zc|circ|circ_zc> [-n elements] [-s max size (%u..%u, %u in circ mode)] "
+          "[-q queue size, multiple of 4, at least twice the max size + %u] [-c csv]\n",
+          p_Name, QUEUE_HOST_MIN_SIZE, QUEUE_HOST_MAX_SIZE, QUEUE_HOST_CIRC_MAX_SIZE, QUEUE_HOST_RESERVE_EXTRA + 8U);
+  exit(2);
+}
@@ -24,10 +24,29 @@
 #include "stm_queue.h"
 
 /* Private define ------------------------------------------------------------*/
+/* Size of the header holding the element size in the SPSC queue */
+#define SPSC_HEADER_SIZE      4U
+/* Header value telling the rest of the buffer is unused, next element is at the beginning */
+#define SPSC_WRAP_MARKER      0xFFFFFFFFU
+/* No wrap marker to be written on commit */
+#define SPSC_NO_MARKER        0xFFFFFFFFU
+
 /* Private typedef -------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 #define MOD(X,Y) (((X) >= (Y)) ? ((X)-(Y)) : (X))
 
+/* Room taken in the SPSC queue by an element, header included, rounded to 4 bytes */
+#define SPSC_ROOM(SIZE) ((((uint32_t)(SIZE)) + SPSC_HEADER_SIZE + 3U) & ~3U)
+
+/* Memory barrier ordering the accesses to the queue buffer and to the head/tail indexes */
+#if defined(__CORTEX_M)
+#define SPSC_MEMORY_BARRIER()   __DMB()
+#elif defined(__GNUC__)
+#define SPSC_MEMORY_BARRIER()   __sync_synchronize()
+#else
+#error "SPSC_MEMORY_BARRIER() shall be defined for this target"
+#endif
+
 /* Private variables ---------------------------------------------------------*/
 /* Global variables ----------------------------------------------------------*/
 /* Extern variables ----------------------------------------------------------*/
@@ -54,6 +73,8 @@ int CircularQueue_Init(queue_t *q, uint8_t* queueBuffer, uint32_t queueSize, uin
   q->queueMaxSize = queueSize;
   q->elementSize = elementSize;
   q->optionFlags = optionFlags;
+  q->reservePos = 0;
+  q->reserveSkip = 0;
 
    if ((optionFlags & CIRCULAR_QUEUE_SPLIT_IF_WRAPPING_FLAG) && q-> elementSize)
    {
@@ -267,18 +288,17 @@ uint8_t* CircularQueue_Remove(queue_t *q, uint16_t* elementSize)
     /* retreive element Size */
     eltSize = (q->elementSize == 0) ? q->qBuff[q->first] + ((q->qBuff[MOD((q->first+1), q->queueMaxSize)])<<8) : q->elementSize;
 
-     if ((q->optionFlags & CIRCULAR_QUEUE_NO_WRAP_FLAG) && !(q->optionFlags & CIRCULAR_QUEUE_SPLIT_IF_WRAPPING_FLAG))
+     /* a 0xFFFF size is the skip marker written by CIRCULAR_QUEUE_NO_WRAP_FLAG option or by CircularQueue_Commit */
+     if (((eltSize == 0xFFFF) && q->elementSize == 0 ) ||
+         ((q->optionFlags & CIRCULAR_QUEUE_NO_WRAP_FLAG) && !(q->optionFlags & CIRCULAR_QUEUE_SPLIT_IF_WRAPPING_FLAG) &&
+          (q->first > q->last) && q->elementSize && ((q->queueMaxSize - q->first) < q->elementSize)))
      {
-       if (((eltSize == 0xFFFF) && q->elementSize == 0 ) ||
-           ((q->first > q->last) && q->elementSize && ((q->queueMaxSize - q->first) < q->elementSize))) 
-       {
-          /* all data from current position up to the end of buffer are invalid */
-          q->byteCount -= (q->queueMaxSize - q->first);
-          /* Adjust first element pos */
-          q->first = 0;
-          /* retrieve the rigth size after the wrap [if varaible size element] */
-          eltSize = (q->elementSize == 0) ? q->qBuff[q->first] + ((q->qBuff[MOD((q->first+1), q->queueMaxSize)])<<8) : q->elementSize;
-       }
+        /* all data from current position up to the end of buffer are invalid */
+        q->byteCount -= (q->queueMaxSize - q->first);
+        /* Adjust first element pos */
+        q->first = 0;
+        /* retrieve the rigth size after the wrap [if varaible size element] */
+        eltSize = (q->elementSize == 0) ? q->qBuff[q->first] + ((q->qBuff[MOD((q->first+1), q->queueMaxSize)])<<8) : q->elementSize;
      }
 
     /* retreive element */
@@ -338,19 +358,17 @@ uint8_t* CircularQueue_Sense(queue_t *q, uint16_t* elementSize)
     FirstElemetPos = q->first;
     eltSize = (q->elementSize == 0) ? q->qBuff[q->first] + ((q->qBuff[MOD((q->first+1), q->queueMaxSize)])<<8) : q->elementSize;
     
-    if ((q->optionFlags & CIRCULAR_QUEUE_NO_WRAP_FLAG) && !(q->optionFlags & CIRCULAR_QUEUE_SPLIT_IF_WRAPPING_FLAG))
-    { 
-      if (((eltSize == 0xFFFF) && q->elementSize == 0 ) ||
-          ((q->first > q->last) && q->elementSize && ((q->queueMaxSize - q->first) < q->elementSize))) 
-
-      {
-        /* all data from current position up to the end of buffer are invalid */
-        FirstElemetPos = 0; /* wrap to the begiining of buffer */
+    /* a 0xFFFF size is the skip marker written by CIRCULAR_QUEUE_NO_WRAP_FLAG option or by CircularQueue_Commit */
+    if (((eltSize == 0xFFFF) && q->elementSize == 0 ) ||
+        ((q->optionFlags & CIRCULAR_QUEUE_NO_WRAP_FLAG) && !(q->optionFlags & CIRCULAR_QUEUE_SPLIT_IF_WRAPPING_FLAG) &&
+         (q->first > q->last) && q->elementSize && ((q->queueMaxSize - q->first) < q->elementSize)))
+    {
+      /* all data from current position up to the end of buffer are invalid */
+      FirstElemetPos = 0; /* wrap to the begiining of buffer */
 
-        /* retrieve the rigth size after the wrap [if varaible size element] */
-        eltSize = (q->elementSize == 0) ? q->qBuff[FirstElemetPos]+ ((q->qBuff[MOD((FirstElemetPos+1), q->queueMaxSize)])<<8) : q->elementSize;
-      }
-   }
+      /* retrieve the rigth size after the wrap [if varaible size element] */
+      eltSize = (q->elementSize == 0) ? q->qBuff[FirstElemetPos]+ ((q->qBuff[MOD((FirstElemetPos+1), q->queueMaxSize)])<<8) : q->elementSize;
+    }
    /* retrieve element */
     x = q->qBuff + (MOD((FirstElemetPos + elemSizeStorageRoom), q->queueMaxSize));
   }
@@ -381,3 +399,346 @@ int CircularQueue_NbElement(queue_t *q)
 {
   return q->elementCount;
 }
+
+/**
+  * @brief  Reserve room for a variable size element at the end of the queue.
+  * @note   The room returned is contiguous in the queue buffer so that the element can be formatted in place,
+  *         avoiding the copy done by CircularQueue_Add(). When the element does not fit at the end of the buffer,
+  *         it is placed at the beginning and the end of the buffer is skipped (0xFFFF size marker).
+  *         The element is only part of the queue after CircularQueue_Commit(). No other element shall be added
+  *         in between. Elements may be removed in between (e.g. from an interrupt handler).
+  * @param  q: pointer on queue structure to be handled (variable size elements only)
+  * @param  elementSize: maximum size of the element
+  * @retval pointer on the room reserved, NULL if there is not enough contiguous room in the queue
+  */
+uint8_t* CircularQueue_Reserve(queue_t *q, uint16_t elementSize)
+{
+  uint32_t pos;           /* position of the header of the element */
+  uint32_t dataPos;       /* position of the data of the element */
+  uint32_t first;
+  uint16_t curElementSize;
+
+  if ((q->elementSize != 0) || (elementSize == 0) || (elementSize == 0xFFFF))
+  {
+    /* only variable size elements can be reserved */
+    return NULL;
+  }
+
+  q->reserveSkip = 0;
+  if (q->byteCount == 0)
+  {
+    /* queue empty: the whole buffer can be used */
+    pos = 0;
+    if ((uint32_t)elementSize + 2 > q->queueMaxSize)
+    {
+      return NULL;
+    }
+  }
+  else
+  {
+    first = q->first;
+    curElementSize = q->qBuff[q->last] + ((q->qBuff[MOD((q->last+1), q->queueMaxSize)])<<8) + 2;
+    pos = MOD((q->last + curElementSize), q->queueMaxSize);
+    dataPos = MOD((pos + 2), q->queueMaxSize);
+
+    if (pos < first)
+    {
+      /* free room is between last and first element */
+      if ((pos + elementSize + 2) > first)
+      {
+        return NULL;
+      }
+    }
+    else if (pos == first)
+    {
+      /* queue full */
+      return NULL;
+    }
+    else if (dataPos < pos)
+    {
+      /* header at the end of the buffer, data at the beginning */
+      if ((dataPos + elementSize) > first)
+      {
+        return NULL;
+      }
+    }
+    else if ((pos + elementSize + 2) > q->queueMaxSize)
+    {
+      /* not enough room at the end of the buffer: skip it */
+      if (((uint32_t)elementSize + 2) > first)
+      {
+        return NULL;
+      }
+      q->reserveSkip = q->queueMaxSize - pos;
+      pos = 0;
+    }
+  }
+
+  q->reservePos = pos;
+  return &q->qBuff[MOD((pos + 2), q->queueMaxSize)];
+}
+
+/**
+  * @brief  Add to the queue the element reserved with CircularQueue_Reserve().
+  * @param  q: pointer on queue structure to be handled
+  * @param  elementSize: actual size of the element, lower or equal to the size reserved
+  * @retval None
+  */
+void CircularQueue_Commit(queue_t *q, uint16_t elementSize)
+{
+  uint32_t pos = q->reservePos;
+
+  if (q->reserveSkip)
+  {
+    /* invalidate end of buffer */
+    q->qBuff[q->queueMaxSize - q->reserveSkip] = 0xFF;
+    q->qBuff[q->queueMaxSize - q->reserveSkip + 1] = 0xFF;
+  }
+  q->qBuff[pos] = elementSize & 0xFF;
+  q->qBuff[MOD((pos+1), q->queueMaxSize)] = (elementSize & 0xFF00) >> 8;
+
+  if (q->byteCount == 0)
+  {
+    /* the queue has been emptied since the reservation, skipped bytes are not part of it */
+    q->first = pos;
+  }
+  else
+  {
+    /* invalid data at the end of buffer are take into account in byteCount */
+    q->byteCount += q->reserveSkip;
+  }
+  q->reserveSkip = 0;
+  q->byteCount += elementSize + 2;
+  q->last = pos;
+  q->elementCount++;
+}
+
+/**
+  * @brief  Return the first element of the queue without removing it.
+  * @note   The element stays valid in the queue buffer until CircularQueue_Release() is called,
+  *         so that it can be processed in place (e.g. sent by DMA) without being copied.
+  * @param  q: pointer on queue structure to be handled
+  * @param  elementSize: Pointer to return Size of the element (ignored if NULL)
+  * @retval Pointer on the element. NULL if queue was empty
+  */
+uint8_t* CircularQueue_Peek(queue_t *q, uint16_t* elementSize)
+{
+  return CircularQueue_Sense(q, elementSize);
+}
+
+/**
+  * @brief  Remove from the queue the element returned by CircularQueue_Peek().
+  * @param  q: pointer on queue structure to be handled
+  * @retval None
+  */
+void CircularQueue_Release(queue_t *q)
+{
+  (void)CircularQueue_Remove(q, NULL);
+}
+
+/**
+  * @brief  Initialize a single producer / single consumer queue.
+  * @note   The producer shall only use SPSCQueue_Reserve/Commit/Add and the consumer
+  *         SPSCQueue_Peek/Release/Remove_Copy/Empty. No critical section is then required
+  *         even if they run in different contexts (e.g. interrupt handler and thread).
+  * @param  q: pointer on queue structure to be initialised
+  * @param  queueBuffer: pointer on Queue Buffer, 4 bytes aligned
+  * @param  queueSize: Size of Queue Buffer, multiple of 4
+  * @retval 0 if succesfull, -1 if the buffer is not aligned
+  */
+int SPSCQueue_Init(spsc_queue_t *q, uint8_t* queueBuffer, uint32_t queueSize)
+{
+  q->qBuff = queueBuffer;
+  q->queueMaxSize = queueSize;
+  q->head = 0;
+  q->tail = 0;
+  q->reservePos = 0;
+  q->reserveMarkerPos = SPSC_NO_MARKER;
+  q->peekPos = 0;
+
+  if ((((uintptr_t)queueBuffer) & 3U) || (queueSize & 3U))
+  {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Reserve room for an element at the end of the queue (producer side).
+  * @note   The room returned is contiguous in the queue buffer so that the element can be built in place.
+  *         When it does not fit at the end of the buffer, the element is placed at the beginning and the
+  *         end of the buffer is skipped. The element is only visible to the consumer after SPSCQueue_Commit().
+  * @param  q: pointer on queue structure to be handled
+  * @param  elementSize: maximum size of the element
+  * @retval pointer on the room reserved, NULL if the queue is full
+  */
+uint8_t* SPSCQueue_Reserve(spsc_queue_t *q, uint16_t elementSize)
+{
+  uint32_t room = SPSC_ROOM(elementSize);
+  uint32_t head = q->head;
+  uint32_t tail = q->tail;
+
+  /* the queue is never filled completely so that head == tail means empty */
+  if (head >= tail)
+  {
+    if ((q->queueMaxSize - head) > room)
+    {
+      q->reserveMarkerPos = SPSC_NO_MARKER;
+    }
+    else if (((q->queueMaxSize - head) == room) && (tail != 0))
+    {
+      q->reserveMarkerPos = SPSC_NO_MARKER;
+    }
+    else if (tail > room)
+    {
+      /* wrap: the end of the buffer will be skipped */
+      q->reserveMarkerPos = head;
+      head = 0;
+    }
+    else
+    {
+      return NULL;
+    }
+  }
+  else if ((tail - head) > room)
+  {
+    q->reserveMarkerPos = SPSC_NO_MARKER;
+  }
+  else
+  {
+    return NULL;
+  }
+
+  q->reservePos = head;
+  return &q->qBuff[head + SPSC_HEADER_SIZE];
+}
+
+/**
+  * @brief  Make the element reserved with SPSCQueue_Reserve() visible to the consumer (producer side).
+  * @param  q: pointer on queue structure to be handled
+  * @param  elementSize: actual size of the element, lower or equal to the size reserved
+  * @retval None
+  */
+void SPSCQueue_Commit(spsc_queue_t *q, uint16_t elementSize)
+{
+  uint32_t head;
+
+  *(uint32_t*)&q->qBuff[q->reservePos] = elementSize;
+  if (q->reserveMarkerPos != SPSC_NO_MARKER)
+  {
+    *(uint32_t*)&q->qBuff[q->reserveMarkerPos] = SPSC_WRAP_MARKER;
+  }
+
+  head = MOD(q->reservePos + SPSC_ROOM(elementSize), q->queueMaxSize);
+
+  /* the element shall be written before it is published */
+  SPSC_MEMORY_BARRIER();
+  q->head = head;
+}
+
+/**
+  * @brief  Copy an element at the end of the queue (producer side).
+  * @param  q: pointer on queue structure to be handled
+  * @param  x: pointer on element to be added
+  * @param  elementSize: Size of element to be added
+  * @retval pointer on the element in the queue, NULL if the queue is full
+  */
+uint8_t* SPSCQueue_Add(spsc_queue_t *q, uint8_t* x, uint16_t elementSize)
+{
+  uint8_t* ptr = SPSCQueue_Reserve(q, elementSize);
+
+  if (ptr != NULL)
+  {
+    memcpy(ptr, x, elementSize);
+    SPSCQueue_Commit(q, elementSize);
+  }
+  return ptr;
+}
+
+/**
+  * @brief  Return the first element of the queue without removing it (consumer side).
+  * @note   The element stays valid in the queue buffer until SPSCQueue_Release() is called,
+  *         so that it can be processed in place (e.g. sent by DMA).
+  * @param  q: pointer on queue structure to be handled
+  * @param  elementSize: Pointer to return Size of the element (ignored if NULL)
+  * @retval pointer on the element, NULL if the queue is empty
+  */
+uint8_t* SPSCQueue_Peek(spsc_queue_t *q, uint16_t* elementSize)
+{
+  uint32_t tail = q->tail;
+  uint32_t eltSize;
+
+  if (tail == q->head)
+  {
+    return NULL;
+  }
+  /* the element shall not be read before head has been read */
+  SPSC_MEMORY_BARRIER();
+
+  eltSize = *(uint32_t*)&q->qBuff[tail];
+  if (eltSize == SPSC_WRAP_MARKER)
+  {
+    /* end of buffer skipped by the producer */
+    tail = 0;
+    eltSize = *(uint32_t*)&q->qBuff[tail];
+  }
+
+  q->peekPos = tail;
+  if (elementSize != NULL)
+  {
+    *elementSize = (uint16_t)eltSize;
+  }
+  return &q->qBuff[tail + SPSC_HEADER_SIZE];
+}
+
+/**
+  * @brief  Remove from the queue the element returned by SPSCQueue_Peek() (consumer side).
+  * @param  q: pointer on queue structure to be handled
+  * @retval None
+  */
+void SPSCQueue_Release(spsc_queue_t *q)
+{
+  uint32_t tail;
+
+  tail = MOD(q->peekPos + SPSC_ROOM(*(uint32_t*)&q->qBuff[q->peekPos]), q->queueMaxSize);
+
+  /* the element shall be read before its room is given back to the producer */
+  SPSC_MEMORY_BARRIER();
+  q->tail = tail;
+}
+
+/**
+  * @brief  Remove the first element of the queue and copy it in provided buffer (consumer side).
+  * @param  q: pointer on queue structure to be handled
+  * @param  elementSize: Pointer to return Size of the element removed (ignored if NULL)
+  * @param  buffer: destination buffer where to copy element
+  * @retval pointer on buffer, NULL if the queue was empty
+  */
+uint8_t* SPSCQueue_Remove_Copy(spsc_queue_t *q, uint16_t* elementSize, uint8_t* buffer)
+{
+  uint16_t eltSize;
+  uint8_t* ptr = SPSCQueue_Peek(q, &eltSize);
+
+  if (ptr == NULL)
+  {
+    return NULL;
+  }
+  memcpy(buffer, ptr, eltSize);
+  SPSCQueue_Release(q);
+
+  if (elementSize != NULL)
+  {
+    *elementSize = eltSize;
+  }
+  return buffer;
+}
+
+/**
+  * @brief  Check if the queue is empty (consumer side).
+  * @param  q: pointer on queue structure to be handled
+  * @retval TRUE (!0) if the queue is empty otherwise FALSE (0)
+  */
+int SPSCQueue_Empty(spsc_queue_t *q)
+{
+  return (q->tail == q->head) ? TRUE : FALSE;
+}
@@ -40,8 +40,23 @@ typedef struct {
    uint32_t byteCount;      /* number of bytes in the queue */
    uint32_t elementCount;   /* number of element in the queue */
    uint8_t  optionFlags;     /* option to enable specific features */
+   uint32_t reservePos;     /* position of the element reserved by CircularQueue_Reserve */
+   uint32_t reserveSkip;    /* number of bytes skipped at the end of buffer by the reserved element */
 } queue_t;
 
+/* Lock-free single producer / single consumer queue of variable size elements.
+   head is only written by the producer and tail only by the consumer so that
+   no critical section is needed when they run in different contexts (ISR / thread) */
+typedef struct {
+   uint8_t* qBuff;                /* queue buffer, provided by init fct (4 bytes aligned) */
+   uint32_t queueMaxSize;         /* size of the queue, provided by init fct (in bytes, multiple of 4) */
+   volatile uint32_t head;        /* position where next element is written (producer) */
+   volatile uint32_t tail;        /* position of first element (consumer) */
+   uint32_t reservePos;           /* position of the element reserved by the producer */
+   uint32_t reserveMarkerPos;     /* position of the wrap marker to write on commit (producer) */
+   uint32_t peekPos;              /* position of the element peeked by the consumer */
+} spsc_queue_t;
+
 /* Exported constants --------------------------------------------------------*/
 
 /* Exported macro ------------------------------------------------------------*/
@@ -54,6 +69,19 @@ int CircularQueue_Empty(queue_t *q);
 int CircularQueue_NbElement(queue_t *q);
 uint8_t* CircularQueue_Remove_Copy(queue_t *q, uint16_t* elementSize, uint8_t* buffer);
 uint8_t* CircularQueue_Sense_Copy(queue_t *q, uint16_t* elementSize, uint8_t* buffer);
+uint8_t* CircularQueue_Reserve(queue_t *q, uint16_t elementSize);
+void CircularQueue_Commit(queue_t *q, uint16_t elementSize);
+uint8_t* CircularQueue_Peek(queue_t *q, uint16_t* elementSize);
+void CircularQueue_Release(queue_t *q);
+
+int SPSCQueue_Init(spsc_queue_t *q, uint8_t* queueBuffer, uint32_t queueSize);
+uint8_t* SPSCQueue_Reserve(spsc_queue_t *q, uint16_t elementSize);
+void SPSCQueue_Commit(spsc_queue_t *q, uint16_t elementSize);
+uint8_t* SPSCQueue_Add(spsc_queue_t *q, uint8_t* x, uint16_t elementSize);
+uint8_t* SPSCQueue_Peek(spsc_queue_t *q, uint16_t* elementSize);
+void SPSCQueue_Release(spsc_queue_t *q);
+uint8_t* SPSCQueue_Remove_Copy(spsc_queue_t *q, uint16_t* elementSize, uint8_t* buffer);
+int SPSCQueue_Empty(spsc_queue_t *q);
 
 
 #endif /* __STM_QUEUE_H */
@@ -941,6 +941,28 @@ typedef struct TX_QUEUE_STRUCT
 } TX_QUEUE;
 
 
+/* Define the buffer queue structure utilized by the application.  A buffer
+   queue passes block pool buffers between threads without copying them: the
+   message is the buffer pointer, the receiver gets the buffer the sender had.
+   Buffers still queued when the buffer queue is flushed or deleted are
+   released to their block pool.  */
+
+typedef struct TX_BUFFER_QUEUE_STRUCT
+{
+
+    /* Define the queue that carries the buffer pointers.  */
+    TX_QUEUE            tx_buffer_queue_queue;
+
+} TX_BUFFER_QUEUE;
+
+
+/* Define the size of a buffer queue message in ULONGs, the storage of a
+   buffer queue holds queue_size/(TX_BUFFER_QUEUE_MESSAGE_SIZE*sizeof(ULONG))
+   buffers.  */
+
+#define TX_BUFFER_QUEUE_MESSAGE_SIZE    ((UINT) ((sizeof(VOID *) + sizeof(ULONG) - 1)/sizeof(ULONG)))
+
+
 /* Define the semaphore structure utilized by the application.  */
 
 typedef struct TX_SEMAPHORE_STRUCT
@@ -1025,6 +1047,12 @@ typedef struct TX_SEMAPHORE_STRUCT
 #define tx_block_pool_prioritize                    _tx_block_pool_prioritize
 #define tx_block_release                            _tx_block_release
 
+#define tx_buffer_queue_create                      _tx_buffer_queue_create
+#define tx_buffer_queue_delete                      _tx_buffer_queue_delete
+#define tx_buffer_queue_flush                       _tx_buffer_queue_flush
+#define tx_buffer_queue_receive                     _tx_buffer_queue_receive
+#define tx_buffer_queue_send                        _tx_buffer_queue_send
+
 #define tx_byte_allocate                            _tx_byte_allocate
 #define tx_byte_pool_create                         _tx_byte_pool_create
 #define tx_byte_pool_delete                         _tx_byte_pool_delete
@@ -1148,6 +1176,12 @@ UINT    _tx_trace_interrupt_control(UINT new_posture);
 #define tx_block_pool_prioritize                    _txr_block_pool_prioritize
 #define tx_block_release                            _txr_block_release
 
+#define tx_buffer_queue_create(b,n,s,l)             _txe_buffer_queue_create((b),(n),(s),(l),(sizeof(TX_BUFFER_QUEUE)))
+#define tx_buffer_queue_delete                      _txe_buffer_queue_delete
+#define tx_buffer_queue_flush                       _txe_buffer_queue_flush
+#define tx_buffer_queue_receive                     _txe_buffer_queue_receive
+#define tx_buffer_queue_send                        _txe_buffer_queue_send
+
 #define tx_byte_allocate                            _txr_byte_allocate
 #define tx_byte_pool_create(p,n,s,l)                _txr_byte_pool_create((p),(n),(s),(l),(sizeof(TX_BYTE_POOL)))
 #define tx_byte_pool_delete                         _txr_byte_pool_delete
@@ -1260,6 +1294,12 @@ UINT    _tx_trace_interrupt_control(UINT new_posture);
 #define tx_block_pool_prioritize                    _txe_block_pool_prioritize
 #define tx_block_release                            _txe_block_release
 
+#define tx_buffer_queue_create(b,n,s,l)             _txe_buffer_queue_create((b),(n),(s),(l),(sizeof(TX_BUFFER_QUEUE)))
+#define tx_buffer_queue_delete                      _txe_buffer_queue_delete
+#define tx_buffer_queue_flush                       _txe_buffer_queue_flush
+#define tx_buffer_queue_receive                     _txe_buffer_queue_receive
+#define tx_buffer_queue_send                        _txe_buffer_queue_send
+
 #define tx_byte_allocate                            _txe_byte_allocate
 #define tx_byte_pool_create(p,n,s,l)                _txe_byte_pool_create((p),(n),(s),(l),(sizeof(TX_BYTE_POOL)))
 #define tx_byte_pool_delete                         _txe_byte_pool_delete
@@ -1416,6 +1456,27 @@ UINT        _txr_block_release(VOID *block_ptr);
 #endif
 
 
+/* Define buffer queue management function prototypes.  */
+
+UINT        _tx_buffer_queue_create(TX_BUFFER_QUEUE *buffer_queue_ptr, CHAR *name_ptr,
+                    VOID *queue_start, ULONG queue_size);
+UINT        _tx_buffer_queue_delete(TX_BUFFER_QUEUE *buffer_queue_ptr);
+UINT        _tx_buffer_queue_flush(TX_BUFFER_QUEUE *buffer_queue_ptr);
+UINT        _tx_buffer_queue_receive(TX_BUFFER_QUEUE *buffer_queue_ptr, VOID **buffer_ptr, ULONG wait_option);
+UINT        _tx_buffer_queue_send(TX_BUFFER_QUEUE *buffer_queue_ptr, VOID *buffer_ptr, ULONG wait_option);
+
+
+/* Define error checking shells for API services.  These are only referenced by the
+   application.  */
+
+UINT        _txe_buffer_queue_create(TX_BUFFER_QUEUE *buffer_queue_ptr, CHAR *name_ptr,
+                    VOID *queue_start, ULONG queue_size, UINT buffer_queue_control_block_size);
+UINT        _txe_buffer_queue_delete(TX_BUFFER_QUEUE *buffer_queue_ptr);
+UINT        _txe_buffer_queue_flush(TX_BUFFER_QUEUE *buffer_queue_ptr);
+UINT        _txe_buffer_queue_receive(TX_BUFFER_QUEUE *buffer_queue_ptr, VOID **buffer_ptr, ULONG wait_option);
+UINT        _txe_buffer_queue_send(TX_BUFFER_QUEUE *buffer_queue_ptr, VOID *buffer_ptr, ULONG wait_option);
+
+
 /* Define byte memory pool management function prototypes.  */
 
 UINT        _tx_byte_allocate(TX_BYTE_POOL *pool_ptr, VOID **memory_ptr, ULONG memory_size,
@@ -1553,7 +1614,7 @@ UINT        _txr_mutex_put(TX_MUTEX *mutex_ptr);
 /* Define queue management function prototypes.  */
 
 UINT        _tx_queue_create(TX_QUEUE *queue_ptr, CHAR *name_ptr, UINT message_size,
-                        VOID *queue_start, ULONG queue_size);
+                    VOID *queue_start, ULONG queue_size);
 UINT        _tx_queue_delete(TX_QUEUE *queue_ptr);
 UINT        _tx_queue_flush(TX_QUEUE *queue_ptr);
 UINT        _tx_queue_info_get(TX_QUEUE *queue_ptr, CHAR **name, ULONG *enqueued, ULONG *available_storage,
@@ -1573,7 +1634,7 @@ UINT        _tx_queue_front_send(TX_QUEUE *queue_ptr, VOID *source_ptr, ULONG wa
    application.  */
 
 UINT        _txe_queue_create(TX_QUEUE *queue_ptr, CHAR *name_ptr, UINT message_size,
-                        VOID *queue_start, ULONG queue_size, UINT queue_control_block_size);
+                    VOID *queue_start, ULONG queue_size, UINT queue_control_block_size);
 UINT        _txe_queue_delete(TX_QUEUE *queue_ptr);
 UINT        _txe_queue_flush(TX_QUEUE *queue_ptr);
 UINT        _txe_queue_info_get(TX_QUEUE *queue_ptr, CHAR **name, ULONG *enqueued, ULONG *available_storage,
@@ -1585,7 +1646,7 @@ UINT        _txe_queue_send_notify(TX_QUEUE *queue_ptr, VOID (*queue_send_notify
 UINT        _txe_queue_front_send(TX_QUEUE *queue_ptr, VOID *source_ptr, ULONG wait_option);
 #ifdef TX_ENABLE_MULTI_ERROR_CHECKING
 UINT        _txr_queue_create(TX_QUEUE *queue_ptr, CHAR *name_ptr, UINT message_size,
-                        VOID *queue_start, ULONG queue_size, UINT queue_control_block_size);
+                    VOID *queue_start, ULONG queue_size, UINT queue_control_block_size);
 UINT        _txr_queue_delete(TX_QUEUE *queue_ptr);
 UINT        _txr_queue_flush(TX_QUEUE *queue_ptr);
 UINT        _txr_queue_info_get(TX_QUEUE *queue_ptr, CHAR **name, ULONG *enqueued, ULONG *available_storage,
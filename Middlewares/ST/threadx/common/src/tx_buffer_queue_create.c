@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Queue                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_queue.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_buffer_queue_create                             PORTABLE C      */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function creates a buffer queue, a queue of block pool buffer  */
+/*    pointers.  The queue storage holds                                  */
+/*    queue_size/(TX_BUFFER_QUEUE_MESSAGE_SIZE*sizeof(ULONG)) buffers.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer_queue_ptr                  Pointer to buffer queue control   */
+/*                                        block                           */
+/*    name_ptr                          Pointer to queue name             */
+/*    queue_start                       Starting address of queue area    */
+/*    queue_size                        Number of bytes in queue          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                            Completion status                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_queue_create                  Create the queue of pointers      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _tx_buffer_queue_create(TX_BUFFER_QUEUE *buffer_queue_ptr, CHAR *name_ptr,
+                        VOID *queue_start, ULONG queue_size)
+{
+
+UINT        status;
+
+
+    /* Create the queue with messages of one buffer pointer.  */
+    status =  _tx_queue_create(&(buffer_queue_ptr -> tx_buffer_queue_queue), name_ptr, TX_BUFFER_QUEUE_MESSAGE_SIZE,
+                               queue_start, queue_size);
+
+    /* Return completion status.  */
+    return(status);
+}
@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Queue                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_queue.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_buffer_queue_delete                             PORTABLE C      */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function deletes a buffer queue.  The threads suspended on     */
+/*    the buffer queue are resumed with TX_DELETED, the senders keep      */
+/*    their buffers.  The buffers left in the queue are then released to  */
+/*    their block pools.                                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer_queue_ptr                  Pointer to buffer queue control   */
+/*                                        block                           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                            Completion status                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_queue_delete                  Delete the queue of pointers      */
+/*    _tx_block_release                 Release a buffer to its pool      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _tx_buffer_queue_delete(TX_BUFFER_QUEUE *buffer_queue_ptr)
+{
+
+TX_QUEUE        *queue_ptr;
+VOID            *buffer_ptr;
+ULONG           *source;
+ULONG           *destination;
+UINT            size;
+UINT            status;
+
+
+    /* Delete the queue of pointers, the suspended senders keep their buffers.  */
+    queue_ptr =  &(buffer_queue_ptr -> tx_buffer_queue_queue);
+    status =     _tx_queue_delete(queue_ptr);
+
+    /* The queue can no longer be used, release the buffers left in its
+       storage.  */
+    while (queue_ptr -> tx_queue_enqueued != TX_NO_MESSAGES)
+    {
+
+        /* Setup source and destination pointers.  */
+        source =       queue_ptr -> tx_queue_read;
+        destination =  TX_VOID_TO_ULONG_POINTER_CONVERT(&buffer_ptr);
+        size =         queue_ptr -> tx_queue_message_size;
+
+        /* Copy the buffer pointer. Note that the source and destination pointers are
+           incremented by the macro.  */
+        TX_QUEUE_MESSAGE_COPY(source, destination, size)
+
+        /* Determine if we are at the end.  */
+        if (source == queue_ptr -> tx_queue_end)
+        {
+
+            /* Yes, wrap around to the beginning.  */
+            source =  queue_ptr -> tx_queue_start;
+        }
+
+        /* Setup the queue read pointer.   */
+        queue_ptr -> tx_queue_read =  source;
+
+        /* Decrease the enqueued count.  */
+        queue_ptr -> tx_queue_enqueued--;
+
+        /* Release the buffer to its block pool.  */
+        (VOID) _tx_block_release(buffer_ptr);
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
@@ -0,0 +1,255 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Queue                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include "tx_queue.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_buffer_queue_flush                              PORTABLE C      */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function empties a buffer queue, as tx_queue_flush does for a  */
+/*    queue: the queue is reset with interrupts disabled and the threads  */
+/*    suspended on the full buffer queue are resumed with TX_SUCCESS.     */
+/*    The buffers that were queued and the buffers of the resumed senders */
+/*    are released to their block pools.                                  */
+/*                                                                        */
+/*    The storage of the buffers that were queued is given back to the    */
+/*    queue as each of them is released, so that the buffers sent from    */
+/*    ISRs meanwhile do not overwrite them.                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer_queue_ptr                  Pointer to buffer queue control   */
+/*                                        block                           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    TX_SUCCESS                        Successful completion status      */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_block_release                 Release a buffer to its pool      */
+/*    _tx_thread_system_resume          Resume thread service             */
+/*    _tx_thread_system_ni_resume       Non-interruptable resume thread   */
+/*    _tx_thread_system_preempt_check   Check for preemption              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _tx_buffer_queue_flush(TX_BUFFER_QUEUE *buffer_queue_ptr)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+TX_QUEUE        *queue_ptr;
+TX_THREAD       *suspension_list;
+UINT            suspended_count;
+TX_THREAD       *thread_ptr;
+UINT            enqueued;
+UINT            i;
+ULONG           *read_ptr;
+VOID            *buffer_ptr;
+ULONG           *source;
+ULONG           *destination;
+UINT            size;
+
+
+    /* Initialize the suspended count and list.  */
+    suspended_count =  TX_NO_SUSPENSIONS;
+    suspension_list =  TX_NULL;
+    queue_ptr =        &(buffer_queue_ptr -> tx_buffer_queue_queue);
+
+    /* Disable interrupts to reset various queue parameters.  */
+    TX_DISABLE
+
+    /* Pickup the buffers queued.  */
+    enqueued =  queue_ptr -> tx_queue_enqueued;
+    read_ptr =  queue_ptr -> tx_queue_read;
+
+    /* Determine if there is something on the queue.  */
+    if (enqueued != TX_NO_MESSAGES)
+    {
+
+        /* Yes, erase all of the queued buffers.  Their storage remains
+           reserved until they are released, the next buffers are written
+           after them.  */
+        queue_ptr -> tx_queue_enqueued =  TX_NO_MESSAGES;
+        queue_ptr -> tx_queue_read =      queue_ptr -> tx_queue_write;
+
+        /* Now determine if there are any threads suspended on a full queue.  */
+        if (queue_ptr -> tx_queue_suspended_count != TX_NO_SUSPENSIONS)
+        {
+
+            /* Yes, there are threads suspended on this queue, they must be
+               resumed!  */
+
+            /* Copy the information into temporary variables.  */
+            suspension_list =  queue_ptr -> tx_queue_suspension_list;
+            suspended_count =  queue_ptr -> tx_queue_suspended_count;
+
+            /* Clear the queue variables.  */
+            queue_ptr -> tx_queue_suspension_list =  TX_NULL;
+            queue_ptr -> tx_queue_suspended_count =  TX_NO_SUSPENSIONS;
+        }
+
+        /* Temporarily disable preemption, so that no thread suspends on the
+           buffer queue until the storage is given back.  */
+        _tx_thread_preempt_disable++;
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Release the buffers that were queued.  */
+    for (i = ((UINT) 0); i < enqueued; i++)
+    {
+
+        /* Setup source and destination pointers.  */
+        source =       read_ptr;
+        destination =  TX_VOID_TO_ULONG_POINTER_CONVERT(&buffer_ptr);
+        size =         queue_ptr -> tx_queue_message_size;
+
+        /* Copy the buffer pointer. Note that the source and destination pointers are
+           incremented by the macro.  */
+        TX_QUEUE_MESSAGE_COPY(source, destination, size)
+
+        /* Determine if we are at the end.  */
+        if (source == queue_ptr -> tx_queue_end)
+        {
+
+            /* Yes, wrap around to the beginning.  */
+            source =  queue_ptr -> tx_queue_start;
+        }
+        read_ptr =  source;
+
+        /* Lockout interrupts.  */
+        TX_DISABLE
+
+        /* Give the storage of the buffer back to the queue.  */
+        queue_ptr -> tx_queue_available_storage++;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Release the buffer to its block pool.  */
+        (VOID) _tx_block_release(buffer_ptr);
+    }
+
+    /* Walk through the queue list to resume any and all threads suspended
+       on this queue, and release their buffers.  */
+    thread_ptr =  suspension_list;
+    while (suspended_count != ((ULONG) 0))
+    {
+
+        /* Decrement the suspension count.  */
+        suspended_count--;
+
+        /* Check for a NULL thread pointer.  */
+        if (thread_ptr == TX_NULL)
+        {
+
+            /* Get out of the loop.  */
+            break;
+        }
+
+        /* Resume the next suspended thread.  */
+
+        /* Lockout interrupts.  */
+        TX_DISABLE
+
+        /* Pickup the buffer of the sender, before it is resumed.  */
+        source =       TX_VOID_TO_ULONG_POINTER_CONVERT(thread_ptr -> tx_thread_additional_suspend_info);
+        destination =  TX_VOID_TO_ULONG_POINTER_CONVERT(&buffer_ptr);
+        size =         queue_ptr -> tx_queue_message_size;
+        TX_QUEUE_MESSAGE_COPY(source, destination, size)
+
+        /* Clear the cleanup pointer, this prevents the timeout from doing
+           anything.  */
+        thread_ptr -> tx_thread_suspend_cleanup =  TX_NULL;
+
+        /* Set the return status in the thread to TX_SUCCESS.  */
+        thread_ptr -> tx_thread_suspend_status =  TX_SUCCESS;
+
+        /* Move the thread pointer ahead.  */
+        thread_ptr =  thread_ptr -> tx_thread_suspended_next;
+
+#ifdef TX_NOT_INTERRUPTABLE
+
+        /* Resume the thread!  */
+        _tx_thread_system_ni_resume(thread_ptr -> tx_thread_suspended_previous);
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+#else
+
+        /* Temporarily disable preemption again.  */
+        _tx_thread_preempt_disable++;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Resume the thread.  */
+        _tx_thread_system_resume(thread_ptr -> tx_thread_suspended_previous);
+#endif
+
+        /* Release the buffer to its block pool.  */
+        (VOID) _tx_block_release(buffer_ptr);
+    }
+
+    /* Determine if preemption was disabled.  */
+    if (enqueued != TX_NO_MESSAGES)
+    {
+
+        /* Disable interrupts.  */
+        TX_DISABLE
+
+        /* Restore previous preempt posture.  */
+        _tx_thread_preempt_disable--;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Check for preemption.  */
+        _tx_thread_system_preempt_check();
+    }
+
+    /* Return TX_SUCCESS.  */
+    return(TX_SUCCESS);
+}
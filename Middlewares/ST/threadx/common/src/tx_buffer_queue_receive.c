@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Queue                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_queue.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_buffer_queue_receive                            PORTABLE C      */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function receives a block pool buffer from a buffer queue.     */
+/*    The caller owns the buffer and releases it to its pool, or sends    */
+/*    it again.  The suspension is the one of tx_queue_receive.           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer_queue_ptr                  Pointer to buffer queue control   */
+/*                                        block                           */
+/*    buffer_ptr                        Pointer to place received buffer  */
+/*                                        pointer                         */
+/*    wait_option                       Suspension option                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                            Completion status                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_queue_receive                 Receive the buffer pointer        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _tx_buffer_queue_receive(TX_BUFFER_QUEUE *buffer_queue_ptr, VOID **buffer_ptr, ULONG wait_option)
+{
+
+UINT        status;
+
+
+    /* Receive the buffer pointer.  */
+    status =  _tx_queue_receive(&(buffer_queue_ptr -> tx_buffer_queue_queue), buffer_ptr, wait_option);
+
+    /* Return completion status.  */
+    return(status);
+}
@@ -30,6 +30,8 @@
 #include "tx_byte_pool.h"
 
 
+#ifndef TX_BYTE_POOL_ENABLE_TLSF
+
 /**************************************************************************/
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
@@ -352,3 +354,4 @@ ULONG           total_theoretical_available;
     return(current_ptr);
 }
 
+#endif
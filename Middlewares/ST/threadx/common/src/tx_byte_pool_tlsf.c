@@ -0,0 +1,762 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Byte Pool                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include "tx_byte_pool.h"
+
+
+/* This file holds the two-level segregated fit (TLSF) search of the byte
+   pools, built when TX_BYTE_POOL_ENABLE_TLSF is defined.  Otherwise, the
+   first-fit search of tx_byte_pool_search.c is built.  The SMP version of
+   ThreadX builds this same file.  */
+
+#ifdef TX_BYTE_POOL_ENABLE_TLSF
+
+
+/* Define the size of the header of a block.  */
+
+#define TX_BYTE_BLOCK_HEADER_SIZE               ((ULONG) ((sizeof(UCHAR *)) + (sizeof(ALIGN_TYPE))))
+
+
+/* Return the next block of a block, without the TX_BYTE_BLOCK_PREV_FREE bit.  */
+
+static UCHAR  *_tx_byte_pool_tlsf_next_get(UCHAR *block_ptr)
+{
+
+UCHAR           **block_link_ptr;
+ALIGN_TYPE      link;
+
+
+    block_link_ptr =  TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    link =            TX_POINTER_TO_ALIGN_TYPE_CONVERT(*block_link_ptr);
+    link =            link & (~TX_BYTE_BLOCK_PREV_FREE);
+    return(TX_VOID_TO_UCHAR_POINTER_CONVERT(TX_ALIGN_TYPE_TO_POINTER_CONVERT(link)));
+}
+
+
+/* Return TX_BYTE_BLOCK_PREV_FREE if the previous block of a block is free.  */
+
+static ALIGN_TYPE  _tx_byte_pool_tlsf_prev_free_get(UCHAR *block_ptr)
+{
+
+UCHAR           **block_link_ptr;
+
+
+    block_link_ptr =  TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    return(TX_POINTER_TO_ALIGN_TYPE_CONVERT(*block_link_ptr) & TX_BYTE_BLOCK_PREV_FREE);
+}
+
+
+/* Setup the next block of a block along with its TX_BYTE_BLOCK_PREV_FREE bit.  */
+
+static VOID  _tx_byte_pool_tlsf_next_set(UCHAR *block_ptr, UCHAR *next_ptr, ALIGN_TYPE prev_free)
+{
+
+UCHAR           **block_link_ptr;
+
+
+    block_link_ptr =   TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    *block_link_ptr =  TX_VOID_TO_UCHAR_POINTER_CONVERT(TX_ALIGN_TYPE_TO_POINTER_CONVERT(TX_POINTER_TO_ALIGN_TYPE_CONVERT(next_ptr) | prev_free));
+}
+
+
+/* Return a pointer to the free list links of a free block, the next
+   free block followed by the previous free block.  */
+
+static UCHAR  **_tx_byte_pool_tlsf_links_get(UCHAR *block_ptr)
+{
+
+UCHAR           *work_ptr;
+
+
+    work_ptr =  TX_UCHAR_POINTER_ADD(block_ptr, TX_BYTE_BLOCK_HEADER_SIZE);
+    return(TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr));
+}
+
+
+/* Mark a block free and store a pointer to its header in its last word.  */
+
+static VOID  _tx_byte_pool_tlsf_free_mark(UCHAR *block_ptr, UCHAR *next_ptr)
+{
+
+UCHAR           *work_ptr;
+ALIGN_TYPE      *free_ptr;
+UCHAR           **footer_ptr;
+
+
+    work_ptr =     TX_UCHAR_POINTER_ADD(block_ptr, (sizeof(UCHAR *)));
+    free_ptr =     TX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(work_ptr);
+    *free_ptr =    TX_BYTE_BLOCK_FREE;
+    work_ptr =     TX_UCHAR_POINTER_SUB(next_ptr, (sizeof(UCHAR *)));
+    footer_ptr =   TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+    *footer_ptr =  block_ptr;
+}
+
+
+/* Return the TLSF index of a byte pool.  */
+
+static TX_BYTE_POOL_TLSF  *_tx_byte_pool_tlsf_get(TX_BYTE_POOL *pool_ptr)
+{
+
+    return((TX_BYTE_POOL_TLSF *) ((VOID *) pool_ptr -> tx_byte_pool_start));
+}
+
+
+/* Return a row of the TLSF index.  The rows follow the header of the index,
+   rounded up to a pointer boundary.  */
+
+static TX_BYTE_POOL_TLSF_ROW  *_tx_byte_pool_tlsf_row_get(TX_BYTE_POOL_TLSF *tlsf_ptr, UINT fl)
+{
+
+UCHAR                   *work_ptr;
+TX_BYTE_POOL_TLSF_ROW   *row_ptr;
+
+
+    work_ptr =  (UCHAR *) ((VOID *) tlsf_ptr);
+    work_ptr =  TX_UCHAR_POINTER_ADD(work_ptr, ((((sizeof(TX_BYTE_POOL_TLSF)) + (sizeof(UCHAR *))) - ((ULONG) 1))/(sizeof(UCHAR *))) * (sizeof(UCHAR *)));
+    row_ptr =   (TX_BYTE_POOL_TLSF_ROW *) ((VOID *) work_ptr);
+    return(&row_ptr[fl]);
+}
+
+
+/* Find the list of a block size: row fl holds the sizes between 2^(fl_shift+fl-1)
+   and 2^(fl_shift+fl) in TX_BYTE_POOL_TLSF_SL_COUNT lists, row 0 holds the
+   smaller sizes in lists one ALIGN_TYPE apart.  */
+
+static VOID  _tx_byte_pool_tlsf_mapping(TX_BYTE_POOL_TLSF *tlsf_ptr, ULONG block_size, UINT *fl_ptr, UINT *sl_ptr)
+{
+
+ULONG           work;
+UINT            highest_bit;
+
+
+    if (block_size < (((ULONG) 1) << tlsf_ptr -> tx_byte_pool_tlsf_fl_shift))
+    {
+
+        *fl_ptr =  ((UINT) 0);
+        *sl_ptr =  (UINT) (block_size/(sizeof(ALIGN_TYPE)));
+    }
+    else
+    {
+
+        work =  block_size;
+        TX_BYTE_POOL_TLSF_HIGHEST_SET_BIT_CALCULATE(work, highest_bit)
+        *fl_ptr =  (highest_bit - tlsf_ptr -> tx_byte_pool_tlsf_fl_shift) + ((UINT) 1);
+        *sl_ptr =  (UINT) ((block_size >> (highest_bit - TX_BYTE_POOL_TLSF_SL_SHIFT)) - ((ULONG) TX_BYTE_POOL_TLSF_SL_COUNT));
+    }
+}
+
+
+/* Insert a free block in its list.  The block becomes the head of the list
+   unless it follows the head in memory, in which case it is placed after
+   the head.  The allocations then stay towards the start of the pool, as
+   with the first-fit search, and the larger free blocks towards its end.  */
+
+static VOID  _tx_byte_pool_tlsf_insert(TX_BYTE_POOL_TLSF *tlsf_ptr, UCHAR *block_ptr, ULONG block_size)
+{
+
+TX_BYTE_POOL_TLSF_ROW   *row_ptr;
+UCHAR                   **links_ptr;
+UCHAR                   **head_links_ptr;
+UCHAR                   **other_links_ptr;
+UCHAR                   *head_ptr;
+UINT                    fl;
+UINT                    sl;
+
+
+    _tx_byte_pool_tlsf_mapping(tlsf_ptr, block_size, &fl, &sl);
+    row_ptr =    _tx_byte_pool_tlsf_row_get(tlsf_ptr, fl);
+    head_ptr =   row_ptr -> tx_byte_pool_tlsf_free_list[sl];
+    links_ptr =  _tx_byte_pool_tlsf_links_get(block_ptr);
+
+    if ((head_ptr != TX_NULL) && (block_ptr > head_ptr))
+    {
+
+        /* Place the block after the head.  */
+        head_links_ptr =  _tx_byte_pool_tlsf_links_get(head_ptr);
+        links_ptr[0] =    head_links_ptr[0];
+        links_ptr[1] =    head_ptr;
+        if (head_links_ptr[0] != TX_NULL)
+        {
+
+            other_links_ptr =     _tx_byte_pool_tlsf_links_get(head_links_ptr[0]);
+            other_links_ptr[1] =  block_ptr;
+        }
+        head_links_ptr[0] =  block_ptr;
+    }
+    else
+    {
+
+        /* Place the block at the head.  */
+        links_ptr[0] =  head_ptr;
+        links_ptr[1] =  TX_NULL;
+        if (head_ptr != TX_NULL)
+        {
+
+            head_links_ptr =     _tx_byte_pool_tlsf_links_get(head_ptr);
+            head_links_ptr[1] =  block_ptr;
+        }
+        row_ptr -> tx_byte_pool_tlsf_free_list[sl] =  block_ptr;
+    }
+
+    /* Mark the list and the row not empty.  */
+    row_ptr -> tx_byte_pool_tlsf_sl_bitmap =   row_ptr -> tx_byte_pool_tlsf_sl_bitmap | (((ULONG) 1) << sl);
+    tlsf_ptr -> tx_byte_pool_tlsf_fl_bitmap =  tlsf_ptr -> tx_byte_pool_tlsf_fl_bitmap | (((ULONG) 1) << fl);
+}
+
+
+/* Remove a free block from its list.  */
+
+static VOID  _tx_byte_pool_tlsf_remove(TX_BYTE_POOL_TLSF *tlsf_ptr, UCHAR *block_ptr, ULONG block_size)
+{
+
+TX_BYTE_POOL_TLSF_ROW   *row_ptr;
+UCHAR                   **links_ptr;
+UCHAR                   **other_links_ptr;
+UINT                    fl;
+UINT                    sl;
+
+
+    _tx_byte_pool_tlsf_mapping(tlsf_ptr, block_size, &fl, &sl);
+    row_ptr =    _tx_byte_pool_tlsf_row_get(tlsf_ptr, fl);
+    links_ptr =  _tx_byte_pool_tlsf_links_get(block_ptr);
+
+    if (links_ptr[1] != TX_NULL)
+    {
+
+        other_links_ptr =     _tx_byte_pool_tlsf_links_get(links_ptr[1]);
+        other_links_ptr[0] =  links_ptr[0];
+    }
+    else
+    {
+
+        /* The block is the head of the list.  */
+        row_ptr -> tx_byte_pool_tlsf_free_list[sl] =  links_ptr[0];
+    }
+
+    if (links_ptr[0] != TX_NULL)
+    {
+
+        other_links_ptr =     _tx_byte_pool_tlsf_links_get(links_ptr[0]);
+        other_links_ptr[1] =  links_ptr[1];
+    }
+
+    /* Determine if the list is now empty.  */
+    if (row_ptr -> tx_byte_pool_tlsf_free_list[sl] == TX_NULL)
+    {
+
+        row_ptr -> tx_byte_pool_tlsf_sl_bitmap =  row_ptr -> tx_byte_pool_tlsf_sl_bitmap & (~(((ULONG) 1) << sl));
+        if (row_ptr -> tx_byte_pool_tlsf_sl_bitmap == ((ULONG) 0))
+        {
+
+            tlsf_ptr -> tx_byte_pool_tlsf_fl_bitmap =  tlsf_ptr -> tx_byte_pool_tlsf_fl_bitmap & (~(((ULONG) 1) << fl));
+        }
+    }
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_byte_pool_tlsf_create                           PORTABLE C      */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds the TLSF index at the start of the memory area */
+/*    of a byte pool, followed by one large free block and the small      */
+/*    allocated block that ends the pool.  The pool start and size are    */
+/*    already setup, the size being at least TX_BYTE_POOL_MIN.            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _tx_byte_pool_create              Create byte pool                  */
+/*                                                                        */
+/**************************************************************************/
+VOID  _tx_byte_pool_tlsf_create(TX_BYTE_POOL *pool_ptr)
+{
+
+TX_BYTE_POOL_TLSF       *tlsf_ptr;
+TX_BYTE_POOL_TLSF_ROW   *row_ptr;
+UCHAR                   *block_ptr;
+UCHAR                   *end_ptr;
+UCHAR                   *temp_ptr;
+UCHAR                   **block_indirect_ptr;
+ULONG                   work;
+ULONG                   index_size;
+UINT                    align_shift;
+UINT                    fl;
+UINT                    sl;
+
+
+    /* Setup the header of the index.  The lists of row 0 are one ALIGN_TYPE apart.  */
+    tlsf_ptr =  _tx_byte_pool_tlsf_get(pool_ptr);
+    work =      (ULONG) (sizeof(ALIGN_TYPE));
+    TX_BYTE_POOL_TLSF_HIGHEST_SET_BIT_CALCULATE(work, align_shift)
+    tlsf_ptr -> tx_byte_pool_tlsf_fl_bitmap =  ((ULONG) 0);
+    tlsf_ptr -> tx_byte_pool_tlsf_fl_shift =   TX_BYTE_POOL_TLSF_SL_SHIFT + align_shift;
+
+    /* No block is larger than the pool, so the row of the pool size is the last one.  */
+    _tx_byte_pool_tlsf_mapping(tlsf_ptr, pool_ptr -> tx_byte_pool_size, &fl, &sl);
+    tlsf_ptr -> tx_byte_pool_tlsf_fl_count =  fl + ((UINT) 1);
+
+    /* Clear the rows.  */
+    row_ptr =     _tx_byte_pool_tlsf_row_get(tlsf_ptr, ((UINT) 0));
+    index_size =  (ULONG) (tlsf_ptr -> tx_byte_pool_tlsf_fl_count * (sizeof(TX_BYTE_POOL_TLSF_ROW)));
+    TX_MEMSET(row_ptr, 0, index_size);
+
+    /* The blocks start after the index, on an ALIGN_TYPE boundary.  */
+    index_size =  index_size + TX_UCHAR_POINTER_DIF(((UCHAR *) ((VOID *) row_ptr)), pool_ptr -> tx_byte_pool_start);
+    index_size =  (((index_size + (sizeof(ALIGN_TYPE))) - ((ULONG) 1))/(sizeof(ALIGN_TYPE))) * (sizeof(ALIGN_TYPE));
+    block_ptr =   TX_UCHAR_POINTER_ADD(pool_ptr -> tx_byte_pool_start, index_size);
+
+    /* Setup memory list to the first block as well as the search pointer.  */
+    pool_ptr -> tx_byte_pool_list =    block_ptr;
+    pool_ptr -> tx_byte_pool_search =  block_ptr;
+
+    /* Build the allocated block at the end of the pool, it points back to the first block.  */
+    end_ptr =   TX_UCHAR_POINTER_ADD(pool_ptr -> tx_byte_pool_start, pool_ptr -> tx_byte_pool_size);
+    end_ptr =   TX_UCHAR_POINTER_SUB(end_ptr, TX_BYTE_BLOCK_HEADER_SIZE);
+    temp_ptr =             TX_UCHAR_POINTER_ADD(end_ptr, (sizeof(UCHAR *)));
+    block_indirect_ptr =   TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(temp_ptr);
+    *block_indirect_ptr =  TX_BYTE_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
+    _tx_byte_pool_tlsf_next_set(end_ptr, block_ptr, TX_BYTE_BLOCK_PREV_FREE);
+
+    /* Now setup the large available block in the pool.  */
+    _tx_byte_pool_tlsf_next_set(block_ptr, end_ptr, ((ALIGN_TYPE) 0));
+    _tx_byte_pool_tlsf_free_mark(block_ptr, end_ptr);
+    _tx_byte_pool_tlsf_insert(tlsf_ptr, block_ptr, TX_UCHAR_POINTER_DIF(end_ptr, block_ptr));
+
+    /* As for the first-fit search, the available bytes count the headers of
+       the free blocks.  */
+    pool_ptr -> tx_byte_pool_available =  TX_UCHAR_POINTER_DIF(end_ptr, block_ptr);
+    pool_ptr -> tx_byte_pool_fragments =  ((UINT) 2);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_byte_pool_search                                PORTABLE C      */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds a memory block to satisfy the requested number  */
+/*    of bytes in the TLSF index of a byte pool.  The head of the list of */
+/*    the requested size is taken if it is large enough.  Otherwise, the  */
+/*    request is rounded up to the next list, so that the head of the     */
+/*    first non-empty list found with the bitmaps is large enough.  Only  */
+/*    when there is no such list, TX_BYTE_POOL_TLSF_SEARCH_MAX blocks of  */
+/*    the list of the requested size are checked after its head.  The     */
+/*    block found may be split before this function returns.              */
+/*                                                                        */
+/*    The search takes a bounded time, it is done with interrupts         */
+/*    disabled.  As for the first-fit search, this function is called     */
+/*    with interrupts enabled, and it sets the tx_pool_owner field to the */
+/*    thread performing the search.                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    memory_size                       Number of bytes required          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    UCHAR *                           Pointer to the allocated memory,  */
+/*                                        if successful.  Otherwise, a    */
+/*                                        NULL is returned                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _tx_byte_allocate                 Allocate bytes of memory          */
+/*    _tx_byte_release                  Release bytes of memory           */
+/*                                                                        */
+/**************************************************************************/
+UCHAR  *_tx_byte_pool_search(TX_BYTE_POOL *pool_ptr, ULONG memory_size)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+TX_BYTE_POOL_TLSF       *tlsf_ptr;
+TX_BYTE_POOL_TLSF_ROW   *row_ptr;
+TX_THREAD               *thread_ptr;
+UCHAR                   *current_ptr;
+UCHAR                   *next_ptr;
+UCHAR                   *split_ptr;
+UCHAR                   **links_ptr;
+UCHAR                   *work_ptr;
+ULONG                   block_size;
+ULONG                   search_size;
+ULONG                   available_bytes;
+ULONG                   split_min;
+ULONG                   work;
+ULONG                   bitmap;
+UINT                    highest_bit;
+UINT                    fl;
+UINT                    sl;
+UINT                    search_count;
+
+
+    /* Disable interrupts.  */
+    TX_DISABLE
+
+    /* Pickup thread pointer.  */
+    TX_THREAD_GET_CURRENT(thread_ptr)
+
+    /* Setup ownership of the byte pool.  */
+    pool_ptr -> tx_byte_pool_owner =  thread_ptr;
+
+    tlsf_ptr =     _tx_byte_pool_tlsf_get(pool_ptr);
+    current_ptr =  TX_NULL;
+
+    /* First, determine if there are enough bytes in the pool.  */
+    if (memory_size < pool_ptr -> tx_byte_pool_available)
+    {
+
+        /* The block holds the header and the memory, and it must be able to hold the
+           free list links once released.  */
+        block_size =  memory_size + TX_BYTE_BLOCK_HEADER_SIZE;
+        if (block_size < TX_BYTE_POOL_TLSF_BLOCK_MIN)
+        {
+
+            block_size =  TX_BYTE_POOL_TLSF_BLOCK_MIN;
+        }
+
+        /* Check the head of the list of the size itself, the closest fit
+           that leaves the larger blocks whole.  */
+        _tx_byte_pool_tlsf_mapping(tlsf_ptr, block_size, &fl, &sl);
+        row_ptr =   _tx_byte_pool_tlsf_row_get(tlsf_ptr, fl);
+        work_ptr =  row_ptr -> tx_byte_pool_tlsf_free_list[sl];
+        if (work_ptr != TX_NULL)
+        {
+
+            if (TX_UCHAR_POINTER_DIF(_tx_byte_pool_tlsf_next_get(work_ptr), work_ptr) >= block_size)
+            {
+
+                current_ptr =  work_ptr;
+            }
+        }
+
+        /* Round the size up to the next list, so that any block of the list is large enough.  */
+        search_size =  block_size;
+        if (search_size >= (((ULONG) 1) << tlsf_ptr -> tx_byte_pool_tlsf_fl_shift))
+        {
+
+            work =  search_size;
+            TX_BYTE_POOL_TLSF_HIGHEST_SET_BIT_CALCULATE(work, highest_bit)
+            search_size =  (search_size + (((ULONG) 1) << (highest_bit - TX_BYTE_POOL_TLSF_SL_SHIFT))) - ((ULONG) 1);
+        }
+        _tx_byte_pool_tlsf_mapping(tlsf_ptr, search_size, &fl, &sl);
+
+#ifdef TX_BYTE_POOL_ENABLE_PERFORMANCE_INFO
+
+        /* Increment the total fragment search counter.  */
+        _tx_byte_pool_performance_search_count++;
+
+        /* Increment the number of fragments searched on this pool.  */
+        pool_ptr -> tx_byte_pool_performance_search_count++;
+#endif
+
+        if ((current_ptr == TX_NULL) && (fl < tlsf_ptr -> tx_byte_pool_tlsf_fl_count))
+        {
+
+            /* Look for a non-empty list in the row, from the rounded up size.  */
+            row_ptr =  _tx_byte_pool_tlsf_row_get(tlsf_ptr, fl);
+            bitmap =   row_ptr -> tx_byte_pool_tlsf_sl_bitmap & (~((((ULONG) 1) << sl) - ((ULONG) 1)));
+            if (bitmap == ((ULONG) 0))
+            {
+
+                /* Otherwise, take the first list of the next non-empty row.  */
+                bitmap =  tlsf_ptr -> tx_byte_pool_tlsf_fl_bitmap & (~((((ULONG) 1) << fl) - ((ULONG) 1)));
+                bitmap =  bitmap & (~(((ULONG) 1) << fl));
+                if (bitmap != ((ULONG) 0))
+                {
+
+                    TX_BYTE_POOL_TLSF_LOWEST_SET_BIT_CALCULATE(bitmap, fl)
+                    row_ptr =  _tx_byte_pool_tlsf_row_get(tlsf_ptr, fl);
+                    bitmap =   row_ptr -> tx_byte_pool_tlsf_sl_bitmap;
+                }
+            }
+
+            if (bitmap != ((ULONG) 0))
+            {
+
+                TX_BYTE_POOL_TLSF_LOWEST_SET_BIT_CALCULATE(bitmap, sl)
+                current_ptr =  row_ptr -> tx_byte_pool_tlsf_free_list[sl];
+            }
+        }
+
+        if (current_ptr == TX_NULL)
+        {
+
+            /* The pool is close to exhaustion, search the list of the size itself
+               after its head, already checked.  Only TX_BYTE_POOL_TLSF_SEARCH_MAX
+               blocks are checked so that the search time remains bounded.  */
+            _tx_byte_pool_tlsf_mapping(tlsf_ptr, block_size, &fl, &sl);
+            row_ptr =   _tx_byte_pool_tlsf_row_get(tlsf_ptr, fl);
+            work_ptr =  row_ptr -> tx_byte_pool_tlsf_free_list[sl];
+            if (work_ptr != TX_NULL)
+            {
+
+                links_ptr =  _tx_byte_pool_tlsf_links_get(work_ptr);
+                work_ptr =   links_ptr[0];
+            }
+            search_count =  ((UINT) 0);
+            while ((work_ptr != TX_NULL) && (search_count < TX_BYTE_POOL_TLSF_SEARCH_MAX))
+            {
+
+                search_count++;
+
+#ifdef TX_BYTE_POOL_ENABLE_PERFORMANCE_INFO
+
+                /* Increment the total fragment search counter.  */
+                _tx_byte_pool_performance_search_count++;
+
+                /* Increment the number of fragments searched on this pool.  */
+                pool_ptr -> tx_byte_pool_performance_search_count++;
+#endif
+
+                if (TX_UCHAR_POINTER_DIF(_tx_byte_pool_tlsf_next_get(work_ptr), work_ptr) >= block_size)
+                {
+
+                    /* Get out of the search loop!  */
+                    current_ptr =  work_ptr;
+                    break;
+                }
+
+                links_ptr =  _tx_byte_pool_tlsf_links_get(work_ptr);
+                work_ptr =   links_ptr[0];
+            }
+        }
+    }
+
+    /* Determine if a block was found.  If so, determine if it needs to be
+       split.  */
+    if (current_ptr != TX_NULL)
+    {
+
+        next_ptr =         _tx_byte_pool_tlsf_next_get(current_ptr);
+        available_bytes =  TX_UCHAR_POINTER_DIF(next_ptr, current_ptr);
+        _tx_byte_pool_tlsf_remove(tlsf_ptr, current_ptr, available_bytes);
+
+        /* A split must leave a block able to hold the free list links.  */
+        split_min =  (ULONG) TX_BYTE_BLOCK_MIN;
+        if (split_min < TX_BYTE_POOL_TLSF_BLOCK_MIN)
+        {
+
+            split_min =  TX_BYTE_POOL_TLSF_BLOCK_MIN;
+        }
+
+        /* Determine if we need to split this block.  */
+        if ((available_bytes - block_size) >= split_min)
+        {
+
+            /* Split the block, the next block remains after a free block.  */
+            split_ptr =  TX_UCHAR_POINTER_ADD(current_ptr, block_size);
+            _tx_byte_pool_tlsf_next_set(split_ptr, next_ptr, ((ALIGN_TYPE) 0));
+            _tx_byte_pool_tlsf_free_mark(split_ptr, next_ptr);
+            _tx_byte_pool_tlsf_insert(tlsf_ptr, split_ptr, TX_UCHAR_POINTER_DIF(next_ptr, split_ptr));
+            _tx_byte_pool_tlsf_next_set(current_ptr, split_ptr, ((ALIGN_TYPE) 0));
+
+            /* Increase the total fragment counter.  */
+            pool_ptr -> tx_byte_pool_fragments++;
+
+            /* Set available equal to the block size for subsequent calculation.  */
+            available_bytes =  block_size;
+
+#ifdef TX_BYTE_POOL_ENABLE_PERFORMANCE_INFO
+
+            /* Increment the total split counter.  */
+            _tx_byte_pool_performance_split_count++;
+
+            /* Increment the number of blocks split on this pool.  */
+            pool_ptr -> tx_byte_pool_performance_split_count++;
+#endif
+        }
+        else
+        {
+
+            /* The next block now follows an allocated block.  */
+            _tx_byte_pool_tlsf_next_set(next_ptr, _tx_byte_pool_tlsf_next_get(next_ptr), ((ALIGN_TYPE) 0));
+        }
+
+        /* In any case, mark the current block as allocated.  */
+        work_ptr =    TX_UCHAR_POINTER_ADD(current_ptr, (sizeof(UCHAR *)));
+        links_ptr =   TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+        *links_ptr =  TX_BYTE_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
+
+        /* Reduce the number of available bytes in the pool.  */
+        pool_ptr -> tx_byte_pool_available =  pool_ptr -> tx_byte_pool_available - available_bytes;
+
+        /* Adjust the pointer for the application.  */
+        current_ptr =  TX_UCHAR_POINTER_ADD(current_ptr, TX_BYTE_BLOCK_HEADER_SIZE);
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Return the search pointer.  */
+    return(current_ptr);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_byte_pool_tlsf_release                          PORTABLE C      */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns an allocated block to the TLSF index of a     */
+/*    byte pool.  The block is merged with its previous and next blocks   */
+/*    when they are free, so that no two free blocks are adjacent.        */
+/*                                                                        */
+/*    It is assumed that this function is called with interrupts          */
+/*    disabled.                                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    block_ptr                         Pointer to the block header       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _tx_byte_release                  Release bytes of memory           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _tx_byte_pool_tlsf_release(TX_BYTE_POOL *pool_ptr, UCHAR *block_ptr)
+{
+
+TX_BYTE_POOL_TLSF       *tlsf_ptr;
+UCHAR                   *next_ptr;
+UCHAR                   *previous_ptr;
+UCHAR                   *work_ptr;
+UCHAR                   **footer_ptr;
+ALIGN_TYPE              *free_ptr;
+
+
+    tlsf_ptr =  _tx_byte_pool_tlsf_get(pool_ptr);
+    next_ptr =  _tx_byte_pool_tlsf_next_get(block_ptr);
+
+    /* Update the number of available bytes in the pool.  */
+    pool_ptr -> tx_byte_pool_available =
+        pool_ptr -> tx_byte_pool_available + TX_UCHAR_POINTER_DIF(next_ptr, block_ptr);
+
+    /* Determine if the next block is free.  */
+    work_ptr =  TX_UCHAR_POINTER_ADD(next_ptr, (sizeof(UCHAR *)));
+    free_ptr =  TX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(work_ptr);
+    if ((*free_ptr) == TX_BYTE_BLOCK_FREE)
+    {
+
+        /* Yes, merge it.  The available bytes already include its header.  */
+        work_ptr =  _tx_byte_pool_tlsf_next_get(next_ptr);
+        _tx_byte_pool_tlsf_remove(tlsf_ptr, next_ptr, TX_UCHAR_POINTER_DIF(work_ptr, next_ptr));
+        next_ptr =  work_ptr;
+
+        /* Reduce the fragment total.  */
+        pool_ptr -> tx_byte_pool_fragments--;
+
+#ifdef TX_BYTE_POOL_ENABLE_PERFORMANCE_INFO
+
+        /* Increment the total merge counter.  */
+        _tx_byte_pool_performance_merge_count++;
+
+        /* Increment the number of blocks merged on this pool.  */
+        pool_ptr -> tx_byte_pool_performance_merge_count++;
+#endif
+    }
+
+    /* Determine if the previous block is free.  */
+    if (_tx_byte_pool_tlsf_prev_free_get(block_ptr) != ((ALIGN_TYPE) 0))
+    {
+
+        /* Yes, pickup its header from its last word and merge it.  */
+        work_ptr =      TX_UCHAR_POINTER_SUB(block_ptr, (sizeof(UCHAR *)));
+        footer_ptr =    TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+        previous_ptr =  *footer_ptr;
+        _tx_byte_pool_tlsf_remove(tlsf_ptr, previous_ptr, TX_UCHAR_POINTER_DIF(block_ptr, previous_ptr));
+        block_ptr =     previous_ptr;
+
+        /* Reduce the fragment total.  */
+        pool_ptr -> tx_byte_pool_fragments--;
+
+#ifdef TX_BYTE_POOL_ENABLE_PERFORMANCE_INFO
+
+        /* Increment the total merge counter.  */
+        _tx_byte_pool_performance_merge_count++;
+
+        /* Increment the number of blocks merged on this pool.  */
+        pool_ptr -> tx_byte_pool_performance_merge_count++;
+#endif
+    }
+
+    /* Place the free block in its list, and mark it free in the next block.  */
+    _tx_byte_pool_tlsf_next_set(block_ptr, next_ptr, ((ALIGN_TYPE) 0));
+    _tx_byte_pool_tlsf_free_mark(block_ptr, next_ptr);
+    _tx_byte_pool_tlsf_insert(tlsf_ptr, block_ptr, TX_UCHAR_POINTER_DIF(next_ptr, block_ptr));
+    _tx_byte_pool_tlsf_next_set(next_ptr, _tx_byte_pool_tlsf_next_get(next_ptr), TX_BYTE_BLOCK_PREV_FREE);
+}
+#endif
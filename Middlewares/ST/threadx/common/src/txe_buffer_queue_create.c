@@ -0,0 +1,219 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Queue                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_initialize.h"
+#include "tx_timer.h"
+#include "tx_thread.h"
+#include "tx_queue.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _txe_buffer_queue_create                            PORTABLE C      */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks for errors in the buffer queue create function */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer_queue_ptr                  Pointer to buffer queue control   */
+/*                                        block                           */
+/*    name_ptr                          Pointer to queue name             */
+/*    queue_start                       Starting address of queue area    */
+/*    queue_size                        Number of bytes in queue          */
+/*    buffer_queue_control_block_size   Size of buffer queue control      */
+/*                                        block                           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    TX_QUEUE_ERROR                    Invalid buffer queue pointer      */
+/*    TX_PTR_ERROR                      Invalid starting address of queue */
+/*    TX_SIZE_ERROR                     Invalid queue size                */
+/*    TX_CALLER_ERROR                   Invalid caller of this function   */
+/*    status                            Actual completion status          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_buffer_queue_create           Actual buffer queue create        */
+/*                                        function                        */
+/*    _tx_thread_system_preempt_check   Check for preemption              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _txe_buffer_queue_create(TX_BUFFER_QUEUE *buffer_queue_ptr, CHAR *name_ptr,
+                        VOID *queue_start, ULONG queue_size, UINT buffer_queue_control_block_size)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+UINT            status;
+ULONG           i;
+TX_QUEUE        *next_queue;
+#ifndef TX_TIMER_PROCESS_IN_ISR
+TX_THREAD       *thread_ptr;
+#endif
+
+
+    /* Default status to success.  */
+    status =  TX_SUCCESS;
+
+    /* Check for an invalid buffer queue pointer.  */
+    if (buffer_queue_ptr == TX_NULL)
+    {
+
+        /* Buffer queue pointer is invalid, return appropriate error code.  */
+        status =  TX_QUEUE_ERROR;
+    }
+
+    /* Now check for a valid control block size.  */
+    else if (buffer_queue_control_block_size != (sizeof(TX_BUFFER_QUEUE)))
+    {
+
+        /* Buffer queue pointer is invalid, return appropriate error code.  */
+        status =  TX_QUEUE_ERROR;
+    }
+    else
+    {
+
+        /* Disable interrupts.  */
+        TX_DISABLE
+
+        /* Increment the preempt disable flag.  */
+        _tx_thread_preempt_disable++;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Next see if its queue is already in the created list.  */
+        next_queue =   _tx_queue_created_ptr;
+        for (i = ((ULONG) 0); i < _tx_queue_created_count; i++)
+        {
+
+            /* Determine if this queue matches the queue in the list.  */
+            if (&(buffer_queue_ptr -> tx_buffer_queue_queue) == next_queue)
+            {
+
+                break;
+            }
+            else
+            {
+
+                /* Move to the next queue.  */
+                next_queue =  next_queue -> tx_queue_created_next;
+            }
+        }
+
+        /* Disable interrupts.  */
+        TX_DISABLE
+
+        /* Decrement the preempt disable flag.  */
+        _tx_thread_preempt_disable--;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Check for preemption.  */
+        _tx_thread_system_preempt_check();
+
+        /* At this point, check to see if there is a duplicate buffer queue.  */
+        if (&(buffer_queue_ptr -> tx_buffer_queue_queue) == next_queue)
+        {
+
+            /* Buffer queue is already created, return appropriate error code.  */
+            status =  TX_QUEUE_ERROR;
+        }
+
+        /* Check the starting address of the queue.  */
+        else if (queue_start == TX_NULL)
+        {
+
+            /* Invalid starting address of queue.  */
+            status =  TX_PTR_ERROR;
+        }
+
+        /* Check on the queue size, it shall hold one buffer at least.  */
+        else if ((queue_size/(sizeof(ULONG))) < ((ULONG) TX_BUFFER_QUEUE_MESSAGE_SIZE))
+        {
+
+            /* Invalid queue size specified.  */
+            status =  TX_SIZE_ERROR;
+        }
+        else
+        {
+
+#ifndef TX_TIMER_PROCESS_IN_ISR
+
+            /* Pickup thread pointer.  */
+            TX_THREAD_GET_CURRENT(thread_ptr)
+
+            /* Check for invalid caller of this function.  First check for a calling thread.  */
+            if (thread_ptr == &_tx_timer_thread)
+            {
+
+                /* Invalid caller of this function, return appropriate error code.  */
+                status =  TX_CALLER_ERROR;
+            }
+#endif
+
+            /* Check for interrupt call.  */
+            if (TX_THREAD_GET_SYSTEM_STATE() != ((ULONG) 0))
+            {
+
+                /* Now, make sure the call is from an interrupt and not initialization.  */
+                if (TX_THREAD_GET_SYSTEM_STATE() < TX_INITIALIZE_IN_PROGRESS)
+                {
+
+                    /* Invalid caller of this function, return appropriate error code.  */
+                    status =  TX_CALLER_ERROR;
+                }
+            }
+        }
+    }
+
+    /* Determine if everything is okay.  */
+    if (status == TX_SUCCESS)
+    {
+
+        /* Call actual buffer queue create function.  */
+        status =  _tx_buffer_queue_create(buffer_queue_ptr, name_ptr, queue_start, queue_size);
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
@@ -633,6 +633,31 @@ typedef struct TX_BLOCK_POOL_STRUCT
 } TX_BLOCK_POOL;
 
 
+/* Define the block pool cache structure utilized by the application.  A cache
+   is owned by a single thread and keeps a chain of blocks of its pool, so that
+   most allocations and releases of that thread are done without the SMP
+   protection.  Blocks move between the cache and the pool in batches.  */
+
+typedef struct TX_BLOCK_POOL_CACHE_STRUCT
+{
+
+    /* Define the block pool the blocks of the cache belong to.  */
+    TX_BLOCK_POOL       *tx_block_pool_cache_pool;
+
+    /* Define the head pointer of the blocks in the cache, linked through
+       their block headers as in the available list of the pool.  */
+    UCHAR               *tx_block_pool_cache_list;
+
+    /* Define the number of blocks in the cache.  */
+    UINT                tx_block_pool_cache_count;
+
+    /* Define the number of blocks moved between the cache and the pool
+       at once.  The cache holds at most twice this number.  */
+    UINT                tx_block_pool_cache_batch;
+
+} TX_BLOCK_POOL_CACHE;
+
+
 /* Determine if the byte allocate extension is defined. If not, define the
    extension to whitespace.  */
 
@@ -1026,6 +1051,10 @@ typedef struct TX_SEMAPHORE_STRUCT
 /* Re-map user API to internal API for SMP routines.  */
 
 #ifndef TX_SOURCE_CODE
+#define tx_block_pool_cache_allocate            _tx_block_pool_cache_allocate
+#define tx_block_pool_cache_create              _tx_block_pool_cache_create
+#define tx_block_pool_cache_flush               _tx_block_pool_cache_flush
+#define tx_block_pool_cache_release             _tx_block_pool_cache_release
 #define tx_thread_smp_core_exclude              _tx_thread_smp_core_exclude
 #define tx_thread_smp_core_exclude_get          _tx_thread_smp_core_exclude_get
 #define tx_thread_smp_core_get                  _tx_thread_smp_core_get
@@ -1045,6 +1074,10 @@ extern ULONG volatile  _tx_timer_system_clock;
 
 /* Define all SMP prototypes for calling from C.  */
 
+UINT        _tx_block_pool_cache_allocate(TX_BLOCK_POOL_CACHE *cache_ptr, VOID **block_ptr, ULONG wait_option);
+UINT        _tx_block_pool_cache_create(TX_BLOCK_POOL_CACHE *cache_ptr, TX_BLOCK_POOL *pool_ptr, UINT batch);
+UINT        _tx_block_pool_cache_flush(TX_BLOCK_POOL_CACHE *cache_ptr);
+UINT        _tx_block_pool_cache_release(TX_BLOCK_POOL_CACHE *cache_ptr, VOID *block_ptr);
 UINT        _tx_thread_smp_core_exclude(TX_THREAD *thread_ptr, ULONG exclusion_map);
 UINT        _tx_thread_smp_core_exclude_get(TX_THREAD *thread_ptr, ULONG *exclusion_map_ptr);
 UINT        _tx_thread_smp_core_get(void);
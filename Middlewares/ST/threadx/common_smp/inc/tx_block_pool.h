@@ -88,6 +88,7 @@ VOID        _tx_block_pool_initialize(VOID);
 /* Define internal block memory pool management function prototypes.  */
 
 VOID        _tx_block_pool_cleanup(TX_THREAD *thread_ptr, ULONG suspension_sequence);
+VOID        _tx_block_pool_cache_drain(TX_BLOCK_POOL_CACHE *cache_ptr, UINT count);
 
 
 /* Block pool management component data declarations follow.  */
@@ -63,6 +63,145 @@
 #define TX_BYTE_BLOCK_MIN                       ((ULONG) 20)
 #endif
 
+#ifdef TX_BYTE_POOL_ENABLE_TLSF
+
+/* Define the two-level segregated fit (TLSF) index of the byte pools.  When
+   TX_BYTE_POOL_ENABLE_TLSF is defined, the free blocks of a pool are kept in
+   segregated free lists instead of being searched first-fit, so that the
+   allocation and the release of memory take a bounded time whatever the
+   fragmentation of the pool.  The first level splits the block sizes in
+   powers of two and the second level splits each power of two in
+   TX_BYTE_POOL_TLSF_SL_COUNT lists.  The index is placed at the start of the
+   pool's memory area, the blocks follow it.
+
+   The blocks keep their header, i.e. a pointer to the next block followed by
+   an ALIGN_TYPE holding either TX_BYTE_BLOCK_FREE or the owning pool.  A free
+   block also holds the links of its free list after its header and a pointer
+   to its header in its last word.  The TX_BYTE_BLOCK_PREV_FREE bit of the
+   next block pointer is set when the previous block is free, so that a
+   released block is merged with both of its neighbors.
+
+   A free block is placed after the head of its list when it follows the head
+   in memory, and the head of the list of the requested size is taken when it
+   is large enough, so that the allocations stay towards the start of the
+   pool.  The pool remains more fragmented than with the first-fit search,
+   whose search walks the blocks in address order.  */
+
+#ifndef TX_BYTE_POOL_TLSF_SL_SHIFT
+#define TX_BYTE_POOL_TLSF_SL_SHIFT              ((UINT) 3)
+#endif
+
+#define TX_BYTE_POOL_TLSF_SL_COUNT              (((UINT) 1) << TX_BYTE_POOL_TLSF_SL_SHIFT)
+
+
+/* Define the number of blocks of the list of the requested size that are
+   checked, after its head, when no list holds a block large enough for sure.
+   This bounds the search done with interrupts disabled.  */
+
+#ifndef TX_BYTE_POOL_TLSF_SEARCH_MAX
+#define TX_BYTE_POOL_TLSF_SEARCH_MAX            ((UINT) 4)
+#endif
+
+#define TX_BYTE_BLOCK_PREV_FREE                 ((ALIGN_TYPE) 1)
+
+#define TX_BYTE_POOL_TLSF_BLOCK_MIN             ((ULONG) (((sizeof(UCHAR *)) * ((ULONG) 4)) + (sizeof(ALIGN_TYPE))))
+
+#ifndef TX_BYTE_POOL_MIN
+#define TX_BYTE_POOL_MIN                        ((ULONG) (((ULONG) TX_BYTE_POOL_TLSF_SL_COUNT) * (sizeof(UCHAR *)) * ((ULONG) 16)))
+#endif
+
+
+/* Define the macro that returns the index of the highest bit set.  The
+   value m is destroyed.  It may be defined in tx_port.h with a count
+   leading zeros instruction.  */
+
+#ifndef TX_BYTE_POOL_TLSF_HIGHEST_SET_BIT_CALCULATE
+#define TX_BYTE_POOL_TLSF_HIGHEST_SET_BIT_CALCULATE(m, b) \
+    (b) =  ((UINT) 0);                          \
+    if ((m) >= ((ULONG) 0x10000))               \
+    {                                           \
+        (m) = (m) >> ((ULONG) 16);              \
+        (b) = (b) + ((UINT) 16);                \
+    }                                           \
+    if ((m) >= ((ULONG) 0x100))                 \
+    {                                           \
+        (m) = (m) >> ((ULONG) 8);               \
+        (b) = (b) + ((UINT) 8);                 \
+    }                                           \
+    if ((m) >= ((ULONG) 0x10))                  \
+    {                                           \
+        (m) = (m) >> ((ULONG) 4);               \
+        (b) = (b) + ((UINT) 4);                 \
+    }                                           \
+    if ((m) >= ((ULONG) 4))                     \
+    {                                           \
+        (m) = (m) >> ((ULONG) 2);               \
+        (b) = (b) + ((UINT) 2);                 \
+    }                                           \
+    (b) = (b) + ((UINT) ((m) >> ((ULONG) 1)));
+#endif
+
+
+/* Define the macro that returns the index of the lowest bit set, which uses
+   the port's TX_LOWEST_SET_BIT_CALCULATE when it is available.  The value m
+   is destroyed.  */
+
+#ifndef TX_BYTE_POOL_TLSF_LOWEST_SET_BIT_CALCULATE
+#ifdef TX_LOWEST_SET_BIT_CALCULATE
+#define TX_BYTE_POOL_TLSF_LOWEST_SET_BIT_CALCULATE(m, b)    TX_LOWEST_SET_BIT_CALCULATE(m, b)
+#else
+#define TX_BYTE_POOL_TLSF_LOWEST_SET_BIT_CALCULATE(m, b)  \
+    (m) =  (m) & ((~(m)) + ((ULONG) 1));                  \
+    TX_BYTE_POOL_TLSF_HIGHEST_SET_BIT_CALCULATE(m, b)
+#endif
+#endif
+
+
+/* Define the pointer conversions used on the next block pointers.  */
+
+#ifndef TX_POINTER_TO_ALIGN_TYPE_CONVERT
+#define TX_POINTER_TO_ALIGN_TYPE_CONVERT(a)     ((ALIGN_TYPE) ((VOID *) (a)))
+#endif
+
+#ifndef TX_ALIGN_TYPE_TO_POINTER_CONVERT
+#define TX_ALIGN_TYPE_TO_POINTER_CONVERT(a)     ((VOID *) ((ALIGN_TYPE) (a)))
+#endif
+
+
+/* Define the header of the TLSF index.  */
+
+typedef struct TX_BYTE_POOL_TLSF_STRUCT
+{
+
+    /* Define the first level bitmap, bit n is set when a list of row n is
+       not empty.  */
+    ULONG               tx_byte_pool_tlsf_fl_bitmap;
+
+    /* Define the number of rows of the index, which depends on the size
+       of the pool.  */
+    UINT                tx_byte_pool_tlsf_fl_count;
+
+    /* Define the index of the highest bit of the smallest block size
+       of row 1.  Row 0 holds the smaller blocks.  */
+    UINT                tx_byte_pool_tlsf_fl_shift;
+} TX_BYTE_POOL_TLSF;
+
+
+/* Define a row of the TLSF index, the rows follow the header.  */
+
+typedef struct TX_BYTE_POOL_TLSF_ROW_STRUCT
+{
+
+    /* Define the heads of the free lists of the row.  */
+    UCHAR               *tx_byte_pool_tlsf_free_list[TX_BYTE_POOL_TLSF_SL_COUNT];
+
+    /* Define the second level bitmap, bit n is set when list n is not
+       empty.  */
+    ULONG               tx_byte_pool_tlsf_sl_bitmap;
+} TX_BYTE_POOL_TLSF_ROW;
+
+#endif
+
 #ifndef TX_BYTE_POOL_MIN
 #define TX_BYTE_POOL_MIN                        ((ULONG) 100)
 #endif
@@ -104,6 +243,10 @@ VOID        _tx_byte_pool_initialize(VOID);
 
 UCHAR       *_tx_byte_pool_search(TX_BYTE_POOL *pool_ptr, ULONG memory_size);
 VOID        _tx_byte_pool_cleanup(TX_THREAD *thread_ptr, ULONG suspension_sequence);
+#ifdef TX_BYTE_POOL_ENABLE_TLSF
+VOID        _tx_byte_pool_tlsf_create(TX_BYTE_POOL *pool_ptr);
+VOID        _tx_byte_pool_tlsf_release(TX_BYTE_POOL *pool_ptr, UCHAR *block_ptr);
+#endif
 
 
 /* Byte pool management component data declarations follow.  */
@@ -248,6 +248,20 @@
 #define TX_BYTE_POOL_ENABLE_PERFORMANCE_INFO
 */
 
+/* Determine if the byte pools keep their free blocks in a two-level segregated fit (TLSF) index instead
+   of searching them first-fit. When the following is defined, the allocation and the release of memory
+   take a bounded time whatever the fragmentation of the pool, at a cost in memory:
+     - an index at the start of each pool, about 480 bytes for a 64KB pool on a 32-bit target,
+     - a minimum pool size (TX_BYTE_POOL_MIN) of 512 bytes instead of 100 on a 32-bit target,
+     - a more fragmented pool: with the stress test of utility/benchmarks/byte_pool, 61% of the free
+       bytes are on average outside of the largest block that can be allocated, instead of 55% with
+       the first-fit search. Size the pools accordingly.
+   The file tx_byte_pool_tlsf.c must be part of the ThreadX build. */
+
+/*
+#define TX_BYTE_POOL_ENABLE_TLSF
+*/
+
 /* Determine if event flags performance gathering is required by the application. When the following is
    defined, ThreadX gathers various event flags performance information. */
 
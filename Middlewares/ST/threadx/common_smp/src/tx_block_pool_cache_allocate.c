@@ -0,0 +1,168 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Block Pool                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_block_pool.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_block_pool_cache_allocate                      PORTABLE SMP     */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function allocates a block from the cache of the calling       */
+/*    thread.  An empty cache is refilled with a batch of blocks of the   */
+/*    pool under a single SMP protection.  When the pool has no block     */
+/*    either, the allocation is done by the pool, which suspends the      */
+/*    thread according to the wait option.                                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cache_ptr                         Pointer to cache control block    */
+/*    block_ptr                         Pointer to place allocated block  */
+/*                                        pointer                         */
+/*    wait_option                       Suspension option                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                            Completion status                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_block_allocate                Allocate a block from the pool    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _tx_block_pool_cache_allocate(TX_BLOCK_POOL_CACHE *cache_ptr, VOID **block_ptr, ULONG wait_option)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+UINT                status;
+TX_BLOCK_POOL       *pool_ptr;
+UCHAR               *work_ptr;
+UCHAR               *temp_ptr;
+UCHAR               **next_block_ptr;
+UCHAR               **return_ptr;
+UINT                count;
+
+
+    /* Pickup the pool of the cache.  */
+    pool_ptr =  cache_ptr -> tx_block_pool_cache_pool;
+
+    /* Determine if the cache is empty.  */
+    if (cache_ptr -> tx_block_pool_cache_count == ((UINT) 0))
+    {
+
+        /* Yes, move a batch of blocks from the pool to the cache.  */
+        TX_DISABLE
+
+        /* Find the end of the batch at the head of the available list.  */
+        work_ptr =  pool_ptr -> tx_block_pool_available_list;
+        count =     ((UINT) 0);
+        while ((count < cache_ptr -> tx_block_pool_cache_batch) && (count < pool_ptr -> tx_block_pool_available))
+        {
+
+            /* Move to the next available block.  */
+            next_block_ptr =  TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+            work_ptr =        *next_block_ptr;
+            count++;
+        }
+
+        /* Determine if any block was found.  */
+        if (count != ((UINT) 0))
+        {
+
+            /* Yes, the blocks keep their links, the cache only uses as many
+               of them as its count.  */
+            cache_ptr -> tx_block_pool_cache_list =   pool_ptr -> tx_block_pool_available_list;
+            cache_ptr -> tx_block_pool_cache_count =  count;
+
+            /* Remove the blocks from the pool.  */
+            pool_ptr -> tx_block_pool_available_list =  work_ptr;
+            pool_ptr -> tx_block_pool_available =       pool_ptr -> tx_block_pool_available - count;
+
+#ifdef TX_BLOCK_POOL_ENABLE_PERFORMANCE_INFO
+
+            /* Count the blocks moved to the cache as allocations.  */
+            _tx_block_pool_performance_allocate_count =  _tx_block_pool_performance_allocate_count + ((ULONG) count);
+            pool_ptr -> tx_block_pool_performance_allocate_count =  pool_ptr -> tx_block_pool_performance_allocate_count + ((ULONG) count);
+#endif
+        }
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+    }
+
+    /* Determine if there is a block in the cache.  */
+    if (cache_ptr -> tx_block_pool_cache_count != ((UINT) 0))
+    {
+
+        /* Yes, a block is available.  Decrement the count of the cache.  */
+        cache_ptr -> tx_block_pool_cache_count--;
+
+        /* Pickup the first block of the cache.  */
+        work_ptr =  cache_ptr -> tx_block_pool_cache_list;
+
+        /* Return the block to the caller.  */
+        temp_ptr =  TX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
+        return_ptr =  TX_INDIRECT_VOID_TO_UCHAR_POINTER_CONVERT(block_ptr);
+        *return_ptr =  temp_ptr;
+
+        /* Modify the cache list to point at the next block.  */
+        next_block_ptr =  TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+        cache_ptr -> tx_block_pool_cache_list =  *next_block_ptr;
+
+        /* Save the pool's address in the block, so that it may also be
+           released with tx_block_release.  */
+        temp_ptr =  TX_BLOCK_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
+        *next_block_ptr =  temp_ptr;
+
+        /* Set status to success.  */
+        status =  TX_SUCCESS;
+    }
+    else
+    {
+
+        /* The pool is empty, let it allocate or suspend.  */
+        status =  _tx_block_allocate(pool_ptr, block_ptr, wait_option);
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
+
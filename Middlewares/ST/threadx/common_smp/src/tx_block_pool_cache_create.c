@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Block Pool                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_block_pool.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_block_pool_cache_create                        PORTABLE SMP     */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function creates a block pool cache for the calling thread.    */
+/*    The cache is empty, blocks are moved from the pool on the first     */
+/*    allocation.  Only the thread that uses the cache may access it,     */
+/*    and it must be flushed before the pool is deleted.                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cache_ptr                         Pointer to cache control block    */
+/*    pool_ptr                          Pointer to pool control block     */
+/*    batch                             Number of blocks moved between    */
+/*                                        the cache and the pool at once  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                            Completion status                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _tx_block_pool_cache_create(TX_BLOCK_POOL_CACHE *cache_ptr, TX_BLOCK_POOL *pool_ptr, UINT batch)
+{
+
+UINT        status;
+
+
+    /* Check for an invalid cache pointer.  */
+    if (cache_ptr == TX_NULL)
+    {
+
+        /* Cache pointer is invalid, return appropriate error code.  */
+        status =  TX_PTR_ERROR;
+    }
+
+    /* Check for an invalid pool pointer.  */
+    else if (pool_ptr == TX_NULL)
+    {
+
+        /* Pool pointer is invalid, return appropriate error code.  */
+        status =  TX_POOL_ERROR;
+    }
+
+    /* Now check for invalid pool ID.  */
+    else if (pool_ptr -> tx_block_pool_id != TX_BLOCK_POOL_ID)
+    {
+
+        /* Pool pointer is invalid, return appropriate error code.  */
+        status =  TX_POOL_ERROR;
+    }
+
+    /* Check for an invalid batch.  */
+    else if (batch == ((UINT) 0))
+    {
+
+        /* Batch is invalid, return appropriate error code.  */
+        status =  TX_SIZE_ERROR;
+    }
+    else
+    {
+
+        /* Setup the empty cache.  */
+        cache_ptr -> tx_block_pool_cache_pool =   pool_ptr;
+        cache_ptr -> tx_block_pool_cache_list =   TX_NULL;
+        cache_ptr -> tx_block_pool_cache_count =  ((UINT) 0);
+        cache_ptr -> tx_block_pool_cache_batch =  batch;
+
+        /* Return success.  */
+        status =  TX_SUCCESS;
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
+
@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Block Pool                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_block_pool.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_block_pool_cache_drain                         PORTABLE SMP     */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns blocks from the head of a cache to the pool.  */
+/*    The blocks are put back in the available list under a single SMP    */
+/*    protection.  If threads are suspended on the pool, the blocks are   */
+/*    released one by one so that the threads are resumed.                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cache_ptr                         Pointer to cache control block    */
+/*    count                             Number of blocks to return        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_block_release                 Release a block to its pool       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _tx_block_pool_cache_flush        Flush a block pool cache          */
+/*    _tx_block_pool_cache_release      Release a block to a cache        */
+/*                                                                        */
+/**************************************************************************/
+VOID  _tx_block_pool_cache_drain(TX_BLOCK_POOL_CACHE *cache_ptr, UINT count)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+TX_BLOCK_POOL       *pool_ptr;
+UCHAR               *first_ptr;
+UCHAR               *last_ptr;
+UCHAR               *work_ptr;
+UCHAR               *temp_ptr;
+UCHAR               **next_block_ptr;
+UINT                i;
+
+
+    /* Determine if there is any block to return.  */
+    if (count != ((UINT) 0))
+    {
+
+        /* Pickup the pool of the cache.  */
+        pool_ptr =  cache_ptr -> tx_block_pool_cache_pool;
+
+        /* Find the last block to return.  The cache is only accessed by its
+           thread, no protection is needed for it.  */
+        first_ptr =  cache_ptr -> tx_block_pool_cache_list;
+        last_ptr =   first_ptr;
+        for (i = ((UINT) 1); i < count; i++)
+        {
+
+            next_block_ptr =  TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(last_ptr);
+            last_ptr =        *next_block_ptr;
+        }
+
+        /* Remove the blocks from the cache.  */
+        next_block_ptr =  TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(last_ptr);
+        cache_ptr -> tx_block_pool_cache_list =   *next_block_ptr;
+        cache_ptr -> tx_block_pool_cache_count =  cache_ptr -> tx_block_pool_cache_count - count;
+
+        /* Disable interrupts to put the blocks back in the pool.  */
+        TX_DISABLE
+
+        /* Determine if there are any threads suspended on the block pool.  */
+        if (pool_ptr -> tx_block_pool_suspension_list == TX_NULL)
+        {
+
+            /* No, put the blocks in front of the available list.  */
+            *next_block_ptr =  pool_ptr -> tx_block_pool_available_list;
+            pool_ptr -> tx_block_pool_available_list =  first_ptr;
+            pool_ptr -> tx_block_pool_available =       pool_ptr -> tx_block_pool_available + count;
+
+#ifdef TX_BLOCK_POOL_ENABLE_PERFORMANCE_INFO
+
+            /* Count the blocks returned to the pool as releases.  */
+            _tx_block_pool_performance_release_count =  _tx_block_pool_performance_release_count + ((ULONG) count);
+            pool_ptr -> tx_block_pool_performance_release_count =  pool_ptr -> tx_block_pool_performance_release_count + ((ULONG) count);
+#endif
+
+            /* Restore interrupts.  */
+            TX_RESTORE
+        }
+        else
+        {
+
+            /* Restore interrupts.  */
+            TX_RESTORE
+
+            /* Release the blocks one by one to resume the suspended threads.  */
+            *next_block_ptr =  TX_NULL;
+            work_ptr =         first_ptr;
+            while (work_ptr != TX_NULL)
+            {
+
+                /* Pickup the next block and save the pool's address in this one.  */
+                next_block_ptr =  TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+                temp_ptr =        *next_block_ptr;
+                *next_block_ptr =  TX_BLOCK_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
+
+                /* Release the block.  */
+                work_ptr =  TX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
+                (VOID) _tx_block_release(TX_UCHAR_TO_VOID_POINTER_CONVERT(work_ptr));
+
+                /* Move to the next block.  */
+                work_ptr =  temp_ptr;
+            }
+        }
+    }
+}
+
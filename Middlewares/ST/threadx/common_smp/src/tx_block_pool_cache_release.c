@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Block Pool                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_block_pool.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_block_pool_cache_release                       PORTABLE SMP     */
+/*                                                           6.1.12       */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns a block to the cache of the calling thread.   */
+/*    When the cache holds twice its batch, a batch of blocks is          */
+/*    returned to the pool.  A block of another pool is released to that  */
+/*    pool.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cache_ptr                         Pointer to cache control block    */
+/*    block_ptr                         Pointer to memory block           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                            Completion status                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _tx_block_release                 Release a block to its pool       */
+/*    _tx_block_pool_cache_drain        Return blocks to the pool         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/**************************************************************************/
+UINT  _tx_block_pool_cache_release(TX_BLOCK_POOL_CACHE *cache_ptr, VOID *block_ptr)
+{
+
+UINT                status;
+TX_BLOCK_POOL       *pool_ptr;
+UCHAR               *work_ptr;
+UCHAR               **next_block_ptr;
+
+
+    /* Pickup the pool pointer which is just previous to the starting
+       address of the block that the caller sees.  */
+    work_ptr =        TX_VOID_TO_UCHAR_POINTER_CONVERT(block_ptr);
+    work_ptr =        TX_UCHAR_POINTER_SUB(work_ptr, (sizeof(UCHAR *)));
+    next_block_ptr =  TX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+    pool_ptr =        TX_UCHAR_TO_BLOCK_POOL_POINTER_CONVERT((*next_block_ptr));
+
+    /* Determine if the block belongs to the pool of the cache.  */
+    if (pool_ptr != cache_ptr -> tx_block_pool_cache_pool)
+    {
+
+        /* No, release it to its own pool.  */
+        status =  _tx_block_release(block_ptr);
+    }
+    else
+    {
+
+        /* Put the block at the head of the cache.  */
+        *next_block_ptr =  cache_ptr -> tx_block_pool_cache_list;
+        cache_ptr -> tx_block_pool_cache_list =  work_ptr;
+        cache_ptr -> tx_block_pool_cache_count++;
+
+        /* Determine if the cache is full.  */
+        if (cache_ptr -> tx_block_pool_cache_count >= ((cache_ptr -> tx_block_pool_cache_batch) << 1))
+        {
+
+            /* Yes, return a batch of blocks to the pool.  */
+            _tx_block_pool_cache_drain(cache_ptr, cache_ptr -> tx_block_pool_cache_batch);
+        }
+
+        /* Set status to success.  */
+        status =  TX_SUCCESS;
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
+
@@ -79,11 +79,13 @@ UINT  _tx_byte_pool_create(TX_BYTE_POOL *pool_ptr, CHAR *name_ptr, VOID *pool_st
 TX_INTERRUPT_SAVE_AREA
 
 UCHAR               *block_ptr;
+#ifndef TX_BYTE_POOL_ENABLE_TLSF
 UCHAR               **block_indirect_ptr;
 UCHAR               *temp_ptr;
+ALIGN_TYPE          *free_ptr;
+#endif
 TX_BYTE_POOL        *next_pool;
 TX_BYTE_POOL        *previous_pool;
-ALIGN_TYPE          *free_ptr;
 
 
     /* Initialize the byte pool control block to all zeros.  */
@@ -100,6 +102,8 @@ ALIGN_TYPE          *free_ptr;
     pool_ptr -> tx_byte_pool_start =   TX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
     pool_ptr -> tx_byte_pool_size =    pool_size;
 
+#ifndef TX_BYTE_POOL_ENABLE_TLSF
+
     /* Setup memory list to the beginning as well as the search pointer.  */
     pool_ptr -> tx_byte_pool_list =    TX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
     pool_ptr -> tx_byte_pool_search =  TX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
@@ -139,6 +143,13 @@ ALIGN_TYPE          *free_ptr;
     block_ptr =            TX_UCHAR_POINTER_ADD(block_ptr, (sizeof(UCHAR *)));
     free_ptr =             TX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(block_ptr);
     *free_ptr =            TX_BYTE_BLOCK_FREE;
+#else
+
+    /* Build the TLSF index at the beginning of the pool, followed by one large
+       available block and the small allocated block at the end of the pool.  */
+    _tx_byte_pool_tlsf_create(pool_ptr);
+    block_ptr =  pool_ptr -> tx_byte_pool_list;
+#endif
 
     /* Clear the owner id.  */
     pool_ptr -> tx_byte_pool_owner =  TX_NULL;
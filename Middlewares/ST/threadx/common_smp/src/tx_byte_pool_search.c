@@ -30,6 +30,8 @@
 #include "tx_byte_pool.h"
 
 
+#ifndef TX_BYTE_POOL_ENABLE_TLSF
+
 /**************************************************************************/
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
@@ -390,3 +392,4 @@ UINT            blocks_searched =  ((UINT) 0);
     return(current_ptr);
 }
 
+#endif
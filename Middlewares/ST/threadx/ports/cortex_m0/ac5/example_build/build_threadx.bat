@@ -29,6 +29,7 @@ armcc -c -g --cpu=cortex-m0 -I../inc -I../../../../common/inc ../../../../common
 armcc -c -g --cpu=cortex-m0 -I../inc -I../../../../common/inc ../../../../common/src/tx_byte_pool_performance_system_info_get.c
 armcc -c -g --cpu=cortex-m0 -I../inc -I../../../../common/inc ../../../../common/src/tx_byte_pool_prioritize.c
 armcc -c -g --cpu=cortex-m0 -I../inc -I../../../../common/inc ../../../../common/src/tx_byte_pool_search.c
+armcc -c -g --cpu=cortex-m0 -I../inc -I../../../../common/inc ../../../../common/src/tx_byte_pool_tlsf.c
 armcc -c -g --cpu=cortex-m0 -I../inc -I../../../../common/inc ../../../../common/src/tx_byte_release.c
 armcc -c -g --cpu=cortex-m0 -I../inc -I../../../../common/inc ../../../../common/src/tx_event_flags_cleanup.c
 armcc -c -g --cpu=cortex-m0 -I../inc -I../../../../common/inc ../../../../common/src/tx_event_flags_create.c
@@ -199,7 +200,7 @@ armar -r tx.a tx_block_allocate.o tx_block_pool_cleanup.o tx_block_pool_create.o
 armar -r tx.a tx_block_pool_initialize.o tx_block_pool_performance_info_get.o tx_block_pool_performance_system_info_get.o tx_block_pool_prioritize.o
 armar -r tx.a tx_block_release.o tx_byte_allocate.o tx_byte_pool_cleanup.o tx_byte_pool_create.o tx_byte_pool_delete.o tx_byte_pool_info_get.o
 armar -r tx.a tx_byte_pool_initialize.o tx_byte_pool_performance_info_get.o tx_byte_pool_performance_system_info_get.o tx_byte_pool_prioritize.o
-armar -r tx.a tx_byte_pool_search.o tx_byte_release.o tx_event_flags_cleanup.o tx_event_flags_create.o tx_event_flags_delete.o tx_event_flags_get.o
+armar -r tx.a tx_byte_pool_search.o tx_byte_pool_tlsf.o tx_byte_release.o tx_event_flags_cleanup.o tx_event_flags_create.o tx_event_flags_delete.o tx_event_flags_get.o
 armar -r tx.a tx_event_flags_info_get.o tx_event_flags_initialize.o tx_event_flags_performance_info_get.o tx_event_flags_performance_system_info_get.o
 armar -r tx.a tx_event_flags_set.o tx_event_flags_set_notify.o tx_initialize_high_level.o tx_initialize_kernel_enter.o tx_initialize_kernel_setup.o
 armar -r tx.a tx_mutex_cleanup.o tx_mutex_create.o tx_mutex_delete.o tx_mutex_get.o tx_mutex_info_get.o tx_mutex_initialize.o tx_mutex_performance_info_get.o
@@ -22,6 +22,11 @@ tx_block_pool_performance_info_get.c \
 tx_block_pool_performance_system_info_get.c \
 tx_block_pool_prioritize.c \
 tx_block_release.c \
+tx_buffer_queue_create.c \
+tx_buffer_queue_delete.c \
+tx_buffer_queue_flush.c \
+tx_buffer_queue_receive.c \
+tx_buffer_queue_send.c \
 tx_byte_allocate.c \
 tx_byte_pool_cleanup.c \
 tx_byte_pool_create.c \
@@ -32,6 +37,7 @@ tx_byte_pool_performance_info_get.c \
 tx_byte_pool_performance_system_info_get.c \
 tx_byte_pool_prioritize.c \
 tx_byte_pool_search.c \
+tx_byte_pool_tlsf.c \
 tx_byte_release.c \
 txe_block_allocate.c \
 txe_block_pool_create.c \
@@ -39,6 +45,11 @@ txe_block_pool_delete.c \
 txe_block_pool_info_get.c \
 txe_block_pool_prioritize.c \
 txe_block_release.c \
+txe_buffer_queue_create.c \
+txe_buffer_queue_delete.c \
+txe_buffer_queue_flush.c \
+txe_buffer_queue_receive.c \
+txe_buffer_queue_send.c \
 txe_byte_allocate.c \
 txe_byte_pool_create.c \
 txe_byte_pool_delete.c \
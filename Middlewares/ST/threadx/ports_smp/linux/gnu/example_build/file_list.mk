@@ -22,6 +22,11 @@ LINUX_OBJS = $(LINUX_SRCS:%.c=.tmp/%.o)
 
 GENERIC_SRCS = \
 tx_block_allocate.c \
+tx_block_pool_cache_allocate.c \
+tx_block_pool_cache_create.c \
+tx_block_pool_cache_drain.c \
+tx_block_pool_cache_flush.c \
+tx_block_pool_cache_release.c \
 tx_block_pool_cleanup.c \
 tx_block_pool_create.c \
 tx_block_pool_delete.c \
@@ -41,6 +46,7 @@ tx_byte_pool_performance_info_get.c \
 tx_byte_pool_performance_system_info_get.c \
 tx_byte_pool_prioritize.c \
 tx_byte_pool_search.c \
+tx_byte_pool_tlsf.c \
 tx_byte_release.c \
 txe_block_allocate.c \
 txe_block_pool_create.c \
@@ -0,0 +1,297 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** Block Pool SMP Benchmark                                              */
+/**                                                                       */
+/**   Allocation Throughput (ThreadX SMP Linux)                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* This file measures the block allocations per second of one to
+   TX_THREAD_SMP_MAX_CORES threads, each bound to its own core, sharing one
+   block pool as packet buffers would be:
+
+   usage: bps_benchmark [-t threads] [-n operations] [-d depth]
+                        [-b cache batch] [-c csv file]
+
+   Each thread allocates depth blocks then releases them, until it has done
+   the given number of allocations.  With a batch of 0 the threads call
+   tx_block_allocate and tx_block_release, which take the SMP protection each
+   time.  Otherwise each thread has a block pool cache of that batch and
+   calls tx_block_pool_cache_allocate and tx_block_pool_cache_release.
+
+   The time is measured on the host clock from the start of the first thread
+   to the end of the last one.  At the end, the pool shall have all its
+   blocks back.  */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <time.h>
+#include    <unistd.h>
+#include    "tx_api.h"
+
+
+/* Define the default parameters of the run.  */
+
+#define BPS_THREADS                     TX_THREAD_SMP_MAX_CORES
+#define BPS_OPERATIONS                  200000
+#define BPS_DEPTH                       4
+#define BPS_BATCH                       16
+#define BPS_BLOCK_SIZE                  64
+#define BPS_DEPTH_MAX                   64
+
+
+/* Define the stack of the threads.  */
+
+#define BPS_STACK_SIZE                  16384
+
+
+/* Define the options and the state of the run.  */
+
+static unsigned long        bps_threads =     BPS_THREADS;
+static unsigned long        bps_operations =  BPS_OPERATIONS;
+static unsigned long        bps_depth =       BPS_DEPTH;
+static unsigned long        bps_batch =       BPS_BATCH;
+static const char          *bps_csv_file;
+
+static TX_THREAD            bps_control_thread;
+static TX_THREAD            bps_worker_threads[TX_THREAD_SMP_MAX_CORES];
+static TX_BLOCK_POOL_CACHE  bps_caches[TX_THREAD_SMP_MAX_CORES];
+static TX_BLOCK_POOL        bps_pool;
+static TX_SEMAPHORE         bps_done;
+static ULONG                bps_control_stack[BPS_STACK_SIZE/sizeof(ULONG)];
+static ULONG                bps_worker_stacks[TX_THREAD_SMP_MAX_CORES][BPS_STACK_SIZE/sizeof(ULONG)];
+static UCHAR               *bps_pool_memory;
+static ULONG                bps_pool_size;
+static unsigned long        bps_errors[TX_THREAD_SMP_MAX_CORES];
+
+
+static unsigned long    bps_time_get(void)
+{
+
+struct timespec     now;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return((unsigned long) now.tv_sec*1000000000UL + (unsigned long) now.tv_nsec);
+}
+
+
+static void     bps_worker_entry(ULONG id)
+{
+
+VOID           *blocks[BPS_DEPTH_MAX];
+unsigned long   operation;
+unsigned long   i;
+UINT            status;
+
+
+    if (bps_batch != 0)
+        tx_block_pool_cache_create(&bps_caches[id], &bps_pool, (UINT) bps_batch);
+
+    operation =  0;
+    while (operation < bps_operations)
+    {
+
+        for (i = 0; i < bps_depth; i++)
+        {
+
+            if (bps_batch != 0)
+                status =  tx_block_pool_cache_allocate(&bps_caches[id], &blocks[i], TX_NO_WAIT);
+            else
+                status =  tx_block_allocate(&bps_pool, &blocks[i], TX_NO_WAIT);
+
+            /* Write the block as a packet would be.  */
+            if (status == TX_SUCCESS)
+                *((ULONG *) blocks[i]) =  id;
+            else
+            {
+
+                blocks[i] =  TX_NULL;
+                bps_errors[id]++;
+            }
+        }
+
+        for (i = 0; i < bps_depth; i++)
+        {
+
+            if (blocks[i] == TX_NULL)
+                continue;
+            if (*((ULONG *) blocks[i]) != id)
+                bps_errors[id]++;
+
+            if (bps_batch != 0)
+                tx_block_pool_cache_release(&bps_caches[id], blocks[i]);
+            else
+                tx_block_release(blocks[i]);
+        }
+
+        operation =  operation + bps_depth;
+    }
+
+    if (bps_batch != 0)
+        tx_block_pool_cache_flush(&bps_caches[id]);
+
+    tx_semaphore_put(&bps_done);
+}
+
+
+static void     bps_control_entry(ULONG id)
+{
+
+unsigned long   start;
+unsigned long   stop;
+unsigned long   errors;
+unsigned long   allocations;
+double          seconds;
+double          rate;
+ULONG           available;
+ULONG           total;
+FILE           *file;
+unsigned long   i;
+
+
+    TX_PARAMETER_NOT_USED(id);
+
+    /* Start the workers, each one on its own core.  */
+    start =  bps_time_get();
+    for (i = 0; i < bps_threads; i++)
+        tx_thread_resume(&bps_worker_threads[i]);
+
+    /* Wait for all of them.  */
+    for (i = 0; i < bps_threads; i++)
+        tx_semaphore_get(&bps_done, TX_WAIT_FOREVER);
+    stop =  bps_time_get();
+
+    errors =  0;
+    for (i = 0; i < bps_threads; i++)
+        errors =  errors + bps_errors[i];
+    tx_block_pool_info_get(&bps_pool, TX_NULL, &available, &total, TX_NULL, TX_NULL, TX_NULL);
+    if (available != total)
+        errors++;
+
+    allocations =  bps_threads*(((bps_operations + bps_depth - 1)/bps_depth)*bps_depth);
+    seconds =      (double) (stop - start)/1e9;
+    rate =         (seconds > 0.0) ? (double) allocations/seconds : 0.0;
+
+    printf("Block pool SMP benchmark, %s: %lu threads, %lu allocations, depth %lu\n",
+           (bps_batch != 0) ? "cache" : "pool", bps_threads, allocations, bps_depth);
+    if (bps_batch != 0)
+        printf("cache batch %lu\n", bps_batch);
+    printf("%.3f s, %.0f allocations/s, %.0f allocations/s per thread, %lu errors, %lu of %lu blocks back in the pool\n",
+           seconds, rate, rate/(double) bps_threads, errors, (unsigned long) available, (unsigned long) total);
+
+    if (bps_csv_file != NULL)
+    {
+
+        file =  fopen(bps_csv_file, "a");
+        if (file != NULL)
+        {
+
+            if (ftell(file) == 0)
+                fprintf(file, "mode,threads,allocations,depth,batch,seconds,allocations_per_second,errors\n");
+            fprintf(file, "%s,%lu,%lu,%lu,%lu,%.3f,%.0f,%lu\n", (bps_batch != 0) ? "cache" : "pool",
+                    bps_threads, allocations, bps_depth, bps_batch, seconds, rate, errors);
+            fclose(file);
+        }
+    }
+
+    fflush(stdout);
+    exit((errors != 0) ? 1 : 0);
+}
+
+
+int main(int argc, char **argv)
+{
+
+int     option;
+
+
+    while ((option =  getopt(argc, argv, "t:n:d:b:c:")) != -1)
+    {
+
+        switch (option)
+        {
+
+        case 't':
+            bps_threads =  strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            bps_operations =  strtoul(optarg, NULL, 0);
+            break;
+        case 'd':
+            bps_depth =  strtoul(optarg, NULL, 0);
+            break;
+        case 'b':
+            bps_batch =  strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            bps_csv_file =  optarg;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-t threads] [-n operations] [-d depth] [-b cache batch] [-c csv file]\n", argv[0]);
+            return(1);
+        }
+    }
+
+    /* Each thread may hold its blocks and a full cache.  */
+    bps_pool_size =    (ULONG) (bps_threads*(bps_depth + 2*bps_batch)*(BPS_BLOCK_SIZE + sizeof(VOID *)));
+    bps_pool_memory =  malloc(bps_pool_size);
+    if ((bps_threads == 0) || (bps_threads > TX_THREAD_SMP_MAX_CORES) || (bps_depth == 0) ||
+        (bps_depth > BPS_DEPTH_MAX) || (bps_pool_memory == NULL))
+    {
+
+        fprintf(stderr, "invalid parameters, 1 to %d threads and 1 to %d blocks deep\n", TX_THREAD_SMP_MAX_CORES, BPS_DEPTH_MAX);
+        return(1);
+    }
+
+    /* Enter the ThreadX kernel.  */
+    tx_kernel_enter();
+
+    return(0);
+}
+
+
+/* Define what the initial system looks like.  */
+
+void    tx_application_define(void *first_unused_memory)
+{
+
+ULONG   i;
+
+
+    TX_PARAMETER_NOT_USED(first_unused_memory);
+
+    if (tx_block_pool_create(&bps_pool, "benchmark pool", BPS_BLOCK_SIZE, bps_pool_memory, bps_pool_size) != TX_SUCCESS)
+    {
+
+        fprintf(stderr, "the pool cannot be created\n");
+        exit(1);
+    }
+
+    tx_semaphore_create(&bps_done, "done", 0);
+
+    for (i = 0; i < bps_threads; i++)
+    {
+
+        tx_thread_create(&bps_worker_threads[i], "worker", bps_worker_entry, i, bps_worker_stacks[i], BPS_STACK_SIZE,
+                         16, 16, TX_NO_TIME_SLICE, TX_DONT_START);
+        tx_thread_smp_core_exclude(&bps_worker_threads[i], ~(((ULONG) 1) << i) & ((((ULONG) 1) << TX_THREAD_SMP_MAX_CORES) - 1));
+    }
+
+    tx_thread_create(&bps_control_thread, "control", bps_control_entry, 0, bps_control_stack, sizeof(bps_control_stack),
+                     1, 1, TX_NO_TIME_SLICE, TX_AUTO_START);
+}
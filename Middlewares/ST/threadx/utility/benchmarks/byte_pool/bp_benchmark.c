@@ -0,0 +1,458 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** Byte Pool Benchmark                                                   */
+/**                                                                       */
+/**   Allocation Stress Test (ThreadX Linux)                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* This file stresses a byte pool with a mix of packet sizes allocated and
+   released in a random order, as a network stack would, and reports the
+   latency percentiles of tx_byte_allocate and tx_byte_release along with the
+   fragmentation of the pool.  It is built once with the first-fit search
+   (bp_first_fit) and once with TX_BYTE_POOL_ENABLE_TLSF (bp_tlsf):
+
+   usage: bp_<search> [-n operations] [-s pool size] [-l live blocks]
+                      [-r seed] [-c csv file]
+
+   Each operation picks one of the live blocks: it is released if it is
+   allocated, otherwise a block of a random size is allocated.  The first
+   tenth of the operations is not measured, so that the pool reaches a steady
+   fragmentation.  The latencies are measured on the host clock, the number
+   of fragments searched by each allocation is read from the performance
+   information of the pool and does not depend on the host.
+
+   The fragmentation is sampled BP_SAMPLE_COUNT times during the measured
+   operations: the largest block that can still be allocated is compared with
+   the free bytes, the fragmentation being the part of the free bytes that is
+   not in that block.  */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <time.h>
+#include    <unistd.h>
+#include    "tx_api.h"
+
+
+/* Define the name of the search, set by the Makefile.  */
+
+#ifndef BP_SEARCH
+#define BP_SEARCH                       "unknown"
+#endif
+
+
+/* Define the default parameters of the run.  */
+
+#define BP_OPERATIONS                   200000
+#define BP_POOL_SIZE                    (256*1024)
+#define BP_LIVE_BLOCKS                  512
+#define BP_SEED                         1
+
+
+/* Define the mix of sizes: the share of each class in percent, and its
+   smallest and largest size.  */
+
+typedef struct BP_SIZE_CLASS_STRUCT
+{
+    unsigned        share;
+    unsigned long   minimum;
+    unsigned long   maximum;
+} BP_SIZE_CLASS;
+
+static const BP_SIZE_CLASS bp_size_classes[] =
+{
+    { 45,   16,     96 },       /* Control packets and descriptors  */
+    { 30,   128,    512 },      /* Small payloads  */
+    { 20,   1024,   1536 },     /* Full frames  */
+    { 5,    2048,   8192 },     /* Reassembly buffers  */
+};
+
+
+/* Define the number of fragmentation samples.  */
+
+#define BP_SAMPLE_COUNT                 200
+
+
+/* Define the stack of the benchmark thread.  */
+
+#define BP_STACK_SIZE                   16384
+
+
+/* Define the percentiles reported.  */
+
+static const double bp_percentiles[] =  { 50.0, 90.0, 99.0, 99.9 };
+
+#define BP_PERCENTILE_COUNT             (sizeof(bp_percentiles)/sizeof(bp_percentiles[0]))
+
+
+/* Define the options and the state of the run.  */
+
+static unsigned long    bp_operations =     BP_OPERATIONS;
+static unsigned long    bp_pool_size =      BP_POOL_SIZE;
+static unsigned long    bp_live_blocks =    BP_LIVE_BLOCKS;
+static unsigned long    bp_seed =           BP_SEED;
+static unsigned long    bp_start_seed;
+static const char      *bp_csv_file;
+
+static TX_THREAD        bp_thread;
+static TX_BYTE_POOL     bp_pool;
+static ULONG            bp_thread_stack[BP_STACK_SIZE/sizeof(ULONG)];
+static UCHAR           *bp_pool_memory;
+
+static VOID           **bp_blocks;
+static unsigned long   *bp_allocate_times;
+static unsigned long   *bp_release_times;
+static unsigned long   *bp_searches;
+static unsigned long    bp_allocate_count;
+static unsigned long    bp_release_count;
+static unsigned long    bp_failure_count;
+static double           bp_fragmentation_sum;
+static double           bp_fragmentation_max;
+static unsigned long    bp_fragments_sum;
+static unsigned long    bp_sample_count;
+
+
+/* Return a pseudo-random number, the same sequence for both searches.  */
+
+static unsigned long    bp_random(void)
+{
+
+    bp_seed =  bp_seed ^ (bp_seed << 13);
+    bp_seed =  bp_seed ^ (bp_seed >> 7);
+    bp_seed =  bp_seed ^ (bp_seed << 17);
+    return(bp_seed & 0xFFFFFFFFUL);
+}
+
+
+static unsigned long    bp_size_get(void)
+{
+
+unsigned long   draw;
+unsigned        i;
+
+
+    draw =  bp_random() % 100;
+    for (i = 0; i < (sizeof(bp_size_classes)/sizeof(bp_size_classes[0])) - 1; i++)
+    {
+
+        if (draw < bp_size_classes[i].share)
+            break;
+        draw =  draw - bp_size_classes[i].share;
+    }
+
+    return(bp_size_classes[i].minimum + (bp_random() % (bp_size_classes[i].maximum - bp_size_classes[i].minimum + 1)));
+}
+
+
+static unsigned long    bp_time_get(void)
+{
+
+struct timespec     now;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return((unsigned long) now.tv_sec*1000000000UL + (unsigned long) now.tv_nsec);
+}
+
+
+static ULONG    bp_search_count_get(void)
+{
+
+ULONG   searches;
+
+
+    tx_byte_pool_performance_info_get(&bp_pool, TX_NULL, TX_NULL, &searches, TX_NULL, TX_NULL, TX_NULL, TX_NULL);
+    return(searches);
+}
+
+
+static int      bp_compare(const void *a, const void *b)
+{
+
+unsigned long   first =   *((const unsigned long *) a);
+unsigned long   second =  *((const unsigned long *) b);
+
+
+    return((first > second) - (first < second));
+}
+
+
+/* Sort the samples and return the given percentile.  */
+
+static unsigned long    bp_percentile(unsigned long *samples, unsigned long count, double percentile)
+{
+
+unsigned long   index;
+
+
+    if (count == 0)
+        return(0);
+
+    index =  (unsigned long) ((percentile*(double) count)/100.0);
+    if (index >= count)
+        index =  count - 1;
+    return(samples[index]);
+}
+
+
+static void     bp_report(FILE *file, const char *name, unsigned long *samples, unsigned long count, const char *unit)
+{
+
+unsigned        i;
+
+
+    qsort(samples, count, sizeof(unsigned long), bp_compare);
+    fprintf(file, "%-26s", name);
+    for (i = 0; i < BP_PERCENTILE_COUNT; i++)
+        fprintf(file, " p%-5g %7lu", bp_percentiles[i], bp_percentile(samples, count, bp_percentiles[i]));
+    fprintf(file, "  max %7lu %s\n", (count != 0) ? samples[count - 1] : 0UL, unit);
+}
+
+
+/* Find the largest block that can be allocated, by bisection.  */
+
+static unsigned long    bp_largest_get(void)
+{
+
+unsigned long   low;
+unsigned long   high;
+unsigned long   middle;
+VOID           *block;
+
+
+    low =   0;
+    high =  bp_pool_size;
+    while (low < high)
+    {
+
+        middle =  low + (high - low + 1)/2;
+        if (tx_byte_allocate(&bp_pool, &block, (ULONG) middle, TX_NO_WAIT) == TX_SUCCESS)
+        {
+
+            tx_byte_release(block);
+            low =  middle;
+        }
+        else
+            high =  middle - 1;
+    }
+
+    return(low);
+}
+
+
+/* Sample the fragmentation of the pool.  */
+
+static void     bp_sample(void)
+{
+
+ULONG           available;
+ULONG           fragments;
+unsigned long   largest;
+double          fragmentation;
+
+
+    tx_byte_pool_info_get(&bp_pool, TX_NULL, &available, &fragments, TX_NULL, TX_NULL, TX_NULL);
+    largest =        bp_largest_get();
+    fragmentation =  (available != 0) ? 100.0*(1.0 - (double) largest/(double) available) : 0.0;
+
+    bp_fragmentation_sum =  bp_fragmentation_sum + fragmentation;
+    if (fragmentation > bp_fragmentation_max)
+        bp_fragmentation_max =  fragmentation;
+    bp_fragments_sum =  bp_fragments_sum + (unsigned long) fragments;
+    bp_sample_count++;
+}
+
+
+static void     bp_thread_entry(ULONG id)
+{
+
+unsigned long   warm_up;
+unsigned long   operation;
+unsigned long   slot;
+unsigned long   start;
+unsigned long   stop;
+unsigned long   sample_period;
+unsigned long   search_samples[BP_PERCENTILE_COUNT];
+ULONG           searches;
+UINT            status;
+double          fragmentation;
+FILE           *file;
+unsigned        i;
+
+
+    TX_PARAMETER_NOT_USED(id);
+
+    warm_up =        bp_operations/10;
+    sample_period =  (bp_operations - warm_up)/BP_SAMPLE_COUNT;
+    if (sample_period == 0)
+        sample_period =  1;
+    for (operation = 0; operation < bp_operations; operation++)
+    {
+
+        slot =  bp_random() % bp_live_blocks;
+        if (bp_blocks[slot] != TX_NULL)
+        {
+
+            start =  bp_time_get();
+            tx_byte_release(bp_blocks[slot]);
+            stop =   bp_time_get();
+            bp_blocks[slot] =  TX_NULL;
+
+            if (operation >= warm_up)
+                bp_release_times[bp_release_count++] =  stop - start;
+        }
+        else
+        {
+
+            searches =  bp_search_count_get();
+            start =     bp_time_get();
+            status =    tx_byte_allocate(&bp_pool, &bp_blocks[slot], (ULONG) bp_size_get(), TX_NO_WAIT);
+            stop =      bp_time_get();
+
+            if (status != TX_SUCCESS)
+            {
+
+                bp_blocks[slot] =  TX_NULL;
+                if (operation >= warm_up)
+                    bp_failure_count++;
+            }
+
+            if (operation >= warm_up)
+            {
+
+                bp_searches[bp_allocate_count] =        bp_search_count_get() - searches;
+                bp_allocate_times[bp_allocate_count] =  stop - start;
+                bp_allocate_count++;
+            }
+        }
+
+        if ((operation >= warm_up) && (((operation - warm_up) % sample_period) == (sample_period - 1)))
+            bp_sample();
+    }
+
+    fragmentation =  (bp_sample_count != 0) ? bp_fragmentation_sum/(double) bp_sample_count : 0.0;
+
+    printf("Byte pool benchmark, %s search: %lu operations, pool %lu bytes, %lu live blocks, seed %lu\n",
+           BP_SEARCH, bp_operations, bp_pool_size, bp_live_blocks, bp_start_seed);
+    bp_report(stdout, "allocate latency", bp_allocate_times, bp_allocate_count, "ns");
+    bp_report(stdout, "release latency", bp_release_times, bp_release_count, "ns");
+    bp_report(stdout, "allocate searched blocks", bp_searches, bp_allocate_count, "");
+    for (i = 0; i < BP_PERCENTILE_COUNT; i++)
+        search_samples[i] =  bp_percentile(bp_searches, bp_allocate_count, bp_percentiles[i]);
+    printf("failed allocations %lu of %lu\n", bp_failure_count, bp_allocate_count);
+    printf("fragmentation over %lu samples: %.1f%% average, %.1f%% maximum, %lu fragments on average\n",
+           bp_sample_count, fragmentation, bp_fragmentation_max, (bp_sample_count != 0) ? bp_fragments_sum/bp_sample_count : 0UL);
+
+    if (bp_csv_file != NULL)
+    {
+
+        file =  fopen(bp_csv_file, "a");
+        if (file != NULL)
+        {
+
+            if (ftell(file) == 0)
+                fprintf(file, "search,operations,pool_size,live_blocks,allocate_p50_ns,allocate_p99_ns,allocate_p999_ns,allocate_max_ns,"
+                              "release_p50_ns,release_p99_ns,release_max_ns,searched_p50,searched_p99,searched_max,"
+                              "failures,fragments_average,fragmentation_average_percent,fragmentation_max_percent\n");
+            fprintf(file, "%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%.1f,%.1f\n",
+                    BP_SEARCH, bp_operations, bp_pool_size, bp_live_blocks,
+                    bp_percentile(bp_allocate_times, bp_allocate_count, 50.0), bp_percentile(bp_allocate_times, bp_allocate_count, 99.0),
+                    bp_percentile(bp_allocate_times, bp_allocate_count, 99.9), (bp_allocate_count != 0) ? bp_allocate_times[bp_allocate_count - 1] : 0UL,
+                    bp_percentile(bp_release_times, bp_release_count, 50.0), bp_percentile(bp_release_times, bp_release_count, 99.0),
+                    (bp_release_count != 0) ? bp_release_times[bp_release_count - 1] : 0UL,
+                    search_samples[0], search_samples[2], (bp_allocate_count != 0) ? bp_searches[bp_allocate_count - 1] : 0UL,
+                    bp_failure_count, (bp_sample_count != 0) ? bp_fragments_sum/bp_sample_count : 0UL, fragmentation, bp_fragmentation_max);
+            fclose(file);
+        }
+    }
+
+    fflush(stdout);
+    exit(0);
+}
+
+
+int main(int argc, char **argv)
+{
+
+int     option;
+
+
+    while ((option =  getopt(argc, argv, "n:s:l:r:c:")) != -1)
+    {
+
+        switch (option)
+        {
+
+        case 'n':
+            bp_operations =  strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            bp_pool_size =  strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            bp_live_blocks =  strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            bp_seed =  strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            bp_csv_file =  optarg;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n operations] [-s pool size] [-l live blocks] [-r seed] [-c csv file]\n", argv[0]);
+            return(1);
+        }
+    }
+
+    bp_start_seed =      bp_seed;
+    bp_pool_memory =     malloc(bp_pool_size);
+    bp_blocks =          calloc(bp_live_blocks, sizeof(VOID *));
+    bp_allocate_times =  malloc(bp_operations*sizeof(unsigned long));
+    bp_release_times =   malloc(bp_operations*sizeof(unsigned long));
+    bp_searches =        malloc(bp_operations*sizeof(unsigned long));
+    if ((bp_seed == 0) || (bp_live_blocks == 0) || (bp_pool_memory == NULL) || (bp_blocks == NULL) ||
+        (bp_allocate_times == NULL) || (bp_release_times == NULL) || (bp_searches == NULL))
+    {
+
+        fprintf(stderr, "invalid parameters\n");
+        return(1);
+    }
+
+    /* Enter the ThreadX kernel.  */
+    tx_kernel_enter();
+
+    return(0);
+}
+
+
+/* Define what the initial system looks like.  */
+
+void    tx_application_define(void *first_unused_memory)
+{
+
+    TX_PARAMETER_NOT_USED(first_unused_memory);
+
+    if (tx_byte_pool_create(&bp_pool, "benchmark pool", bp_pool_memory, (ULONG) bp_pool_size) != TX_SUCCESS)
+    {
+
+        fprintf(stderr, "the pool cannot be created\n");
+        exit(1);
+    }
+
+    tx_thread_create(&bp_thread, "benchmark", bp_thread_entry, 0, bp_thread_stack, sizeof(bp_thread_stack),
+                     16, 16, TX_NO_TIME_SLICE, TX_AUTO_START);
+}
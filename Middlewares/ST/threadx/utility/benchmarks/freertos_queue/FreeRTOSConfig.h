@@ -0,0 +1,46 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FreeRTOS Queue Benchmark                                              */
+/**                                                                       */
+/**   FreeRTOS Adaptation Layer Configuration (ThreadX Linux)             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configTICK_RATE_HZ                         (100u)
+#define configMAX_PRIORITIES                       (32u)
+#define configMINIMAL_STACK_SIZE                   (4096u)
+#define configTOTAL_HEAP_SIZE                      (1024u * 256u)
+#define configUSE_16_BIT_TICKS                      0
+#define configSTACK_DEPTH_TYPE                     uint32_t
+
+#define INCLUDE_vTaskDelete                     1
+
+#define configASSERT(x)
+#define TX_FREERTOS_ASSERT_FAIL()
+#define TX_FREERTOS_AUTO_INIT 0
+
+/* TX_FREERTOS_NATIVE_QUEUE is set by the makefile, 0 for the layered queue and 1 for the native queue.  */
+
+/* The Linux port has no interrupt to disable, the benchmark does not use these macros.  */
+#define taskENTER_CRITICAL_FROM_ISR()   0
+#define taskEXIT_CRITICAL_FROM_ISR(x)   (void) (x)
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+
+#endif /* #ifndef FREERTOS_CONFIG_H */
@@ -0,0 +1,401 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FreeRTOS Queue Benchmark                                              */
+/**                                                                       */
+/**   Message Throughput and Latency (ThreadX Linux)                      */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* This file measures the messages per second and the latency of the
+   FreeRTOS queue API.  It is built three times: on the FreeRTOS adaptation
+   layer with TX_FREERTOS_NATIVE_QUEUE set to 0 (two semaphores per queue)
+   and to 1 (one ThreadX queue), and with FQ_FREERTOS_KERNEL on the FreeRTOS
+   queue.c, run from main() by a host port without a scheduler:
+
+   usage: fq_benchmark_<implementation> [-m mode] [-n messages] [-s item size]
+                                        [-l queue length] [-c csv file]
+
+   The modes are:
+
+     send       a task sends an item to the back of the queue and receives it
+     front      the queue holds one item, a task sends an item to the front
+                of the queue and receives it
+     set        the queue is in a queue set, a task sends an item, selects
+                the queue from the set and receives the item
+     pingpong   a task sends an item to a higher priority task that sends it
+                back on a second queue, both wait forever, which needs a
+                scheduler: not on the FreeRTOS kernel
+
+   The messages per second are measured on the host clock over the given
+   number of messages.  Then the send and the receive of up to
+   FQ_SAMPLES messages are timed one by one for their median and 99th
+   percentile; in pingpong mode the receive is the wait for the reply.  Every
+   item received shall be the one expected.  */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <time.h>
+#include    <unistd.h>
+#include    "FreeRTOS.h"
+#include    "task.h"
+#include    "queue.h"
+
+
+/* Define the default parameters of the run.  */
+
+#define FQ_MODE                         "send"
+#define FQ_MESSAGES                     1000000
+#define FQ_ITEM_SIZE                    16
+#define FQ_LENGTH                       8
+#define FQ_ITEM_MAX                     256
+#define FQ_SAMPLES                      100000
+
+
+/* Define the stack of the tasks, in words.  */
+
+#define FQ_STACK_SIZE                   4096
+
+
+#ifdef FQ_FREERTOS_KERNEL
+#define FQ_IMPLEMENTATION               "freertos"
+#elif (TX_FREERTOS_NATIVE_QUEUE == 1)
+#define FQ_IMPLEMENTATION               "native"
+#else
+#define FQ_IMPLEMENTATION               "layered"
+#endif
+
+
+/* Define the options and the state of the run.  */
+
+static const char          *fq_mode =       FQ_MODE;
+static unsigned long        fq_messages =   FQ_MESSAGES;
+static unsigned long        fq_item_size =  FQ_ITEM_SIZE;
+static unsigned long        fq_length =     FQ_LENGTH;
+static const char          *fq_csv_file;
+
+static QueueHandle_t        fq_queue;
+static QueueHandle_t        fq_reply_queue;
+static QueueSetHandle_t     fq_set;
+static TaskHandle_t         fq_task;
+static TaskHandle_t         fq_echo_task;
+static unsigned long        fq_errors;
+static unsigned long        fq_send_samples[FQ_SAMPLES];
+static unsigned long        fq_receive_samples[FQ_SAMPLES];
+
+
+static unsigned long    fq_time_get(void)
+{
+
+struct timespec     now;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return((unsigned long) now.tv_sec*1000000000UL + (unsigned long) now.tv_nsec);
+}
+
+
+static int      fq_compare(const void *first, const void *second)
+{
+
+unsigned long   a =  *((const unsigned long *) first);
+unsigned long   b =  *((const unsigned long *) second);
+
+
+    return((a > b) - (a < b));
+}
+
+
+static unsigned long    fq_percentile(unsigned long *samples, unsigned long count, unsigned long percent)
+{
+
+    if (count == 0)
+        return(0);
+    return(samples[((count - 1)*percent)/100]);
+}
+
+
+/* Exchange one message in the given mode, timing the send and the receive
+   when the time pointers are not NULL.  */
+
+static void     fq_exchange(unsigned long sequence, unsigned long *send_time, unsigned long *receive_time)
+{
+
+uint32_t        item[FQ_ITEM_MAX/sizeof(uint32_t)];
+uint32_t        received[FQ_ITEM_MAX/sizeof(uint32_t)];
+unsigned long   start;
+unsigned long   middle;
+BaseType_t      status;
+
+
+    item[0] =  (uint32_t) sequence;
+
+    start =  (send_time != NULL) ? fq_time_get() : 0;
+    if (strcmp(fq_mode, "front") == 0)
+        status =  xQueueSendToFront(fq_queue, item, 0);
+    else if (strcmp(fq_mode, "pingpong") == 0)
+        status =  xQueueSend(fq_queue, item, portMAX_DELAY);
+    else
+        status =  xQueueSend(fq_queue, item, 0);
+    middle =  (send_time != NULL) ? fq_time_get() : 0;
+    if (status != pdPASS)
+        fq_errors++;
+
+    received[0] =  ~item[0];
+    if (strcmp(fq_mode, "set") == 0)
+    {
+
+        if (xQueueSelectFromSet(fq_set, 0) != (QueueSetMemberHandle_t) fq_queue)
+            fq_errors++;
+        status =  xQueueReceive(fq_queue, received, 0);
+    }
+    else if (strcmp(fq_mode, "pingpong") == 0)
+        status =  xQueueReceive(fq_reply_queue, received, portMAX_DELAY);
+    else
+        status =  xQueueReceive(fq_queue, received, 0);
+    if (send_time != NULL)
+    {
+
+        *send_time =     middle - start;
+        *receive_time =  fq_time_get() - middle;
+    }
+    if ((status != pdPASS) || (received[0] != item[0]))
+        fq_errors++;
+}
+
+
+#ifndef FQ_FREERTOS_KERNEL
+static void     fq_echo_entry(void *parameter)
+{
+
+uint32_t        item[FQ_ITEM_MAX/sizeof(uint32_t)];
+
+
+    (void) parameter;
+    for (;;)
+    {
+
+        if (xQueueReceive(fq_queue, item, portMAX_DELAY) != pdPASS)
+            fq_errors++;
+        else if (xQueueSend(fq_reply_queue, item, portMAX_DELAY) != pdPASS)
+            fq_errors++;
+    }
+}
+#endif
+
+
+static void     fq_run(void)
+{
+
+uint32_t        item[FQ_ITEM_MAX/sizeof(uint32_t)];
+unsigned long   start;
+unsigned long   stop;
+unsigned long   samples;
+unsigned long   i;
+double          seconds;
+double          rate;
+unsigned long   send_p50, send_p99;
+unsigned long   receive_p50, receive_p99;
+FILE           *file;
+
+
+    fq_queue =  xQueueCreate(fq_length, fq_item_size);
+    if (fq_queue == NULL)
+    {
+
+        fprintf(stderr, "the queue cannot be created\n");
+        exit(1);
+    }
+
+    if (strcmp(fq_mode, "front") == 0)
+    {
+
+        /* The item at the back shall stay there.  */
+        memset(item, 0xa5, sizeof(item));
+        xQueueSend(fq_queue, item, 0);
+    }
+    else if (strcmp(fq_mode, "set") == 0)
+    {
+
+        fq_set =  xQueueCreateSet(fq_length);
+        if ((fq_set == NULL) || (xQueueAddToSet(fq_queue, fq_set) != pdPASS))
+        {
+
+            fprintf(stderr, "the queue set cannot be created\n");
+            exit(1);
+        }
+    }
+    else if (strcmp(fq_mode, "pingpong") == 0)
+    {
+
+#ifdef FQ_FREERTOS_KERNEL
+        fprintf(stderr, "the pingpong mode needs a scheduler, it is not available on the FreeRTOS kernel\n");
+        exit(1);
+#else
+        fq_reply_queue =  xQueueCreate(fq_length, fq_item_size);
+        if ((fq_reply_queue == NULL) ||
+            (xTaskCreate(fq_echo_entry, "echo", FQ_STACK_SIZE, NULL, 20, &fq_echo_task) != pdPASS))
+        {
+
+            fprintf(stderr, "the echo task cannot be created\n");
+            exit(1);
+        }
+#endif
+    }
+    else if (strcmp(fq_mode, "send") != 0)
+    {
+
+        fprintf(stderr, "unknown mode %s\n", fq_mode);
+        exit(1);
+    }
+
+    /* Measure the throughput.  */
+    start =  fq_time_get();
+    for (i = 0; i < fq_messages; i++)
+        fq_exchange(i, NULL, NULL);
+    stop =  fq_time_get();
+
+    /* Then the latency of each call.  */
+    samples =  (fq_messages < FQ_SAMPLES) ? fq_messages : FQ_SAMPLES;
+    for (i = 0; i < samples; i++)
+        fq_exchange(i, &fq_send_samples[i], &fq_receive_samples[i]);
+
+    if (strcmp(fq_mode, "front") == 0)
+    {
+
+        if ((xQueueReceive(fq_queue, item, 0) != pdPASS) || (item[0] != 0xa5a5a5a5))
+            fq_errors++;
+    }
+    if (uxQueueMessagesWaiting(fq_queue) != 0)
+        fq_errors++;
+
+    qsort(fq_send_samples, samples, sizeof(unsigned long), fq_compare);
+    qsort(fq_receive_samples, samples, sizeof(unsigned long), fq_compare);
+    send_p50 =     fq_percentile(fq_send_samples, samples, 50);
+    send_p99 =     fq_percentile(fq_send_samples, samples, 99);
+    receive_p50 =  fq_percentile(fq_receive_samples, samples, 50);
+    receive_p99 =  fq_percentile(fq_receive_samples, samples, 99);
+
+    seconds =  (double) (stop - start)/1e9;
+    rate =     (seconds > 0.0) ? (double) fq_messages/seconds : 0.0;
+
+    printf("FreeRTOS queue benchmark, %s, %s: %lu messages of %lu bytes, queue length %lu\n",
+           FQ_IMPLEMENTATION, fq_mode, fq_messages, fq_item_size, fq_length);
+    printf("%.3f s, %.0f messages/s, send p50 %lu ns p99 %lu ns, receive p50 %lu ns p99 %lu ns, %lu errors\n",
+           seconds, rate, send_p50, send_p99, receive_p50, receive_p99, fq_errors);
+
+    if (fq_csv_file != NULL)
+    {
+
+        file =  fopen(fq_csv_file, "a");
+        if (file != NULL)
+        {
+
+            if (ftell(file) == 0)
+                fprintf(file, "implementation,mode,messages,item_size,length,seconds,messages_per_second,"
+                              "send_p50_ns,send_p99_ns,receive_p50_ns,receive_p99_ns,errors\n");
+            fprintf(file, "%s,%s,%lu,%lu,%lu,%.3f,%.0f,%lu,%lu,%lu,%lu,%lu\n", FQ_IMPLEMENTATION, fq_mode,
+                    fq_messages, fq_item_size, fq_length, seconds, rate, send_p50, send_p99, receive_p50, receive_p99,
+                    fq_errors);
+            fclose(file);
+        }
+    }
+
+    fflush(stdout);
+    exit((fq_errors != 0) ? 1 : 0);
+}
+
+
+int main(int argc, char **argv)
+{
+
+int     option;
+
+
+    while ((option =  getopt(argc, argv, "m:n:s:l:c:")) != -1)
+    {
+
+        switch (option)
+        {
+
+        case 'm':
+            fq_mode =  optarg;
+            break;
+        case 'n':
+            fq_messages =  strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            fq_item_size =  strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            fq_length =  strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            fq_csv_file =  optarg;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-m send|front|set|pingpong] [-n messages] [-s item size] [-l queue length] [-c csv file]\n", argv[0]);
+            return(1);
+        }
+    }
+
+    if ((fq_item_size < sizeof(uint32_t)) || (fq_item_size > FQ_ITEM_MAX) || (fq_length < 2))
+    {
+
+        fprintf(stderr, "invalid parameters, items of %u to %d bytes and a queue length of 2 at least\n",
+                (unsigned) sizeof(uint32_t), FQ_ITEM_MAX);
+        return(1);
+    }
+
+#ifdef FQ_FREERTOS_KERNEL
+
+    /* There is no scheduler, the kernel objects are used from main().  */
+    fq_run();
+#else
+
+    /* Enter the ThreadX kernel.  */
+    tx_kernel_enter();
+#endif
+
+    return(0);
+}
+
+
+#ifndef FQ_FREERTOS_KERNEL
+static void     fq_task_entry(void *parameter)
+{
+
+    (void) parameter;
+    fq_run();
+}
+
+
+/* Define what the initial system looks like.  */
+
+void    tx_application_define(void *first_unused_memory)
+{
+
+    (void) first_unused_memory;
+
+    if ((tx_freertos_init() != TX_SUCCESS) ||
+        (xTaskCreate(fq_task_entry, "benchmark", FQ_STACK_SIZE, NULL, 10, &fq_task) != pdPASS))
+    {
+
+        fprintf(stderr, "the benchmark task cannot be created\n");
+        exit(1);
+    }
+}
+#endif
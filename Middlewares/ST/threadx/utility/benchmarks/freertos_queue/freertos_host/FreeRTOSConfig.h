@@ -0,0 +1,50 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FreeRTOS Queue Benchmark                                              */
+/**                                                                       */
+/**   FreeRTOS Kernel Configuration (Host)                                */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configCPU_CLOCK_HZ                      (100000000UL)
+#define configTICK_RATE_HZ                      (100u)
+#define configMAX_PRIORITIES                    (32u)
+#define configMINIMAL_STACK_SIZE                (512u)
+#define configMAX_TASK_NAME_LEN                 (16)
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_MUTEXES                       1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configUSE_QUEUE_SETS                    1
+#define configQUEUE_REGISTRY_SIZE               0
+#define configUSE_TIMERS                        0
+#define configUSE_CO_ROUTINES                   0
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configCHECK_FOR_STACK_OVERFLOW          0
+
+#define INCLUDE_vTaskDelete                     1
+
+#define configASSERT(x)
+
+#endif /* #ifndef FREERTOS_CONFIG_H */
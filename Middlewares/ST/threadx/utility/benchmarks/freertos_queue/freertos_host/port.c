@@ -0,0 +1,77 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FreeRTOS Queue Benchmark                                              */
+/**                                                                       */
+/**   FreeRTOS Kernel Port (Host)                                         */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <pthread.h>
+#include    "FreeRTOS.h"
+#include    "task.h"
+
+
+static pthread_mutex_t  port_critical_mutex =  PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+
+void    vPortEnterCritical(void)
+{
+
+    pthread_mutex_lock(&port_critical_mutex);
+}
+
+
+void    vPortExitCritical(void)
+{
+
+    pthread_mutex_unlock(&port_critical_mutex);
+}
+
+
+/* The scheduler is never started, a yield can only come from a call that
+   would block or wake up a task, which the benchmark does not make.  */
+
+void    vPortYield(void)
+{
+
+    fprintf(stderr, "the FreeRTOS host port cannot switch tasks\n");
+    exit(1);
+}
+
+
+StackType_t    *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+
+    (void) pxCode;
+    (void) pvParameters;
+    return(pxTopOfStack);
+}
+
+
+BaseType_t  xPortStartScheduler(void)
+{
+
+    fprintf(stderr, "the FreeRTOS host port cannot start the scheduler\n");
+    exit(1);
+    return(pdFALSE);
+}
+
+
+void    vPortEndScheduler(void)
+{
+}
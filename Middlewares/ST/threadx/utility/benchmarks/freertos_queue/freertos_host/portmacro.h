@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** FreeRTOS Queue Benchmark                                              */
+/**                                                                       */
+/**   FreeRTOS Kernel Port Macros (Host)                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* This port only runs the kernel objects from main(), before the scheduler
+   is started: there is no context switch, so no call may block.  The
+   critical sections take a recursive pthread mutex, as the interrupt
+   disable of the ThreadX Linux port does, so that both kernels pay the
+   same price for them.  */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#define portCHAR                char
+#define portFLOAT               float
+#define portDOUBLE              double
+#define portLONG                long
+#define portSHORT               short
+#define portSTACK_TYPE          uint32_t
+#define portBASE_TYPE           long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if (configUSE_16_BIT_TICKS == 1)
+    typedef uint16_t TickType_t;
+    #define portMAX_DELAY (TickType_t) 0xffff
+#else
+    typedef uint32_t TickType_t;
+    #define portMAX_DELAY (TickType_t) 0xffffffffUL
+#endif
+
+#define portSTACK_GROWTH                        (-1)
+#define portTICK_PERIOD_MS                      ((TickType_t) 1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT                      8
+
+void vPortYield(void);
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+
+#define portYIELD()                             vPortYield()
+#define portEND_SWITCHING_ISR(xSwitchRequired)  if ((xSwitchRequired) != pdFALSE) portYIELD()
+#define portYIELD_FROM_ISR(x)                   portEND_SWITCHING_ISR(x)
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()       (vPortEnterCritical(), 0)
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    ((void) (x), vPortExitCritical())
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()                    vPortEnterCritical()
+#define portEXIT_CRITICAL()                     vPortExitCritical()
+
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters) void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters) void vFunction(void *pvParameters)
+
+#define portNOP()
+#define portMEMORY_BARRIER()                    __asm volatile("" ::: "memory")
+
+#endif
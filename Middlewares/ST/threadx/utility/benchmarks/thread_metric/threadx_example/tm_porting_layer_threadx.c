@@ -76,6 +76,12 @@
 #define TM_THREADX_MEMORY_POOL_SIZE     2048
 
 
+/* Define the size of a test message (4 unsigned long) in ThreadX words. It is TX_4_ULONG
+   unless unsigned long is larger than ULONG, e.g. on the 64-bit Linux port.  */
+
+#define TM_THREADX_MESSAGE_SIZE         ((UINT) ((4*sizeof(unsigned long))/sizeof(ULONG)))
+
+
 /* Define the number of timer interrupt ticks per second.  */
 
 #define TM_THREADX_TICKS_PER_SECOND     100
@@ -85,6 +91,7 @@
 
 TX_THREAD       tm_thread_array[TM_THREADX_MAX_THREADS];
 TX_QUEUE        tm_queue_array[TM_THREADX_MAX_QUEUES];
+TX_BUFFER_QUEUE tm_buffer_queue_array[TM_THREADX_MAX_QUEUES];
 TX_SEMAPHORE    tm_semaphore_array[TM_THREADX_MAX_SEMAPHORES];
 TX_BLOCK_POOL   tm_block_pool_array[TM_THREADX_MAX_MEMORY_POOLS];
 
@@ -93,6 +100,7 @@ TX_BLOCK_POOL   tm_block_pool_array[TM_THREADX_MAX_MEMORY_POOLS];
 
 unsigned char   tm_thread_stack_area[TM_THREADX_MAX_THREADS*TM_THREADX_THREAD_STACK_SIZE];
 unsigned char   tm_queue_memory_area[TM_THREADX_MAX_QUEUES*TM_THREADX_QUEUE_SIZE];
+unsigned char   tm_buffer_queue_memory_area[TM_THREADX_MAX_QUEUES*TM_THREADX_QUEUE_SIZE];
 unsigned char   tm_pool_memory_area[TM_THREADX_MAX_MEMORY_POOLS*TM_THREADX_MEMORY_POOL_SIZE];
 
 
@@ -217,7 +225,7 @@ UINT    status;
 
 
     /* Create the specified queue with 16-byte messages.  */
-    status =  tx_queue_create(&tm_queue_array[queue_id], "Thread-Metric test", TX_4_ULONG, 
+    status =  tx_queue_create(&tm_queue_array[queue_id], "Thread-Metric test", TM_THREADX_MESSAGE_SIZE, 
                               &tm_queue_memory_area[queue_id*TM_THREADX_QUEUE_SIZE], TM_THREADX_QUEUE_SIZE);
 
     /* Determine if the queue create was successful.  */
@@ -383,6 +391,64 @@ UINT    status;
 }
 
 
+/* This function creates the specified buffer queue.  If successful, the function should
+   return TM_SUCCESS. Otherwise, TM_ERROR should be returned.  */
+int  tm_buffer_queue_create(int queue_id)
+{
+
+UINT    status;
+
+
+    /* Create the specified buffer queue, its messages are block pointers.  */
+    status =  tx_buffer_queue_create(&tm_buffer_queue_array[queue_id], "Thread-Metric test",
+                                     &tm_buffer_queue_memory_area[queue_id*TM_THREADX_QUEUE_SIZE], TM_THREADX_QUEUE_SIZE);
+
+    /* Determine if the buffer queue create was successful.  */
+    if (status == TX_SUCCESS)
+        return(TM_SUCCESS);
+    else
+        return(TM_ERROR);
+}
+
+
+/* This function sends a 128-byte block to the specified buffer queue.  If successful,
+   the function should return TM_SUCCESS. Otherwise, TM_ERROR should be returned.  */
+int  tm_buffer_queue_send(int queue_id, unsigned char *buffer_ptr)
+{
+
+UINT    status;
+
+
+    /* Send the block pointer to the specified buffer queue.  */
+    status =  tx_buffer_queue_send(&tm_buffer_queue_array[queue_id], (void *) buffer_ptr, TX_NO_WAIT);
+
+    /* Determine if the buffer queue send was successful.  */
+    if (status == TX_SUCCESS)
+        return(TM_SUCCESS);
+    else
+        return(TM_ERROR);
+}
+
+
+/* This function receives a 128-byte block from the specified buffer queue.  If successful,
+   the function should return TM_SUCCESS. Otherwise, TM_ERROR should be returned.  */
+int  tm_buffer_queue_receive(int queue_id, unsigned char **buffer_ptr)
+{
+
+UINT    status;
+
+
+    /* Receive the block pointer from the specified buffer queue.  */
+    status =  tx_buffer_queue_receive(&tm_buffer_queue_array[queue_id], (void **) buffer_ptr, TX_NO_WAIT);
+
+    /* Determine if the buffer queue receive was successful.  */
+    if (status == TX_SUCCESS)
+        return(TM_SUCCESS);
+    else
+        return(TM_ERROR);
+}
+
+
 /* This is the ThreadX thread entry.  It is going to call the Thread-Metric
    entry function saved earlier.  */
 VOID  tm_thread_entry(ULONG thread_input)
@@ -0,0 +1,475 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** Thread-Metric Component                                               */
+/**                                                                       */
+/**   Linux Test Driver (ThreadX Linux)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* This file is linked with one Thread-Metric test, the ThreadX porting layer
+   and the ThreadX Linux port. It runs the test for a number of time periods,
+   then writes the results in CSV and/or JSON and compares them with a
+   baseline, so that the tests may be run unattended:
+
+   usage: tm_<test> [-n periods] [-c csv file] [-j json file]
+                    [-b baseline csv file] [-t tolerance %]
+
+   The results are appended to the CSV file (a header is written in an empty
+   file) and to the JSON file (one object per line). A file "-" is the standard
+   output; the reports of the test are then printed on the standard error.
+   The exit code is 0 on success, 1 when the test reported an error and 2 when
+   the average is lower than the baseline minus the tolerance.  */
+
+#include    <errno.h>
+#include    <pthread.h>
+#include    <semaphore.h>
+#include    <signal.h>
+#include    <stdarg.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <unistd.h>
+#include    "tx_api.h"
+#include    "tm_api.h"
+
+
+/* Define the name of the test, set by the Makefile.  */
+
+#ifndef TM_LINUX_TEST
+#define TM_LINUX_TEST                   "unknown"
+#endif
+
+
+/* Define the maximum number of time periods.  */
+
+#define TM_LINUX_MAX_PERIODS            64
+
+
+/* Define the exit codes.  */
+
+#define TM_LINUX_EXIT_SUCCESS           0
+#define TM_LINUX_EXIT_ERROR             1
+#define TM_LINUX_EXIT_REGRESSION        2
+
+
+/* Define the prefixes of the report lines of the tests.  */
+
+#define TM_LINUX_TITLE_PREFIX           "**** Thread-Metric "
+#define TM_LINUX_TITLE_SUFFIX           " ****"
+#define TM_LINUX_ERROR_PREFIX           "ERROR"
+#define TM_LINUX_TOTAL_PREFIX           "Time Period Total:"
+
+
+/* Define the signal that raises the simulated interrupt of the interrupt
+   processing tests.  */
+
+#define TM_LINUX_INTERRUPT_SIG          SIGRTMIN
+
+
+/* Define the ThreadX Linux port services used to simulate an interrupt.  */
+
+VOID            _tx_thread_context_save(VOID);
+VOID            _tx_thread_context_restore(VOID);
+
+
+/* The interrupt handler of the test, only one of them is linked.  */
+
+void            tm_interrupt_handler(void) __attribute__((weak));
+void            tm_interrupt_preemption_handler(void) __attribute__((weak));
+
+
+/* Define the prototype of the test entry point.  */
+
+void            tm_main(void);
+
+
+/* Define the options and the results of the run.  */
+
+static int              tm_linux_periods =  1;
+static const char      *tm_linux_csv_file;
+static const char      *tm_linux_json_file;
+static const char      *tm_linux_baseline_file;
+static double           tm_linux_tolerance =  10.0;
+static FILE            *tm_linux_report_stream;
+
+static char             tm_linux_title[128];
+static unsigned long    tm_linux_totals[TM_LINUX_MAX_PERIODS];
+static int              tm_linux_period_count;
+static int              tm_linux_error_count;
+static int              tm_linux_period_error;
+
+static pthread_t        tm_linux_interrupt_id;
+static sem_t            tm_linux_interrupt_done;
+
+
+static FILE    *tm_linux_open(const char *file_name)
+{
+
+    if (strcmp(file_name, "-") == 0)
+        return(stdout);
+
+    return(fopen(file_name, "a"));
+}
+
+
+static void     tm_linux_close(FILE *file)
+{
+
+    if (file != stdout)
+        fclose(file);
+    else
+        fflush(file);
+}
+
+
+/* Find the average of the test in a baseline CSV file written by a previous run.
+   Returns 0 when the test is not in the file.  */
+static int      tm_linux_baseline_get(const char *file_name, unsigned long *average)
+{
+
+FILE           *file;
+char            line[256];
+char            test[64];
+unsigned long   value;
+int             found;
+
+
+    file =  fopen(file_name, "r");
+    if (file == NULL)
+    {
+
+        fprintf(stderr, "Cannot open the baseline file %s\n", file_name);
+        return(0);
+    }
+
+    found =  0;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+
+        /* The columns are test,title,duration,periods,average,...  */
+        if ((sscanf(line, "%63[^,],\"%*[^\"]\",%*u,%*u,%lu", test, &value) == 2) &&
+            (strcmp(test, TM_LINUX_TEST) == 0))
+        {
+
+            *average =  value;
+            found =  1;
+        }
+    }
+
+    fclose(file);
+    return(found);
+}
+
+
+/* Write the results and leave. Called by the reporting thread after the last period.  */
+static void     tm_linux_complete(void)
+{
+
+unsigned long   total;
+unsigned long   average;
+unsigned long   minimum;
+unsigned long   maximum;
+unsigned long   baseline;
+int             has_baseline;
+const char     *status;
+int             exit_code;
+FILE           *file;
+int             i;
+
+
+    total =    0;
+    minimum =  tm_linux_totals[0];
+    maximum =  tm_linux_totals[0];
+    for (i = 0; i < tm_linux_period_count; i++)
+    {
+
+        total =  total + tm_linux_totals[i];
+        if (tm_linux_totals[i] < minimum)
+            minimum =  tm_linux_totals[i];
+        if (tm_linux_totals[i] > maximum)
+            maximum =  tm_linux_totals[i];
+    }
+    average =  total/((unsigned long) tm_linux_period_count);
+
+    has_baseline =  0;
+    baseline =      0;
+    if (tm_linux_baseline_file != NULL)
+        has_baseline =  tm_linux_baseline_get(tm_linux_baseline_file, &baseline);
+
+    if (tm_linux_error_count != 0)
+    {
+
+        status =     "error";
+        exit_code =  TM_LINUX_EXIT_ERROR;
+    }
+    else if ((has_baseline) && ((double) average < ((double) baseline)*(1.0 - tm_linux_tolerance/100.0)))
+    {
+
+        status =     "regression";
+        exit_code =  TM_LINUX_EXIT_REGRESSION;
+    }
+    else
+    {
+
+        status =     "ok";
+        exit_code =  TM_LINUX_EXIT_SUCCESS;
+    }
+
+    if (tm_linux_csv_file != NULL)
+    {
+
+        file =  tm_linux_open(tm_linux_csv_file);
+        if (file != NULL)
+        {
+
+            if ((file == stdout) || (ftell(file) == 0))
+                fprintf(file, "test,title,duration,periods,average,minimum,maximum,errors,baseline,status\n");
+            fprintf(file, "%s,\"%s\",%d,%d,%lu,%lu,%lu,%d,", TM_LINUX_TEST, tm_linux_title, TM_TEST_DURATION,
+                    tm_linux_period_count, average, minimum, maximum, tm_linux_error_count);
+            if (has_baseline)
+                fprintf(file, "%lu", baseline);
+            fprintf(file, ",%s\n", status);
+            tm_linux_close(file);
+        }
+    }
+
+    if (tm_linux_json_file != NULL)
+    {
+
+        file =  tm_linux_open(tm_linux_json_file);
+        if (file != NULL)
+        {
+
+            fprintf(file, "{\"test\": \"%s\", \"title\": \"%s\", \"duration\": %d, \"totals\": [",
+                    TM_LINUX_TEST, tm_linux_title, TM_TEST_DURATION);
+            for (i = 0; i < tm_linux_period_count; i++)
+                fprintf(file, "%s%lu", (i == 0) ? "" : ", ", tm_linux_totals[i]);
+            fprintf(file, "], \"average\": %lu, \"minimum\": %lu, \"maximum\": %lu, \"errors\": %d, ",
+                    average, minimum, maximum, tm_linux_error_count);
+            if (has_baseline)
+                fprintf(file, "\"baseline\": %lu, ", baseline);
+            else
+                fprintf(file, "\"baseline\": null, ");
+            fprintf(file, "\"status\": \"%s\"}\n", status);
+            tm_linux_close(file);
+        }
+    }
+
+    if (has_baseline)
+        fprintf(tm_linux_report_stream, "%s: average %lu, baseline %lu (%+.1f%%), %s\n", TM_LINUX_TEST, average,
+                baseline, (100.0*((double) average - (double) baseline))/(double) baseline, status);
+    fflush(tm_linux_report_stream);
+
+    exit(exit_code);
+}
+
+
+/* Print a report line of the test and pick up its results.  */
+int     tm_report_printf(const char *format, ...)
+{
+
+va_list         args;
+const char     *end;
+size_t          length;
+int             count;
+
+
+    va_start(args, format);
+    count =  vfprintf(tm_linux_report_stream, format, args);
+    va_end(args);
+
+    if (strncmp(format, TM_LINUX_TITLE_PREFIX, strlen(TM_LINUX_TITLE_PREFIX)) == 0)
+    {
+
+        /* Title line, at the start of each period.  */
+        format =  format + strlen(TM_LINUX_TITLE_PREFIX);
+        end =     strstr(format, TM_LINUX_TITLE_SUFFIX);
+        length =  (end != NULL) ? (size_t) (end - format) : strlen(format);
+        if (length >= sizeof(tm_linux_title))
+            length =  sizeof(tm_linux_title) - 1;
+        memcpy(tm_linux_title, format, length);
+        tm_linux_title[length] =  0;
+    }
+    else if (strncmp(format, TM_LINUX_ERROR_PREFIX, strlen(TM_LINUX_ERROR_PREFIX)) == 0)
+    {
+
+        tm_linux_period_error =  1;
+    }
+    else if (strncmp(format, TM_LINUX_TOTAL_PREFIX, strlen(TM_LINUX_TOTAL_PREFIX)) == 0)
+    {
+
+        /* Last line of the period.  */
+        va_start(args, format);
+        tm_linux_totals[tm_linux_period_count] =  va_arg(args, unsigned long);
+        va_end(args);
+
+        tm_linux_error_count =   tm_linux_error_count + tm_linux_period_error;
+        tm_linux_period_error =  0;
+        tm_linux_period_count++;
+
+        if (tm_linux_period_count >= tm_linux_periods)
+            tm_linux_complete();
+    }
+
+    return(count);
+}
+
+
+/* Define the interrupt of the interrupt processing tests. It is simulated as
+   the timer interrupt of the Linux port: a host thread, woken by a signal,
+   suspends the running ThreadX thread, calls the handler of the test in ISR
+   context and then restores the thread made ready by the handler, if any.  */
+static void    *tm_linux_interrupt(void *p)
+{
+
+sigset_t    set;
+int         sig;
+
+
+    (void)p;
+
+    sigemptyset(&set);
+    sigaddset(&set, TM_LINUX_INTERRUPT_SIG);
+
+    while(1)
+    {
+
+        /* Wait for the interrupt request.  */
+        if (sigwait(&set, &sig) != 0)
+            continue;
+
+        /* Call ThreadX context save for interrupt preparation.  */
+        _tx_thread_context_save();
+
+        if (tm_interrupt_handler)
+            tm_interrupt_handler();
+        if (tm_interrupt_preemption_handler)
+            tm_interrupt_preemption_handler();
+
+        /* The interrupted thread returns from the trap when it runs again.  */
+        sem_post(&tm_linux_interrupt_done);
+
+        /* Call ThreadX context restore for interrupt completion.  */
+        _tx_thread_context_restore();
+    }
+
+    return(NULL);
+}
+
+
+/* Simulate the trap of the interrupt processing tests: raise the interrupt and
+   wait until it has been processed.  */
+void    tm_cause_interrupt(void)
+{
+
+    pthread_kill(tm_linux_interrupt_id, TM_LINUX_INTERRUPT_SIG);
+
+    /* The wait is interrupted by the suspension of the thread during the interrupt.  */
+    while ((sem_wait(&tm_linux_interrupt_done) != 0) && (errno == EINTR))
+    {
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+
+int         option;
+sigset_t    set;
+
+
+    tm_linux_report_stream =  stdout;
+
+    while ((option =  getopt(argc, argv, "n:c:j:b:t:")) != -1)
+    {
+
+        switch (option)
+        {
+
+        case 'n':
+            tm_linux_periods =  atoi(optarg);
+            break;
+        case 'c':
+            tm_linux_csv_file =  optarg;
+            break;
+        case 'j':
+            tm_linux_json_file =  optarg;
+            break;
+        case 'b':
+            tm_linux_baseline_file =  optarg;
+            break;
+        case 't':
+            tm_linux_tolerance =  atof(optarg);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n periods] [-c csv file] [-j json file] [-b baseline csv file] [-t tolerance %%]\n", argv[0]);
+            return(TM_LINUX_EXIT_ERROR);
+        }
+    }
+
+    if ((tm_linux_periods < 1) || (tm_linux_periods > TM_LINUX_MAX_PERIODS))
+    {
+
+        fprintf(stderr, "The number of periods shall be 1 to %d\n", TM_LINUX_MAX_PERIODS);
+        return(TM_LINUX_EXIT_ERROR);
+    }
+
+    /* Keep the standard output for the results written there.  */
+    if (((tm_linux_csv_file != NULL) && (strcmp(tm_linux_csv_file, "-") == 0)) ||
+        ((tm_linux_json_file != NULL) && (strcmp(tm_linux_json_file, "-") == 0)))
+        tm_linux_report_stream =  stderr;
+
+    /* The interrupt signal is only received by the interrupt thread: block it in
+       the threads created from now on.  */
+    sigemptyset(&set);
+    sigaddset(&set, TM_LINUX_INTERRUPT_SIG);
+    pthread_sigmask(SIG_BLOCK, &set, NULL);
+
+    /* Enter the ThreadX kernel.  */
+    tx_kernel_enter();
+
+    return(TM_LINUX_EXIT_SUCCESS);
+}
+
+
+/* Define what the initial system looks like.  */
+
+void    tx_application_define(void *first_unused_memory)
+{
+
+struct sched_param  sp;
+
+
+    (void)first_unused_memory;
+
+    /* Create the interrupt thread of the interrupt processing tests, at the
+       priority of the timer interrupt thread of the port.  */
+    if (tm_interrupt_handler || tm_interrupt_preemption_handler)
+    {
+
+        sem_init(&tm_linux_interrupt_done, 0, 0);
+        if (pthread_create(&tm_linux_interrupt_id, NULL, tm_linux_interrupt, NULL) != 0)
+        {
+
+            fprintf(stderr, "Error creating the interrupt thread\n");
+            exit(TM_LINUX_EXIT_ERROR);
+        }
+        sp.sched_priority =  TX_LINUX_PRIORITY_ISR;
+        pthread_setschedparam(tm_linux_interrupt_id, SCHED_FIFO, &sp);
+    }
+
+    /* Enter the Thread-Metric test main function for initialization and to start the test.  */
+    tm_main();
+}
@@ -0,0 +1,49 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** Thread-Metric Component                                               */
+/**                                                                       */
+/**   Porting Layer (ThreadX Linux)                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* This file replaces tm_porting_layer.h for the ThreadX Linux port. It is
+   included ahead of every test source file (gcc -include), so that its
+   include guard hides the Cortex-M definitions of tm_porting_layer.h.  */
+
+#ifndef TM_PORTING_LAYER_H
+#define TM_PORTING_LAYER_H
+
+#include <stdio.h>
+
+
+/* The reports of the tests are captured to produce the machine-readable
+   results (see tm_linux_main.c). The lines are still printed.  */
+
+int     tm_report_printf(const char *format, ...);
+
+#define printf                tm_report_printf
+
+
+/* There is no trap instruction on the Linux port: TM_CAUSE_INTERRUPT sends a
+   signal to the interrupt thread of tm_linux_main.c, which calls the handler
+   of the test in ISR context, and waits until the interrupt is processed.  */
+
+void    tm_cause_interrupt(void);
+
+#define TM_CAUSE_INTERRUPT    tm_cause_interrupt();
+
+
+#endif
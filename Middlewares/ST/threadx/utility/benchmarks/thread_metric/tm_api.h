@@ -91,6 +91,9 @@ int    tm_semaphore_put(int semaphore_id);
 int    tm_memory_pool_create(int pool_id);
 int    tm_memory_pool_allocate(int pool_id, unsigned char **memory_ptr);
 int    tm_memory_pool_deallocate(int pool_id, unsigned char *memory_ptr);
+int    tm_buffer_queue_create(int queue_id);
+int    tm_buffer_queue_send(int queue_id, unsigned char *buffer_ptr);
+int    tm_buffer_queue_receive(int queue_id, unsigned char **buffer_ptr);
 
 
 /* Determine if a C++ compiler is being used.  If so, complete the standard
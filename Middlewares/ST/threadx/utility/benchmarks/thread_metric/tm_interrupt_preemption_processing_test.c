@@ -47,9 +47,9 @@
 
 /* Define the counters used in the demo application...  */
 
-unsigned long   tm_interrupt_preemption_thread_0_counter;
-unsigned long   tm_interrupt_preemption_thread_1_counter;
-unsigned long   tm_interrupt_preemption_handler_counter;
+volatile unsigned long   tm_interrupt_preemption_thread_0_counter;
+volatile unsigned long   tm_interrupt_preemption_thread_1_counter;
+volatile unsigned long   tm_interrupt_preemption_handler_counter;
 
 
 /* Define the test thread prototypes.  */
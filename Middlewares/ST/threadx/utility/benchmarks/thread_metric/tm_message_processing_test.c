@@ -32,7 +32,9 @@
 /*                                                                        */ 
 /*  DESCRIPTION                                                           */ 
 /*                                                                        */ 
-/*    Basic test for message exchange processing.                         */
+/*    Basic test for message exchange processing.  When                   */
+/*    TM_MESSAGE_PROCESSING_ZERO_COPY is defined, the 16-byte message is  */
+/*    in a memory pool block and the queue only passes its pointer.       */
 /*                                                                        */ 
 /*  RELEASE HISTORY                                                       */ 
 /*                                                                        */ 
@@ -46,9 +48,14 @@
 
 /* Define the counters used in the demo application...  */
 
-unsigned long   tm_message_processing_counter;
+volatile unsigned long   tm_message_processing_counter;
+#ifndef TM_MESSAGE_PROCESSING_ZERO_COPY
 unsigned long   tm_message_sent[4];
 unsigned long   tm_message_received[4];
+#else
+unsigned long  *tm_message_sent;
+unsigned long  *tm_message_received;
+#endif
 
 
 /* Define the test thread prototypes.  */
@@ -87,8 +94,16 @@ void  tm_message_processing_initialize(void)
     /* Resume thread 0.  */
     tm_thread_resume(0);
 
+#ifndef TM_MESSAGE_PROCESSING_ZERO_COPY
+
     /* Create a queue for the message passing.  */
     tm_queue_create(0);
+#else
+
+    /* Create a memory pool for the message and a buffer queue to pass it.  */
+    tm_memory_pool_create(0);
+    tm_buffer_queue_create(0);
+#endif
 
     /* Create the reporting thread. It will preempt the other 
        threads and print out the test results.  */
@@ -101,6 +116,12 @@ void  tm_message_processing_initialize(void)
 void  tm_message_processing_thread_0_entry(void)
 {
 
+#ifdef TM_MESSAGE_PROCESSING_ZERO_COPY
+
+    /* Allocate the block of the message.  */
+    tm_memory_pool_allocate(0, (unsigned char **) &tm_message_sent);
+#endif
+
     /* Initialize the source message.   */
     tm_message_sent[0] =  0x11112222;
     tm_message_sent[1] =  0x33334444;
@@ -109,11 +130,26 @@ void  tm_message_processing_thread_0_entry(void)
 
     while(1)
     {   	
+#ifndef TM_MESSAGE_PROCESSING_ZERO_COPY
+
         /* Send a message to the queue.  */
         tm_queue_send(0, tm_message_sent);
 
         /* Receive a message from the queue.  */
         tm_queue_receive(0, tm_message_received);
+#else
+
+        /* Send the block of the message to the buffer queue.  */
+        tm_buffer_queue_send(0, (unsigned char *) tm_message_sent);
+
+        /* Receive the block back, the message is not copied.  */
+        tm_message_received =  0;
+        tm_buffer_queue_receive(0, (unsigned char **) &tm_message_received);
+
+        /* Check for a different block.  */
+        if (tm_message_received != tm_message_sent)
+            break;
+#endif
 
         /* Check for invalid message.  */
         if (tm_message_received[3] != tm_message_sent[3])
@@ -152,7 +188,11 @@ unsigned long   relative_time;
         relative_time =  relative_time + TM_TEST_DURATION;
 
         /* Print results to the stdio window.  */
+#ifndef TM_MESSAGE_PROCESSING_ZERO_COPY
         printf("**** Thread-Metric Message Processing Test **** Relative Time: %lu\n", relative_time);
+#else
+        printf("**** Thread-Metric Zero-Copy Message Processing Test **** Relative Time: %lu\n", relative_time);
+#endif
 
         /* See if there are any errors.  */
         if (tm_message_processing_counter == last_counter)
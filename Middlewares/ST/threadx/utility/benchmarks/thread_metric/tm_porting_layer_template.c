@@ -151,3 +151,30 @@ int  tm_memory_pool_deallocate(int pool_id, unsigned char *memory_ptr)
 }
 
 
+/* This function creates the specified buffer queue, a queue that passes blocks of
+   the memory pool without copying them.  If successful, the function should return
+   TM_SUCCESS. Otherwise, TM_ERROR should be returned.  */
+int  tm_buffer_queue_create(int queue_id)
+{
+
+}
+
+
+/* This function sends a block of the memory pool to the specified buffer queue.  If
+   successful, the function should return TM_SUCCESS. Otherwise, TM_ERROR should be
+   returned.  */
+int  tm_buffer_queue_send(int queue_id, unsigned char *buffer_ptr)
+{
+
+}
+
+
+/* This function receives a block of the memory pool from the specified buffer queue.
+   If successful, the function should return TM_SUCCESS. Otherwise, TM_ERROR should
+   be returned.  */
+int  tm_buffer_queue_receive(int queue_id, unsigned char **buffer_ptr)
+{
+
+}
+
+
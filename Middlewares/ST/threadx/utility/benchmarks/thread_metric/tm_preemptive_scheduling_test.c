@@ -45,11 +45,11 @@
 
 /* Define the counters used in the demo application...  */
 
-unsigned long   tm_preemptive_thread_0_counter;
-unsigned long   tm_preemptive_thread_1_counter;
-unsigned long   tm_preemptive_thread_2_counter;
-unsigned long   tm_preemptive_thread_3_counter;
-unsigned long   tm_preemptive_thread_4_counter;
+volatile unsigned long   tm_preemptive_thread_0_counter;
+volatile unsigned long   tm_preemptive_thread_1_counter;
+volatile unsigned long   tm_preemptive_thread_2_counter;
+volatile unsigned long   tm_preemptive_thread_3_counter;
+volatile unsigned long   tm_preemptive_thread_4_counter;
 
 
 /* Define the test thread prototypes.  */
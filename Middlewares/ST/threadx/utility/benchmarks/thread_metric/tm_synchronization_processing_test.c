@@ -45,7 +45,7 @@
 
 /* Define the counters used in the demo application...  */
 
-unsigned long   tm_synchronization_processing_counter;
+volatile unsigned long   tm_synchronization_processing_counter;
 
 
 /* Define the test thread prototypes.  */
@@ -119,6 +119,11 @@ typedef UINT StackType_t;
 #define TX_FREERTOS_AUTO_INIT 0
 #endif
 
+// Set to 0 to implement every queue with two semaphores instead of a ThreadX queue.
+#ifndef TX_FREERTOS_NATIVE_QUEUE
+#define TX_FREERTOS_NATIVE_QUEUE 1
+#endif
+
 #ifndef configMINIMAL_STACK_SIZE
 #error "configMINIMAL_STACK_SIZE must be defined in FreeRTOSConfig.h"
 #endif
@@ -211,6 +216,11 @@ typedef struct txfr_queue {
     uint8_t *p_read;
     UBaseType_t queue_length;
     UBaseType_t msg_size;
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    uint8_t native;
+    TX_QUEUE queue;
+    UINT peek_waiting;
+#endif
 } txfr_queue_t;
 
 typedef txfr_queue_t *QueueHandle_t;
@@ -89,4 +89,7 @@
 /* Set to 1 to support auto initialization, see documentation for details. */
 #define TX_FREERTOS_AUTO_INIT 0
 
+/* Set to 0 to implement every queue with two semaphores instead of a ThreadX queue, see documentation for details. */
+#define TX_FREERTOS_NATIVE_QUEUE 1
+
 #endif /* #ifndef FREERTOS_CONFIG_H */
@@ -1467,12 +1467,255 @@ TickType_t xTaskGetTickCountFromISR(void)
 }
 
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+// Return the size in words of the ThreadX queue messages holding the items, 0 if they don't fit in a message.
+static UINT txfr_queue_native_words(UBaseType_t item_size)
+{
+    UINT words;
+
+    words = (UINT)((item_size + (sizeof(ULONG) - 1u)) / sizeof(ULONG));
+    if(words > TX_16_ULONG) {
+        return 0u;
+    }
+
+    return words;
+}
+
+
+// Return 1 if the item must go through a local buffer since ThreadX copies whole aligned words.
+static UINT txfr_queue_native_bounce(txfr_queue_t *p_queue, const void *p_item)
+{
+    if(((p_queue->msg_size & (sizeof(ULONG) - 1u)) != 0u) ||
+       (((uintptr_t)p_item & (sizeof(ULONG) - 1u)) != 0u)) {
+        return 1u;
+    }
+
+    return 0u;
+}
+
+
+static UINT txfr_queue_native_create(txfr_queue_t *p_queue, UINT words, void *p_mem)
+{
+    UINT ret;
+
+    ret = tx_queue_create(&p_queue->queue, "", words, p_mem, p_queue->queue_length * words * sizeof(ULONG));
+    if(ret != TX_SUCCESS) {
+        return ret;
+    }
+
+    // The read semaphore only wakes up the tasks waiting in xQueuePeek().
+    ret = tx_semaphore_create(&p_queue->read_sem, "", 0u);
+    if(ret != TX_SUCCESS) {
+        tx_queue_delete(&p_queue->queue);
+        return ret;
+    }
+
+    p_queue->native = 1u;
+
+    return TX_SUCCESS;
+}
+
+
+// Signal a new message to the tasks waiting in xQueuePeek() and to the queue set.
+static UINT txfr_queue_native_post(txfr_queue_t *p_queue)
+{
+    UINT ret;
+
+    if(p_queue->peek_waiting != 0u) {
+        // The woken up task passes the signal on to the other ones waiting.
+        ret = tx_semaphore_ceiling_put(&p_queue->read_sem, 1u);
+        if((ret != TX_SUCCESS) && (ret != TX_CEILING_EXCEEDED)) {
+            TX_FREERTOS_ASSERT_FAIL();
+            return ret;
+        }
+    }
+
+    if(p_queue->p_set != NULL) {
+        // To prevent deadlocks don't wait when posting on a queue set.
+        ret = tx_queue_send(&p_queue->p_set->queue, &p_queue, TX_NO_WAIT);
+        if((ret != TX_SUCCESS) && (ret != TX_QUEUE_FULL)) {
+            // Fatal error, queue full errors are ignored on purpose to match the original behaviour.
+            TX_FREERTOS_ASSERT_FAIL();
+            return ret;
+        }
+    }
+
+    return TX_SUCCESS;
+}
+
+
+static UINT txfr_queue_native_send(txfr_queue_t *p_queue, const void *p_item, UINT timeout, UINT front)
+{
+    ULONG msg[TX_16_ULONG];
+    VOID *p_msg;
+    UINT ret;
+
+    if(txfr_queue_native_bounce(p_queue, p_item) == 1u) {
+        memcpy(msg, p_item, p_queue->msg_size);
+        p_msg = msg;
+    } else {
+        p_msg = (VOID *)p_item;
+    }
+
+    if(front == 1u) {
+        ret = tx_queue_front_send(&p_queue->queue, p_msg, timeout);
+    } else {
+        ret = tx_queue_send(&p_queue->queue, p_msg, timeout);
+    }
+
+    if(ret != TX_SUCCESS) {
+        return ret;
+    }
+
+    return txfr_queue_native_post(p_queue);
+}
+
+
+static UINT txfr_queue_native_receive(txfr_queue_t *p_queue, void *p_buffer, UINT timeout)
+{
+    ULONG msg[TX_16_ULONG];
+    UINT ret;
+
+    if(txfr_queue_native_bounce(p_queue, p_buffer) == 0u) {
+        return tx_queue_receive(&p_queue->queue, p_buffer, timeout);
+    }
+
+    ret = tx_queue_receive(&p_queue->queue, msg, timeout);
+    if(ret == TX_SUCCESS) {
+        memcpy(p_buffer, msg, p_queue->msg_size);
+    }
+
+    return ret;
+}
+
+
+static UINT txfr_queue_native_peek(txfr_queue_t *p_queue, void *p_buffer, UINT timeout)
+{
+    TX_INTERRUPT_SAVE_AREA;
+    ULONG start;
+    ULONG elapsed;
+    UINT waiting;
+    UINT ret;
+
+    start = tx_time_get();
+    for(;;) {
+        TX_DISABLE;
+        if(p_queue->queue.tx_queue_enqueued != 0u) {
+            // The oldest message is at the read pointer, messages never wrap around the end of the queue.
+            memcpy(p_buffer, p_queue->queue.tx_queue_read, p_queue->msg_size);
+            waiting = p_queue->peek_waiting;
+            TX_RESTORE;
+
+            if(waiting != 0u) {
+                tx_semaphore_ceiling_put(&p_queue->read_sem, 1u);
+            }
+
+            return TX_SUCCESS;
+        }
+
+        if(timeout == TX_NO_WAIT) {
+            TX_RESTORE;
+            return TX_QUEUE_EMPTY;
+        }
+
+        // Register before waiting so that a message sent from now on posts the read semaphore.
+        p_queue->peek_waiting++;
+        TX_RESTORE;
+
+        if(timeout == TX_WAIT_FOREVER) {
+            ret = tx_semaphore_get(&p_queue->read_sem, TX_WAIT_FOREVER);
+        } else {
+            elapsed = tx_time_get() - start;
+            if(elapsed >= timeout) {
+                ret = TX_NO_INSTANCE;
+            } else {
+                ret = tx_semaphore_get(&p_queue->read_sem, (ULONG)(timeout - elapsed));
+            }
+        }
+
+        TX_DISABLE;
+        p_queue->peek_waiting--;
+        TX_RESTORE;
+
+        if(ret != TX_SUCCESS) {
+            return ret;
+        }
+    }
+}
+
+
+static UINT txfr_queue_native_overwrite(txfr_queue_t *p_queue, const void *p_item)
+{
+    TX_INTERRUPT_SAVE_AREA;
+    ULONG *p_last;
+    UINT ret;
+
+    for(;;) {
+        TX_DISABLE;
+        if(p_queue->queue.tx_queue_enqueued != 0u) {
+            // Replace the last message written, the queue set is not signaled as no message is added.
+            p_last = p_queue->queue.tx_queue_write;
+            if(p_last == p_queue->queue.tx_queue_start) {
+                p_last = p_queue->queue.tx_queue_end;
+            }
+            p_last -= p_queue->queue.tx_queue_message_size;
+
+            memcpy(p_last, p_item, p_queue->msg_size);
+            TX_RESTORE;
+
+            return TX_SUCCESS;
+        }
+        TX_RESTORE;
+
+        ret = txfr_queue_native_send(p_queue, p_item, TX_NO_WAIT, 0u);
+        if(ret != TX_QUEUE_FULL) {
+            return ret;
+        }
+
+        // Another task filled the queue in the meantime, overwrite its message instead.
+    }
+}
+
+
+static UINT txfr_queue_native_reset(txfr_queue_t *p_queue)
+{
+    TX_INTERRUPT_SAVE_AREA;
+    ULONG msg[TX_16_ULONG];
+    ULONG count;
+    UINT ret;
+
+    TX_DISABLE;
+    _tx_thread_preempt_disable++;
+    count = p_queue->queue.tx_queue_enqueued;
+    TX_RESTORE;
+
+    // Drop the messages queued before the reset, a task waiting for space sends its message as it would under FreeRTOS.
+    ret = TX_SUCCESS;
+    while((count != 0u) && (ret == TX_SUCCESS)) {
+        ret = tx_queue_receive(&p_queue->queue, msg, TX_NO_WAIT);
+        count--;
+    }
+
+    TX_DISABLE;
+    _tx_thread_preempt_disable--;
+    TX_RESTORE;
+
+    _tx_thread_system_preempt_check();
+
+    return TX_SUCCESS;
+}
+#endif
+
+
 QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength,
                                  UBaseType_t uxItemSize,
                                  uint8_t *pucQueueStorageBuffer,
                                  StaticQueue_t *pxQueueBuffer)
 {
     UINT ret;
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    UINT words;
+#endif
 
     configASSERT(uxQueueLength != 0u);
     configASSERT(uxItemSize >= sizeof(UINT));
@@ -1496,6 +1739,20 @@ QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength,
     pxQueueBuffer->msg_size = uxItemSize;
     pxQueueBuffer->queue_length = uxQueueLength;
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    // The storage of a ThreadX queue holds aligned words with no padding between the messages.
+    words = txfr_queue_native_words(uxItemSize);
+    if((words != 0u) && ((words * sizeof(ULONG)) == uxItemSize) &&
+       (((uintptr_t)pucQueueStorageBuffer & (sizeof(ULONG) - 1u)) == 0u)) {
+        ret = txfr_queue_native_create(pxQueueBuffer, words, pucQueueStorageBuffer);
+        if(ret != TX_SUCCESS) {
+            return NULL;
+        }
+
+        return pxQueueBuffer;
+    }
+#endif
+
     ret = tx_semaphore_create(&pxQueueBuffer->read_sem, "", 0u);
     if(ret != TX_SUCCESS) {
         return NULL;
@@ -1516,6 +1773,9 @@ QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
     void *p_mem;
     size_t mem_size;
     UINT ret;
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    UINT words;
+#endif
 
     configASSERT(uxQueueLength != 0u);
     configASSERT(uxItemSize >= sizeof(UINT));
@@ -1532,6 +1792,12 @@ QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
     }
 
     mem_size = uxQueueLength*(uxItemSize);
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    words = txfr_queue_native_words(uxItemSize);
+    if(words != 0u) {
+        mem_size = uxQueueLength * words * sizeof(ULONG);
+    }
+#endif
 
     p_mem = txfr_malloc(mem_size);
     if(p_mem == NULL) {
@@ -1550,6 +1816,19 @@ QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
     p_queue->msg_size = uxItemSize;
     p_queue->queue_length = uxQueueLength;
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(words != 0u) {
+        ret = txfr_queue_native_create(p_queue, words, p_mem);
+        if(ret != TX_SUCCESS) {
+            txfr_free(p_mem);
+            txfr_free(p_queue);
+            return NULL;
+        }
+
+        return p_queue;
+    }
+#endif
+
     ret = tx_semaphore_create(&p_queue->read_sem, "", 0u);
     if(ret != TX_SUCCESS) {
         return NULL;
@@ -1574,7 +1853,15 @@ void vQueueDelete(QueueHandle_t xQueue)
         TX_FREERTOS_ASSERT_FAIL();
     }
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = tx_queue_delete(&xQueue->queue);
+    } else {
+        ret = tx_semaphore_delete(&xQueue->write_sem);
+    }
+#else
     ret = tx_semaphore_delete(&xQueue->write_sem);
+#endif
     if(ret != TX_SUCCESS) {
         TX_FREERTOS_ASSERT_FAIL();
     }
@@ -1602,6 +1889,17 @@ BaseType_t xQueueSend(QueueHandle_t xQueue,
         timeout = (UINT)xTicksToWait;
     }
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = txfr_queue_native_send(xQueue, pvItemToQueue, timeout, 0u);
+        if(ret != TX_SUCCESS) {
+            return pdFALSE;
+        }
+
+        return pdPASS;
+    }
+#endif
+
     // Wait for space to be available on the queue.
     ret = tx_semaphore_get(&xQueue->write_sem, timeout);
     if(ret != TX_SUCCESS) {
@@ -1687,6 +1985,17 @@ BaseType_t xQueueSendToFront(QueueHandle_t xQueue,
         timeout = (UINT)xTicksToWait;
     }
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = txfr_queue_native_send(xQueue, pvItemToQueue, timeout, 1u);
+        if(ret != TX_SUCCESS) {
+            return pdFALSE;
+        }
+
+        return pdPASS;
+    }
+#endif
+
     if(xQueue->p_set != NULL) {
         TX_DISABLE;
         _tx_thread_preempt_disable++;
@@ -1768,6 +2077,17 @@ BaseType_t xQueueReceive(QueueHandle_t xQueue,
         timeout = (UINT)xTicksToWait;
     }
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = txfr_queue_native_receive(xQueue, pvBuffer, timeout);
+        if(ret != TX_SUCCESS) {
+            return pdFAIL;
+        }
+
+        return pdPASS;
+    }
+#endif
+
     // Wait for a message to be available on the queue.
     ret = tx_semaphore_get(&xQueue->read_sem, timeout);
     if(ret != TX_SUCCESS) {
@@ -1825,6 +2145,17 @@ BaseType_t xQueuePeek(QueueHandle_t xQueue,
         timeout = (UINT)xTicksToWait;
     }
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = txfr_queue_native_peek(xQueue, pvBuffer, timeout);
+        if(ret != TX_SUCCESS) {
+            return pdFAIL;
+        }
+
+        return pdPASS;
+    }
+#endif
+
     // Wait for a message to be available on the queue.
     ret = tx_semaphore_get(&xQueue->read_sem, timeout);
     if(ret != TX_SUCCESS) {
@@ -1866,7 +2197,15 @@ UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue)
 
     configASSERT(xQueue != NULL);
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = tx_queue_info_get(&xQueue->queue, NULL, &count, NULL, NULL, NULL, NULL);
+    } else {
+        ret = tx_semaphore_info_get(&xQueue->read_sem, NULL, &count, NULL, NULL, NULL);
+    }
+#else
     ret = tx_semaphore_info_get(&xQueue->read_sem, NULL, &count, NULL, NULL, NULL);
+#endif
     if(ret != TX_SUCCESS) {
         TX_FREERTOS_ASSERT_FAIL();
         return 0;
@@ -1889,7 +2228,15 @@ UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue)
 
     configASSERT(xQueue != NULL);
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = tx_queue_info_get(&xQueue->queue, NULL, NULL, &count, NULL, NULL, NULL);
+    } else {
+        ret = tx_semaphore_info_get(&xQueue->write_sem, NULL, &count, NULL, NULL, NULL);
+    }
+#else
     ret = tx_semaphore_info_get(&xQueue->write_sem, NULL, &count, NULL, NULL, NULL);
+#endif
     if(ret != TX_SUCCESS) {
         TX_FREERTOS_ASSERT_FAIL();
         return 0;
@@ -1905,7 +2252,15 @@ BaseType_t xQueueIsQueueEmptyFromISR(const QueueHandle_t xQueue)
 
     configASSERT(xQueue != NULL);
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = tx_queue_info_get(&xQueue->queue, NULL, &count, NULL, NULL, NULL, NULL);
+    } else {
+        ret = tx_semaphore_info_get(&xQueue->read_sem, NULL, &count, NULL, NULL, NULL);
+    }
+#else
     ret = tx_semaphore_info_get(&xQueue->read_sem, NULL, &count, NULL, NULL, NULL);
+#endif
     if(ret != TX_SUCCESS) {
         TX_FREERTOS_ASSERT_FAIL();
         return 0;
@@ -1925,7 +2280,15 @@ BaseType_t xQueueIsQueueFullFromISR(const QueueHandle_t xQueue)
 
     configASSERT(xQueue != NULL);
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = tx_queue_info_get(&xQueue->queue, NULL, NULL, &count, NULL, NULL, NULL);
+    } else {
+        ret = tx_semaphore_info_get(&xQueue->write_sem, NULL, &count, NULL, NULL, NULL);
+    }
+#else
     ret = tx_semaphore_info_get(&xQueue->write_sem, NULL, &count, NULL, NULL, NULL);
+#endif
     if(ret != TX_SUCCESS) {
         TX_FREERTOS_ASSERT_FAIL();
         return 0;
@@ -1947,6 +2310,18 @@ BaseType_t xQueueReset(QueueHandle_t xQueue)
 
     configASSERT(xQueue != NULL);
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = txfr_queue_native_reset(xQueue);
+        if(ret != TX_SUCCESS) {
+            TX_FREERTOS_ASSERT_FAIL();
+            return pdFALSE;
+        }
+
+        return pdPASS;
+    }
+#endif
+
     write_post = 0u;
     TX_DISABLE;
     _tx_thread_preempt_disable++;
@@ -1993,6 +2368,17 @@ BaseType_t xQueueOverwrite(QueueHandle_t xQueue,
     configASSERT(xQueue != NULL);
     configASSERT(pvItemToQueue != NULL);
 
+#if (TX_FREERTOS_NATIVE_QUEUE == 1)
+    if(xQueue->native == 1u) {
+        ret = txfr_queue_native_overwrite(xQueue, pvItemToQueue);
+        if(ret != TX_SUCCESS) {
+            return pdFALSE;
+        }
+
+        return pdPASS;
+    }
+#endif
+
     read_post = 0u;
     TX_DISABLE;
 
@@ -46,12 +46,12 @@ typedef struct
 {
   HW_TS_pTimerCb_t  pTimerCallBack;
   uint32_t        CounterInit;
-  uint32_t        CountLeft;
+  uint32_t        Expiry;
+  uint32_t        Slack;
   TimerIDStatus_t     TimerIDStatus;
   HW_TS_Mode_t   TimerMode;
   uint32_t        TimerProcessID;
-  uint8_t         PreviousID;
-  uint8_t         NextID;
+  uint8_t         HeapIndex;
 }TimerContext_t;
 
 /* Private defines -----------------------------------------------------------*/
@@ -59,6 +59,19 @@ typedef struct
 #define TIMER_LIST_EMPTY      0xFFFF
 
 /* Private macros ------------------------------------------------------------*/
+/**
+ * Number of ticks left before the expiry of a timer
+ * The expiry times are absolute ticks of the timer server time base that may wrap around. No timer is left
+ * behind the time base (see SaturateExpiredTimers()) so that the ticks left are always computed in unsigned
+ * arithmetic, over the whole range of timeout allowed by HW_TS_Start()
+ */
+#define TIMER_TICKS_LEFT(id)  (aTimerContext[(id)].Expiry - TimeBase)
+
+/**
+ * Compare the expiry time of two timers
+ */
+#define TIMER_EXPIRES_BEFORE(id1, id2)  (TIMER_TICKS_LEFT(id1) < TIMER_TICKS_LEFT(id2))
+
 /* Private variables ---------------------------------------------------------*/
 
 /**
@@ -66,6 +79,13 @@ typedef struct
  */
 
 PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile TimerContext_t aTimerContext[CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER];
+PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint8_t aTimerHeap[CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER];
+PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint8_t TimerHeapSize;
+PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint32_t TimeBase;
+PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint32_t WakeupTime;
+PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint8_t WakeupProgrammed;
+PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint32_t RtcWakeupCount;
+PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint32_t TimerExpiredCount;
 PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint8_t CurrentRunningTimerID;
 PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint8_t PreviousRunningTimerID;
 PLACE_IN_SECTION("TIMERSERVER_CONTEXT") static volatile uint32_t SSRValueOnLastSetup;
@@ -87,8 +107,11 @@ static void RestartWakeupCounter(uint16_t Value);
 static uint16_t ReturnTimeElapsed(void);
 static void RescheduleTimerList(void);
 static void UnlinkTimer(uint8_t TimerID, RequestReadSSR_t RequestReadSSR);
-static void LinkTimerBefore(uint8_t TimerID, uint8_t RefTimerID);
-static void LinkTimerAfter(uint8_t TimerID, uint8_t RefTimerID);
+static void HeapSiftUp(uint8_t HeapIndex);
+static void HeapSiftDown(uint8_t HeapIndex);
+static uint32_t ComputeWakeupTime(void);
+static uint32_t DeadlineTicksLeft(uint8_t TimerID);
+static void SaturateExpiredTimers(uint16_t TimeElapsed);
 static uint16_t linkTimer(uint8_t TimerID);
 static uint32_t ReadRtcSsrValue(void);
 
@@ -123,51 +146,192 @@ static uint32_t ReadRtcSsrValue(void)
 }
 
 /**
- * @brief  Insert a Timer in the list after the Timer ID specified
- * @param  TimerID:   The ID of the Timer
- * @param  RefTimerID: The ID of the Timer to be linked after
+ * @brief  Move a Timer up in the heap until its parent expires before it
+ * @param  HeapIndex: The position of the Timer in the heap
  * @retval None
  */
-static void LinkTimerAfter(uint8_t TimerID, uint8_t RefTimerID)
+static void HeapSiftUp(uint8_t HeapIndex)
 {
-  uint8_t next_id;
+  uint8_t timer_id;
+  uint8_t parent_index;
 
-  next_id = aTimerContext[RefTimerID].NextID;
+  timer_id = aTimerHeap[HeapIndex];
 
-  if(next_id != CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER)
+  while(HeapIndex != 0)
   {
-    aTimerContext[next_id].PreviousID = TimerID;
+    parent_index = (HeapIndex - 1) >> 1;
+    if(!TIMER_EXPIRES_BEFORE(timer_id, aTimerHeap[parent_index]))
+    {
+      break;
+    }
+    aTimerHeap[HeapIndex] = aTimerHeap[parent_index];
+    aTimerContext[aTimerHeap[HeapIndex]].HeapIndex = HeapIndex;
+    HeapIndex = parent_index;
   }
-  aTimerContext[TimerID].NextID = next_id;
-  aTimerContext[TimerID].PreviousID = RefTimerID ;
-  aTimerContext[RefTimerID].NextID = TimerID;
+
+  aTimerHeap[HeapIndex] = timer_id;
+  aTimerContext[timer_id].HeapIndex = HeapIndex;
 
   return;
 }
 
 /**
- * @brief  Insert a Timer in the list before the ID specified
- * @param  TimerID:   The ID of the Timer
- * @param  RefTimerID: The ID of the Timer to be linked before
+ * @brief  Move a Timer down in the heap until its children expire after it
+ * @param  HeapIndex: The position of the Timer in the heap
  * @retval None
  */
-static void LinkTimerBefore(uint8_t TimerID, uint8_t RefTimerID)
+static void HeapSiftDown(uint8_t HeapIndex)
 {
-  uint8_t previous_id;
+  uint8_t timer_id;
+  uint16_t child_index;
 
-  if(RefTimerID != CurrentRunningTimerID)
+  timer_id = aTimerHeap[HeapIndex];
+
+  while(1)
   {
-    previous_id = aTimerContext[RefTimerID].PreviousID;
+    child_index = (2 * (uint16_t)HeapIndex) + 1;
+    if(child_index >= TimerHeapSize)
+    {
+      break;
+    }
+    if(((child_index + 1) < TimerHeapSize) && TIMER_EXPIRES_BEFORE(aTimerHeap[child_index + 1], aTimerHeap[child_index]))
+    {
+      child_index++;
+    }
+    if(!TIMER_EXPIRES_BEFORE(aTimerHeap[child_index], timer_id))
+    {
+      break;
+    }
+    aTimerHeap[HeapIndex] = aTimerHeap[child_index];
+    aTimerContext[aTimerHeap[HeapIndex]].HeapIndex = HeapIndex;
+    HeapIndex = (uint8_t)child_index;
+  }
 
-    aTimerContext[previous_id].NextID = TimerID;
-    aTimerContext[TimerID].NextID = RefTimerID;
-    aTimerContext[TimerID].PreviousID = previous_id ;
-    aTimerContext[RefTimerID].PreviousID = TimerID;
+  aTimerHeap[HeapIndex] = timer_id;
+  aTimerContext[timer_id].HeapIndex = HeapIndex;
+
+  return;
+}
+
+/**
+ * @brief  Return the number of ticks left before the latest time at which a Timer may be notified
+ * @note   The value saturates when the slack added to the timeout does not fit in 32 bits
+ * @param  TimerID: The ID of the Timer
+ * @retval Number of ticks from the time base to the deadline of the Timer
+ */
+static uint32_t DeadlineTicksLeft(uint8_t TimerID)
+{
+  uint32_t ticks_left;
+
+  ticks_left = TIMER_TICKS_LEFT(TimerID);
+
+  if(aTimerContext[TimerID].Slack > (0xFFFFFFFF - ticks_left))
+  {
+    ticks_left = 0xFFFFFFFF;
   }
   else
   {
-    aTimerContext[TimerID].NextID = RefTimerID;
-    aTimerContext[RefTimerID].PreviousID = TimerID;
+    ticks_left += aTimerContext[TimerID].Slack;
+  }
+
+  return ticks_left;
+}
+
+/**
+ * @brief  Compute the time of the next wakeup
+ * @note   The wakeup is delayed up to the deadline of the first Timer to expire, as long as the deadline of
+ *         all the Timers expiring before the wakeup is met. This allows the Timers with overlapping tolerance
+ *         windows to be notified on a single wakeup
+ *         Only the Timers expiring before the wakeup are visited in the heap
+ * @param  None
+ * @retval Number of ticks from the time base to the wakeup
+ */
+static uint32_t ComputeWakeupTime(void)
+{
+  uint8_t  a_heap_index[CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER];
+  uint8_t  nbr_heap_index;
+  uint8_t  timer_id;
+  uint16_t child_index;
+  uint32_t wakeup_ticks_left;
+
+  wakeup_ticks_left = DeadlineTicksLeft(aTimerHeap[0]);
+
+  a_heap_index[0] = 0;
+  nbr_heap_index = 1;
+  while(nbr_heap_index != 0)
+  {
+    nbr_heap_index--;
+    timer_id = aTimerHeap[a_heap_index[nbr_heap_index]];
+    if(TIMER_TICKS_LEFT(timer_id) <= wakeup_ticks_left)
+    {
+      if(DeadlineTicksLeft(timer_id) < wakeup_ticks_left)
+      {
+        wakeup_ticks_left = DeadlineTicksLeft(timer_id);
+      }
+
+      /**
+       * The Timers below in the heap may expire before the wakeup as well
+       */
+      child_index = (2 * (uint16_t)a_heap_index[nbr_heap_index]) + 1;
+      if(child_index < TimerHeapSize)
+      {
+        a_heap_index[nbr_heap_index] = (uint8_t)child_index;
+        nbr_heap_index++;
+      }
+      if((child_index + 1) < TimerHeapSize)
+      {
+        a_heap_index[nbr_heap_index] = (uint8_t)(child_index + 1);
+        nbr_heap_index++;
+      }
+    }
+  }
+
+  return wakeup_ticks_left;
+}
+
+/**
+ * @brief  Bring the expiry time of the Timers that are going to be left behind the time base back to it
+ * @note   The time base may be advanced beyond the expiry of the first Timers (interrupt latency, slack). Their
+ *         expiry time is set to the new time base so that their ticks left read 0 instead of wrapping around.
+ *         The heap order is kept as these Timers expire before all the other ones
+ *         Only the Timers expiring before the new time base are visited in the heap
+ * @param  TimeElapsed: Number of ticks the time base is advanced by
+ * @retval None
+ */
+static void SaturateExpiredTimers(uint16_t TimeElapsed)
+{
+  uint8_t  a_heap_index[CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER];
+  uint8_t  nbr_heap_index;
+  uint8_t  timer_id;
+  uint16_t child_index;
+
+  if(TimerHeapSize == 0)
+  {
+    return;
+  }
+
+  a_heap_index[0] = 0;
+  nbr_heap_index = 1;
+  while(nbr_heap_index != 0)
+  {
+    nbr_heap_index--;
+    timer_id = aTimerHeap[a_heap_index[nbr_heap_index]];
+    if(TIMER_TICKS_LEFT(timer_id) < TimeElapsed)
+    {
+      aTimerContext[timer_id].Expiry = TimeBase + TimeElapsed;
+
+      child_index = (2 * (uint16_t)a_heap_index[nbr_heap_index]) + 1;
+      if(child_index < TimerHeapSize)
+      {
+        a_heap_index[nbr_heap_index] = (uint8_t)child_index;
+        nbr_heap_index++;
+      }
+      if((child_index + 1) < TimerHeapSize)
+      {
+        a_heap_index[nbr_heap_index] = (uint8_t)(child_index + 1);
+        nbr_heap_index++;
+      }
+    }
   }
 
   return;
@@ -175,68 +339,45 @@ static void LinkTimerBefore(uint8_t TimerID, uint8_t RefTimerID)
 
 /**
  * @brief  Insert a Timer in the list
+ * @note   The list is a binary heap ordered on the expiry time so that the insertion is done in O(log(n))
+ *         The Timer running in the wakeup timer is always on top of the heap
  * @param  TimerID:   The ID of the Timer
  * @retval None
  */
 static uint16_t linkTimer(uint8_t TimerID)
 {
-  uint32_t time_left;
   uint16_t time_elapsed;
-  uint8_t timer_id_lookup;
-  uint8_t next_id;
 
   if(CurrentRunningTimerID == CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER)
   {
     /**
      * No timer in the list
      */
-    PreviousRunningTimerID = CurrentRunningTimerID;
-    CurrentRunningTimerID = TimerID;
-    aTimerContext[TimerID].NextID = CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER;
-
     SSRValueOnLastSetup = SSR_FORBIDDEN_VALUE;
     time_elapsed = 0;
   }
   else
   {
     time_elapsed = ReturnTimeElapsed();
+  }
 
-    /**
-     * update count of the timer to be linked
-     */
-    aTimerContext[TimerID].CountLeft += time_elapsed;
-    time_left = aTimerContext[TimerID].CountLeft;
+  /**
+   * The expiry time is computed from the time base which has been updated on the last setup of the wakeup timer
+   */
+  aTimerContext[TimerID].Expiry = TimeBase + time_elapsed + aTimerContext[TimerID].CounterInit;
 
-    /**
-     * Search for index where the new timer shall be linked
-     */
-    if(aTimerContext[CurrentRunningTimerID].CountLeft <= time_left)
-    {
-      /**
-       * Search for the ID after the first one
-       */
-      timer_id_lookup = CurrentRunningTimerID;
-      next_id = aTimerContext[timer_id_lookup].NextID;
-      while((next_id != CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER) && (aTimerContext[next_id].CountLeft <= time_left))
-      {
-        timer_id_lookup = aTimerContext[timer_id_lookup].NextID;
-        next_id = aTimerContext[timer_id_lookup].NextID;
-      }
+  aTimerHeap[TimerHeapSize] = TimerID;
+  TimerHeapSize++;
+  HeapSiftUp(TimerHeapSize - 1);
 
-      /**
-       * Link after the ID
-       */
-      LinkTimerAfter(TimerID, timer_id_lookup);
-    }
-    else
-    {
-      /**
-       * Link before the first ID
-       */
-      LinkTimerBefore(TimerID, CurrentRunningTimerID);
-      PreviousRunningTimerID = CurrentRunningTimerID;
-      CurrentRunningTimerID = TimerID;
-    }
+  /**
+   * PreviousRunningTimerID is only updated when the new Timer is the first to expire. Otherwise it is kept
+   * as set by UnlinkTimer(), so that a Timer restarted from the wakeup handler reschedules the wakeup timer
+   */
+  if(aTimerHeap[0] != CurrentRunningTimerID)
+  {
+    PreviousRunningTimerID = CurrentRunningTimerID;
+    CurrentRunningTimerID = aTimerHeap[0];
   }
 
   return time_elapsed;
@@ -250,24 +391,31 @@ static uint16_t linkTimer(uint8_t TimerID)
  */
 static void UnlinkTimer(uint8_t TimerID, RequestReadSSR_t RequestReadSSR)
 {
-  uint8_t previous_id;
-  uint8_t next_id;
+  uint8_t heap_index;
+  uint8_t last_id;
 
-  if(TimerID == CurrentRunningTimerID)
+  heap_index = aTimerContext[TimerID].HeapIndex;
+  TimerHeapSize--;
+
+  if(heap_index != TimerHeapSize)
   {
-    PreviousRunningTimerID = CurrentRunningTimerID;
-    CurrentRunningTimerID = aTimerContext[TimerID].NextID;
+    /**
+     * Move the last Timer of the heap in place of the one removed
+     */
+    last_id = aTimerHeap[TimerHeapSize];
+    aTimerHeap[heap_index] = last_id;
+    HeapSiftUp(heap_index);
+    HeapSiftDown(aTimerContext[last_id].HeapIndex);
+  }
+
+  PreviousRunningTimerID = CurrentRunningTimerID;
+  if(TimerHeapSize != 0)
+  {
+    CurrentRunningTimerID = aTimerHeap[0];
   }
   else
   {
-    previous_id = aTimerContext[TimerID].PreviousID;
-    next_id = aTimerContext[TimerID].NextID;
-
-    aTimerContext[previous_id].NextID = aTimerContext[TimerID].NextID;
-    if(next_id != CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER)
-    {
-      aTimerContext[next_id].PreviousID = aTimerContext[TimerID].PreviousID;
-    }
+    CurrentRunningTimerID = CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER;
   }
 
   /**
@@ -386,14 +534,13 @@ static void RestartWakeupCounter(uint16_t Value)
 
 /**
  * @brief  Reschedule the list of timer
- * @note  1) Update the count left for each timer in the list
+ * @note  1) Update the time base with the ticks counted since the last setup
  *    2) Setup the wakeuptimer
  * @param  None
  * @retval None
  */
 static void RescheduleTimerList(void)
 {
-  uint8_t   localTimerID;
   uint32_t  timecountleft;
   uint16_t  wakeup_timer_value;
   uint16_t  time_elapsed;
@@ -411,60 +558,50 @@ static void RescheduleTimerList(void)
   }
   __HAL_RTC_WAKEUPTIMER_DISABLE(phrtc);   /**<  Disable the Wakeup Timer */
 
-  localTimerID = CurrentRunningTimerID;
-
   /**
-   * Calculate what will be the value to write in the wakeuptimer
+   * Read how much has been counted and update the time base
+   * The count left of every timer in the list is implicitly updated, the timers already expired are
+   * kept at the time base
    */
-  timecountleft = aTimerContext[localTimerID].CountLeft;
+  time_elapsed = ReturnTimeElapsed();
+  SaturateExpiredTimers(time_elapsed);
+  TimeBase += time_elapsed;
 
   /**
-   * Read how much has been counted
+   * Calculate what will be the value to write in the wakeuptimer
    */
-  time_elapsed = ReturnTimeElapsed();
-
-  if(timecountleft < time_elapsed )
+  if(TIMER_TICKS_LEFT(CurrentRunningTimerID) == 0)
   {
     /**
-     * There is no tick left to count
+     * The first timer is already expired: it is notified without delay
      */
-    wakeup_timer_value = 0;
-    WakeupTimerLimitation = WakeupTimerValue_LargeEnough;
+    timecountleft = 0;
   }
   else
   {
-    if(timecountleft > (time_elapsed + MaxWakeupTimerSetup))
-    {
-      /**
-       * The number of tick left is greater than the Wakeuptimer maximum value
-       */
-      wakeup_timer_value = MaxWakeupTimerSetup;
+    timecountleft = ComputeWakeupTime();
+  }
+  WakeupTime = TimeBase + timecountleft;
 
-      WakeupTimerLimitation = WakeupTimerValue_Overpassed;
-    }
-    else
-    {
-      wakeup_timer_value = timecountleft - time_elapsed;
-      WakeupTimerLimitation = WakeupTimerValue_LargeEnough;
-    }
+  if(timecountleft > MaxWakeupTimerSetup)
+  {
+    /**
+     * The number of tick left is greater than the Wakeuptimer maximum value
+     */
+    wakeup_timer_value = MaxWakeupTimerSetup;
 
+    WakeupTimerLimitation = WakeupTimerValue_Overpassed;
+  }
+  else
+  {
+    wakeup_timer_value = (uint16_t)timecountleft;
+    WakeupTimerLimitation = WakeupTimerValue_LargeEnough;
   }
 
   /**
-   * update ticks left to be counted for each timer
+   * When there is no tick left, the timer is notified without waiting for the wakeup timer
    */
-  while(localTimerID != CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER)
-  {
-    if (aTimerContext[localTimerID].CountLeft < time_elapsed)
-    {
-      aTimerContext[localTimerID].CountLeft = 0;
-    }
-    else
-    {
-      aTimerContext[localTimerID].CountLeft -= time_elapsed;
-    }
-    localTimerID = aTimerContext[localTimerID].NextID;
-  }
+  WakeupProgrammed = (wakeup_timer_value != 0);
 
   /**
    * Write next count
@@ -523,13 +660,19 @@ void HW_TS_RTC_Wakeup_Handler(void)
      */
     if(WakeupTimerLimitation != WakeupTimerValue_Overpassed)
     {
+      TimerExpiredCount++;
+      if(WakeupProgrammed != 0)
+      {
+        RtcWakeupCount++;
+      }
+
       if(aTimerContext[local_current_running_timer_id].TimerMode == hw_ts_Repeated)
       {
         UnlinkTimer(local_current_running_timer_id, SSR_Read_Not_Requested);
 #if (CFG_HW_TS_USE_PRIMASK_AS_CRITICAL_SECTION == 1)
         __set_PRIMASK(primask_bit); /**< Restore PRIMASK bit*/
 #endif
-        HW_TS_Start(local_current_running_timer_id, aTimerContext[local_current_running_timer_id].CounterInit);
+        HW_TS_StartWithSlack(local_current_running_timer_id, aTimerContext[local_current_running_timer_id].CounterInit, aTimerContext[local_current_running_timer_id].Slack);
 
         /* Disable the write protection for RTC registers */
         __HAL_RTC_WRITEPROTECTION_DISABLE( phrtc );
@@ -644,6 +787,10 @@ void HW_TS_Init(HW_TS_InitMode_t TimerInitMode, RTC_HandleTypeDef *hrtc)
     }
 
     CurrentRunningTimerID = CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER;   /**<  Set ID to non valid value */
+    TimerHeapSize = 0;
+    TimeBase = 0;
+    RtcWakeupCount = 0;
+    TimerExpiredCount = 0;
 
     __HAL_RTC_WAKEUPTIMER_DISABLE(phrtc);                       /**<  Disable the Wakeup Timer */
     __HAL_RTC_WAKEUPTIMER_CLEAR_FLAG(phrtc, RTC_FLAG_WUTF);     /**<  Clear flag in RTC module */
@@ -799,7 +946,13 @@ void HW_TS_Stop(uint8_t timer_id)
 
 void HW_TS_Start(uint8_t timer_id, uint32_t timeout_ticks)
 {
-  uint16_t time_elapsed;
+  HW_TS_StartWithSlack(timer_id, timeout_ticks, 0);
+
+  return;
+}
+
+void HW_TS_StartWithSlack(uint8_t timer_id, uint32_t timeout_ticks, uint32_t slack_ticks)
+{
   uint8_t localcurrentrunningtimerid;
 
 #if (CFG_HW_TS_USE_PRIMASK_AS_CRITICAL_SECTION == 1)
@@ -823,21 +976,21 @@ void HW_TS_Start(uint8_t timer_id, uint32_t timeout_ticks)
 
   aTimerContext[timer_id].TimerIDStatus = TimerID_Running;
 
-  aTimerContext[timer_id].CountLeft = timeout_ticks;
   aTimerContext[timer_id].CounterInit = timeout_ticks;
+  aTimerContext[timer_id].Slack = slack_ticks;
 
-  time_elapsed =  linkTimer(timer_id);
+  (void)linkTimer(timer_id);
 
   localcurrentrunningtimerid = CurrentRunningTimerID;
 
-  if(PreviousRunningTimerID != localcurrentrunningtimerid)
+  /**
+   * The wakeup timer shall be setup again when the new timer is the first to expire or when
+   * its deadline is before the wakeup already programmed
+   */
+  if((PreviousRunningTimerID != localcurrentrunningtimerid) || (DeadlineTicksLeft(timer_id) < (WakeupTime - TimeBase)))
   {
     RescheduleTimerList();
   }
-  else
-  {
-    aTimerContext[timer_id].CountLeft -= time_elapsed;
-  }
 
   /* Enable the write protection for RTC registers */
   __HAL_RTC_WRITEPROTECTION_ENABLE( phrtc );
@@ -851,6 +1004,21 @@ void HW_TS_Start(uint8_t timer_id, uint32_t timeout_ticks)
   return;
 }
 
+void HW_TS_ReadWakeupCounters(uint32_t *pRtcWakeupCount, uint32_t *pWakeupAvoidedCount)
+{
+  uint32_t primask_bit;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+  *pRtcWakeupCount = RtcWakeupCount;
+  *pWakeupAvoidedCount = TimerExpiredCount - RtcWakeupCount;
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+
+  return;
+}
+
 uint16_t HW_TS_RTC_ReadLeftTicksToCount(void)
 {
   uint32_t primask_bit;
@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @file    app_conf.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the application configuration for the Linux host
+ *          build of the NVM of the application
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Only the definitions used by appli_nvm.c are provided. The timer server and
+ * the sequencer are simulated by nvm_host.c.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_CONF_H
+#define APP_CONF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "hw_if.h"
+
+#define CFG_DEBUG_TRACE                                                     0
+
+/* DIVR((CFG_RTCCLK_DIV * 1000000), LSE_VALUE) with the default RTC divider of 16 */
+#define CFG_TS_TICK_VAL                                                   488
+
+typedef enum
+{
+  CFG_TIM_PROC_ID_ISR,
+} CFG_TimProcID_t;
+
+typedef enum
+{
+  CFG_TASK_APPLI_REQ_ID,
+  CFG_LAST_TASK_ID_WITH_NO_HCICMD
+} CFG_Task_Id_With_NO_HCI_Cmd_t;
+
+typedef enum
+{
+  CFG_SCH_PRIO_0,
+  CFG_PRIO_NBR,
+} CFG_SCH_Prio_Id_t;
+
+#endif /*APP_CONF_H */
@@ -0,0 +1,34 @@
+/**
+ ******************************************************************************
+ * @file    ble.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the BLE interface for the Linux host build of the
+ *          NVM of the application
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * pal_nvm.c only uses the flash geometry of the STM32WB55xx, the flash is
+ * simulated by flash_driver_host.c of the BLE_Ota application.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __BLE_H
+#define __BLE_H
+
+#define FLASH_BASE           (0x08000000UL)
+#define FLASH_SIZE           (0x00100000UL)
+#define FLASH_BANK_SIZE      FLASH_SIZE
+#define FLASH_PAGE_SIZE      (0x00001000U)
+
+#endif /*__BLE_H */
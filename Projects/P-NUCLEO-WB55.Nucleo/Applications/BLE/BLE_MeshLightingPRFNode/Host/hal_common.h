@@ -0,0 +1,36 @@
+/**
+ ******************************************************************************
+ * @file    hal_common.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the HAL of the mesh application for the Linux host
+ *          build of the NVM of the application
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef _HAL_H_
+#define _HAL_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "types.h"
+
+/* The flash operations are never suspended by the simulated CPU2 */
+#define LL_FLASH_IsActiveFlag_OperationSuspended()                          0
+
+#endif /* _HAL_H_ */
@@ -0,0 +1,51 @@
+/**
+ ******************************************************************************
+ * @file    hw_if.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the hardware interface for the Linux host build of
+ *          the NVM of the application
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Only the timer server API is provided, the timers are simulated by
+ * nvm_host.c.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HW_IF_H
+#define HW_IF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+typedef enum
+{
+  hw_ts_SingleShot,
+  hw_ts_Repeated
+} HW_TS_Mode_t;
+
+typedef enum
+{
+  hw_ts_Successful,
+  hw_ts_Failed,
+} HW_TS_ReturnStatus_t;
+
+typedef void (*HW_TS_pTimerCb_t)(void);
+
+HW_TS_ReturnStatus_t HW_TS_Create(uint32_t TimerProcessID, uint8_t *pTimerId, HW_TS_Mode_t TimerMode,
+                                  HW_TS_pTimerCb_t pTimerCallBack);
+void HW_TS_Stop(uint8_t TimerID);
+void HW_TS_Start(uint8_t TimerID, uint32_t timeout_ticks);
+
+#endif /* HW_IF_H */
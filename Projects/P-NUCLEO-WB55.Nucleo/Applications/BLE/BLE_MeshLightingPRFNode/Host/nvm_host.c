@@ -0,0 +1,490 @@
+/**
+ ******************************************************************************
+ * @file    nvm_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host run of the model states journal of appli_nvm.c over
+ *          the simulated flash
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The model states are saved with appli_nvm.c and pal_nvm.c in the flash
+ * simulated by flash_driver_host.c of the BLE_Ota application: the sectors
+ * erased and the 64bits data programmed are counted, and each operation
+ * advances the simulated time by its STM32WB55xx duration.
+ *
+ * The node runs as a Low Power Node: AppliNvm_Process() is only called when
+ * its task is set, by a save or by a timer of the simulated timer server. The
+ * task runs are counted.
+ *
+ * The light is driven by <updates> state changes, in sessions 1 to 10 s
+ * apart: either a dimming of 5 to 20 steps 50 ms apart or a single on/off
+ * change. After one session out of 10 on average, once the changes are
+ * written, the node restarts: the time of AppliNvm_LoadModelState() is
+ * measured with the size of the journal replayed, and the states restored are
+ * compared with the last ones saved. Any difference is an error, so is a
+ * 64bits data programmed over data not erased.
+ *
+ * nvm_host_subpage, built with NVM_HOST_SUBPAGE, runs the same updates over
+ * the former scheme of this application: a 256 bytes subpage written per save
+ * and the page erased every 15 saves, as still done by BLE_MeshLightingLPN.
+ * That code stalls the erase on a Low Power Node, so the node runs the main
+ * loop of the other nodes instead: AppliNvm_Process() is called every 1 ms
+ * and these calls are counted as task runs. The former scheme loses the
+ * states when the node restarts with the page full, such restores are
+ * counted apart and are not errors.
+ *
+ * Usage: nvm_host [-n updates] [-s seed] [-c csv]
+ *        nvm_host_subpage [-n updates] [-s seed] [-c csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * The stand-in of hal_common.h is included first, the one of the application
+ * being next to appli_nvm.c. appli_nvm.c is built as for a Low Power Node,
+ * without disabling the relay, proxy and friend features checked by mesh_cfg.h.
+ * The former appli_nvm.c is built with the headers of this application, the
+ * ones of BLE_MeshLightingLPN it uses being the same except mesh_cfg_usr.h
+ */
+#include "hal_common.h"
+#include "mesh_cfg.h"
+#ifdef NVM_HOST_SUBPAGE
+#include "../../BLE_MeshLightingLPN/STM32_WPAN/app/appli_nvm.c"
+#else
+#undef LOW_POWER_FEATURE
+#define LOW_POWER_FEATURE               1
+#include "appli_nvm.c"
+#endif
+
+/* Included by appli_nvm.c for a Low Power Node only */
+#include "app_conf.h"
+#include "stm32_seq.h"
+#include "ble.h"
+#include "flash_driver_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define NVM_HOST_MAX_ERRORS             (10U)
+#define NVM_HOST_MAX_TIMER_NBR          (4U)
+#define NVM_HOST_STEP_TIME              (50000U)        /**< Time between two steps of a dimming (us) */
+#define NVM_HOST_MIN_IDLE_TIME          (1000000U)      /**< Time between two sessions (us) */
+#define NVM_HOST_MAX_IDLE_TIME          (10000000U)
+#define NVM_HOST_RESTART_RATE           (10U)
+#define NVM_HOST_LOOP_TIME              (1000U)         /**< Period of the main loop of the subpage scheme (us) */
+#ifdef NVM_HOST_SUBPAGE
+#define NVM_HOST_SCHEME                 "subpage"
+#define NVM_HOST_WINDOW_MS              (0U)
+#else
+#define NVM_HOST_SCHEME                 "journal"
+#define NVM_HOST_WINDOW_MS              APP_NVM_JOURNAL_WINDOW_MS
+#endif
+/* Same layout as on target: the provisioner, the application and the mesh library pages */
+#define NVM_HOST_PRVN_BASE              (FLASH_BASE + 0x7A000U)
+#define NVM_HOST_APP_BASE               (NVM_HOST_PRVN_BASE + PRVN_NVM_PAGE_SIZE)
+#define NVM_HOST_MOBLE_BASE             (NVM_HOST_APP_BASE + APP_NVM_SIZE)
+/* Offsets of the states changed, as saved by Model_SaveStates() for the first element */
+#define NVM_HOST_ONOFF_OFFSET           (0U)
+#define NVM_HOST_LEVEL_OFFSET           (2U)
+#define NVM_HOST_LIGHTNESS_OFFSET       (APP_NVM_GENERIC_MODEL_SIZE)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  HW_TS_pTimerCb_t pCb;
+  uint64_t Expiry;                      /**< Simulated time of the timeout (us) */
+  uint8_t Running;
+} NVM_HOST_Timer_t;
+
+/* Private variables ---------------------------------------------------------*/
+const void *mobleNvmBase;
+const void *appNvmBase;
+const void *prvsnr_data;
+const MOBLEUINT8* _bdaddr[1];
+
+static uint32_t UpdateNbr = 10000U;
+static uint32_t Seed = 1U;
+static const char *CsvFile;
+
+static NVM_HOST_Timer_t Timer[NVM_HOST_MAX_TIMER_NBR];
+static uint32_t TimerNbr;
+static uint32_t TaskReq;
+static uint32_t TaskRunNbr;
+/* States of the models, as saved by the models */
+static MOBLEUINT8 State[APP_NVM_MODEL_SIZE];
+static MOBLEUINT8 Restored[APP_NVM_MODEL_SIZE];
+static uint32_t Random;
+static uint32_t LostNbr;
+static uint32_t ErrorNbr;
+
+/* Private function prototypes -----------------------------------------------*/
+static void NVM_HOST_Save( void );
+static void NVM_HOST_RunTasks( void );
+static void NVM_HOST_AdvanceTo( uint64_t Time );
+static uint64_t NVM_HOST_Restart( MOBLEBOOL *p_Lost );
+static uint32_t NVM_HOST_Random( uint32_t Range );
+static uint64_t NVM_HOST_NowNs( void );
+static void NVM_HOST_Error( const char *p_Msg, uint32_t Update );
+static void NVM_HOST_Usage( const char *p_Name );
+
+/* Functions Definition ------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+  uint32_t update = 0;
+  uint32_t session_nbr = 0;
+  uint32_t step_nbr;
+  uint32_t step;
+  uint16_t lightness = 0x8000U;
+  uint32_t restart_nbr = 0;
+  uint32_t journal_max = 0;
+  uint64_t restore_total_ns = 0;
+  MOBLEBOOL lost;
+  double restore_us;
+  FLASH_HOST_Stats_t flash_stats;
+  FILE *p_csv;
+  int opt;
+
+  while((opt = getopt(argc, argv, "n:s:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'n':
+        UpdateNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 's':
+        Seed = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'c':
+        CsvFile = optarg;
+        break;
+
+      default:
+        NVM_HOST_Usage(argv[0]);
+        break;
+    }
+  }
+
+  if(UpdateNbr == 0U)
+  {
+    NVM_HOST_Usage(argv[0]);
+  }
+
+  if(FLASH_HOST_Init() != 0)
+  {
+    fprintf(stderr, "the simulated flash cannot be mapped at 0x%08lX\n", FLASH_BASE);
+    return 2;
+  }
+  prvsnr_data = (const void *)NVM_HOST_PRVN_BASE;
+  appNvmBase = (const void *)NVM_HOST_APP_BASE;
+  mobleNvmBase = (const void *)NVM_HOST_MOBLE_BASE;
+
+  /* First start, the page holds the reserved area only */
+  Random = Seed;
+  memset((void*)NVM_HOST_APP_BASE, 0x5A, APP_NVM_RESERVED_SIZE);
+  (void)NVM_HOST_Restart(&lost);
+  NVM_HOST_RunTasks();
+
+  while(update < UpdateNbr)
+  {
+    session_nbr++;
+    if(NVM_HOST_Random(2U) == 0U)
+    {
+      /* Dimming */
+      step_nbr = 5U + NVM_HOST_Random(16U);
+      State[NVM_HOST_ONOFF_OFFSET] = 1U;
+      for(step = 0; (step < step_nbr) && (update < UpdateNbr); step++)
+      {
+        lightness += (uint16_t)(NVM_HOST_Random(0x1000U) - 0x800U);
+        memcpy(&State[NVM_HOST_LIGHTNESS_OFFSET], &lightness, sizeof(lightness));
+        memcpy(&State[NVM_HOST_LEVEL_OFFSET], &lightness, sizeof(lightness));
+        NVM_HOST_Save();
+        update++;
+        NVM_HOST_AdvanceTo(FLASH_HOST_GetTime() + NVM_HOST_STEP_TIME);
+      }
+    }
+    else
+    {
+      /* On/Off */
+      State[NVM_HOST_ONOFF_OFFSET] ^= 1U;
+      NVM_HOST_Save();
+      update++;
+    }
+
+    NVM_HOST_AdvanceTo(FLASH_HOST_GetTime() + NVM_HOST_MIN_IDLE_TIME +
+                       NVM_HOST_Random(NVM_HOST_MAX_IDLE_TIME - NVM_HOST_MIN_IDLE_TIME));
+
+    if(NVM_HOST_Random(NVM_HOST_RESTART_RATE) == 0U)
+    {
+      restart_nbr++;
+      restore_total_ns += NVM_HOST_Restart(&lost);
+#ifndef NVM_HOST_SUBPAGE
+      if(AppliNvm_Reqs.journalOffset > journal_max)
+      {
+        journal_max = AppliNvm_Reqs.journalOffset;
+      }
+#endif
+      if(lost == MOBLE_TRUE)
+      {
+        LostNbr++;
+      }
+      else if(memcmp(Restored, State, APP_NVM_MODEL_SIZE) != 0)
+      {
+        NVM_HOST_Error("restored states differ from the saved ones", update);
+      }
+      /* The journal may be compacted at startup */
+      NVM_HOST_RunTasks();
+    }
+  }
+
+  FLASH_HOST_GetStats(&flash_stats);
+  if(flash_stats.ProgramErrorNbr != 0U)
+  {
+    NVM_HOST_Error("64bits data programmed over data not erased", update);
+  }
+
+  restore_us = (restart_nbr != 0U) ? (double)restore_total_ns / restart_nbr / 1000 : 0;
+
+  printf("%s, window %u ms: %u updates, %u sessions, %u erases, %u 64bits programmed, %u task runs, "
+         "%u restarts (%u lost), restore %.1f us (journal up to %u bytes), %u errors\n", NVM_HOST_SCHEME,
+         NVM_HOST_WINDOW_MS, UpdateNbr, session_nbr, flash_stats.EraseNbr, flash_stats.ProgramNbr, TaskRunNbr,
+         restart_nbr, LostNbr, restore_us, journal_max, ErrorNbr);
+
+  if(CsvFile != NULL)
+  {
+    p_csv = fopen(CsvFile, "a");
+    if(p_csv != NULL)
+    {
+      if(ftell(p_csv) == 0)
+      {
+        fprintf(p_csv, "scheme,window_ms,updates,sessions,erases,programs,task_runs,restarts,lost,restore_us,"
+                "journal_max,errors\n");
+      }
+      fprintf(p_csv, "%s,%u,%u,%u,%u,%u,%u,%u,%u,%.1f,%u,%u\n", NVM_HOST_SCHEME, NVM_HOST_WINDOW_MS, UpdateNbr,
+              session_nbr, flash_stats.EraseNbr, flash_stats.ProgramNbr, TaskRunNbr, restart_nbr, LostNbr,
+              restore_us, journal_max, ErrorNbr);
+      fclose(p_csv);
+    }
+  }
+
+  return (ErrorNbr == 0U) ? 0 : 1;
+}
+
+/**
+ * @brief Timer server, the timers run on the simulated time
+ */
+HW_TS_ReturnStatus_t HW_TS_Create( uint32_t TimerProcessID, uint8_t *pTimerId, HW_TS_Mode_t TimerMode,
+                                   HW_TS_pTimerCb_t pTimerCallBack )
+{
+  if((TimerNbr == NVM_HOST_MAX_TIMER_NBR) || (TimerMode != hw_ts_SingleShot))
+  {
+    return hw_ts_Failed;
+  }
+  Timer[TimerNbr].pCb = pTimerCallBack;
+  Timer[TimerNbr].Running = 0;
+  *pTimerId = (uint8_t)TimerNbr;
+  TimerNbr++;
+
+  return hw_ts_Successful;
+}
+
+void HW_TS_Stop( uint8_t TimerID )
+{
+  Timer[TimerID].Running = 0;
+
+  return;
+}
+
+void HW_TS_Start( uint8_t TimerID, uint32_t timeout_ticks )
+{
+  Timer[TimerID].Expiry = FLASH_HOST_GetTime() + ((uint64_t)timeout_ticks * CFG_TS_TICK_VAL);
+  Timer[TimerID].Running = 1;
+
+  return;
+}
+
+/**
+ * @brief Sequencer, only the task of the application is run by NVM_HOST_RunTasks()
+ */
+void UTIL_SEQ_SetTask( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio )
+{
+  TaskReq |= TaskId_bm;
+
+  return;
+}
+
+void BLEMesh_SuspendAdvScan( void )
+{
+  return;
+}
+
+void BLEMesh_ResumeAdvScan( void )
+{
+  return;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+/**
+ * @brief Save of the states by the models
+ */
+static void NVM_HOST_Save( void )
+{
+  (void)AppliNvm_SaveModelState(State, APP_NVM_MODEL_SIZE);
+  NVM_HOST_RunTasks();
+
+  return;
+}
+
+#ifdef NVM_HOST_SUBPAGE
+/**
+ * @brief Main loop, the requests are processed within 1 ms
+ */
+static void NVM_HOST_RunTasks( void )
+{
+  TaskRunNbr++;
+  AppliNvm_Process();
+
+  return;
+}
+#else
+static void NVM_HOST_RunTasks( void )
+{
+  while((TaskReq & (1U << CFG_TASK_APPLI_REQ_ID)) != 0U)
+  {
+    TaskReq &= ~(1U << CFG_TASK_APPLI_REQ_ID);
+    TaskRunNbr++;
+    AppliNvm_Process();
+  }
+
+  return;
+}
+#endif
+
+/**
+ * @brief Run the timers expiring up to the time, in order
+ */
+static void NVM_HOST_AdvanceTo( uint64_t Time )
+{
+  uint32_t index;
+  uint32_t next;
+
+  do
+  {
+    next = NVM_HOST_MAX_TIMER_NBR;
+    for(index = 0; index < TimerNbr; index++)
+    {
+      if((Timer[index].Running != 0) && (Timer[index].Expiry <= Time) &&
+         ((next == NVM_HOST_MAX_TIMER_NBR) || (Timer[index].Expiry < Timer[next].Expiry)))
+      {
+        next = index;
+      }
+    }
+
+    if(next != NVM_HOST_MAX_TIMER_NBR)
+    {
+      if(Timer[next].Expiry > FLASH_HOST_GetTime())
+      {
+        FLASH_HOST_Advance(Timer[next].Expiry - FLASH_HOST_GetTime());
+      }
+      Timer[next].Running = 0;
+      Timer[next].pCb();
+      NVM_HOST_RunTasks();
+    }
+  } while(next != NVM_HOST_MAX_TIMER_NBR);
+
+#ifdef NVM_HOST_SUBPAGE
+  while((FLASH_HOST_GetTime() + NVM_HOST_LOOP_TIME) <= Time)
+  {
+    FLASH_HOST_Advance(NVM_HOST_LOOP_TIME);
+    NVM_HOST_RunTasks();
+  }
+#endif
+
+  if(Time > FLASH_HOST_GetTime())
+  {
+    FLASH_HOST_Advance(Time - FLASH_HOST_GetTime());
+  }
+
+  return;
+}
+
+/**
+ * @brief Restart of the node: the RAM of appli_nvm.c and the timers are cleared, then the states are loaded.
+ *        The tasks set at startup are not run
+ * @param p_Lost: MOBLE_TRUE when no states are restored as the page is full, with the subpage scheme only
+ * @retval Time of AppliNvm_LoadModelState() (ns)
+ */
+static uint64_t NVM_HOST_Restart( MOBLEBOOL *p_Lost )
+{
+  MOBLE_RESULT result;
+  uint64_t start_time;
+  uint64_t restore_ns;
+  uint16_t size;
+
+  memset(&AppliNvm_Reqs, 0, sizeof(AppliNvm_Reqs));
+  StopRadioInProgress = 0;
+  TimerNbr = 0;
+  TaskReq = 0;
+  memset(Restored, 0, APP_NVM_MODEL_SIZE);
+
+  start_time = NVM_HOST_NowNs();
+  result = AppliNvm_LoadModelState(Restored, &size);
+  restore_ns = NVM_HOST_NowNs() - start_time;
+#ifdef NVM_HOST_SUBPAGE
+  *p_Lost = (result == MOBLE_RESULT_FAIL) ? MOBLE_TRUE : MOBLE_FALSE;
+#else
+  (void)result;
+  *p_Lost = MOBLE_FALSE;
+#endif
+
+  return restore_ns;
+}
+
+/**
+ * @brief Linear congruential generator, the updates only depend on the seed
+ */
+static uint32_t NVM_HOST_Random( uint32_t Range )
+{
+  Random = (Random * 1103515245U) + 12345U;
+
+  return (Random >> 8) % Range;
+}
+
+static uint64_t NVM_HOST_NowNs( void )
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static void NVM_HOST_Error( const char *p_Msg, uint32_t Update )
+{
+  if(ErrorNbr < NVM_HOST_MAX_ERRORS)
+  {
+    printf("error: update %u: %s\n", Update, p_Msg);
+  }
+  ErrorNbr++;
+
+  return;
+}
+
+static void NVM_HOST_Usage( const char *p_Name )
+{
+  fprintf(stderr, "usage: %s [-n updates] [-s seed] [-c csv]\n", p_Name);
+  exit(2);
+}
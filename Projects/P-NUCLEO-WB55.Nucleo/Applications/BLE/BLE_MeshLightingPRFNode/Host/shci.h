@@ -0,0 +1,28 @@
+/**
+ ******************************************************************************
+ * @file    shci.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the system commands for the Linux host build of the
+ *          NVM of the application
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * pal_nvm.c does not use the system commands.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SHCI_H
+#define __SHCI_H
+
+#endif /*__SHCI_H */
@@ -0,0 +1,41 @@
+/**
+ ******************************************************************************
+ * @file    types.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the mesh types for the Linux host build of the NVM
+ *          of the application
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * MOBLEUINT32 and MOBLEINT32 are long in types.h, they are made 32 bits wide
+ * as on target.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_TYPES_H
+#define HOST_TYPES_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#define MOBLEINT32 MOBLEINT32_LP64
+#define MOBLEUINT32 MOBLEUINT32_LP64
+#include "../../../../../../Middlewares/ST/STM32_WPAN/ble/mesh/Inc/types.h"
+#undef MOBLEINT32
+#undef MOBLEUINT32
+
+typedef int32_t MOBLEINT32;
+typedef uint32_t MOBLEUINT32;
+
+#endif /* HOST_TYPES_H */
@@ -30,10 +30,8 @@
 #ifdef SAVE_MODEL_STATE_FOR_ALL_MESSAGES
 #include "common.h"
 #endif
-#if (LOW_POWER_FEATURE == 1)
 #include "app_conf.h"
 #include "stm32_seq.h"
-#endif
 #include "config_client.h"
 
 /** @addtogroup ST_BLE_Mesh
@@ -55,13 +53,36 @@ extern const void* appNvmBase;
 
 
 /*
-*  Page of size 4k, STM32WB, reserved for application is divided into 16 subpages of each 256 bytes
-*  First subpage is reserved (for e.g. External MAC is present in this area)
-*  Rest 15 subpages are used on rolling basis for application states. 
-*    First byte of each subpage indicates if page is valid or not
+*  Page of size 4k, STM32WB, reserved for application
+*  First 256 bytes are reserved (for e.g. External MAC is present in this area)
+*  Rest of the page is a journal of the model states, made of records aligned on 8 bytes:
+*    a header of 8 bytes followed by the data padded with 0xFF.
+*    - A snapshot holds all the model states. It is the first record after an erase
+*    - A delta holds the range of bytes changed since the previous record
+*  The changes received within APP_NVM_JOURNAL_WINDOW_MS give one record.
+*  The page is erased only when the journal is full, a snapshot is then written again.
+*  At startup the records are replayed in order, a record with a wrong checksum 
+*  (interrupted write) is skipped.
 */
 
 #define APP_NVM_RESERVED_SIZE             256U
+#define APP_NVM_JOURNAL_OFFSET            APP_NVM_RESERVED_SIZE
+#define APP_NVM_JOURNAL_SIZE              (unsigned int)(APP_NVM_SIZE - APP_NVM_RESERVED_SIZE)
+#define APP_NVM_JOURNAL_HDR_SIZE          8U
+#define APP_NVM_JOURNAL_ALIGN(size)       (((size) + 7U) & ~7U)
+#define APP_NVM_JOURNAL_RECORD_MAX_SIZE   (APP_NVM_JOURNAL_HDR_SIZE + APP_NVM_JOURNAL_ALIGN(APP_NVM_MODEL_SIZE))
+
+/* record tags */
+#define APP_NVM_JOURNAL_EMPTY             0xFFFFU
+#define APP_NVM_JOURNAL_SNAPSHOT          0x5350U
+#define APP_NVM_JOURNAL_DELTA             0x4454U
+
+#ifndef APP_NVM_JOURNAL_WINDOW_MS
+#define APP_NVM_JOURNAL_WINDOW_MS         500U
+#endif
+#define APP_NVM_JOURNAL_WINDOW_TICKS      (APP_NVM_JOURNAL_WINDOW_MS*1000/CFG_TS_TICK_VAL)
+
+/* Former rolling subpages, still used by the disabled code below */
 #define APP_NVM_SUBPAGE_SIZE              256U
 #define APP_NVM_MAX_SUBPAGE               15U
 #define APP_NVM_SUBPAGE_OFFSET(i)         (unsigned int)(APP_NVM_RESERVED_SIZE + APP_NVM_SUBPAGE_SIZE*(i))
@@ -84,9 +105,24 @@ extern const void* appNvmBase;
 
 typedef struct
 {
-  MOBLEUINT8 modelData[APP_NVM_GENERIC_MODEL_SIZE+APP_NVM_LIGHT_MODEL_SIZE];
+  MOBLEUINT16 tag;              /* APP_NVM_JOURNAL_SNAPSHOT or APP_NVM_JOURNAL_DELTA */
+  MOBLEUINT16 offset;           /* offset of the data in the model states */
+  MOBLEUINT16 length;           /* number of bytes of data */
+  MOBLEUINT16 check;            /* checksum of offset, length and data */
+} APPLI_NVM_JOURNAL_HDR;
+
+typedef struct
+{
+  MOBLEUINT8 modelData[APP_NVM_MODEL_SIZE];    /* model states to be saved */
+  MOBLEUINT8 nvmData[APP_NVM_MODEL_SIZE];      /* model states held by the journal */
+  MOBLEUINT16 journalOffset;                   /* offset of the next record in the journal */
+  MOBLEBOOL journalLoaded;
+  MOBLEBOOL nvmValid;                          /* the journal holds a snapshot */
   MOBLEBOOL erasePageReq;
   MOBLEBOOL writeReq;
+  MOBLEBOOL flushReq;                          /* write without waiting for the window */
+  MOBLEBOOL windowTimerCreated;
+  MOBLEUINT8 windowTimerId;                    /* ends the window started by the first change */
 } APPLI_NVM_REQS;
 
 /* ALIGN(4) */
@@ -175,6 +211,246 @@ MOBLE_RESULT AppliNvm_FlashProgram(MOBLEUINT32 offset,
 }
 
 
+/**
+*  @brief  Checksum (CRC-16 CCITT) of a journal record.
+*          Unlike an additive checksum, it tells an erased byte (0xFF) from 0x00.
+*  @param  hdr: record header, its check field is not used
+*  @param  data: record data
+*  @retval checksum
+*/
+static MOBLEUINT16 AppliNvm_JournalCheck(APPLI_NVM_JOURNAL_HDR const *hdr,
+                                         MOBLEUINT8 const *data)
+{
+  MOBLEUINT16 crc = 0xFFFF;
+  MOBLEUINT8 field[4];
+  MOBLEUINT8 byte;
+  
+  field[0] = (MOBLEUINT8)hdr->offset;
+  field[1] = (MOBLEUINT8)(hdr->offset >> 8);
+  field[2] = (MOBLEUINT8)hdr->length;
+  field[3] = (MOBLEUINT8)(hdr->length >> 8);
+  
+  for (MOBLEUINT16 count=0; count<(sizeof(field) + hdr->length); count++)
+  {
+    byte = (count < sizeof(field)) ? field[count] : data[count - sizeof(field)];
+    crc ^= (MOBLEUINT16)byte << 8;
+    for (MOBLEUINT8 bit=0; bit<8; bit++)
+    {
+      crc = (crc & 0x8000) ? (MOBLEUINT16)((crc << 1) ^ 0x1021) : (MOBLEUINT16)(crc << 1);
+    }
+  }
+  
+  return crc;
+}
+
+
+/**
+*  @brief  Replay the journal records in nvmData and find the offset of the next record.
+*          The journal is full when an unknown record is found (e.g. written by a
+*          former firmware): it is then erased on the next write.
+*  @param  void
+*  @retval void
+*/
+static void AppliNvm_JournalReplay(void)
+{
+  APPLI_NVM_JOURNAL_HDR hdr;
+  MOBLEUINT8 const *data;
+  MOBLEUINT32 offset = 0;
+  MOBLEUINT32 recordSize;
+  
+  AppliNvm_Reqs.nvmValid = MOBLE_FALSE;
+  memset(AppliNvm_Reqs.nvmData, 0, APP_NVM_MODEL_SIZE);
+  
+  while (offset + APP_NVM_JOURNAL_HDR_SIZE <= APP_NVM_JOURNAL_SIZE)
+  {
+    memcpy((void*)&hdr,
+           (void*)(APP_NVM_BASE + APP_NVM_JOURNAL_OFFSET + offset),
+           APP_NVM_JOURNAL_HDR_SIZE);
+    
+    if (hdr.tag == APP_NVM_JOURNAL_EMPTY)
+    {
+      /* end of the journal */
+      break;
+    }
+    
+    recordSize = APP_NVM_JOURNAL_HDR_SIZE + APP_NVM_JOURNAL_ALIGN(hdr.length);
+    
+    if (((hdr.tag != APP_NVM_JOURNAL_SNAPSHOT) && (hdr.tag != APP_NVM_JOURNAL_DELTA)) ||
+        (hdr.length == 0) ||
+        (hdr.offset + hdr.length > APP_NVM_MODEL_SIZE) ||
+        (offset + recordSize > APP_NVM_JOURNAL_SIZE))
+    {
+      TRACE_M(TF_PROVISION,"Unknown record in the model states journal\r\n");
+      offset = APP_NVM_JOURNAL_SIZE;
+      break;
+    }
+    
+    data = (MOBLEUINT8 const *)(APP_NVM_BASE + APP_NVM_JOURNAL_OFFSET + offset + APP_NVM_JOURNAL_HDR_SIZE);
+    
+    if (AppliNvm_JournalCheck(&hdr, data) != hdr.check)
+    {
+      /* interrupted write, skip the record */
+    }
+    else if (hdr.tag == APP_NVM_JOURNAL_SNAPSHOT)
+    {
+      memset(AppliNvm_Reqs.nvmData, 0, APP_NVM_MODEL_SIZE);
+      memcpy(&AppliNvm_Reqs.nvmData[hdr.offset], data, hdr.length);
+      AppliNvm_Reqs.nvmValid = MOBLE_TRUE;
+    }
+    else if (AppliNvm_Reqs.nvmValid == MOBLE_TRUE)
+    {
+      memcpy(&AppliNvm_Reqs.nvmData[hdr.offset], data, hdr.length);
+    }
+    else
+    {
+      /* delta without snapshot, do nothing */
+    }
+    
+    offset += recordSize;
+  }
+  
+  AppliNvm_Reqs.journalOffset = (MOBLEUINT16)offset;
+  AppliNvm_Reqs.journalLoaded = MOBLE_TRUE;
+}
+
+
+/**
+*  @brief  Append to the journal the model states changed since the previous record.
+*          A snapshot is written when the journal holds none.
+*  @param  void
+*  @retval MOBLE_RESULT_SUCCESS on success or when nothing has changed
+*          MOBLE_RESULT_OUTOFMEMORY when the journal is full
+*          MOBLE_RESULT_FAIL on flash error, the record is skipped at replay
+*/
+static MOBLE_RESULT AppliNvm_JournalAppend(void)
+{
+  __attribute__((aligned(8))) MOBLEUINT8 record[APP_NVM_JOURNAL_RECORD_MAX_SIZE];
+  APPLI_NVM_JOURNAL_HDR hdr;
+  MOBLEUINT32 recordSize;
+  MOBLEUINT16 first = 0;
+  MOBLEUINT16 last = APP_NVM_MODEL_SIZE;
+  MOBLE_RESULT result;
+  
+  if (AppliNvm_Reqs.nvmValid == MOBLE_TRUE)
+  {
+    /* range of the changed bytes */
+    while ((first < last) && 
+           (AppliNvm_Reqs.modelData[first] == AppliNvm_Reqs.nvmData[first]))
+    {
+      first++;
+    }
+    while ((last > first) && 
+           (AppliNvm_Reqs.modelData[last-1] == AppliNvm_Reqs.nvmData[last-1]))
+    {
+      last--;
+    }
+    
+    if (first == last)
+    {
+      /* nothing has changed */
+      return MOBLE_RESULT_SUCCESS;
+    }
+    hdr.tag = APP_NVM_JOURNAL_DELTA;
+  }
+  else
+  {
+    hdr.tag = APP_NVM_JOURNAL_SNAPSHOT;
+  }
+  
+  hdr.offset = first;
+  hdr.length = last - first;
+  hdr.check = AppliNvm_JournalCheck(&hdr, &AppliNvm_Reqs.modelData[first]);
+  recordSize = APP_NVM_JOURNAL_HDR_SIZE + APP_NVM_JOURNAL_ALIGN(hdr.length);
+  
+  if (AppliNvm_Reqs.journalOffset + recordSize > APP_NVM_JOURNAL_SIZE)
+  {
+    TRACE_M(TF_PROVISION,"Model states journal is full \r\n");
+    return MOBLE_RESULT_OUTOFMEMORY;
+  }
+  
+  memset((void*)record, 0xFF, recordSize);
+  memcpy((void*)record, (void*)&hdr, APP_NVM_JOURNAL_HDR_SIZE);
+  memcpy((void*)&record[APP_NVM_JOURNAL_HDR_SIZE], 
+         (void*)&AppliNvm_Reqs.modelData[first], 
+         hdr.length);
+  
+  result = AppliNvm_FlashProgram(APP_NVM_JOURNAL_OFFSET + AppliNvm_Reqs.journalOffset,
+                                 record,
+                                 recordSize);
+  
+  if (result == MOBLE_RESULT_SUCCESS)
+  {
+    memcpy((void*)&AppliNvm_Reqs.nvmData[first], 
+           (void*)&AppliNvm_Reqs.modelData[first], 
+           hdr.length);
+    AppliNvm_Reqs.nvmValid = MOBLE_TRUE;
+  }
+  
+  /* the header is programmed first: when it is not empty, the record is kept
+     even if partly programmed, it is skipped at replay */
+  memcpy((void*)&hdr,
+         (void*)(APP_NVM_BASE + APP_NVM_JOURNAL_OFFSET + AppliNvm_Reqs.journalOffset),
+         APP_NVM_JOURNAL_HDR_SIZE);
+  if (hdr.tag != APP_NVM_JOURNAL_EMPTY)
+  {
+    AppliNvm_Reqs.journalOffset += recordSize;
+  }
+  
+  return result;
+}
+
+
+/**
+*  @brief  End of the window of the model states changes, called by the timer server.
+*          AppliNvm_Process() writes the changes in the journal.
+*  @param  void
+*  @retval void
+*/
+static void AppliNvm_JournalWindowCb(void)
+{
+  AppliNvm_Reqs.flushReq = MOBLE_TRUE;
+  UTIL_SEQ_SetTask( 1<<CFG_TASK_APPLI_REQ_ID, CFG_SCH_PRIO_0);
+  
+  return;
+}
+
+
+/**
+*  @brief  Start the window of the model states changes at the first change.
+*          No task is run until the window ends, so the low power mode is not prevented.
+*  @param  void
+*  @retval void
+*/
+static void AppliNvm_JournalWindowStart(void)
+{
+  if ((APP_NVM_JOURNAL_WINDOW_TICKS != 0) &&
+      (AppliNvm_Reqs.windowTimerCreated == MOBLE_FALSE))
+  {
+    if (HW_TS_Create(CFG_TIM_PROC_ID_ISR, 
+                     &AppliNvm_Reqs.windowTimerId, 
+                     hw_ts_SingleShot, 
+                     AppliNvm_JournalWindowCb) == hw_ts_Successful)
+    {
+      AppliNvm_Reqs.windowTimerCreated = MOBLE_TRUE;
+    }
+  }
+  
+  if (AppliNvm_Reqs.windowTimerCreated == MOBLE_TRUE)
+  {
+    /* the timer may have ended a window already written */
+    AppliNvm_Reqs.flushReq = MOBLE_FALSE;
+    HW_TS_Start(AppliNvm_Reqs.windowTimerId, APP_NVM_JOURNAL_WINDOW_TICKS);
+  }
+  else
+  {
+    /* no window, write now */
+    AppliNvm_JournalWindowCb();
+  }
+  
+  return;
+}
+
+
 /**
 *  @brief  Mark first valid subpage as invalid. 
 *  @param  void
@@ -345,7 +621,9 @@ MOBLE_RESULT AppliNvm_FactorySettingReset(void)
 
 
 /**
-* @brief  Save model states in nvm
+* @brief  Save model states in nvm. The states are written in the journal by 
+*         AppliNvm_Process() after APP_NVM_JOURNAL_WINDOW_MS, the states saved
+*         meanwhile replace them.
 * @param  model state buff
 * @param  model state buff size
 * @retval MOBLE_RESULT_SUCCESS on success
@@ -368,11 +646,11 @@ MOBLE_RESULT AppliNvm_SaveModelState(uint8_t* state,
            state, 
            size);
     
-    AppliNvm_Reqs.writeReq = MOBLE_TRUE;
-    AppliNvm_Reqs.erasePageReq = MOBLE_FALSE;
-#if (LOW_POWER_FEATURE == 1)
-    UTIL_SEQ_SetTask( 1<<CFG_TASK_APPLI_REQ_ID, CFG_SCH_PRIO_0);
-#endif
+    if (AppliNvm_Reqs.writeReq == MOBLE_FALSE)
+    {
+      AppliNvm_Reqs.writeReq = MOBLE_TRUE;
+      AppliNvm_JournalWindowStart();
+    }
   }
 #endif /* SAVE_MODEL_STATE_NVM */  
   return result;
@@ -389,51 +667,36 @@ MOBLE_RESULT AppliNvm_ClearModelState(void)
   MOBLE_RESULT result = MOBLE_RESULT_FAIL; /* if save model state not defined, return MOBLE_RESULT_FAIL */
   
 #if (SAVE_MODEL_STATE_NVM == 1)
-  MOBLEUINT8 subPageTemp[APP_NVM_SUBPAGE_SIZE];
-  MOBLEINT16 subPageIdx;
-  MOBLEUINT8 clearBuff[APP_NVM_MODELDATA_PER_ELEMENT_SIZE] = {0};
-  MOBLEUINT32 valid = 0;
+  if (AppliNvm_Reqs.journalLoaded == MOBLE_FALSE)
+  {
+    AppliNvm_JournalReplay();
+  }
   
-  result = AppliNvm_FindFirstEmptyPage(&subPageIdx,
-                                       APP_NVM_SUBPAGE_SIZE,
-                                       APP_NVM_MAX_SUBPAGE,
-                                       (APP_NVM_BASE+APP_NVM_RESERVED_SIZE));
-    
-  if (MOBLE_FAILED(result))
+  memset((void*)AppliNvm_Reqs.modelData, 
+         0, 
+         APP_NVM_MODEL_SIZE);
+  
+  if (AppliNvm_Reqs.erasePageReq == MOBLE_TRUE)
   {
-    result = MOBLE_RESULT_FAIL;
+    result = MOBLE_RESULT_OUTOFMEMORY;
   }
   else
   {
-    if(subPageIdx > 0)
-    { /* Not the first subpage */
-      /* clear models states */
-      memcpy((void*)&(subPageTemp[0]),
-             (void*)(APP_NVM_BASE + APP_NVM_SUBPAGE_OFFSET(subPageIdx-1)),
-             APP_NVM_SUBPAGE_SIZE);
-      memcpy((void*)&subPageTemp[APP_NVM_GENERIC_MODEL_OFFSET],
-             (void*)(clearBuff),
-             APP_NVM_GENERIC_MODEL_SIZE+APP_NVM_LIGHT_MODEL_SIZE);
-      subPageTemp[APP_NVM_VALID_FLAG_OFFSET] = valid;
-      
-      result = AppliNvm_FlashProgram(APP_NVM_SUBPAGE_OFFSET(subPageIdx),
-                                     (uint32_t*)&subPageTemp, 
-                                     APP_NVM_SUBPAGE_SIZE);
-    }
-    else
-    {  /* First subpage */
-      memcpy((void*)&(subPageTemp[0]),
-             (void*)(APP_NVM_BASE + APP_NVM_SUBPAGE_OFFSET(subPageIdx)),
-             APP_NVM_SUBPAGE_SIZE);
-      memcpy((void*)&subPageTemp[APP_NVM_GENERIC_MODEL_OFFSET],
-             (void*)(clearBuff),
-             APP_NVM_GENERIC_MODEL_SIZE+APP_NVM_LIGHT_MODEL_SIZE);
-      subPageTemp[APP_NVM_VALID_FLAG_OFFSET] = valid;
-      
-      result = AppliNvm_FlashProgram(APP_NVM_SUBPAGE_OFFSET(subPageIdx),
-                                     (uint32_t*)&subPageTemp, 
-                                     APP_NVM_SUBPAGE_SIZE);
-    }
+    result = AppliNvm_JournalAppend();
+  }
+  
+  if (result == MOBLE_RESULT_SUCCESS)
+  {
+    AppliNvm_Reqs.writeReq = MOBLE_FALSE;
+  }
+  else
+  {
+    /* written by AppliNvm_Process() */
+    AppliNvm_Reqs.writeReq = MOBLE_TRUE;
+    AppliNvm_Reqs.flushReq = MOBLE_TRUE;
+#if (LOW_POWER_FEATURE == 1)
+    UTIL_SEQ_SetTask( 1<<CFG_TASK_APPLI_REQ_ID, CFG_SCH_PRIO_0);
+#endif
   }
 #endif /* SAVE_MODEL_STATE_NVM */  
   return result;
@@ -451,36 +714,28 @@ MOBLE_RESULT AppliNvm_LoadModelState(uint8_t state[],
 {  
 #if (SAVE_MODEL_STATE_NVM == 1)  
   MOBLE_RESULT result = MOBLE_RESULT_SUCCESS;
-  MOBLEINT16 currSubPageIdx = 0;
   
   *size = 0;
-  result = AppliNvm_FindFirstEmptyPage(&currSubPageIdx,
-                                       APP_NVM_SUBPAGE_SIZE,
-                                       APP_NVM_MAX_SUBPAGE,
-                                       APP_NVM_BASE + APP_NVM_RESERVED_SIZE);
+  AppliNvm_JournalReplay();
   
-  if(result == MOBLE_RESULT_OUTOFMEMORY)
+  if (AppliNvm_Reqs.nvmValid == MOBLE_TRUE)
   {
+    memcpy((void*)AppliNvm_Reqs.modelData, 
+           (void*)AppliNvm_Reqs.nvmData, 
+           APP_NVM_MODEL_SIZE);
+    memcpy((void*)state, 
+           (void*)(AppliNvm_Reqs.modelData), 
+           APP_NVM_MODEL_SIZE);
+    *size = APP_NVM_MODEL_SIZE;
+  }
+  
+  if (AppliNvm_Reqs.journalOffset + APP_NVM_JOURNAL_RECORD_MAX_SIZE > APP_NVM_JOURNAL_SIZE)
+  {
+    /* no room left for a snapshot, compact the journal now */
     AppliNvm_Reqs.erasePageReq = MOBLE_TRUE;
 #if (LOW_POWER_FEATURE == 1)
     UTIL_SEQ_SetTask( 1<<CFG_TASK_APPLI_REQ_ID, CFG_SCH_PRIO_0);
 #endif
-    result = MOBLE_RESULT_FAIL;
-  }
-  else
-  {
-    if(currSubPageIdx > 0)
-    { 
-      /* Not the first reset */
-      /* Load model data copy from nvm */
-      memcpy((void*)AppliNvm_Reqs.modelData, 
-             (void*)(APP_NVM_BASE + APP_NVM_SUBPAGE_OFFSET(currSubPageIdx-1) + APP_NVM_GENERIC_MODEL_OFFSET), 
-             APP_NVM_GENERIC_MODEL_SIZE + APP_NVM_LIGHT_MODEL_SIZE);
-      memcpy((void*)state, 
-             (void*)(AppliNvm_Reqs.modelData), 
-             APP_NVM_MODEL_SIZE);
-      *size = APP_NVM_MODEL_SIZE;
-    }
   }
   return result;  
 #else /* SAVE_MODEL_STATE_NVM */  
@@ -492,15 +747,21 @@ MOBLE_RESULT AppliNvm_LoadModelState(uint8_t state[],
 
 /**
 * @brief  Process NVM erase and write requests
+*         When the journal is full, the page is erased and the model states are 
+*         written again as a snapshot.
 * @param  void
 * @retval void
 */
 void AppliNvm_Process(void)
 {
   MOBLE_RESULT result;
-  MOBLEINT16 subPageIdx;
   uint8_t reserveAreaCopy[APP_NVM_RESERVED_SIZE];
   
+  if (AppliNvm_Reqs.journalLoaded == MOBLE_FALSE)
+  {
+    AppliNvm_JournalReplay();
+  }
+  
   /* Erase if required */
   if ((AppliNvm_Reqs.erasePageReq == MOBLE_TRUE) &&
       (!LL_FLASH_IsActiveFlag_OperationSuspended()))
@@ -525,7 +786,14 @@ void AppliNvm_Process(void)
       else
       {
         AppliNvm_Reqs.erasePageReq = MOBLE_FALSE;
-        AppliNvm_Reqs.writeReq = MOBLE_TRUE;
+        AppliNvm_Reqs.journalOffset = 0;
+        if (AppliNvm_Reqs.nvmValid == MOBLE_TRUE)
+        {
+          /* snapshot of the model states */
+          AppliNvm_Reqs.writeReq = MOBLE_TRUE;
+          AppliNvm_Reqs.flushReq = MOBLE_TRUE;
+        }
+        AppliNvm_Reqs.nvmValid = MOBLE_FALSE;
 #if (LOW_POWER_FEATURE == 1)
         UTIL_SEQ_SetTask( 1<<CFG_TASK_APPLI_REQ_ID, CFG_SCH_PRIO_0);
 #endif
@@ -538,16 +806,24 @@ void AppliNvm_Process(void)
       }
     }
     else
+    {
       StopRadioInProgress--;
+#if (LOW_POWER_FEATURE == 1)
+      UTIL_SEQ_SetTask( 1<<CFG_TASK_APPLI_REQ_ID, CFG_SCH_PRIO_0);
+#endif
+    }
   }
       
   if (AppliNvm_Reqs.erasePageReq == MOBLE_FALSE && 
       AppliNvm_Reqs.writeReq == MOBLE_TRUE)
   {
-    result = AppliNvm_FindFirstEmptyPage(&subPageIdx,
-                                         APP_NVM_SUBPAGE_SIZE,
-                                         APP_NVM_MAX_SUBPAGE,
-                                        (APP_NVM_BASE+APP_NVM_RESERVED_SIZE));
+    if (AppliNvm_Reqs.flushReq == MOBLE_FALSE)
+    {
+      /* wait for the next changes, the task is set at the end of the window */
+      return;
+    }
+    
+    result = AppliNvm_JournalAppend();
     
     if(result == MOBLE_RESULT_OUTOFMEMORY)
     {
@@ -560,41 +836,14 @@ void AppliNvm_Process(void)
 #endif
       result = MOBLE_RESULT_SUCCESS;
     }  
+    else if (result == MOBLE_RESULT_SUCCESS)
+    {
+      AppliNvm_Reqs.writeReq = MOBLE_FALSE;
+      AppliNvm_Reqs.flushReq = MOBLE_FALSE;
+    }
     else
     {
-      MOBLEUINT8 subPageTemp[APP_NVM_SUBPAGE_SIZE];
-      MOBLEUINT32 valid = 0;
-      
-      if(subPageIdx > 0)
-      { 
-        /* Not the first reset */
-        /* read the previous subpage */
-        memcpy((void*)&(subPageTemp[0]),
-               (void*)(APP_NVM_BASE + APP_NVM_SUBPAGE_OFFSET(subPageIdx-1)),
-               APP_NVM_SUBPAGE_SIZE);
-      }
-      else
-      {
-        /* read the current subpage */
-        memcpy((void*)&(subPageTemp[0]),
-               (void*)(APP_NVM_BASE + APP_NVM_SUBPAGE_OFFSET(subPageIdx)),
-               APP_NVM_SUBPAGE_SIZE);
-      }
-      
-      memcpy((void*)&(subPageTemp[APP_NVM_GENERIC_MODEL_OFFSET]),
-             (void*)&(AppliNvm_Reqs.modelData),
-             APP_NVM_GENERIC_MODEL_SIZE+APP_NVM_LIGHT_MODEL_SIZE);
-            
-      subPageTemp[APP_NVM_VALID_FLAG_OFFSET] = valid;
-
-      result = AppliNvm_FlashProgram(APP_NVM_SUBPAGE_OFFSET(subPageIdx), 
-                                     (uint8_t*)subPageTemp,
-                                     APP_NVM_SUBPAGE_SIZE);
-    
-      if (result == MOBLE_RESULT_SUCCESS)
-      {
-        AppliNvm_Reqs.writeReq = MOBLE_FALSE;
-      }
+      /* try again on next call */
     }
   }
 }
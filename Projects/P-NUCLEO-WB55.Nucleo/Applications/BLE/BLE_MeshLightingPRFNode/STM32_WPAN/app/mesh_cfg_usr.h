@@ -357,6 +357,12 @@ this should be avoided to ensure flash longevity
 #define APP_NVM_MODELDATA_PER_ELEMENT_SIZE  (APP_NVM_GENERIC_MODEL_SIZE+APP_NVM_LIGHT_MODEL_SIZE)
 //#define APP_NVM_MODEL_SIZE                                                   50U
 #define APP_NVM_MODEL_SIZE   (APP_NVM_MODELDATA_PER_ELEMENT_SIZE * APPLICATION_NUMBER_OF_ELEMENTS)
+
+/* Time in ms the model states wait before being written in NVM. The changes made
+  meanwhile (e.g. a dimming) are written as one record of the journal.
+  0 writes the states as soon as they change (e.g. for a Low Power Node).
+*/
+#define APP_NVM_JOURNAL_WINDOW_MS                                           500U
 //#define APP_NVM_MODEL_ALL_ELEMENTS_SIZE 
 
       
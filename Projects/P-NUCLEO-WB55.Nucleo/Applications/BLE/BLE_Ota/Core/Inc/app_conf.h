@@ -541,6 +541,7 @@ typedef enum
     CFG_FIRST_TASK_ID_WITH_NO_HCICMD = CFG_LAST_TASK_ID_WITH_HCICMD - 1,        /**< Shall be FIRST in the list */
 
     CFG_TASK_SYSTEM_HCI_ASYNCH_EVT_ID,
+    CFG_TASK_OTA_PIPE_ID,
 
     CFG_LAST_TASK_ID_WITHO_NO_HCICMD                                            /**< Shall be LAST in the list */
 } CFG_Task_Id_With_NO_HCI_Cmd_t;
@@ -0,0 +1,173 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    ota_pipeline.h
+  * @author  MCD Application Team
+  * @brief   OTA image pipeline interface
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2020-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OTA_PIPELINE_H
+#define OTA_PIPELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* Includes ------------------------------------------------------------------*/
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+
+/* USER CODE END Includes */
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  OTA_PIPE_PROCESS_REQ_EVT,     /**< OTA_PIPE_Process() shall be called from the background */
+  OTA_PIPE_COMPLETE_EVT,        /**< The image is in flash and its CRC has been checked */
+  OTA_PIPE_ERROR_EVT,           /**< The CRC read back from flash does not match the received image */
+  OTA_PIPE_READY_EVT,           /**< There is room for the chunk refused with OTA_PIPE_BUSY, it may be written again */
+}OTA_PIPE_Evt_t;
+
+typedef enum
+{
+  OTA_PIPE_OK,
+  OTA_PIPE_BUSY,                /**< The buffer is full, the chunk has not been taken */
+}OTA_PIPE_Status_t;
+
+typedef struct
+{
+  uint32_t ImageSize;           /**< Number of bytes received */
+  uint32_t WrittenSize;         /**< Number of bytes programmed in flash */
+  uint32_t ErasedSectorNbr;     /**< Number of sectors erased */
+  uint32_t DeferredNbr;         /**< Number of flash operations postponed by the timing protection */
+  uint32_t StallNbr;            /**< Number of chunks refused with OTA_PIPE_BUSY */
+  uint32_t BufferPeak;          /**< Highest number of bytes waiting in the buffer */
+  uint32_t Crc;                 /**< CRC-32 of the bytes received */
+  uint32_t Throughput;          /**< Bytes per second from the first chunk to the completion (or now) */
+}OTA_PIPE_Stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * Size of the buffer between the received chunks and the flash. It is a multiple of 8 bytes
+ */
+#ifndef CFG_OTA_PIPE_BUFFER_SIZE
+#define CFG_OTA_PIPE_BUFFER_SIZE                (8 * 1024)
+#endif
+
+/**
+ * Number of sectors kept erased ahead of the sector being written
+ */
+#ifndef CFG_OTA_PIPE_ERASE_AHEAD
+#define CFG_OTA_PIPE_ERASE_AHEAD                (2)
+#endif
+
+/**
+ * Number of 64bits data programmed on each call of OTA_PIPE_Process()
+ */
+#ifndef CFG_OTA_PIPE_WRITE_BURST
+#define CFG_OTA_PIPE_WRITE_BURST                (32)
+#endif
+
+/**
+ * Number of bytes read back from flash on each call of OTA_PIPE_Process() to check the CRC
+ */
+#ifndef CFG_OTA_PIPE_VERIFY_BURST
+#define CFG_OTA_PIPE_VERIFY_BURST               (4 * 1024)
+#endif
+
+/* Exported functions ------------------------------------------------------- */
+
+  /**
+   * @brief  Sets the flash area the pipeline erases. Its sectors are erased in order, just ahead of the write cursor
+   *         while the image is received, and the ones left are erased when the image is finished.
+   *         The sectors outside of the area are expected to be erased already.
+   *
+   * @param  FirstSector:   The first sector of the area
+   * @param  NbrOfSectors:  The number of sectors of the area, 0 when the pipeline shall not erase the flash
+   * @retval None
+   */
+  void OTA_PIPE_Init(uint32_t FirstSector, uint32_t NbrOfSectors);
+
+  /**
+   * @brief  Starts a new image. Any data of the previous image not yet in flash is discarded.
+   *
+   * @param  BaseAddress:   Address of the image in flash. It shall be 64bits aligned
+   * @retval None
+   */
+  void OTA_PIPE_Start(uint32_t BaseAddress);
+
+  /**
+   * @brief  Appends a chunk of the image. The chunk is copied in the buffer and programmed in the background.
+   *         When there is no room for the chunk, nothing is copied and OTA_PIPE_BUSY is returned: the chunk shall be
+   *         written again after OTA_PIPE_READY_EVT. The flash is never processed from this call.
+   *
+   * @param  pData:   Chunk of the image
+   * @param  Length:  Length of the chunk, not more than CFG_OTA_PIPE_BUFFER_SIZE
+   * @retval OTA_PIPE_OK when the chunk has been taken (or ignored as no image is started), OTA_PIPE_BUSY otherwise
+   */
+  OTA_PIPE_Status_t OTA_PIPE_Write(const uint8_t *pData, uint32_t Length);
+
+  /**
+   * @brief  Ends the image: the last 64bits data is padded with 0xFF, the buffer is flushed, the sectors left in the
+   *         area are erased and the CRC is read back from flash. OTA_PIPE_COMPLETE_EVT or OTA_PIPE_ERROR_EVT reports
+   *         the outcome.
+   *
+   * @param  None
+   * @retval None
+   */
+  void OTA_PIPE_Finish(void);
+
+  /**
+   * @brief  Drops the image being received. The sectors already erased stay erased.
+   *
+   * @param  None
+   * @retval None
+   */
+  void OTA_PIPE_Cancel(void);
+
+  /**
+   * @brief  Executes one flash operation (one sector erase, a burst of 64bits data or a CRC read back burst).
+   *         OTA_PIPE_PROCESS_REQ_EVT is reported when there is more to do. An operation postponed by the timing
+   *         protection of either CPU is tried again on the next call.
+   *
+   * @param  None
+   * @retval None
+   */
+  void OTA_PIPE_Process(void);
+
+  /**
+   * @brief  Statistics of the image being received, or of the last one
+   *
+   * @param  pStats:  Statistics
+   * @retval None
+   */
+  void OTA_PIPE_GetStats(OTA_PIPE_Stats_t *pStats);
+
+  /**
+   * Callbacks to be implemented by the application
+   *  - OTA_PIPE_Notification() reports the pipeline events
+   *  - OTA_PIPE_GetTick() returns a millisecond time base to compute the throughput. A weak implementation returns 0,
+   *    the throughput is then not computed.
+   */
+  void OTA_PIPE_Notification(OTA_PIPE_Evt_t Evt);
+  uint32_t OTA_PIPE_GetTick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*OTA_PIPELINE_H */
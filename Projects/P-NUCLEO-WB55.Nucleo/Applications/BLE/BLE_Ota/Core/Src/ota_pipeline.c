@@ -0,0 +1,428 @@
+/**
+  ******************************************************************************
+  * File Name          : ota_pipeline.c
+  * Description        : OTA image pipeline
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/**
+ * The chunks of the image are copied in a ring buffer of 64bits data and programmed from the background with
+ * OTA_PIPE_Process(), one short flash operation at a time, so that the BLE link keeps being served:
+ *  - the sectors of the area given to OTA_PIPE_Init() are erased in order, CFG_OTA_PIPE_ERASE_AHEAD sectors ahead of
+ *    the write cursor. A sector is erased before the cursor enters it. The sectors left are erased on OTA_PIPE_Finish()
+ *  - an operation postponed by the timing protection of either CPU (the flash driver reports it not executed) is
+ *    tried again on the next call
+ *  - a chunk is never programmed from OTA_PIPE_Write(): when there is no room for it, it is refused with
+ *    OTA_PIPE_BUSY and OTA_PIPE_READY_EVT is reported once OTA_PIPE_Process() has made room for it
+ *  - a CRC-32 of the received bytes is kept and compared with the CRC read back from flash once the image is written
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+
+#include "flash_driver.h"
+#include "ota_pipeline.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  OTA_PIPE_IDLE,
+  OTA_PIPE_RECEIVING,
+  OTA_PIPE_FINISHING,
+  OTA_PIPE_VERIFYING,
+}OTA_PIPE_State_t;
+
+typedef struct
+{
+  uint64_t Buffer[CFG_OTA_PIPE_BUFFER_SIZE / 8];
+  uint8_t  State;
+  uint32_t AreaFirstSector;
+  uint32_t AreaEndSector;               /**< First sector after the area */
+  uint32_t EraseNext;                   /**< Next sector of the area to erase */
+  uint32_t BaseAddress;
+  uint32_t WriteAddress;                /**< Next flash address to program */
+  uint32_t Head;                        /**< Number of bytes put in the buffer since OTA_PIPE_Start() */
+  uint32_t Tail;                        /**< Number of bytes programmed since OTA_PIPE_Start() */
+  uint32_t PendingLength;               /**< Length of the chunk refused with OTA_PIPE_BUSY, 0 when none */
+  uint32_t VerifyOffset;
+  uint32_t VerifyCrc;
+  uint32_t StartTick;
+  uint32_t EndTick;
+  OTA_PIPE_Stats_t Stats;
+}OTA_PIPE_Context_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define OTA_PIPE_DOUBLEWORD_SIZE        (8)
+#define OTA_PIPE_CRC_INIT               (0xFFFFFFFFU)
+
+/* Private macros ------------------------------------------------------------*/
+#define OTA_PIPE_SECTOR(address)        (((address) - FLASH_BASE) / FLASH_PAGE_SIZE)
+
+/* Private variables ---------------------------------------------------------*/
+static OTA_PIPE_Context_t OTA_PIPE_Context;
+
+/**
+ * CRC-32 (IEEE 802.3, reflected), processed 4 bits at a time
+ */
+static const uint32_t OTA_PIPE_CrcTable[16] =
+{
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/* Global variables ----------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t Crc32(uint32_t Crc, const uint8_t *pData, uint32_t Length);
+static uint8_t ProcessStep(void);
+static void EraseNextSector(void);
+static void ProgramBuffer(uint32_t NbrOfData);
+static void ResumeWrite(void);
+
+/* Public functions ----------------------------------------------------------*/
+void OTA_PIPE_Init(uint32_t FirstSector, uint32_t NbrOfSectors)
+{
+  OTA_PIPE_Context.State = OTA_PIPE_IDLE;
+  OTA_PIPE_Context.AreaFirstSector = FirstSector;
+  OTA_PIPE_Context.AreaEndSector = FirstSector + NbrOfSectors;
+  OTA_PIPE_Context.EraseNext = FirstSector;
+  OTA_PIPE_Context.WriteAddress = 0;
+
+  return;
+}
+
+void OTA_PIPE_Start(uint32_t BaseAddress)
+{
+  uint32_t sector;
+
+  /**
+   * The sectors programmed by a previous image shall be erased again
+   */
+  if(OTA_PIPE_Context.Stats.WrittenSize != 0)
+  {
+    sector = OTA_PIPE_SECTOR(OTA_PIPE_Context.BaseAddress);
+    OTA_PIPE_Context.EraseNext = MIN(OTA_PIPE_Context.EraseNext, MAX(sector, OTA_PIPE_Context.AreaFirstSector));
+  }
+
+  OTA_PIPE_Context.State = OTA_PIPE_RECEIVING;
+  OTA_PIPE_Context.BaseAddress = BaseAddress;
+  OTA_PIPE_Context.WriteAddress = BaseAddress;
+  OTA_PIPE_Context.Head = 0;
+  OTA_PIPE_Context.Tail = 0;
+  ResumeWrite();
+  memset(&OTA_PIPE_Context.Stats, 0, sizeof(OTA_PIPE_Context.Stats));
+  OTA_PIPE_Context.Stats.Crc = OTA_PIPE_CRC_INIT;
+  OTA_PIPE_Context.StartTick = OTA_PIPE_GetTick();
+  OTA_PIPE_Context.EndTick = OTA_PIPE_Context.StartTick;
+
+  /**
+   * Start erasing while waiting for the first chunk
+   */
+  OTA_PIPE_Notification(OTA_PIPE_PROCESS_REQ_EVT);
+
+  return;
+}
+
+OTA_PIPE_Status_t OTA_PIPE_Write(const uint8_t *pData, uint32_t Length)
+{
+  uint32_t offset;
+  uint32_t size;
+
+  if(OTA_PIPE_Context.State != OTA_PIPE_RECEIVING)
+  {
+    return OTA_PIPE_OK;
+  }
+
+  if(Length > (CFG_OTA_PIPE_BUFFER_SIZE - (OTA_PIPE_Context.Head - OTA_PIPE_Context.Tail)))
+  {
+    /**
+     * The buffer is full: the flash is not processed from the caller context, the chunk is given again
+     * after OTA_PIPE_READY_EVT
+     */
+    OTA_PIPE_Context.PendingLength = Length;
+    OTA_PIPE_Context.Stats.StallNbr++;
+    OTA_PIPE_Notification(OTA_PIPE_PROCESS_REQ_EVT);
+
+    return OTA_PIPE_BUSY;
+  }
+
+  if(OTA_PIPE_Context.Stats.ImageSize == 0)
+  {
+    OTA_PIPE_Context.StartTick = OTA_PIPE_GetTick();
+  }
+  OTA_PIPE_Context.Stats.ImageSize += Length;
+  OTA_PIPE_Context.Stats.Crc = Crc32(OTA_PIPE_Context.Stats.Crc, pData, Length);
+
+  while(Length != 0)
+  {
+    offset = OTA_PIPE_Context.Head % CFG_OTA_PIPE_BUFFER_SIZE;
+    size = MIN(Length, CFG_OTA_PIPE_BUFFER_SIZE - offset);
+    memcpy((uint8_t*)OTA_PIPE_Context.Buffer + offset, pData, size);
+    OTA_PIPE_Context.Head += size;
+    pData += size;
+    Length -= size;
+  }
+
+  OTA_PIPE_Context.Stats.BufferPeak = MAX(OTA_PIPE_Context.Stats.BufferPeak,
+                                          OTA_PIPE_Context.Head - OTA_PIPE_Context.Tail);
+
+  OTA_PIPE_Notification(OTA_PIPE_PROCESS_REQ_EVT);
+
+  return OTA_PIPE_OK;
+}
+
+void OTA_PIPE_Finish(void)
+{
+  uint32_t offset;
+
+  if(OTA_PIPE_Context.State != OTA_PIPE_RECEIVING)
+  {
+    return;
+  }
+
+  /**
+   * As it is mandatory to write 64bits data, the last one is padded with 0xFF.
+   * There is room for it as the buffer size and the number of bytes programmed are multiple of 8 bytes.
+   */
+  while((OTA_PIPE_Context.Head % OTA_PIPE_DOUBLEWORD_SIZE) != 0)
+  {
+    offset = OTA_PIPE_Context.Head % CFG_OTA_PIPE_BUFFER_SIZE;
+    ((uint8_t*)OTA_PIPE_Context.Buffer)[offset] = 0xFF;
+    OTA_PIPE_Context.Head++;
+  }
+
+  OTA_PIPE_Context.State = OTA_PIPE_FINISHING;
+  OTA_PIPE_Notification(OTA_PIPE_PROCESS_REQ_EVT);
+
+  return;
+}
+
+void OTA_PIPE_Cancel(void)
+{
+  OTA_PIPE_Context.State = OTA_PIPE_IDLE;
+  OTA_PIPE_Context.Head = OTA_PIPE_Context.Tail;
+  ResumeWrite();
+
+  return;
+}
+
+void OTA_PIPE_Process(void)
+{
+  if(ProcessStep() != FALSE)
+  {
+    OTA_PIPE_Notification(OTA_PIPE_PROCESS_REQ_EVT);
+  }
+
+  return;
+}
+
+void OTA_PIPE_GetStats(OTA_PIPE_Stats_t *pStats)
+{
+  uint32_t elapsed;
+
+  *pStats = OTA_PIPE_Context.Stats;
+
+  if((OTA_PIPE_Context.State == OTA_PIPE_RECEIVING) || (OTA_PIPE_Context.State == OTA_PIPE_FINISHING) ||
+     (OTA_PIPE_Context.State == OTA_PIPE_VERIFYING))
+  {
+    elapsed = OTA_PIPE_GetTick() - OTA_PIPE_Context.StartTick;
+  }
+  else
+  {
+    elapsed = OTA_PIPE_Context.EndTick - OTA_PIPE_Context.StartTick;
+  }
+  pStats->Throughput = (elapsed != 0) ? (uint32_t)(((uint64_t)pStats->ImageSize * 1000) / elapsed) : 0;
+
+  return;
+}
+
+/*************************************************************
+ *
+ * LOCAL FUNCTIONS
+ *
+ *************************************************************/
+static uint32_t Crc32(uint32_t Crc, const uint8_t *pData, uint32_t Length)
+{
+  while(Length-- != 0)
+  {
+    Crc ^= *pData++;
+    Crc = (Crc >> 4) ^ OTA_PIPE_CrcTable[Crc & 0x0F];
+    Crc = (Crc >> 4) ^ OTA_PIPE_CrcTable[Crc & 0x0F];
+  }
+
+  return Crc;
+}
+
+/**
+ * @brief  Executes one flash operation
+ * @param  None
+ * @retval TRUE when there is more to do
+ */
+static uint8_t ProcessStep(void)
+{
+  uint32_t nbr_of_data;
+  uint32_t sector;
+  uint32_t erase_end;
+  uint32_t size;
+
+  switch(OTA_PIPE_Context.State)
+  {
+    case OTA_PIPE_RECEIVING:
+    case OTA_PIPE_FINISHING:
+      nbr_of_data = (OTA_PIPE_Context.Head - OTA_PIPE_Context.Tail) / OTA_PIPE_DOUBLEWORD_SIZE;
+      sector = OTA_PIPE_SECTOR(OTA_PIPE_Context.WriteAddress);
+
+      if(nbr_of_data != 0)
+      {
+        if((sector >= OTA_PIPE_Context.EraseNext) && (sector < OTA_PIPE_Context.AreaEndSector))
+        {
+          /**
+           * The sector under the write cursor is not erased yet
+           */
+          EraseNextSector();
+        }
+        else
+        {
+          /**
+           * Do not go past the end of the buffer nor past the end of the sector
+           */
+          nbr_of_data = MIN(nbr_of_data, CFG_OTA_PIPE_WRITE_BURST);
+          nbr_of_data = MIN(nbr_of_data, (CFG_OTA_PIPE_BUFFER_SIZE - (OTA_PIPE_Context.Tail % CFG_OTA_PIPE_BUFFER_SIZE))
+                                         / OTA_PIPE_DOUBLEWORD_SIZE);
+          nbr_of_data = MIN(nbr_of_data, (FLASH_PAGE_SIZE - (OTA_PIPE_Context.WriteAddress % FLASH_PAGE_SIZE))
+                                         / OTA_PIPE_DOUBLEWORD_SIZE);
+          ProgramBuffer(nbr_of_data);
+        }
+        return TRUE;
+      }
+
+      if(OTA_PIPE_Context.State == OTA_PIPE_FINISHING)
+      {
+        erase_end = OTA_PIPE_Context.AreaEndSector;
+      }
+      else
+      {
+        erase_end = MIN(OTA_PIPE_Context.AreaEndSector, sector + 1 + CFG_OTA_PIPE_ERASE_AHEAD);
+      }
+      if(OTA_PIPE_Context.EraseNext < erase_end)
+      {
+        EraseNextSector();
+        return TRUE;
+      }
+
+      if(OTA_PIPE_Context.State == OTA_PIPE_FINISHING)
+      {
+        OTA_PIPE_Context.State = OTA_PIPE_VERIFYING;
+        OTA_PIPE_Context.VerifyOffset = 0;
+        OTA_PIPE_Context.VerifyCrc = OTA_PIPE_CRC_INIT;
+        return TRUE;
+      }
+      break;
+
+    case OTA_PIPE_VERIFYING:
+      size = MIN(OTA_PIPE_Context.Stats.ImageSize - OTA_PIPE_Context.VerifyOffset, CFG_OTA_PIPE_VERIFY_BURST);
+      OTA_PIPE_Context.VerifyCrc = Crc32(OTA_PIPE_Context.VerifyCrc,
+                                         (const uint8_t*)(uintptr_t)(OTA_PIPE_Context.BaseAddress +
+                                                                     OTA_PIPE_Context.VerifyOffset),
+                                         size);
+      OTA_PIPE_Context.VerifyOffset += size;
+      if(OTA_PIPE_Context.VerifyOffset < OTA_PIPE_Context.Stats.ImageSize)
+      {
+        return TRUE;
+      }
+
+      OTA_PIPE_Context.State = OTA_PIPE_IDLE;
+      OTA_PIPE_Context.EndTick = OTA_PIPE_GetTick();
+      if(OTA_PIPE_Context.VerifyCrc == OTA_PIPE_Context.Stats.Crc)
+      {
+        OTA_PIPE_Notification(OTA_PIPE_COMPLETE_EVT);
+      }
+      else
+      {
+        OTA_PIPE_Notification(OTA_PIPE_ERROR_EVT);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return FALSE;
+}
+
+static void EraseNextSector(void)
+{
+  /**
+   * When the sector is not erased due to the timing protection, FD_EraseSectors() keeps the ownership of the flash
+   * and it is called again on the next step to finish the process
+   */
+  if(FD_EraseSectors(OTA_PIPE_Context.EraseNext, 1) == 0)
+  {
+    OTA_PIPE_Context.EraseNext++;
+    OTA_PIPE_Context.Stats.ErasedSectorNbr++;
+  }
+  else
+  {
+    OTA_PIPE_Context.Stats.DeferredNbr++;
+  }
+
+  return;
+}
+
+static void ProgramBuffer(uint32_t NbrOfData)
+{
+  uint32_t nbr_not_written;
+  uint32_t size;
+
+  nbr_not_written = FD_WriteData(OTA_PIPE_Context.WriteAddress,
+                                 &OTA_PIPE_Context.Buffer[(OTA_PIPE_Context.Tail % CFG_OTA_PIPE_BUFFER_SIZE) / OTA_PIPE_DOUBLEWORD_SIZE],
+                                 NbrOfData);
+  if(nbr_not_written != 0)
+  {
+    OTA_PIPE_Context.Stats.DeferredNbr++;
+  }
+
+  size = (NbrOfData - nbr_not_written) * OTA_PIPE_DOUBLEWORD_SIZE;
+  OTA_PIPE_Context.WriteAddress += size;
+  OTA_PIPE_Context.Tail += size;
+  OTA_PIPE_Context.Stats.WrittenSize += size;
+
+  if((OTA_PIPE_Context.PendingLength != 0) &&
+     (OTA_PIPE_Context.PendingLength <= (CFG_OTA_PIPE_BUFFER_SIZE - (OTA_PIPE_Context.Head - OTA_PIPE_Context.Tail))))
+  {
+    ResumeWrite();
+  }
+
+  return;
+}
+
+static void ResumeWrite(void)
+{
+  if(OTA_PIPE_Context.PendingLength != 0)
+  {
+    OTA_PIPE_Context.PendingLength = 0;
+    OTA_PIPE_Notification(OTA_PIPE_READY_EVT);
+  }
+
+  return;
+}
+
+/*************************************************************
+ *
+ * WEAK FUNCTIONS
+ *
+ *************************************************************/
+__WEAK uint32_t OTA_PIPE_GetTick(void)
+{
+  return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ ******************************************************************************
+ * @file    app_common.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the application common header for the Linux host build
+ *          of the OTA pipeline
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Only the definitions used by ota_pipeline.c are provided. The flash
+ * geometry is the one of the STM32WB55xx. This directory shall be in the
+ * include path before Core/Inc.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __APP_COMMON_H
+#define __APP_COMMON_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#undef FALSE
+#define FALSE                   0
+
+#undef TRUE
+#define TRUE                    (!0)
+
+#ifndef MAX
+#define MAX( x, y )          (((x)>(y))?(x):(y))
+#endif
+
+#ifndef MIN
+#define MIN( x, y )          (((x)<(y))?(x):(y))
+#endif
+
+#define __WEAK               __attribute__((weak))
+
+#define FLASH_BASE           (0x08000000UL)
+#define FLASH_SIZE           (0x00100000UL)
+#define FLASH_PAGE_SIZE      (0x00001000U)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__APP_COMMON_H */
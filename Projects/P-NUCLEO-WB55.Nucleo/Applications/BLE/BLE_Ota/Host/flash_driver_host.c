@@ -0,0 +1,234 @@
+/**
+ ******************************************************************************
+ * @file    flash_driver_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host simulator of the dual core flash driver
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <sys/mman.h>
+
+#include "app_common.h"
+
+#include "flash_driver.h"
+#include "flash_driver_host.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  FLASH_ERASE,
+  FLASH_WRITE,
+}FlashOperationType_t;
+
+typedef struct
+{
+  uint64_t Time;                /**< Simulated time (us) */
+  uint32_t EraseTime;
+  uint32_t ProgramTime;
+  uint32_t RadioInterval;       /**< 0 when there is no radio activity */
+  uint32_t RadioActive;
+  FLASH_HOST_Stats_t Stats;
+} FLASH_HOST_Context_t;
+
+/* Private variables ---------------------------------------------------------*/
+static FLASH_HOST_Context_t FLASH_HOST_Context;
+
+/* Private function prototypes -----------------------------------------------*/
+static SingleFlashOperationStatus_t ProcessSingleFlashOperation(FlashOperationType_t FlashOperationType,
+                                                                uint32_t SectorNumberOrDestAddress,
+                                                                uint64_t Data);
+
+/* Public functions ----------------------------------------------------------*/
+int FLASH_HOST_Init( void )
+{
+  void *p_flash;
+
+  p_flash = mmap((void*)FLASH_BASE, FLASH_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+  if(p_flash != (void*)FLASH_BASE)
+  {
+    return -1;
+  }
+  memset(p_flash, 0xFF, FLASH_SIZE);
+
+  memset(&FLASH_HOST_Context, 0, sizeof(FLASH_HOST_Context));
+  FLASH_HOST_Context.EraseTime = FLASH_HOST_ERASE_TIME;
+  FLASH_HOST_Context.ProgramTime = FLASH_HOST_PROGRAM_TIME;
+
+  return 0;
+}
+
+void FLASH_HOST_SetTiming( uint32_t EraseTime, uint32_t ProgramTime )
+{
+  FLASH_HOST_Context.EraseTime = EraseTime;
+  FLASH_HOST_Context.ProgramTime = ProgramTime;
+
+  return;
+}
+
+void FLASH_HOST_SetRadio( uint32_t Interval, uint32_t Active )
+{
+  FLASH_HOST_Context.RadioInterval = Interval;
+  FLASH_HOST_Context.RadioActive = Active;
+
+  return;
+}
+
+uint64_t FLASH_HOST_GetTime( void )
+{
+  return FLASH_HOST_Context.Time;
+}
+
+void FLASH_HOST_Advance( uint64_t Time )
+{
+  FLASH_HOST_Context.Time += Time;
+
+  return;
+}
+
+void FLASH_HOST_GetStats( FLASH_HOST_Stats_t *p_Stats )
+{
+  *p_Stats = FLASH_HOST_Context.Stats;
+
+  return;
+}
+
+/**
+ * The dual core algorithm of flash_driver.c, without the semaphores and the
+ * CPU2 notification
+ */
+uint32_t FD_EraseSectors(uint32_t FirstSector, uint32_t NbrOfSectors)
+{
+  uint32_t loop_flash;
+  uint32_t return_value;
+  SingleFlashOperationStatus_t single_flash_operation_status;
+
+  single_flash_operation_status = SINGLE_FLASH_OPERATION_DONE;
+
+  for(loop_flash = 0; (loop_flash < NbrOfSectors) && (single_flash_operation_status ==  SINGLE_FLASH_OPERATION_DONE) ; loop_flash++)
+  {
+    single_flash_operation_status = FD_EraseSingleSector(FirstSector+loop_flash);
+  }
+
+  if(single_flash_operation_status != SINGLE_FLASH_OPERATION_DONE)
+  {
+    return_value = NbrOfSectors - loop_flash + 1;
+  }
+  else
+  {
+    return_value = 0;
+  }
+
+  return return_value;
+}
+
+uint32_t FD_WriteData(uint32_t DestAddress, uint64_t * pSrcBuffer, uint32_t NbrOfData)
+{
+  uint32_t loop_flash;
+  uint32_t return_value;
+  SingleFlashOperationStatus_t single_flash_operation_status;
+
+  single_flash_operation_status = SINGLE_FLASH_OPERATION_DONE;
+
+  for(loop_flash = 0; (loop_flash < NbrOfData) && (single_flash_operation_status ==  SINGLE_FLASH_OPERATION_DONE) ; loop_flash++)
+  {
+    single_flash_operation_status = FD_WriteSingleData(DestAddress+(8*loop_flash), *(pSrcBuffer+loop_flash));
+  }
+
+  if(single_flash_operation_status != SINGLE_FLASH_OPERATION_DONE)
+  {
+    return_value = NbrOfData - loop_flash + 1;
+  }
+  else
+  {
+    return_value = 0;
+  }
+
+  return return_value;
+}
+
+SingleFlashOperationStatus_t FD_EraseSingleSector(uint32_t SectorNumber)
+{
+  return ProcessSingleFlashOperation(FLASH_ERASE, SectorNumber, 0);
+}
+
+SingleFlashOperationStatus_t FD_WriteSingleData(uint32_t DestAddress, uint64_t Data)
+{
+  return ProcessSingleFlashOperation(FLASH_WRITE, DestAddress, Data);
+}
+
+/*************************************************************
+ *
+ * LOCAL FUNCTIONS
+ *
+ *************************************************************/
+static SingleFlashOperationStatus_t ProcessSingleFlashOperation(FlashOperationType_t FlashOperationType,
+                                                                uint32_t SectorNumberOrDestAddress,
+                                                                uint64_t Data)
+{
+  WaitedSemStatus_t waited_sem_status;
+  uint64_t *p_dest;
+  uint32_t duration;
+
+  while((FLASH_HOST_Context.RadioInterval != 0) &&
+        ((FLASH_HOST_Context.Time % FLASH_HOST_Context.RadioInterval) < FLASH_HOST_Context.RadioActive))
+  {
+    /**
+     * The CPU2 protects the timing of the radio event
+     */
+    FLASH_HOST_Context.Stats.RefusedNbr++;
+    FLASH_HOST_Context.Time += FLASH_HOST_RETRY_TIME;
+    waited_sem_status = FD_WaitForSemAvailable(WAIT_FOR_SEM_BLOCK_FLASH_REQ_BY_CPU2);
+    if(waited_sem_status == WAITED_SEM_BUSY)
+    {
+      return SINGLE_FLASH_OPERATION_NOT_EXECUTED;
+    }
+  }
+
+  if(FlashOperationType == FLASH_ERASE)
+  {
+    memset((void*)(FLASH_BASE + (SectorNumberOrDestAddress * FLASH_PAGE_SIZE)), 0xFF, FLASH_PAGE_SIZE);
+    FLASH_HOST_Context.Stats.EraseNbr++;
+    duration = FLASH_HOST_Context.EraseTime;
+  }
+  else
+  {
+    p_dest = (uint64_t*)(uintptr_t)SectorNumberOrDestAddress;
+    if((*p_dest == UINT64_MAX) || (Data == 0))
+    {
+      *p_dest = Data;
+    }
+    else
+    {
+      FLASH_HOST_Context.Stats.ProgramErrorNbr++;
+    }
+    FLASH_HOST_Context.Stats.ProgramNbr++;
+    duration = FLASH_HOST_Context.ProgramTime;
+  }
+
+  FLASH_HOST_Context.Time += duration;
+  FLASH_HOST_Context.Stats.BusyTime += duration;
+
+  return SINGLE_FLASH_OPERATION_DONE;
+}
+
+/*************************************************************
+ *
+ * WEAK FUNCTIONS
+ *
+ *************************************************************/
+__WEAK WaitedSemStatus_t FD_WaitForSemAvailable(WaitedSemId_t WaitedSemId)
+{
+  return WAITED_SEM_BUSY;
+}
@@ -0,0 +1,71 @@
+/**
+ ******************************************************************************
+ * @file    flash_driver_host.h
+ * @author  MCD Application Team
+ * @brief   Header for flash_driver_host.c
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Linux host simulator of the flash seen through the dual core flash driver
+ * (flash_driver.h):
+ *  - the flash is mapped at FLASH_BASE so that it is read with the same
+ *    addresses as on target
+ *  - a sector erase and a 64bits programming advance a simulated time by the
+ *    typical STM32WB55xx durations (22.02ms and 81.69us). The CPU1 is stalled
+ *    during that time, as it executes from flash on target
+ *  - a 64bits data can be programmed only over an erased one (or with 0),
+ *    otherwise the programming fails and is counted
+ *  - the CPU2 timing protection is modeled by periodic radio events: a flash
+ *    operation requested during a radio event is not executed
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __FLASH_DRIVER_HOST_H
+#define __FLASH_DRIVER_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t EraseNbr;            /**< Number of sectors erased */
+  uint32_t ProgramNbr;          /**< Number of 64bits data programmed */
+  uint32_t ProgramErrorNbr;     /**< Number of 64bits data programmed over data not erased */
+  uint32_t RefusedNbr;          /**< Number of operations not executed due to a radio event */
+  uint64_t BusyTime;            /**< Time spent in flash operations (us) */
+} FLASH_HOST_Stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+#define FLASH_HOST_ERASE_TIME           (22020)     /**< Sector erase time (us) */
+#define FLASH_HOST_PROGRAM_TIME         (82)        /**< 64bits programming time (us) */
+#define FLASH_HOST_RETRY_TIME           (10)        /**< Time spent on an operation not executed (us) */
+
+/* Exported functions ------------------------------------------------------- */
+int FLASH_HOST_Init( void );
+void FLASH_HOST_SetTiming( uint32_t EraseTime, uint32_t ProgramTime );
+void FLASH_HOST_SetRadio( uint32_t Interval, uint32_t Active );
+uint64_t FLASH_HOST_GetTime( void );
+void FLASH_HOST_Advance( uint64_t Time );
+void FLASH_HOST_GetStats( FLASH_HOST_Stats_t *p_Stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__FLASH_DRIVER_HOST_H */
@@ -0,0 +1,267 @@
+/**
+ ******************************************************************************
+ * @file    ota_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host run of the OTA pipeline over the simulated flash
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * An image is sent over a simulated BLE link: the peer writes one raw data
+ * chunk every chunk period. The CPU2 holds up to a number of chunks not yet
+ * processed by the CPU1; when they are all in use, the peer is stalled. The
+ * CPU1 runs a sequencer loop: the received chunks first, then the pipeline
+ * background task. A chunk refused with OTA_PIPE_BUSY stays in the CPU2 and
+ * the received chunks are held until OTA_PIPE_READY_EVT resumes the flow. All
+ * times are simulated, the CPU1 being stalled during the flash operations.
+ *
+ * With -s, the flash is processed synchronously on each chunk, as the OTA
+ * application did before the pipeline.
+ *
+ * Usage: ota_host [-n image size] [-c chunk size] [-p chunk period us]
+ *                 [-q CPU2 queue depth] [-i radio interval us]
+ *                 [-a radio active us] [-s]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <unistd.h>
+
+#include "app_common.h"
+
+#include "flash_driver_host.h"
+#include "ota_pipeline.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define OTA_HOST_FIRST_SECTOR           (7)
+#define OTA_HOST_SPARE_SECTORS          (8)
+#define OTA_HOST_EVT_TIME               (30)    /**< CPU1 time to process a received chunk (us) */
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t ProcessReq;
+static uint8_t FlowEnabled = TRUE;
+static int Result = -1;
+
+/* Functions Definition ------------------------------------------------------*/
+void OTA_PIPE_Notification(OTA_PIPE_Evt_t Evt)
+{
+  switch(Evt)
+  {
+    case OTA_PIPE_PROCESS_REQ_EVT:
+      ProcessReq = TRUE;
+      break;
+
+    case OTA_PIPE_COMPLETE_EVT:
+      Result = 0;
+      break;
+
+    case OTA_PIPE_ERROR_EVT:
+      Result = 1;
+      break;
+
+    case OTA_PIPE_READY_EVT:
+      FlowEnabled = TRUE;
+      break;
+
+    default:
+      break;
+  }
+
+  return;
+}
+
+uint32_t OTA_PIPE_GetTick(void)
+{
+  return (uint32_t)(FLASH_HOST_GetTime() / 1000);
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t image_size = 256 * 1024;
+  uint32_t chunk_size = 244;
+  uint32_t chunk_period = 4000;
+  uint32_t queue_depth = 6;
+  uint32_t radio_interval = 7500;
+  uint32_t radio_active = 1250;
+  int sync = 0;
+  int opt;
+  uint8_t *p_image;
+  uint32_t area_size;
+  uint32_t sent, processed, queued, queue_peak, busy, length, i;
+  uint64_t next_arrival, now, stall_time, end_of_link;
+  OTA_PIPE_Stats_t stats;
+  FLASH_HOST_Stats_t flash_stats;
+
+  while((opt = getopt(argc, argv, "n:c:p:q:i:a:s")) != -1)
+  {
+    switch(opt)
+    {
+      case 'n': image_size = strtoul(optarg, NULL, 0); break;
+      case 'c': chunk_size = strtoul(optarg, NULL, 0); break;
+      case 'p': chunk_period = strtoul(optarg, NULL, 0); break;
+      case 'q': queue_depth = strtoul(optarg, NULL, 0); break;
+      case 'i': radio_interval = strtoul(optarg, NULL, 0); break;
+      case 'a': radio_active = strtoul(optarg, NULL, 0); break;
+      case 's': sync = 1; break;
+      default:
+        fprintf(stderr, "usage: %s [-n size] [-c chunk] [-p period] [-q depth] [-i interval] [-a active] [-s]\n", argv[0]);
+        return 2;
+    }
+  }
+
+  if((chunk_size == 0) || (queue_depth == 0) ||
+     ((image_size + (OTA_HOST_FIRST_SECTOR + OTA_HOST_SPARE_SECTORS) * FLASH_PAGE_SIZE) > FLASH_SIZE))
+  {
+    fprintf(stderr, "invalid parameters\n");
+    return 2;
+  }
+
+  if(FLASH_HOST_Init() != 0)
+  {
+    fprintf(stderr, "the simulated flash cannot be mapped at 0x%08lX\n", FLASH_BASE);
+    return 2;
+  }
+  FLASH_HOST_SetRadio(radio_interval, radio_active);
+
+  /**
+   * The area holds a previous image
+   */
+  area_size = ((image_size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE) + OTA_HOST_SPARE_SECTORS;
+  memset((void*)(FLASH_BASE + OTA_HOST_FIRST_SECTOR * FLASH_PAGE_SIZE), 0x5A, area_size * FLASH_PAGE_SIZE);
+
+  p_image = malloc(image_size);
+  for(i = 0; i < image_size; i++)
+  {
+    p_image[i] = (uint8_t)((i * 2654435761U) >> 24);
+  }
+
+  OTA_PIPE_Init(OTA_HOST_FIRST_SECTOR, area_size);
+  OTA_PIPE_Start(FLASH_BASE + OTA_HOST_FIRST_SECTOR * FLASH_PAGE_SIZE);
+
+  sent = 0;
+  processed = 0;
+  queued = 0;
+  queue_peak = 0;
+  busy = 0;
+  stall_time = 0;
+  end_of_link = 0;
+  next_arrival = FLASH_HOST_GetTime() + chunk_period;
+
+  while(Result < 0)
+  {
+    now = FLASH_HOST_GetTime();
+
+    /**
+     * Link: the peer sends its chunks on time unless the CPU2 has no room left
+     */
+    while((sent * chunk_size < image_size) && (next_arrival <= now) && (queued < queue_depth))
+    {
+      sent++;
+      queued++;
+      queue_peak = MAX(queue_peak, queued);
+      next_arrival += chunk_period;
+      if((sent * chunk_size >= image_size))
+      {
+        end_of_link = now;
+      }
+    }
+
+    if((queued == queue_depth) && (next_arrival <= now))
+    {
+      /**
+       * The peer was stalled since the chunk was due
+       */
+      stall_time += now - next_arrival;
+      next_arrival = now;
+    }
+
+    /**
+     * CPU1 sequencer
+     */
+    if((queued != 0) && (FlowEnabled != FALSE))
+    {
+      length = MIN(chunk_size, image_size - processed * chunk_size);
+      FLASH_HOST_Advance(OTA_HOST_EVT_TIME);
+      if(OTA_PIPE_Write(&p_image[processed * chunk_size], length) == OTA_PIPE_BUSY)
+      {
+        /**
+         * The chunk is kept by the CPU2 and given again once the flow is resumed
+         */
+        FlowEnabled = FALSE;
+        busy++;
+        continue;
+      }
+      processed++;
+      queued--;
+      if(processed * chunk_size >= image_size)
+      {
+        OTA_PIPE_Finish();
+      }
+      if(sync != 0)
+      {
+        while(ProcessReq != FALSE)
+        {
+          ProcessReq = FALSE;
+          OTA_PIPE_Process();
+        }
+      }
+    }
+    else if(ProcessReq != FALSE)
+    {
+      ProcessReq = FALSE;
+      OTA_PIPE_Process();
+    }
+    else if(FlowEnabled == FALSE)
+    {
+      fprintf(stderr, "the flow is not resumed after a busy chunk\n");
+      return 1;
+    }
+    else if(sent * chunk_size < image_size)
+    {
+      /**
+       * Idle until the next chunk
+       */
+      FLASH_HOST_Advance(next_arrival - now);
+    }
+    else
+    {
+      fprintf(stderr, "the pipeline is idle before the end of the image\n");
+      return 1;
+    }
+  }
+
+  OTA_PIPE_GetStats(&stats);
+  FLASH_HOST_GetStats(&flash_stats);
+
+  printf("image %u bytes in %u chunks of %u bytes every %u us, radio %u/%u us, %s\n",
+         image_size, processed, chunk_size, chunk_period, radio_active, radio_interval,
+         (sync != 0) ? "synchronous" : "pipelined");
+  printf("pipeline: written %u, erased %u sectors, deferred %u, stalls %u, buffer peak %u, throughput %u B/s\n",
+         stats.WrittenSize, stats.ErasedSectorNbr, stats.DeferredNbr, stats.StallNbr, stats.BufferPeak,
+         stats.Throughput);
+  printf("link: last chunk at %.1f ms (%.1f ms on schedule), peer stalled %.1f ms, CPU2 queue peak %u/%u, "
+         "%u busy\n",
+         end_of_link / 1000.0, ((uint64_t)processed * chunk_period) / 1000.0, stall_time / 1000.0,
+         queue_peak, queue_depth, busy);
+  printf("flash: %u erases, %u programs, %u errors, %u refused, busy %.1f ms, done at %.1f ms\n",
+         flash_stats.EraseNbr, flash_stats.ProgramNbr, flash_stats.ProgramErrorNbr, flash_stats.RefusedNbr,
+         flash_stats.BusyTime / 1000.0, FLASH_HOST_GetTime() / 1000.0);
+  printf("CRC 0x%08X %s\n", stats.Crc, (Result == 0) ? "verified" : "MISMATCH");
+
+  if((Result == 0) && (memcmp((void*)(FLASH_BASE + OTA_HOST_FIRST_SECTOR * FLASH_PAGE_SIZE), p_image, image_size) != 0))
+  {
+    Result = 1;
+  }
+  free(p_image);
+
+  return ((Result == 0) && (flash_stats.ProgramErrorNbr == 0)) ? 0 : 1;
+}
@@ -36,6 +36,7 @@
 #endif /* OTA_SBSFU */
 
 #include "flash_driver.h"
+#include "ota_pipeline.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private defines -----------------------------------------------------------*/
@@ -143,6 +144,11 @@ void APP_BLE_Init( void )
    */
   UTIL_SEQ_RegTask( 1<<CFG_TASK_HCI_ASYNCH_EVT_ID, UTIL_SEQ_RFU, hci_user_evt_proc);
 
+  /**
+   * Register the OTA pipeline background task writing the image in flash
+   */
+  UTIL_SEQ_RegTask( 1<<CFG_TASK_OTA_PIPE_ID, UTIL_SEQ_RFU, OTA_PIPE_Process);
+
   /**
    * Starts the BLE Stack on CPU2
    */
@@ -420,6 +426,11 @@ static void Delete_Sectors( void )
   
   FD_EraseSectors((SLOT_DWL_1_START&0x00FFF000)>>12, 
                   NbrOfSectorToBeErased);
+
+  /**
+   * The slots are erased, the OTA pipeline has no sector to erase
+   */
+  OTA_PIPE_Init(0, 0);
   return;
 #else
   /**
@@ -450,8 +461,12 @@ static void Delete_Sectors( void )
     NbrOfSectorToBeErased = first_secure_sector_idx - CFG_OTA_START_SECTOR_IDX_VAL_MSG;
   }
 
-  FD_EraseSectors(CFG_OTA_START_SECTOR_IDX_VAL_MSG, 
-                  NbrOfSectorToBeErased);
+  /**
+   * The sectors are not erased here: the OTA pipeline erases them in the background, just ahead of the image being
+   * written, so that the erase time is spread over the transfer. The ones left are erased once the image is received.
+   */
+  OTA_PIPE_Init(CFG_OTA_START_SECTOR_IDX_VAL_MSG, 
+                NbrOfSectorToBeErased);
   return;
 #endif /* OTA_SBSFU */
 }
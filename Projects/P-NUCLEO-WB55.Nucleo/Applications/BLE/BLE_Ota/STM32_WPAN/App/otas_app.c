@@ -21,14 +21,16 @@
 /* Includes ------------------------------------------------------------------*/
 #include "app_common.h"
 
+#include "dbg_trace.h"
 #include "ble.h"
 #include "shci.h"
+#include "stm32_seq.h"
 
 #ifdef OTA_SBSFU
 #include "ota_sbsfu.h"
 #endif /* OTA_SBSFU */
 
-#include "flash_driver.h"
+#include "ota_pipeline.h"
 
 /* Private typedef -----------------------------------------------------------*/
 typedef enum
@@ -40,28 +42,71 @@ typedef enum
 typedef struct
 {
   uint32_t base_address;
-  uint64_t write_value;
-  uint8_t  write_value_index;
   uint8_t  file_type;
 } OTAS_APP_Context_t;
 
 /* Private macros ------------------------------------------------------------*/
-/* Number of bytes to be written in flash on each programming sequence */
-#define DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING       (8)
-
 /* Private variables ---------------------------------------------------------*/
 OTAS_APP_Context_t OTAS_APP_Context;
 
 /* Global variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static void OTAS_APP_Reboot( void );
+
 /* Functions Definition ------------------------------------------------------*/
 /* Private functions ----------------------------------------------------------*/
+static void OTAS_APP_Reboot( void )
+{
+  /**
+   * Decide now what to do after all the data has been written in Flash
+   */
+  switch(OTAS_APP_Context.file_type)
+  {
+    case Fw_App:
+      /**
+       * Reboot on FW Application
+       */
+      CFG_OTA_REBOOT_VAL_MSG = CFG_REBOOT_ON_FW_APP;
+ 
+#ifdef OTA_SBSFU
+      /* Communication with SBSFU : FW application installation by SBSFU requested */
+      STANDALONE_LOADER_STATE = STANDALONE_LOADER_INSTALL_REQ;
+#endif /* OTA_SBSFU */
+
+      NVIC_SystemReset(); /* it waits until reset */
+      break;
+
+    case Wireless_Fw:
+#ifdef OTA_SBSFU
+      /* Communication with SBSFU : by-pass mode requested for Wireless stack installation by FUS */
+      STANDALONE_LOADER_STATE = STANDALONE_LOADER_BYPASS_REQ;
+      
+      NVIC_SystemReset(); /* it waits until reset */
+#else
+      /**
+       * Wireless firmware update is requested
+       * Request CPU2 to reboot on FUS by sending two FUS command
+       */
+      SHCI_C2_FUS_GetState( NULL );
+      SHCI_C2_FUS_GetState( NULL );
+      while(1)
+      {
+        HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+      }
+#endif /* OTA_SBSFU */
+      break;
+
+    default:
+      break;
+  }
+
+  return;
+}
+
 /* Public functions ----------------------------------------------------------*/
 
 void OTAS_STM_Notification( OTA_STM_Notification_t *p_notification )
 {
-  uint32_t count;
-  uint32_t size_left;
   OTAS_STM_Indication_Msg_t msg_conf;
 
   switch(p_notification->ChardId)
@@ -71,6 +116,7 @@ void OTAS_STM_Notification( OTA_STM_Notification_t *p_notification )
       switch( ((OTA_STM_Base_Addr_Event_Format_t*)(p_notification->pPayload))->Command )
       {
         case OTAS_STM_STOP_ALL_UPLOAD:
+          OTA_PIPE_Cancel();
           break;
 
         case OTAS_STM_WIRELESS_FW_UPLOAD:
@@ -79,7 +125,7 @@ void OTAS_STM_Notification( OTA_STM_Notification_t *p_notification )
           ((uint8_t*)&OTAS_APP_Context.base_address)[0] = (((uint8_t*)((OTA_STM_Base_Addr_Event_Format_t*)(p_notification->pPayload))->Base_Addr))[2];
           ((uint8_t*)&OTAS_APP_Context.base_address)[1] = (((uint8_t*)((OTA_STM_Base_Addr_Event_Format_t*)(p_notification->pPayload))->Base_Addr))[1];
           ((uint8_t*)&OTAS_APP_Context.base_address)[2] = (((uint8_t*)((OTA_STM_Base_Addr_Event_Format_t*)(p_notification->pPayload))->Base_Addr))[0];
-          OTAS_APP_Context.write_value_index = 0;
+          OTA_PIPE_Start(OTAS_APP_Context.base_address);
           break;
 
         case OTAS_STM_APPLICATION_UPLOAD:
@@ -88,7 +134,7 @@ void OTAS_STM_Notification( OTA_STM_Notification_t *p_notification )
           ((uint8_t*)&OTAS_APP_Context.base_address)[0] = (((uint8_t*)((OTA_STM_Base_Addr_Event_Format_t*)(p_notification->pPayload))->Base_Addr))[2];
           ((uint8_t*)&OTAS_APP_Context.base_address)[1] = (((uint8_t*)((OTA_STM_Base_Addr_Event_Format_t*)(p_notification->pPayload))->Base_Addr))[1];
           ((uint8_t*)&OTAS_APP_Context.base_address)[2] = (((uint8_t*)((OTA_STM_Base_Addr_Event_Format_t*)(p_notification->pPayload))->Base_Addr))[0];
-          OTAS_APP_Context.write_value_index = 0;
+          OTA_PIPE_Start(OTAS_APP_Context.base_address);
           break;
 
         case OTAS_STM_UPLOAD_FINISHED:
@@ -97,6 +143,7 @@ void OTAS_STM_Notification( OTA_STM_Notification_t *p_notification )
           break;
 
         case OTAS_STM_CANCEL_UPLOAD:
+          OTA_PIPE_Cancel();
           break;
 
         default:
@@ -107,46 +154,16 @@ void OTAS_STM_Notification( OTA_STM_Notification_t *p_notification )
 
     case OTAS_STM_RAW_DATA_ID:
       /**
-       * Write in Flash the data received in the BLE packet
-       */
-      count = 0;
-      size_left = p_notification->ValueLength;
-
-      /**
-       * The flash is written by bunch of DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING bytes
-       * Data are written in flash as long as there are at least DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING bytes
-       */
-      while( size_left >= (DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING - OTAS_APP_Context.write_value_index) )
-      {
-        uint32_t NbrOfDataToBeWritten = 1;
-        
-        memcpy( (uint8_t*)&OTAS_APP_Context.write_value + OTAS_APP_Context.write_value_index,
-                ((OTA_STM_Raw_Data_Event_Format_t*)(p_notification->pPayload))->Raw_Data + count,
-                DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING - OTAS_APP_Context.write_value_index );
-        while(NbrOfDataToBeWritten > 0)
-          NbrOfDataToBeWritten = FD_WriteData(OTAS_APP_Context.base_address,
-                                              &(OTAS_APP_Context.write_value),
-                                              1);
-        if(*(uint64_t*)(OTAS_APP_Context.base_address)==OTAS_APP_Context.write_value)
-        {
-          OTAS_APP_Context.base_address += DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING;
-          size_left -= (DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING - OTAS_APP_Context.write_value_index);
-          count += (DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING - OTAS_APP_Context.write_value_index);
-          OTAS_APP_Context.write_value_index = 0;
-        }
-      }
-
-      /**
-       * The Flash shall be written by DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING number of bytes.
-       * In case the packet received is not a multiple of DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING bytes,
-       * It shall be recorded how much bytes is left to be written in flash
+       * The data received in the BLE packet are written in Flash in the background
        */
-      if(size_left != 0)
+      if(OTA_PIPE_Write(((OTA_STM_Raw_Data_Event_Format_t*)(p_notification->pPayload))->Raw_Data,
+                        p_notification->ValueLength) == OTA_PIPE_BUSY)
       {
-        memcpy( (uint8_t*)&OTAS_APP_Context.write_value + OTAS_APP_Context.write_value_index,
-                ((OTA_STM_Raw_Data_Event_Format_t*)(p_notification->pPayload))->Raw_Data + count,
-                size_left );
-        OTAS_APP_Context.write_value_index += size_left;
+        /**
+         * The pipeline buffer is full: the event is held by the BLE transport layer and reported again once
+         * OTA_PIPE_READY_EVT resumes the flow
+         */
+        p_notification->Busy = TRUE;
       }
       break;
 
@@ -154,79 +171,47 @@ void OTAS_STM_Notification( OTA_STM_Notification_t *p_notification )
     {
       /**
        * The Remote notifies it has send all the data to be written in Flash
+       * The pipeline writes the data left, completes the erase of the area and checks the CRC of the image before
+       * reporting OTA_PIPE_COMPLETE_EVT
        */
+      OTA_PIPE_Finish();
+    }
+    break;
 
-      /**
-       * Write now in Flash the remaining data that has not been written before because they were less than
-       * DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING bytes to be written
-       */
-      if(OTAS_APP_Context.write_value_index != 0)
-      {
-        /**
-         * As it is mandatory to write DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING bytes, the data to be written shall be padded
-         * up to DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING bytes with 0xFF.
-         * This is mandatory for correct operation with the Firmware Upgrade Service (FUS) as otherwise, it could be the magic
-         * key word in wrongly duplicated
-         */
-        memset( (uint8_t*)&OTAS_APP_Context.write_value + OTAS_APP_Context.write_value_index,
-                0xFF,
-                DOUBLEWORD_SIZE_FOR_FLASH_PROGRAMMING - OTAS_APP_Context.write_value_index  );
-
-        while(*(uint64_t*)(OTAS_APP_Context.base_address) != OTAS_APP_Context.write_value)
-        {
-          uint32_t NbrOfDataToBeWritten = 1;
-
-          while(NbrOfDataToBeWritten > 0)
-            NbrOfDataToBeWritten = FD_WriteData(OTAS_APP_Context.base_address,
-                                                &(OTAS_APP_Context.write_value),
-                                                1);
-        }
-      }
+    default:
+      break;
+  }
 
-      /**
-       * Decide now what to do after all the data has been written in Flash
-       */
-      switch(OTAS_APP_Context.file_type)
-      {
-        case Fw_App:
-          /**
-           * Reboot on FW Application
-           */
-          CFG_OTA_REBOOT_VAL_MSG = CFG_REBOOT_ON_FW_APP;
- 
-#ifdef OTA_SBSFU
-          /* Communication with SBSFU : FW application installation by SBSFU requested */
-          STANDALONE_LOADER_STATE = STANDALONE_LOADER_INSTALL_REQ;
-#endif /* OTA_SBSFU */
+  return;
+}
 
-          NVIC_SystemReset(); /* it waits until reset */
-          break;
+void OTA_PIPE_Notification( OTA_PIPE_Evt_t Evt )
+{
+  OTA_PIPE_Stats_t stats;
 
-        case Wireless_Fw:
-#ifdef OTA_SBSFU
-          /* Communication with SBSFU : by-pass mode requested for Wireless stack installation by FUS */
-          STANDALONE_LOADER_STATE = STANDALONE_LOADER_BYPASS_REQ;
-          
-          NVIC_SystemReset(); /* it waits until reset */
-#else
-          /**
-           * Wireless firmware update is requested
-           * Request CPU2 to reboot on FUS by sending two FUS command
-           */
-          SHCI_C2_FUS_GetState( NULL );
-          SHCI_C2_FUS_GetState( NULL );
-          while(1)
-          {
-            HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
-          }
-#endif /* OTA_SBSFU */
-          break;
+  switch(Evt)
+  {
+    case OTA_PIPE_PROCESS_REQ_EVT:
+      UTIL_SEQ_SetTask(1 << CFG_TASK_OTA_PIPE_ID, CFG_SCH_PRIO_0);
+      break;
 
-        default:
-          break;
-      }
-    }
-    break;
+    case OTA_PIPE_COMPLETE_EVT:
+      OTA_PIPE_GetStats(&stats);
+      APP_DBG_MSG("OTA image of %ld bytes written at %ld bytes/s, %ld sectors erased, %ld operations deferred\n",
+                  stats.ImageSize, stats.Throughput, stats.ErasedSectorNbr, stats.DeferredNbr);
+      OTAS_APP_Reboot();
+      break;
+
+    case OTA_PIPE_ERROR_EVT:
+      /**
+       * The image in Flash is corrupted, it shall not be started. The Remote may upload it again.
+       */
+      APP_DBG_MSG("OTA image CRC mismatch\n");
+      break;
+
+    case OTA_PIPE_READY_EVT:
+      SVCCTL_ResumeUserEventFlow();
+      break;
 
     default:
       break;
@@ -234,3 +219,8 @@ void OTAS_STM_Notification( OTA_STM_Notification_t *p_notification )
 
   return;
 }
+
+uint32_t OTA_PIPE_GetTick( void )
+{
+  return HAL_GetTick();
+}
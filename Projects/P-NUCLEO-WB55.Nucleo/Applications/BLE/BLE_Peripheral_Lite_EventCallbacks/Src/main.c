@@ -63,8 +63,6 @@ detailed procedure to change the Wireless Coprocessor binary.
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 
-#define EVT_END_OF_RADIO_ACTIVITY           0x0004
-
 #define BD_ADDR_SIZE_LOCAL                  6
 #define APP_BLE_GAP_DEVICE_NAME_LENGTH      sizeof(gap_device_name)
 #define EVENT_POOL_SIZE                    (CFG_TLBLE_EVT_QUEUE_LENGTH*4U*DIVC(( sizeof(TL_PacketHeader_t) + TL_BLE_EVENT_FRAME_SIZE ), 4U))
@@ -904,97 +902,49 @@ static void BLE_UserEventReceivedCallback( void * pData )
   tHCI_UserEvtRxParam *pParam;
   hci_event_pckt *event_pckt;
   hci_uart_pckt *pUartPckt;
+  const hci_event_table_t *p_entry;
+  const uint8_t *p_param;
 
   pParam = (tHCI_UserEvtRxParam *)pData; 
 
   pUartPckt = (hci_uart_pckt *)&(pParam->pckt->evtserial);
   event_pckt = (hci_event_pckt*)(pUartPckt->data);
 
+  /* The event is dispatched to its callback of ble_events.h through the event tables of ble_events.c */
   switch (event_pckt->evt)
   {
     case HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE:
       {
         evt_blecore_aci *blecore_evt;
-        
-        blecore_evt = (evt_blecore_aci*) event_pckt->data;
-
-        switch (blecore_evt->ecode)
-        {
-          case EVT_END_OF_RADIO_ACTIVITY:
-            {
-              BSP_LED_Toggle(LED_GREEN);
-            }
-            break; /* EVT_END_OF_RADIO_ACTIVITY */
-            
-          case ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE:
-            {
-              aci_gatt_attribute_modified_event_rp0 * attribute_modified;
-              
-              attribute_modified = (aci_gatt_attribute_modified_event_rp0*)blecore_evt->data;
-              aci_gatt_attribute_modified_event(attribute_modified->Connection_Handle,
-                                                attribute_modified->Attr_Handle,
-                                                attribute_modified->Offset,
-                                                attribute_modified->Attr_Data_Length,
-                                                attribute_modified->Attr_Data);
-            }
-            break;
-
-          default:
-            break;
-        }
-      }
-      break; /* HCI_HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE_SPECIFIC */
 
-    case HCI_DISCONNECTION_COMPLETE_EVT_CODE:
-      {
-        hci_disconnection_complete_event_rp0 * disconnection_complete_event;
-
-        disconnection_complete_event = (hci_disconnection_complete_event_rp0 *)event_pckt->data;
-
-        hci_disconnection_complete_event(disconnection_complete_event->Status,
-                                         disconnection_complete_event->Connection_Handle,
-                                         disconnection_complete_event->Reason );
+        blecore_evt = (evt_blecore_aci*) event_pckt->data;
+        p_entry = hci_vs_event_table_find(blecore_evt->ecode);
+        p_param = blecore_evt->data;
       }
-      break; /* HCI_DISCONNECTION_COMPLETE_EVT_CODE */
+      break; /* HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE */
 
     case HCI_LE_META_EVT_CODE:
       {
         evt_le_meta_event *meta_evt;
-        
-        meta_evt = (evt_le_meta_event*)event_pckt->data;
 
-        switch(meta_evt->subevent)
-        {
-          case HCI_LE_CONNECTION_COMPLETE_SUBEVT_CODE:
-            {
-              hci_le_connection_complete_event_rp0 * connection_complete_event;
-
-              /**
-               * The connection is done, there is no need anymore to schedule the LP ADV
-               */
-              connection_complete_event = (hci_le_connection_complete_event_rp0 *)meta_evt->data;
-
-              hci_le_connection_complete_event( connection_complete_event->Status,
-                                                connection_complete_event->Connection_Handle,
-                                                connection_complete_event->Role,
-                                                connection_complete_event->Peer_Address_Type,
-                                                connection_complete_event->Peer_Address,
-                                                connection_complete_event->Conn_Interval,
-                                                connection_complete_event->Conn_Latency,
-                                                connection_complete_event->Supervision_Timeout,
-                                                connection_complete_event->Master_Clock_Accuracy );
-            }
-            break; /* HCI_HCI_LE_CONNECTION_COMPLETE_SUBEVT_CODE */
-
-            default:
-              break;
-        }
+        meta_evt = (evt_le_meta_event*)event_pckt->data;
+        p_entry = hci_le_event_table_find(meta_evt->subevent);
+        p_param = meta_evt->data;
       }
-      break; /* HCI_HCI_LE_META_EVT_CODE */
-      
+      break; /* HCI_LE_META_EVT_CODE */
+
     default:
+      {
+        p_entry = hci_event_table_find(event_pckt->evt);
+        p_param = event_pckt->data;
+      }
       break;
   }
+
+  if (p_entry != NULL)
+  {
+    p_entry->process(p_param);
+  }
 }
 
 /**
@@ -1069,6 +1019,22 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification( void *pckt )
   return (SVCCTL_UserEvtFlowEnable);
 }
 
+/**
+ * @brief ACI_HAL_END_OF_RADIO_ACTIVITY_EVENT
+ * This event is generated when the device completes a radio activity and
+ * provide information when a new radio activity will be performed.
+ * The green LED is toggled on each radio activity.
+ * @return None
+ */
+void aci_hal_end_of_radio_activity_event( uint8_t Last_State,
+                                          uint8_t Next_State,
+                                          uint32_t Next_State_SysTime,
+                                          uint8_t Last_State_Slot,
+                                          uint8_t Next_State_Slot )
+{
+  BSP_LED_Toggle(LED_GREEN);
+}
+
 /**
  * @brief ACI_GATT_ATTRIBUTE_MODIFIED_EVENT
  * This event is generated to the application by the GATT server when a client
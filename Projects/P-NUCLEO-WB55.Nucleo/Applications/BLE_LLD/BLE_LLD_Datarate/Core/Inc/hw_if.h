@@ -209,6 +209,31 @@ void MX_USART1_UART_DeInit(void);
    */
   void HW_TS_Start(uint8_t TimerID, uint32_t timeout_ticks);
 
+  /**
+   * @brief  Start a virtual timer with a tolerance on the expiry time
+   *         This API behaves as HW_TS_Start() but the timer may be notified up to slack_ticks after its timeout.
+   *         The timer server uses this tolerance to notify on a single wakeup the timers whose tolerance windows
+   *         overlap. When the timer is in the repeated mode, it is restarted with the same tolerance.
+   *
+   * @param  TimerID:  The ID Id of the timer to start
+   * @param  timeout_ticks: Number of ticks of the virtual timer (Maximum value is (0xFFFFFFFF-0xFFFF = 0xFFFF0000)
+   * @param  slack_ticks: Number of ticks the notification may be delayed
+   * @retval None
+   */
+  void HW_TS_StartWithSlack(uint8_t TimerID, uint32_t timeout_ticks, uint32_t slack_ticks);
+
+  /**
+   * @brief  Read the wakeup counters of the timer server
+   *         The number of wakeups avoided is the number of timers notified without a dedicated wakeup of the RTC
+   *         wakeup timer, either because they expire at the same time or because their tolerance windows overlap.
+   *         The counters are cleared by HW_TS_Init() in hw_ts_InitMode_Full.
+   *
+   * @param  pRtcWakeupCount: Number of RTC wakeup timer expiries that have notified a timer
+   * @param  pWakeupAvoidedCount: Number of timers notified without a dedicated RTC wakeup
+   * @retval None
+   */
+  void HW_TS_ReadWakeupCounters(uint32_t *pRtcWakeupCount, uint32_t *pWakeupAvoidedCount);
+
   /**
    * @brief  Delete a virtual timer from the list
    *         This API should be used when a timer is not needed anymore by the user. A deleted timer is removed from
@@ -0,0 +1,118 @@
+/**
+ ******************************************************************************
+ * @file    utilities_conf.h
+ * @author  MCD Application Team
+ * @brief   Configuration file to utilities for a Linux host build
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * This template allows the utilities (e.g. the sequencer) to be compiled and
+ * executed on a Linux host, for instance to measure scheduling latency on a PC
+ * before flashing a board.
+ *
+ * The interrupt masking (PRIMASK) used on target is replaced by a recursive
+ * pthread mutex. A thread of the host application may play the role of an
+ * interrupt handler and call UTIL_SEQ_SetTask() / UTIL_SEQ_SetEvt() while the
+ * main thread executes UTIL_SEQ_Run().
+ *
+ * UTIL_SEQ_Idle() is called with the lock held: a host implementation may
+ * block on a condition variable bound to UTILS_HostLock (signaled by the
+ * "interrupt" thread) to emulate the WFI of the target.
+ *
+ * The number of tasks, of priorities, the statistics and the EDF mode may be
+ * given on the compiler command line, e.g. -DUTIL_SEQ_CONF_PRIO_NBR=4U, so that
+ * a benchmark can be built for several configurations (see
+ * Utilities/sequencer/host).
+ *
+ * The host application shall provide the definition of UTILS_HostLock, e.g.
+ *   pthread_mutex_t UTILS_HostLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+ * and shall be compiled with -D_GNU_SOURCE -pthread.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef UTILITIES_CONF_H
+#define UTILITIES_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include "stdio.h"
+#include "string.h"
+
+/******************************************************************************
+ * compiler
+ ******************************************************************************/
+#ifndef __WEAK
+#define __WEAK                                  __attribute__((weak))
+#endif
+
+/******************************************************************************
+ * common
+ ******************************************************************************/
+extern pthread_mutex_t UTILS_HostLock;
+
+#define UTILS_INIT_CRITICAL_SECTION( )
+#define UTILS_ENTER_CRITICAL_SECTION( )         (void)pthread_mutex_lock( &UTILS_HostLock )
+
+#define UTILS_EXIT_CRITICAL_SECTION( )          (void)pthread_mutex_unlock( &UTILS_HostLock )
+
+#define UTILS_MEMSET8(dest, value, size)        memset((dest),(value),(size));
+
+/******************************************************************************
+ * tim_serv
+ * (any macro that does not need to be modified can be removed)
+ ******************************************************************************/
+#define UTIL_TIMER_INIT_CRITICAL_SECTION( )
+#define UTIL_TIMER_ENTER_CRITICAL_SECTION( )    UTILS_ENTER_CRITICAL_SECTION( )
+#define UTIL_TIMER_EXIT_CRITICAL_SECTION( )     UTILS_EXIT_CRITICAL_SECTION( )
+
+/******************************************************************************
+ * tiny low power manager
+ * (any macro that does not need to be modified can be removed)
+ ******************************************************************************/
+#define UTIL_LPM_INIT_CRITICAL_SECTION( )
+#define UTIL_LPM_ENTER_CRITICAL_SECTION( )      UTILS_ENTER_CRITICAL_SECTION( )
+#define UTIL_LPM_EXIT_CRITICAL_SECTION( )       UTILS_EXIT_CRITICAL_SECTION( )
+
+/******************************************************************************
+ * sequencer
+ * (any macro that does not need to be modified can be removed)
+ ******************************************************************************/
+#define UTIL_SEQ_INIT_CRITICAL_SECTION( )
+#define UTIL_SEQ_ENTER_CRITICAL_SECTION( )      UTILS_ENTER_CRITICAL_SECTION( )
+#define UTIL_SEQ_EXIT_CRITICAL_SECTION( )       UTILS_EXIT_CRITICAL_SECTION( )
+#ifndef UTIL_SEQ_CONF_TASK_NBR
+#define UTIL_SEQ_CONF_TASK_NBR                  (32U)
+#endif
+#ifndef UTIL_SEQ_CONF_PRIO_NBR
+#define UTIL_SEQ_CONF_PRIO_NBR                  (2U)
+#endif
+#define UTIL_SEQ_MEMSET8( dest, value, size )   UTILS_MEMSET8((dest),(value),(size))
+#ifndef UTIL_SEQ_CONF_STATISTICS
+#define UTIL_SEQ_CONF_STATISTICS                (0U)
+#endif
+/* #define UTIL_SEQ_GET_CYCLE_COUNT( )             host_cycle_count( ) */
+#ifndef UTIL_SEQ_CONF_EDF
+#define UTIL_SEQ_CONF_EDF                       (0U)
+#endif
+/* #define UTIL_SEQ_GET_TICK( )                    host_tick( ) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*UTILITIES_CONF_H */
@@ -68,7 +68,12 @@ extern "C" {
 #define UTIL_SEQ_EXIT_CRITICAL_SECTION( )       UTILS_EXIT_CRITICAL_SECTION( )
 #define UTIL_SEQ_CONF_TASK_NBR                  (32U)
 #define UTIL_SEQ_CONF_PRIO_NBR                  (2U)
+#define UTIL_SEQ_CONF_EVT_NBR                   (32U)
 #define UTIL_SEQ_MEMSET8( dest, value, size )   UTILS_MEMSET8((dest),(value),(size))
+#define UTIL_SEQ_CONF_STATISTICS                (0U)
+/* #define UTIL_SEQ_GET_CYCLE_COUNT( )             (DWT->CYCCNT) */
+#define UTIL_SEQ_CONF_EDF                       (0U)
+/* #define UTIL_SEQ_GET_TICK( )                    HAL_GetTick( ) */
 
 /******************************************************************************
  * trace\advanced
@@ -0,0 +1,342 @@
+/**
+ ******************************************************************************
+ * @file    seq_benchmark.c
+ * @author  MCD Application Team
+ * @brief   Linux host benchmark of the sequencer
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The tasks are requested with UTIL_SEQ_SetTask() by bursts, each request
+ * picking a random task among the first <tasks> ones and a random priority
+ * among the UTIL_SEQ_CONF_PRIO_NBR levels. The next burst is only sent once
+ * all the tasks of the previous one have been executed.
+ *
+ *   -m isr     the bursts are sent by a thread playing the interrupt context
+ *              while the main thread executes UTIL_SEQ_Run() and sleeps in
+ *              UTIL_SEQ_Idle() on a condition variable, as the target does
+ *              in WFI. The latency includes the wake up of the main thread.
+ *   -m inline  the bursts are sent by the main thread before it calls
+ *              UTIL_SEQ_Run(). Only the cost of the sequencer is measured.
+ *
+ * The set-to-run latency of a task is measured from the first request of the
+ * task that finds it not pending up to the start of its execution. Requests
+ * of a task already pending are coalesced by the sequencer.
+ *
+ * Usage: seq_benchmark -t <tasks> -n <requests> -b <burst> -m <isr|inline> [-c <csv>]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "stm32_seq.h"
+#include "utilities_conf.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define SEQ_BENCH_MAX_TASK_NBR                  (32U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  SEQ_BENCH_MODE_ISR,
+  SEQ_BENCH_MODE_INLINE,
+} SEQ_BENCH_Mode_t;
+
+/* Private variables ---------------------------------------------------------*/
+pthread_mutex_t UTILS_HostLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/**
+ * Signaled by the interrupt thread when it sends a burst, and by the tasks
+ * when the last pending one has been executed
+ */
+static pthread_cond_t IsrCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t DrainedCond = PTHREAD_COND_INITIALIZER;
+
+static SEQ_BENCH_Mode_t Mode = SEQ_BENCH_MODE_ISR;
+static uint32_t TaskNbr = 8U;
+static uint32_t RequestNbr = 100000U;
+static uint32_t BurstSize = 1U;
+static const char *CsvFile;
+
+static uint32_t PendingTasks;
+static volatile uint8_t Done;
+static uint64_t SetTime[SEQ_BENCH_MAX_TASK_NBR];
+static uint32_t *p_Latency;
+static uint32_t LatencyNbr;
+static uint32_t Coalesced;
+static uint32_t RandomState = 0x2545F491U;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint64_t SEQ_BENCH_Now( void );
+static uint32_t SEQ_BENCH_Random( void );
+static void SEQ_BENCH_SendBurst( uint32_t count );
+static void SEQ_BENCH_Task( uint32_t TaskIdx );
+static void *SEQ_BENCH_Isr( void *arg );
+static int SEQ_BENCH_Compare( const void *a, const void *b );
+
+/* Functions Definition ------------------------------------------------------*/
+#define SEQ_BENCH_TASK(n)   static void SEQ_BENCH_Task##n( void ) { SEQ_BENCH_Task( n ); }
+SEQ_BENCH_TASK(0)  SEQ_BENCH_TASK(1)  SEQ_BENCH_TASK(2)  SEQ_BENCH_TASK(3)
+SEQ_BENCH_TASK(4)  SEQ_BENCH_TASK(5)  SEQ_BENCH_TASK(6)  SEQ_BENCH_TASK(7)
+SEQ_BENCH_TASK(8)  SEQ_BENCH_TASK(9)  SEQ_BENCH_TASK(10) SEQ_BENCH_TASK(11)
+SEQ_BENCH_TASK(12) SEQ_BENCH_TASK(13) SEQ_BENCH_TASK(14) SEQ_BENCH_TASK(15)
+SEQ_BENCH_TASK(16) SEQ_BENCH_TASK(17) SEQ_BENCH_TASK(18) SEQ_BENCH_TASK(19)
+SEQ_BENCH_TASK(20) SEQ_BENCH_TASK(21) SEQ_BENCH_TASK(22) SEQ_BENCH_TASK(23)
+SEQ_BENCH_TASK(24) SEQ_BENCH_TASK(25) SEQ_BENCH_TASK(26) SEQ_BENCH_TASK(27)
+SEQ_BENCH_TASK(28) SEQ_BENCH_TASK(29) SEQ_BENCH_TASK(30) SEQ_BENCH_TASK(31)
+
+static void (* const TaskTable[SEQ_BENCH_MAX_TASK_NBR])( void ) =
+{
+  SEQ_BENCH_Task0,  SEQ_BENCH_Task1,  SEQ_BENCH_Task2,  SEQ_BENCH_Task3,
+  SEQ_BENCH_Task4,  SEQ_BENCH_Task5,  SEQ_BENCH_Task6,  SEQ_BENCH_Task7,
+  SEQ_BENCH_Task8,  SEQ_BENCH_Task9,  SEQ_BENCH_Task10, SEQ_BENCH_Task11,
+  SEQ_BENCH_Task12, SEQ_BENCH_Task13, SEQ_BENCH_Task14, SEQ_BENCH_Task15,
+  SEQ_BENCH_Task16, SEQ_BENCH_Task17, SEQ_BENCH_Task18, SEQ_BENCH_Task19,
+  SEQ_BENCH_Task20, SEQ_BENCH_Task21, SEQ_BENCH_Task22, SEQ_BENCH_Task23,
+  SEQ_BENCH_Task24, SEQ_BENCH_Task25, SEQ_BENCH_Task26, SEQ_BENCH_Task27,
+  SEQ_BENCH_Task28, SEQ_BENCH_Task29, SEQ_BENCH_Task30, SEQ_BENCH_Task31,
+};
+
+/**
+ * @brief UTIL_SEQ_Idle is called with UTILS_HostLock held: wait for the next burst
+ *        the same way the target waits in WFI for an interrupt
+ */
+void UTIL_SEQ_Idle( void )
+{
+  if (Mode == SEQ_BENCH_MODE_ISR)
+  {
+    while ((PendingTasks == 0U) && (Done == 0U))
+    {
+      (void)pthread_cond_wait(&IsrCond, &UTILS_HostLock);
+    }
+  }
+
+  return;
+}
+
+int main( int argc, char *argv[] )
+{
+  pthread_t isr_thread;
+  uint64_t start;
+  uint64_t elapsed;
+  uint32_t sent;
+  uint32_t idx;
+  uint32_t runs;
+  double throughput;
+  FILE *csv;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "t:n:b:m:c:")) != -1)
+  {
+    switch (opt)
+    {
+      case 't':
+        TaskNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'n':
+        RequestNbr = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'b':
+        BurstSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'm':
+        Mode = (strcmp(optarg, "inline") == 0) ? SEQ_BENCH_MODE_INLINE : SEQ_BENCH_MODE_ISR;
+        break;
+      case 'c':
+        CsvFile = optarg;
+        break;
+      default:
+        fprintf(stderr, "usage: %s -t <tasks> -n <requests> -b <burst> -m <isr|inline> [-c <csv>]\n", argv[0]);
+        return 2;
+    }
+  }
+  if ((TaskNbr == 0U) || (TaskNbr > SEQ_BENCH_MAX_TASK_NBR) || (TaskNbr > UTIL_SEQ_CONF_TASK_NBR) ||
+      (RequestNbr == 0U) || (BurstSize == 0U))
+  {
+    fprintf(stderr, "invalid parameters\n");
+    return 2;
+  }
+
+  p_Latency = malloc(RequestNbr * sizeof(uint32_t));
+  if (p_Latency == NULL)
+  {
+    return 1;
+  }
+
+  UTIL_SEQ_Init();
+  for (idx = 0U; idx < TaskNbr; idx++)
+  {
+    UTIL_SEQ_RegTask(1U << idx, UTIL_SEQ_RFU, TaskTable[idx]);
+  }
+
+  start = SEQ_BENCH_Now();
+  if (Mode == SEQ_BENCH_MODE_ISR)
+  {
+    if (pthread_create(&isr_thread, NULL, SEQ_BENCH_Isr, NULL) != 0)
+    {
+      return 1;
+    }
+    while (Done == 0U)
+    {
+      UTIL_SEQ_Run(UTIL_SEQ_DEFAULT);
+    }
+    (void)pthread_join(isr_thread, NULL);
+  }
+  else
+  {
+    for (sent = 0U; sent < RequestNbr; sent += BurstSize)
+    {
+      SEQ_BENCH_SendBurst((RequestNbr - sent) < BurstSize ? (RequestNbr - sent) : BurstSize);
+      UTIL_SEQ_Run(UTIL_SEQ_DEFAULT);
+    }
+  }
+  elapsed = SEQ_BENCH_Now() - start;
+
+  runs = LatencyNbr;
+  throughput = (double)runs * 1e9 / (double)elapsed;
+  qsort(p_Latency, LatencyNbr, sizeof(uint32_t), SEQ_BENCH_Compare);
+
+  printf("prio %u tasks %2u %-6s burst %2u: %u runs (%u coalesced), %.0f runs/s, latency p50 %u ns p99 %u ns max %u ns\n",
+         (unsigned)UTIL_SEQ_CONF_PRIO_NBR, TaskNbr, (Mode == SEQ_BENCH_MODE_ISR) ? "isr" : "inline",
+         BurstSize, runs, Coalesced, throughput,
+         p_Latency[LatencyNbr / 2U], p_Latency[(uint32_t)(((uint64_t)LatencyNbr * 99U) / 100U)],
+         p_Latency[LatencyNbr - 1U]);
+
+  if (CsvFile != NULL)
+  {
+    csv = fopen(CsvFile, "a");
+    if (csv == NULL)
+    {
+      return 1;
+    }
+    if (ftell(csv) == 0)
+    {
+      fprintf(csv, "prio_nbr,tasks,mode,burst,runs,coalesced,runs_per_s,p50_ns,p99_ns,max_ns\n");
+    }
+    fprintf(csv, "%u,%u,%s,%u,%u,%u,%.0f,%u,%u,%u\n",
+            (unsigned)UTIL_SEQ_CONF_PRIO_NBR, TaskNbr, (Mode == SEQ_BENCH_MODE_ISR) ? "isr" : "inline",
+            BurstSize, runs, Coalesced, throughput,
+            p_Latency[LatencyNbr / 2U], p_Latency[(uint32_t)(((uint64_t)LatencyNbr * 99U) / 100U)],
+            p_Latency[LatencyNbr - 1U]);
+    (void)fclose(csv);
+  }
+
+  free(p_Latency);
+
+  return 0;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+static uint64_t SEQ_BENCH_Now( void )
+{
+  struct timespec ts;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t SEQ_BENCH_Random( void )
+{
+  RandomState ^= RandomState << 13U;
+  RandomState ^= RandomState >> 17U;
+  RandomState ^= RandomState << 5U;
+
+  return RandomState;
+}
+
+/**
+ * @brief request count tasks, called with UTILS_HostLock held in the isr mode
+ */
+static void SEQ_BENCH_SendBurst( uint32_t count )
+{
+  uint64_t now = SEQ_BENCH_Now();
+  uint32_t task_idx;
+  uint32_t prio;
+
+  while (count != 0U)
+  {
+    task_idx = SEQ_BENCH_Random() % TaskNbr;
+    prio = SEQ_BENCH_Random() % UTIL_SEQ_CONF_PRIO_NBR;
+    if ((PendingTasks & (1U << task_idx)) == 0U)
+    {
+      PendingTasks |= (1U << task_idx);
+      SetTime[task_idx] = now;
+    }
+    else
+    {
+      Coalesced++;
+    }
+    UTIL_SEQ_SetTask(1U << task_idx, prio);
+    count--;
+  }
+
+  return;
+}
+
+static void SEQ_BENCH_Task( uint32_t TaskIdx )
+{
+  uint64_t now = SEQ_BENCH_Now();
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  p_Latency[LatencyNbr++] = (uint32_t)(now - SetTime[TaskIdx]);
+  PendingTasks &= ~(1U << TaskIdx);
+  if (PendingTasks == 0U)
+  {
+    (void)pthread_cond_signal(&DrainedCond);
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  return;
+}
+
+/**
+ * @brief interrupt context: send a burst and wait for the tasks to be executed
+ */
+static void *SEQ_BENCH_Isr( void *arg )
+{
+  uint32_t sent;
+  uint32_t count;
+
+  (void)arg;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  for (sent = 0U; sent < RequestNbr; sent += count)
+  {
+    count = ((RequestNbr - sent) < BurstSize) ? (RequestNbr - sent) : BurstSize;
+    SEQ_BENCH_SendBurst(count);
+    (void)pthread_cond_signal(&IsrCond);
+    while (PendingTasks != 0U)
+    {
+      (void)pthread_cond_wait(&DrainedCond, &UTILS_HostLock);
+    }
+  }
+  Done = 1U;
+  (void)pthread_cond_signal(&IsrCond);
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  return NULL;
+}
+
+static int SEQ_BENCH_Compare( const void *a, const void *b )
+{
+  uint32_t va = *(const uint32_t *)a;
+  uint32_t vb = *(const uint32_t *)b;
+
+  return (va > vb) - (va < vb);
+}
@@ -0,0 +1,392 @@
+/**
+ ******************************************************************************
+ * @file    seq_edf_sim.c
+ * @author  MCD Application Team
+ * @brief   Linux host simulation of the sequencer deadline misses, earliest
+ *          deadline first versus priorities
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The sequencer is executed on a virtual time in microseconds: a task advances
+ * the time by its execution time, and UTIL_SEQ_Idle() advances it up to the
+ * next release. The releases that fall during the execution of a task are
+ * requested at their time, as an interrupt handler would, and are only
+ * executed once the running task returns (the sequencer is not preemptive).
+ *
+ * Synthetic BLE + Thread workload:
+ *  - BLE connection event: every 7.5 ms, 300 us, shall run within 1.25 ms,
+ *    low priority
+ *  - BLE stack event: random, 4 ms on average, 200 us, within 3 ms, low priority
+ *  - Thread reception: a burst of <burst> tasks of 800 us every 15 ms +/- 2 ms,
+ *    within 10 ms, high priority
+ *  - application: every 50 ms, 2 ms, no deadline, low priority
+ *
+ *   -m prio   the tasks are requested with UTIL_SEQ_SetTask() only
+ *   -m edf    the tasks with a deadline are requested with UTIL_SEQ_SetTaskDeadline()
+ *
+ * A job misses its deadline when it starts after it, or when it is released
+ * while the previous one of the same task is still pending (the requests are
+ * coalesced by the sequencer, so the job is lost).
+ *
+ * Usage: seq_edf_sim -m <prio|edf> -b <burst> [-d <duration s>] [-c <csv>]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "stm32_seq.h"
+#include "utilities_conf.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define SEQ_SIM_MAX_BURST                       (8U)
+
+#define SEQ_SIM_TASK_BLE_CONN                   (0U)
+#define SEQ_SIM_TASK_BLE_EVT                    (1U)
+#define SEQ_SIM_TASK_APP                        (2U)
+#define SEQ_SIM_TASK_THREAD                     (3U)
+#define SEQ_SIM_TASK_NBR                        (SEQ_SIM_TASK_THREAD + SEQ_SIM_MAX_BURST)
+
+#define SEQ_SIM_PRIO_HIGH                       (0U)
+#define SEQ_SIM_PRIO_LOW                        (1U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  SEQ_SIM_CLASS_BLE_CONN,
+  SEQ_SIM_CLASS_BLE_EVT,
+  SEQ_SIM_CLASS_THREAD,
+  SEQ_SIM_CLASS_APP,
+  SEQ_SIM_CLASS_NBR,
+} SEQ_SIM_Class_t;
+
+typedef struct
+{
+  uint32_t cost;
+  uint32_t deadline;          /* relative to the release, 0 when none */
+  uint32_t prio;
+  SEQ_SIM_Class_t class;
+} SEQ_SIM_Task_t;
+
+typedef struct
+{
+  uint8_t pending;
+  uint32_t abs_deadline;
+} SEQ_SIM_Job_t;
+
+typedef struct
+{
+  uint32_t jobs;
+  uint32_t missed;
+  uint32_t lost;
+  uint32_t worst_start;
+} SEQ_SIM_Stats_t;
+
+/* Private variables ---------------------------------------------------------*/
+pthread_mutex_t UTILS_HostLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static const SEQ_SIM_Task_t TaskDesc[SEQ_SIM_CLASS_NBR] =
+{
+  [SEQ_SIM_CLASS_BLE_CONN] = {  300U,  1250U, SEQ_SIM_PRIO_LOW,  SEQ_SIM_CLASS_BLE_CONN },
+  [SEQ_SIM_CLASS_BLE_EVT]  = {  200U,  3000U, SEQ_SIM_PRIO_LOW,  SEQ_SIM_CLASS_BLE_EVT },
+  [SEQ_SIM_CLASS_THREAD]   = {  800U, 10000U, SEQ_SIM_PRIO_HIGH, SEQ_SIM_CLASS_THREAD },
+  [SEQ_SIM_CLASS_APP]      = { 2000U,     0U, SEQ_SIM_PRIO_LOW,  SEQ_SIM_CLASS_APP },
+};
+
+static const char * const ClassName[SEQ_SIM_CLASS_NBR] = { "ble_conn", "ble_evt", "thread", "app" };
+
+static uint8_t EdfMode;
+static uint32_t BurstSize = 4U;
+static uint32_t Duration = 60U;
+static const char *CsvFile;
+
+static uint32_t Now;
+static uint32_t EndTime;
+static uint32_t NextBleConn;
+static uint32_t NextBleEvt;
+static uint32_t NextThread;
+static uint32_t NextApp;
+static uint32_t RandomState = 0x2545F491U;
+
+static SEQ_SIM_Job_t Job[SEQ_SIM_TASK_NBR];
+static SEQ_SIM_Stats_t Stats[SEQ_SIM_CLASS_NBR];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t SEQ_SIM_Random( uint32_t Range );
+static const SEQ_SIM_Task_t *SEQ_SIM_Desc( uint32_t TaskIdx );
+static uint32_t SEQ_SIM_NextRelease( void );
+static void SEQ_SIM_Release( uint32_t TaskIdx );
+static void SEQ_SIM_Advance( uint32_t To );
+static void SEQ_SIM_Task( uint32_t TaskIdx );
+
+/* Functions Definition ------------------------------------------------------*/
+#define SEQ_SIM_TASK(n)   static void SEQ_SIM_Task##n( void ) { SEQ_SIM_Task( n ); }
+SEQ_SIM_TASK(0) SEQ_SIM_TASK(1) SEQ_SIM_TASK(2)  SEQ_SIM_TASK(3)  SEQ_SIM_TASK(4)  SEQ_SIM_TASK(5)
+SEQ_SIM_TASK(6) SEQ_SIM_TASK(7) SEQ_SIM_TASK(8)  SEQ_SIM_TASK(9)  SEQ_SIM_TASK(10)
+
+static void (* const TaskTable[SEQ_SIM_TASK_NBR])( void ) =
+{
+  SEQ_SIM_Task0, SEQ_SIM_Task1, SEQ_SIM_Task2, SEQ_SIM_Task3, SEQ_SIM_Task4, SEQ_SIM_Task5,
+  SEQ_SIM_Task6, SEQ_SIM_Task7, SEQ_SIM_Task8, SEQ_SIM_Task9, SEQ_SIM_Task10,
+};
+
+uint32_t SEQ_SIM_GetTick( void )
+{
+  return Now;
+}
+
+/**
+ * @brief nothing is pending: wait for the next release
+ */
+void UTIL_SEQ_Idle( void )
+{
+  SEQ_SIM_Advance(SEQ_SIM_NextRelease());
+
+  return;
+}
+
+int main( int argc, char *argv[] )
+{
+  uint32_t idx;
+  uint32_t jobs = 0U;
+  uint32_t missed = 0U;
+  FILE *csv;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "m:b:d:c:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'm':
+        EdfMode = (strcmp(optarg, "edf") == 0) ? 1U : 0U;
+        break;
+      case 'b':
+        BurstSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'd':
+        Duration = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'c':
+        CsvFile = optarg;
+        break;
+      default:
+        fprintf(stderr, "usage: %s -m <prio|edf> -b <burst> [-d <duration s>] [-c <csv>]\n", argv[0]);
+        return 2;
+    }
+  }
+  if ((BurstSize == 0U) || (BurstSize > SEQ_SIM_MAX_BURST) || (Duration == 0U) || (Duration > 4000U))
+  {
+    fprintf(stderr, "invalid parameters\n");
+    return 2;
+  }
+
+  UTIL_SEQ_Init();
+  for (idx = 0U; idx < SEQ_SIM_TASK_NBR; idx++)
+  {
+    UTIL_SEQ_RegTask(1U << idx, UTIL_SEQ_RFU, TaskTable[idx]);
+  }
+
+  EndTime = Duration * 1000000U;
+  NextBleConn = 1000U;
+  NextBleEvt = SEQ_SIM_Random(8000U);
+  NextThread = 5000U;
+  NextApp = 20000U;
+
+  while (Now < EndTime)
+  {
+    UTIL_SEQ_Run(UTIL_SEQ_DEFAULT);
+  }
+
+  printf("%-4s burst %u:", EdfMode ? "edf" : "prio", BurstSize);
+  for (idx = 0U; idx < SEQ_SIM_CLASS_NBR; idx++)
+  {
+    if (TaskDesc[idx].deadline != 0U)
+    {
+      printf(" %s %.2f%%", ClassName[idx], (100.0 * (Stats[idx].missed + Stats[idx].lost)) / Stats[idx].jobs);
+      jobs += Stats[idx].jobs;
+      missed += Stats[idx].missed + Stats[idx].lost;
+    }
+  }
+  printf(" | all %.2f%% (%u/%u)", (100.0 * missed) / jobs, missed, jobs);
+  if (EdfMode != 0U)
+  {
+    printf(" | UTIL_SEQ_GetDeadlineMiss %u", UTIL_SEQ_GetDeadlineMiss());
+  }
+  printf(" | worst start delay ble_conn %u us thread %u us\n",
+         Stats[SEQ_SIM_CLASS_BLE_CONN].worst_start, Stats[SEQ_SIM_CLASS_THREAD].worst_start);
+
+  if (CsvFile != NULL)
+  {
+    csv = fopen(CsvFile, "a");
+    if (csv == NULL)
+    {
+      return 1;
+    }
+    if (ftell(csv) == 0)
+    {
+      fprintf(csv, "mode,burst,class,jobs,missed,lost,miss_rate,worst_start_delay_us\n");
+    }
+    for (idx = 0U; idx < SEQ_SIM_CLASS_NBR; idx++)
+    {
+      fprintf(csv, "%s,%u,%s,%u,%u,%u,%.4f,%u\n", EdfMode ? "edf" : "prio", BurstSize, ClassName[idx],
+              Stats[idx].jobs, Stats[idx].missed, Stats[idx].lost,
+              (TaskDesc[idx].deadline != 0U) ? (double)(Stats[idx].missed + Stats[idx].lost) / Stats[idx].jobs : 0.0,
+              Stats[idx].worst_start);
+    }
+    (void)fclose(csv);
+  }
+
+  return 0;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+static uint32_t SEQ_SIM_Random( uint32_t Range )
+{
+  RandomState ^= RandomState << 13U;
+  RandomState ^= RandomState >> 17U;
+  RandomState ^= RandomState << 5U;
+
+  return RandomState % Range;
+}
+
+static const SEQ_SIM_Task_t *SEQ_SIM_Desc( uint32_t TaskIdx )
+{
+  const SEQ_SIM_Task_t *desc;
+
+  switch (TaskIdx)
+  {
+    case SEQ_SIM_TASK_BLE_CONN:
+      desc = &TaskDesc[SEQ_SIM_CLASS_BLE_CONN];
+      break;
+    case SEQ_SIM_TASK_BLE_EVT:
+      desc = &TaskDesc[SEQ_SIM_CLASS_BLE_EVT];
+      break;
+    case SEQ_SIM_TASK_APP:
+      desc = &TaskDesc[SEQ_SIM_CLASS_APP];
+      break;
+    default:
+      desc = &TaskDesc[SEQ_SIM_CLASS_THREAD];
+      break;
+  }
+
+  return desc;
+}
+
+static uint32_t SEQ_SIM_NextRelease( void )
+{
+  uint32_t next = NextBleConn;
+
+  next = (NextBleEvt < next) ? NextBleEvt : next;
+  next = (NextThread < next) ? NextThread : next;
+  next = (NextApp < next) ? NextApp : next;
+
+  return next;
+}
+
+/**
+ * @brief interrupt context: request a task
+ */
+static void SEQ_SIM_Release( uint32_t TaskIdx )
+{
+  const SEQ_SIM_Task_t *desc = SEQ_SIM_Desc(TaskIdx);
+
+  Stats[desc->class].jobs++;
+  if (Job[TaskIdx].pending != 0U)
+  {
+    /* coalesced with the pending request: the job is lost */
+    Stats[desc->class].lost++;
+    return;
+  }
+  Job[TaskIdx].pending = 1U;
+  Job[TaskIdx].abs_deadline = Now + desc->deadline;
+
+  if ((EdfMode != 0U) && (desc->deadline != 0U))
+  {
+    UTIL_SEQ_SetTaskDeadline(TaskIdx, desc->prio, Job[TaskIdx].abs_deadline);
+  }
+  else
+  {
+    UTIL_SEQ_SetTask(1U << TaskIdx, desc->prio);
+  }
+
+  return;
+}
+
+/**
+ * @brief advance the virtual time, requesting the tasks released meanwhile
+ */
+static void SEQ_SIM_Advance( uint32_t To )
+{
+  uint32_t idx;
+
+  while (SEQ_SIM_NextRelease() <= To)
+  {
+    Now = SEQ_SIM_NextRelease();
+    if (Now == NextBleConn)
+    {
+      SEQ_SIM_Release(SEQ_SIM_TASK_BLE_CONN);
+      NextBleConn += 7500U;
+    }
+    else if (Now == NextBleEvt)
+    {
+      SEQ_SIM_Release(SEQ_SIM_TASK_BLE_EVT);
+      /* 4 ms on average */
+      NextBleEvt += 500U + SEQ_SIM_Random(7000U);
+    }
+    else if (Now == NextThread)
+    {
+      for (idx = 0U; idx < BurstSize; idx++)
+      {
+        SEQ_SIM_Release(SEQ_SIM_TASK_THREAD + idx);
+      }
+      NextThread += 13000U + SEQ_SIM_Random(4000U);
+    }
+    else
+    {
+      SEQ_SIM_Release(SEQ_SIM_TASK_APP);
+      NextApp += 50000U;
+    }
+  }
+  Now = To;
+
+  return;
+}
+
+static void SEQ_SIM_Task( uint32_t TaskIdx )
+{
+  const SEQ_SIM_Task_t *desc = SEQ_SIM_Desc(TaskIdx);
+  SEQ_SIM_Stats_t *stats = &Stats[desc->class];
+  uint32_t start_delay;
+
+  Job[TaskIdx].pending = 0U;
+  if (desc->deadline != 0U)
+  {
+    if ((int32_t)(Now - Job[TaskIdx].abs_deadline) > 0)
+    {
+      stats->missed++;
+    }
+    start_delay = Now - (Job[TaskIdx].abs_deadline - desc->deadline);
+    if (start_delay > stats->worst_start)
+    {
+      stats->worst_start = start_delay;
+    }
+  }
+
+  SEQ_SIM_Advance(Now + desc->cost);
+
+  return;
+}
@@ -0,0 +1,40 @@
+/**
+ ******************************************************************************
+ * @file    utilities_conf.h
+ * @author  MCD Application Team
+ * @brief   Configuration file to utilities for the sequencer host benchmark
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2019 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The benchmark uses the Linux host template as is. UTIL_SEQ_CONF_PRIO_NBR is
+ * given by the Makefile, one program being built per number of priorities.
+ *
+ * The EDF simulation is built with UTIL_SEQ_CONF_EDF set to 1: the deadlines
+ * are evaluated on its virtual time, in microseconds.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SEQ_HOST_UTILITIES_CONF_H
+#define SEQ_HOST_UTILITIES_CONF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "utilities_conf_host_template.h"
+
+#if (UTIL_SEQ_CONF_EDF == 1)
+uint32_t SEQ_SIM_GetTick( void );
+#define UTIL_SEQ_GET_TICK( )                    SEQ_SIM_GetTick( )
+#endif
+
+#endif /*SEQ_HOST_UTILITIES_CONF_H */
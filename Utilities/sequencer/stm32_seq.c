@@ -24,24 +24,6 @@
   * @{
   */
 
-/* Private typedef -----------------------------------------------------------*/
-/** @defgroup SEQUENCER_Private_type SEQUENCER private type
- *  @{
- */
-
-/**
- * @brief structure used to manage task scheduling
- */
-typedef struct
-{
-  uint32_t priority;    /*!<bit field of the enabled task.          */
-  uint32_t round_robin; /*!<mask on the allowed task to be running. */
-} UTIL_SEQ_Priority_t;
-
-/**
- * @}
- */
-
 /* Private defines -----------------------------------------------------------*/
 
 /** @defgroup SEQUENCER_Private_define SEQUENCER private defines
@@ -84,16 +66,41 @@ typedef struct
 #define UTIL_SEQ_ALL_BIT_SET    (~0U)
 
 /**
- * @brief default number of task is default 32 (maximum), can be reduced by redefining in utilities_conf.h
+ * @brief default number of task is default 32, can be modified by redefining in utilities_conf.h
+ *        Up to 1024 tasks are supported. The tasks above 31 are managed with the *Id API.
  */
 #ifndef UTIL_SEQ_CONF_TASK_NBR
 	#define UTIL_SEQ_CONF_TASK_NBR  (32)
 #endif
 
-#if UTIL_SEQ_CONF_TASK_NBR > 32
-#error "UTIL_SEQ_CONF_PRIO_NBR must be less of equal then 32"
+#if UTIL_SEQ_CONF_TASK_NBR > 1024
+#error "UTIL_SEQ_CONF_TASK_NBR must be less of equal then 1024"
 #endif
 
+/**
+ * @brief default number of event is default 32, can be modified by redefining in utilities_conf.h
+ *        Up to 1024 events are supported. The events above 31 are managed with the *Id API.
+ */
+#ifndef UTIL_SEQ_CONF_EVT_NBR
+	#define UTIL_SEQ_CONF_EVT_NBR  (32)
+#endif
+
+#if UTIL_SEQ_CONF_EVT_NBR > 1024
+#error "UTIL_SEQ_CONF_EVT_NBR must be less of equal then 1024"
+#endif
+
+/**
+ * @brief number of 32 bit words used to map the tasks and the events.
+ */
+#define UTIL_SEQ_TASK_WORD_NBR  ((UTIL_SEQ_CONF_TASK_NBR + 31U) / 32U)
+#define UTIL_SEQ_EVT_WORD_NBR   ((UTIL_SEQ_CONF_EVT_NBR + 31U) / 32U)
+
+/**
+ * @brief split of an id in a word index and a bit inside the word.
+ */
+#define UTIL_SEQ_ID_WORD( Id )  ((Id) >> 5U)
+#define UTIL_SEQ_ID_BIT( Id )   (1U << ((Id) & 31U))
+
 /**
  * @brief default value of priority number.
  */
@@ -101,6 +108,45 @@ typedef struct
   #define UTIL_SEQ_CONF_PRIO_NBR  (2)
 #endif
 
+/**
+ * @brief per task runtime statistics are disabled by default, can be enabled by redefining in utilities_conf.h
+ */
+#ifndef UTIL_SEQ_CONF_STATISTICS
+  #define UTIL_SEQ_CONF_STATISTICS  (0)
+#endif
+
+#if (UTIL_SEQ_CONF_STATISTICS == 1)
+/**
+ * @brief cycle counter used to timestamp the task. It shall be provided in utilities_conf.h,
+ *        e.g. DWT->CYCCNT on Cortex-M4 or a free running timer.
+ */
+#ifndef UTIL_SEQ_GET_CYCLE_COUNT
+#error "UTIL_SEQ_GET_CYCLE_COUNT( ) shall be defined when UTIL_SEQ_CONF_STATISTICS is enabled"
+#endif
+#define UTIL_SEQ_STATS_SET_TASK( WordIdx, TaskId_bm )    SEQ_StatsSetTask( WordIdx, TaskId_bm )
+#else
+#define UTIL_SEQ_STATS_SET_TASK( WordIdx, TaskId_bm )
+#endif
+
+/**
+ * @brief earliest deadline first scheduling is disabled by default, can be enabled by redefining in utilities_conf.h
+ *        When enabled, the tasks requested with UTIL_SEQ_SetTaskDeadline() are executed before the other ones,
+ *        the nearest deadline first.
+ */
+#ifndef UTIL_SEQ_CONF_EDF
+  #define UTIL_SEQ_CONF_EDF  (0)
+#endif
+
+#if (UTIL_SEQ_CONF_EDF == 1)
+/**
+ * @brief tick used to evaluate the deadlines. It shall be provided in utilities_conf.h,
+ *        e.g. the RTC or a free running timer. It is assumed to wrap around at 2^32.
+ */
+#ifndef UTIL_SEQ_GET_TICK
+#error "UTIL_SEQ_GET_TICK( ) shall be defined when UTIL_SEQ_CONF_EDF is enabled"
+#endif
+#endif
+
 /**
  * @brief default memset function.
  */
@@ -108,6 +154,35 @@ typedef struct
 #define UTIL_SEQ_MEMSET8( dest, value, size )   UTILS_MEMSET8( dest, value, size )
 #endif
 
+/**
+ * @}
+ */
+
+/* Private typedef -----------------------------------------------------------*/
+/** @defgroup SEQUENCER_Private_type SEQUENCER private type
+ *  @{
+ */
+
+/**
+ * @brief two level bitmap of tasks
+ *        bit n of summary is set when word[n] is not empty so that the highest task
+ *        can be found with two count leading zero operations
+ */
+typedef struct
+{
+  uint32_t summary;                             /*!<bit field of the non empty words. */
+  UTIL_SEQ_bm_t word[UTIL_SEQ_TASK_WORD_NBR];   /*!<bit field of the tasks.           */
+} UTIL_SEQ_TaskList_t;
+
+/**
+ * @brief structure used to manage task scheduling
+ */
+typedef struct
+{
+  UTIL_SEQ_TaskList_t priority;                       /*!<bit field of the enabled task.          */
+  UTIL_SEQ_bm_t round_robin[UTIL_SEQ_TASK_WORD_NBR];  /*!<mask on the allowed task to be running. */
+} UTIL_SEQ_Priority_t;
+
 /**
  * @}
  */
@@ -121,28 +196,33 @@ typedef struct
 /**
  * @brief task set.
  */
-static volatile UTIL_SEQ_bm_t TaskSet;
+static volatile UTIL_SEQ_TaskList_t TaskSet;
 
 /**
  * @brief task mask.
  */
-static volatile UTIL_SEQ_bm_t TaskMask = UTIL_SEQ_ALL_BIT_SET;
+static volatile UTIL_SEQ_bm_t TaskMask[UTIL_SEQ_TASK_WORD_NBR];
 
 /**
  * @brief super mask.
  */
-static UTIL_SEQ_bm_t SuperMask = UTIL_SEQ_ALL_BIT_SET;
+static UTIL_SEQ_bm_t SuperMask[UTIL_SEQ_TASK_WORD_NBR];
 
 /**
  * @brief evt set mask.
  */
-static volatile UTIL_SEQ_bm_t EvtSet = UTIL_SEQ_NO_BIT_SET;
+static volatile UTIL_SEQ_bm_t EvtSet[UTIL_SEQ_EVT_WORD_NBR];
 
 /**
  * @brief evt expected mask.
  */
 static volatile UTIL_SEQ_bm_t EvtWaited = UTIL_SEQ_NO_BIT_SET;
 
+/**
+ * @brief word of EvtSet the evt expected mask applies to.
+ */
+static volatile uint32_t EvtWaitedWord = 0U;
+
 /**
  * @brief current task id.
  */
@@ -158,6 +238,35 @@ static void (*TaskCb[UTIL_SEQ_CONF_TASK_NBR])( void );
  */
 static volatile UTIL_SEQ_Priority_t TaskPrio[UTIL_SEQ_CONF_PRIO_NBR];
 
+#if (UTIL_SEQ_CONF_STATISTICS == 1)
+/**
+ * @brief task runtime statistics.
+ */
+static UTIL_SEQ_TaskStats_t TaskStats[UTIL_SEQ_CONF_TASK_NBR];
+
+/**
+ * @brief timestamp of the first UTIL_SEQ_SetTask() of a pending task.
+ */
+static uint32_t TaskSetTime[UTIL_SEQ_CONF_TASK_NBR];
+#endif
+
+#if (UTIL_SEQ_CONF_EDF == 1)
+/**
+ * @brief set of the pending tasks that have a deadline.
+ */
+static volatile UTIL_SEQ_TaskList_t DeadlineSet;
+
+/**
+ * @brief deadline of the pending tasks.
+ */
+static volatile uint32_t TaskDeadline[UTIL_SEQ_CONF_TASK_NBR];
+
+/**
+ * @brief number of tasks executed after their deadline.
+ */
+static volatile uint32_t DeadlineMissCount;
+#endif
+
 /**
  * @}
  */
@@ -167,6 +276,16 @@ static volatile UTIL_SEQ_Priority_t TaskPrio[UTIL_SEQ_CONF_PRIO_NBR];
  *  @{
  */
 uint8_t SEQ_BitPosition(uint32_t Value);
+static uint32_t SEQ_IsTaskPending(void);
+static uint32_t SEQ_SelectTask(uint32_t Prio, uint32_t *TaskIdx);
+static void SEQ_SetTask(uint32_t WordIdx, UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio);
+static void SEQ_WaitEvt(uint32_t WordIdx, UTIL_SEQ_bm_t EvtId_bm);
+#if (UTIL_SEQ_CONF_STATISTICS == 1)
+static void SEQ_StatsSetTask(uint32_t WordIdx, UTIL_SEQ_bm_t TaskId_bm);
+#endif
+#if (UTIL_SEQ_CONF_EDF == 1)
+static uint32_t SEQ_SelectDeadlineTask(uint32_t *TaskIdx);
+#endif
 
 /**
  * @}
@@ -179,18 +298,22 @@ uint8_t SEQ_BitPosition(uint32_t Value);
  */
 void UTIL_SEQ_Init( void )
 {
-  TaskSet = UTIL_SEQ_NO_BIT_SET;
-  TaskMask = UTIL_SEQ_ALL_BIT_SET;
-  SuperMask = UTIL_SEQ_ALL_BIT_SET;
-  EvtSet = UTIL_SEQ_NO_BIT_SET;
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)&TaskSet, 0, sizeof(TaskSet));
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskMask, 0xFF, sizeof(TaskMask));
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)SuperMask, 0xFF, sizeof(SuperMask));
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)EvtSet, 0, sizeof(EvtSet));
   EvtWaited = UTIL_SEQ_NO_BIT_SET;
+  EvtWaitedWord = 0U;
   CurrentTaskIdx = 0U;
   (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskCb, 0, sizeof(TaskCb));
-  for(uint32_t index = 0; index < UTIL_SEQ_CONF_PRIO_NBR; index++)
-  {
-      TaskPrio[index].priority = 0;
-      TaskPrio[index].round_robin = 0;
-  }
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskPrio, 0, sizeof(TaskPrio));
+#if (UTIL_SEQ_CONF_STATISTICS == 1)
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskStats, 0, sizeof(TaskStats));
+#endif
+#if (UTIL_SEQ_CONF_EDF == 1)
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)&DeadlineSet, 0, sizeof(DeadlineSet));
+  DeadlineMissCount = 0U;
+#endif
   UTIL_SEQ_INIT_CRITICAL_SECTION( );
 }
 
@@ -207,20 +330,33 @@ void UTIL_SEQ_DeInit( void )
 void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
 {
   uint32_t counter;
-  UTIL_SEQ_bm_t current_task_set;
-  UTIL_SEQ_bm_t super_mask_backup;
-  UTIL_SEQ_bm_t local_taskset;
-  UTIL_SEQ_bm_t local_evtset;
-  UTIL_SEQ_bm_t local_taskmask;
-  UTIL_SEQ_bm_t local_evtwaited;
+  uint32_t word_idx;
+  UTIL_SEQ_bm_t task_bm;
+  UTIL_SEQ_bm_t super_mask_backup[UTIL_SEQ_TASK_WORD_NBR];
+#if (UTIL_SEQ_CONF_STATISTICS == 1)
+  uint32_t start_time;
+  uint32_t elapsed_time;
+#endif
+  uint32_t task_idx = 0U;
 
   /*
    * When this function is nested, the mask to be applied cannot be larger than the first call
    * The mask is always getting smaller and smaller
    * A copy is made of the mask set by UTIL_SEQ_Run() in case it is called again in the task
+   * Mask_bm applies to the tasks 0 to 31. The tasks above are only masked when Mask_bm is 0
    */
-  super_mask_backup = SuperMask;
-  SuperMask &= Mask_bm;
+  for (word_idx = 0U; word_idx < UTIL_SEQ_TASK_WORD_NBR; word_idx++)
+  {
+    super_mask_backup[word_idx] = SuperMask[word_idx];
+  }
+  SuperMask[0] &= Mask_bm;
+  if (Mask_bm == UTIL_SEQ_NO_BIT_SET)
+  {
+    for (word_idx = 1U; word_idx < UTIL_SEQ_TASK_WORD_NBR; word_idx++)
+    {
+      SuperMask[word_idx] = UTIL_SEQ_NO_BIT_SET;
+    }
+  }
 
   /*
    * There are two independent mask to check:
@@ -229,70 +365,96 @@ void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
    * If the waited event is there, exit from  UTIL_SEQ_Run() to return to the
    * waiting task
    */
-  local_taskset = TaskSet;
-  local_evtset = EvtSet;
-  local_taskmask = TaskMask;
-  local_evtwaited =  EvtWaited;
-  while(((local_taskset & local_taskmask & SuperMask) != 0U) && ((local_evtset & local_evtwaited)==0U))
+  while((SEQ_IsTaskPending() != 0U) && (UTIL_SEQ_IsEvtPend() == 0U))
   {
-    counter = 0U;
+#if (UTIL_SEQ_CONF_EDF == 1)
     /*
-     * When a flag is set, the associated bit is set in TaskPrio[counter].priority mask depending
-     * on the priority parameter given from UTIL_SEQ_SetTask()
-     * The while loop is looking for a flag set from the highest priority maskr to the lower
+     * The tasks with a deadline are executed first, the nearest deadline first.
+     * The priority levels are only evaluated when there is no such task.
      */
-    while((TaskPrio[counter].priority & local_taskmask & SuperMask)== 0U)
+    if(SEQ_SelectDeadlineTask(&task_idx) == 0U)
+#endif
     {
-      counter++;
+      counter = 0U;
+      /*
+       * When a flag is set, the associated bit is set in TaskPrio[counter].priority mask depending
+       * on the priority parameter given from UTIL_SEQ_SetTask()
+       * The while loop is looking for a flag set from the highest priority maskr to the lower
+       * Once the index is read, the associated task will be executed even though a higher priority stack is requested
+       * before task execution.
+       */
+      while(SEQ_SelectTask(counter, &task_idx) == 0U)
+      {
+        counter++;
+      }
+
+      /*
+       * remove from the roun_robin mask the task that has been selected to be executed
+       */
+      TaskPrio[counter].round_robin[UTIL_SEQ_ID_WORD(task_idx)] &= ~UTIL_SEQ_ID_BIT(task_idx);
     }
+    CurrentTaskIdx = task_idx;
+    word_idx = UTIL_SEQ_ID_WORD(task_idx);
+    task_bm = UTIL_SEQ_ID_BIT(task_idx);
 
-    current_task_set = TaskPrio[counter].priority & local_taskmask & SuperMask;
-
-    /*
-     * The round_robin register is a mask of allowed flags to be evaluated.
-     * The concept is to make sure that on each round on UTIL_SEQ_Run(), if two same flags are always set,
-     * the sequencer does not run always only the first one.
-     * When a task has been executed, The flag is removed from the round_robin mask.
-     * If on the next UTIL_SEQ_RUN(), the two same flags are set again, the round_robin mask will mask out the first flag
-     * so that the second one can be executed.
-     * Note that the first flag is not removed from the list of pending task but just masked by the round_robin mask
-     *
-     * In the check below, the round_robin mask is reinitialize in case all pending tasks haven been executed at least once
-     */
-    if ((TaskPrio[counter].round_robin & current_task_set) == 0U)
+    UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+#if (UTIL_SEQ_CONF_EDF == 1)
+    if ((DeadlineSet.word[word_idx] & task_bm) != 0U)
     {
-      TaskPrio[counter].round_robin = UTIL_SEQ_ALL_BIT_SET;
+      if ((int32_t)(UTIL_SEQ_GET_TICK( ) - TaskDeadline[task_idx]) > 0)
+      {
+        DeadlineMissCount++;
+      }
+      DeadlineSet.word[word_idx] &= ~task_bm;
+      if (DeadlineSet.word[word_idx] == UTIL_SEQ_NO_BIT_SET)
+      {
+        DeadlineSet.summary &= ~(1U << word_idx);
+      }
     }
-
-  /*
-   * Read the flag index of the task to be executed
-	 * Once the index is read, the associated task will be executed even though a higher priority stack is requested
-	 * before task execution.
-	 */
-    CurrentTaskIdx = (SEQ_BitPosition(current_task_set & TaskPrio[counter].round_robin));
-
-    /*
-     * remove from the roun_robin mask the task that has been selected to be executed
-     */
-    TaskPrio[counter].round_robin &= ~(1U << CurrentTaskIdx);
-
-    UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+#endif
     /* remove from the list or pending task the one that has been selected to be executed */
-    TaskSet &= ~(1U << CurrentTaskIdx);
+    TaskSet.word[word_idx] &= ~task_bm;
+    if (TaskSet.word[word_idx] == UTIL_SEQ_NO_BIT_SET)
+    {
+      TaskSet.summary &= ~(1U << word_idx);
+    }
     /* remove from all priority mask the task that has been selected to be executed */
     for (counter = UTIL_SEQ_CONF_PRIO_NBR; counter != 0U; counter--)
     {
-      TaskPrio[counter - 1U].priority &= ~(1U << CurrentTaskIdx);
+      TaskPrio[counter - 1U].priority.word[word_idx] &= ~task_bm;
+      if (TaskPrio[counter - 1U].priority.word[word_idx] == UTIL_SEQ_NO_BIT_SET)
+      {
+        TaskPrio[counter - 1U].priority.summary &= ~(1U << word_idx);
+      }
     }
     UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
+#if (UTIL_SEQ_CONF_STATISTICS == 1)
+    /*
+     * CurrentTaskIdx is kept in a local as it may be overwritten by a nested UTIL_SEQ_Run().
+     * The execution time of a task includes the time spent in the nested tasks.
+     */
+    start_time = UTIL_SEQ_GET_CYCLE_COUNT( );
+    elapsed_time = start_time - TaskSetTime[task_idx];
+    if (elapsed_time > TaskStats[task_idx].pend_time_max)
+    {
+      TaskStats[task_idx].pend_time_max = elapsed_time;
+    }
+
     /* Execute the task */
-    TaskCb[CurrentTaskIdx]( );
+    TaskCb[task_idx]( );
 
-    local_taskset = TaskSet;
-    local_evtset = EvtSet;
-    local_taskmask = TaskMask;
-    local_evtwaited = EvtWaited;
+    elapsed_time = UTIL_SEQ_GET_CYCLE_COUNT( ) - start_time;
+    TaskStats[task_idx].count++;
+    TaskStats[task_idx].exec_time += elapsed_time;
+    if (elapsed_time > TaskStats[task_idx].exec_time_max)
+    {
+      TaskStats[task_idx].exec_time_max = elapsed_time;
+    }
+#else
+    /* Execute the task */
+    TaskCb[task_idx]( );
+#endif
   }
 
   /* the set of CurrentTaskIdx to no task running allows to call WaitEvt in the Pre/Post ilde context */
@@ -300,12 +462,9 @@ void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
   UTIL_SEQ_PreIdle( );
 
   UTIL_SEQ_ENTER_CRITICAL_SECTION_IDLE( );
-  local_taskset = TaskSet;
-  local_evtset = EvtSet;
-  local_taskmask = TaskMask;
-  if ((local_taskset & local_taskmask & SuperMask) == 0U)
+  if (SEQ_IsTaskPending() == 0U)
   {
-    if ((local_evtset & EvtWaited)== 0U)
+    if (UTIL_SEQ_IsEvtPend() == 0U)
     {
       UTIL_SEQ_Idle( );
     }
@@ -315,17 +474,27 @@ void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
   UTIL_SEQ_PostIdle( );
 
   /* restore the mask from UTIL_SEQ_Run() */
-  SuperMask = super_mask_backup;
+  for (word_idx = 0U; word_idx < UTIL_SEQ_TASK_WORD_NBR; word_idx++)
+  {
+    SuperMask[word_idx] = super_mask_backup[word_idx];
+  }
 
   return;
 }
 
 void UTIL_SEQ_RegTask(UTIL_SEQ_bm_t TaskId_bm, uint32_t Flags, void (*Task)( void ))
+{
+  UTIL_SEQ_RegTaskId(SEQ_BitPosition(TaskId_bm), Flags, Task);
+
+  return;
+}
+
+void UTIL_SEQ_RegTaskId(uint32_t TaskId, uint32_t Flags, void (*Task)( void ))
 {
   (void)Flags;
   UTIL_SEQ_ENTER_CRITICAL_SECTION();
 
-  TaskCb[SEQ_BitPosition(TaskId_bm)] = Task;
+  TaskCb[TaskId] = Task;
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION();
 
@@ -334,15 +503,54 @@ void UTIL_SEQ_RegTask(UTIL_SEQ_bm_t TaskId_bm, uint32_t Flags, void (*Task)( voi
 
 void UTIL_SEQ_SetTask( UTIL_SEQ_bm_t TaskId_bm , uint32_t Task_Prio )
 {
+  SEQ_SetTask(0U, TaskId_bm, Task_Prio);
+
+  return;
+}
+
+void UTIL_SEQ_SetTaskId( uint32_t TaskId , uint32_t Task_Prio )
+{
+  SEQ_SetTask(UTIL_SEQ_ID_WORD(TaskId), UTIL_SEQ_ID_BIT(TaskId), Task_Prio);
+
+  return;
+}
+
+#if (UTIL_SEQ_CONF_EDF == 1)
+void UTIL_SEQ_SetTaskDeadline( uint32_t TaskId , uint32_t Task_Prio, uint32_t Deadline )
+{
+  uint32_t word_idx = UTIL_SEQ_ID_WORD(TaskId);
+  UTIL_SEQ_bm_t task_bm = UTIL_SEQ_ID_BIT(TaskId);
+
   UTIL_SEQ_ENTER_CRITICAL_SECTION( );
 
-  TaskSet |= TaskId_bm;
-  TaskPrio[Task_Prio].priority |= TaskId_bm;
+  /* When the task is already pending with a deadline, the nearest one is kept */
+  if (((DeadlineSet.word[word_idx] & task_bm) == 0U)
+   || ((int32_t)(Deadline - TaskDeadline[TaskId]) < 0))
+  {
+    TaskDeadline[TaskId] = Deadline;
+  }
+  DeadlineSet.word[word_idx] |= task_bm;
+  DeadlineSet.summary |= (1U << word_idx);
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
+  SEQ_SetTask(word_idx, task_bm, Task_Prio);
+
+  return;
+}
+
+uint32_t UTIL_SEQ_GetDeadlineMiss( void )
+{
+  return DeadlineMissCount;
+}
+
+void UTIL_SEQ_ResetDeadlineMiss( void )
+{
+  DeadlineMissCount = 0U;
+
   return;
 }
+#endif
 
 uint32_t UTIL_SEQ_IsSchedulableTask( UTIL_SEQ_bm_t TaskId_bm)
 {
@@ -351,8 +559,23 @@ uint32_t UTIL_SEQ_IsSchedulableTask( UTIL_SEQ_bm_t TaskId_bm)
 
   UTIL_SEQ_ENTER_CRITICAL_SECTION();
 
-  local_taskset = TaskSet;
-  _status = ((local_taskset & TaskMask & SuperMask & TaskId_bm) == TaskId_bm)? 1U: 0U;
+  local_taskset = TaskSet.word[0];
+  _status = ((local_taskset & TaskMask[0] & SuperMask[0] & TaskId_bm) == TaskId_bm)? 1U: 0U;
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION();
+  return _status;
+}
+
+uint32_t UTIL_SEQ_IsSchedulableTaskId( uint32_t TaskId )
+{
+  uint32_t _status;
+  uint32_t word_idx = UTIL_SEQ_ID_WORD(TaskId);
+  UTIL_SEQ_bm_t local_taskset;
+
+  UTIL_SEQ_ENTER_CRITICAL_SECTION();
+
+  local_taskset = TaskSet.word[word_idx];
+  _status = ((local_taskset & TaskMask[word_idx] & SuperMask[word_idx] & UTIL_SEQ_ID_BIT(TaskId)) != 0U)? 1U: 0U;
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION();
   return _status;
@@ -362,7 +585,18 @@ void UTIL_SEQ_PauseTask( UTIL_SEQ_bm_t TaskId_bm )
 {
   UTIL_SEQ_ENTER_CRITICAL_SECTION( );
 
-  TaskMask &= (~TaskId_bm);
+  TaskMask[0] &= (~TaskId_bm);
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return;
+}
+
+void UTIL_SEQ_PauseTaskId( uint32_t TaskId )
+{
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  TaskMask[UTIL_SEQ_ID_WORD(TaskId)] &= (~UTIL_SEQ_ID_BIT(TaskId));
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
@@ -374,7 +608,18 @@ uint32_t UTIL_SEQ_IsPauseTask( UTIL_SEQ_bm_t TaskId_bm )
   uint32_t _status;
   UTIL_SEQ_ENTER_CRITICAL_SECTION( );
 
-  _status = ((TaskMask & TaskId_bm) == TaskId_bm) ? 0u:1u;
+  _status = ((TaskMask[0] & TaskId_bm) == TaskId_bm) ? 0u:1u;
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+  return _status;
+}
+
+uint32_t UTIL_SEQ_IsPauseTaskId( uint32_t TaskId )
+{
+  uint32_t _status;
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  _status = ((TaskMask[UTIL_SEQ_ID_WORD(TaskId)] & UTIL_SEQ_ID_BIT(TaskId)) != 0U) ? 0u:1u;
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
   return _status;
@@ -384,7 +629,18 @@ void UTIL_SEQ_ResumeTask( UTIL_SEQ_bm_t TaskId_bm )
 {
   UTIL_SEQ_ENTER_CRITICAL_SECTION( );
 
-  TaskMask |= TaskId_bm;
+  TaskMask[0] |= TaskId_bm;
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return;
+}
+
+void UTIL_SEQ_ResumeTaskId( uint32_t TaskId )
+{
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  TaskMask[UTIL_SEQ_ID_WORD(TaskId)] |= UTIL_SEQ_ID_BIT(TaskId);
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
@@ -395,7 +651,18 @@ void UTIL_SEQ_SetEvt( UTIL_SEQ_bm_t EvtId_bm )
 {
   UTIL_SEQ_ENTER_CRITICAL_SECTION( );
 
-  EvtSet |= EvtId_bm;
+  EvtSet[0] |= EvtId_bm;
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return;
+}
+
+void UTIL_SEQ_SetEvtId( uint32_t EvtId )
+{
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  EvtSet[UTIL_SEQ_ID_WORD(EvtId)] |= UTIL_SEQ_ID_BIT(EvtId);
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
@@ -406,7 +673,18 @@ void UTIL_SEQ_ClrEvt( UTIL_SEQ_bm_t EvtId_bm )
 {
   UTIL_SEQ_ENTER_CRITICAL_SECTION( );
 
-  EvtSet &= (~EvtId_bm);
+  EvtSet[0] &= (~EvtId_bm);
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return;
+}
+
+void UTIL_SEQ_ClrEvtId( uint32_t EvtId )
+{
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  EvtSet[UTIL_SEQ_ID_WORD(EvtId)] &= (~UTIL_SEQ_ID_BIT(EvtId));
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
@@ -414,10 +692,257 @@ void UTIL_SEQ_ClrEvt( UTIL_SEQ_bm_t EvtId_bm )
 }
 
 void UTIL_SEQ_WaitEvt(UTIL_SEQ_bm_t EvtId_bm)
+{
+  SEQ_WaitEvt(0U, EvtId_bm);
+
+  return;
+}
+
+void UTIL_SEQ_WaitEvtId(uint32_t EvtId)
+{
+  SEQ_WaitEvt(UTIL_SEQ_ID_WORD(EvtId), UTIL_SEQ_ID_BIT(EvtId));
+
+  return;
+}
+
+UTIL_SEQ_bm_t UTIL_SEQ_IsEvtPend( void )
+{
+  UTIL_SEQ_bm_t local_evtwaited = EvtWaited;
+  return (EvtSet[EvtWaitedWord] & local_evtwaited);
+}
+
+__WEAK void UTIL_SEQ_EvtIdle( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_bm_t EvtWaited_bm )
+{
+  (void)EvtWaited_bm;
+  UTIL_SEQ_Run(~TaskId_bm);
+  return;
+}
+
+__WEAK void UTIL_SEQ_Idle( void )
+{
+  return;
+}
+
+__WEAK void UTIL_SEQ_PreIdle( void )
+{
+  /*
+   * Unless specified by the application, there is nothing to be done
+   */
+  return;
+}
+
+__WEAK void UTIL_SEQ_PostIdle( void )
+{
+  /*
+   * Unless specified by the application, there is nothing to be done
+   */
+  return;
+}
+
+#if (UTIL_SEQ_CONF_STATISTICS == 1)
+void UTIL_SEQ_GetStatistics( UTIL_SEQ_TaskStats_t *Stats, uint32_t TaskNbr )
+{
+  uint32_t nbr = (TaskNbr < UTIL_SEQ_CONF_TASK_NBR) ? TaskNbr : UTIL_SEQ_CONF_TASK_NBR;
+
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  for (uint32_t index = 0; index < nbr; index++)
+  {
+    Stats[index] = TaskStats[index];
+  }
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return;
+}
+
+void UTIL_SEQ_ResetStatistics( void )
+{
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskStats, 0, sizeof(TaskStats));
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return;
+}
+#endif
+
+/**
+  * @}
+  */
+
+/** @addtogroup SEQUENCER_Private_function
+ *  @{
+ */
+
+/**
+ * @brief check whether a task is pending and allowed by both TaskMask and SuperMask
+ * @retval 0 when no task can be executed
+ */
+static uint32_t SEQ_IsTaskPending(void)
+{
+  uint32_t summary = TaskSet.summary;
+  uint32_t word_idx;
+
+  while (summary != 0U)
+  {
+    word_idx = SEQ_BitPosition(summary);
+    if ((TaskSet.word[word_idx] & TaskMask[word_idx] & SuperMask[word_idx]) != 0U)
+    {
+      return 1U;
+    }
+    summary &= ~(1U << word_idx);
+  }
+
+  return 0U;
+}
+
+/**
+ * @brief select the next task to be executed in a priority level
+ * @param Prio priority level
+ * @param TaskIdx id of the task selected
+ * @retval 0 when no task can be executed in this priority level
+ */
+static uint32_t SEQ_SelectTask(uint32_t Prio, uint32_t *TaskIdx)
+{
+  volatile UTIL_SEQ_Priority_t *prio = &TaskPrio[Prio];
+  uint32_t summary = prio->priority.summary;
+  uint32_t fallback_idx = UTIL_SEQ_NOTASKRUNNING;
+  uint32_t word_idx;
+  UTIL_SEQ_bm_t current_task_set;
+
+  /*
+   * The round_robin register is a mask of allowed flags to be evaluated.
+   * The concept is to make sure that on each round on UTIL_SEQ_Run(), if two same flags are always set,
+   * the sequencer does not run always only the first one.
+   * When a task has been executed, The flag is removed from the round_robin mask.
+   * If on the next UTIL_SEQ_RUN(), the two same flags are set again, the round_robin mask will mask out the first flag
+   * so that the second one can be executed.
+   * Note that the first flag is not removed from the list of pending task but just masked by the round_robin mask
+   *
+   * The words are evaluated from the highest task id to the lowest one.
+   */
+  while (summary != 0U)
+  {
+    word_idx = SEQ_BitPosition(summary);
+    summary &= ~(1U << word_idx);
+
+    current_task_set = prio->priority.word[word_idx] & TaskMask[word_idx] & SuperMask[word_idx];
+    if (current_task_set != 0U)
+    {
+      if ((prio->round_robin[word_idx] & current_task_set) != 0U)
+      {
+        *TaskIdx = (word_idx << 5U) + SEQ_BitPosition(current_task_set & prio->round_robin[word_idx]);
+        return 1U;
+      }
+      if (fallback_idx == UTIL_SEQ_NOTASKRUNNING)
+      {
+        fallback_idx = (word_idx << 5U) + SEQ_BitPosition(current_task_set);
+      }
+    }
+  }
+
+  if (fallback_idx == UTIL_SEQ_NOTASKRUNNING)
+  {
+    return 0U;
+  }
+
+  /*
+   * The round_robin mask is reinitialize in case all pending tasks haven been executed at least once
+   */
+  for (word_idx = 0U; word_idx < UTIL_SEQ_TASK_WORD_NBR; word_idx++)
+  {
+    prio->round_robin[word_idx] = UTIL_SEQ_ALL_BIT_SET;
+  }
+  *TaskIdx = fallback_idx;
+
+  return 1U;
+}
+
+#if (UTIL_SEQ_CONF_EDF == 1)
+/**
+ * @brief select the pending task with the nearest deadline
+ * @note  the deadlines are compared relatively to the current tick so that the wrap around
+ *        of the tick is supported as long as the deadlines are less than 2^31 ticks away
+ * @param TaskIdx id of the task selected
+ * @retval 0 when no task with a deadline can be executed
+ */
+static uint32_t SEQ_SelectDeadlineTask(uint32_t *TaskIdx)
+{
+  uint32_t summary = DeadlineSet.summary;
+  uint32_t now = UTIL_SEQ_GET_TICK( );
+  uint32_t selected_idx = UTIL_SEQ_NOTASKRUNNING;
+  int32_t selected_delay = 0;
+  uint32_t word_idx;
+  uint32_t task_idx;
+  int32_t delay;
+  UTIL_SEQ_bm_t current_task_set;
+
+  while (summary != 0U)
+  {
+    word_idx = SEQ_BitPosition(summary);
+    summary &= ~(1U << word_idx);
+
+    current_task_set = DeadlineSet.word[word_idx] & TaskMask[word_idx] & SuperMask[word_idx];
+    while (current_task_set != 0U)
+    {
+      task_idx = SEQ_BitPosition(current_task_set);
+      current_task_set &= ~(1U << task_idx);
+      task_idx += (word_idx << 5U);
+
+      delay = (int32_t)(TaskDeadline[task_idx] - now);
+      if ((selected_idx == UTIL_SEQ_NOTASKRUNNING) || (delay < selected_delay))
+      {
+        selected_idx = task_idx;
+        selected_delay = delay;
+      }
+    }
+  }
+
+  if (selected_idx == UTIL_SEQ_NOTASKRUNNING)
+  {
+    return 0U;
+  }
+
+  *TaskIdx = selected_idx;
+  return 1U;
+}
+#endif
+
+/**
+ * @brief request tasks of one word to be executed
+ * @param WordIdx word of the task list
+ * @param TaskId_bm bit mapping of the tasks inside the word
+ * @param Task_Prio The priority of the task
+ */
+static void SEQ_SetTask(uint32_t WordIdx, UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio)
+{
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  UTIL_SEQ_STATS_SET_TASK( WordIdx, TaskId_bm );
+  TaskSet.word[WordIdx] |= TaskId_bm;
+  TaskSet.summary |= (1U << WordIdx);
+  TaskPrio[Task_Prio].priority.word[WordIdx] |= TaskId_bm;
+  TaskPrio[Task_Prio].priority.summary |= (1U << WordIdx);
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+}
+
+/**
+ * @brief wait for an event of one word to be set
+ * @param WordIdx word of the event list
+ * @param EvtId_bm bit mapping of the event inside the word
+ */
+static void SEQ_WaitEvt(uint32_t WordIdx, UTIL_SEQ_bm_t EvtId_bm)
 {
   UTIL_SEQ_bm_t event_waited_id_backup;
-  UTIL_SEQ_bm_t current_task_idx;
+  uint32_t event_waited_word_backup;
+  uint32_t current_task_idx;
   UTIL_SEQ_bm_t wait_task_idx;
+#if (UTIL_SEQ_TASK_WORD_NBR > 1U)
+  UTIL_SEQ_bm_t super_mask_backup = UTIL_SEQ_ALL_BIT_SET;
+#endif
   /*
    * store in local the current_task_id_bm as the global variable CurrentTaskIdx
    * may be overwritten in case there are nested call of UTIL_SEQ_Run()
@@ -427,6 +952,18 @@ void UTIL_SEQ_WaitEvt(UTIL_SEQ_bm_t EvtId_bm)
   {
     wait_task_idx = 0u;
   }
+#if (UTIL_SEQ_TASK_WORD_NBR > 1U)
+  else if(current_task_idx >= 32U)
+  {
+    /*
+     * The task cannot be reported to UTIL_SEQ_EvtIdle() in a 32 bit mapping:
+     * it is directly removed from the SuperMask while waiting
+     */
+    wait_task_idx = 0u;
+    super_mask_backup = SuperMask[UTIL_SEQ_ID_WORD(current_task_idx)];
+    SuperMask[UTIL_SEQ_ID_WORD(current_task_idx)] &= ~UTIL_SEQ_ID_BIT(current_task_idx);
+  }
+#endif
   else
   {
     wait_task_idx = (uint32_t)1u << CurrentTaskIdx;
@@ -434,7 +971,9 @@ void UTIL_SEQ_WaitEvt(UTIL_SEQ_bm_t EvtId_bm)
 
   /* backup the event id that was currently waited */
   event_waited_id_backup = EvtWaited;
+  event_waited_word_backup = EvtWaitedWord;
   EvtWaited = EvtId_bm;
+  EvtWaitedWord = WordIdx;
   /*
    * wait for the new event
    * note: that means that if the previous waited event occurs, it will not exit
@@ -444,7 +983,7 @@ void UTIL_SEQ_WaitEvt(UTIL_SEQ_bm_t EvtId_bm)
    * It case it occurs while waiting for the second one, the while loop will exit immediately
    */
 
-  while ((EvtSet & EvtId_bm) == 0U)
+  while ((EvtSet[WordIdx] & EvtId_bm) == 0U)
   {
     UTIL_SEQ_EvtIdle(wait_task_idx, EvtId_bm);
   }
@@ -455,60 +994,57 @@ void UTIL_SEQ_WaitEvt(UTIL_SEQ_bm_t EvtId_bm)
    * in the call of UTIL_SEQ_EvtIdle()
    */
   CurrentTaskIdx = current_task_idx;
+#if (UTIL_SEQ_TASK_WORD_NBR > 1U)
+  if((current_task_idx != UTIL_SEQ_NOTASKRUNNING) && (current_task_idx >= 32U))
+  {
+    SuperMask[UTIL_SEQ_ID_WORD(current_task_idx)] = super_mask_backup;
+  }
+#endif
 
   UTIL_SEQ_ENTER_CRITICAL_SECTION( );
 
-  EvtSet &= (~EvtId_bm);
+  EvtSet[WordIdx] &= (~EvtId_bm);
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
   EvtWaited = event_waited_id_backup;
-  return;
+  EvtWaitedWord = event_waited_word_backup;
 }
 
-UTIL_SEQ_bm_t UTIL_SEQ_IsEvtPend( void )
-{
-  UTIL_SEQ_bm_t local_evtwaited = EvtWaited;
-  return (EvtSet & local_evtwaited);
-}
-
-__WEAK void UTIL_SEQ_EvtIdle( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_bm_t EvtWaited_bm )
-{
-  (void)EvtWaited_bm;
-  UTIL_SEQ_Run(~TaskId_bm);
-  return;
-}
-
-__WEAK void UTIL_SEQ_Idle( void )
-{
-  return;
-}
-
-__WEAK void UTIL_SEQ_PreIdle( void )
+#if (UTIL_SEQ_CONF_STATISTICS == 1)
+/**
+ * @brief timestamp the tasks that become pending
+ * @note  shall be called in critical section before TaskSet is updated. A task already
+ *        pending keeps the timestamp of its first request.
+ * @param WordIdx word of the task list
+ * @param TaskId_bm bit mapping of the tasks inside the word
+ */
+static void SEQ_StatsSetTask(uint32_t WordIdx, UTIL_SEQ_bm_t TaskId_bm)
 {
-  /*
-   * Unless specified by the application, there is nothing to be done
-   */
-  return;
-}
+  UTIL_SEQ_bm_t new_task = TaskId_bm & ~TaskSet.word[WordIdx];
+  uint32_t now = UTIL_SEQ_GET_CYCLE_COUNT( );
 
-__WEAK void UTIL_SEQ_PostIdle( void )
-{
-  /*
-   * Unless specified by the application, there is nothing to be done
-   */
-  return;
+  while (new_task != 0U)
+  {
+    uint32_t task_idx = SEQ_BitPosition(new_task);
+    TaskSetTime[(WordIdx << 5U) + task_idx] = now;
+    new_task &= ~(1U << task_idx);
+  }
 }
+#endif
 
+#if !defined(__CORTEX_M) && defined(__GNUC__)
 /**
-  * @}
-  */
-
-/** @addtogroup SEQUENCER_Private_function
- *  @{
+ * @brief return the position of the first bit set to 1
+ * @note  host build (no CMSIS core): rely on the compiler builtin
+ * @param Value 32 bit value
+ * @retval bit position
  */
-
-#if( __CORTEX_M == 0)
+uint8_t SEQ_BitPosition(uint32_t Value)
+{
+  return (uint8_t)(31 - __builtin_clz( Value ));
+}
+#elif( __CORTEX_M == 0)
 const uint8_t SEQ_clz_table_4bit[16U] = { 4U, 3U, 2U, 2U, 1U, 1U, 1U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U };
 /**
  * @brief return the position of the first bit set to 1
@@ -547,4 +1083,3 @@ uint8_t SEQ_BitPosition(uint32_t Value)
 /**
   * @}
   */
-
@@ -43,6 +43,19 @@ extern "C" {
 
 typedef uint32_t UTIL_SEQ_bm_t;
 
+/**
+ *  @brief  runtime statistics of one task.
+ *  All durations are expressed in units of UTIL_SEQ_GET_CYCLE_COUNT().
+ *  They are only maintained when UTIL_SEQ_CONF_STATISTICS is set to 1.
+ */
+typedef struct
+{
+  uint32_t count;          /*!< number of times the task has been executed                      */
+  uint64_t exec_time;      /*!< cumulated execution time                                         */
+  uint32_t exec_time_max;  /*!< longest execution time                                           */
+  uint32_t pend_time_max;  /*!< longest time between UTIL_SEQ_SetTask() and the task execution  */
+} UTIL_SEQ_TaskStats_t;
+
 /**
   * @}
  */
@@ -190,6 +203,7 @@ void UTIL_SEQ_PostIdle( void );
  *        This function should be called in a while loop in the application
  *
  * @param Mask_bm list of task (bit mapping) that is be kept in the sequencer list.
+ *        It applies to the tasks 0 to 31. The tasks above 31 are kept unless Mask_bm is 0.
  *
  * @note  It shall not be called from an ISR.
  * @note  The construction of the task must take into account the fact that there is no counting / protection
@@ -211,6 +225,19 @@ void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm );
  */
 void UTIL_SEQ_RegTask( UTIL_SEQ_bm_t TaskId_bm, uint32_t Flags, void (*Task)( void ) );
 
+/**
+ * @brief This function registers a task in the sequencer from its number.
+ *
+ * @param TaskId The number of the task, from 0 to UTIL_SEQ_CONF_TASK_NBR - 1
+ * @param Flags Flags are reserved param for future use
+ * @param Task Reference of the function to be executed
+ *
+ * @note  The tasks 0 to 31 may be managed either with this API or with the bit mapping API.
+ *        It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_RegTaskId( uint32_t TaskId, uint32_t Flags, void (*Task)( void ) );
+
 /**
  * @brief This function requests a task to be executed
  *
@@ -226,6 +253,51 @@ void UTIL_SEQ_RegTask( UTIL_SEQ_bm_t TaskId_bm, uint32_t Flags, void (*Task)( vo
  */
 void UTIL_SEQ_SetTask( UTIL_SEQ_bm_t TaskId_bm , uint32_t Task_Prio );
 
+/**
+ * @brief This function requests a task to be executed from its number
+ *
+ * @param TaskId The number of the task, from 0 to UTIL_SEQ_CONF_TASK_NBR - 1
+ * @param Task_Prio The priority of the task (see UTIL_SEQ_SetTask())
+ *
+ * @note   It may be called from an ISR
+ *
+ */
+void UTIL_SEQ_SetTaskId( uint32_t TaskId , uint32_t Task_Prio );
+
+/**
+ * @brief This function requests a task to be executed before a deadline
+ *
+ * @param TaskId The number of the task, from 0 to UTIL_SEQ_CONF_TASK_NBR - 1
+ * @param Task_Prio The priority of the task (see UTIL_SEQ_SetTask())
+ * @param Deadline The tick, as returned by UTIL_SEQ_GET_TICK(), before which the task shall be executed
+ *
+ * @note  The tasks with a deadline are executed before the other tasks, the nearest deadline first.
+ *        When the task is already pending with a deadline, the nearest deadline is kept.
+ *        A task executed after its deadline is counted in UTIL_SEQ_GetDeadlineMiss().
+ *        Only available when UTIL_SEQ_CONF_EDF is set to 1.
+ *        It may be called from an ISR
+ *
+ */
+void UTIL_SEQ_SetTaskDeadline( uint32_t TaskId , uint32_t Task_Prio, uint32_t Deadline );
+
+/**
+ * @brief This function returns the number of tasks executed after their deadline
+ *
+ * @note  Only available when UTIL_SEQ_CONF_EDF is set to 1.
+ *        It may be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_GetDeadlineMiss( void );
+
+/**
+ * @brief This function clears the number of tasks executed after their deadline
+ *
+ * @note  Only available when UTIL_SEQ_CONF_EDF is set to 1.
+ *        It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_ResetDeadlineMiss( void );
+
 /**
  * @brief This function checks if a task could be scheduled.
  *
@@ -238,6 +310,17 @@ void UTIL_SEQ_SetTask( UTIL_SEQ_bm_t TaskId_bm , uint32_t Task_Prio );
  */
 uint32_t UTIL_SEQ_IsSchedulableTask( UTIL_SEQ_bm_t TaskId_bm);
 
+/**
+ * @brief This function checks if a task could be scheduled from its number.
+ *
+ * @param TaskId The number of the task, from 0 to UTIL_SEQ_CONF_TASK_NBR - 1
+ * @retval 0 if not 1 if true
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_IsSchedulableTaskId( uint32_t TaskId );
+
 /**
  * @brief This function prevents a task to be called by the sequencer even when set with UTIL_SEQ_SetTask()
  *        By default, all tasks are executed by the sequencer when set with UTIL_SEQ_SetTask()
@@ -251,6 +334,16 @@ uint32_t UTIL_SEQ_IsSchedulableTask( UTIL_SEQ_bm_t TaskId_bm);
  */
 void UTIL_SEQ_PauseTask( UTIL_SEQ_bm_t TaskId_bm );
 
+/**
+ * @brief This function pauses a task from its number (see UTIL_SEQ_PauseTask())
+ *
+ * @param TaskId The number of the task, from 0 to UTIL_SEQ_CONF_TASK_NBR - 1
+ *
+ * @note  It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_PauseTaskId( uint32_t TaskId );
+
 /**
  * @brief This function allows to know if the task has been put in pause.
  *        By default, all tasks are executed by the sequencer when set with UTIL_SEQ_SetTask()
@@ -264,6 +357,16 @@ void UTIL_SEQ_PauseTask( UTIL_SEQ_bm_t TaskId_bm );
  */
 uint32_t UTIL_SEQ_IsPauseTask( UTIL_SEQ_bm_t TaskId_bm );
 
+/**
+ * @brief This function allows to know if the task has been put in pause from its number.
+ *
+ * @param TaskId The number of the task, from 0 to UTIL_SEQ_CONF_TASK_NBR - 1
+ *
+ * @note  It may be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_IsPauseTaskId( uint32_t TaskId );
+
 /**
  * @brief This function allows again a task to be called by the sequencer if set with UTIL_SEQ_SetTask()
  *        This is used in relation with UTIL_SEQ_PauseTask()
@@ -276,6 +379,16 @@ uint32_t UTIL_SEQ_IsPauseTask( UTIL_SEQ_bm_t TaskId_bm );
  */
 void UTIL_SEQ_ResumeTask( UTIL_SEQ_bm_t TaskId_bm );
 
+/**
+ * @brief This function resumes a task from its number (see UTIL_SEQ_ResumeTask())
+ *
+ * @param TaskId The number of the task, from 0 to UTIL_SEQ_CONF_TASK_NBR - 1
+ *
+ * @note  It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_ResumeTaskId( uint32_t TaskId );
+
 /**
  * @brief This function sets an event that is waited with UTIL_SEQ_WaitEvt()
  *
@@ -287,6 +400,16 @@ void UTIL_SEQ_ResumeTask( UTIL_SEQ_bm_t TaskId_bm );
  */
 void UTIL_SEQ_SetEvt( UTIL_SEQ_bm_t EvtId_bm );
 
+/**
+ * @brief This function sets an event from its number that is waited with UTIL_SEQ_WaitEvtId()
+ *
+ * @param EvtId The number of the event, from 0 to UTIL_SEQ_CONF_EVT_NBR - 1
+ *
+ * @note  It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_SetEvtId( uint32_t EvtId );
+
 /**
  * @brief This function may be used to clear the event before calling UTIL_SEQ_WaitEvt()
  *        This API may be useful when the UTIL_SEQ_SetEvt() is called several time to notify the same event.
@@ -300,6 +423,16 @@ void UTIL_SEQ_SetEvt( UTIL_SEQ_bm_t EvtId_bm );
  */
 void UTIL_SEQ_ClrEvt( UTIL_SEQ_bm_t EvtId_bm );
 
+/**
+ * @brief This function clears an event from its number (see UTIL_SEQ_ClrEvt())
+ *
+ * @param EvtId The number of the event, from 0 to UTIL_SEQ_CONF_EVT_NBR - 1
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_ClrEvtId( uint32_t EvtId );
+
 /**
  * @brief This function waits for a specific event to be set. The sequencer loops UTIL_SEQ_EvtIdle() until the event is set
  *        When called recursively, it acts as a First in / Last out mechanism. The sequencer waits for the
@@ -315,6 +448,17 @@ void UTIL_SEQ_ClrEvt( UTIL_SEQ_bm_t EvtId_bm );
  */
 void UTIL_SEQ_WaitEvt( UTIL_SEQ_bm_t EvtId_bm );
 
+/**
+ * @brief This function waits for an event from its number (see UTIL_SEQ_WaitEvt())
+ *
+ * @param EvtId The number of the event, from 0 to UTIL_SEQ_CONF_EVT_NBR - 1
+ *
+ * @note  It shall not be called from an ISR.
+ * @note  When called from a task above 31, UTIL_SEQ_EvtIdle() receives 0 as TaskId_bm and the waiting
+ *        task is kept out of the scheduling by the sequencer itself.
+ */
+void UTIL_SEQ_WaitEvtId( uint32_t EvtId );
+
 /**
  * @brief This function returns whether the waited event is pending or not
  *        It is useful only when the UTIL_SEQ_EvtIdle() is overloaded by the application. In that case, when the low
@@ -322,6 +466,7 @@ void UTIL_SEQ_WaitEvt( UTIL_SEQ_bm_t EvtId_bm );
  *        or not. Both the event checking and the low power mode processing should be done in critical section
  *
  * @retval 0 when the waited event is not there or the evt_id when the waited event is pending
+ *         For an event above 31, the value is the bit mapping of the event inside its 32 bit word
  *
  * @note   It may be called from an ISR.
  *
@@ -344,6 +489,27 @@ UTIL_SEQ_bm_t UTIL_SEQ_IsEvtPend( void );
  */
 void UTIL_SEQ_EvtIdle( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_bm_t EvtWaited_bm );
 
+/**
+ * @brief This function returns a snapshot of the runtime statistics of the tasks
+ *
+ * @param Stats array filled with the statistics of each task, indexed by task id
+ * @param TaskNbr number of entries in Stats. Only the first UTIL_SEQ_CONF_TASK_NBR entries are filled.
+ *
+ * @note  Only available when UTIL_SEQ_CONF_STATISTICS is set to 1.
+ *        It shall not be called from an ISR.
+ *
+ */
+void UTIL_SEQ_GetStatistics( UTIL_SEQ_TaskStats_t *Stats, uint32_t TaskNbr );
+
+/**
+ * @brief This function clears the runtime statistics of all tasks
+ *
+ * @note  Only available when UTIL_SEQ_CONF_STATISTICS is set to 1.
+ *        It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_ResetStatistics( void );
+
 /**
   * @}
  */
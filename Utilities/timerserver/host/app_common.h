@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ * @file    app_common.h
+ * @author  MCD Application Team
+ * @brief   Stand-in of the application common header for the Linux host build
+ *          of the timer server
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Only the definitions used by hw_timerserver.c are provided. The hardware
+ * interface is the hw_if.h of the application, built over the RTC model of
+ * rtc_host.h. This directory shall be first in the include path.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __APP_COMMON_H
+#define __APP_COMMON_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hw_conf.h"
+#include "rtc_host.h"
+#include "hw_if.h"
+
+#undef FALSE
+#define FALSE                   0
+
+#undef TRUE
+#define TRUE                    (!0)
+
+#define PLACE_IN_SECTION( __x__ )  __attribute__((section (__x__)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__APP_COMMON_H */
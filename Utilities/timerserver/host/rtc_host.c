@@ -0,0 +1,270 @@
+/**
+ ******************************************************************************
+ * @file    rtc_host.c
+ * @author  MCD Application Team
+ * @brief   Model of the RTC wakeup timer, of the NVIC and of the PRIMASK for
+ *          the Linux host build of the timer server
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <time.h>
+
+#include "app_common.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define HOST_RTC_PREDIV_A               (15U)
+#define HOST_RTC_PREDIV_S               (0x7FFFU)
+
+/* Private variables ---------------------------------------------------------*/
+RTC_TypeDef HOST_Rtc;
+EXTI_TypeDef HOST_Exti;
+RTC_HandleTypeDef hrtc = { .Instance = RTC };
+
+static uint64_t Now;
+static uint64_t WakeupTimerNext;
+static uint8_t WakeupTimerFlag;
+static uint8_t NvicEnabled;
+static uint8_t NvicPending;
+static uint32_t Primask;
+static uint8_t InHandler;
+static uint32_t WakeupIrqCount;
+static HOST_MaskStat_t MaskStat;
+static struct timespec MaskStart;
+
+/* Private function prototypes -----------------------------------------------*/
+static void HOST_RTC_UpdateSsr( void );
+static void HOST_RTC_ServeIrq( void );
+
+/* Functions Definition ------------------------------------------------------*/
+void HOST_RTC_Init( void )
+{
+  memset(&HOST_Rtc, 0, sizeof(HOST_Rtc));
+  memset(&HOST_Exti, 0, sizeof(HOST_Exti));
+  HOST_Rtc.PRER = (HOST_RTC_PREDIV_A << 16) | HOST_RTC_PREDIV_S;
+  Now = 0;
+  WakeupTimerFlag = 0;
+  NvicEnabled = 0;
+  NvicPending = 0;
+  Primask = 0;
+  InHandler = 0;
+  WakeupIrqCount = 0;
+  HOST_RTC_UpdateSsr();
+
+  return;
+}
+
+/**
+ * @brief Advance the time, the wakeup timer interrupts are taken on their expiry
+ */
+void HOST_RTC_Advance( uint64_t Ticks )
+{
+  uint64_t target = Now + Ticks;
+
+  while(((HOST_Rtc.CR & RTC_CR_WUTE) != 0) && (WakeupTimerNext <= target))
+  {
+    Now = WakeupTimerNext;
+    HOST_RTC_UpdateSsr();
+
+    /* The wakeup timer reloads and keeps on counting until it is disabled */
+    WakeupTimerNext += (uint64_t)(HOST_Rtc.WUTR & RTC_WUTR_WUT) + 1;
+    WakeupTimerFlag = 1;
+    NvicPending = 1;
+    WakeupIrqCount++;
+    HOST_RTC_ServeIrq();
+  }
+
+  Now = target;
+  HOST_RTC_UpdateSsr();
+  HOST_RTC_ServeIrq();
+
+  return;
+}
+
+uint64_t HOST_RTC_Now( void )
+{
+  return Now;
+}
+
+/**
+ * @brief Number of wakeup timer expiries, each one wakes up the CPU from low power
+ */
+uint32_t HOST_RTC_ReadWakeupIrqCount( void )
+{
+  return WakeupIrqCount;
+}
+
+void HOST_RTC_WakeupTimerEnable( void )
+{
+  HOST_Rtc.CR |= RTC_CR_WUTE;
+  WakeupTimerNext = Now + (HOST_Rtc.WUTR & RTC_WUTR_WUT) + 1;
+
+  return;
+}
+
+void HOST_RTC_WakeupTimerDisable( void )
+{
+  HOST_Rtc.CR &= ~RTC_CR_WUTE;
+
+  return;
+}
+
+uint32_t HOST_RTC_GetFlag( uint32_t Flag )
+{
+  uint32_t flag_set;
+
+  if(Flag == RTC_FLAG_WUTWF)
+  {
+    /* The wakeup timer may be written once it is disabled */
+    flag_set = ((HOST_Rtc.CR & RTC_CR_WUTE) == 0) ? SET : RESET;
+  }
+  else
+  {
+    flag_set = (WakeupTimerFlag != 0) ? SET : RESET;
+  }
+
+  return flag_set;
+}
+
+void HOST_RTC_ClearFlag( uint32_t Flag )
+{
+  if(Flag == RTC_FLAG_WUTF)
+  {
+    WakeupTimerFlag = 0;
+  }
+
+  return;
+}
+
+/**
+ * @brief The NVIC of the HAL, only the RTC wakeup timer interrupt is modelled
+ */
+void HAL_NVIC_SetPriority( IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority )
+{
+  (void)IRQn;
+  (void)PreemptPriority;
+  (void)SubPriority;
+
+  return;
+}
+
+void HAL_NVIC_EnableIRQ( IRQn_Type IRQn )
+{
+  if(IRQn == RTC_WKUP_IRQn)
+  {
+    NvicEnabled = 1;
+    HOST_RTC_ServeIrq();
+  }
+
+  return;
+}
+
+void HAL_NVIC_DisableIRQ( IRQn_Type IRQn )
+{
+  if(IRQn == RTC_WKUP_IRQn)
+  {
+    NvicEnabled = 0;
+  }
+
+  return;
+}
+
+void HAL_NVIC_SetPendingIRQ( IRQn_Type IRQn )
+{
+  if(IRQn == RTC_WKUP_IRQn)
+  {
+    NvicPending = 1;
+    HOST_RTC_ServeIrq();
+  }
+
+  return;
+}
+
+void HAL_NVIC_ClearPendingIRQ( IRQn_Type IRQn )
+{
+  if(IRQn == RTC_WKUP_IRQn)
+  {
+    NvicPending = 0;
+  }
+
+  return;
+}
+
+uint32_t HOST_GetPrimask( void )
+{
+  return Primask;
+}
+
+void HOST_SetPrimask( uint32_t Primask_bit )
+{
+  struct timespec now;
+  uint64_t elapsed;
+
+  if((Primask == 0) && (Primask_bit != 0))
+  {
+    clock_gettime(CLOCK_MONOTONIC, &MaskStart);
+  }
+  else if((Primask != 0) && (Primask_bit == 0))
+  {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    elapsed = ((uint64_t)(now.tv_sec - MaskStart.tv_sec) * 1000000000ULL) + now.tv_nsec - MaskStart.tv_nsec;
+    MaskStat.Count++;
+    MaskStat.TotalNs += elapsed;
+  }
+  Primask = Primask_bit;
+  HOST_RTC_ServeIrq();
+
+  return;
+}
+
+/**
+ * @brief Statistics of the time spent with the interrupts masked by the PRIMASK
+ */
+void HOST_MaskStatReset( void )
+{
+  memset(&MaskStat, 0, sizeof(MaskStat));
+
+  return;
+}
+
+void HOST_MaskStatRead( HOST_MaskStat_t *p_stat )
+{
+  *p_stat = MaskStat;
+
+  return;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+static void HOST_RTC_UpdateSsr( void )
+{
+  /* The subsecond counter counts down from PREDIV_S */
+  HOST_Rtc.SSR = HOST_RTC_PREDIV_S - (uint32_t)(Now % (HOST_RTC_PREDIV_S + 1));
+
+  return;
+}
+
+/**
+ * @brief Take the wakeup timer interrupt when pending, enabled and not masked
+ */
+static void HOST_RTC_ServeIrq( void )
+{
+  while((InHandler == 0) && (NvicEnabled != 0) && (Primask == 0) && (NvicPending != 0))
+  {
+    NvicPending = 0;
+    InHandler = 1;
+    HW_TS_RTC_Wakeup_Handler();
+    InHandler = 0;
+  }
+
+  return;
+}
@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    rtc_host.h
+ * @author  MCD Application Team
+ * @brief   Model of the RTC wakeup timer, of the NVIC and of the PRIMASK for
+ *          the Linux host build of the timer server
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * The RTC is configured as on target: RTCCLK at 32 kHz, asynchronous
+ * prescaler 16, synchronous prescaler 32768 and wakeup timer clocked by
+ * RTCCLK/16. One tick of the wakeup timer is one tick of the subsecond
+ * counter (SSR).
+ *
+ * The time only moves when HOST_RTC_Advance() is called: the timer server
+ * APIs are executed in no time. The wakeup timer interrupt is raised when the
+ * counter reaches 0, and is taken as soon as it is enabled in the NVIC and
+ * not masked by the PRIMASK, outside of the interrupt handler itself.
+ *
+ * The device, HAL and LL headers of the application are used unmodified. This
+ * header shall be included before them: the RTC and EXTI registers are moved
+ * to memory before the LL drivers are parsed, then the accesses that have a
+ * side effect on the hardware (wakeup timer enable, flags, PRIMASK) are
+ * redirected to the model. The HAL_NVIC_xxx() functions are provided by
+ * rtc_host.c.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef RTC_HOST_H
+#define RTC_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(STM32WB15xx)
+#include "stm32wb15xx.h"
+#elif defined(STM32WB5Mxx)
+#include "stm32wb5mxx.h"
+#elif defined(STM32WB1Mxx)
+#include "stm32wb1mxx.h"
+#else
+#include "stm32wb55xx.h"
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t Count;       /* Number of critical sections */
+  uint64_t TotalNs;     /* Time spent with the interrupts masked */
+} HOST_MaskStat_t;
+
+/* Exported variables --------------------------------------------------------*/
+extern RTC_TypeDef HOST_Rtc;
+extern EXTI_TypeDef HOST_Exti;
+
+/* Exported macros -----------------------------------------------------------*/
+#undef RTC
+#define RTC                                     (&HOST_Rtc)
+
+#undef EXTI
+#define EXTI                                    (&HOST_Exti)
+
+#include "stm32wbxx.h"
+
+extern RTC_HandleTypeDef hrtc;
+
+#undef __HAL_RTC_WAKEUPTIMER_ENABLE
+#define __HAL_RTC_WAKEUPTIMER_ENABLE(h)         HOST_RTC_WakeupTimerEnable()
+
+#undef __HAL_RTC_WAKEUPTIMER_DISABLE
+#define __HAL_RTC_WAKEUPTIMER_DISABLE(h)        HOST_RTC_WakeupTimerDisable()
+
+#undef __HAL_RTC_WAKEUPTIMER_GET_FLAG
+#define __HAL_RTC_WAKEUPTIMER_GET_FLAG(h, flag) HOST_RTC_GetFlag(flag)
+
+#undef __HAL_RTC_WAKEUPTIMER_CLEAR_FLAG
+#define __HAL_RTC_WAKEUPTIMER_CLEAR_FLAG(h, flag) HOST_RTC_ClearFlag(flag)
+
+#define __get_PRIMASK()                         HOST_GetPrimask()
+#define __disable_irq()                         HOST_SetPrimask(1)
+#define __set_PRIMASK(primask)                  HOST_SetPrimask(primask)
+
+/* Exported functions ------------------------------------------------------- */
+void HOST_RTC_Init( void );
+void HOST_RTC_Advance( uint64_t Ticks );
+uint64_t HOST_RTC_Now( void );
+uint32_t HOST_RTC_ReadWakeupIrqCount( void );
+void HOST_RTC_WakeupTimerEnable( void );
+void HOST_RTC_WakeupTimerDisable( void );
+uint32_t HOST_RTC_GetFlag( uint32_t Flag );
+void HOST_RTC_ClearFlag( uint32_t Flag );
+uint32_t HOST_GetPrimask( void );
+void HOST_SetPrimask( uint32_t Primask_bit );
+void HOST_MaskStatReset( void );
+void HOST_MaskStatRead( HOST_MaskStat_t *p_stat );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*RTC_HOST_H */
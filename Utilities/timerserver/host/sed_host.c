@@ -0,0 +1,329 @@
+/**
+ ******************************************************************************
+ * @file    sed_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host simulation of the timer server wakeups on the polling
+ *          schedule of a Zigbee sleepy end device
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * hw_timerserver.c is built unmodified over the RTC model of rtc_host.c and
+ * runs the timers of a sleepy end device reporting a sensor value:
+ *
+ *  - long poll:    MAC data request to the parent every 7.5 s
+ *  - sensor:       measurement every 5 s
+ *  - report:       attribute report every 30 s, followed by a fast poll
+ *                  every 250 ms until 4 data requests have been sent
+ *  - keepalive:    end device keepalive to the parent every 60 s
+ *  - battery:      battery voltage measurement every 300 s
+ *
+ * Each timer has its own period and phase. The schedule is run once with no
+ * slack, then with a slack of a given percentage of each period (the fast
+ * poll gets 10 % at most). Each notification is checked to happen within the
+ * slack of its timeout. The wakeups of the CPU are the expiries of the RTC
+ * wakeup timer, including the ones of timeouts longer than the wakeup timer.
+ *
+ * Usage: sed_host [-d hours] [-s slack%[,slack%...]] [-c results.csv]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <unistd.h>
+
+#include "app_common.h"
+
+/* Private defines -----------------------------------------------------------*/
+/* The wakeup timer is clocked by RTCCLK/16 */
+#define SED_HOST_TICK_PER_S             (32768U / 16U)
+#define SED_HOST_MS_TO_TICK(ms)         ((uint32_t)(((uint64_t)(ms) * SED_HOST_TICK_PER_S) / 1000U))
+#define SED_HOST_FAST_POLL_NBR          (4)
+#define SED_HOST_FAST_POLL_MAX_SLACK    (10)
+#define SED_HOST_MAX_SLACK_NBR          (8)
+#define SED_HOST_MAX_ERRORS             (10)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  SED_HOST_LongPoll,
+  SED_HOST_Sensor,
+  SED_HOST_Report,
+  SED_HOST_FastPoll,
+  SED_HOST_Keepalive,
+  SED_HOST_Battery,
+  SED_HOST_TimerNbr,
+} SED_HOST_TimerIdx_t;
+
+typedef struct
+{
+  const char *name;
+  uint32_t period_ms;
+  uint32_t phase_ms;
+  uint8_t id;
+  uint8_t active;
+  uint8_t pending;
+  uint32_t slack;
+  uint64_t expected;
+  uint32_t notified;
+} SED_HOST_Timer_t;
+
+/* Private variables ---------------------------------------------------------*/
+static SED_HOST_Timer_t Timer[SED_HOST_TimerNbr] =
+{
+  { "long poll",  7500,    300 },
+  { "sensor",     5000,   1100 },
+  { "report",    30000,   2300 },
+  { "fast poll",   250,      0 },
+  { "keepalive", 60000,  17000 },
+  { "battery",  300000, 123000 },
+};
+static uint32_t FastPollCount;
+static uint32_t Errors;
+static uint32_t Notifications;
+
+/* Private function prototypes -----------------------------------------------*/
+static void SED_HOST_Error( uint8_t Idx, uint64_t Time );
+static void SED_HOST_Start( uint8_t Idx, uint32_t SlackPercent );
+static void SED_HOST_TimerCb( void );
+static void SED_HOST_Process( uint32_t SlackPercent );
+static int SED_HOST_Run( uint32_t Hours, uint32_t SlackPercent, uint32_t *pReference, FILE *pCsv );
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+ * @brief Check the notification against its slack window and defer the job to the main loop
+ */
+void HW_TS_RTC_Int_AppNot(uint32_t TimerProcessID, uint8_t TimerID, HW_TS_pTimerCb_t pTimerCallBack)
+{
+  SED_HOST_Timer_t *p_timer = &Timer[TimerProcessID];
+  uint64_t now = HOST_RTC_Now();
+
+  (void)pTimerCallBack;
+
+  Notifications++;
+  if((TimerProcessID >= SED_HOST_TimerNbr) || (p_timer->id != TimerID) || (p_timer->active == 0) ||
+     (now < p_timer->expected) || (now > (p_timer->expected + p_timer->slack)))
+  {
+    SED_HOST_Error(TimerProcessID, now);
+    return;
+  }
+
+  /* All the timers are repeated ones, the next timeout starts from the notification */
+  p_timer->notified++;
+  p_timer->pending = 1;
+  p_timer->expected = now + SED_HOST_MS_TO_TICK(p_timer->period_ms);
+
+  return;
+}
+
+void HW_TS_RTC_CountUpdated_AppNot(void)
+{
+  return;
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t a_slack[SED_HOST_MAX_SLACK_NBR] = { 0, 2, 5, 10, 20 };
+  uint8_t slack_nbr = 5;
+  uint32_t hours = 4;
+  uint32_t reference = 0;
+  FILE *p_csv = NULL;
+  char *p_token;
+  int status = 0;
+  int opt;
+  uint8_t idx;
+
+  while((opt = getopt(argc, argv, "d:s:c:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'd':
+        hours = strtoul(optarg, NULL, 0);
+        break;
+
+      case 's':
+        slack_nbr = 0;
+        for(p_token = strtok(optarg, ","); (p_token != NULL) && (slack_nbr < SED_HOST_MAX_SLACK_NBR);
+            p_token = strtok(NULL, ","))
+        {
+          a_slack[slack_nbr++] = strtoul(p_token, NULL, 0);
+        }
+        break;
+
+      case 'c':
+        p_csv = fopen(optarg, "a");
+        if(p_csv == NULL)
+        {
+          perror(optarg);
+          return 2;
+        }
+        break;
+
+      default:
+        fprintf(stderr, "usage: %s [-d hours] [-s slack%%[,slack%%...]] [-c results.csv]\n", argv[0]);
+        return 2;
+    }
+  }
+
+  printf("sleepy end device, %u h\n", hours);
+  printf("  slack  notifications  CPU wakeups  timer wakeups  wakeups avoided  reduction  errors\n");
+  for(idx = 0; idx < slack_nbr; idx++)
+  {
+    /* The reduction of the wakeups is given against the first run */
+    status |= SED_HOST_Run(hours, a_slack[idx], &reference, p_csv);
+  }
+  printf("%s\n", (status == 0) ? "PASS" : "FAIL");
+
+  if(p_csv != NULL)
+  {
+    fclose(p_csv);
+  }
+
+  return status;
+}
+
+
+/* Private Functions Definition ----------------------------------------------*/
+static void SED_HOST_Error( uint8_t Idx, uint64_t Time )
+{
+  Errors++;
+  if(Errors <= SED_HOST_MAX_ERRORS)
+  {
+    printf("  notification error: %s timer at tick %llu\n", Timer[Idx].name, (unsigned long long)Time);
+  }
+
+  return;
+}
+
+static void SED_HOST_Start( uint8_t Idx, uint32_t SlackPercent )
+{
+  SED_HOST_Timer_t *p_timer = &Timer[Idx];
+  uint32_t period = SED_HOST_MS_TO_TICK(p_timer->period_ms);
+
+  /* The fast poll is what keeps the reply latency of the parent low, it is not delayed much */
+  if((Idx == SED_HOST_FastPoll) && (SlackPercent > SED_HOST_FAST_POLL_MAX_SLACK))
+  {
+    SlackPercent = SED_HOST_FAST_POLL_MAX_SLACK;
+  }
+
+  p_timer->active = 1;
+  p_timer->pending = 0;
+  p_timer->slack = (period * SlackPercent) / 100;
+  p_timer->expected = HOST_RTC_Now() + period;
+  HW_TS_Stop(p_timer->id);
+  HW_TS_StartWithSlack(p_timer->id, period, p_timer->slack);
+
+  return;
+}
+
+static void SED_HOST_TimerCb( void )
+{
+  return;
+}
+
+/**
+ * @brief Jobs of the application, run from the main loop once the wakeup handler has returned
+ */
+static void SED_HOST_Process( uint32_t SlackPercent )
+{
+  if(Timer[SED_HOST_Report].pending != 0)
+  {
+    Timer[SED_HOST_Report].pending = 0;
+    FastPollCount = 0;
+    SED_HOST_Start(SED_HOST_FastPoll, SlackPercent);
+  }
+
+  if(Timer[SED_HOST_FastPoll].pending != 0)
+  {
+    Timer[SED_HOST_FastPoll].pending = 0;
+    FastPollCount++;
+    if(FastPollCount >= SED_HOST_FAST_POLL_NBR)
+    {
+      Timer[SED_HOST_FastPoll].active = 0;
+      HW_TS_Stop(Timer[SED_HOST_FastPoll].id);
+    }
+  }
+
+  return;
+}
+
+static int SED_HOST_Run( uint32_t Hours, uint32_t SlackPercent, uint32_t *pReference, FILE *pCsv )
+{
+  uint64_t end = (uint64_t)Hours * 3600U * SED_HOST_TICK_PER_S;
+  uint32_t rtc_wakeup_count;
+  uint32_t wakeup_avoided_count;
+  uint32_t cpu_wakeups;
+  double reduction;
+  uint8_t idx;
+
+  HOST_RTC_Init();
+  HW_TS_Init(hw_ts_InitMode_Full, &hrtc);
+  Errors = 0;
+  Notifications = 0;
+  FastPollCount = 0;
+  for(idx = 0; idx < SED_HOST_TimerNbr; idx++)
+  {
+    Timer[idx].active = 0;
+    Timer[idx].pending = 0;
+    Timer[idx].notified = 0;
+    (void)HW_TS_Create(idx, &Timer[idx].id, hw_ts_Repeated, SED_HOST_TimerCb);
+  }
+
+  /**
+   * A repeated timer restarts with the timeout it has been started with, so each timer is started with
+   * its period once its phase is elapsed
+   */
+  for(idx = 0; idx < SED_HOST_TimerNbr; idx++)
+  {
+    Timer[idx].expected = SED_HOST_MS_TO_TICK(Timer[idx].phase_ms);
+  }
+
+  while(HOST_RTC_Now() < end)
+  {
+    for(idx = 0; idx < SED_HOST_TimerNbr; idx++)
+    {
+      if((idx != SED_HOST_FastPoll) && (Timer[idx].active == 0) && (HOST_RTC_Now() >= Timer[idx].expected))
+      {
+        SED_HOST_Start(idx, SlackPercent);
+      }
+    }
+    SED_HOST_Process(SlackPercent);
+    HOST_RTC_Advance(1);
+
+    /* A notification missed by more than its slack is an error */
+    for(idx = 0; idx < SED_HOST_TimerNbr; idx++)
+    {
+      if((Timer[idx].active != 0) && (HOST_RTC_Now() > (Timer[idx].expected + Timer[idx].slack)))
+      {
+        SED_HOST_Error(idx, HOST_RTC_Now());
+        Timer[idx].active = 0;
+        HW_TS_Stop(Timer[idx].id);
+      }
+    }
+  }
+
+  HW_TS_ReadWakeupCounters(&rtc_wakeup_count, &wakeup_avoided_count);
+  cpu_wakeups = HOST_RTC_ReadWakeupIrqCount();
+  if(*pReference == 0)
+  {
+    *pReference = cpu_wakeups;
+  }
+  reduction = (100.0 * ((double)*pReference - cpu_wakeups)) / *pReference;
+  printf("  %4u%%  %13u  %11u  %13u  %15u  %8.1f%%  %6u\n", SlackPercent, Notifications, cpu_wakeups,
+         rtc_wakeup_count, wakeup_avoided_count, reduction, Errors);
+  if(pCsv != NULL)
+  {
+    fprintf(pCsv, "%u,%u,%u,%u,%u,%u,%.1f,%u\n", Hours, SlackPercent, Notifications, cpu_wakeups, rtc_wakeup_count,
+            wakeup_avoided_count, reduction, Errors);
+  }
+
+  return (Errors == 0) ? 0 : 1;
+}
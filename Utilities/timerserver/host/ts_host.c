@@ -0,0 +1,441 @@
+/**
+ ******************************************************************************
+ * @file    ts_host.c
+ * @author  MCD Application Team
+ * @brief   Linux host test of the timer server against a model of the RTC
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2019-2021 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * hw_timerserver.c is built unmodified over the RTC model of rtc_host.c. Each
+ * notification is checked against a reference model of the timers: it shall
+ * happen at the timeout, or within the slack when one is given, and never for
+ * a timer that is stopped.
+ *
+ *  - long:   timeouts around 2^31 ticks and up to 0xFFFF0000 ticks, each one
+ *            becoming the first timer to expire when it is started
+ *  - wrap:   random starts and stops of timers up to 0xFFFF0000 ticks while
+ *            the time base of the timer server wraps around several times
+ *  - repeat: repeated timers, restarted from the wakeup handler, mixed with
+ *            random restarts from the application
+ *  - bench:  time spent with the interrupts masked by HW_TS_Stop() and
+ *            HW_TS_Start(), with 6 to 200 timers running. Only the critical
+ *            sections are timed, less the cost of the clock reads measured on
+ *            an empty critical section.
+ *
+ * ts_host_list is the same program built over the linked list timer server
+ * that precedes the binary heap, see the Makefile. It only runs the bench, to
+ * compare both implementations on the same host.
+ *
+ * Usage: ts_host [-s seed]
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <unistd.h>
+
+#include "app_common.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TS_HOST_TIMER_NBR               CFG_HW_TS_MAX_NBR_CONCURRENT_TIMER
+#define TS_HOST_MAX_TIMEOUT             (0xFFFF0000U)
+#define TS_HOST_MAX_ERRORS              (10)
+#define TS_HOST_BENCH_LOOP              (1000000)
+
+#ifdef TS_HOST_LIST
+/* The linked list timer server has no slack */
+#define HW_TS_StartWithSlack(id, timeout, slack)  HW_TS_Start(id, timeout)
+#define TS_HOST_IMPL                    "list"
+#define TS_HOST_TESTS                   (0)
+#else
+#define TS_HOST_IMPL                    "heap"
+#define TS_HOST_TESTS                   (1)
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint8_t id;
+  uint8_t active;
+  HW_TS_Mode_t mode;
+  uint32_t timeout;
+  uint32_t slack;
+  uint64_t expected;
+  uint32_t notified;
+} TS_HOST_Timer_t;
+
+/* Private variables ---------------------------------------------------------*/
+static TS_HOST_Timer_t Timer[TS_HOST_TIMER_NBR];
+static uint8_t TimerNbr;
+static uint32_t Errors;
+static uint32_t Notifications;
+static uint64_t RandomState = 0x9E3779B97F4A7C15ULL;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t TS_HOST_Random( void );
+static void TS_HOST_Error( const char *Test, uint8_t TimerID, uint64_t Time );
+static void TS_HOST_Setup( uint8_t Nbr, HW_TS_Mode_t Mode );
+static void TS_HOST_Start( uint8_t Idx, uint32_t Timeout, uint32_t Slack );
+static void TS_HOST_Stop( uint8_t Idx );
+static uint32_t TS_HOST_RandomTimeout( void );
+static void TS_HOST_TimerCb( void );
+static int TS_HOST_Long( void );
+static int TS_HOST_Wrap( void );
+static int TS_HOST_Repeat( void );
+static void TS_HOST_CheckMissed( const char *Test );
+static double TS_HOST_MaskOverhead( void );
+static void TS_HOST_Bench( void );
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+ * @brief Check the notification against the reference model
+ */
+void HW_TS_RTC_Int_AppNot(uint32_t TimerProcessID, uint8_t TimerID, HW_TS_pTimerCb_t pTimerCallBack)
+{
+  TS_HOST_Timer_t *p_timer = &Timer[TimerProcessID];
+  uint64_t now = HOST_RTC_Now();
+
+  (void)pTimerCallBack;
+
+  Notifications++;
+  if((TimerProcessID >= TimerNbr) || (p_timer->id != TimerID) || (p_timer->active == 0) ||
+     (now < p_timer->expected) || (now > (p_timer->expected + p_timer->slack)))
+  {
+    TS_HOST_Error("notification", TimerID, now);
+    return;
+  }
+
+  p_timer->notified++;
+  if(p_timer->mode == hw_ts_Repeated)
+  {
+    p_timer->expected = now + p_timer->timeout;
+  }
+  else
+  {
+    p_timer->active = 0;
+  }
+
+  return;
+}
+
+void HW_TS_RTC_CountUpdated_AppNot(void)
+{
+  return;
+}
+
+int main(int argc, char *argv[])
+{
+  int opt;
+  int status = 0;
+
+  while((opt = getopt(argc, argv, "s:")) != -1)
+  {
+    if(opt == 's')
+    {
+      RandomState = strtoull(optarg, NULL, 0) | 1;
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [-s seed]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  /* The tests rely on the slack and long timeouts of the binary heap */
+  if(TS_HOST_TESTS != 0)
+  {
+    status |= TS_HOST_Long();
+    status |= TS_HOST_Wrap();
+    status |= TS_HOST_Repeat();
+  }
+  TS_HOST_Bench();
+
+  printf("%s\n", (status == 0) ? "PASS" : "FAIL");
+
+  return status;
+}
+
+/* Private Functions Definition ----------------------------------------------*/
+static uint32_t TS_HOST_Random( void )
+{
+  RandomState ^= RandomState << 13;
+  RandomState ^= RandomState >> 7;
+  RandomState ^= RandomState << 17;
+
+  return (uint32_t)(RandomState >> 32);
+}
+
+static void TS_HOST_Error( const char *Test, uint8_t TimerID, uint64_t Time )
+{
+  Errors++;
+  if(Errors <= TS_HOST_MAX_ERRORS)
+  {
+    printf("  %s error: timer %u at tick %llu\n", Test, TimerID, (unsigned long long)Time);
+  }
+
+  return;
+}
+
+static void TS_HOST_Setup( uint8_t Nbr, HW_TS_Mode_t Mode )
+{
+  uint8_t idx;
+
+  HOST_RTC_Init();
+  HW_TS_Init(hw_ts_InitMode_Full, &hrtc);
+
+  memset(Timer, 0, sizeof(Timer));
+  TimerNbr = Nbr;
+  Errors = 0;
+  Notifications = 0;
+  for(idx = 0; idx < Nbr; idx++)
+  {
+    Timer[idx].mode = Mode;
+    (void)HW_TS_Create(idx, &Timer[idx].id, Mode, TS_HOST_TimerCb);
+  }
+
+  return;
+}
+
+static void TS_HOST_Start( uint8_t Idx, uint32_t Timeout, uint32_t Slack )
+{
+  Timer[Idx].active = 1;
+  Timer[Idx].timeout = Timeout;
+  Timer[Idx].slack = Slack;
+  Timer[Idx].expected = HOST_RTC_Now() + Timeout;
+  HW_TS_StartWithSlack(Timer[Idx].id, Timeout, Slack);
+
+  return;
+}
+
+static void TS_HOST_Stop( uint8_t Idx )
+{
+  Timer[Idx].active = 0;
+  HW_TS_Stop(Timer[Idx].id);
+
+  return;
+}
+
+/**
+ * @brief Mix of short, medium and long timeouts, up to the maximum allowed
+ */
+static uint32_t TS_HOST_RandomTimeout( void )
+{
+  uint32_t draw = TS_HOST_Random() % 10;
+  uint32_t timeout;
+
+  if(draw < 5)
+  {
+    timeout = 1 + (TS_HOST_Random() % 2000);
+  }
+  else if(draw < 8)
+  {
+    timeout = 1 + (TS_HOST_Random() % (1U << 20));
+  }
+  else
+  {
+    timeout = 1 + (TS_HOST_Random() % TS_HOST_MAX_TIMEOUT);
+  }
+
+  return timeout;
+}
+
+static void TS_HOST_TimerCb( void )
+{
+  return;
+}
+
+static int TS_HOST_Long( void )
+{
+  static const uint32_t a_timeout[] = { TS_HOST_MAX_TIMEOUT, 0xC0000000U, 0x80000001U, 0x80000000U, 0x7FFFFFFFU, 100 };
+  uint8_t nbr = sizeof(a_timeout) / sizeof(a_timeout[0]);
+  uint8_t idx;
+
+  TS_HOST_Setup(nbr, hw_ts_SingleShot);
+  for(idx = 0; idx < nbr; idx++)
+  {
+    TS_HOST_Start(idx, a_timeout[idx], 0);
+    HOST_RTC_Advance(1 + (TS_HOST_Random() % 100));
+  }
+  while(HOST_RTC_Now() < (TS_HOST_MAX_TIMEOUT + 0x10000ULL))
+  {
+    HOST_RTC_Advance(1U << 24);
+  }
+
+  for(idx = 0; idx < nbr; idx++)
+  {
+    if(Timer[idx].notified != 1)
+    {
+      TS_HOST_Error("long", Timer[idx].id, HOST_RTC_Now());
+    }
+  }
+  printf("long:  %u timers up to 0x%08X ticks, %u notifications, %u errors\n",
+         nbr, TS_HOST_MAX_TIMEOUT, Notifications, Errors);
+
+  return (Errors == 0) ? 0 : 1;
+}
+
+static int TS_HOST_Wrap( void )
+{
+  uint32_t step = 0;
+  uint32_t starts = 0;
+  uint32_t stops = 0;
+  uint8_t idx;
+
+  TS_HOST_Setup(TS_HOST_TIMER_NBR, hw_ts_SingleShot);
+
+  /* Four wrap arounds of the 32 bit time base */
+  while(HOST_RTC_Now() < (4ULL << 32))
+  {
+    idx = TS_HOST_Random() % TS_HOST_TIMER_NBR;
+    if((Timer[idx].active != 0) && ((TS_HOST_Random() % 4) == 0))
+    {
+      TS_HOST_Stop(idx);
+      stops++;
+    }
+    else
+    {
+      TS_HOST_Start(idx, TS_HOST_RandomTimeout(), 0);
+      starts++;
+    }
+    HOST_RTC_Advance(TS_HOST_Random() % (1U << 20));
+    step++;
+  }
+  for(idx = 0; idx < TS_HOST_TIMER_NBR; idx++)
+  {
+    if(Timer[idx].active != 0)
+    {
+      TS_HOST_Stop(idx);
+    }
+  }
+  HOST_RTC_Advance(1ULL << 32);
+
+  printf("wrap:  %u starts, %u stops over %llu ticks, %u notifications, %u errors\n",
+         starts, stops, (unsigned long long)HOST_RTC_Now(), Notifications, Errors);
+
+  return (Errors == 0) ? 0 : 1;
+}
+
+static int TS_HOST_Repeat( void )
+{
+  uint32_t step;
+  uint32_t restarts = 0;
+  uint8_t nbr = 8;
+  uint8_t idx;
+
+  TS_HOST_Setup(nbr, hw_ts_Repeated);
+  for(idx = 0; idx < nbr; idx++)
+  {
+    TS_HOST_Start(idx, 100 + (TS_HOST_Random() % 5000), 0);
+  }
+  for(step = 0; step < 200000; step++)
+  {
+    HOST_RTC_Advance(TS_HOST_Random() % 500);
+    TS_HOST_CheckMissed("repeat");
+    if((TS_HOST_Random() % 8) == 0)
+    {
+      idx = TS_HOST_Random() % nbr;
+      TS_HOST_Start(idx, 100 + (TS_HOST_Random() % 5000), 0);
+      restarts++;
+    }
+  }
+
+  printf("repeat: %u timers, %u restarts, %u notifications, %u errors\n", nbr, restarts, Notifications, Errors);
+
+  return (Errors == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Report the running timers whose notification is overdue
+ */
+static void TS_HOST_CheckMissed( const char *Test )
+{
+  uint64_t now = HOST_RTC_Now();
+  uint8_t idx;
+
+  for(idx = 0; idx < TimerNbr; idx++)
+  {
+    if((Timer[idx].active != 0) && (now > (Timer[idx].expected + Timer[idx].slack)))
+    {
+      TS_HOST_Error(Test, Timer[idx].id, now);
+      /* Report each missed notification once */
+      Timer[idx].active = 0;
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief Mean time of an empty critical section, that is the cost of the
+ *        clock reads added to each critical section by the model
+ */
+static double TS_HOST_MaskOverhead( void )
+{
+  HOST_MaskStat_t stat;
+  uint32_t primask_bit;
+  uint32_t loop;
+
+  HOST_MaskStatReset();
+  for(loop = 0; loop < TS_HOST_BENCH_LOOP; loop++)
+  {
+    primask_bit = __get_PRIMASK();
+    __disable_irq();
+    __set_PRIMASK(primask_bit);
+  }
+  HOST_MaskStatRead(&stat);
+
+  return (double)stat.TotalNs / stat.Count;
+}
+
+static void TS_HOST_Bench( void )
+{
+  static const uint8_t a_nbr[] = { 6, 50, 200 };
+  static uint8_t a_idx[TS_HOST_BENCH_LOOP];
+  static uint32_t a_timeout[TS_HOST_BENCH_LOOP];
+  HOST_MaskStat_t stat;
+  double overhead;
+  uint32_t loop;
+  uint8_t n;
+  uint8_t idx;
+
+  overhead = TS_HOST_MaskOverhead();
+  printf("bench: %s, empty critical section %.0f ns, removed from the results\n", TS_HOST_IMPL, overhead);
+
+  for(n = 0; n < sizeof(a_nbr); n++)
+  {
+    TS_HOST_Setup(a_nbr[n], hw_ts_SingleShot);
+    for(idx = 0; idx < a_nbr[n]; idx++)
+    {
+      TS_HOST_Start(idx, 0x10000000U + (TS_HOST_Random() % 0x10000000U), 0);
+    }
+    for(loop = 0; loop < TS_HOST_BENCH_LOOP; loop++)
+    {
+      a_idx[loop] = TS_HOST_Random() % a_nbr[n];
+      a_timeout[loop] = 0x10000000U + (TS_HOST_Random() % 0x10000000U);
+    }
+
+    HOST_MaskStatReset();
+    for(loop = 0; loop < TS_HOST_BENCH_LOOP; loop++)
+    {
+      HW_TS_Stop(Timer[a_idx[loop]].id);
+      HW_TS_Start(Timer[a_idx[loop]].id, a_timeout[loop]);
+    }
+    HOST_MaskStatRead(&stat);
+
+    printf("bench: %s, %3u timers, HW_TS_Stop() + HW_TS_Start() masked %.0f ns in %.1f critical sections\n",
+           TS_HOST_IMPL, a_nbr[n],
+           ((double)stat.TotalNs - (overhead * stat.Count)) / TS_HOST_BENCH_LOOP,
+           (double)stat.Count / TS_HOST_BENCH_LOOP);
+  }
+
+  return;
+}